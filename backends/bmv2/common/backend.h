@@ -78,6 +78,12 @@ class Backend {
           json(new BMV2::JsonObjects()) {
         refMap->setIsV1(options.isv1());
     }
+    /// Serialization already streams: the Util::IJson tree writes straight into the
+    /// output stream with no intermediate string, so peak memory is one copy of the
+    /// tree.  Emitting sections as they are converted (fully single-pass) is not
+    /// possible with the current converters, which fill toplevel's sections out of
+    /// their output order and patch earlier sections (e.g. declared headers and
+    /// field lists) while later ones are built.
     void serialize(std::ostream &out) const { json->toplevel->serialize(out); }
     virtual void convert(const IR::ToplevelBlock *block) = 0;
 };
@@ -27,6 +27,7 @@ limitations under the License.
 #include "helpers.h"
 #include "ir/ir.h"
 #include "lib/algorithm.h"
+#include "lib/indent.h"
 #include "lib/json.h"
 #include "midend/convertEnums.h"
 #include "sharedActionSelectorCheck.h"
@@ -434,170 +435,221 @@ class ControlConverter : public Inspector {
         convertTableEntries(table, result);
         return result;
     }
+    /// Serializes the "entries" array of a large const table directly to the output
+    /// stream, converting one entry at a time instead of materializing a JsonObject
+    /// per entry; this keeps the memory used for entry conversion constant in the
+    /// table size.  Produces exactly the text a JsonArray of the same entries would.
+    class StreamedTableEntries : public Util::IJson {
+        ControlConverter *converter;
+        const IR::P4Table *table;
+
+     public:
+        StreamedTableEntries(ControlConverter *converter, const IR::P4Table *table)
+            : converter(converter), table(table) {
+            CHECK_NULL(converter);
+            CHECK_NULL(table);
+        }
+        void serialize(std::ostream &out) const override {
+            out << "[" << IndentCtl::indent;
+            int entryPriority = 1;
+            bool first = true;
+            for (auto e : table->getEntries()->entries) {
+                if (!first) out << ",";
+                first = false;
+                out << IndentCtl::endl;
+                // The up-front pass in convertTableEntries already diagnosed these
+                // entries; do not report the same problems again.
+                converter->convertTableEntry(table, e, entryPriority++, false)->serialize(out);
+            }
+            out << IndentCtl::unindent << IndentCtl::endl << "]";
+        }
+
+        DECLARE_TYPEINFO(StreamedTableEntries, Util::IJson);
+    };
+
     void convertTableEntries(const IR::P4Table *table, Util::JsonObject *jsonTable) {
         auto entriesList = table->getEntries();
         if (entriesList == nullptr) return;
 
+        if (entriesList->entries.size() >= TableAttributes::streamedEntriesLimit) {
+            // For large constant tables emit the entries during serialization, one at
+            // a time, instead of holding the whole array in memory.  Convert (and
+            // discard) each entry once up front so diagnostics fire during this pass;
+            // serialization then redoes the conversion with diagnostics suppressed,
+            // so nothing is reported twice.
+            int entryPriority = 1;
+            for (auto e : entriesList->entries) convertTableEntry(table, e, entryPriority++);
+            jsonTable->emplace("entries", new StreamedTableEntries(this, table));
+            return;
+        }
         auto entries = mkArrayField(jsonTable, "entries"_cs);
         int entryPriority = 1;  // default priority is defined by index position
-        for (auto e : entriesList->entries) {
-            auto entry = new Util::JsonObject();
-            entry->emplace_non_null("source_info"_cs, e->sourceInfoJsonObj());
-
-            auto keyset = e->getKeys();
-            auto matchKeys = mkArrayField(entry, "match_key"_cs);
-            int keyIndex = 0;
-            for (auto k : keyset->components) {
-                auto key = new Util::JsonObject();
-                auto tableKey = table->getKey()->keyElements.at(keyIndex);
-                int keyWidth = 0;
-                if (tableKey->expression->type->is<IR::Type_Error>()) {
-                    // error type doesn't have a width, and will fail below, checking the key
-                    // expression k, so it doesn't matter what keyWidth is.
-                } else {
-                    keyWidth = tableKey->expression->type->width_bits();
-                }
-                auto k8 = ROUNDUP(keyWidth, 8);
-                auto matchType = getKeyMatchType(tableKey);
-                // Table key fields with match_kind optional will be
-                // represented in the BMv2 JSON file the same as a ternary
-                // field would be.
-                if (matchType == "optional") {
-                    key->emplace("match_type", "ternary");
-                } else {
-                    key->emplace("match_type", matchType);
+        for (auto e : entriesList->entries)
+            entries->append(convertTableEntry(table, e, entryPriority++));
+    }
+    /// Convert a single const entry of @table; @entryPriority is the priority its
+    /// position implies, used unless the entry carries a @priority annotation.
+    /// With @reportErrors false invalid entries are converted silently; used when
+    /// re-converting entries that an earlier pass has already diagnosed.
+    Util::JsonObject *convertTableEntry(const IR::P4Table *table, const IR::Entry *e,
+                                        int entryPriority, bool reportErrors = true) {
+        auto entry = new Util::JsonObject();
+        entry->emplace_non_null("source_info"_cs, e->sourceInfoJsonObj());
+
+        auto keyset = e->getKeys();
+        auto matchKeys = mkArrayField(entry, "match_key"_cs);
+        int keyIndex = 0;
+        for (auto k : keyset->components) {
+            auto key = new Util::JsonObject();
+            auto tableKey = table->getKey()->keyElements.at(keyIndex);
+            int keyWidth = 0;
+            if (tableKey->expression->type->is<IR::Type_Error>()) {
+                // error type doesn't have a width, and will fail below, checking the key
+                // expression k, so it doesn't matter what keyWidth is.
+            } else {
+                keyWidth = tableKey->expression->type->width_bits();
+            }
+            auto k8 = ROUNDUP(keyWidth, 8);
+            auto matchType = getKeyMatchType(tableKey);
+            // Table key fields with match_kind optional will be
+            // represented in the BMv2 JSON file the same as a ternary
+            // field would be.
+            if (matchType == "optional") {
+                key->emplace("match_type", "ternary");
+            } else {
+                key->emplace("match_type", matchType);
+            }
+            if (matchType == corelib.exactMatch.name) {
+                if (k->is<IR::Constant>())
+                    key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
+                else if (k->is<IR::BoolLiteral>())
+                    // booleans are converted to ints
+                    key->emplace("key",
+                                 stringRepr(k->to<IR::BoolLiteral>()->value ? 1 : 0, k8));
+                else if (reportErrors)
+                    ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                                "%1%: unsupported exact key expression", k);
+            } else if (matchType == corelib.ternaryMatch.name) {
+                if (k->is<IR::Mask>()) {
+                    auto km = k->to<IR::Mask>();
+                    key->emplace("key", stringRepr(km->left->to<IR::Constant>()->value, k8));
+                    key->emplace("mask", stringRepr(km->right->to<IR::Constant>()->value, k8));
+                } else if (k->is<IR::Constant>()) {
+                    key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
+                    key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
+                } else if (k->is<IR::BoolLiteral>()) {
+                    key->emplace("key",
+                                 stringRepr(k->to<IR::BoolLiteral>()->value ? 1 : 0, k8));
+                    key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
+                } else if (k->is<IR::DefaultExpression>()) {
+                    key->emplace("key", stringRepr(0, k8));
+                    key->emplace("mask", stringRepr(0, k8));
+                } else if (reportErrors) {
+                    ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                                "%1%: unsupported ternary key expression", k);
                 }
-                if (matchType == corelib.exactMatch.name) {
-                    if (k->is<IR::Constant>())
-                        key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
-                    else if (k->is<IR::BoolLiteral>())
-                        // booleans are converted to ints
-                        key->emplace("key",
-                                     stringRepr(k->to<IR::BoolLiteral>()->value ? 1 : 0, k8));
-                    else
-                        ::P4::error(ErrorType::ERR_UNSUPPORTED,
-                                    "%1%: unsupported exact key expression", k);
-                } else if (matchType == corelib.ternaryMatch.name) {
-                    if (k->is<IR::Mask>()) {
-                        auto km = k->to<IR::Mask>();
-                        key->emplace("key", stringRepr(km->left->to<IR::Constant>()->value, k8));
-                        key->emplace("mask", stringRepr(km->right->to<IR::Constant>()->value, k8));
-                    } else if (k->is<IR::Constant>()) {
-                        key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
-                        key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
-                    } else if (k->is<IR::BoolLiteral>()) {
-                        key->emplace("key",
-                                     stringRepr(k->to<IR::BoolLiteral>()->value ? 1 : 0, k8));
-                        key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
-                    } else if (k->is<IR::DefaultExpression>()) {
-                        key->emplace("key", stringRepr(0, k8));
-                        key->emplace("mask", stringRepr(0, k8));
+            } else if (matchType == corelib.lpmMatch.name) {
+                if (k->is<IR::Mask>()) {
+                    auto km = k->to<IR::Mask>();
+                    key->emplace("key", stringRepr(km->left->to<IR::Constant>()->value, k8));
+                    auto trailing_zeros = [](unsigned long n, unsigned long keyWidth) {
+                        return n ? __builtin_ctzl(n) : static_cast<int>(keyWidth);
+                    };
+                    auto count_ones = [](unsigned long n) {
+                        return n ? __builtin_popcountl(n) : 0;
+                    };
+                    auto mask =
+                        static_cast<unsigned long>(km->right->to<IR::Constant>()->value);
+                    auto len = trailing_zeros(mask, keyWidth);
+                    if (len + count_ones(mask) != keyWidth) {  // any remaining 0s in the prefix?
+                        if (reportErrors)
+                            ::P4::error(ErrorType::ERR_INVALID, "%1%: invalid mask for LPM key",
+                                        k);
                     } else {
-                        ::P4::error(ErrorType::ERR_UNSUPPORTED,
-                                    "%1%: unsupported ternary key expression", k);
+                        key->emplace("prefix_length", keyWidth - len);
                     }
-                } else if (matchType == corelib.lpmMatch.name) {
-                    if (k->is<IR::Mask>()) {
-                        auto km = k->to<IR::Mask>();
-                        key->emplace("key", stringRepr(km->left->to<IR::Constant>()->value, k8));
-                        auto trailing_zeros = [](unsigned long n, unsigned long keyWidth) {
-                            return n ? __builtin_ctzl(n) : static_cast<int>(keyWidth);
-                        };
-                        auto count_ones = [](unsigned long n) {
-                            return n ? __builtin_popcountl(n) : 0;
-                        };
-                        auto mask =
-                            static_cast<unsigned long>(km->right->to<IR::Constant>()->value);
-                        auto len = trailing_zeros(mask, keyWidth);
-                        if (len + count_ones(mask) != keyWidth)  // any remaining 0s in the prefix?
-                            ::P4::error(ErrorType::ERR_INVALID, "%1%: invalid mask for LPM key", k);
-                        else
-                            key->emplace("prefix_length", keyWidth - len);
-                    } else if (k->is<IR::Constant>()) {
-                        key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
-                        key->emplace("prefix_length", keyWidth);
-                    } else if (k->is<IR::DefaultExpression>()) {
-                        key->emplace("key", stringRepr(0, k8));
-                        key->emplace("prefix_length", 0);
-                    } else {
-                        ::P4::error(ErrorType::ERR_UNSUPPORTED,
-                                    "%1%: unsupported LPM key expression", k);
-                    }
-                } else if (matchType == "range") {
-                    if (k->is<IR::Range>()) {
-                        auto kr = k->to<IR::Range>();
-                        key->emplace("start", stringRepr(kr->left->to<IR::Constant>()->value, k8));
-                        key->emplace("end", stringRepr(kr->right->to<IR::Constant>()->value, k8));
-                    } else if (k->is<IR::Constant>()) {
-                        key->emplace("start", stringRepr(k->to<IR::Constant>()->value, k8));
-                        key->emplace("end", stringRepr(k->to<IR::Constant>()->value, k8));
-                    } else if (k->is<IR::DefaultExpression>()) {
-                        key->emplace("start", stringRepr(0, k8));
-                        key->emplace("end", stringRepr((1 << keyWidth) - 1, k8));  // 2^N -1
-                    } else {
-                        ::P4::error(ErrorType::ERR_UNSUPPORTED,
-                                    "%1% unsupported range key expression", k);
-                    }
-                } else if (matchType == "optional") {
-                    // Table key fields with match_kind optional with
-                    // "const entries" in the P4 source code will be
-                    // represented using the same "key" and "mask" keys in
-                    // the BMv2 JSON file as table key fields with
-                    // match_kind ternary.  In the P4 source code we only
-                    // allow exact values or a DefaultExpression (_ or
-                    // default), no &&& expression.
-                    if (k->is<IR::Constant>()) {
-                        key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
-                        key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
-                    } else if (k->is<IR::DefaultExpression>()) {
-                        key->emplace("key", stringRepr(0, k8));
-                        key->emplace("mask", stringRepr(0, k8));
-                    } else {
-                        ::P4::error(ErrorType::ERR_UNSUPPORTED,
-                                    "%1%: unsupported optional key expression", k);
-                    }
-                } else {
-                    ::P4::error(ErrorType::ERR_UNKNOWN, "unknown key match type '%2%' for key %1%",
-                                k, matchType);
+                } else if (k->is<IR::Constant>()) {
+                    key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
+                    key->emplace("prefix_length", keyWidth);
+                } else if (k->is<IR::DefaultExpression>()) {
+                    key->emplace("key", stringRepr(0, k8));
+                    key->emplace("prefix_length", 0);
+                } else if (reportErrors) {
+                    ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                                "%1%: unsupported LPM key expression", k);
                 }
-                matchKeys->append(key);
-                keyIndex++;
-            }
-
-            auto action = new Util::JsonObject();
-            auto actionRef = e->getAction();
-            if (!actionRef->is<IR::MethodCallExpression>())
-                ::P4::error(ErrorType::ERR_INVALID, "Invalid action '%1%' in entries list.",
-                            actionRef);
-            auto actionCall = actionRef->to<IR::MethodCallExpression>();
-            auto method = actionCall->method->to<IR::PathExpression>()->path;
-            auto decl = ctxt->refMap->getDeclaration(method, true);
-            auto actionDecl = decl->to<IR::P4Action>();
-            unsigned id = get(ctxt->structure->ids, actionDecl, INVALID_ACTION_ID);
-            BUG_CHECK(id != INVALID_ACTION_ID, "Could not find id for %1%", actionDecl);
-            action->emplace("action_id", id);
-            auto actionData = mkArrayField(action, "action_data"_cs);
-            for (auto arg : *actionCall->arguments) {
-                actionData->append(stringRepr(arg->expression->to<IR::Constant>()->value, 0));
-            }
-            entry->emplace("action_entry", action);
-
-            if (auto priorityAnnotation = e->getAnnotation("priority"_cs)) {
-                const auto &expr = priorityAnnotation->getExpr();
-                if (expr.size() > 1)
-                    ::P4::error(ErrorType::ERR_INVALID, "Invalid priority value %1%", expr);
-                auto priValue = expr.front();
-                if (!priValue->is<IR::Constant>())
-                    ::P4::error(ErrorType::ERR_INVALID,
-                                "Invalid priority value %1%; must be constant.", expr);
-                entry->emplace("priority", priValue->to<IR::Constant>()->value);
-            } else {
-                entry->emplace("priority", entryPriority);
+            } else if (matchType == "range") {
+                if (k->is<IR::Range>()) {
+                    auto kr = k->to<IR::Range>();
+                    key->emplace("start", stringRepr(kr->left->to<IR::Constant>()->value, k8));
+                    key->emplace("end", stringRepr(kr->right->to<IR::Constant>()->value, k8));
+                } else if (k->is<IR::Constant>()) {
+                    key->emplace("start", stringRepr(k->to<IR::Constant>()->value, k8));
+                    key->emplace("end", stringRepr(k->to<IR::Constant>()->value, k8));
+                } else if (k->is<IR::DefaultExpression>()) {
+                    key->emplace("start", stringRepr(0, k8));
+                    key->emplace("end", stringRepr((1 << keyWidth) - 1, k8));  // 2^N -1
+                } else if (reportErrors) {
+                    ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                                "%1% unsupported range key expression", k);
+                }
+            } else if (matchType == "optional") {
+                // Table key fields with match_kind optional with
+                // "const entries" in the P4 source code will be
+                // represented using the same "key" and "mask" keys in
+                // the BMv2 JSON file as table key fields with
+                // match_kind ternary.  In the P4 source code we only
+                // allow exact values or a DefaultExpression (_ or
+                // default), no &&& expression.
+                if (k->is<IR::Constant>()) {
+                    key->emplace("key", stringRepr(k->to<IR::Constant>()->value, k8));
+                    key->emplace("mask", stringRepr(Util::mask(keyWidth), k8));
+                } else if (k->is<IR::DefaultExpression>()) {
+                    key->emplace("key", stringRepr(0, k8));
+                    key->emplace("mask", stringRepr(0, k8));
+                } else if (reportErrors) {
+                    ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                                "%1%: unsupported optional key expression", k);
+                }
+            } else if (reportErrors) {
+                ::P4::error(ErrorType::ERR_UNKNOWN, "unknown key match type '%2%' for key %1%",
+                            k, matchType);
             }
-            entryPriority += 1;
+            matchKeys->append(key);
+            keyIndex++;
+        }
 
-            entries->append(entry);
+        auto action = new Util::JsonObject();
+        auto actionRef = e->getAction();
+        if (!actionRef->is<IR::MethodCallExpression>() && reportErrors)
+            ::P4::error(ErrorType::ERR_INVALID, "Invalid action '%1%' in entries list.",
+                        actionRef);
+        auto actionCall = actionRef->to<IR::MethodCallExpression>();
+        auto method = actionCall->method->to<IR::PathExpression>()->path;
+        auto decl = ctxt->refMap->getDeclaration(method, true);
+        auto actionDecl = decl->to<IR::P4Action>();
+        unsigned id = get(ctxt->structure->ids, actionDecl, INVALID_ACTION_ID);
+        BUG_CHECK(id != INVALID_ACTION_ID, "Could not find id for %1%", actionDecl);
+        action->emplace("action_id", id);
+        auto actionData = mkArrayField(action, "action_data"_cs);
+        for (auto arg : *actionCall->arguments) {
+            actionData->append(stringRepr(arg->expression->to<IR::Constant>()->value, 0));
+        }
+        entry->emplace("action_entry", action);
+
+        if (auto priorityAnnotation = e->getAnnotation("priority"_cs)) {
+            const auto &expr = priorityAnnotation->getExpr();
+            if (expr.size() > 1 && reportErrors)
+                ::P4::error(ErrorType::ERR_INVALID, "Invalid priority value %1%", expr);
+            auto priValue = expr.front();
+            if (!priValue->is<IR::Constant>() && reportErrors)
+                ::P4::error(ErrorType::ERR_INVALID,
+                            "Invalid priority value %1%; must be constant.", expr);
+            entry->emplace("priority", priValue->to<IR::Constant>()->value);
+        } else {
+            entry->emplace("priority", entryPriority);
         }
+        return entry;
     }
     cstring getKeyMatchType(const IR::KeyElement *ke) {
         auto path = ke->matchType->path;
@@ -767,6 +767,11 @@ bool ExpressionConverter::isArrayIndexRuntime(const IR::Expression *e) {
 /// see below for wrap.
 Util::IJson *ExpressionConverter::convert(const IR::Expression *e, bool doFixup, bool wrap,
                                           bool convertBool) {
+    auto memoKey =
+        std::make_tuple(e, doFixup, wrap, convertBool, withConstantWidths, simpleExpressionsOnly);
+    auto cached = memo.find(memoKey);
+    if (cached != memo.end()) return cached->second;
+
     const IR::Expression *expr = e;
     if (doFixup) {
         ArithmeticFixup af(typeMap);
@@ -813,6 +818,7 @@ Util::IJson *ExpressionConverter::convert(const IR::Expression *e, bool doFixup,
             }
         }
     }
+    memo.emplace(memoKey, result);
     return result;
 }
 
@@ -17,6 +17,8 @@ limitations under the License.
 #ifndef BACKENDS_BMV2_COMMON_EXPRESSION_H_
 #define BACKENDS_BMV2_COMMON_EXPRESSION_H_
 
+#include <tuple>
+
 #include "backends/common/programStructure.h"
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/coreLibrary.h"
@@ -61,6 +63,12 @@ class ExpressionConverter : public Inspector {
     /// For this pass to work correctly, the IR tree must be converted
     /// from a DAG to a TREE.
     std::map<const IR::Expression *, Util::IJson *> map;
+    /// Memoized results of convert(), keyed on the expression node and the flags that
+    /// influence the conversion.  Each convert() call runs ArithmeticFixup (which clones
+    /// the expression) and a full inspector walk, and the same expressions are converted
+    /// many times per program; sharing the emitted JSON fragments between call sites is
+    /// already the established behavior of 'map' above.
+    std::map<std::tuple<const IR::Expression *, bool, bool, bool, bool, bool>, Util::IJson *> memo;
     bool leftValue;  // true if converting a left value
     // in some cases the bmv2 JSON requires a 'bitwidth' attribute for hex
     // strings (e.g. for constants in calculation inputs). When this flag is set
@@ -16,6 +16,9 @@ limitations under the License.
 
 #include "helpers.h"
 
+#include <cinttypes>
+#include <limits>
+
 #include "lib/json.h"
 
 namespace P4::BMV2 {
@@ -25,6 +28,7 @@ const cstring MatchImplementation::selectorMatchTypeName = "selector"_cs;
 const cstring MatchImplementation::rangeMatchTypeName = "range"_cs;
 const cstring MatchImplementation::optionalMatchTypeName = "optional"_cs;
 const unsigned TableAttributes::defaultTableSize = 1024;
+const unsigned TableAttributes::streamedEntriesLimit = 1024;
 const cstring V1ModelProperties::jsonMetadataParameterName = "standard_metadata"_cs;
 const cstring V1ModelProperties::validField = "$valid$"_cs;
 
@@ -60,20 +64,28 @@ Util::JsonObject *mkPrimitive(cstring name) {
 
 cstring stringRepr(big_int value, unsigned bytes) {
     std::string sign;
-    std::stringstream r;
-    std::string filler;
+    std::string r;
     if (value < 0) {
         value = -value;
         sign = "-";
     }
-    r << std::hex << value;
-
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+        // almost all keys, masks and action data fit in a machine word; format those
+        // directly instead of going through a stringstream
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%" PRIx64, value.convert_to<uint64_t>());
+        r = buf;
+    } else {
+        std::stringstream str;
+        str << std::hex << value;
+        r = str.str();
+    }
     if (bytes > 0) {
-        int digits = bytes * 2 - r.str().size();
+        int digits = bytes * 2 - r.size();
         BUG_CHECK(digits >= 0, "Cannot represent %1% on %2% bytes", value, bytes);
-        filler = std::string(digits, '0');
+        r.insert(0, digits, '0');
     }
-    return sign + "0x" + filler + r.str();
+    return sign + "0x" + r;
 }
 
 unsigned nextId(cstring group) {
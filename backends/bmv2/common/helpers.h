@@ -46,6 +46,9 @@ class MatchImplementation {
 class TableAttributes {
  public:
     static const unsigned defaultTableSize;
+    /// Const tables with at least this many entries have their JSON emitted in a
+    /// streamed fashion, one entry at a time, during serialization.
+    static const unsigned streamedEntriesLimit;
 };
 
 class V1ModelProperties {
@@ -43,8 +43,7 @@ limitations under the License.
 #include "midend/expandEmit.h"
 #include "midend/expandLookahead.h"
 #include "midend/fillEnumMap.h"
-#include "midend/flattenHeaders.h"
-#include "midend/flattenInterfaceStructs.h"
+#include "midend/flattenStructs.h"
 #include "midend/local_copyprop.h"
 #include "midend/midEndLast.h"
 #include "midend/nestedStructs.h"
@@ -139,8 +138,7 @@ PnaNicMidEnd::PnaNicMidEnd(CompilerOptions &options, std::ostream *outStream)
             new P4::NestedStructs(&typeMap),
             new P4::SimplifySelectList(&typeMap),
             new P4::RemoveSelectBooleans(&typeMap),
-            new P4::FlattenHeaders(&typeMap),
-            new P4::FlattenInterfaceStructs(&typeMap),
+            new P4::FlattenStructs(&typeMap),
             new P4::ReplaceSelectRange(),
             new P4::Predication(),
             new P4::MoveDeclarations(),  // more may have been introduced
@@ -38,6 +38,7 @@ limitations under the License.
 #include "lib/gc.h"
 #include "lib/log.h"
 #include "lib/nullstream.h"
+#include "lib/telemetry.h"
 
 using namespace P4;
 
@@ -101,6 +102,7 @@ int main(int argc, char *const argv[]) {
     BMV2::SimpleSwitchMidEnd midEnd(options);
     midEnd.addDebugHook(hook);
     try {
+        Util::Telemetry::Span telemetrySpan("midend");
         toplevel = midEnd.process(program);
         if (::P4::errorCount() > 1 || toplevel == nullptr || toplevel->getMain() == nullptr)
             return 1;
@@ -120,6 +122,7 @@ int main(int argc, char *const argv[]) {
     // Necessary because BMV2Context is expected at the top of stack in further processing
     AutoCompileContext autoContext(new BMV2::BMV2Context(BMV2::SimpleSwitchContext::get()));
     try {
+        Util::Telemetry::Span telemetrySpan("backend");
         backend->convert(toplevel);
     } catch (const std::exception &bug) {
         std::cerr << bug.what() << std::endl;
@@ -46,8 +46,7 @@ limitations under the License.
 #include "midend/expandEmit.h"
 #include "midend/expandLookahead.h"
 #include "midend/fillEnumMap.h"
-#include "midend/flattenHeaders.h"
-#include "midend/flattenInterfaceStructs.h"
+#include "midend/flattenStructs.h"
 #include "midend/local_copyprop.h"
 #include "midend/midEndLast.h"
 #include "midend/nestedStructs.h"
@@ -106,8 +105,7 @@ SimpleSwitchMidEnd::SimpleSwitchMidEnd(CompilerOptions &options, std::ostream *o
              new P4::NestedStructs(&typeMap),
              new P4::SimplifySelectList(&typeMap),
              new P4::RemoveSelectBooleans(&typeMap),
-             new P4::FlattenHeaders(&typeMap),
-             new P4::FlattenInterfaceStructs(&typeMap),
+             new P4::FlattenStructs(&typeMap),
              new P4::ReplaceSelectRange(),
              new P4::MoveDeclarations(),  // more may have been introduced
              new P4::ConstantFolding(&typeMap),
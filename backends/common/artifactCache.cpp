@@ -0,0 +1,211 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "backends/common/artifactCache.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "lib/log.h"
+
+namespace P4 {
+
+namespace {
+
+/// 64-bit FNV-1a, matching the frontend cache: keys and manifests must be stable across
+/// processes, which rules out any per-process-seeded hash.
+class StableDigest {
+    uint64_t state = 0xcbf29ce484222325ULL;
+
+ public:
+    void add(const void *data, size_t len) {
+        auto *p = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < len; ++i) {
+            state ^= p[i];
+            state *= 0x100000001b3ULL;
+        }
+    }
+    void add(std::string_view s) { add(s.data(), s.size()); }
+    uint64_t value() const { return state; }
+};
+
+constexpr std::string_view manifestMagic = "p4c-artifact-cache 1";
+constexpr std::string_view manifestName = "MANIFEST";
+
+std::filesystem::path entryDir(const std::filesystem::path &cacheDir, const std::string &key) {
+    return cacheDir / key;
+}
+
+std::optional<std::string> fileDigest(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    StableDigest digest;
+    char buffer[16384];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        digest.add(buffer, size_t(in.gcount()));
+    }
+    return absl::StrFormat("%016x", digest.value());
+}
+
+/// One artifact as recorded in the manifest.  The path is relative to the output
+/// directory and comes last on the manifest line, since it may contain blanks.
+struct ManifestEntry {
+    uintmax_t size;
+    std::string digest;
+    std::filesystem::path path;
+};
+
+}  // namespace
+
+std::optional<std::string> ArtifactCache::key(CompilerOptions &options) {
+    auto preprocessorResult = options.preprocess();
+    if (!preprocessorResult) return std::nullopt;
+
+    StableDigest digest;
+    char buffer[16384];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), preprocessorResult->get())) > 0)
+        digest.add(buffer, got);
+
+    // Unlike the frontend cache, artifacts can depend on every option, so fold in the
+    // complete compile command instead of picking out individual flags.  Harnesses that
+    // want hits across runs must keep the command stable.
+    digest.add(options.getCompileCommand() ? options.getCompileCommand().string_view()
+                                           : std::string_view());
+    digest.add(options.compilerVersion ? options.compilerVersion.string_view()
+                                       : std::string_view());
+
+    return absl::StrFormat("%016x", digest.value());
+}
+
+bool ArtifactCache::restore(const std::filesystem::path &cacheDir, const std::string &key,
+                            const std::filesystem::path &outputDir) {
+    auto entry = entryDir(cacheDir, key);
+    std::ifstream manifest(entry / manifestName);
+    if (!manifest) return false;
+
+    std::string line;
+    if (!std::getline(manifest, line) || line != manifestMagic) {
+        LOG1("ignoring artifact cache entry with unknown manifest format for " << key);
+        return false;
+    }
+
+    std::vector<ManifestEntry> artifacts;
+    while (std::getline(manifest, line)) {
+        if (line.empty()) continue;
+        std::istringstream fields(line);
+        ManifestEntry artifact;
+        std::string rest;
+        if (!(fields >> artifact.size >> artifact.digest) || !std::getline(fields, rest) ||
+            rest.size() < 2) {
+            LOG1("ignoring artifact cache entry with malformed manifest for " << key);
+            return false;
+        }
+        artifact.path = rest.substr(1);  // skip the field separator
+        artifacts.push_back(std::move(artifact));
+    }
+
+    // Verify the whole entry before copying anything, so a partial or tampered entry
+    // never leaves a half-populated output directory behind.
+    for (auto &artifact : artifacts) {
+        auto stored = entry / artifact.path;
+        std::error_code ec;
+        if (std::filesystem::file_size(stored, ec) != artifact.size || ec ||
+            fileDigest(stored) != artifact.digest) {
+            LOG1("ignoring artifact cache entry with mismatched contents for " << key);
+            return false;
+        }
+    }
+
+    for (auto &artifact : artifacts) {
+        std::error_code ec;
+        auto target = outputDir / artifact.path;
+        std::filesystem::create_directories(target.parent_path(), ec);
+        std::filesystem::copy_file(entry / artifact.path, target,
+                                   std::filesystem::copy_options::overwrite_existing, ec);
+        if (ec) {
+            LOG1("failed to restore artifact " << artifact.path << " for " << key);
+            return false;
+        }
+    }
+    LOG1("artifact cache hit for " << key << ": restored " << artifacts.size() << " artifacts");
+    return true;
+}
+
+void ArtifactCache::store(const std::filesystem::path &cacheDir, const std::string &key,
+                          const std::filesystem::path &outputDir) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (ec) return;
+
+    // Populate a unique temporary directory and rename it into place, so that concurrent
+    // compiles of the same program never observe a partially written entry; losing the
+    // rename race just discards this copy.
+    auto entry = entryDir(cacheDir, key);
+    auto tmp = entry;
+    tmp += absl::StrFormat(".tmp.%d", getpid());
+    std::filesystem::create_directories(tmp, ec);
+    if (ec) return;
+
+    std::ofstream manifest(tmp / manifestName);
+    if (!manifest) {
+        std::filesystem::remove_all(tmp, ec);
+        return;
+    }
+    manifest << manifestMagic << "\n";
+
+    size_t count = 0;
+    try {
+        for (auto &dirent : std::filesystem::recursive_directory_iterator(
+                 outputDir, std::filesystem::directory_options::skip_permission_denied)) {
+            if (!dirent.is_regular_file()) continue;
+            auto relative = std::filesystem::relative(dirent.path(), outputDir, ec);
+            if (ec) continue;
+            auto digest = fileDigest(dirent.path());
+            if (!digest) continue;
+            std::filesystem::create_directories((tmp / relative).parent_path(), ec);
+            std::filesystem::copy_file(dirent.path(), tmp / relative, ec);
+            if (ec) {
+                std::filesystem::remove_all(tmp, ec);
+                return;
+            }
+            manifest << dirent.file_size() << " " << *digest << " " << relative.generic_string()
+                     << "\n";
+            ++count;
+        }
+    } catch (const std::filesystem::filesystem_error &) {
+        std::filesystem::remove_all(tmp, ec);
+        return;
+    }
+    manifest.close();
+    if (!manifest || count == 0) {
+        std::filesystem::remove_all(tmp, ec);
+        return;
+    }
+
+    std::filesystem::remove_all(entry, ec);
+    std::filesystem::rename(tmp, entry, ec);
+    if (ec) std::filesystem::remove_all(tmp, ec);
+    LOG1("stored artifact cache entry for " << key << " with " << count << " artifacts");
+}
+
+}  // namespace P4
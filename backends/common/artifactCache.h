@@ -0,0 +1,56 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef BACKENDS_COMMON_ARTIFACTCACHE_H_
+#define BACKENDS_COMMON_ARTIFACTCACHE_H_
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "frontends/common/options.h"
+
+namespace P4 {
+
+/// On-disk cache of final compilation artifacts, keyed by a digest of the preprocessed
+/// source and the complete compile command.  A test harness (or a backend driver) computes
+/// the key up front; when a usable entry exists, restore copies the recorded artifacts into
+/// the output directory and the compile can be skipped entirely, and after a successful
+/// compile, store records the output directory for the next run.  Each entry carries a
+/// manifest listing every artifact with its size and digest, and restore rejects entries
+/// whose contents no longer match it.  Stores go through a unique temporary directory that
+/// is renamed into place, so concurrent compiles of the same program never observe partial
+/// entries.  All failures (missing or corrupt entries, I/O errors, lost rename races) are
+/// soft: the caller falls back to a normal compile.
+class ArtifactCache {
+ public:
+    /// Compute the cache key for @options: a digest of the preprocessed source, the full
+    /// compile command, and the compiler version.  Returns std::nullopt if the input
+    /// cannot be preprocessed (the normal compilation path will report the error).
+    static std::optional<std::string> key(CompilerOptions &options);
+
+    /// @return true if @cacheDir holds a usable entry for @key and every artifact its
+    /// manifest records was copied into @outputDir (created if needed).
+    static bool restore(const std::filesystem::path &cacheDir, const std::string &key,
+                        const std::filesystem::path &outputDir);
+
+    /// Record all regular files under @outputDir as the entry for @key in @cacheDir,
+    /// replacing any previous entry.
+    static void store(const std::filesystem::path &cacheDir, const std::string &key,
+                      const std::filesystem::path &outputDir);
+};
+
+}  // namespace P4
+
+#endif /* BACKENDS_COMMON_ARTIFACTCACHE_H_ */
@@ -327,13 +327,7 @@ void CollectMetadataHeaderInfo::pushMetadata(const IR::ParameterList *params,
 }
 
 void CollectMetadataHeaderInfo::pushMetadata(const IR::Parameter *p) {
-    for (auto m : structure->used_metadata) {
-        if (m->to<IR::Type_Name>()->path->name.name ==
-            p->type->to<IR::Type_Name>()->path->name.name) {
-            return;
-        }
-    }
-    structure->used_metadata.push_back(p->type);
+    structure->used_metadata_names.insert(p->type->to<IR::Type_Name>()->path->name.name);
 }
 
 bool CollectMetadataHeaderInfo::preorder(const IR::P4Program *) {
@@ -397,16 +391,13 @@ bool CollectMetadataHeaderInfo::preorder(const IR::P4Program *) {
 }
 
 bool CollectMetadataHeaderInfo::preorder(const IR::Type_Struct *s) {
-    for (auto m : structure->used_metadata) {
-        if (m->to<IR::Type_Name>()->path->name.name == s->name.name) {
-            for (auto field : s->fields) {
-                auto sf = new IR::StructField(
-                    IR::ID(TypeStruct2Name(s->name.name) + "_" + field->name), field->type);
-                LOG4("Adding metadata field: " << sf);
-                structure->compiler_added_fields.push_back(sf);
-            }
-            return true;
-        }
+    if (structure->used_metadata_names.count(s->name.name) == 0) return true;
+    for (auto field : s->fields) {
+        auto sf = new IR::StructField(IR::ID(TypeStruct2Name(s->name.name) + "_" + field->name),
+                                      field->type);
+        LOG4("Adding metadata field: " << sf);
+        structure->compiler_added_fields.push_back(sf);
+        structure->metadata_layout.emplace(sf->name.name, sf);
     }
     return true;
 }
@@ -690,6 +681,7 @@ const IR::Node *InjectFixedMetadataField::preorder(IR::Type_Struct *s) {
         }
         s->fields.push_back(
             new IR::StructField(IR::ID(DirectResourceTableEntryIndex), IR::Type_Bits::get(32)));
+        for (auto sf : s->fields) structure->metadata_layout.emplace(sf->name.name, sf);
         LOG3("Metadata structure after injecting Fixed metadata fields:" << std::endl << s);
     }
     return s;
@@ -1121,6 +1113,7 @@ const IR::Node *CollectLocalVariables::postorder(IR::Type_Struct *s) {
     if (s->name.name == structure->local_metadata_type) {
         for (auto sf : structure->key_fields) {
             s->fields.push_back(sf);
+            structure->metadata_layout.emplace(sf->name.name, sf);
         }
         for (auto kv : localsMap) {
             auto dv = kv.first;
@@ -1137,6 +1130,7 @@ const IR::Node *CollectLocalVariables::postorder(IR::Type_Struct *s) {
                                        << " type: " << field->type << std::endl
                                        << " added to: " << s->name.name);
                     s->fields.push_back(sf);
+                    structure->metadata_layout.emplace(sf->name.name, sf);
                 }
             } else {
                 auto sf = new IR::StructField(IR::ID(kv.second), dv->type);
@@ -1144,6 +1138,7 @@ const IR::Node *CollectLocalVariables::postorder(IR::Type_Struct *s) {
                                    << " type: " << type << std::endl
                                    << " added to: " << s->name.name);
                 s->fields.push_back(sf);
+                structure->metadata_layout.emplace(sf->name.name, sf);
             }
         }
     } else if (s->name.name == structure->header_type) {
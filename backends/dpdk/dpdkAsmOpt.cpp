@@ -16,6 +16,8 @@ limitations under the License.
 
 #include "dpdkAsmOpt.h"
 
+#include <unordered_set>
+
 #include "dpdkUtils.h"
 
 namespace P4::DPDK {
@@ -161,6 +163,88 @@ const IR::IndexedVector<IR::DpdkAsmStatement> *RemoveLabelAfterLabel::removeLabe
     return new_l;
 }
 
+const IR::IndexedVector<IR::DpdkAsmStatement> *OptimizeLabelsAndJumps::optimizeLabelsAndJumps(
+    const IR::IndexedVector<IR::DpdkAsmStatement> &s) {
+    auto *stmts = new IR::IndexedVector<IR::DpdkAsmStatement>(s);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        size_t n = stmts->size();
+        // Index pass: record where each label redirects to -- a label followed by
+        // another label (RemoveLabelAfterLabel) or by an unconditional jmp
+        // (ThreadJumps).
+        std::unordered_map<cstring, cstring> redirect;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            auto label = (*stmts)[i]->to<IR::DpdkLabelStatement>();
+            if (!label) continue;
+            auto next = (*stmts)[i + 1];
+            if (auto l2 = next->to<IR::DpdkLabelStatement>())
+                redirect[label->label] = l2->label;
+            else if (auto jmp = next->to<IR::DpdkJmpLabelStatement>())
+                redirect[label->label] = jmp->label;
+        }
+        // Flatten redirection chains so each jump rewrite below is a single
+        // lookup.  The compiler only emits forward jumps, so chains terminate,
+        // but guard against cycles anyway.
+        for (auto &kv : redirect) {
+            cstring target = kv.second;
+            std::unordered_set<cstring> seen({kv.first});
+            auto it = redirect.find(target);
+            while (it != redirect.end() && seen.insert(target).second) {
+                target = it->second;
+                it = redirect.find(target);
+            }
+            kv.second = target;
+        }
+        // Rewrite pass: retarget jumps and count how often each label is used.
+        std::unordered_map<cstring, int> refs;
+        for (size_t i = 0; i < n; ++i) {
+            if (auto jmp = (*stmts)[i]->to<IR::DpdkJmpStatement>()) {
+                cstring target = jmp->label;
+                auto res = redirect.find(target);
+                if (res != redirect.end()) target = res->second;
+                if (target != jmp->label) {
+                    auto copy = jmp->clone();
+                    copy->label = target;
+                    (*stmts)[i] = copy;
+                    changed = true;
+                }
+                refs[target]++;
+            }
+        }
+        // Rebuild pass: drop labels nothing jumps to (RemoveRedundantLabel), jumps
+        // to the immediately following label and trailing jumps, which can only
+        // leave the list (RemoveConsecutiveJmpAndLabel) -- except jumps to
+        // LABEL_DROP, which lives outside the statement list.
+        auto *new_l = new IR::IndexedVector<IR::DpdkAsmStatement>;
+        new_l->reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            auto stmt = (*stmts)[i];
+            if (auto label = stmt->to<IR::DpdkLabelStatement>()) {
+                if (refs[label->label] == 0) {
+                    changed = true;
+                    continue;
+                }
+            } else if (auto jmp = stmt->to<IR::DpdkJmpStatement>()) {
+                if (i + 1 < n) {
+                    if (auto next = (*stmts)[i + 1]->to<IR::DpdkLabelStatement>()) {
+                        if (next->label == jmp->label) {
+                            changed = true;
+                            continue;
+                        }
+                    }
+                } else if (jmp->label != "LABEL_DROP") {
+                    changed = true;
+                    continue;
+                }
+            }
+            new_l->push_back(stmt);
+        }
+        stmts = new_l;
+    }
+    return stmts;
+}
+
 bool RemoveUnusedMetadataFields::isByteSizeField(const IR::Type *field_type) {
     // DPDK implements bool and error types as bit<8>
     if (field_type->is<IR::Type_Boolean>() || field_type->is<IR::Type_Error>()) return true;
@@ -204,14 +288,14 @@ const IR::Expression *CopyPropagationAndElimination::getIrreplaceableExpr(cstrin
     auto expr = collectUseDef->replacementMap[str];
     const IR::Expression *prev = nullptr;
     cstring exprStr;
-    if (expr) exprStr = expr->toString();
+    if (expr) exprStr = collectUseDef->key(expr);
     while (expr != nullptr && (!allowConst ? expr->is<IR::Member>() : true) && str != exprStr &&
            (!allowConst ? exprStr.startsWith("m.") : true) &&
            collectUseDef->dontEliminate.count(exprStr) == 0 && newUsesInfo[exprStr] == 0 &&
            (expr->is<IR::Member>() ? collectUseDef->haveSingleUseDef(exprStr) : true)) {
         prev = expr;
         expr = collectUseDef->replacementMap[exprStr];
-        if (expr) exprStr = expr->toString();
+        if (expr) exprStr = collectUseDef->key(expr);
     }
     if (expr != nullptr && allowConst)
         return expr;
@@ -224,13 +308,13 @@ const IR::Expression *CopyPropagationAndElimination::getIrreplaceableExpr(cstrin
 const IR::Expression *CopyPropagationAndElimination::replaceIfCopy(const IR::Expression *expr,
                                                                    bool allowConst) {
     if (!expr) return expr;
-    auto str = expr->toString();
+    auto str = collectUseDef->key(expr);
     if (collectUseDef->haveSingleUseDef(str)) {
         if (auto rexpr = getIrreplaceableExpr(str, allowConst)) {
             return rexpr;
         }
     }
-    if (!expr->is<IR::Constant>()) newUsesInfo[expr->toString()]++;
+    if (!expr->is<IR::Constant>()) newUsesInfo[str]++;
     return expr;
 }
 
@@ -246,8 +330,8 @@ const IR::DpdkAsmStatement *CopyPropagationAndElimination::elimCastOrMov(
     } else {
         return stmt;
     }
-    auto src = srcExpr->toString();
-    auto dst = dstExpr->toString();
+    auto src = collectUseDef->key(srcExpr);
+    auto dst = collectUseDef->key(dstExpr);
     bool dropCopy = false;
     if (collectUseDef->dontEliminate.count(dst) == 0 && dst.startsWith("m.") &&
         newUsesInfo[dst] == 0 && collectUseDef->haveSingleUseDef(dst)) {
@@ -255,8 +339,8 @@ const IR::DpdkAsmStatement *CopyPropagationAndElimination::elimCastOrMov(
     }
     if (!dropCopy) {
         auto r = replaceIfCopy(srcExpr);
-        if (dst != r->toString() && dst.startsWith("m.")) {
-            newUsesInfo[r->toString()]++;
+        if (dst != collectUseDef->key(r) && dst.startsWith("m.")) {
+            newUsesInfo[collectUseDef->key(r)]++;
             return new IR::DpdkMovStatement(dstExpr, r);
         } else {
             newUsesInfo[src]++;
@@ -31,6 +31,7 @@ limitations under the License.
 #include "frontends/p4/unusedDeclarations.h"
 #include "ir/ir.h"
 #include "lib/big_int_util.h"
+#include "lib/hvec_map.h"
 #include "lib/json.h"
 
 #define DPDK_TABLE_MAX_KEY_SIZE 64 * 8
@@ -144,6 +145,35 @@ class RemoveLabelAfterLabel : public Transform {
     }
 };
 
+/// Single-traversal engine for the label/jump peephole rules above.
+///
+/// The individual passes (RemoveRedundantLabel, RemoveLabelAfterLabel,
+/// RemoveConsecutiveJmpAndLabel, ThreadJumps) each rescan the full instruction list
+/// per rule and are repeated until convergence, which is quadratic in practice on
+/// the 50k+ instruction lists generated for large programs.  This pass instead
+/// builds an index per list (label redirections and per-label jump reference
+/// counts) and applies all four rules in one O(n) round, iterating rounds until
+/// the index reports no change -- typically two or three.
+class OptimizeLabelsAndJumps : public Transform {
+ public:
+    const IR::IndexedVector<IR::DpdkAsmStatement> *optimizeLabelsAndJumps(
+        const IR::IndexedVector<IR::DpdkAsmStatement> &s);
+
+    const IR::Node *postorder(IR::DpdkListStatement *l) override {
+        const IR::IndexedVector<IR::DpdkAsmStatement> *newStmts;
+        newStmts = optimizeLabelsAndJumps(l->statements);
+        l->statements = *newStmts;
+        return l;
+    }
+
+    const IR::Node *postorder(IR::DpdkAction *l) override {
+        const IR::IndexedVector<IR::DpdkAsmStatement> *newStmts;
+        newStmts = optimizeLabelsAndJumps(l->statements);
+        l->statements = *newStmts;
+        return l;
+    }
+};
+
 /// This pass Collects all metadata struct member used in program.
 class CollectUsedMetadataField : public Inspector {
     ordered_set<cstring> &used_fields;
@@ -153,7 +183,11 @@ class CollectUsedMetadataField : public Inspector {
         : used_fields(used_fields) {}
     bool preorder(const IR::Member *m) override {
         // metadata struct field used like m.<field_name> in expressions
-        if (m->expr->toString() == "m") used_fields.insert(m->member.toString());
+        if (auto pe = m->expr->to<IR::PathExpression>()) {
+            if (pe->path->name == "m") used_fields.insert(m->member.name);
+        } else if (m->expr->toString() == "m") {
+            used_fields.insert(m->member.name);
+        }
         return true;
     }
 };
@@ -351,6 +385,18 @@ class CollectUseDefInfo : public Inspector {
     std::unordered_map<cstring, int> defInfo;
     std::unordered_map<cstring /*def*/, const IR::Expression * /*use*/> replacementMap;
     std::unordered_map<cstring, bool> dontEliminate;
+    /// Expression spellings serve as the keys of all the maps above; they are
+    /// memoized by node identity here because the copy-elimination rewrite later
+    /// queries the very same operand nodes, and rebuilding the spelling per query
+    /// is a measurable cost on large specs.
+    hvec_map<const IR::Expression *, cstring> exprKeys;
+
+    /// The map key for expression @e (its spelling), computed once per node.
+    cstring key(const IR::Expression *e) {
+        auto [it, inserted] = exprKeys.emplace(e, cstring());
+        if (inserted) it->second = e->toString();
+        return it->second;
+    }
 
     explicit CollectUseDefInfo(P4::TypeMap *typeMap) : typeMap(typeMap) {
         dontEliminate["m.pna_main_output_metadata_output_port"_cs] = true;
@@ -359,62 +405,62 @@ class CollectUseDefInfo : public Inspector {
     }
 
     bool preorder(const IR::DpdkJmpCondStatement *b) override {
-        usesInfo[b->src1->toString()]++;
-        usesInfo[b->src2->toString()]++;
+        usesInfo[key(b->src1)]++;
+        usesInfo[key(b->src2)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkLearnStatement *b) override {
-        usesInfo[b->timeout->toString()]++;
-        dontEliminate[b->timeout->toString()] = true;
+        usesInfo[key(b->timeout)]++;
+        dontEliminate[key(b->timeout)] = true;
         if (b->argument) {
-            usesInfo[b->argument->toString()]++;
+            usesInfo[key(b->argument)]++;
             // dpdk expect all action argument to be contiguous starting from first argument
             // passed to learner action
-            dontEliminate[b->argument->toString()] = true;
+            dontEliminate[key(b->argument)] = true;
         }
         return false;
     }
 
     bool preorder(const IR::DpdkUnaryStatement *u) override {
-        usesInfo[u->src->toString()]++;
-        defInfo[u->dst->toString()]++;
+        usesInfo[key(u->src)]++;
+        defInfo[key(u->dst)]++;
         // do not eliminate the destination
-        dontEliminate[u->dst->toString()] = true;
+        dontEliminate[key(u->dst)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkBinaryStatement *b) override {
-        usesInfo[b->src1->toString()]++;
-        usesInfo[b->src2->toString()]++;
-        defInfo[b->dst->toString()]++;
+        usesInfo[key(b->src1)]++;
+        usesInfo[key(b->src2)]++;
+        defInfo[key(b->dst)]++;
         // dst and src1 can not be eliminated, because both are same
         // and dpdk does not allow src1 to be constant
-        dontEliminate[b->dst->toString()] = true;
-        dontEliminate[b->src1->toString()] = true;
+        dontEliminate[key(b->dst)] = true;
+        dontEliminate[key(b->src1)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkMovStatement *mv) override {
-        defInfo[mv->dst->toString()]++;
-        usesInfo[mv->src->toString()]++;
-        replacementMap[mv->dst->toString()] = mv->src;
+        defInfo[key(mv->dst)]++;
+        usesInfo[key(mv->src)]++;
+        replacementMap[key(mv->dst)] = mv->src;
         return false;
     }
 
     bool preorder(const IR::DpdkCastStatement *c) override {
-        usesInfo[c->src->toString()]++;
-        defInfo[c->dst->toString()]++;
-        replacementMap[c->dst->toString()] = c->src;
+        usesInfo[key(c->src)]++;
+        defInfo[key(c->dst)]++;
+        replacementMap[key(c->dst)] = c->src;
         return false;
     }
 
     bool preorder(const IR::DpdkMirrorStatement *m) override {
-        usesInfo[m->slotId->toString()]++;
-        usesInfo[m->sessionId->toString()]++;
+        usesInfo[key(m->slotId)]++;
+        usesInfo[key(m->sessionId)]++;
         // dpdk expect it as metadata struct member
-        dontEliminate[m->slotId->toString()] = true;
-        dontEliminate[m->sessionId->toString()] = true;
+        dontEliminate[key(m->slotId)] = true;
+        dontEliminate[key(m->sessionId)] = true;
         return false;
     }
 
@@ -422,7 +468,7 @@ class CollectUseDefInfo : public Inspector {
         auto type = typeMap->getType(e->header)->to<IR::Type_Header>();
         if (type)
             for (auto f : type->fields) {
-                cstring name = e->header->toString() + "." + f->name.toString();
+                cstring name = key(e->header) + "." + f->name.toString();
                 usesInfo[name]++;
             }
         return false;
@@ -432,13 +478,13 @@ class CollectUseDefInfo : public Inspector {
         auto type = typeMap->getType(e->header)->to<IR::Type_Header>();
         if (type)
             for (auto f : type->fields) {
-                cstring name = e->header->toString() + "." + f->name.toString();
+                cstring name = key(e->header) + "." + f->name.toString();
                 defInfo[name]++;
             }
         if (e->length) {
-            usesInfo[e->length->toString()]++;
+            usesInfo[key(e->length)]++;
             // dpdk expect length to be metadata struct member
-            dontEliminate[e->length->toString()] = true;
+            dontEliminate[key(e->length)] = true;
         }
         return false;
     }
@@ -447,106 +493,106 @@ class CollectUseDefInfo : public Inspector {
         auto type = typeMap->getType(l->header)->to<IR::Type_Header>();
         if (type)
             for (auto f : type->fields) {
-                cstring name = l->header->toString() + "." + f->name.toString();
+                cstring name = key(l->header) + "." + f->name.toString();
                 defInfo[name]++;
             }
         return false;
     }
 
     bool preorder(const IR::DpdkRxStatement *r) override {
-        usesInfo[r->port->toString()]++;
+        usesInfo[key(r->port)]++;
         // always required
-        dontEliminate[r->port->toString()] = true;
+        dontEliminate[key(r->port)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkTxStatement *t) override {
-        usesInfo[t->port->toString()]++;
+        usesInfo[key(t->port)]++;
         // always required
-        dontEliminate[t->port->toString()] = true;
+        dontEliminate[key(t->port)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkRecircidStatement *t) override {
-        usesInfo[t->pass->toString()]++;
+        usesInfo[key(t->pass)]++;
         // uses standard metadata fields
-        dontEliminate[t->pass->toString()] = true;
+        dontEliminate[key(t->pass)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkRearmStatement *r) override {
         if (r->timeout) {
-            usesInfo[r->timeout->toString()]++;
+            usesInfo[key(r->timeout)]++;
             // dpdk requires it in metadata struct
-            dontEliminate[r->timeout->toString()] = true;
+            dontEliminate[key(r->timeout)] = true;
         }
         return false;
     }
 
     bool preorder(const IR::DpdkChecksumAddStatement *c) override {
-        usesInfo[c->field->toString()]++;
+        usesInfo[key(c->field)]++;
         // dpdk requires it in header
         if (auto m = c->field->to<IR::Member>())
-            if (m->expr->is<IR::Type_Header>()) dontEliminate[c->field->toString()] = true;
+            if (m->expr->is<IR::Type_Header>()) dontEliminate[key(c->field)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkChecksumSubStatement *c) override {
-        usesInfo[c->field->toString()]++;
+        usesInfo[key(c->field)]++;
         // dpdk requires it in header
         if (auto m = c->field->to<IR::Member>())
-            if (m->expr->is<IR::Type_Header>()) dontEliminate[c->field->toString()] = true;
+            if (m->expr->is<IR::Type_Header>()) dontEliminate[key(c->field)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkGetHashStatement *c) override {
-        usesInfo[c->dst->toString()]++;
+        usesInfo[key(c->dst)]++;
         // dpdk requires it in metadata struct
-        dontEliminate[c->dst->toString()] = true;
+        dontEliminate[key(c->dst)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkVerifyStatement *v) override {
-        usesInfo[v->condition->toString()]++;
-        usesInfo[v->error->toString()]++;
+        usesInfo[key(v->condition)]++;
+        usesInfo[key(v->error)]++;
         // dpdk requires it in metadata struct
-        dontEliminate[v->condition->toString()] = true;
-        dontEliminate[v->error->toString()] = true;
+        dontEliminate[key(v->condition)] = true;
+        dontEliminate[key(v->error)] = true;
         return false;
     }
 
     bool preorder(const IR::DpdkMeterDeclStatement *c) override {
-        usesInfo[c->size->toString()]++;
+        usesInfo[key(c->size)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkMeterExecuteStatement *e) override {
-        usesInfo[e->index->toString()]++;
-        if (e->length) usesInfo[e->length->toString()]++;
-        usesInfo[e->color_in->toString()]++;
-        usesInfo[e->color_out->toString()]++;
+        usesInfo[key(e->index)]++;
+        if (e->length) usesInfo[key(e->length)]++;
+        usesInfo[key(e->color_in)]++;
+        usesInfo[key(e->color_out)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkCounterCountStatement *c) override {
-        usesInfo[c->index->toString()]++;
-        if (c->incr) usesInfo[c->incr->toString()]++;
+        usesInfo[key(c->index)]++;
+        if (c->incr) usesInfo[key(c->incr)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkRegisterDeclStatement *r) override {
-        usesInfo[r->size->toString()]++;
+        usesInfo[key(r->size)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkRegisterReadStatement *r) override {
-        usesInfo[r->index->toString()]++;
-        defInfo[r->dst->toString()]++;
+        usesInfo[key(r->index)]++;
+        defInfo[key(r->dst)]++;
         return false;
     }
 
     bool preorder(const IR::DpdkRegisterWriteStatement *r) override {
-        usesInfo[r->index->toString()]++;
+        usesInfo[key(r->index)]++;
         return false;
     }
 
@@ -554,7 +600,7 @@ class CollectUseDefInfo : public Inspector {
         auto keys = t->match_keys;
         if (keys)
             for (auto ke : keys->keyElements) {
-                dontEliminate[ke->expression->toString()] = true;
+                dontEliminate[key(ke->expression)] = true;
             }
         return false;
     }
@@ -643,13 +689,9 @@ class DpdkAsmOptimization : public PassRepeated {
  private:
  public:
     DpdkAsmOptimization() {
-        passes.push_back(new RemoveRedundantLabel);
-        auto r = new PassRepeated{new RemoveLabelAfterLabel};
-        passes.push_back(r);
-        passes.push_back(new RemoveConsecutiveJmpAndLabel);
-        passes.push_back(new RemoveRedundantLabel);
-        passes.push_back(r);
-        passes.push_back(new ThreadJumps);
+        // Applies all the label/jump rules above in one indexed traversal; the
+        // individual passes are kept for standalone use and as documentation.
+        passes.push_back(new OptimizeLabelsAndJumps);
     }
 };
 
@@ -1532,15 +1532,8 @@ void ConvertStatementToDpdk::add128bitwiseInstr(const IR::Expression *src1Op,
         createSandboxHeaderType = true;
         createSandboxHeader();
     }
-    const IR::Type_Header *Type_Header = nullptr;
-    const IR::Type_Header *Type_Tmp = nullptr;
-    for (auto header : structure->header_types) {
-        if (header.first == "_p4c_sandbox_header_t") {
-            Type_Header = header.second;
-        } else if (header.first == "_p4c_tmp128_t") {
-            Type_Tmp = header.second;
-        }
-    }
+    const IR::Type_Header *Type_Header = getSandboxHeaderType("_p4c_sandbox_header_t"_cs);
+    const IR::Type_Header *Type_Tmp = getSandboxHeaderType("_p4c_tmp128_t"_cs);
     if (Type_Header == nullptr || Type_Tmp == nullptr) {
         BUG("Header type not found");
     }
@@ -1622,11 +1615,15 @@ void ConvertStatementToDpdk::add128bitwiseInstr(const IR::Expression *src1Op,
 }
 
 void ConvertStatementToDpdk::createSandboxHeader() {
+    // May run on the egress conversion thread under --parallelPipelines; the
+    // Type_Bits::get calls are safe there because the interning factories take
+    // their own lock, while convertLock below only protects the structure.
     auto fields = new IR::IndexedVector<IR::StructField>;
     fields->push_back(new IR::StructField("upper_half", IR::Type_Bits::get(64)));
     fields->push_back(new IR::StructField("lower_half", IR::Type_Bits::get(64)));
     const IR::Type_Header *headerStruct =
         new IR::Type_Header(IR::ID("_p4c_sandbox_header_t"), *fields);
+    std::lock_guard<std::mutex> lock(structure->convertLock);
     structure->header_types.emplace(cstring("_p4c_sandbox_header_t"), headerStruct);
 }
 
@@ -1634,21 +1631,27 @@ void ConvertStatementToDpdk::createTmpVarForSandbox() {
     auto fields = new IR::IndexedVector<IR::StructField>;
     fields->push_back(new IR::StructField("inter", IR::Type_Bits::get(64)));
     const IR::Type_Header *headerStruct = new IR::Type_Header(IR::ID("_p4c_tmp128_t"), *fields);
+    std::lock_guard<std::mutex> lock(structure->convertLock);
     structure->header_types.emplace(cstring("_p4c_tmp128_t"), headerStruct);
 }
 
+/// Looks up one of the compiler-created sandbox header types.  Takes the structure's
+/// convert lock because the other pipeline's conversion thread may be inserting into
+/// header_types concurrently (--parallelPipelines).
+const IR::Type_Header *ConvertStatementToDpdk::getSandboxHeaderType(cstring name) {
+    std::lock_guard<std::mutex> lock(structure->convertLock);
+    auto it = structure->header_types.find(name);
+    if (it == structure->header_types.end()) return nullptr;
+    return it->second;
+}
+
 void ConvertStatementToDpdk::add128ComparisonInstr(cstring true_label, const IR::Expression *src1Op,
                                                    const IR::Expression *src2Op, const char *op) {
     if (!createSandboxHeaderType) {
         createSandboxHeaderType = true;
         createSandboxHeader();
     }
-    const IR::Type_Header *Type_Header = nullptr;
-    for (auto header : structure->header_types) {
-        if (header.first == "_p4c_sandbox_header_t") {
-            Type_Header = header.second;
-        }
-    }
+    const IR::Type_Header *Type_Header = getSandboxHeaderType("_p4c_sandbox_header_t"_cs);
     if (Type_Header == nullptr) {
         BUG("Header type not found");
     }
@@ -1708,15 +1711,8 @@ void ConvertStatementToDpdk::add128bitComplInstr(const IR::Expression *dst,
         createSandboxHeaderType = true;
         createSandboxHeader();
     }
-    const IR::Type_Header *Type_Header = nullptr;
-    const IR::Type_Header *Type_Tmp = nullptr;
-    for (auto header : structure->header_types) {
-        if (header.first == "_p4c_sandbox_header_t") {
-            Type_Header = header.second;
-        } else if (header.first == "_p4c_tmp128_t") {
-            Type_Tmp = header.second;
-        }
-    }
+    const IR::Type_Header *Type_Header = getSandboxHeaderType("_p4c_sandbox_header_t"_cs);
+    const IR::Type_Header *Type_Tmp = getSandboxHeaderType("_p4c_tmp128_t"_cs);
     if (Type_Header == nullptr || Type_Tmp == nullptr) {
         BUG("Header type not found");
     }
@@ -1752,12 +1748,7 @@ void ConvertStatementToDpdk::add128bitMovInstr(const IR::Expression *left,
         createSandboxHeaderType = true;
         createSandboxHeader();
     }
-    const IR::Type_Header *Type_Header = nullptr;
-    for (auto header : structure->header_types) {
-        if (header.first == "_p4c_sandbox_header_t") {
-            Type_Header = header.second;
-        }
-    }
+    const IR::Type_Header *Type_Header = getSandboxHeaderType("_p4c_sandbox_header_t"_cs);
     if (Type_Header == nullptr) {
         BUG("Header type not found");
     }
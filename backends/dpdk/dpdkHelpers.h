@@ -166,6 +166,7 @@ class ConvertStatementToDpdk : public Inspector {
     bool checkIfConsecutiveHdrMdfields(const IR::Argument *field);
     void createSandboxHeader();
     void createTmpVarForSandbox();
+    const IR::Type_Header *getSandboxHeaderType(cstring name);
     friend class BranchingInstructionGeneration;
 
  public:
@@ -16,8 +16,14 @@ limitations under the License.
 
 #include "dpdkProgram.h"
 
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
+#include "lib/gc.h"
+
 #include "backend.h"
 #include "dpdkHelpers.h"
 #include "ir/dbprint.h"
@@ -104,51 +110,100 @@ const IR::DpdkAsmProgram *ConvertToDpdkProgram::create(IR::P4Program *prog) {
         }
     }
 
+    // The ingress and egress halves of a PSA pipeline share no P4 state, so their
+    // conversion to asm can run on separate worker threads.  The only sinks they
+    // share are the program structure (guarded by its convert lock), the reference
+    // map's name generator (serialized below) and the metadata structure, which the
+    // egress half converts into its own clone; the egress-added fields are spliced
+    // back after the join, so the merged field order is deterministic.
+    bool parallel = options.parallelPipelines && options.enableEgress && metadataStruct != nullptr;
+    size_t sharedFields = metadataStruct != nullptr ? metadataStruct->fields.size() : 0;
+    IR::Type_Struct *egressMetadataStruct =
+        parallel ? metadataStruct->clone() : metadataStruct;
+
     IR::IndexedVector<IR::DpdkAsmStatement> statements;
 
     auto ingress_parser_converter =
         new ConvertToDpdkParser(refmap, typemap, structure, metadataStruct);
     auto egress_parser_converter =
-        new ConvertToDpdkParser(refmap, typemap, structure, metadataStruct);
+        new ConvertToDpdkParser(refmap, typemap, structure, egressMetadataStruct);
+    auto ingress_converter = new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct);
+    auto egress_converter =
+        new ConvertToDpdkControl(refmap, typemap, structure, egressMetadataStruct);
+    auto ingress_deparser_converter =
+        new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct, true);
+    auto egress_deparser_converter =
+        new ConvertToDpdkControl(refmap, typemap, structure, egressMetadataStruct);
+
+    // Conversion work items in the order the serial implementation runs them; the
+    // parallel path partitions them by pipeline half instead.
+    struct ConvertTask {
+        bool egress;
+        std::function<void()> run;
+    };
+    std::vector<ConvertTask> tasks;
     for (auto kv : structure->parsers) {
         if (kv.first == "IngressParser")
-            kv.second->apply(*ingress_parser_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_parser_converter); }});
         else if (kv.first == "EgressParser") {
-            if (options.enableEgress) kv.second->apply(*egress_parser_converter);
+            if (options.enableEgress)
+                tasks.push_back({true, [=] { kv.second->apply(*egress_parser_converter); }});
         } else if (kv.first == "MainParserT")
-            kv.second->apply(*ingress_parser_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_parser_converter); }});
         else
             BUG("Unknown parser %s", kv.second->name);
     }
-    auto ingress_converter = new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct);
-    auto egress_converter = new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct);
     for (auto kv : structure->pipelines) {
         if (kv.first == "Ingress")
-            kv.second->apply(*ingress_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_converter); }});
         else if (kv.first == "Egress") {
-            if (options.enableEgress) kv.second->apply(*egress_converter);
+            if (options.enableEgress)
+                tasks.push_back({true, [=] { kv.second->apply(*egress_converter); }});
         } else if (kv.first == "PreControlT")
-            kv.second->apply(*ingress_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_converter); }});
         else if (kv.first == "MainControlT")
-            kv.second->apply(*ingress_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_converter); }});
         else
             BUG("Unknown control block %s", kv.second->name);
     }
-    auto ingress_deparser_converter =
-        new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct, true);
-    auto egress_deparser_converter =
-        new ConvertToDpdkControl(refmap, typemap, structure, metadataStruct);
     for (auto kv : structure->deparsers) {
         if (kv.first == "IngressDeparser")
-            kv.second->apply(*ingress_deparser_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_deparser_converter); }});
         else if (kv.first == "EgressDeparser") {
-            if (options.enableEgress) kv.second->apply(*egress_deparser_converter);
+            if (options.enableEgress)
+                tasks.push_back({true, [=] { kv.second->apply(*egress_deparser_converter); }});
         } else if (kv.first == "MainDeparserT")
-            kv.second->apply(*ingress_deparser_converter);
+            tasks.push_back({false, [=] { kv.second->apply(*ingress_deparser_converter); }});
         else
             BUG("Unknown deparser block %s", kv.second->name);
     }
 
+    if (parallel) {
+        static std::once_flag allow_threads;
+        std::call_once(allow_threads, gc_allow_threads);
+        std::exception_ptr egressFailure;
+        std::thread egressThread([&] {
+            gc_thread_scope gc_scope;
+            try {
+                for (auto &task : tasks)
+                    if (task.egress) task.run();
+            } catch (...) {
+                egressFailure = std::current_exception();
+            }
+        });
+        for (auto &task : tasks)
+            if (!task.egress) task.run();
+        egressThread.join();
+        if (egressFailure) std::rethrow_exception(egressFailure);
+        // Both halves start from the same cloned field prefix; splice the fields the
+        // egress half added behind the ones the ingress half added.  Names cannot
+        // collide, as generated names come from the serialized name generator.
+        for (size_t i = sharedFields; i < egressMetadataStruct->fields.size(); ++i)
+            metadataStruct->fields.push_back(egressMetadataStruct->fields[i]);
+    } else {
+        for (auto &task : tasks) task.run();
+    }
+
     IR::IndexedVector<IR::DpdkAsmStatement> instr;
     if (structure->isPNA())
         instr.append(create_pna_preamble());
@@ -260,8 +315,15 @@ cstring ConvertToDpdkParser::append_parser_name(const IR::P4Parser *p, cstring l
 
 IR::Declaration_Variable *ConvertToDpdkParser::addNewTmpVarToMetadata(cstring name,
                                                                       const IR::Type *type) {
-    auto newTmpVar =
-        new IR::Declaration_Variable(IR::ID(refmap->newName(name.string_view())), type);
+    // The reference map is shared with the conversion of the other pipeline half
+    // (--parallelPipelines) and newName mutates its used-name table; serializing it
+    // also keeps generated names unique across the two metadata structures.
+    cstring tmpName;
+    {
+        std::lock_guard<std::mutex> lock(structure->convertLock);
+        tmpName = refmap->newName(name.string_view());
+    }
+    auto newTmpVar = new IR::Declaration_Variable(IR::ID(tmpName), type);
     metadataStruct->fields.push_back(
         new IR::StructField(IR::ID(newTmpVar->name.name), newTmpVar->type));
     return newTmpVar;
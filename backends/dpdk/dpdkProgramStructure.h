@@ -1,6 +1,8 @@
 #ifndef BACKENDS_DPDK_DPDKPROGRAMSTRUCTURE_H_
 #define BACKENDS_DPDK_DPDKPROGRAMSTRUCTURE_H_
 
+#include <mutex>
+
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/typeMap.h"
 #include "ir/ir.h"
@@ -64,14 +66,29 @@ struct DpdkProgramStructure {
     cstring header_type = cstring::empty;
     IR::IndexedVector<IR::StructField> compiler_added_fields;
     IR::IndexedVector<IR::StructField> key_fields;
-    IR::Vector<IR::Type> used_metadata;
+    /// Names of the metadata struct types merged into the single metadata struct.
+    ordered_set<cstring> used_metadata_names;
+    /// The flattened metadata layout indexed by flattened field name.  Seeded once
+    /// by CollectMetadataHeaderInfo and kept current by the passes that extend the
+    /// single metadata struct, so conversion passes can query the layout without
+    /// re-walking the metadata structs.
+    ordered_map<cstring, const IR::StructField *> metadata_layout;
     ordered_map<cstring, std::vector<struct hdrFieldInfo>> hdrFieldInfoList;
     ordered_map<cstring, IR::ParameterList *> defActionParamList;
 
-    void push_variable(const IR::DpdkDeclaration *d) { variables.push_back(d); }
+    /// Serializes updates to the collections above while the ingress and egress
+    /// pipelines are converted on separate worker threads (--parallelPipelines,
+    /// see ConvertToDpdkProgram::create); uncontended during serial conversion.
+    std::mutex convertLock;
+
+    void push_variable(const IR::DpdkDeclaration *d) {
+        std::lock_guard<std::mutex> lock(convertLock);
+        variables.push_back(d);
+    }
     IR::IndexedVector<IR::DpdkDeclaration> &get_globals() { return variables; }
 
     void addHeaderInstances(const IR::DpdkHeaderInstance *d) {
+        std::lock_guard<std::mutex> lock(convertLock);
         if (header_instances.find(d->name->toString()) == header_instances.end()) {
             header_instances.emplace(d->name->toString(), d);
         }
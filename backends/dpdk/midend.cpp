@@ -46,8 +46,7 @@ limitations under the License.
 #include "midend/expandEmit.h"
 #include "midend/expandLookahead.h"
 #include "midend/fillEnumMap.h"
-#include "midend/flattenHeaders.h"
-#include "midend/flattenInterfaceStructs.h"
+#include "midend/flattenStructs.h"
 #include "midend/flattenUnions.h"
 #include "midend/hsIndexSimplify.h"
 #include "midend/local_copyprop.h"
@@ -199,8 +198,7 @@ DpdkMidEnd::DpdkMidEnd(CompilerOptions &options, std::ostream *outStream) {
             new P4::NestedStructs(&typeMap),
             new P4::SimplifySelectList(&typeMap),
             new P4::RemoveSelectBooleans(&typeMap),
-            new P4::FlattenHeaders(&typeMap),
-            new P4::FlattenInterfaceStructs(&typeMap),
+            new P4::FlattenStructs(&typeMap),
             new P4::EliminateTypedef(&typeMap),
             new P4::HSIndexSimplifier(&typeMap),
             new P4::ParsersUnroll(config, &refMap, &typeMap),
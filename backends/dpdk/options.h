@@ -36,6 +36,8 @@ class DpdkOptions : public CompilerOptions {
     bool loadIRFromJson = false;
     /// Enable/disable Egress pipeline in PSA.
     bool enableEgress = false;
+    /// Convert the ingress and egress pipelines to asm on separate worker threads.
+    bool parallelPipelines = false;
 
     DpdkOptions() {
         registerOption(
@@ -54,6 +56,15 @@ class DpdkOptions : public CompilerOptions {
                 return true;
             },
             "[Dpdk back-end] Enable egress pipeline's codegen\n", OptionFlags::Hide);
+        registerOption(
+            "--parallelPipelines", nullptr,
+            [this](const char *) {
+                parallelPipelines = true;
+                return true;
+            },
+            "[Dpdk back-end] Convert the ingress and egress pipelines on separate worker "
+            "threads (only useful together with --enableEgress)\n",
+            OptionFlags::Hide);
 
         registerOption(
             "--bf-rt-schema", "file",
@@ -48,8 +48,8 @@ void emitFilterModel(const EbpfOptions &options, Target *target, const IR::Tople
 
     ebpfprog->emitH(&h, hfile);
     ebpfprog->emitC(&c, hfile);
-    *cstream << c.toString();
-    *hstream << h.toString();
+    c.writeTo(*cstream);
+    h.writeTo(*hstream);
     cstream->flush();
     hstream->flush();
 }
@@ -145,16 +145,22 @@ void EBPFProgram::emitC(CodeBuilder *builder, const std::filesystem::path &heade
 }
 
 void EBPFProgram::emitGeneratedComment(CodeBuilder *builder) {
-    std::chrono::time_point<std::chrono::system_clock> now = std::chrono::system_clock::now();
-    std::time_t time = std::chrono::system_clock::to_time_t(now);
-    builder->append("/* Automatically generated by ");
-    builder->append(options.exe_name);
-    builder->append(" from ");
-    builder->append(options.file);
-    builder->append(" on ");
-    builder->append(std::ctime(&time));
-    builder->append(" */");
-    builder->newline();
+    // Built once per program and appended by reference, so the C and H files (and
+    // the several per-section emitters in the TC/PSA backends) share one fragment
+    // and one timestamp.
+    if (generatedComment.size() == 0) {
+        std::chrono::time_point<std::chrono::system_clock> now = std::chrono::system_clock::now();
+        std::time_t time = std::chrono::system_clock::to_time_t(now);
+        generatedComment.append("/* Automatically generated by ");
+        generatedComment.append(options.exe_name);
+        generatedComment.append(" from ");
+        generatedComment.append(options.file);
+        generatedComment.append(" on ");
+        generatedComment.append(std::ctime(&time));
+        generatedComment.append(" */");
+        generatedComment.newline();
+    }
+    builder->append(generatedComment);
 }
 
 void EBPFProgram::emitH(CodeBuilder *builder, const std::filesystem::path &) {
@@ -59,6 +59,8 @@ class EBPFProgram : public EBPFObject {
     cstring errorEnum;
     cstring license = "GPL"_cs;  /// TODO: this should be a compiler option probably
     cstring arrayIndexType = "u32"_cs;
+    /// Cache for emitGeneratedComment; see there.
+    Util::SourceCodeBuilder generatedComment;
 
     virtual bool build();  /// return 'true' on success
 
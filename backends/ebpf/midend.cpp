@@ -37,17 +37,16 @@ limitations under the License.
 #include "midend/eliminateTuples.h"
 #include "midend/expandEmit.h"
 #include "midend/local_copyprop.h"
+#include "midend/lowerSelects.h"
 #include "midend/midEndLast.h"
 #include "midend/noMatch.h"
 #include "midend/parserUnroll.h"
 #include "midend/removeExits.h"
 #include "midend/removeLeftSlices.h"
 #include "midend/removeMiss.h"
-#include "midend/removeSelectBooleans.h"
 #include "midend/simplifyKey.h"
 #include "midend/simplifySelectCases.h"
 #include "midend/simplifySelectList.h"
-#include "midend/singleArgumentSelect.h"
 #include "midend/tableHit.h"
 #include "midend/validateProperties.h"
 
@@ -102,8 +101,7 @@ const IR::ToplevelBlock *MidEnd::run(EbpfOptions &options, const IR::P4Program *
              new P4::EliminateTuples(&typeMap),
              new P4::SimplifySelectList(&typeMap),
              new P4::MoveDeclarations(),  // more may have been introduced
-             new P4::RemoveSelectBooleans(&typeMap),
-             new P4::SingleArgumentSelect(&typeMap),
+             new P4::LowerSelects(&typeMap),
              new P4::ConstantFolding(&typeMap),
              new P4::SimplifyControlFlow(&typeMap, true),
              new P4::TableHit(&typeMap),
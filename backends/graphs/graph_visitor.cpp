@@ -16,7 +16,12 @@
 
 #include "graph_visitor.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include "graphs.h"
+#include "lib/gc.h"
 #include "lib/nullstream.h"
 
 namespace P4::graphs {
@@ -170,13 +175,34 @@ void Graph_visitor::forLoopFullGraph(std::vector<Graph *> &graphsArray, fullGrap
 void Graph_visitor::process(std::vector<Graph *> &controlGraphsArray,
                             std::vector<Graph *> &parserGraphsArray) {
     if (graphs) {
+        // Decorate the graphs serially (GraphAttributeSetter mutates them), then
+        // write the dot files in parallel: each graph goes to its own file and
+        // write_graphviz only reads the graph, so the writes are independent.
+        std::vector<Graph *> work;
         for (auto g : controlGraphsArray) {
             GraphAttributeSetter()(*g);
-            writeGraphToFile(*g, boost::get_property(*g, boost::graph_name));
+            work.push_back(g);
         }
         for (auto g : parserGraphsArray) {
             GraphAttributeSetter()(*g);
-            writeGraphToFile(*g, boost::get_property(*g, boost::graph_name));
+            work.push_back(g);
+        }
+        size_t nthreads =
+            std::min<size_t>(work.size(), std::max(1u, std::thread::hardware_concurrency()));
+        if (nthreads > 1) {
+            static std::once_flag allow_threads;
+            std::call_once(allow_threads, gc_allow_threads);
+            std::atomic<size_t> next(0);
+            auto writer = [&]() {
+                gc_thread_scope gc_scope;
+                for (size_t i = next++; i < work.size(); i = next++)
+                    writeGraphToFile(*work[i], boost::get_property(*work[i], boost::graph_name));
+            };
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < nthreads; ++t) threads.emplace_back(writer);
+            for (auto &t : threads) t.join();
+        } else {
+            for (auto g : work) writeGraphToFile(*g, boost::get_property(*g, boost::graph_name));
         }
     }
 
@@ -17,7 +17,8 @@ int main(int argc, char *const argv[]) {
     }
     options.setInputFile();
 
-    std::stringstream formattedOutput = P4Fmt::getFormattedOutput(options.file);
+    std::stringstream formattedOutput =
+        P4Fmt::getFormattedOutput(options.file, options.formatRange());
     if (formattedOutput.str().empty()) {
         return EXIT_FAILURE;
     };
@@ -1,5 +1,9 @@
 #include "options.h"
 
+#include <cstdio>
+
+#include "lib/error.h"
+
 namespace P4::P4Fmt {
 
 P4fmtOptions::P4fmtOptions() {
@@ -10,8 +14,27 @@ P4fmtOptions::P4fmtOptions() {
             return true;
         },
         "Write formatted output to outfile");
+    registerOption(
+        "--range", "begin:end",
+        [this](const char *arg) {
+            size_t begin = 0;
+            size_t end = 0;
+            if (sscanf(arg, "%zu:%zu", &begin, &end) != 2 || begin > end) {
+                ::P4::error(ErrorType::ERR_INVALID,
+                            "Invalid --range '%1%'; expected begin:end byte offsets.", arg);
+                return false;
+            }
+            fmtRange = std::make_pair(begin, end);
+            return true;
+        },
+        "Reformat only the top-level declarations overlapping the given byte range "
+        "of the input file; the rest of the file is emitted verbatim.");
 }
 
 const std::filesystem::path &P4fmtOptions::outputFile() const { return outFile; }
 
+const std::optional<std::pair<size_t, size_t>> &P4fmtOptions::formatRange() const {
+    return fmtRange;
+}
+
 }  // namespace P4::P4Fmt
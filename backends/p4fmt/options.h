@@ -1,6 +1,9 @@
 #ifndef BACKENDS_P4FMT_OPTIONS_H_
 #define BACKENDS_P4FMT_OPTIONS_H_
 
+#include <optional>
+#include <utility>
+
 #include "frontends/common/options.h"
 #include "frontends/common/parser_options.h"
 
@@ -17,9 +20,15 @@ class P4fmtOptions : public CompilerOptions {
 
     const std::filesystem::path &outputFile() const;
 
+    /// Byte range to reformat (see --range); nullopt means format the whole file.
+    const std::optional<std::pair<size_t, size_t>> &formatRange() const;
+
  private:
     /// File to output to.
     std::filesystem::path outFile;
+
+    /// Restricts formatting to the declarations overlapping this byte range.
+    std::optional<std::pair<size_t, size_t>> fmtRange;
 };
 
 using P4FmtContext = P4CContextWithOptions<P4fmtOptions>;
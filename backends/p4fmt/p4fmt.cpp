@@ -1,5 +1,10 @@
 #include "backends/p4fmt/p4fmt.h"
 
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "backends/p4fmt/attach.h"
 #include "backends/p4fmt/p4formatter.h"
 #include "frontends/common/parseInput.h"
@@ -38,7 +43,64 @@ std::optional<std::pair<const IR::P4Program *, const Util::InputSources *>> pars
     return result;
 }
 
-std::stringstream getFormattedOutput(std::filesystem::path inputFile) {
+namespace {
+
+/// Maps line/column source positions back to byte offsets in a source buffer.
+class ByteOffsetMap {
+    std::vector<size_t> lineStarts;
+    size_t size;
+
+ public:
+    explicit ByteOffsetMap(const std::string &text) : size(text.size()) {
+        lineStarts.push_back(0);
+        for (size_t i = 0; i < text.size(); ++i)
+            if (text[i] == '\n') lineStarts.push_back(i + 1);
+    }
+
+    /// Byte offset for @pos, clamped to the end of the buffer.
+    size_t offset(const Util::SourcePosition &pos) const {
+        if (!pos.isValid() || pos.getLineNumber() > lineStarts.size()) return size;
+        return std::min(size, lineStarts[pos.getLineNumber() - 1] + pos.getColumnNumber());
+    }
+};
+
+/// Reformats only the top-level declarations of @program overlapping the byte
+/// range @range of @file, copying everything else verbatim from the source
+/// buffer. This keeps format-on-save cheap for small edits in large files.
+void formatRange(const IR::P4Program *program, std::pair<size_t, size_t> range,
+                 const std::filesystem::path &file, std::stringstream &out) {
+    std::ifstream in(file);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    ByteOffsetMap offsets(text);
+
+    size_t cursor = 0;
+    for (const auto *obj : program->objects) {
+        const auto &si = obj->srcInfo;
+        if (!si.isValid()) continue;
+        // Skip declarations pulled in from #include'd files.
+        if (si.getSourceFile() != file.c_str()) continue;
+        size_t start = offsets.offset(si.getStart());
+        size_t end = std::max(start, offsets.offset(si.getEnd()));
+        if (end <= range.first || start >= range.second) continue;
+        if (start < cursor) continue;
+        out << text.substr(cursor, start - cursor);
+        auto top4 = P4Formatter(&out);
+        obj->apply(top4);
+        cursor = end;
+        // Swallow trailing blanks and the declaration's final newline so the
+        // formatter's own trailing newline does not duplicate it.
+        while (cursor < text.size() && (text[cursor] == ' ' || text[cursor] == '\t')) ++cursor;
+        if (cursor < text.size() && text[cursor] == '\n') ++cursor;
+    }
+    out << text.substr(cursor);
+}
+
+}  // namespace
+
+std::stringstream getFormattedOutput(std::filesystem::path inputFile,
+                                     std::optional<std::pair<size_t, size_t>> range) {
     AutoCompileContext autoP4FmtContext(new P4Fmt::P4FmtContext);
     auto &options = P4Fmt::P4FmtContext::get().options();
 
@@ -65,11 +127,15 @@ std::stringstream getFormattedOutput(std::filesystem::path inputFile) {
         }
     }
 
-    auto top4 = P4Fmt::P4Formatter(&formattedOutput);
     auto attach = P4::P4Fmt::Attach(globalCommentsMap);
     program->apply(attach);
-    // Print the program before running front end passes.
-    program->apply(top4);
+    if (range) {
+        formatRange(program, *range, options.file, formattedOutput);
+    } else {
+        auto top4 = P4Fmt::P4Formatter(&formattedOutput);
+        // Print the program before running front end passes.
+        program->apply(top4);
+    }
 
     if (::P4::errorCount() > 0) {
         ::P4::error("Failed to format p4 program.");
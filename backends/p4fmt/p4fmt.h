@@ -1,13 +1,19 @@
 #ifndef BACKENDS_P4FMT_P4FMT_H_
 #define BACKENDS_P4FMT_P4FMT_H_
 
+#include <cstddef>
 #include <filesystem>
+#include <optional>
 #include <sstream>
+#include <utility>
 
 namespace P4::P4Fmt {
 
-/// Formats a P4 program from the input file, returns formatted output
-std::stringstream getFormattedOutput(std::filesystem::path inputFile);
+/// Formats a P4 program from the input file, returns formatted output.
+/// When @range is set, only the top-level declarations overlapping the given
+/// byte range are reformatted and the rest of the file is emitted verbatim.
+std::stringstream getFormattedOutput(std::filesystem::path inputFile,
+                                     std::optional<std::pair<size_t, size_t>> range = std::nullopt);
 
 }  // namespace P4::P4Fmt
 
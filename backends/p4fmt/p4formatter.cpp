@@ -19,8 +19,9 @@ Visitor::profile_t P4Formatter::init_apply(const IR::Node *node) {
 
 void P4Formatter::end_apply(const IR::Node *) {
     if (outStream != nullptr) {
-        cstring result = builder.toString();
-        *outStream << result;
+        // Stream the rope chunk by chunk; flattening it into a cstring would
+        // copy the whole program and intern it permanently.
+        builder.writeTo(*outStream);
         outStream->flush();
     }
     BUG_CHECK(listTerminators.size() == listTerminators_init_apply_size,
@@ -379,12 +380,13 @@ bool P4Formatter::process(const IR::Type_StructLike *t, const char *name) {
 
     std::unordered_map<const IR::StructField *, cstring> type;
     size_t len = 0;
+    Util::SourceCodeBuilder fieldBuilder;
     for (auto f : t->fields) {
-        Util::SourceCodeBuilder builder;
-        P4Formatter rec(builder);
+        fieldBuilder.clear();
+        P4Formatter rec(fieldBuilder);
 
         f->type->apply(rec);
-        cstring t = builder.toString();
+        cstring t = fieldBuilder.toString();
         if (t.size() > len) len = t.size();
         type.emplace(f, t);
     }
@@ -1299,12 +1301,13 @@ bool P4Formatter::preorder(const IR::Key *v) {
 
     std::unordered_map<const IR::KeyElement *, cstring> kf;
     size_t len = 0;
+    Util::SourceCodeBuilder keyBuilder;
     for (auto f : v->keyElements) {
-        Util::SourceCodeBuilder builder;
-        P4Formatter rec(builder);
+        keyBuilder.clear();
+        P4Formatter rec(keyBuilder);
 
         f->expression->apply(rec);
-        cstring s = builder.toString();
+        cstring s = keyBuilder.toString();
         if (s.size() > len) len = s.size();
         kf.emplace(f, s);
     }
@@ -44,8 +44,7 @@ limitations under the License.
 #include "midend/eliminateTypedefs.h"
 #include "midend/expandEmit.h"
 #include "midend/expandLookahead.h"
-#include "midend/flattenHeaders.h"
-#include "midend/flattenInterfaceStructs.h"
+#include "midend/flattenStructs.h"
 #include "midend/flattenLogMsg.h"
 #include "midend/flattenUnions.h"
 #include "midend/global_copyprop.h"
@@ -115,8 +114,7 @@ MidEnd::MidEnd(P4TestOptions &options, std::ostream *outStream) {
          new P4::StrengthReduction(&typeMap),
          new P4::SimplifySelectList(&typeMap),
          new P4::RemoveSelectBooleans(&typeMap),
-         new P4::FlattenHeaders(&typeMap),
-         new P4::FlattenInterfaceStructs(&typeMap),
+         new P4::FlattenStructs(&typeMap),
          new P4::EliminateTypedef(&typeMap),
          new P4::ReplaceSelectRange(),
          new P4::MoveDeclarations(),  // more may have been introduced
@@ -16,18 +16,35 @@ limitations under the License.
 
 #include "p4test.h"
 
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdlib>
+#include <cstring>
 #include <fstream>  // IWYU pragma: keep
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "backends/p4test/version.h"
 #include "control-plane/p4RuntimeSerializer.h"
 #include "frontends/common/applyOptionsPragmas.h"
+#include "frontends/common/frontendCache.h"
 #include "frontends/common/parseInput.h"
 #include "frontends/p4/evaluator/evaluator.h"
 #include "frontends/p4/frontend.h"
 #include "frontends/p4/toP4/toP4.h"
 #include "ir/ir.h"
 #include "ir/json_loader.h"
+#include "ir/pass_manager.h"
 #include "ir/pass_utils.h"
 #include "lib/crash.h"
 #include "lib/error.h"
@@ -35,6 +52,8 @@ limitations under the License.
 #include "lib/gc.h"
 #include "lib/log.h"
 #include "lib/nullstream.h"
+#include "lib/telemetry.h"
+#include "lib/timer.h"
 #include "midend.h"
 
 P4TestOptions::P4TestOptions() {
@@ -89,6 +108,57 @@ P4TestOptions::P4TestOptions() {
     registerOption(
         "--keepTuples", nullptr, [this](const char *) { return keepTuples = true; },
         "keep tuple type, but flatten assignments of them");
+    registerOption(
+        "--pass-timing-json", "file",
+        [this](const char *arg) {
+            passTimingJsonFile = arg;
+            P4::PassManager::enablePassTimers();
+            return true;
+        },
+        "Record a wall-clock timer around every frontend/midend pass and write "
+        "the timers to the\n"
+        "given file as JSON when compilation finishes. Used by the p4c-bench "
+        "harness.");
+    registerOption(
+        "--pass-timing-folded", "file",
+        [this](const char *arg) {
+            passTimingFoldedFile = arg;
+            P4::PassManager::enablePassTimers();
+            return true;
+        },
+        "Record a wall-clock timer around every frontend/midend pass and write "
+        "the nested timings\n"
+        "to the given file as collapsed stacks ('Outer;Inner microseconds' per "
+        "line), ready for\n"
+        "flamegraph.pl --countname=us.");
+    registerOption(
+        "--server", nullptr,
+        [](const char *) {
+            ::P4::error(ErrorType::ERR_INVALID, "--server must be the first argument");
+            return false;
+        },
+        "Run as a compile server: read one whitespace-separated p4test command "
+        "line per stdin line,\n"
+        "compile each in this process (reusing interned strings, warm allocator "
+        "state and the\n"
+        "frontend cache across jobs), and print 'p4test-job-exit <code>' after "
+        "each job.\n"
+        "Must be the first argument.");
+    registerOption(
+        "--batch", nullptr,
+        [](const char *) {
+            ::P4::error(ErrorType::ERR_INVALID, "--batch must be the first argument");
+            return false;
+        },
+        "Batch reference-output comparison: p4test --batch [-j N] manifest. "
+        "Each manifest line is\n"
+        "'<name> <compile args...> -- <produced>=<reference> ...'; jobs are "
+        "compiled across N forked\n"
+        "workers (default: all cores) and one JSON result line per job is "
+        "written to stdout.\n"
+        "Comparison ignores whitespace like the regression harness (diff -B "
+        "-w).  Must be the first\n"
+        "argument.");
 }
 
 class P4TestPragmas : public P4::P4COptionPragmaParser {
@@ -140,10 +210,25 @@ static void log_dump(const IR::Node *node, const char *head) {
     }
 }
 
-int main(int argc, char *const argv[]) {
-    setup_gc_logging();
-    setup_signals();
+/// Writes the timers accumulated by Util::getTimers() to @param file as a JSON array. Timer names
+/// are dotted paths reflecting timer nesting (pass managers nest their passes); pass names
+/// contain no characters that would need JSON escaping.
+static void dumpPassTimingJson(const std::filesystem::path &file) {
+    auto *out = openFile(file, true);
+    if (out == nullptr) return;
+    *out << "[";
+    const char *sep = "\n";
+    for (const auto &timer : Util::getTimers()) {
+        *out << sep << "  {\"name\": \"" << timer.timerName
+             << "\", \"milliseconds\": " << timer.milliseconds
+             << ", \"invocations\": " << timer.invocations
+             << ", \"relative_to_parent\": " << timer.relativeToParent << "}";
+        sep = ",\n";
+    }
+    *out << "\n]" << std::endl;
+}
 
+static int runCompile(int argc, char *const argv[]) {
     AutoCompileContext autoP4TestContext(new P4TestContext);
     auto &options = P4TestContext::get().options();
     options.langVersion = CompilerOptions::FrontendVersion::P4_16;
@@ -168,27 +253,36 @@ int main(int argc, char *const argv[]) {
             error(ErrorType::ERR_IO, "Can't open %s", options.file);
         }
     } else {
-        P4::DiagnosticCountInfo info;
-        program = P4::parseP4File(options);
-        info.emitInfo("PARSER");
-
-        if (program != nullptr && ::P4::errorCount() == 0) {
-            P4TestPragmas testPragmas;
-            program->apply(P4::ApplyOptionsPragmas(testPragmas));
-            info.emitInfo("PASS P4COptionPragmaParser");
-
-            if (!options.parseOnly) {
-                try {
-                    TestFEPolicy fe_policy(testPragmas);
-                    P4::FrontEnd fe(&fe_policy);
-                    fe.addDebugHook(hook);
-                    // use -TdiagnosticCountInPass:1 / -TdiagnosticCountInPass:4 to get output of
-                    // this hook
-                    fe.addDebugHook(info.getPassManagerHook());
-                    program = fe.run(options, program);
-                } catch (const std::exception &bug) {
-                    std::cerr << bug.what() << std::endl;
-                    return 1;
+        std::optional<std::string> cacheKey;
+        if (!options.frontendCacheDir.empty() && !options.parseOnly) {
+            cacheKey = P4::FrontendCache::key(options);
+            if (cacheKey) program = P4::FrontendCache::load(options.frontendCacheDir, *cacheKey);
+        }
+        if (program == nullptr) {
+            P4::DiagnosticCountInfo info;
+            program = P4::parseP4File(options);
+            info.emitInfo("PARSER");
+
+            if (program != nullptr && ::P4::errorCount() == 0) {
+                P4TestPragmas testPragmas;
+                program->apply(P4::ApplyOptionsPragmas(testPragmas));
+                info.emitInfo("PASS P4COptionPragmaParser");
+
+                if (!options.parseOnly) {
+                    try {
+                        TestFEPolicy fe_policy(testPragmas);
+                        P4::FrontEnd fe(&fe_policy);
+                        fe.addDebugHook(hook);
+                        // use -TdiagnosticCountInPass:1 / -TdiagnosticCountInPass:4 to get output
+                        // of this hook
+                        fe.addDebugHook(info.getPassManagerHook());
+                        program = fe.run(options, program);
+                    } catch (const std::exception &bug) {
+                        std::cerr << bug.what() << std::endl;
+                        return 1;
+                    }
+                    if (cacheKey && program != nullptr && ::P4::errorCount() == 0)
+                        P4::FrontendCache::store(options.frontendCacheDir, *cacheKey, program);
                 }
             }
         }
@@ -213,6 +307,7 @@ int main(int argc, char *const argv[]) {
 #endif
             const IR::ToplevelBlock *top = nullptr;
             try {
+                Util::Telemetry::Span telemetrySpan("midend");
                 top = midEnd.process(program);
                 // This can modify program!
                 log_dump(program, "After midend");
@@ -227,6 +322,16 @@ int main(int argc, char *const argv[]) {
                 auto dumpJsonStream = openFile(options.dumpJsonFile, true);
                 JSONGenerator(*dumpJsonStream, true).emit(program);
             }
+            if (!options.dumpJsonBinFile.empty()) {
+                auto dumpStream = openFile(options.dumpJsonBinFile, true);
+                // The generator only emits text, so produce the document in memory
+                // and re-encode it; the loader reads the binary form directly.
+                std::stringstream ss;
+                JSONGenerator(ss).emit(program);
+                std::unique_ptr<JsonData> doc;
+                ss >> doc;
+                writeBinaryJson(*dumpStream, doc.get());
+            }
             if (options.debugJson) {
                 std::stringstream ss1, ss2;
                 JSONGenerator gen1(ss1), gen2(ss2);
@@ -251,6 +356,258 @@ int main(int argc, char *const argv[]) {
         }
     }
 
+    if (!options.passTimingJsonFile.empty()) dumpPassTimingJson(options.passTimingJsonFile);
+    if (!options.passTimingFoldedFile.empty()) {
+        if (auto *out = openFile(options.passTimingFoldedFile, true)) {
+            Util::dumpCollapsedStacks(*out);
+            out->flush();
+        }
+    }
+
     if (Log::verbose()) std::cerr << "Done." << std::endl;
     return ::P4::errorCount() > 0;
 }
+
+/// Compile jobs read from stdin, one whitespace-separated command line per
+/// line.  Process startup, GC initialization, the cstring intern table and the
+/// on-disk frontend/include caches are shared across jobs; each job still gets
+/// a fresh compile context, so options and diagnostic counts do not leak.
+static int runServer(char *const argv0) {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::vector<std::string> words;
+        std::istringstream split(line);
+        for (std::string word; split >> word;) words.push_back(word);
+        if (words.empty()) continue;
+
+        std::vector<char *> jobArgv;
+        jobArgv.push_back(argv0);
+        for (auto &word : words) jobArgv.push_back(word.data());
+
+        int exitCode;
+        try {
+            exitCode = runCompile(jobArgv.size(), jobArgv.data());
+        } catch (const std::exception &bug) {
+            std::cerr << bug.what() << std::endl;
+            exitCode = 1;
+        }
+        // Synchronization point for the client driving us.
+        std::cout << "p4test-job-exit " << exitCode << std::endl;
+        std::cerr << std::flush;
+    }
+    return 0;
+}
+
+/// One line of a --batch manifest: a job name, the compile arguments, and the
+/// produced/reference file pairs to compare after the compile.
+struct BatchJob {
+    std::string name;
+    std::vector<std::string> args;
+    std::vector<std::pair<std::string, std::string>> compares;  // produced, reference
+};
+
+/// Parses one manifest line of the form
+///     <name> <compile args...> -- <produced>=<reference> ...
+/// Blank lines and lines starting with '#' yield nothing.
+static std::optional<BatchJob> parseBatchLine(const std::string &line) {
+    std::vector<std::string> words;
+    std::istringstream split(line);
+    for (std::string word; split >> word;) words.push_back(word);
+    if (words.empty() || words.front()[0] == '#') return std::nullopt;
+    BatchJob job;
+    job.name = words.front();
+    size_t i = 1;
+    for (; i < words.size() && words[i] != "--"; ++i) job.args.push_back(words[i]);
+    for (++i; i < words.size(); ++i) {
+        auto eq = words[i].find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "p4test --batch: bad compare pair '" << words[i] << "' in job "
+                      << job.name << std::endl;
+            continue;
+        }
+        job.compares.emplace_back(words[i].substr(0, eq), words[i].substr(eq + 1));
+    }
+    return job;
+}
+
+/// Compares two files the way the regression harness does (diff -B -w): whitespace inside
+/// lines and blank lines are ignored.  Returns false if either file is unreadable.
+static bool filesMatchIgnoringWhitespace(const std::string &a, const std::string &b) {
+    std::ifstream fa(a), fb(b);
+    if (!fa || !fb) return false;
+    auto nextLine = [](std::ifstream &in, std::string &out) {
+        std::string line;
+        while (std::getline(in, line)) {
+            out.clear();
+            for (char ch : line)
+                if (!isspace(static_cast<unsigned char>(ch))) out += ch;
+            if (!out.empty()) return true;
+        }
+        return false;
+    };
+    std::string la, lb;
+    while (true) {
+        bool hasA = nextLine(fa, la), hasB = nextLine(fb, lb);
+        if (!hasA || !hasB) return hasA == hasB;
+        if (la != lb) return false;
+    }
+}
+
+static std::string jsonEscape(const std::string &s) {
+    std::string rv;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') rv += '\\';
+        rv += ch;
+    }
+    return rv;
+}
+
+/// Runs one batch job in this process and returns its JSON result line.  @fail is set
+/// when the compile fails or any comparison differs.
+static std::string runBatchJob(char *const argv0, BatchJob &job, bool &fail) {
+    std::vector<char *> jobArgv;
+    jobArgv.push_back(argv0);
+    for (auto &word : job.args) jobArgv.push_back(word.data());
+    auto start = std::chrono::steady_clock::now();
+    int exitCode;
+    try {
+        exitCode = runCompile(jobArgv.size(), jobArgv.data());
+    } catch (const std::exception &bug) {
+        std::cerr << bug.what() << std::endl;
+        exitCode = 1;
+    }
+    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    if (exitCode != 0) fail = true;
+    std::ostringstream json;
+    json << "{\"name\": \"" << jsonEscape(job.name) << "\", \"exit\": " << exitCode
+         << ", \"milliseconds\": " << msec << ", \"compare\": [";
+    const char *sep = "";
+    for (auto &[produced, reference] : job.compares) {
+        bool equal = exitCode == 0 && filesMatchIgnoringWhitespace(produced, reference);
+        if (!equal) fail = true;
+        json << sep << "{\"produced\": \"" << jsonEscape(produced) << "\", \"reference\": \""
+             << jsonEscape(reference) << "\", \"equal\": " << (equal ? "true" : "false") << "}";
+        sep = ", ";
+    }
+    json << "]}\n";
+    return json.str();
+}
+
+/// Batch reference-output comparison: reads a manifest of jobs (see parseBatchLine),
+/// compiles them across a pool of forked workers, and writes one JSON result line per job
+/// to stdout.  Forking rather than threading because a whole compile touches process-wide
+/// state (the compile context stack, the parser); the workers still amortize process
+/// startup, GC initialization and the interned string table across their share of the
+/// suite, and each worker reuses its warm state from job to job exactly like --server.
+/// Returns nonzero if any job failed to compile or any comparison differed.
+static int runBatch(char *const argv0, int argc, char *const argv[]) {
+    unsigned nworkers = std::thread::hardware_concurrency();
+    int argi = 0;
+    if (argi + 1 < argc && strcmp(argv[argi], "-j") == 0) {
+        nworkers = atoi(argv[argi + 1]);
+        argi += 2;
+    }
+    if (argi != argc - 1) {
+        std::cerr << "usage: p4test --batch [-j N] manifest-file" << std::endl;
+        return 1;
+    }
+    std::ifstream manifest(argv[argi]);
+    if (!manifest) {
+        std::cerr << "p4test --batch: can't open " << argv[argi] << std::endl;
+        return 1;
+    }
+    std::vector<BatchJob> jobs;
+    for (std::string line; std::getline(manifest, line);)
+        if (auto job = parseBatchLine(line)) jobs.push_back(std::move(*job));
+    if (jobs.empty()) return 0;
+    if (nworkers < 1) nworkers = 1;
+    if (nworkers > jobs.size()) nworkers = jobs.size();
+
+    // One result pipe per worker: a result line (long path lists, error text) can
+    // exceed PIPE_BUF, where a shared pipe would no longer keep concurrent writes
+    // atomic and lines could interleave.  The parent reassembles each worker's
+    // stream and forwards only complete lines to stdout.
+    std::vector<int> workerFds;
+    for (unsigned worker = 0; worker < nworkers; ++worker) {
+        int results[2];
+        if (pipe(results) != 0) {
+            perror("p4test --batch: pipe");
+            return 1;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("p4test --batch: fork");
+            return 1;
+        }
+        if (pid == 0) {
+            for (int fd : workerFds) close(fd);
+            close(results[0]);
+            bool fail = false;
+            for (size_t i = worker; i < jobs.size(); i += nworkers) {
+                auto json = runBatchJob(argv0, jobs[i], fail);
+                for (size_t off = 0; off < json.size();) {
+                    ssize_t put = write(results[1], json.data() + off, json.size() - off);
+                    if (put < 0) {
+                        fail = true;
+                        break;
+                    }
+                    off += put;
+                }
+            }
+            std::cerr << std::flush;
+            // _exit: skip atexit handlers and static destructors shared with the parent.
+            _exit(fail ? 1 : 0);
+        }
+        close(results[1]);
+        workerFds.push_back(results[0]);
+    }
+    std::vector<std::string> partial(workerFds.size());
+    size_t open = workerFds.size();
+    char buffer[4096];
+    while (open > 0) {
+        std::vector<struct pollfd> pfds;
+        for (int fd : workerFds)
+            if (fd >= 0) pfds.push_back({fd, POLLIN, 0});
+        if (poll(pfds.data(), pfds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("p4test --batch: poll");
+            break;
+        }
+        for (auto &pfd : pfds) {
+            if (!(pfd.revents & (POLLIN | POLLHUP))) continue;
+            size_t worker = std::find(workerFds.begin(), workerFds.end(), pfd.fd) -
+                            workerFds.begin();
+            ssize_t got = read(pfd.fd, buffer, sizeof(buffer));
+            if (got <= 0) {
+                // Worker done; a trailing fragment means it died mid-line, pass it on.
+                if (!partial[worker].empty()) std::cout << partial[worker] << '\n';
+                close(pfd.fd);
+                workerFds[worker] = -1;
+                --open;
+                continue;
+            }
+            partial[worker].append(buffer, got);
+            auto eol = partial[worker].rfind('\n');
+            if (eol != std::string::npos) {
+                std::cout.write(partial[worker].data(), eol + 1);
+                partial[worker].erase(0, eol + 1);
+            }
+        }
+    }
+    std::cout << std::flush;
+    int rv = 0, status;
+    for (pid_t pid; (pid = wait(&status)) > 0;)
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) rv = 1;
+    return rv;
+}
+
+int main(int argc, char *const argv[]) {
+    setup_gc_logging();
+    setup_signals();
+
+    if (argc > 1 && strcmp(argv[1], "--server") == 0) return runServer(argv[0]);
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) return runBatch(argv[0], argc - 2, argv + 2);
+    return runCompile(argc, argv);
+}
@@ -28,6 +28,12 @@ class P4TestOptions : public CompilerOptions {
     bool loadIRFromJson = false;
     bool preferSwitch = false;
     bool keepTuples = false;  // keep tuples but flatten assignments of them
+    /// If non-empty, write the per-pass timers accumulated during compilation to this file as
+    /// JSON. Consumed by the p4c-bench harness.
+    std::filesystem::path passTimingJsonFile;
+    /// If non-empty, write the per-pass timers to this file as collapsed stacks suitable for
+    /// flame graph tools.
+    std::filesystem::path passTimingFoldedFile;
     P4TestOptions();
 };
 
@@ -184,6 +184,10 @@ std::optional<bool> Z3Solver::checkSat(const z3::expr_vector &asserts) {
 
 std::optional<bool> Z3Solver::checkSat(const std::vector<const Constraint *> &asserts) {
     Util::ScopedTimer ctZ3("z3");
+    if (knownUnsat.count(asserts) != 0) {
+        Z3_LOG("assertions known to be unsatisfiable, skipping check");
+        return false;
+    }
     if (isIncremental) {
         // Find common prefix with the previous invocation's list of assertions
         auto from = asserts.begin();
@@ -205,7 +209,11 @@ std::optional<bool> Z3Solver::checkSat(const std::vector<const Constraint *> &as
     }
     Z3_LOG("checking satisfiability for %d assertions",
            isIncremental ? z3solver.assertions().size() : z3Assertions.size());
-    return isIncremental ? checkSat() : checkSat(z3Assertions);
+    auto result = isIncremental ? checkSat() : checkSat(z3Assertions);
+    if (result == false) {
+        knownUnsat.insert(asserts);
+    }
+    return result;
 }
 
 void Z3Solver::asrt(const Constraint *assertion) {
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <iosfwd>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -135,6 +136,13 @@ class Z3Solver : public AbstractSolver {
     /// @ref p4Assertions at the time the checkpoint was made.
     std::vector<size_t> checkpoints;
 
+    /// Assertion lists that checkSat has already proven unsatisfiable. The same query recurs when
+    /// a pruned branch's path condition is revisited, and an unsat verdict is definitive, so it
+    /// can be served without invoking Z3. Satisfiable verdicts are never cached because callers
+    /// retrieve the model of the last live check through @ref getSymbolicMapping, and unknown
+    /// results may be timeout-dependent.
+    std::set<std::vector<const Constraint *>> knownUnsat;
+
     /// The Z3 counterpart to @ref p4Assertions. This is only used when @a isIncremental is false.
     z3::expr_vector z3Assertions;
 
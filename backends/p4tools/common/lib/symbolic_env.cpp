@@ -12,20 +12,26 @@
 namespace P4::P4Tools {
 
 const IR::Expression *SymbolicEnv::get(const IR::StateVariable &var) const {
-    auto it = map.find(var);
-    if (it != map.end()) {
+    auto it = map->find(var);
+    if (it != map->end()) {
         return it->second;
     }
     BUG("Unable to find var %s in the symbolic environment.", var);
 }
 
-bool SymbolicEnv::exists(const IR::StateVariable &var) const { return map.find(var) != map.end(); }
+bool SymbolicEnv::exists(const IR::StateVariable &var) const {
+    return map->find(var) != map->end();
+}
 
 void SymbolicEnv::set(const IR::StateVariable &var, const IR::Expression *value) {
     BUG_CHECK(value->type && !value->type->is<IR::Type_Unknown>(),
               "Cannot set value for node %1% with unspecified type: %2%", value->node_type_name(),
               value);
-    map[var] = value;
+    // Detach from any environment sharing the map with us before writing.
+    if (map.use_count() > 1) {
+        map = std::make_shared<SymbolicMapType>(*map);
+    }
+    (*map)[var] = value;
 }
 
 const IR::Expression *SymbolicEnv::subst(const IR::Expression *expr) const {
@@ -63,7 +69,7 @@ const IR::Expression *SymbolicEnv::subst(const IR::Expression *expr) const {
     return expr->apply(SubstVisitor(*this));
 }
 
-const SymbolicMapType &SymbolicEnv::getInternalMap() const { return map; }
+const SymbolicMapType &SymbolicEnv::getInternalMap() const { return *map; }
 
 bool SymbolicEnv::isSymbolicValue(const IR::Node *node) {
     // Check the obvious case first.
@@ -1,6 +1,8 @@
 #ifndef BACKENDS_P4TOOLS_COMMON_LIB_SYMBOLIC_ENV_H_
 #define BACKENDS_P4TOOLS_COMMON_LIB_SYMBOLIC_ENV_H_
 
+#include <memory>
+
 #include "backends/p4tools/common/lib/model.h"
 #include "ir/ir.h"
 #include "ir/node.h"
@@ -9,9 +11,11 @@ namespace P4::P4Tools {
 
 /// A symbolic environment maps variables to their symbolic value. A symbolic value is just an
 /// expression on the program's initial state.
+/// The environment is copy-on-write: copies (execution state forks) share the underlying map and
+/// only the first write after a fork pays for a full copy. This assumes a single mutator thread.
 class SymbolicEnv {
  private:
-    SymbolicMapType map;
+    std::shared_ptr<SymbolicMapType> map = std::make_shared<SymbolicMapType>();
 
  public:
     // Maybe coerce from Model for concrete execution?
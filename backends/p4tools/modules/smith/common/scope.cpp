@@ -45,6 +45,18 @@ void P4Scope::addToScope(const IR::Node *node) {
 
 void P4Scope::startLocalScope() { scope.push_back(new IR::Vector<IR::Node>()); }
 
+void P4Scope::reset() {
+    scope.clear();
+    usedNames.clear();
+    lvalMap.clear();
+    lvalMapRw.clear();
+    callableTables.clear();
+    notInitializedStructs.clear();
+    prop = {};
+    req = {};
+    constraints = {};
+}
+
 void P4Scope::endLocalScope() {
     IR::Vector<IR::Node> *localScope = scope.back();
 
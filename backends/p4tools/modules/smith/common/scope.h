@@ -90,6 +90,9 @@ class P4Scope {
     static void startLocalScope();
     static void endLocalScope();
 
+    /// Clears all generator state so that another program can be generated in the same process.
+    static void reset();
+
     static void addLval(const IR::Type *tp, cstring name, bool read_only = false);
     static bool checkLval(const IR::Type *tp, bool must_write = false);
     static cstring pickLval(const IR::Type *tp, bool must_write = false);
@@ -1,6 +1,8 @@
 #include "backends/p4tools/modules/smith/options.h"
 
 #include <cstdlib>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -35,6 +37,26 @@ void SmithOptions::processArgs(const std::vector<const char *> &args) {
     }
 }
 
-SmithOptions::SmithOptions() : AbstractP4cToolOptions(P4Smith::TOOL_NAME, "P4Smith options.") {}
+SmithOptions::SmithOptions() : AbstractP4cToolOptions(P4Smith::TOOL_NAME, "P4Smith options.") {
+    registerOption(
+        "--generate-count", "count",
+        [this](const char *arg) {
+            try {
+                auto count = std::stoll(arg);
+                if (count < 1) {
+                    error("--generate-count must be at least 1.");
+                    return false;
+                }
+                generateCount = count;
+            } catch (std::invalid_argument &) {
+                error("Invalid input value %1% for --generate-count. Expected a number.", arg);
+                return false;
+            }
+            return true;
+        },
+        "How many programs to generate in this invocation. The generator is initialized once for "
+        "the whole batch; programs after the first are written to numbered variants of the output "
+        "file name.");
+}
 
 }  // namespace P4::P4Tools
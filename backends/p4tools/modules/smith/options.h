@@ -13,6 +13,10 @@ class SmithOptions : public AbstractP4cToolOptions {
     static SmithOptions &get();
 
     void processArgs(const std::vector<const char *> &args);
+
+    /// How many programs to generate in this invocation. Programs after the first are written to
+    /// numbered variants of the output file name.
+    unsigned generateCount = 1;
 };
 
 }  // namespace P4::P4Tools
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "backends/p4tools/common/compiler/compiler_result.h"
@@ -65,11 +66,6 @@ int Smith::mainImpl(const CompilerResult & /*result*/) {
     if (outputFile.empty()) {
         outputFile = "out.p4";
     }
-    auto ostream = openFile(outputFile, false);
-    if (ostream == nullptr) {
-        error("must have [file]");
-        exit(EXIT_FAILURE);
-    }
     if (smithOptions.seed.has_value()) {
         printInfo("Using provided seed");
     } else {
@@ -83,16 +79,32 @@ int Smith::mainImpl(const CompilerResult & /*result*/) {
     printInfo("============ Program seed %1% =============\n", *smithOptions.seed);
     const auto &smithTarget = SmithTarget::get();
 
-    auto result = smithTarget.writeTargetPreamble(ostream.get());
-    if (result != EXIT_SUCCESS) {
-        return result;
+    for (unsigned progIdx = 0; progIdx < smithOptions.generateCount; ++progIdx) {
+        // Number the output files when more than one program is requested.
+        auto batchFile = outputFile;
+        if (smithOptions.generateCount > 1) {
+            batchFile.replace_filename(outputFile.stem().string() + "_" +
+                                       std::to_string(progIdx) + outputFile.extension().string());
+        }
+        auto ostream = openFile(batchFile, false);
+        if (ostream == nullptr) {
+            error("must have [file]");
+            exit(EXIT_FAILURE);
+        }
+        // Leftover names, lvalues, and constraints from the previous program would otherwise
+        // constrain this one.
+        P4Scope::reset();
+        auto result = smithTarget.writeTargetPreamble(ostream.get());
+        if (result != EXIT_SUCCESS) {
+            return result;
+        }
+        const auto *generatedProgram = smithTarget.generateP4Program();
+        // Use ToP4 to write the P4 program to the specified stream.
+        P4::ToP4 top4(ostream.get(), false);
+        generatedProgram->apply(top4);
+        ostream->flush();
+        P4Scope::endLocalScope();
     }
-    const auto *generatedProgram = smithTarget.generateP4Program();
-    // Use ToP4 to write the P4 program to the specified stream.
-    P4::ToP4 top4(ostream.get(), false);
-    generatedProgram->apply(top4);
-    ostream->flush();
-    P4Scope::endLocalScope();
 
     return EXIT_SUCCESS;
 }
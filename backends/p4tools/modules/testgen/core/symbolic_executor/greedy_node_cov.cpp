@@ -22,13 +22,13 @@ GreedyNodeSelection::GreedyNodeSelection(AbstractSolver &solver, const ProgramIn
     : SymbolicExecutor(solver, programInfo) {}
 
 std::optional<SymbolicExecutor::Branch> GreedyNodeSelection::popPotentialBranch(
-    const P4::Coverage::CoverageSet &coveredNodes,
+    const P4::Coverage::CoverageBitmap &coveredNodes,
     std::vector<SymbolicExecutor::Branch> &candidateBranches) {
     for (size_t idx = 0; idx < candidateBranches.size(); ++idx) {
         auto branch = candidateBranches.at(idx);
         // First check all the potential set of nodes we can cover by looking ahead.
         for (const auto &stmt : branch.potentialNodes) {
-            if (coveredNodes.count(stmt) == 0U) {
+            if (coveredNodes.isVisited(stmt) != true) {
                 candidateBranches[idx] = candidateBranches.back();
                 candidateBranches.pop_back();
                 return branch;
@@ -37,7 +37,7 @@ std::optional<SymbolicExecutor::Branch> GreedyNodeSelection::popPotentialBranch(
         // If we did not find anything, check whether this state covers any new nodes
         // already.
         for (const auto &stmt : branch.nextState.get().getVisited()) {
-            if (coveredNodes.count(stmt) == 0U) {
+            if (coveredNodes.isVisited(stmt) != true) {
                 candidateBranches[idx] = candidateBranches.back();
                 candidateBranches.pop_back();
                 return branch;
@@ -61,7 +61,7 @@ std::optional<ExecutionStateReference> GreedyNodeSelection::pickSuccessor(StepRe
     // This guard is necessary to avoid getting caught in parser loops.
     if (stepsWithoutTest < MAX_STEPS_WITHOUT_TEST) {
         // Try to find a branch that covers new nodes.
-        auto branch = popPotentialBranch(getVisitedNodes(), *successors);
+        auto branch = popPotentialBranch(visitedBitmap, *successors);
         // If we succeed, pick the branch and add the remainder to the list of
         // potential branches.
         if (branch.has_value()) {
@@ -120,7 +120,7 @@ void GreedyNodeSelection::runImpl(const Callback &callBack,
         }
         // Select a new branch by iterating over all branches
         Util::ScopedTimer chooseBranchtimer("branch_selection");
-        auto branch = popPotentialBranch(getVisitedNodes(), potentialBranches);
+        auto branch = popPotentialBranch(visitedBitmap, potentialBranches);
         if (branch.has_value()) {
             executionState = branch.value().nextState;
             continue;
@@ -61,11 +61,11 @@ class GreedyNodeSelection : public SymbolicExecutor {
     std::vector<Branch> unexploredBranches;
 
     /// Iterate over all the input branches in @param candidateBranches and try to find a branch
-    /// which contains nodes that are not in @param coverednodes yet. Return the first
+    /// which contains nodes that are not in @param coveredNodes yet. Return the first
     /// branch that was found and remove that branch from the container of @param candidateBranches.
     /// Return none, if no branch was found.
     static std::optional<SymbolicExecutor::Branch> popPotentialBranch(
-        const P4::Coverage::CoverageSet &coverednodes,
+        const P4::Coverage::CoverageBitmap &coveredNodes,
         std::vector<SymbolicExecutor::Branch> &candidateBranches);
 
     /// Try to pick a successor from the list of given successors. This involves three steps.
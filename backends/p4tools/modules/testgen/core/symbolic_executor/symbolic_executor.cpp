@@ -37,6 +37,13 @@ SymbolicExecutor::StepResult SymbolicExecutor::step(ExecutionState &state) {
     return successors;
 }
 
+// Path exploration is deliberately single-threaded. Stepping allocates IR
+// nodes and execution states through the garbage-collected allocator, which
+// assumes a single mutator, and everything below us reaches for process-wide
+// state: the CompileContextStack (options, error/warning reporter), the
+// coverage bookkeeping in the executor, and the test back-end writers. Until
+// those are made thread-safe, worker threads pulling branches from a shared
+// frontier would race on every step, even with one solver instance per worker.
 void SymbolicExecutor::run(const Callback &callBack) {
     runImpl(callBack, ExecutionState::create(&programInfo.getP4Program()));
 }
@@ -92,6 +99,7 @@ SymbolicExecutor::SymbolicExecutor(AbstractSolver &solver, const ProgramInfo &pr
     : programInfo(programInfo),
       solver(solver),
       coverableNodes(programInfo.getCoverableNodes()),
+      visitedBitmap(coverableNodes),
       evaluator(solver, programInfo) {
     // If there is no seed provided, do not randomize the solver.
     auto seed = Utils::getCurrentSeed();
@@ -103,7 +111,17 @@ SymbolicExecutor::SymbolicExecutor(AbstractSolver &solver, const ProgramInfo &pr
 bool SymbolicExecutor::updateVisitedNodes(const P4::Coverage::CoverageSet &newNodes) {
     auto hasUpdated = false;
     for (const auto *newNode : newNodes) {
-        hasUpdated |= visitedNodes.insert(newNode).second;
+        // The bitmap answers repeat visits without touching the ordered set. Nodes outside the
+        // coverable set fall back to the set, preserving the previous union semantics.
+        auto newlyCovered = visitedBitmap.markVisited(newNode);
+        if (newlyCovered.has_value()) {
+            if (*newlyCovered) {
+                visitedNodes.insert(newNode);
+                hasUpdated = true;
+            }
+        } else {
+            hasUpdated |= visitedNodes.insert(newNode).second;
+        }
     }
     return hasUpdated;
 }
@@ -70,6 +70,11 @@ class SymbolicExecutor {
     /// Set of all nodes executed in any testcase that has been outputted.
     P4::Coverage::CoverageSet visitedNodes;
 
+    /// Densely-numbered bitmap over @ref coverableNodes, mirroring @ref visitedNodes. It answers
+    /// repeated coverage queries with a pointer memo and a bit test instead of ordered-set
+    /// lookups.
+    P4::Coverage::CoverageBitmap visitedBitmap;
+
     /// Handles processing at the end of a P4 program.
     ///
     /// @returns true if symbolic execution should end; false if symbolic execution should continue
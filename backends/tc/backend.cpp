@@ -1962,9 +1962,9 @@ void Backend::serialize() const {
         ::P4::error("Unable to open File %1%", headerFile);
         return;
     }
-    *cstream << c.toString();
-    *pstream << p.toString();
-    *hstream << h.toString();
+    c.writeTo(*cstream);
+    p.writeTo(*pstream);
+    h.writeTo(*hstream);
     cstream->flush();
     pstream->flush();
     hstream->flush();
@@ -2024,6 +2024,7 @@ void ConvertToBackendIR::postorder(const IR::P4Action *action) {
         tcAction->setPipelineName(pipelineName);
         tcAction->setActionId(actionId);
         actionIDList.emplace(actionId, actionName);
+        actionIDs.emplace(actionName, actionId);
         auto paramList = action->getParameters();
         if (paramList != nullptr && !paramList->empty()) {
             for (auto param : paramList->parameters) {
@@ -2075,6 +2076,7 @@ void ConvertToBackendIR::postorder(const IR::P4Action *action) {
             }
         }
         tcPipeline->addActionDefinition(tcAction);
+        actionDefMap.emplace(actionName, tcAction);
     }
 }
 
@@ -2585,10 +2587,8 @@ void ConvertToBackendIR::postorder(const IR::P4Table *t) {
                 const IR::TCAction *tcAction = nullptr;
                 auto adecl = refMap->getDeclaration(action->getPath(), true);
                 auto actionName = externalName(adecl);
-                for (auto actionDef : tcPipeline->actionDefs) {
-                    if (actionName != actionDef->actionName) continue;
-                    tcAction = actionDef;
-                }
+                auto find = actionDefMap.find(actionName);
+                if (find != actionDefMap.end()) tcAction = find->second;
                 if (actionName == P4::P4CoreLibrary::instance().noAction.name) {
                     tcAction = tcPipeline->NoAction;
                 }
@@ -2613,6 +2613,7 @@ void ConvertToBackendIR::postorder(const IR::P4Table *t) {
         updateConstEntries(t, tableDefinition);
         updateTimerProfiles(tableDefinition);
         tcPipeline->addTableDefinition(tableDefinition);
+        tableDescriptors.emplace(tName, TableDescriptor{tId, keySize, tableDefinition});
     }
 }
 
@@ -3060,34 +3061,37 @@ unsigned ConvertToBackendIR::getTcType(const IR::StringLiteral *sl) {
     return typeVal;
 }
 
+const ConvertToBackendIR::TableDescriptor *ConvertToBackendIR::getTableDescriptor(
+    cstring tableName) const {
+    auto itr = tableDescriptors.find(tableName);
+    if (itr != tableDescriptors.end()) return &itr->second;
+    return nullptr;
+}
+
 unsigned ConvertToBackendIR::getTableId(cstring tableName) const {
-    for (auto t : tableIDList) {
-        if (t.second == tableName) return t.first;
-    }
+    auto itr = tableDescriptors.find(tableName);
+    if (itr != tableDescriptors.end()) return itr->second.tableId;
     return 0;
 }
 
 unsigned ConvertToBackendIR::getActionId(cstring actionName) const {
-    for (auto a : actionIDList) {
-        if (a.second == actionName) return a.first;
-    }
+    auto itr = actionIDs.find(actionName);
+    if (itr != actionIDs.end()) return itr->second;
     return 0;
 }
 
 cstring ConvertToBackendIR::getExternId(cstring externName) const {
-    for (auto e : externsInfo) {
-        if (e.first == externName) return e.second->externId;
-    }
+    auto itr = externsInfo.find(externName);
+    if (itr != externsInfo.end()) return itr->second->externId;
     return ""_cs;
 }
 
 unsigned ConvertToBackendIR::getExternInstanceId(cstring externName, cstring instanceName) const {
-    for (auto e : externsInfo) {
-        if (e.first == externName) {
-            for (auto eI : e.second->eInstance) {
-                if (eI->instance_name == instanceName) {
-                    return eI->instance_id;
-                }
+    auto itr = externsInfo.find(externName);
+    if (itr != externsInfo.end()) {
+        for (auto eI : itr->second->eInstance) {
+            if (eI->instance_name == instanceName) {
+                return eI->instance_id;
             }
         }
     }
@@ -341,6 +341,15 @@ class ConvertToBackendIR : public Inspector {
         safe_vector<struct ExternInstance *> eInstance;
     };
     enum CounterType { PACKETS, BYTES, PACKETS_AND_BYTES };
+    /// Analyzed per-table information computed once when the table is converted and
+    /// shared between the template-file emission and the eBPF C code generation, so
+    /// consumers resolve ids, key sizes and table definitions by name instead of
+    /// re-deriving them with a scan of the pipeline per lookup.
+    struct TableDescriptor {
+        unsigned tableId;
+        unsigned keySize;
+        const IR::TCTable *tableDef;
+    };
     const IR::ToplevelBlock *tlb;
     IR::TCPipeline *tcPipeline;
     P4::ReferenceMap *refMap;
@@ -357,6 +366,9 @@ class ConvertToBackendIR : public Inspector {
     ordered_map<unsigned, cstring> tableIDList;
     ordered_map<unsigned, cstring> actionIDList;
     ordered_map<unsigned, unsigned> tableKeysizeList;
+    ordered_map<cstring, TableDescriptor> tableDescriptors;
+    ordered_map<cstring, unsigned> actionIDs;
+    ordered_map<cstring, const IR::TCAction *> actionDefMap;
     safe_vector<const IR::P4Table *> add_on_miss_tables;
     ordered_map<cstring, std::pair<cstring, cstring> *> tablePermissions;
     ordered_map<cstring, const IR::Type_Struct *> ControlStructPerExtern;
@@ -397,6 +409,7 @@ class ConvertToBackendIR : public Inspector {
     unsigned int findMappedKernelMeta(const IR::Member *mem);
     const IR::Expression *ExtractExpFromCast(const IR::Expression *exp);
     unsigned getTcType(const IR::StringLiteral *sl);
+    const TableDescriptor *getTableDescriptor(cstring tableName) const;
     unsigned getTableId(cstring tableName) const;
     unsigned getActionId(cstring actionName) const;
     cstring getExternId(cstring externName) const;
@@ -16,8 +16,143 @@ and limitations under the License.
 
 #include "ebpfCodeGen.h"
 
+#include "lib/sourceCodeBuilder.h"
+
 namespace P4::TC {
 
+namespace {
+
+/// Invariant C scaffolding that is identical for every compiled program. Each
+/// skeleton below is rendered once per process into a rope fragment; the
+/// emitters splice it into the output by reference
+/// (Util::SourceCodeBuilder::append shares the underlying chunks) and only
+/// generate the program-specific slots in between, instead of re-emitting the
+/// boilerplate line by line for every program.
+const Util::SourceCodeBuilder &pnaIncludesSkeleton() {
+    static const Util::SourceCodeBuilder skeleton = [] {
+        Util::SourceCodeBuilder b;
+        b.appendLine("#include <stdbool.h>");
+        b.appendLine("#include <linux/if_ether.h>");
+        b.appendLine("#include \"pna.h\"");
+        return b;
+    }();
+    return skeleton;
+}
+
+const Util::SourceCodeBuilder &commonPreambleSkeleton() {
+    static const Util::SourceCodeBuilder skeleton = [] {
+        Util::SourceCodeBuilder b;
+        b.newline();
+        b.appendLine("#define EBPF_MASK(t, w) ((((t)(1)) << (w)) - (t)1)");
+        b.appendLine("#define BYTES(w) ((w) / 8)");
+        b.appendLine("#define BYTES_ROUND_UP(w) (((w) + (8) - 1) / (8))");
+        b.appendLine(
+            "#define write_partial(a, w, s, v) do { *((u8*)a) = ((*((u8*)a)) "
+            "& ~(EBPF_MASK(u8, w) << s)) | (v << s) ; } while (0)");
+        b.appendLine(
+            "#define write_byte(base, offset, v) do { "
+            "*(u8*)((base) + (offset)) = (v); "
+            "} while (0)");
+        return b;
+    }();
+    return skeleton;
+}
+
+const Util::SourceCodeBuilder &internalStructuresSkeleton() {
+    static const Util::SourceCodeBuilder skeleton = [] {
+        Util::SourceCodeBuilder b;
+        b.appendLine("struct p4tc_filter_fields p4tc_filter_fields;");
+        b.newline();
+        b.append(
+            "struct internal_metadata {\n"
+            "    __u16 pkt_ether_type;\n"
+            "} __attribute__((aligned(4)));\n\n"
+            "struct skb_aggregate {\n"
+            "    struct p4tc_skb_meta_get get;\n"
+            "    struct p4tc_skb_meta_set set;\n"
+            "};\n");
+        b.newline();
+        return b;
+    }();
+    return skeleton;
+}
+
+/// The fixed leading fields of struct p4tc_filter_fields; the table-specific
+/// default-action parameters are filled into the slot that follows.
+const Util::SourceCodeBuilder &p4tcFilterFieldsSkeleton() {
+    static const Util::SourceCodeBuilder skeleton = [] {
+        Util::SourceCodeBuilder b;
+        b.increaseIndent();
+        for (const char *field : {"__u32 pipeid", "__u32 handle", "__u32 classid", "__u32 chain",
+                                  "__u32 blockid", "__be16 proto", "__u16 prio"}) {
+            b.emitIndent();
+            b.append(field);
+            b.endOfStatement(true);
+        }
+        b.decreaseIndent();
+        return b;
+    }();
+    return skeleton;
+}
+
+const Util::SourceCodeBuilder &globalFunctionsSkeleton() {
+    static const Util::SourceCodeBuilder skeleton = [] {
+        Util::SourceCodeBuilder b;
+        b.appendLine(
+            "static inline u32 getPrimitive32(u8 *a, int size) {\n"
+            "   if(size <= 16 || size > 24) {\n"
+            "       bpf_printk(\"Invalid size.\");\n"
+            "   }\n"
+            "   return  ((((u32)a[2]) <<16) | (((u32)a[1]) << 8) | a[0]);\n"
+            "}\n"
+            "static inline u64 getPrimitive64(u8 *a, int size) {\n"
+            "   if(size <= 32 || size > 56) {\n"
+            "       bpf_printk(\"Invalid size.\");\n"
+            "   }\n"
+            "   if(size <= 40) {\n"
+            "       return  ((((u64)a[4]) << 32) | (((u64)a[3]) << 24) | (((u64)a[2]) << 16) | "
+            "(((u64)a[1]) << 8) | a[0]);\n"
+            "   } else {\n"
+            "       if(size <= 48) {\n"
+            "           return  ((((u64)a[5]) << 40) | (((u64)a[4]) << 32) | (((u64)a[3]) << 24) | "
+            "(((u64)a[2]) << 16) | (((u64)a[1]) << 8) | a[0]);\n"
+            "       } else {\n"
+            "           return  ((((u64)a[6]) << 48) | (((u64)a[5]) << 40) | (((u64)a[4]) << 32) | "
+            "(((u64)a[3]) << 24) | (((u64)a[2]) << 16) | (((u64)a[1]) << 8) | a[0]);\n"
+            "       }\n"
+            "   }\n"
+            "}\n"
+            "static inline void storePrimitive32(u8 *a, int size, u32 value) {\n"
+            "   if(size <= 16 || size > 24) {\n"
+            "       bpf_printk(\"Invalid size.\");\n"
+            "   }\n"
+            "   a[0] = (u8)(value);\n"
+            "   a[1] = (u8)(value >> 8);\n"
+            "   a[2] = (u8)(value >> 16);\n"
+            "}\n"
+            "static inline void storePrimitive64(u8 *a, int size, u64 value) {\n"
+            "   if(size <= 32 || size > 56) {\n"
+            "       bpf_printk(\"Invalid size.\");\n"
+            "   }\n"
+            "   a[0] = (u8)(value);\n"
+            "   a[1] = (u8)(value >> 8);\n"
+            "   a[2] = (u8)(value >> 16);\n"
+            "   a[3] = (u8)(value >> 24);\n"
+            "   a[4] = (u8)(value >> 32);\n"
+            "   if (size > 40) {\n"
+            "       a[5] = (u8)(value >> 40);\n"
+            "   }\n"
+            "   if (size > 48) {\n"
+            "       a[6] = (u8)(value >> 48);\n"
+            "   }\n"
+            "}\n");
+        return b;
+    }();
+    return skeleton;
+}
+
+}  // namespace
+
 DeparserBodyTranslatorPNA::DeparserBodyTranslatorPNA(const IngressDeparserPNA *deparser)
     : CodeGenInspector(deparser->program->refMap, deparser->program->typeMap),
       DeparserBodyTranslatorPSA(deparser) {
@@ -26,9 +161,7 @@ DeparserBodyTranslatorPNA::DeparserBodyTranslatorPNA(const IngressDeparserPNA *d
 
 // =====================PNAEbpfGenerator=============================
 void PNAEbpfGenerator::emitPNAIncludes(EBPF::CodeBuilder *builder) const {
-    builder->appendLine("#include <stdbool.h>");
-    builder->appendLine("#include <linux/if_ether.h>");
-    builder->appendLine("#include \"pna.h\"");
+    builder->append(pnaIncludesSkeleton());
 }
 
 cstring PNAEbpfGenerator::getProgramName() const { return cstring(options.file.stem()); }
@@ -39,32 +172,12 @@ void PNAEbpfGenerator::emitPreamble(EBPF::CodeBuilder *builder) const {
 }
 
 void PNAEbpfGenerator::emitCommonPreamble(EBPF::CodeBuilder *builder) const {
-    builder->newline();
-    builder->appendLine("#define EBPF_MASK(t, w) ((((t)(1)) << (w)) - (t)1)");
-    builder->appendLine("#define BYTES(w) ((w) / 8)");
-    builder->appendLine("#define BYTES_ROUND_UP(w) (((w) + (8) - 1) / (8))");
-    builder->appendLine(
-        "#define write_partial(a, w, s, v) do { *((u8*)a) = ((*((u8*)a)) "
-        "& ~(EBPF_MASK(u8, w) << s)) | (v << s) ; } while (0)");
-    builder->appendLine(
-        "#define write_byte(base, offset, v) do { "
-        "*(u8*)((base) + (offset)) = (v); "
-        "} while (0)");
+    builder->append(commonPreambleSkeleton());
     builder->target->emitPreamble(builder);
 }
 
 void PNAEbpfGenerator::emitInternalStructures(EBPF::CodeBuilder *builder) const {
-    builder->appendLine("struct p4tc_filter_fields p4tc_filter_fields;");
-    builder->newline();
-    builder->append(
-        "struct internal_metadata {\n"
-        "    __u16 pkt_ether_type;\n"
-        "} __attribute__((aligned(4)));\n\n"
-        "struct skb_aggregate {\n"
-        "    struct p4tc_skb_meta_get get;\n"
-        "    struct p4tc_skb_meta_set set;\n"
-        "};\n");
-    builder->newline();
+    builder->append(internalStructuresSkeleton());
 }
 
 /* Generate headers and structs in p4 prog */
@@ -106,28 +219,7 @@ void PNAEbpfGenerator::emitGlobalHeadersMetadata(EBPF::CodeBuilder *builder) con
 void PNAEbpfGenerator::emitP4TCFilterFields(EBPF::CodeBuilder *builder) const {
     builder->append("struct p4tc_filter_fields ");
     builder->blockStart();
-
-    builder->emitIndent();
-    builder->appendFormat("__u32 pipeid");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__u32 handle");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__u32 classid");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__u32 chain");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__u32 blockid");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__be16 proto");
-    builder->endOfStatement(true);
-    builder->emitIndent();
-    builder->appendFormat("__u16 prio");
-    builder->endOfStatement(true);
+    builder->append(p4tcFilterFieldsSkeleton());
     emitP4TCActionParam(builder);
     builder->blockEnd(false);
     builder->endOfStatement(true);
@@ -224,55 +316,7 @@ void PNAArchTC::emitInstances(EBPF::CodeBuilder *builder) const {
 }
 
 void PNAArchTC::emitGlobalFunctions(EBPF::CodeBuilder *builder) const {
-    const char *code =
-        "static inline u32 getPrimitive32(u8 *a, int size) {\n"
-        "   if(size <= 16 || size > 24) {\n"
-        "       bpf_printk(\"Invalid size.\");\n"
-        "   }\n"
-        "   return  ((((u32)a[2]) <<16) | (((u32)a[1]) << 8) | a[0]);\n"
-        "}\n"
-        "static inline u64 getPrimitive64(u8 *a, int size) {\n"
-        "   if(size <= 32 || size > 56) {\n"
-        "       bpf_printk(\"Invalid size.\");\n"
-        "   }\n"
-        "   if(size <= 40) {\n"
-        "       return  ((((u64)a[4]) << 32) | (((u64)a[3]) << 24) | (((u64)a[2]) << 16) | "
-        "(((u64)a[1]) << 8) | a[0]);\n"
-        "   } else {\n"
-        "       if(size <= 48) {\n"
-        "           return  ((((u64)a[5]) << 40) | (((u64)a[4]) << 32) | (((u64)a[3]) << 24) | "
-        "(((u64)a[2]) << 16) | (((u64)a[1]) << 8) | a[0]);\n"
-        "       } else {\n"
-        "           return  ((((u64)a[6]) << 48) | (((u64)a[5]) << 40) | (((u64)a[4]) << 32) | "
-        "(((u64)a[3]) << 24) | (((u64)a[2]) << 16) | (((u64)a[1]) << 8) | a[0]);\n"
-        "       }\n"
-        "   }\n"
-        "}\n"
-        "static inline void storePrimitive32(u8 *a, int size, u32 value) {\n"
-        "   if(size <= 16 || size > 24) {\n"
-        "       bpf_printk(\"Invalid size.\");\n"
-        "   }\n"
-        "   a[0] = (u8)(value);\n"
-        "   a[1] = (u8)(value >> 8);\n"
-        "   a[2] = (u8)(value >> 16);\n"
-        "}\n"
-        "static inline void storePrimitive64(u8 *a, int size, u64 value) {\n"
-        "   if(size <= 32 || size > 56) {\n"
-        "       bpf_printk(\"Invalid size.\");\n"
-        "   }\n"
-        "   a[0] = (u8)(value);\n"
-        "   a[1] = (u8)(value >> 8);\n"
-        "   a[2] = (u8)(value >> 16);\n"
-        "   a[3] = (u8)(value >> 24);\n"
-        "   a[4] = (u8)(value >> 32);\n"
-        "   if (size > 40) {\n"
-        "       a[5] = (u8)(value >> 40);\n"
-        "   }\n"
-        "   if (size > 48) {\n"
-        "       a[6] = (u8)(value >> 48);\n"
-        "   }\n"
-        "}\n";
-    builder->appendLine(code);
+    builder->append(globalFunctionsSkeleton());
 }
 
 void PNAArchTC::emitParser(EBPF::CodeBuilder *builder) const {
@@ -1622,24 +1666,21 @@ void EBPFTablePNA::emitAction(EBPF::CodeBuilder *builder, cstring valueName,
         }
         bool generateDefaultMissCode = false;
         bool generateDefaultHitCode = false;
-        for (auto tbl : tcIR->tcPipeline->tableDefs) {
-            if (tbl->getTableName() == table->container->name.originalName) {
-                if (tbl->isTcMayOverrideMiss) {
-                    cstring defaultActionName = tbl->defaultMissAction->getActionName();
-                    defaultActionName = defaultActionName.substr(
-                        defaultActionName.find('/') - defaultActionName.begin() + 1,
-                        defaultActionName.size());
-                    if (defaultActionName == action->name.originalName)
-                        generateDefaultMissCode = true;
-                }
-                if (tbl->isTcMayOverrideHit) {
-                    cstring defaultActionName = tbl->defaultHitAction->getActionName();
-                    defaultActionName = defaultActionName.substr(
-                        defaultActionName.find('/') - defaultActionName.begin() + 1,
-                        defaultActionName.size());
-                    if (defaultActionName == action->name.originalName)
-                        generateDefaultHitCode = true;
-                }
+        if (auto desc = tcIR->getTableDescriptor(table->container->name.originalName)) {
+            auto tbl = desc->tableDef;
+            if (tbl->isTcMayOverrideMiss) {
+                cstring defaultActionName = tbl->defaultMissAction->getActionName();
+                defaultActionName = defaultActionName.substr(
+                    defaultActionName.find('/') - defaultActionName.begin() + 1,
+                    defaultActionName.size());
+                if (defaultActionName == action->name.originalName) generateDefaultMissCode = true;
+            }
+            if (tbl->isTcMayOverrideHit) {
+                cstring defaultActionName = tbl->defaultHitAction->getActionName();
+                defaultActionName = defaultActionName.substr(
+                    defaultActionName.find('/') - defaultActionName.begin() + 1,
+                    defaultActionName.size());
+                if (defaultActionName == action->name.originalName) generateDefaultHitCode = true;
             }
         }
         if (generateDefaultMissCode || generateDefaultHitCode) {
@@ -2680,9 +2721,9 @@ void ControlBodyTranslatorPNA::processApply(const P4::ApplyMethod *method) {
         builder->emitIndent();
         builder->appendLine("    .pipeid = p4tc_filter_fields.pipeid,");
         builder->emitIndent();
-        auto tblId = tcIR->getTableId(method->object->getName().originalName);
-        BUG_CHECK(tblId != 0, "Table ID not found");
-        builder->appendFormat("    .tblid = %d", tblId);
+        auto tblDesc = tcIR->getTableDescriptor(method->object->getName().originalName);
+        BUG_CHECK(tblDesc != nullptr, "Table ID not found");
+        builder->appendFormat("    .tblid = %d", tblDesc->tableId);
         builder->newline();
         builder->emitIndent();
         builder->appendLine("};");
@@ -2693,9 +2734,8 @@ void ControlBodyTranslatorPNA::processApply(const P4::ApplyMethod *method) {
         builder->appendFormat("__builtin_memset(&%s, 0, sizeof(%s))", keyname.c_str(),
                               keyname.c_str());
         builder->endOfStatement(true);
-        unsigned int keysize = tcIR->getTableKeysize(tblId);
         builder->emitIndent();
-        builder->appendFormat("%s.keysz = %d;", keyname.c_str(), keysize);
+        builder->appendFormat("%s.keysz = %d;", keyname.c_str(), tblDesc->keySize);
         builder->newline();
         // Emit Keys
         for (auto c : table->keyGenerator->keyElements) {
@@ -53,8 +53,7 @@ IR::ToplevelBlock *MidEnd::run(TCOptions &options, const IR::P4Program *program,
             new P4::ConstantFolding(&typeMap),
             new P4::StrengthReduction(&typeMap),
         }),
-        new P4::RemoveSelectBooleans(&typeMap),
-        new P4::SingleArgumentSelect(&typeMap),
+        new P4::LowerSelects(&typeMap),
         new P4::ConstantFolding(&typeMap),
         new P4::SimplifyControlFlow(&typeMap, true),
         new P4::TableHit(&typeMap),
@@ -42,17 +42,16 @@ and limitations under the License.
 #include "midend/eliminateTuples.h"
 #include "midend/expandEmit.h"
 #include "midend/local_copyprop.h"
+#include "midend/lowerSelects.h"
 #include "midend/midEndLast.h"
 #include "midend/noMatch.h"
 #include "midend/parserUnroll.h"
 #include "midend/removeExits.h"
 #include "midend/removeLeftSlices.h"
 #include "midend/removeMiss.h"
-#include "midend/removeSelectBooleans.h"
 #include "midend/simplifyKey.h"
 #include "midend/simplifySelectCases.h"
 #include "midend/simplifySelectList.h"
-#include "midend/singleArgumentSelect.h"
 #include "midend/tableHit.h"
 #include "midend/validateProperties.h"
 #include "options.h"
@@ -17,6 +17,9 @@
 
 #include "hashexpr.h"
 
+#include <map>
+#include <string>
+
 #include "input_xbar.h"
 #include "lib/bitops.h"
 #include "lib/bitvec.h"
@@ -60,6 +63,50 @@ void HashExpr::gen_ixbar_init(ixbar_init_t *ixbar_init, std::vector<ixbar_input_
     ixbar_init->outputs_sz = outputs.size();
 }
 
+/**
+ * Memoized hash columns, keyed by hash_column_key below.  Identical hash
+ * configurations (the same algorithm over the same input layout) recur across
+ * many tables, and recomputing the galois matrix for each of their logical
+ * hash bits is one of the more expensive parts of assembling hash-heavy
+ * programs.
+ */
+static std::map<std::string, bitvec> hash_column_cache;
+
+/**
+ * Builds the memoization key for a single hash column computation: the
+ * algorithm description, the logical hash bit, the input layout, and the hash
+ * table the column is extracted from.  Everything determine_hash_matrix and
+ * global_column0_extract read is encoded, so equal keys yield equal columns.
+ */
+static std::string hash_column_key(const bfn_hash_algorithm_t &alg,
+                                   const std::vector<ixbar_input_t> &inputs, int logical_hash_bit,
+                                   InputXbar::HashTable hash_table) {
+    std::string key;
+    auto add = [&key](uint64_t v) {
+        for (int i = 0; i < 8; ++i) key += static_cast<char>(v >> (8 * i));
+    };
+    add(alg.hash_alg);
+    add(alg.msb);
+    add(alg.extend);
+    add(static_cast<uint64_t>(alg.hash_bit_width));
+    add(alg.reverse);
+    add(alg.poly);
+    add(alg.init);
+    add(alg.final_xor);
+    add(static_cast<uint64_t>(logical_hash_bit));
+    add(hash_table.uid());
+    for (auto &input : inputs) {
+        add(input.type);
+        add(input.ixbar_bit_position);
+        add(input.bit_size);
+        add(input.symmetric_info.is_symmetric);
+        add(input.symmetric_info.sym_group);
+        add(input.symmetric_info.sib_sym_group);
+        add(input.type == tCONST ? input.u.constant : static_cast<uint64_t>(input.u.valid));
+    }
+    return key;
+}
+
 /**
  * The function call for PhvRef, Random, Identity, and Crc functions.  The input xbar is
  * initialized, and the data returned writes out a vector of inputs.  For Stripe,
@@ -74,6 +121,18 @@ void HashExpr::gen_data(bitvec &data, int logical_hash_bit, InputXbar *ix,
 
     gen_ixbar_init(&ixbar_init, inputs, outputs, logical_hash_bit, ix, hash_table);
 
+    // RANDOM_DYN columns are meant to be independent draws, so they are never
+    // cached; everything else is deterministic in the key.
+    std::string key;
+    if (hash_algorithm.hash_alg != RANDOM_DYN) {
+        key = hash_column_key(hash_algorithm, inputs, logical_hash_bit, hash_table);
+        auto cached = hash_column_cache.find(key);
+        if (cached != hash_column_cache.end()) {
+            data |= cached->second;
+            return;
+        }
+    }
+
     bool non_zero = false;
     int loops = 0;
     // It is possible that a hash column can be genereated as all 0s if using RANDOM_DYN algo, so
@@ -87,7 +146,9 @@ void HashExpr::gen_data(bitvec &data, int logical_hash_bit, InputXbar *ix,
         }
         BUG_CHECK(loops++ < 1000, "Looping trying to get a valid RANDOM_DYN matrix");
     }
-    data |= ix->global_column0_extract(hash_table, hash_matrix);
+    bitvec column = ix->global_column0_extract(hash_table, hash_matrix);
+    if (!key.empty()) hash_column_cache[key] = column;
+    data |= column;
 }
 
 class HashExpr::PhvRef : HashExpr {
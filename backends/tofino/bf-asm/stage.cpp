@@ -238,6 +238,13 @@ void AsmStage::input(VECTOR(value_t) args, value_t data) {
     }
 }
 
+/* Stages are processed one at a time even though most of the per-table work is local to
+ * its stage.  Farming the passes out to a per-stage thread pool does not work in the
+ * current structure: the passes are globally ordered (every table's pass1 must finish
+ * before any pass2, since pass2 reads cross-stage state such as attached-table home rows
+ * and stage dependencies), Phv::setuse below mutates gress-wide use maps, and
+ * error()/warning() and the name lookup tables are unguarded globals touched from every
+ * table method.  Any parallel split would need those globals threaded through first. */
 void AsmStage::process() {
     for (auto &stage : pipe) {
         stage.pass1_logical_id = stage.pass1_tcam_id = -1;
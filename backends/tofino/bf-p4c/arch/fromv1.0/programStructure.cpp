@@ -1016,11 +1016,46 @@ const IR::P4Control *TnaProgramStructure::convertControl(const IR::V1Control *co
     return new IR::P4Control(ctrl->name, ctrl->type, *locals, body);
 }
 
+/// Deep-clones a converted parser state (or the declarations its conversion produced) so
+/// the result can be reused by the other gress's parser.  The two parsers must not share
+/// IR nodes, so every node in the subtree gets a fresh copy (forceClone); and since the
+/// extract bookkeeping in the base converter is keyed by node identity, cloned extract
+/// calls are re-registered as they are copied.
+class CloneConvertedParserState : public Transform {
+    ProgramStructure *structure;
+
+    const IR::Node *postorder(IR::MethodCallExpression *mce) override {
+        auto orig = getOriginal<IR::MethodCallExpression>();
+        auto ht = P4::get(structure->extractsSynthesized, orig);
+        if (ht != nullptr) structure->extractsSynthesized.emplace(mce, ht);
+        return mce;
+    }
+
+ public:
+    explicit CloneConvertedParserState(ProgramStructure *structure) : structure(structure) {
+        forceClone = true;
+        setName("CloneConvertedParserState");
+    }
+};
+
 // Adapted from frontend with changes on how name annotation is generated.
 // Specifically, this function generates local name annotation for pvs and
 // parser state instead of global name annotation.
 const IR::ParserState *TnaProgramStructure::convertParser(
     const IR::V1Parser *parser, IR::IndexedVector<IR::Declaration> *stateful) {
+    // createIngressParser and createEgressParser both convert every state of the V1
+    // parser, and the two conversions are identical: the parsers register the same
+    // "pkt"/"hdr"/"meta" parameter names, and the per-gress entry-point rename is
+    // applied by the caller afterwards.  Convert each state once and replay a clone of
+    // the cached result for the other gress.
+    auto cached = convertedParserStates.find(parser);
+    if (cached != convertedParserStates.end()) {
+        CloneConvertedParserState cloner(this);
+        for (auto d : cached->second.stateful)
+            stateful->push_back(d->apply(cloner)->to<IR::Declaration>());
+        return cached->second.state->apply(cloner)->to<IR::ParserState>();
+    }
+    auto statefulBefore = stateful->size();
     ExpressionConverter conv(this);
 
     latest = nullptr;
@@ -1122,6 +1157,10 @@ const IR::ParserState *TnaProgramStructure::convertParser(
         parser->srcInfo, parser->name,
         IR::Annotations::maybeAddNameAnnotation(parser->annotations, parser->name), components,
         select);
+    auto &record = convertedParserStates[parser];
+    record.state = result;
+    for (auto i = statefulBefore; i < stateful->size(); ++i)
+        record.stateful.push_back(stateful->at(i));
     return result;
 }
 
@@ -164,6 +164,16 @@ class TnaProgramStructure : public ProgramStructure {
     IR::IndexedVector<IR::ParserState> *createMirrorStates();
     IR::IndexedVector<IR::ParserState> *createResubmitStates();
 
+    /// Conversion result for one V1 parser state: the converted state and the stateful
+    /// declarations (parser value sets) the conversion added to the enclosing parser.
+    struct ConvertedParserState {
+        const IR::ParserState *state;
+        std::vector<const IR::Declaration *> stateful;
+    };
+    /// Ingress and egress parser construction each convert the whole V1 parser, so every
+    /// state is converted once and replayed as a deep clone for the other gress.
+    ordered_map<const IR::V1Parser *, ConvertedParserState> convertedParserStates;
+
     // types
     void removeType(cstring typeName, cstring headerName);
     void removeP14IntrinsicMetadataTypes();
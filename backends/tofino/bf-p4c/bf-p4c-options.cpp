@@ -342,6 +342,23 @@ BFN_Options::BFN_Options() {
             return true;
         },
         "Do not reorder tables in a basic block");
+    registerOption(
+        "--table-placement-incremental-replay", nullptr,
+        [this](const char *) {
+            table_placement_incremental_replay = true;
+            return true;
+        },
+        "Replay the previous fitting round's placement decisions up to the first "
+        "divergence and re-solve only the affected stages");
+    registerOption(
+        "--table-placement-journal", "file",
+        [this](const char *arg) {
+            table_placement_journal = cstring(arg);
+            return true;
+        },
+        "Persist the table placement decisions of a successful fit in the given file "
+        "(one per pipe) and replay them on subsequent compiles up to the first "
+        "divergence, so re-fits after small edits only re-solve the affected stages");
     registerOption(
         "--disable_backfill", nullptr,
         [this](const char *) {
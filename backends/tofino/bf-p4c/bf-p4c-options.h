@@ -54,6 +54,9 @@ class BFN_Options : public CompilerOptions {
     bool disable_table_placement_backfill = false;
     bool disable_egress_latency_padding = false;
     bool table_placement_in_order = false;
+    bool table_placement_incremental_replay = false;
+    // Base name of the per-pipe decision journal files; nullptr disables the journal.
+    cstring table_placement_journal = nullptr;
     bool table_placement_long_branch_backtrack = false;
     bool disable_gfm_parity = true;
     int relax_phv_init = 0;
@@ -52,6 +52,7 @@
 #include "frontends/p4/strengthReduction.h"
 #include "frontends/p4/typeMap.h"
 #include "frontends/p4/uselessCasts.h"
+#include "lib/hash.h"
 #include "midend/local_copyprop.h"
 
 // included by PackFlexibleHeaders
@@ -1103,12 +1104,48 @@ void ConstraintSolver::add_extract_together_constraints(cstring hdr,
     }
 }
 
+/**
+ * Computes a fingerprint of everything the constraint encoding reads for a set of fields:
+ * the per-field attributes and the pairwise relations from PhvInfo. Field objects are
+ * rebuilt between packing rounds, so the fingerprint works from attributes rather than
+ * field identity.
+ */
+uint64_t ConstraintSolver::constraint_fingerprint(ordered_set<const PHV::Field *> &fields) {
+    uint64_t hash = fields.size();
+    for (auto f : fields) {
+        auto align = f->getAlignmentConstraint();
+        hash = Util::hash_combine(hash, std::hash<cstring>()(f->name));
+        hash = Util::hash_combine(
+            hash, (uint64_t(uint32_t(f->size)) << 32) |
+                      (align.hasConstraint() ? (align.getAlignment() | 0x100) : 0));
+        hash = Util::hash_combine(hash, (uint64_t(uint32_t(f->no_split_container_size())) << 32) |
+                                            (f->is_solitary() << 3) | (f->no_split() << 2) |
+                                            (f->deparsed_to_tm() << 1));
+        for (auto g : fields) {
+            if (f->id == g->id) continue;
+            hash = Util::hash_combine(
+                hash, uint64_t((phv.are_bridged_extracted_together(f, g) << 2) |
+                               (phv.isFieldNoPack(f, g) << 1) | phv.are_mutually_aligned(f, g)));
+        }
+    }
+    return hash;
+}
+
 /**
  * Initializes the Z3 solver with mutually aligned constraints from PhvInfo.
  */
 void ConstraintSolver::add_mutually_aligned_constraints(ordered_set<const PHV::Field *> &fields) {
     if (!fields.size()) return;
 
+    // The same field lists come back round after round; skip re-asserting when nothing
+    // relevant changed since the previous round.
+    auto fingerprint = constraint_fingerprint(fields);
+    if (mutually_aligned_fingerprint == fingerprint) {
+        LOG3("Mutually aligned constraints are unchanged; reusing previous assertions");
+        return;
+    }
+    mutually_aligned_fingerprint = fingerprint;
+
     // mutually aligned constraint
     using const_iterator = ordered_set<const PHV::Field *>::const_iterator;
     for (const_iterator it = fields.begin(); it != fields.end(); it++) {
@@ -1296,6 +1333,18 @@ const PHV::Field *ConstraintSolver::create_padding(int size) {
  */
 void ConstraintSolver::add_constraints(cstring hdr, ordered_set<const PHV::Field *> &fields) {
     for (auto f : fields) LOG6("add constraints for " << f);
+
+    // The same header type shows up in one packing round per bridge path and its assertions
+    // from earlier rounds persist in the solver, so only re-encode it when its constraints
+    // changed; skipping otherwise also avoids stacking duplicate minimize objectives.
+    auto fingerprint = constraint_fingerprint(fields);
+    auto it = encoded_headers.find(hdr);
+    if (it != encoded_headers.end() && it->second == fingerprint) {
+        LOG3("Constraints for " << hdr << " are unchanged; reusing previous assertions");
+        return;
+    }
+    encoded_headers[hdr] = fingerprint;
+
     /// Computes upper bound of the overall size of all fields, which is used as a constraint
     /// to Z3 solver in the ConstraintSolver::add_field_alignment_constraints method.
     /// It assumes that each field is padded to next byte boundary.
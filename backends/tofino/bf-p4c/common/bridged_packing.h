@@ -455,6 +455,18 @@ class ConstraintSolver {
     void add_no_pack_constraints(cstring, ordered_set<const PHV::Field *> &);
     void add_no_split_constraints(cstring, ordered_set<const PHV::Field *> &);
 
+    /// Fingerprints of the constraint systems already asserted into the solver, per header.
+    /// Bridge packing applies the solver to several near-identical bridge paths per compile
+    /// and the assertions from earlier rounds persist in the solver, so a header only needs
+    /// to be re-encoded when its constraints actually changed. PHV::Field objects are rebuilt
+    /// between rounds, so the fingerprint covers the field attributes and pairwise relations
+    /// the encoding reads rather than the field pointers.
+    ordered_map<cstring, uint64_t> encoded_headers;
+    /// Likewise for the mutual-alignment constraints spanning all field lists.
+    uint64_t mutually_aligned_fingerprint = 0;
+
+    uint64_t constraint_fingerprint(ordered_set<const PHV::Field *> &);
+
     const PHV::Field *create_padding(int size);
     std::vector<const PHV::Field *> insert_padding(std::vector<std::pair<unsigned, std::string>> &);
 
@@ -98,17 +98,27 @@ Visitor::profile_t FieldDefUse::init_apply(const IR::Node *root) {
     return rv;
 }
 
+/** Map a unit stage to a dense bit index for info::use_stages.  Unit::stage() returns -1
+ *  for parser units (and unplaced tables), a small stage number for placed tables, and
+ *  INT_MAX for the deparser, so shift by one and clamp the deparser to a fixed high bit.
+ *  The mapping is order preserving for any realistic stage count. */
+static int stage_bit(int stage) {
+    if (stage < 0) return 0;
+    if (stage >= 254) return 255;
+    return stage + 1;
+}
+
 void FieldDefUse::check_conflicts(const info &read, int when) {
     int firstdef = INT_MAX;
     for (auto def : read.def) firstdef = std::min(firstdef, def.first->stage());
+    if (firstdef > when) return;
+    int lo = stage_bit(firstdef);
+    int size = stage_bit(when) - lo + 1;
     for (auto &other : defuse) {
         if (other.field == nullptr) continue;
         if (other.field == read.field) continue;
-        for (auto use : other.use) {
-            int use_when = use.first->stage();
-            if (use_when >= firstdef && use_when <= when)
-                conflict(read.field->id, other.field->id) = true;
-        }
+        if (!other.use_stages.getslice(lo, size).empty())
+            conflict(read.field->id, other.field->id) = true;
     }
 }
 
@@ -126,8 +136,10 @@ void FieldDefUse::read(const PHV::Field *f, std::optional<le_bitrange> range,
     auto &info = field(f);
     LOG3("defuse: " << DBPrint::Brief << *unit << " reading " << f->name);
     info.use.clear();
+    info.use_stages.clear();
     locpair use(unit, e);
     info.use.emplace(use);
+    info.use_stages.setbit(stage_bit(unit->stage()));
     located_uses[f->id].emplace(use);
     check_conflicts(info, unit->stage());
     for (auto &def : info.def) {
@@ -240,6 +252,7 @@ void FieldDefUse::write(const PHV::Field *f, std::optional<le_bitrange> range,
         // we don't mark it as a use of previous writes, and don't clobber those previous writes.
         if (!range) {
             info.use.clear();
+            info.use_stages.clear();
             // Though parser do OR value into phv, as long as it is not partial, the zero-init
             // def should be remove, because this def will override the 0.
             safe_vector<locpair> to_rm;
@@ -256,6 +269,7 @@ void FieldDefUse::write(const PHV::Field *f, std::optional<le_bitrange> range,
         }
 
         info.use.emplace(unit, e);
+        info.use_stages.setbit(stage_bit(unit->stage()));
         check_conflicts(info, unit->stage());
         for (auto &def : info.def)
             LOG4("  " << e << " in " << *unit << " combines with " << def.second << " from "
@@ -505,6 +519,7 @@ void FieldDefUse::flow_merge(Visitor &a_) {
         BUG_CHECK(&info != &i, "same object in FieldDefUse::flow_merge");
         info.def.insert(i.def.begin(), i.def.end());
         info.use.insert(i.use.begin(), i.use.end());
+        info.use_stages |= i.use_stages;
 
         // consider a program like this:
         // bit<16> foo = 1;
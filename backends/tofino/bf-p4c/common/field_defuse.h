@@ -25,6 +25,7 @@
 #include "backends/tofino/bf-p4c/ir/tofino_write_context.h"
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
 #include "ir/ir.h"
+#include "lib/bitvec.h"
 #include "lib/ltbitmatrix.h"
 #include "lib/ordered_set.h"
 #include "lib/symbitmatrix.h"
@@ -120,6 +121,10 @@ class FieldDefUse : public BFN::ControlFlowVisitor, public Inspector, TofinoWrit
     struct info {
         const PHV::Field *field = nullptr;
         LocPairSet def, use;
+        /// Stages of the units in `use`, remapped to dense bit indexes (see stage_bit in
+        /// field_defuse.cpp).  Kept in sync with `use` so check_conflicts can test a stage
+        /// range with one bitvec slice instead of iterating every use of every other field.
+        bitvec use_stages;
         ordered_map<locpair, ordered_set<le_bitrange>> def_covered_ranges_map;
         // The reason to have a set of bit range is that there is a case that new def's range only
         // shadows a segment of a previous range, e.g., [3,5] shadows [0,7]. In this case, the
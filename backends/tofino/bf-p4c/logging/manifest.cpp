@@ -390,6 +390,7 @@ void Manifest::setPipe(const int pipeID_in, const cstring pipe_name) {
     m_pipes.emplace(m_pipeId, pipe_name);
     // and add implicitly add the pipe outputs so that even if there are no
     // files produced by the compiler, we get the pipe structure.
+    std::lock_guard<std::mutex> lock(m_pipeOutputsMutex);
     getPipeOutputs(pipeID_in);
 }
 
@@ -399,6 +400,7 @@ void Manifest::addGraph(const int pipe, const cstring graphType, const cstring g
                           .getOutputDirectory("graphs"_cs, pipe)
                           .substr(m_options.outputDir.size() + 1) +
                       "/" + graphName + ext;
+    std::lock_guard<std::mutex> lock(m_pipeOutputsMutex);
     getPipeOutputs(pipe)->m_graphs.insert(GraphOutput(path, gress, graphType, ext));
 }
 
@@ -407,6 +409,7 @@ void Manifest::addLog(const int pipe, const cstring logType, const cstring logNa
                           .getOutputDirectory("logs"_cs, pipe)
                           .substr(m_options.outputDir.size() + 1) +
                       "/" + logName;
+    std::lock_guard<std::mutex> lock(m_pipeOutputsMutex);
     getPipeOutputs(pipe)->m_logs.insert(PathAndType(path, logType));
 }
 
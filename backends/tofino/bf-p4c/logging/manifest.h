@@ -25,6 +25,7 @@
 #include <cstdarg>
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -102,6 +103,9 @@ class Manifest : public Inspector {
     std::map<unsigned int, cstring> m_pipes;
     /// map of pipe-id to OutputFiles
     std::map<unsigned int, OutputFiles *> m_pipeOutputs;
+    /// Guards m_pipeOutputs and the OutputFiles it holds: the output passes
+    /// register their files from concurrent threads (see GenerateOutputs).
+    std::mutex m_pipeOutputsMutex;
     InputFiles m_programInputs;
     cstring m_eventLogPath, m_frontendIrLogPath;
     /// reference to ProgramPipelines to generate the architecture configuration
@@ -135,8 +139,12 @@ class Manifest : public Inspector {
 
     void setSuccess(const bool success) { m_success = success; }
 
-    void addContext(const int pipe, const cstring path) { getPipeOutputs(pipe)->m_context = path; }
+    void addContext(const int pipe, const cstring path) {
+        std::lock_guard<std::mutex> lock(m_pipeOutputsMutex);
+        getPipeOutputs(pipe)->m_context = path;
+    }
     void addResources(const int pipe, const cstring path, const cstring type = "resources"_cs) {
+        std::lock_guard<std::mutex> lock(m_pipeOutputsMutex);
         getPipeOutputs(pipe)->m_resources.insert(PathAndType(path, type));
     }
     void addGraph(int pipe, const cstring graphType, const cstring graphName, const gress_t gress,
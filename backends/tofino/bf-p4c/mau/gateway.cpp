@@ -479,42 +479,38 @@ static const IR::Expression *simplifyRow(const IR::Expression *e) {
     return e;
 }
 
-/* break apart the terms of a conjunction into a set of conjuncts */
-static std::set<const IR::Expression *> rowConjuncts(const IR::Expression *e) {
-    std::set<const IR::Expression *> rv;
-    while (auto *conj = e->to<IR::LAnd>()) {
-        rv.insert(conj->right);
-        e = conj->left;
-    }
-    rv.insert(e);
-    return rv;
-}
+/** Interns gateway conjunct terms so that equivalent expressions (by equiv()) share a
+ * small id, and summarizes a row conjunction as the bitvec of its term ids.  A previous
+ * row then dominates a later one exactly when its term set is a subset of the later
+ * row's, so the check is a bitvec operation instead of re-running the expression
+ * comparisons for every pair of rows; each term is compared against the dictionary
+ * just once per row. */
+class RowTermIndex {
+    std::vector<const IR::Expression *> terms;
+    std::map<const IR::Expression *, int> byNode;  // terms already seen, by node identity
 
-/* remove a conjunct from a set of conjuncts if present.  FIXME This would be much more
- * efficient if the IR generator supported autogen hash and/or operator< for IR nodes
- * to allow efficient set tracking */
-static void removeConjunct(std::set<const IR::Expression *> &s, const IR::Expression *e) {
-    for (auto it = s.begin(); it != s.end();) {
-        if (e->equiv(**it))
-            it = s.erase(it);
-        else
-            ++it;
+    int id(const IR::Expression *e) {
+        auto it = byNode.find(e);
+        if (it != byNode.end()) return it->second;
+        size_t i;
+        for (i = 0; i < terms.size(); ++i)
+            if (e->equiv(*terms[i])) break;
+        if (i == terms.size()) terms.push_back(e);
+        byNode.emplace(e, i);
+        return i;
     }
-}
 
-/** Test a row conjunction to see if it contains every term in a previous row.  If it
- * does it can be safely reomved as it will never match (the previous row will also
- * match, and at a higher priority, dominating it).   We need a copy of the 'prev'
- * set here so we can modify to see if all elements are present */
-static bool rowDominates(std::set<const IR::Expression *> prev, const IR::Expression *e) {
-    while (auto *conj = e->to<IR::LAnd>()) {
-        removeConjunct(prev, conj->right);
-        if (prev.empty()) return true;
-        e = conj->left;
-    }
-    removeConjunct(prev, e);
-    return prev.empty();
-}
+ public:
+    bitvec row(const IR::Expression *e) {
+        bitvec rv;
+        while (auto *conj = e->to<IR::LAnd>()) {
+            rv[id(conj->right)] = 1;
+            e = conj->left;
+        }
+        rv[id(e)] = 1;
+        return rv;
+    }
+};
 
 void CanonGatewayExpr::removeUnusedRows(IR::MAU::Table *tbl, bool isCanon) {
     auto &rows = tbl->gateway_rows;
@@ -525,7 +521,8 @@ void CanonGatewayExpr::removeUnusedRows(IR::MAU::Table *tbl, bool isCanon) {
     // While doing that, track the next tags that we remove and keep.
     bool erase_rest = false;
     std::set<cstring> removed, present;  // next tags in the table from the gateway
-    std::vector<std::set<const IR::Expression *>> prevRowTerms;
+    RowTermIndex terms;
+    std::vector<bitvec> prevRowTerms;
     for (auto row = rows.begin(); row != rows.end();) {
         if (erase_rest) {
             removed.insert(row->second);
@@ -557,18 +554,25 @@ void CanonGatewayExpr::removeUnusedRows(IR::MAU::Table *tbl, bool isCanon) {
             }
             continue;
         }
+        // A row that contains every term of a previous row can be safely removed as it
+        // will never match (the previous row will also match, and at a higher priority,
+        // dominating it).  Only valid if the gateway is canonicalized, so the terms are
+        // only tracked then.
         bool remove_row = false;
-        for (auto &prev : prevRowTerms) {
-            if (rowDominates(prev, row->first)) {
-                remove_row = true;
-                break;
+        if (isCanon) {
+            bitvec rowTerms = terms.row(row->first);
+            for (auto &prev : prevRowTerms) {
+                if ((prev - rowTerms).empty()) {
+                    remove_row = true;
+                    break;
+                }
             }
+            if (!remove_row) prevRowTerms.push_back(std::move(rowTerms));
         }
         if (remove_row) {
             removed.insert(row->second);
             row = rows.erase(row);
         } else {
-            if (isCanon) prevRowTerms.push_back(rowConjuncts(row->first));
             present.insert(row->second);
             ++row;
         }
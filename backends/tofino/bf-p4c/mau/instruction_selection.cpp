@@ -591,6 +591,9 @@ static T *clone(const T *ir) {
 
 Visitor::profile_t DoInstructionSelection::init_apply(const IR::Node *root) {
     auto rv = MauTransform::init_apply(root);
+    phv_operand_cache.clear();
+    action_bus_operand_cache.clear();
+    src1_operand_cache.clear();
     return rv;
 }
 
@@ -751,33 +754,52 @@ const IR::MAU::Action *DoInstructionSelection::preorder(IR::MAU::Action *af) {
 }
 
 bool DoInstructionSelection::checkPHV(const IR::Expression *e) {
-    if (auto *c = e->to<IR::BFN::ReinterpretCast>()) return checkPHV(c->expr);
-    return phv.field(e);
+    auto it = phv_operand_cache.find(e);
+    if (it != phv_operand_cache.end()) return it->second;
+
+    bool rv;
+    if (auto *c = e->to<IR::BFN::ReinterpretCast>())
+        rv = checkPHV(c->expr);
+    else
+        rv = phv.field(e);
+    return phv_operand_cache[e] = rv;
 }
 
 bool DoInstructionSelection::checkActionBus(const IR::Expression *e) {
-    if (auto *c = e->to<IR::BFN::ReinterpretCast>()) return checkActionBus(c->expr);
-    if (auto *c = e->to<IR::BFN::SignExtend>()) return checkActionBus(c->expr);
-    if (auto slice = e->to<IR::Slice>()) return checkActionBus(slice->e0);
-    if (e->is<IR::Constant>()) return true;
-    if (e->is<IR::BoolLiteral>()) return true;
-    if (e->is<IR::MAU::ActionArg>()) return true;
-    if (e->is<IR::MAU::HashDist>()) return true;
-    if (e->is<IR::MAU::RandomNumber>()) return true;
-    if (e->is<IR::MAU::AttachedOutput>()) return true;
-    if (e->is<IR::MAU::StatefulCounter>()) return true;
-    if (auto m = e->to<IR::Member>())
-        if (m->expr->is<IR::MAU::AttachedOutput>()) return true;
-    return false;
+    auto it = action_bus_operand_cache.find(e);
+    if (it != action_bus_operand_cache.end()) return it->second;
+
+    auto classify = [this](const IR::Expression *e) {
+        if (auto *c = e->to<IR::BFN::ReinterpretCast>()) return checkActionBus(c->expr);
+        if (auto *c = e->to<IR::BFN::SignExtend>()) return checkActionBus(c->expr);
+        if (auto slice = e->to<IR::Slice>()) return checkActionBus(slice->e0);
+        if (e->is<IR::Constant>()) return true;
+        if (e->is<IR::BoolLiteral>()) return true;
+        if (e->is<IR::MAU::ActionArg>()) return true;
+        if (e->is<IR::MAU::HashDist>()) return true;
+        if (e->is<IR::MAU::RandomNumber>()) return true;
+        if (e->is<IR::MAU::AttachedOutput>()) return true;
+        if (e->is<IR::MAU::StatefulCounter>()) return true;
+        if (auto m = e->to<IR::Member>())
+            if (m->expr->is<IR::MAU::AttachedOutput>()) return true;
+        return false;
+    };
+    return action_bus_operand_cache[e] = classify(e);
 }
 
 bool DoInstructionSelection::checkSrc1(const IR::Expression *e) {
     LOG3("Checking src1 : " << e);
-    if (auto *c = e->to<IR::BFN::ReinterpretCast>()) return checkSrc1(c->expr);
-    if (auto *c = e->to<IR::BFN::SignExtend>()) return checkSrc1(c->expr);
-    if (auto slice = e->to<IR::Slice>()) return checkSrc1(slice->e0);
-    if (checkActionBus(e)) return true;
-    return phv.field(e);
+    auto it = src1_operand_cache.find(e);
+    if (it != src1_operand_cache.end()) return it->second;
+
+    auto classify = [this](const IR::Expression *e) -> bool {
+        if (auto *c = e->to<IR::BFN::ReinterpretCast>()) return checkSrc1(c->expr);
+        if (auto *c = e->to<IR::BFN::SignExtend>()) return checkSrc1(c->expr);
+        if (auto slice = e->to<IR::Slice>()) return checkSrc1(slice->e0);
+        if (checkActionBus(e)) return true;
+        return phv.field(e);
+    };
+    return src1_operand_cache[e] = classify(e);
 }
 
 bool DoInstructionSelection::checkConst(const IR::Expression *ex, long &value) {
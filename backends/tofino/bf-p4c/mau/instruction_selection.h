@@ -183,6 +183,14 @@ class DoInstructionSelection : public MauTransform, TofinoWriteContext {
     const IR::MAU::TableSeq *ts = nullptr;
     ordered_map<cstring, const IR::MAU::Instruction *> const_to_phv;
 
+    /// Operand classification caches, keyed on the expression node. The classifiers unwrap
+    /// casts and slices and bottom out in a PhvInfo lookup, and the same operand is re-examined
+    /// by several candidate patterns per primitive, so memoize the answers per node. IR nodes
+    /// are immutable, so entries stay valid for the lifetime of one apply.
+    assoc::map<const IR::Expression *, bool> phv_operand_cache;
+    assoc::map<const IR::Expression *, bool> action_bus_operand_cache;
+    assoc::map<const IR::Expression *, bool> src1_operand_cache;
+
     profile_t init_apply(const IR::Node *root) override;
     const IR::MAU::HashDist *preorder(IR::MAU::HashDist *hd) override {
         prune();
@@ -18,6 +18,9 @@
 
 #include "resource_estimate.h"
 
+#include <algorithm>
+#include <map>
+
 #include "backends/tofino/bf-p4c/mau/tofino/input_xbar.h"
 #include "hash_mask_annotations.h"
 #include "lib/bitops.h"
@@ -1035,11 +1038,63 @@ void StageUseEstimate::determine_initial_layout_option(const IR::MAU::Table *tbl
     }
 }
 
+namespace {
+
+/// A completed estimate plus the values the constructor wrote back through its
+/// in/out entries and attached_entries arguments.
+struct EstimateCacheEntry {
+    StageUseEstimate use;
+    int entries_out;
+    attached_entries_t attached_out;
+};
+
+std::map<StageUseEstimate::CacheKey, EstimateCacheEntry> estimate_cache;
+uint64_t estimate_cache_hits = 0;
+uint64_t estimate_cache_misses = 0;
+
+StageUseEstimate::CacheKey estimate_cache_key(const IR::MAU::Table *tbl, int entries,
+                                              const attached_entries_t &attached_entries,
+                                              bool prev_placed, bool gateway_attached,
+                                              bool disable_split) {
+    StageUseEstimate::CacheKey key;
+    key.table = tbl;
+    key.entries = entries;
+    key.flags = (prev_placed ? 1 : 0) | (gateway_attached ? 2 : 0) | (disable_split ? 4 : 0);
+    for (auto &att : attached_entries)
+        key.attached.emplace_back(att.first, att.second.entries, att.second.need_more,
+                                  att.second.first_stage);
+    return key;
+}
+
+}  // namespace
+
+void StageUseEstimate::clearCache() {
+    if (estimate_cache_hits + estimate_cache_misses > 0)
+        LOG2("StageUseEstimate cache: " << estimate_cache_hits << " hits, "
+                                        << estimate_cache_misses << " misses");
+    estimate_cache.clear();
+    estimate_cache_hits = 0;
+    estimate_cache_misses = 0;
+}
+
 /* Constructor to estimate the number of srams, tcams, and maprams a table will require*/
 StageUseEstimate::StageUseEstimate(const IR::MAU::Table *tbl, int &entries,
                                    attached_entries_t &attached_entries, LayoutChoices *lc,
                                    bool prev_placed, bool gateway_attached, bool disable_split,
                                    PhvInfo &phv) {
+    auto key =
+        estimate_cache_key(tbl, entries, attached_entries, prev_placed, gateway_attached,
+                           disable_split);
+    if (auto it = estimate_cache.find(key); it != estimate_cache.end()) {
+        ++estimate_cache_hits;
+        *this = it->second.use;
+        entries = it->second.entries_out;
+        attached_entries = it->second.attached_out;
+        LOG2("StageUseEstimate(" << tbl->name << ", " << entries << ", " << format_type
+                                 << ") from cache");
+        return;
+    }
+    ++estimate_cache_misses;
     HashMaskAnnotations hash_mask_annotations(tbl, phv);
     hash_bits_masked = hash_mask_annotations.hash_bits_masked();
     // Because the table is const, the layout options must be copied into the Object
@@ -1065,25 +1120,19 @@ StageUseEstimate::StageUseEstimate(const IR::MAU::Table *tbl, int &entries,
     exact_ixbar_bytes = tbl->layout.ixbar_bytes;
     // A hash action table currently cannot be split across stages if it does an action lookup,
     // thus if the table has been previously been placed and has multiple entries (is not a
-    // no_match table), the current stage table cannot be hash action
-    if (prev_placed && entries > 1) {
-        auto it = layout_options.begin();
-        while (it != layout_options.end()) {
-            if (it->layout.hash_action)
-                it = layout_options.erase(it);
-            else
-                it++;
-        }
-    }
-
-    if (gateway_attached) {
-        auto it = layout_options.begin();
-        while (it != layout_options.end()) {
-            if (it->layout.gateway_match)
-                it = layout_options.erase(it);
-            else
-                it++;
-        }
+    // no_match table), the current stage table cannot be hash action. Likewise a table with a
+    // gateway attached cannot use a gateway-match layout. Prune both in a single pass rather
+    // than with repeated vector erases.
+    bool prune_hash_action = prev_placed && entries > 1;
+    if (prune_hash_action || gateway_attached) {
+        layout_options.erase(std::remove_if(layout_options.begin(), layout_options.end(),
+                                            [&](const LayoutOption &lo) {
+                                                return (prune_hash_action &&
+                                                        lo.layout.hash_action) ||
+                                                       (gateway_attached &&
+                                                        lo.layout.gateway_match);
+                                            }),
+                             layout_options.end());
     }
     BUG_CHECK(tbl->conditional_gateway_only() || !layout_options.empty(), "No layout for %s", tbl);
     determine_initial_layout_option(tbl, entries, attached_entries);
@@ -1100,6 +1149,8 @@ StageUseEstimate::StageUseEstimate(const IR::MAU::Table *tbl, int &entries,
     // a non-informational crash,
     if (initial_entries == 0) entries = 0;
 
+    estimate_cache.emplace(std::move(key), EstimateCacheEntry{*this, entries, attached_entries});
+
     LOG2("StageUseEstimate(" << tbl->name << ", " << entries << ", " << format_type << ") "
                              << layout_options.size() << " layouts");
 }
@@ -19,6 +19,9 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_MAU_RESOURCE_ESTIMATE_H_
 #define BACKENDS_TOFINO_BF_P4C_MAU_RESOURCE_ESTIMATE_H_
 
+#include <tuple>
+#include <vector>
+
 #include "backends/tofino/bf-p4c/mau/attached_entries.h"
 #include "backends/tofino/bf-p4c/mau/table_layout.h"
 #include "lib/algorithm.h"
@@ -83,6 +86,26 @@ struct StageUseEstimate {
     StageUseEstimate(const IR::MAU::Table *, int &, attached_entries_t &, LayoutChoices *lc,
                      bool prev_placed, bool gateway_attached, bool disable_split, PhvInfo &phv);
 
+    /// The placement backtracking search constructs estimates for the same
+    /// table/entries/attached-entries combination thousands of times, so
+    /// completed constructions are cached, keyed by all the inputs that
+    /// influence the result.  The constructor also adjusts its entries and
+    /// attached_entries arguments, so those outputs are cached alongside the
+    /// estimate itself.  The cache must be cleared when the inputs the key
+    /// cannot see change, i.e. at the start of every placement round (layout
+    /// choices and PHV allocation are recomputed between rounds).
+    struct CacheKey {
+        const IR::MAU::Table *table;
+        int entries;
+        unsigned flags;  // prev_placed | gateway_attached << 1 | disable_split << 2
+        std::vector<std::tuple<const IR::MAU::AttachedMemory *, int, bool, bool>> attached;
+        bool operator<(const CacheKey &a) const {
+            return std::tie(table, entries, flags, attached) <
+                   std::tie(a.table, a.entries, a.flags, a.attached);
+        }
+    };
+    static void clearCache();
+
     StageUseEstimate operator+(const StageUseEstimate &a) const {
         StageUseEstimate rv = *this;
         rv += a;
@@ -2162,18 +2162,18 @@ const IR::MAU::SaluInstruction *CreateSaluInstruction::createInstruction() {
 }
 
 /**
- * @brief Compare two instructions if they are same and predicates are
- * not null.
+ * @brief Check whether two instructions compute the same value, i.e. they agree on
+ * everything from the output operand on and can differ only in the predicate.
  *
  * @param si1 First instruction to check
  * @param si2 Second instruction to check
- * @return true Both instructions are same, predicates are not same
+ * @return true Both instructions compute the same value (predicates may differ)
  * @return false Instructions have different options
  */
 static bool check_instructions(const IR::MAU::SaluInstruction *si1,
                                const IR::MAU::SaluInstruction *si2) {
-    // Similar instructions differs in one field only (the predicate).
     LOG3("Probing instructions: " << si1 << " and " << si2);
+    // Screen on the cheap structural fields before any deep operand comparison.
     if (si1->name != si2->name || si1->output_operand != si2->output_operand ||
         si1->operands.size() != si2->operands.size())
         return false;
@@ -2197,27 +2197,37 @@ void CreateSaluInstruction::insert_instruction(const IR::MAU::SaluInstruction *s
         auto si_orig = (*it)->to<IR::MAU::SaluInstruction>();
         BUG_CHECK(si_orig,
                   "SALU instruction is the only type which can be inserted into SALU assembler!");
-        // We don't want to insert same instruction which is already ther
-        if (si_orig->equiv(*si_insert)) {
+        // Both the duplicate and the merge test need the instructions to compute the same
+        // value, so check that once; the predicates then decide which case applies. Merged
+        // predicates grow with every control-flow path that reaches the same update, so
+        // avoiding a second deep traversal of them here matters for meter-heavy programs.
+        if (!check_instructions(si_orig, si_insert)) continue;
+
+        // Predicates (everything before the output operand) equivalent as well means the
+        // same instruction is already there and doesn't need to be inserted again.
+        bool same_predicate = true;
+        for (size_t i = 0; i < si_orig->output_operand; i++)
+            if (!si_orig->operands.at(i)->equiv(*si_insert->operands.at(i))) {
+                same_predicate = false;
+                break;
+            }
+        if (same_predicate) {
             LOG3("Same instruction " << si_insert
                                      << " has been detected. It will not be inserted again.");
             insert = false;
             break;
         }
 
-        bool similar_inst = check_instructions(si_orig, si_insert);
-        if (similar_inst) {
-            auto merged_pred = new IR::LOr(si_insert->operands.at(0), si_orig->operands.at(0));
+        auto merged_pred = new IR::LOr(si_insert->operands.at(0), si_orig->operands.at(0));
 
-            auto new_inst = si_insert->clone();
-            new_inst->operands[0] = merged_pred;
-            LOG3("Merging instruction " << si_orig << " and " << si_insert << " into " << new_inst);
+        auto new_inst = si_insert->clone();
+        new_inst->operands[0] = merged_pred;
+        LOG3("Merging instruction " << si_orig << " and " << si_insert << " into " << new_inst);
 
-            action->action.erase(it);
-            action->action.insert(it, new_inst);
-            insert = false;
-            break;
-        }
+        action->action.erase(it);
+        action->action.insert(it, new_inst);
+        insert = false;
+        break;
     }
 
     // Instruction cannot be merged a we can insert it here
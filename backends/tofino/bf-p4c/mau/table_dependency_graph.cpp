@@ -1582,24 +1582,33 @@ FindDependencyGraph::calc_topological_stage(unsigned dep_flags, DependencyGraph
 
     std::vector<ordered_set<DependencyGraph::Graph::vertex_descriptor>> rst;
     ordered_set<DependencyGraph::Graph::vertex_descriptor> processed;
+
+    // Kahn's algorithm with an explicit frontier.  Vertices enter the frontier
+    // when their in-degree drops to zero instead of being found by re-scanning
+    // every vertex per generation, which is quadratic on the long dependency
+    // chains this function is mostly called for.  Sorting the frontier keeps
+    // the same within-generation order the scan produced (vertex descriptors
+    // are assigned in insertion order).
+    std::vector<DependencyGraph::Graph::vertex_descriptor> frontier;
+    for (auto &kv : n_depending_on)
+        if (kv.second == 0) frontier.push_back(kv.first);
+
     while (processed.size() < num_vertices(dep_graph)) {
-        ordered_set<DependencyGraph::Graph::vertex_descriptor> this_generation;
-        // Select vertices of those current in-degree is 0 as members of this_generation.
-        // as long as they have not been processed yet.
-        LOG5("\t New while iteration over num_vertices - processed size: "
-             << processed.size() << "   graph vertices: " << num_vertices(dep_graph));
-
-        for (auto &kv : n_depending_on) {
-            if (!processed.count(kv.first) && kv.second == 0) {
-                this_generation.insert(kv.first);
-                LOG5("\t\t Non processed vertex: " << curr_dg.get_vertex(kv.first)->name << " with "
-                                                   << kv.second << " incoming deps");
-            } else if (!processed.count(kv.first) && kv.second) {
-                LOG5("\t\t Non processed vertex: " << curr_dg.get_vertex(kv.first)->name << " with "
+        std::sort(frontier.begin(), frontier.end());
+        ordered_set<DependencyGraph::Graph::vertex_descriptor> this_generation(frontier.begin(),
+                                                                               frontier.end());
+        frontier.clear();
+        if (LOGGING(5)) {
+            LOG5("\t New while iteration over num_vertices - processed size: "
+                 << processed.size() << "   graph vertices: " << num_vertices(dep_graph));
+            for (auto &kv : n_depending_on) {
+                if (processed.count(kv.first))
+                    LOG5("\t\t Processed vertex: " << curr_dg.get_vertex(kv.first)->name << " with "
                                                    << kv.second << " incoming deps");
-            } else {
-                LOG5("\t\t Processed vertex: " << curr_dg.get_vertex(kv.first)->name << " with "
-                                               << kv.second << " incoming deps");
+                else
+                    LOG5("\t\t Non processed vertex: " << curr_dg.get_vertex(kv.first)->name
+                                                       << " with " << kv.second
+                                                       << " incoming deps");
             }
         }
 
@@ -1643,7 +1652,7 @@ FindDependencyGraph::calc_topological_stage(unsigned dep_flags, DependencyGraph
                     dep != DependencyGraph::REDUCTION_OR_READ) {
                     happens_after_work_map[table_later].setbit(table_to_id.at(table));
                     happens_after_work_map[table_later] |= happens_after_work_map[table];
-                    n_depending_on[vertex_later]--;
+                    if (--n_depending_on[vertex_later] == 0) frontier.push_back(vertex_later);
                     auto &vertex_later_edges = n_depending_on_with_edges[vertex_later];
                     auto rm_edge =
                         std::find(vertex_later_edges.begin(), vertex_later_edges.end(), *out);
@@ -20,7 +20,9 @@
 
 #include <math.h>
 
+#include <functional>
 #include <set>
+#include <sstream>
 
 #include "backends/tofino/bf-p4c/common/utils.h"
 #include "backends/tofino/bf-p4c/lib/error_type.h"
@@ -606,15 +608,57 @@ void DoTableLayout::setup_action_layout(IR::MAU::Table *tbl) {
                                         af[0].bytes_per_loc[ActionData::IMMEDIATE];
 }
 
+namespace {
+
+/// Collects the PHV fields referenced anywhere in a table's actions.
+class CollectActionFields : public MauInspector {
+    const PhvInfo &phv;
+    ordered_set<const PHV::Field *> &fields;
+    bool preorder(const IR::Expression *e) override {
+        if (const auto *field = phv.field(e)) {
+            fields.insert(field);
+            return false;
+        }
+        return true;
+    }
+
+ public:
+    CollectActionFields(const PhvInfo &p, ordered_set<const PHV::Field *> &f)
+        : phv(p), fields(f) {}
+};
+
+}  // namespace
+
+uint64_t LayoutChoices::action_format_signature(const IR::MAU::Table *tbl) const {
+    std::stringstream ss;
+    ss << tbl->name << ":" << tbl->get_immediate_ctrl();
+    ordered_set<const PHV::Field *> fields;
+    CollectActionFields collect(phv, fields);
+    for (auto *act : Values(tbl->actions)) {
+        ss << *act;
+        act->apply(collect);
+    }
+    for (const auto *field : fields) ss << '|' << field->name << field->get_alloc();
+    return std::hash<std::string>()(ss.str());
+}
+
 void LayoutChoices::compute_action_formats(const IR::MAU::Table *tbl,
                                            ActionData::FormatType_t format_type) {
     LOG5("Computing action formats for table " << tbl->name);
     BUG_CHECK(format_type.valid(), "invalid format type in LayoutChoices::compute_action_formats");
+    auto &result = cache_action_formats[std::make_pair(tbl->name, format_type)];
+    auto memo_key = std::make_pair(action_format_signature(tbl), format_type);
+    if (auto it = memo_action_formats.find(memo_key); it != memo_action_formats.end()) {
+        LOG5("  Reusing action format solution computed in a previous round");
+        result = it->second;
+        return;
+    }
     ActionData::Format af(phv, tbl, red_info, att_info);
-    af.set_uses(&cache_action_formats[std::make_pair(tbl->name, format_type)]);
+    af.set_uses(&result);
 
     IR::MAU::Table::ImmediateControl_t imm_ctrl = tbl->get_immediate_ctrl();
     af.allocate_format(imm_ctrl, format_type);
+    memo_action_formats[memo_key] = result;
 }
 
 void LayoutChoices::setup_ternary_layout(const IR::MAU::Table *tbl,
@@ -19,6 +19,8 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_MAU_TABLE_LAYOUT_H_
 #define BACKENDS_TOFINO_BF_P4C_MAU_TABLE_LAYOUT_H_
 
+#include <cstdint>
+
 #include "backends/tofino/bf-p4c/mau/action_format.h"
 #include "backends/tofino/bf-p4c/mau/attached_output.h"
 #include "backends/tofino/bf-p4c/mau/mau_visitor.h"
@@ -121,6 +123,19 @@ class LayoutChoices {
     using cache_t = std::map<key_t, safe_vector<T>>;
     cache_t<LayoutOption> cache_layout_options;
     cache_t<ActionData::Format::Use> cache_action_formats;
+    /// Packing solutions memoized across placement rounds.  The per-round caches above
+    /// are invalidated wholesale by clear() because PHV allocation may have changed;
+    /// this memo instead keys a solution by the action-format signature of the table,
+    /// so a table whose actions and referenced PHV allocation are unchanged reuses the
+    /// previous round's solution instead of re-running the packing search.
+    std::map<std::pair<uint64_t, ActionData::FormatType_t>, safe_vector<ActionData::Format::Use>>
+        memo_action_formats;
+    /// Fingerprint of everything compute_action_formats depends on for @p tbl: the
+    /// structure of its actions, its immediate control, and the PHV allocation of every
+    /// field the actions reference.  Matching signatures make a memoized solution safe
+    /// to reuse, as action-format parameter matching is structural
+    /// (ActionData::Parameter::equiv_value), not pointer-based.
+    uint64_t action_format_signature(const IR::MAU::Table *tbl) const;
     int get_pack_pragma_val(const IR::MAU::Table *tbl, const IR::MAU::Table::Layout &layout_proto);
 
  public:
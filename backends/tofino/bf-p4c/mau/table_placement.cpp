@@ -32,6 +32,9 @@
 #include <vector>
 #endif
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
 #include <list>
 #include <sstream>
 #include <unordered_map>
@@ -361,6 +364,10 @@ bool TablePlacement::backtrack(trigger &trig) {
 
 Visitor::profile_t TablePlacement::init_apply(const IR::Node *root) {
     auto rv = PassManager::init_apply(root);
+    // Layout choices and PHV allocation may have changed since the last round,
+    // and the estimate cache key cannot see either.
+    StageUseEstimate::clearCache();
+    clear_alloc_caches();
     alloc_done = phv.alloc_done();
     summary.clearPlacementErrors();
     LOG1("Table Placement " << summary.getActualStateStr()
@@ -1437,6 +1444,11 @@ class DecidePlacement::FinalPlacement {
     // Simple hack to make sure the last strategy tried is evaluated with the least priority.
     BacktrackPlacement *first_complete = nullptr;
 
+    // Branch-and-bound incumbent: the number of stages of the best complete
+    // error-free solution found so far. Branches that already reach this many
+    // stages cannot win the final comparison and can be abandoned early.
+    int incumbent_stages = INT_MAX;
+
  public:
     FinalPlacement(DecidePlacement &self, ordered_set<const GroupPlace *> &w,
                    ordered_set<const IR::MAU::Table *> &p, const Placed *&a)
@@ -1457,6 +1469,9 @@ class DecidePlacement::FinalPlacement {
         else
             complete.insert(bp);
 
+        if (bp->get_placed() && bp->get_num_placement_errors() == 0)
+            incumbent_stages = std::min(incumbent_stages, bp->get_placed()->stage + 1);
+
         if ((bp->get_placed() == nullptr) || (bp->get_placed()->stage < Device::numStages())) {
             LOG3("Found a complete solution that fit the number of stages required");
             return;
@@ -1473,6 +1488,24 @@ class DecidePlacement::FinalPlacement {
         }
     }
 
+    int incumbent_bound() const { return incumbent_stages; }
+
+    // Abandon the branch being explored because it cannot beat the incumbent
+    // solution; restore the next incomplete placement if one remains.
+    // @returns false when there is no other branch left to switch to.
+    bool abandon_current_branch() {
+        if (incomplete.empty()) return false;
+        auto bt_it = incomplete.begin();
+        auto bt = *bt_it;
+        active_placed = bt->reset_place_table(active_work, false);
+        self.recomputePartlyPlaced(active_placed, partly_placed);
+        BUG_CHECK(self.resource_mode == bt->is_resource_mode(), "Inconsistent resource mode flag");
+        incomplete.erase(bt_it);
+        LOG3("Abandoned bounded branch; finalizing incomplete placement for resource mode:"
+             << self.resource_mode);
+        return true;
+    }
+
     void select_best_final_placement() {
         BUG_CHECK(first_complete != nullptr,
                   "Analyzing best final placement with no first complete solution");
@@ -1761,7 +1794,7 @@ bool TablePlacement::pick_layout_option(Placed *next, std::vector<Placed *> allo
             table_format = true;
         } else if (!next->table->conditional_gateway_only() &&
                    !next->table->is_always_run_action()) {
-            table_format = try_alloc_format(next, next->gw);
+            table_format = try_alloc_format(next, allocated_layout, next->gw);
         }
 
         if (!table_format) {
@@ -2001,10 +2034,140 @@ struct TablePlacement::RewriteForSplitAttached : public Transform {
     }
 };
 
+namespace {
+
+/** Memoization of the per-stage input crossbar and memory allocations.  Both allocators
+ *  start from scratch on every placement probe, and the search retries identical stage
+ *  contents many times across candidate orderings and backtracking rounds.  The keys
+ *  capture everything the allocators look at for each table in the stage (in add order,
+ *  which matters); the values replay the resulting resource state or the failure
+ *  messages.  Both caches are cleared each placement round from
+ *  TablePlacement::init_apply since the keyed IR nodes are rewritten between rounds. */
+struct StageTableSig {
+    const IR::MAU::Table *table;
+    const IR::MAU::Table *gw;
+    const LayoutOption *layout;
+    const ActionData::Format::Use *action_format;
+    ActionData::FormatType_t format_type;
+    int entries;
+    int stage_split;
+    std::vector<std::tuple<const IR::MAU::AttachedMemory *, int, bool, bool>> attached;
+    bool operator<(const StageTableSig &a) const {
+        return std::tie(table, gw, layout, action_format, format_type, entries, stage_split,
+                        attached) < std::tie(a.table, a.gw, a.layout, a.action_format,
+                                             a.format_type, a.entries, a.stage_split, a.attached);
+    }
+};
+
+StageTableSig stage_table_sig(const TablePlacement::Placed *p) {
+    StageTableSig sig{p->table,
+                      p->gw,
+                      p->use.preferred(),
+                      p->use.preferred_action_format(),
+                      p->use.format_type,
+                      p->entries,
+                      p->stage_split,
+                      {}};
+    for (auto &ae : p->attached_entries)
+        sig.attached.emplace_back(ae.first, ae.second.entries, ae.second.need_more,
+                                  ae.second.first_stage);
+    return sig;
+}
+
+struct IXBarAllocResult {
+    bool success;
+    // the ixbar-related parts of the placed table's resources (see clear_ixbar)
+    TableResourceAlloc alloc;
+    cstring error_message;
+};
+
+std::map<std::vector<StageTableSig>, IXBarAllocResult> ixbar_alloc_cache;
+uint64_t ixbar_alloc_cache_hits = 0, ixbar_alloc_cache_misses = 0;
+
+struct MemAllocKey {
+    bool shrink_lt;
+    std::vector<StageTableSig> tables;
+    bool operator<(const MemAllocKey &a) const {
+        return std::tie(shrink_lt, tables) < std::tie(a.shrink_lt, a.tables);
+    }
+};
+
+struct MemAllocResult {
+    bool success;
+    // per-table memuse in add order (last entry is the table being placed)
+    std::vector<std::map<UniqueId, Memories::Use>> memuse;
+    cstring error_message;
+    cstring stage_advance_log;
+};
+
+std::map<MemAllocKey, MemAllocResult> mem_alloc_cache;
+uint64_t mem_alloc_cache_hits = 0, mem_alloc_cache_misses = 0;
+
+struct FormatAllocResult {
+    bool success;
+    TableFormat::Use format;
+    cstring error_message;
+};
+
+// The match format depends only on the chosen layout/action format and on the input
+// crossbar allocation, which try_alloc_ixbar derives deterministically from the same stage
+// signature, so the stage signature (plus the gateway linkage) also keys the format.
+// Structurally identical tables share entries, so each distinct packing problem is solved
+// once per placement round.
+std::map<std::pair<std::vector<StageTableSig>, bool>, FormatAllocResult> format_alloc_cache;
+uint64_t format_alloc_cache_hits = 0, format_alloc_cache_misses = 0;
+
+}  // namespace
+
+void TablePlacement::clear_alloc_caches() {
+    if (ixbar_alloc_cache_hits + ixbar_alloc_cache_misses > 0)
+        LOG2("IXBar allocation cache: " << ixbar_alloc_cache_hits << " hits, "
+                                        << ixbar_alloc_cache_misses << " misses");
+    if (mem_alloc_cache_hits + mem_alloc_cache_misses > 0)
+        LOG2("Memory packing cache: " << mem_alloc_cache_hits << " hits, "
+                                      << mem_alloc_cache_misses << " misses");
+    if (format_alloc_cache_hits + format_alloc_cache_misses > 0)
+        LOG2("Match format cache: " << format_alloc_cache_hits << " hits, "
+                                    << format_alloc_cache_misses << " misses");
+    ixbar_alloc_cache.clear();
+    ixbar_alloc_cache_hits = ixbar_alloc_cache_misses = 0;
+    mem_alloc_cache.clear();
+    mem_alloc_cache_hits = mem_alloc_cache_misses = 0;
+    format_alloc_cache.clear();
+    format_alloc_cache_hits = format_alloc_cache_misses = 0;
+}
+
 bool TablePlacement::try_alloc_ixbar(Placed *next, std::vector<Placed *> allocated_layout) {
     Log::TempIndent indent;
     LOG5("Trying to allocate ixbar for " << next->name << indent);
     next->resources.clear_ixbar();
+
+    std::vector<StageTableSig> key;
+    for (auto *p : boost::adaptors::reverse(allocated_layout)) {
+        if (!Device::threadsSharePipe(p->table->gress, next->table->gress)) continue;
+        key.push_back(stage_table_sig(p));
+    }
+    key.push_back(stage_table_sig(next));
+    if (auto cached = ixbar_alloc_cache.find(key); cached != ixbar_alloc_cache.end()) {
+        ++ixbar_alloc_cache_hits;
+        auto &result = cached->second;
+        if (result.success) {
+            next->resources.match_ixbar = result.alloc.match_ixbar;
+            next->resources.gateway_ixbar = result.alloc.gateway_ixbar;
+            next->resources.proxy_hash_ixbar = result.alloc.proxy_hash_ixbar;
+            next->resources.selector_ixbar = result.alloc.selector_ixbar;
+            next->resources.salu_ixbar = result.alloc.salu_ixbar;
+            next->resources.meter_ixbar = result.alloc.meter_ixbar;
+            next->resources.hash_dists = result.alloc.hash_dists;
+            LOG5("Allocating ixbar successful (cached)");
+            return true;
+        }
+        error_message = result.error_message;
+        LOG3("    " << error_message << " (cached)");
+        return false;
+    }
+    ++ixbar_alloc_cache_misses;
+
     std::unique_ptr<IXBar> current_ixbar(IXBar::create());
     int tables_already_in_stage = 0;
     for (auto *p : boost::adaptors::reverse(allocated_layout)) {
@@ -2042,9 +2205,21 @@ bool TablePlacement::try_alloc_ixbar(Placed *next, std::vector<Placed *> allocat
             error_message += " by itself";
         if (current_ixbar->failure_reason) error_message += ": " + current_ixbar->failure_reason;
         LOG3("    " << error_message);
+        ixbar_alloc_cache.emplace(std::move(key),
+                                  IXBarAllocResult{false, TableResourceAlloc(), error_message});
         return false;
     }
 
+    IXBarAllocResult result{true, TableResourceAlloc(), cstring()};
+    result.alloc.match_ixbar = next->resources.match_ixbar;
+    result.alloc.gateway_ixbar = next->resources.gateway_ixbar;
+    result.alloc.proxy_hash_ixbar = next->resources.proxy_hash_ixbar;
+    result.alloc.selector_ixbar = next->resources.selector_ixbar;
+    result.alloc.salu_ixbar = next->resources.salu_ixbar;
+    result.alloc.meter_ixbar = next->resources.meter_ixbar;
+    result.alloc.hash_dists = next->resources.hash_dists;
+    ixbar_alloc_cache.emplace(std::move(key), std::move(result));
+
     LOG5("Allocating ixbar successful");
     return true;
 }
@@ -2071,9 +2246,36 @@ bool TablePlacement::try_alloc_mem(Placed *next, std::vector<Placed *> whole_sta
 
     if (shrink_lt) current_mem->shrink_allowed_lts();
 
-    const IR::MAU::Table *table_to_add = nullptr;
+    std::vector<Placed *> to_add;
+    MemAllocKey key;
+    key.shrink_lt = shrink_lt;
     for (auto *p : whole_stage) {
         if (!Device::threadsSharePipe(p->table->gress, next->table->gress)) continue;
+        to_add.push_back(p);
+        key.tables.push_back(stage_table_sig(p));
+    }
+    key.tables.push_back(stage_table_sig(next));
+    if (auto cached = mem_alloc_cache.find(key); cached != mem_alloc_cache.end()) {
+        ++mem_alloc_cache_hits;
+        auto &result = cached->second;
+        if (result.success) {
+            for (size_t i = 0; i < to_add.size(); ++i)
+                to_add[i]->resources.memuse = result.memuse[i];
+            next->resources.memuse = result.memuse.back();
+            LOG5("\t Allocating mem successful (cached)");
+            return true;
+        }
+        error_message = result.error_message;
+        next->stage_advance_log = result.stage_advance_log;
+        LOG3("    " << error_message << " (cached)");
+        next->resources.memuse.clear();
+        for (auto *p : whole_stage) p->resources.memuse.clear();
+        return false;
+    }
+    ++mem_alloc_cache_misses;
+
+    const IR::MAU::Table *table_to_add = nullptr;
+    for (auto *p : to_add) {
         table_to_add = p->table;
         if (!p->use.format_type.matchThisStage())
             table_to_add = table_to_add->apply(RewriteForSplitAttached(*this, p));
@@ -2115,6 +2317,8 @@ bool TablePlacement::try_alloc_mem(Placed *next, std::vector<Placed *> whole_sta
         next->stage_advance_log = "ran out of memories: " + current_mem->last_failure();
         LOG3("Memuse for failed memory placement: ");
         LOG3(*current_mem);
+        mem_alloc_cache.emplace(std::move(key),
+                                MemAllocResult{false, {}, error_message, next->stage_advance_log});
         next->resources.memuse.clear();
         for (auto *p : whole_stage) p->resources.memuse.clear();
         return false;
@@ -2124,18 +2328,44 @@ bool TablePlacement::try_alloc_mem(Placed *next, std::vector<Placed *> whole_sta
     if (shrink_lt) verify_mem->shrink_allowed_lts();
     for (auto *p : whole_stage) verify_mem->update(p->resources.memuse);
     verify_mem->update(next->resources.memuse);
+
+    MemAllocResult result{true, {}, cstring(), cstring()};
+    for (auto *p : to_add) result.memuse.push_back(p->resources.memuse);
+    result.memuse.push_back(next->resources.memuse);
+    mem_alloc_cache.emplace(std::move(key), std::move(result));
+
     LOG7(IndentCtl::indent << IndentCtl::indent);
     LOG7(*current_mem << IndentCtl::unindent << IndentCtl::unindent);
     LOG5("\t Allocating mem successful");
     return true;
 }
 
-bool TablePlacement::try_alloc_format(Placed *next, bool gw_linked) {
+bool TablePlacement::try_alloc_format(Placed *next, std::vector<Placed *> allocated_layout,
+                                      bool gw_linked) {
     LOG6("try_alloc_format(" << next->name << "): [" << next->use.preferred_index << "] "
                              << Log::indent << *next->use.preferred() << Log::unindent);
     const bitvec immediate_mask = next->use.preferred_action_format()->immediate_mask;
     next->resources.table_format.clear();
     gw_linked |= next->use.preferred()->layout.gateway_match;
+
+    std::pair<std::vector<StageTableSig>, bool> key({}, gw_linked);
+    for (auto *p : boost::adaptors::reverse(allocated_layout)) {
+        if (!Device::threadsSharePipe(p->table->gress, next->table->gress)) continue;
+        key.first.push_back(stage_table_sig(p));
+    }
+    key.first.push_back(stage_table_sig(next));
+    if (auto cached = format_alloc_cache.find(key); cached != format_alloc_cache.end()) {
+        ++format_alloc_cache_hits;
+        auto &result = cached->second;
+        if (result.success) {
+            next->resources.table_format = result.format;
+            return true;
+        }
+        error_message = result.error_message;
+        LOG3("    " << error_message << " (cached)");
+        return false;
+    }
+    ++format_alloc_cache_misses;
     // If the placed table has been split some of the attached tables might
     // have been moved to its part (meter/counters/...)
     // Remove them, so that pack fields for them dont clutter the table
@@ -2156,8 +2386,11 @@ bool TablePlacement::try_alloc_format(Placed *next, bool gw_linked) {
                         " could "
                         "not fit given the input xbar allocation";
         LOG3("    " << error_message);
+        format_alloc_cache.emplace(std::move(key), FormatAllocResult{false, {}, error_message});
         return false;
     }
+    format_alloc_cache.emplace(std::move(key),
+                               FormatAllocResult{true, next->resources.table_format, cstring()});
     return true;
 }
 
@@ -4312,6 +4545,12 @@ class DecidePlacement::BacktrackManagement {
         return false;
     }
 
+    // Branch-and-bound over the complete-solution strategies: the number of
+    // stages of the best complete error-free solution found so far, and a way
+    // to give up on branches that can no longer beat it.
+    int incumbent_bound() const { return final_placement.incumbent_bound(); }
+    bool abandon_current_branch() { return final_placement.abandon_current_branch(); }
+
     // Add a complete solution for one of the strategy
     void add_complete_solution() {
         BacktrackPlacement *bt = new BacktrackPlacement(self, active_placed, active_work, true);
@@ -4322,6 +4561,234 @@ class DecidePlacement::BacktrackManagement {
     void select_best_final_solution() { final_placement.select_best_final_placement(); }
 };
 
+struct DecidePlacement::ReplayDecision {
+    cstring tableName;        // the match table, or a gateway-only table
+    cstring gatewayName;      // the gateway merged with the table, if any
+    cstring gatewayMergeCond;  // the next-table tag chosen for the merge
+    int stage = -1;           // the stage the decision placed the table in
+    uint64_t fingerprint = 0;  // decision_fingerprint at record time; 0 if not recorded
+    const TableSummary::PlacedTable *hint = nullptr;  // layout hint when replaying in-process
+};
+
+/* Replay a sequence of recorded placement decisions until the first
+ * divergence, so that a re-run only re-solves the stages a change actually
+ * affected.  The decisions come either from the previous fitting round of the
+ * same compile (TableSummary) or from the decision journal of a previous
+ * compile, in placement order, and each one is re-checked with
+ * try_place_table, so the reused prefix is validated against the current IR
+ * and resources rather than trusted blindly.  On the first table that no
+ * longer exists, no longer fits, lands in a different stage, or whose recorded
+ * context fingerprint no longer matches, the prefix is rewound to the last
+ * stage boundary before the divergence and the normal search takes over from
+ * there.
+ */
+const DecidePlacement::Placed *DecidePlacement::replay_decisions(
+    const std::vector<ReplayDecision> &decisions, const char *what,
+    ordered_set<const IR::MAU::Table *> &partly_placed) {
+    const Placed *placed = nullptr;
+    std::unordered_map<cstring, bool> need_more_tables;
+    int first_affected_stage = -1;
+    for (auto &decision : decisions) {
+        const int prev_stage = decision.stage;
+        StageUseEstimate current = get_current_stage_use(placed);
+        if (is_starter_pistol_table(decision.tableName)) {
+            placed = self.add_starter_pistols(placed, nullptr, current);
+            continue;
+        }
+        const auto *tbl = self.getTblByName(decision.tableName);
+        const IR::MAU::Table *try_tbl = tbl;
+        TablePlacement::GatewayMergeChoices gmc;
+        if (tbl && decision.gatewayName) {
+            if (const auto *cond = self.getTblByName(decision.gatewayName)) {
+                gmc[tbl] = decision.gatewayMergeCond;
+                try_tbl = cond;
+            } else {
+                try_tbl = nullptr;
+            }
+        }
+        if (!try_tbl) {
+            // The table was split, merged or renamed since the decision was
+            // recorded, so everything from its old stage onwards must be
+            // re-solved.
+            LOG2(what << ": " << decision.tableName << " no longer exists, diverging at stage "
+                      << prev_stage);
+            first_affected_stage = prev_stage;
+            break;
+        }
+        if (decision.fingerprint != 0 &&
+            decision.fingerprint != decision_fingerprint(tbl, decision.gatewayName,
+                                                         decision.gatewayMergeCond, prev_stage)) {
+            // The table still exists but its dependency context changed, so
+            // the choice points from here on would have seen different
+            // candidates.
+            LOG2(what << ": context of " << decision.tableName << " changed, diverging at stage "
+                      << prev_stage);
+            first_affected_stage = prev_stage;
+            break;
+        }
+        if (need_more_tables.count(try_tbl->name) && !need_more_tables[try_tbl->name]) {
+            // The recorded placement put another chunk of this table here, but
+            // the replay has already placed all of its entries: the stage
+            // shapes have changed, so stop reusing decisions.
+            LOG2(what << ": " << try_tbl->name << " already fully placed, diverging at stage "
+                      << prev_stage);
+            first_affected_stage = prev_stage;
+            break;
+        }
+        auto pl_vec = self.try_place_table(try_tbl, placed, current, gmc, decision.hint);
+        if (pl_vec.empty() || pl_vec[0]->stage != prev_stage) {
+            first_affected_stage =
+                pl_vec.empty() ? prev_stage : std::min(prev_stage, pl_vec[0]->stage);
+            LOG2(what << ": " << try_tbl->name << " diverged (was stage " << prev_stage
+                      << "), re-solving from stage " << first_affected_stage);
+            break;
+        }
+        placed = pl_vec[0];
+        need_more_tables[try_tbl->name] = placed->need_more;
+        LOG3(what << ": replayed " << placed->entries << " entries of " << placed->name
+                  << " in stage " << placed->stage);
+    }
+
+    if (first_affected_stage >= 0) {
+        // Drop every decision in or after the diverging stage; the earlier
+        // stages saw identical resource use, so their decisions still hold.
+        while (placed && placed->stage >= first_affected_stage) placed = placed->prev;
+    }
+    if (placed) {
+        recomputePartlyPlaced(placed, partly_placed);
+        LOG1(what << ": reused placement through stage " << placed->stage);
+    }
+    return placed;
+}
+
+/* Replay the per-stage decisions of the previous fitting round.  Rounds 2+ of
+ * placement repeat mostly identical work: PHV allocation and small table
+ * rewrites usually perturb only a few stages, yet the search restarts from
+ * stage 0 every time.
+ */
+const DecidePlacement::Placed *DecidePlacement::incremental_replay_prefix(
+    const IR::BFN::Pipe *pipe, ordered_set<const IR::MAU::Table *> &partly_placed) {
+    auto &prev_round = self.summary.getPlacedTables();
+    if (prev_round.empty()) return nullptr;
+    LOG1("Incremental placement: replaying previous round on " << pipe->canon_name());
+
+    std::vector<ReplayDecision> decisions;
+    for (auto &pt : prev_round) {
+        ReplayDecision decision;
+        decision.tableName = pt.second->internalTableName;
+        decision.gatewayName = pt.second->gatewayName;
+        decision.gatewayMergeCond = pt.second->gatewayMergeCond;
+        decision.stage = pt.second->stage;
+        decision.hint = pt.second;
+        decisions.push_back(decision);
+    }
+    return replay_decisions(decisions, "Incremental placement", partly_placed);
+}
+
+uint64_t DecidePlacement::decision_fingerprint(const IR::MAU::Table *tbl, cstring gateway,
+                                               cstring cond, int stage) const {
+    // 64-bit FNV-1a; the journal is read by later compiler runs, so the hash
+    // must be stable across processes.
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto add_bytes = [&h](const void *data, size_t len) {
+        auto *p = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < len; ++i) {
+            h ^= p[i];
+            h *= 0x100000001b3ULL;
+        }
+    };
+    auto add_str = [&](cstring s) {
+        if (s) add_bytes(s.c_str(), s.size());
+        add_bytes("", 1);  // delimiter, so adjacent strings can't alias
+    };
+    add_str(tbl->name);
+    add_str(gateway);
+    add_str(cond);
+    add_bytes(&stage, sizeof(stage));
+    if (self.deps.stage_info.count(tbl)) {
+        auto &info = self.deps.stage_info.at(tbl);
+        add_bytes(&info.min_stage, sizeof(info.min_stage));
+        add_bytes(&info.dep_stages_control_anti, sizeof(info.dep_stages_control_anti));
+    }
+    return h;
+}
+
+std::filesystem::path DecidePlacement::journal_path(const IR::BFN::Pipe *pipe) const {
+    // One journal per pipe, since each pipe is placed independently.
+    std::filesystem::path path(self.options.table_placement_journal.c_str());
+    path += ".";
+    path += pipe->canon_name().c_str();
+    return path;
+}
+
+/// The first line of every journal file; bump the trailing number when the
+/// format or the fingerprint recipe changes, so stale journals are ignored.
+static constexpr const char *journal_format_tag = "p4c-placement-journal-1";
+
+void DecidePlacement::save_journal(const IR::BFN::Pipe *pipe, const Placed *placement) {
+    std::vector<const Placed *> order;
+    for (auto *p = placement; p; p = p->prev) order.push_back(p);
+    std::reverse(order.begin(), order.end());
+
+    auto path = journal_path(pipe);
+    std::ofstream out(path);
+    if (!out) {
+        LOG1("Placement journal: cannot write " << path);
+        return;
+    }
+    out << journal_format_tag << "\n";
+    for (auto *p : order) {
+        uint64_t fingerprint = 0;
+        if (!is_starter_pistol_table(p->name))
+            fingerprint = decision_fingerprint(p->table, p->gw ? p->gw->name : cstring(),
+                                               p->gw_result_tag, p->stage);
+        out << p->stage << '\t' << hex(fingerprint) << '\t' << p->name;
+        if (p->gw) out << '\t' << p->gw->name << '\t' << p->gw_result_tag;
+        out << '\n';
+    }
+    LOG1("Placement journal: saved " << order.size() << " decisions to " << path);
+}
+
+const DecidePlacement::Placed *DecidePlacement::journal_replay_prefix(
+    const IR::BFN::Pipe *pipe, ordered_set<const IR::MAU::Table *> &partly_placed) {
+    auto path = journal_path(pipe);
+    std::ifstream in(path);
+    if (!in) return nullptr;
+    std::string line;
+    if (!std::getline(in, line) || line != journal_format_tag) {
+        LOG1("Placement journal: ignoring " << path << " (unrecognized format)");
+        return nullptr;
+    }
+    std::vector<ReplayDecision> decisions;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields;
+        for (size_t pos = 0; pos <= line.size();) {
+            size_t tab = line.find('\t', pos);
+            if (tab == std::string::npos) tab = line.size();
+            fields.push_back(line.substr(pos, tab - pos));
+            pos = tab + 1;
+        }
+        if (fields.size() != 3 && fields.size() != 5) {
+            LOG1("Placement journal: ignoring " << path << " (corrupt entry)");
+            return nullptr;
+        }
+        ReplayDecision decision;
+        decision.stage = atoi(fields[0].c_str());
+        decision.fingerprint = strtoull(fields[1].c_str(), nullptr, 16);
+        decision.tableName = cstring(fields[2]);
+        if (fields.size() == 5) {
+            decision.gatewayName = cstring(fields[3]);
+            decision.gatewayMergeCond = cstring(fields[4]);
+        }
+        decisions.push_back(decision);
+    }
+    if (decisions.empty()) return nullptr;
+    LOG1("Placement journal: replaying " << decisions.size() << " recorded decisions on "
+                                         << pipe->canon_name());
+    return replay_decisions(decisions, "Placement journal", partly_placed);
+}
+
 const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR::BFN::Pipe *pipe) {
     LOG1("Table placement starting on " << pipe->canon_name()
                                         << " with DEFAULT PLACEMENT approach");
@@ -4340,6 +4807,10 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
     initForPipe(pipe, work);
 
     ordered_set<const IR::MAU::Table *> partly_placed;
+    if (self.options.table_placement_incremental_replay)
+        placed = incremental_replay_prefix(pipe, partly_placed);
+    if (!placed && self.options.table_placement_journal)
+        placed = journal_replay_prefix(pipe, partly_placed);
     Backfill backfill(*this);
     BacktrackManagement bt_mgmt(*this, work, partly_placed, placed, backfill);
 #ifdef MULTITHREAD
@@ -4637,6 +5108,21 @@ const DecidePlacement::Placed *DecidePlacement::default_table_placement(const IR
         self.add_starter_pistols(placed, &best, current);
         placed = place_table(work, best);
 
+        // Branch-and-bound: once a complete error-free solution with N stages
+        // exists, a branch that already reaches stage N-1 can at best tie it,
+        // and ties lose the final comparison. Stop placing the rest of its
+        // tables and move to the next queued branch instead. When nothing is
+        // queued, let the branch finish normally so the loop exits through the
+        // usual complete-solution path.
+        if (placed->stage + 1 >= bt_mgmt.incumbent_bound()) {
+            const int bounded_stage = placed->stage;
+            if (bt_mgmt.abandon_current_branch()) {
+                LOG3("Pruned branch at stage " << bounded_stage << ": the incumbent fits in "
+                                               << bt_mgmt.incumbent_bound() << " stages");
+                continue;
+            }
+        }
+
         if (!self.options.disable_table_placement_backfill) {
             for (auto p : trial) {
                 /* Look for tables that are were placeable in this stage and are now not placeable
@@ -4680,6 +5166,7 @@ bool DecidePlacement::preorder(const IR::BFN::Pipe *pipe) {
         LOG_FEATURE("stage_advance", 2,
                     "Stage " << placed->stage << IndentCtl::indent << Log::endl
                              << StageSummary(placed->stage, placed) << IndentCtl::unindent);
+        if (self.options.table_placement_journal) save_journal(pipe, placed);
     }
 
     self.summary.setAllStagesResources(get_total_stage_use(placed));
@@ -26,6 +26,8 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_MAU_TABLE_PLACEMENT_H_
 #define BACKENDS_TOFINO_BF_P4C_MAU_TABLE_PLACEMENT_H_
 
+#include <cstdint>
+#include <filesystem>
 #include <map>
 
 #include "backends/tofino/bf-p4c/backend.h"
@@ -175,8 +177,10 @@ class TablePlacement : public PassManager {
                         std::vector<Placed *> tables_placed);
 
     bool try_alloc_ixbar(Placed *next, std::vector<Placed *> allocated_layout);
-    bool try_alloc_format(Placed *next, bool gw_linked);
+    bool try_alloc_format(Placed *next, std::vector<Placed *> allocated_layout, bool gw_linked);
     bool try_alloc_mem(Placed *next, std::vector<Placed *> whole_stage);
+    /// Drop the memoized per-stage ixbar and memory allocation verdicts (table_placement.cpp).
+    void clear_alloc_caches();
     void setup_detached_gateway(IR::MAU::Table *tbl, const Placed *placed);
     void filter_layout_options(Placed *pl);
     bool disable_split_layout(const IR::MAU::Table *tbl);
@@ -244,6 +248,36 @@ class DecidePlacement : public MauInspector {
     std::map<cstring, std::set<int>> bt_attempts;
     void savePlacement(const Placed *, const ordered_set<const GroupPlace *> &, bool);
     void recomputePartlyPlaced(const Placed *, ordered_set<const IR::MAU::Table *> &);
+    /// One recorded choice point of a previous placement, in placement order;
+    /// replayed either in-process (from TableSummary) or across compiles (from
+    /// the on-disk decision journal).
+    struct ReplayDecision;
+    /// Replays @p decisions until one diverges from what the current IR allows,
+    /// validating each with try_place_table, and rewinds to the last stage
+    /// boundary before the divergence. @returns the reusable placement prefix,
+    /// or nullptr; @p what labels the log messages.
+    const Placed *replay_decisions(const std::vector<ReplayDecision> &decisions, const char *what,
+                                   ordered_set<const IR::MAU::Table *> &partly_placed);
+    /// Replays the previous fitting round's decisions until they diverge from
+    /// what the current IR allows, so the search only restarts from the first
+    /// affected stage. @returns the reusable placement prefix, or nullptr.
+    const Placed *incremental_replay_prefix(const IR::BFN::Pipe *,
+                                            ordered_set<const IR::MAU::Table *> &partly_placed);
+    /// Replays the decision journal persisted by a previous compile (see
+    /// --table-placement-journal), so a re-fit after a small edit re-solves
+    /// only the stages the edit affected. @returns the reusable prefix, or
+    /// nullptr if there is no usable journal for this pipe.
+    const Placed *journal_replay_prefix(const IR::BFN::Pipe *,
+                                        ordered_set<const IR::MAU::Table *> &partly_placed);
+    /// Fingerprint of the context a decision for @p tbl depended on beyond what
+    /// try_place_table re-validates (its dependency-graph position and merged
+    /// gateway); stable across processes.
+    uint64_t decision_fingerprint(const IR::MAU::Table *tbl, cstring gateway, cstring cond,
+                                  int stage) const;
+    std::filesystem::path journal_path(const IR::BFN::Pipe *) const;
+    /// Persists the decisions of @p placement as the journal of this pipe,
+    /// replacing any previous journal.
+    void save_journal(const IR::BFN::Pipe *, const Placed *placement);
     std::optional<BacktrackPlacement *> find_previous_placement(const Placed *best, int offset,
                                                                 bool local_bt, int process_stage);
     std::optional<BacktrackPlacement *> find_backtrack_point(const Placed *, int, bool);
@@ -20,14 +20,66 @@
 
 #include "backends/tofino/bf-p4c/mau/action_analysis.h"
 #include "ir/ir.h"
+#include "lib/hash.h"
 #include "lib/log.h"
 
+namespace {
+
+/// Hashes the container assignments that action analysis reads for the PHV operands of an
+/// action: for every field referenced, each alloc slice's container, slice placement and
+/// liveness participate. An allocation change touching any of these fields changes the
+/// fingerprint; changes to unrelated fields do not.
+struct AllocFingerprint : public Inspector {
+    const PhvInfo &phv;
+    uint64_t hash = 0;
+
+    explicit AllocFingerprint(const PhvInfo &phv) : phv(phv) {}
+
+    bool preorder(const IR::Expression *e) override {
+        le_bitrange bits;
+        const auto *field = phv.field(e, &bits);
+        if (!field) return true;
+
+        hash = Util::hash_combine(hash, (uint64_t(uint32_t(field->id)) << 32) | uint32_t(bits.lo));
+        field->foreach_alloc(bits, [&](const PHV::AllocSlice &sl) {
+            hash = Util::hash_combine(hash, hash_value(sl.container()));
+            hash = Util::hash_combine(hash, (uint64_t(uint32_t(sl.container_slice().lo)) << 32) |
+                                                uint32_t(sl.field_slice().lo));
+            hash = Util::hash_combine(hash, (uint64_t(uint32_t(sl.width())) << 32) |
+                                                uint32_t(sl.getEarliestLiveness().first));
+            hash = Util::hash_combine(hash, uint64_t(sl.getLatestLiveness().first));
+        });
+        return false;
+    }
+};
+
+}  // namespace
+
 bool ValidateActions::preorder(const IR::MAU::Action *act) {
     auto tbl = findContext<IR::MAU::Table>();
     CHECK_NULL(tbl);
     Log::TempIndent indent;
     LOG3("ValidateActions for table: " << tbl->externalName() << ", action: " << act->name
                                        << indent);
+
+    // Skip re-analysis when neither the action nor the container assignments its analysis
+    // depends on have changed since it was last found clean. Action-data allocation is not
+    // fingerprinted, so don't use the cache when it is in play.
+    uint64_t fingerprint = 0;
+    bool cacheable = !ad_alloc;
+    if (cacheable && phv_alloc) {
+        AllocFingerprint fp(phv);
+        act->apply(fp);
+        fingerprint = fp.hash;
+    }
+    if (cacheable) {
+        auto it = clean_actions.find(act);
+        if (it != clean_actions.end() && it->second == fingerprint) {
+            LOG3("Skipping action: unchanged since last clean analysis");
+            return false;
+        }
+    }
+
     ActionAnalysis::FieldActionsMap field_actions_map;
     ActionAnalysis::ContainerActionsMap container_actions_map;
     ActionAnalysis aa(phv, phv_alloc, ad_alloc, tbl, red_info, false,
@@ -43,6 +95,12 @@ bool ValidateActions::preorder(const IR::MAU::Action *act) {
     if (warning_found) LOG3("Warning found");
     error_found |= aa.error_found();
     if (error_found) LOG3("Error found");
+    if (cacheable) {
+        if (!aa.warning_found() && !aa.error_found())
+            clean_actions[act] = fingerprint;
+        else
+            clean_actions.erase(act);
+    }
     return false;
 }
 
@@ -38,6 +38,13 @@ class ValidateActions final : public MauInspector {
     // true if action analysis finds a PHV allocation that violates MAU constraints.
     bool error_found = false;
 
+    /// Actions whose last analysis produced no diagnostics, keyed on the action node together
+    /// with a fingerprint of the container assignments the analysis read. Entries survive
+    /// across applies -- the pass is re-run after allocation changes -- so only actions whose
+    /// instructions or relevant containers actually changed get re-analyzed. Actions with
+    /// warnings or errors are never cached, so their diagnostics are re-emitted.
+    assoc::map<const IR::MAU::Action *, uint64_t> clean_actions;
+
     profile_t init_apply(const IR::Node *root) override;
     bool preorder(const IR::MAU::Action *act) override;
     void end_apply() override;
@@ -193,6 +193,11 @@ class ActionSynthesisPolicy : public P4::ActionSynthesisPolicy {
         return !DependsOnPaths(*this, stmt, writes);
     }
 
+    // Generated pipelines repeat the same statement groups in many places and
+    // every duplicate synthesized action is another action the allocator must
+    // place, so let equivalent groups share one action.
+    bool can_share(const Visitor::Context *, const IR::P4Control *) override { return true; }
+
  public:
     ActionSynthesisPolicy(const std::set<cstring> *skip, P4::ReferenceMap *refMap,
                           P4::TypeMap *typeMap)
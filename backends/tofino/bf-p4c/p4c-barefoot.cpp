@@ -297,20 +297,27 @@ class GenerateOutputs : public PassManager {
         auto logsDir = BFNContext::get().getOutputDirectory("logs"_cs, pipeId);
         std::string phvLogFile(logsDir + "/phv.json");
         std::string resourcesLogFile(logsDir + "/resources.json");
+        // The output generators only read the backend's results and write disjoint
+        // files (the .bfa, phv.json and resources.json), so they run concurrently
+        // over the same immutable pipe; manifest registration is serialized inside
+        // Logging::Manifest.  The dynamic hash verification stays ahead of them.
         addPasses(
             {&_dynhash,  // Verifies that the hash is valid before the dump of
                          // information in assembly
-             new BFN::AsmOutput(_pipeId, b.get_phv(), b.get_clot(), b.get_defuse(),
-                                b.get_flexible_logging(), b.get_nxt_tbl(), b.get_power_and_mpr(),
-                                b.get_tbl_summary(), b.get_live_range_report(),
-                                b.get_parser_hdr_seqs(), o, success),
-             o.debugInfo ? new PhvLogging(phvLogFile.c_str(), b.get_phv(), b.get_clot(),
-                                          *b.get_phv_logging(), *b.get_phv_logging_defuse_info(),
-                                          b.get_table_alloc(), b.get_tbl_summary())
-                         : nullptr,
-             o.debugInfo
-                 ? new BFN::ResourcesLogging(b.get_clot(), resourcesLogFile, o.outputDir.c_str())
-                 : nullptr});
+             new ParallelInspect(
+                 {new BFN::AsmOutput(_pipeId, b.get_phv(), b.get_clot(), b.get_defuse(),
+                                     b.get_flexible_logging(), b.get_nxt_tbl(),
+                                     b.get_power_and_mpr(), b.get_tbl_summary(),
+                                     b.get_live_range_report(), b.get_parser_hdr_seqs(), o,
+                                     success),
+                  o.debugInfo
+                      ? new PhvLogging(phvLogFile.c_str(), b.get_phv(), b.get_clot(),
+                                       *b.get_phv_logging(), *b.get_phv_logging_defuse_info(),
+                                       b.get_table_alloc(), b.get_tbl_summary())
+                      : nullptr,
+                  o.debugInfo ? new BFN::ResourcesLogging(b.get_clot(), resourcesLogFile,
+                                                          o.outputDir.c_str())
+                              : nullptr})});
 
         setName("Assembly output");
     }
@@ -569,6 +576,14 @@ int main(int ac, char **av) {
         };
         manifest_generator_guard emit_manifest(manifest);
 
+        // Pipes are compiled one after another even though they are independent after
+        // the arch substitution split them.  Running execute_backend on separate threads
+        // is not currently practical: all IR allocation goes through the garbage
+        // collector, which serializes concurrent allocation (see the measurements in the
+        // MULTITHREAD notes in mau/table_placement.cpp), and the error reporter, event
+        // logger, manifest and Device are process-wide singletons.  Identical pipes are
+        // already compiled once and replicated through Pipe::ids, so the duplicated work
+        // is limited to genuinely distinct pipes.
         for (auto &pipe : substitute.pipe) {
 #if BAREFOOT_INTERNAL
             if (std::all_of(pipe->names.begin(), pipe->names.end(),
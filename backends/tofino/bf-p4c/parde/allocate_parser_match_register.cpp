@@ -19,6 +19,7 @@
 #include "backends/tofino/bf-p4c/parde/allocate_parser_match_register.h"
 
 #include <string>
+#include <tuple>
 
 #include <boost/range/adaptors.hpp>
 
@@ -707,6 +708,7 @@ class MatcherAllocator : public Visitor {
         result.transition_scratches.clear();
         result.save_reg_slices.clear();
         delay_defs.clear();
+        interference_cache.clear();
 
         return Visitor::init_apply(root);
     }
@@ -870,14 +872,28 @@ class MatcherAllocator : public Visitor {
         return false;
     }
 
+    /// Memoized interference results, keyed on the group pair and the candidate def sets they
+    /// were queried with; the def set acts as the live-set fingerprint, since a group is probed
+    /// with different candidate def sets from its def_transition_sets. The use-def structure is
+    /// immutable within one allocation round, so entries stay valid as more groups get allocated
+    /// and the same pairs get re-queried by get_available_regs, both in the top-down and the
+    /// bottom-up attempt. Cleared in init_apply, since the groups are rebuilt from a new IR each
+    /// round.
+    std::map<std::tuple<const UseGroup *, DefSet, const UseGroup *, DefSet>, bool>
+        interference_cache;
+
     /// returns true if a and b's live range intersection is not null
     bool interfere(const IR::BFN::ParserGraph &graph, const UseGroup *a, const DefSet &a_defs,
                    const UseGroup *b, const DefSet &b_defs) {
-        if (overlap(graph, a, a_defs, b, b_defs)) return true;
+        // Interference is symmetric; normalize the key so that both query orders share an entry.
+        auto key = a < b ? std::make_tuple(a, a_defs, b, b_defs)
+                         : std::make_tuple(b, b_defs, a, a_defs);
+        auto it = interference_cache.find(key);
+        if (it != interference_cache.end()) return it->second;
 
-        if (overlap(graph, b, b_defs, a, a_defs)) return true;
+        bool rv = overlap(graph, a, a_defs, b, b_defs) || overlap(graph, b, b_defs, a, a_defs);
 
-        return false;
+        return interference_cache[key] = rv;
     }
 
     /// Checks if Defset "a" and DefSet "b" have a common transition.
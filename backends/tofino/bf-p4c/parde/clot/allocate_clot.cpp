@@ -18,7 +18,10 @@
 
 #include "backends/tofino/bf-p4c/parde/clot/allocate_clot.h"
 
+#include <atomic>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 #include "backends/tofino/bf-p4c/common/utils.h"
 #include "backends/tofino/bf-p4c/lib/log_fixup.h"
@@ -31,6 +34,7 @@
 #include "backends/tofino/bf-p4c/parde/count_strided_header_refs.h"
 #include "backends/tofino/bf-p4c/parde/parser_info.h"
 #include "backends/tofino/bf-p4c/phv/pragma/pa_alias.h"
+#include "lib/gc.h"
 
 /**
  * \ingroup parde
@@ -363,7 +367,7 @@ class GreedyClotAllocator : public Visitor {
                   c1->thread(), c2->id, c2->thread());
 
         auto gress = c1->thread();
-        const auto &deparse_graph = clotInfo.deparse_graph_[gress];
+        const auto &deparse_graph = clotInfo.deparse_graph_.at(gress);
 
         auto gaps = c1->byte_gaps(parserInfo, c2);
         if (gaps.empty()) {
@@ -525,44 +529,112 @@ class GreedyClotAllocator : public Visitor {
         return false;
     }
 
-    /// Adjusts a CLOT candidate to account for the allocation of another (possibly the same)
-    /// candidate.
-    ClotCandidateSet *adjust_for_allocation(
+    /// Gap requirements of a candidate against an allocated candidate, as evaluated by
+    /// analyze_gap_requirements.
+    struct GapInfo {
+        bool mutually_exclusive = false;
+        bool needs_pre_gap = false;
+        bool needs_post_gap = false;
+    };
+
+    /// Determines whether @p to_adjust is mutually exclusive with @p allocated and, if not,
+    /// whether an inter-CLOT gap is needed before and after @p allocated. This is the expensive,
+    /// read-only part of adjust_for_allocation, split out so that it can run on worker threads.
+    GapInfo analyze_gap_requirements(
         const ClotCandidate *to_adjust, const ClotCandidate *allocated,
         const HeaderValidityAnalysis::ResultMap header_removals) const {
-        const auto GAP_BYTES = Device::pardeSpec().byteInterClotGap();
-        const auto GAP_BITS = 8 * GAP_BYTES;
-
-        LOG5("");
-        LOG5("  Adjusting candidate " << to_adjust->id << " for allocated CLOT");
-
-        ClotCandidateSet *result = new ClotCandidateSet();
+        GapInfo result;
 
         // If the states from one candidate are mutually exclusive with the states from another,
         // then no need to adjust.
         const auto to_adjust_states = to_adjust->states();
         const auto allocated_states = allocated->states();
         const auto &graph = parserInfo.graph(parserInfo.parser(*allocated_states.begin()));
-        bool mutually_exclusive = true;
+        result.mutually_exclusive = true;
         for (auto &to_adjust_state : to_adjust_states) {
             for (auto &allocated_state : allocated_states) {
-                mutually_exclusive = graph.is_mutex(to_adjust_state, allocated_state);
-                if (!mutually_exclusive) break;
+                result.mutually_exclusive = graph.is_mutex(to_adjust_state, allocated_state);
+                if (!result.mutually_exclusive) break;
             }
-            if (!mutually_exclusive) break;
+            if (!result.mutually_exclusive) break;
+        }
+
+        if (result.mutually_exclusive) return result;
+
+        // Determine the inter-CLOT gap sizes needed before and after the allocated candidate.
+        result.needs_pre_gap = needInterClotGap(to_adjust, allocated, header_removals);
+        result.needs_post_gap = needInterClotGap(allocated, to_adjust, header_removals);
+        return result;
+    }
+
+    /// Evaluates the gap requirements of each candidate in @p to_evaluate against @p allocated,
+    /// in parallel when there are enough candidates to be worth it. The analysis only reads
+    /// shared state: the parser graphs, the deparser graphs, and the CLOT info, whose memoization
+    /// caches are guarded by their own locks. Candidate adjustment itself stays serial, since it
+    /// creates new ClotCandidate objects whose ids must be assigned deterministically.
+    std::vector<GapInfo> analyze_gap_requirements_all(
+        const std::vector<const ClotCandidate *> &to_evaluate, const ClotCandidate *allocated,
+        const HeaderValidityAnalysis::ResultMap header_removals) const {
+        std::vector<GapInfo> results(to_evaluate.size());
+
+        size_t nthreads = std::min<size_t>(to_evaluate.size(),
+                                           std::max(1u, std::thread::hardware_concurrency()));
+        if (nthreads > 1) {
+            static std::once_flag allow_threads;
+            std::call_once(allow_threads, gc_allow_threads);
+
+            std::atomic<size_t> next(0);
+            std::mutex failure_mutex;
+            std::exception_ptr failure;
+            // Note: LOG5 output produced by workers may interleave.
+            auto worker = [&]() {
+                gc_thread_scope gc_scope;
+                for (size_t i = next++; i < to_evaluate.size(); i = next++) {
+                    try {
+                        results[i] =
+                            analyze_gap_requirements(to_evaluate[i], allocated, header_removals);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(failure_mutex);
+                        if (!failure) failure = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < nthreads; ++t) threads.emplace_back(worker);
+            for (auto &t : threads) t.join();
+            if (failure) std::rethrow_exception(failure);
+        } else {
+            for (size_t i = 0; i < to_evaluate.size(); ++i)
+                results[i] = analyze_gap_requirements(to_evaluate[i], allocated, header_removals);
         }
 
-        if (mutually_exclusive) {
+        return results;
+    }
+
+    /// Adjusts a CLOT candidate to account for the allocation of another (possibly the same)
+    /// candidate, given the gap requirements computed by analyze_gap_requirements.
+    ClotCandidateSet *adjust_for_allocation(const ClotCandidate *to_adjust,
+                                            const ClotCandidate *allocated,
+                                            const GapInfo &gap_info) const {
+        const auto GAP_BYTES = Device::pardeSpec().byteInterClotGap();
+        const auto GAP_BITS = 8 * GAP_BYTES;
+
+        LOG5("");
+        LOG5("  Adjusting candidate " << to_adjust->id << " for allocated CLOT");
+
+        ClotCandidateSet *result = new ClotCandidateSet();
+
+        if (gap_info.mutually_exclusive) {
             LOG5("    No need to adjust: states are mutually exclusive");
             result->insert(to_adjust);
             return result;
         }
 
-        // Determine the inter-CLOT gap sizes needed before and after the allocated candidate.
-        bool allocatedNeedsPreGap = needInterClotGap(to_adjust, allocated, header_removals);
+        // The inter-CLOT gap sizes needed before and after the allocated candidate.
+        bool allocatedNeedsPreGap = gap_info.needs_pre_gap;
         int preGapBits = allocatedNeedsPreGap ? GAP_BITS : 0;
 
-        bool allocatedNeedsPostGap = needInterClotGap(allocated, to_adjust, header_removals);
+        bool allocatedNeedsPostGap = gap_info.needs_post_gap;
         int postGapBits = allocatedNeedsPostGap ? GAP_BITS : 0;
 
         // If the candidate occurs immediately after a CLOT that has already been allocated, and
@@ -1122,6 +1194,7 @@ class GreedyClotAllocator : public Visitor {
                 // Set of removed candidates; used for logging.
                 ClotCandidateSet removed_candidates;
 
+                std::vector<const ClotCandidate *> to_evaluate;
                 for (auto other_candidate : *candidates) {
                     if (intersects(*full_states, other_candidate->states())) {
                         // Candidate has a full state. Remove from candidacy.
@@ -1131,8 +1204,16 @@ class GreedyClotAllocator : public Visitor {
 
                     if (candidate == other_candidate) continue;
 
-                    auto adjusted =
-                        adjust_for_allocation(other_candidate, candidate, header_removals);
+                    to_evaluate.push_back(other_candidate);
+                }
+
+                // Each surviving candidate's gap analysis against the just-allocated candidate is
+                // independent, so evaluate them in parallel, then adjust serially in candidate
+                // order so that any replacement candidates get deterministic ids.
+                auto gap_infos = analyze_gap_requirements_all(to_evaluate, candidate,
+                                                              header_removals);
+                for (size_t i = 0; i < to_evaluate.size(); ++i) {
+                    auto adjusted = adjust_for_allocation(to_evaluate[i], candidate, gap_infos[i]);
                     new_candidates->insert(adjusted->begin(), adjusted->end());
                 }
 
@@ -57,6 +57,7 @@ bool DeparseGraph::canReach(const PHV::Field *f1, const PHV::Field *f2) const {
     auto n1 = fieldToVertex.at(f1);
     auto n2 = fieldToVertex.at(f2);
 
+    std::lock_guard<std::mutex> lock(reachability_mutex);
     return reachability.canReach(n1, n2);
 }
 
@@ -68,6 +69,7 @@ const std::vector<DeparseGraph::NodeInfo> DeparseGraph::nodesBetween(const PHV::
     auto n1 = fieldToVertex.at(f1);
     auto n2 = fieldToVertex.at(f2);
 
+    std::lock_guard<std::mutex> lock(reachability_mutex);
     std::vector<NodeInfo> result;
     for (auto node : reachability.reachableBetween(n1, n2)) {
         result.push_back(g[node]);
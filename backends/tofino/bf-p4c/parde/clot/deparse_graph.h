@@ -19,6 +19,8 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_PARDE_CLOT_DEPARSE_GRAPH_H_
 #define BACKENDS_TOFINO_BF_P4C_PARDE_CLOT_DEPARSE_GRAPH_H_
 
+#include <mutex>
+
 #include "backends/tofino/bf-p4c/lib/boost_graph.h"
 #include "backends/tofino/bf-p4c/phv/phv_fields.h"
 
@@ -96,6 +98,10 @@ class DeparseGraph {
 
     mutable Reachability<Graph> reachability;
 
+    /// Guards @a reachability, which recomputes itself lazily on the first query after a
+    /// mutation, so that canReach and nodesBetween can be called from worker threads.
+    mutable std::mutex reachability_mutex;
+
  public:
     DeparseGraph() : reachability(g) {}
 };
@@ -22,6 +22,7 @@
 
 #include "backends/tofino/bf-p4c/common/table_printer.h"
 #include "backends/tofino/bf-p4c/specs/device.h"
+#include "lib/hash.h"
 
 template <typename T>
 static std::vector<T> to_vector(const ordered_set<T> &data) {
@@ -513,6 +514,9 @@ void ComputeValuesAtDeparser::group_weak_fields() {
     for (auto &kv : weak_fields.field_to_weak_assigns) {
         auto f = kv.first;
 
+        // the transitive sources don't depend on the candidate group
+        auto srcs = get_all_weak_srcs(f);
+
         bool found_union = false;
 
         for (auto &group : weak_field_groups) {
@@ -523,8 +527,6 @@ void ComputeValuesAtDeparser::group_weak_fields() {
                 break;
             }
 
-            auto srcs = get_all_weak_srcs(f);
-
             for (auto src : srcs) {
                 if (src->field) {
                     if (group.count(src->field)) {
@@ -541,8 +543,6 @@ void ComputeValuesAtDeparser::group_weak_fields() {
 
             new_group.insert(f);
 
-            auto srcs = get_all_weak_srcs(f);
-
             for (auto src : srcs) {
                 if (src->field) new_group.insert(src->field);
             }
@@ -665,8 +665,45 @@ bool ComputeValuesAtDeparser::compute_all_reachable_values_at_deparser(
         return false;
     }
 
-    auto first_table = (table_to_assigns.begin())->first;
-    auto all_chains = enumerate_all_assign_chains(first_table, table_to_assigns);
+    // Canonicalize the group's assigns so that chain solutions computed by a
+    // previous application of this pass can be matched up positionally, and
+    // fingerprint them by their printed form (the Assign objects are rebuilt by
+    // every application, so pointers can't serve as the cache key).
+    std::vector<const Assign *> canon_assigns;
+    size_t fingerprint = table_to_assigns.size();
+    for (auto &ta : table_to_assigns) {
+        for (auto assign : ta.second) {
+            canon_assigns.push_back(assign);
+            fingerprint = Util::hash_combine(
+                fingerprint, std::hash<std::string>()(weak_fields.print_assign(assign)));
+        }
+    }
+
+    ordered_set<AssignChain> all_chains;
+
+    auto cached = solution_cache.find(fingerprint);
+    if (cached != solution_cache.end()) {
+        LOG2("\nreusing assign chains for unchanged group " << weak_field_group.id);
+
+        for (auto &chain_indices : cached->second) {
+            AssignChain chain;
+            for (auto idx : chain_indices) chain.push_back(canon_assigns.at(idx));
+            all_chains.insert(chain);
+        }
+    } else {
+        auto first_table = (table_to_assigns.begin())->first;
+        all_chains = enumerate_all_assign_chains(first_table, table_to_assigns);
+
+        assoc::map<const Assign *, unsigned> assign_to_index;
+        for (unsigned i = 0; i < canon_assigns.size(); i++) assign_to_index[canon_assigns[i]] = i;
+
+        auto &solution = solution_cache[fingerprint];
+        for (auto &chain : all_chains) {
+            std::vector<unsigned> chain_indices;
+            for (auto assign : chain) chain_indices.push_back(assign_to_index.at(assign));
+            solution.push_back(chain_indices);
+        }
+    }
 
     LOG2("\nTotal assign chains: " << all_chains.size());
     LOG2(print_assign_chains(all_chains));
@@ -473,6 +473,15 @@ class ComputeValuesAtDeparser : public Inspector {
                                 const ordered_set<AssignChain> &all_chains_in_group) const;
 
  private:
+    /// Chain solutions from previous applications of this pass, keyed by a
+    /// fingerprint of the group's assign structure.  Decaf is replayed when a
+    /// backtracking retry re-runs the backend passes and the deparser emit
+    /// structure rarely changes across retries, so unchanged groups reuse the
+    /// enumerated chains instead of recomputing them.  Chains are stored as
+    /// indices into the group's canonical assign order because the Assign
+    /// objects themselves are recreated by every application.
+    std::map<size_t, std::vector<std::vector<unsigned>>> solution_cache;
+
     Visitor::profile_t init_apply(const IR::Node *root) override;
 
     ordered_set<const Value *> get_all_weak_srcs(const PHV::Field *field,
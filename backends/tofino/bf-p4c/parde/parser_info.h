@@ -19,6 +19,7 @@
 #ifndef BACKENDS_TOFINO_BF_P4C_PARDE_PARSER_INFO_H_
 #define BACKENDS_TOFINO_BF_P4C_PARDE_PARSER_INFO_H_
 
+#include <mutex>
 #include <numeric>
 #include <optional>
 
@@ -252,9 +253,15 @@ class ParserGraphImpl : public DirectedGraph {
     /// Memoization table.
     mutable assoc::map<const State *, assoc::map<const State *, bool>> is_ancestor_;
 
+    /// Guards @a is_ancestor_ so that graph queries can be issued from worker threads (e.g. the
+    /// CLOT allocator's parallel candidate analysis). Recursive, since is_ancestor recurses.
+    mutable std::recursive_mutex is_ancestor_mutex_;
+
  public:
     /// Is "src" an ancestor of "dst"?
     bool is_ancestor(const State *src, const State *dst) const {
+        std::lock_guard<std::recursive_mutex> lock(is_ancestor_mutex_);
+
         if (src == dst) return false;
 
         if (!predecessors().count(dst)) return false;
@@ -783,6 +790,10 @@ class CollectParserInfoImpl : public PardeInspector {
     mutable assoc::map<const State *, assoc::map<const State *, const std::set<int> *>>
         all_shift_amounts_;
 
+    // Guards all_shift_amounts_ so that shift-amount queries can be issued from worker threads
+    // (e.g. the CLOT allocator's parallel candidate analysis).
+    mutable std::mutex all_shift_amounts_mutex_;
+
  public:
     /// @return all possible shift amounts, in bits, for all paths from the start state to @p dst .
     /// If @p dst is the start state, then a singleton 0 is returned.
@@ -816,6 +827,9 @@ class CollectParserInfoImpl : public PardeInspector {
     ///
     /// @pre DANGER: This method assumes the parser graph is a DAG.
     const std::set<int> *get_all_shift_amounts(const State *src, const State *dst) const {
+        // Covers the whole recursive computation; the graph's own lock nests safely inside.
+        std::lock_guard<std::mutex> lock(all_shift_amounts_mutex_);
+
         bool reverse_path = graphs().at(parser(src))->is_ancestor(dst, src);
         if (reverse_path) std::swap(src, dst);
 
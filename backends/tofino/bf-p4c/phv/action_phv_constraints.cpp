@@ -113,7 +113,13 @@ int ActionPhvConstraints::ConstraintTracker::current_action = 0;
 
 Visitor::profile_t ActionPhvConstraints::init_apply(const IR::Node *root) {
     LOG1("CLEARING ActionPhvConstraints");
+    if (pack_cache_hits + pack_cache_misses > 0)
+        LOG1("can_pack verdict cache: " << pack_cache_hits << " hits, " << pack_cache_misses
+                                        << " misses");
     profile_t rv = Inspector::init_apply(root);
+    pack_verdict_cache.clear();
+    pack_cache_hits = 0;
+    pack_cache_misses = 0;
     meter_color_destinations.clear();
     meter_color_destinations_8bit.clear();
     special_no_pack.clear();
@@ -2602,40 +2608,52 @@ CanPackReturnType ActionPhvConstraints::check_and_generate_conditional_constrain
     return std::make_tuple(CanPackErrorCode::NO_ERROR, rv);
 }
 
-CanPackReturnType ActionPhvConstraints::can_pack(
-    const PHV::Allocation &alloc, const std::vector<PHV::AllocSlice> &slices,
-    const PHV::Allocation::MutuallyLiveSlices &original_container_state,
+std::pair<uint64_t, uint64_t> ActionPhvConstraints::pack_query_fingerprint(
+    const std::vector<PHV::AllocSlice> &slices,
+    const PHV::Allocation::MutuallyLiveSlices &container_state,
     const PHV::Allocation::LiveRangeShrinkingMap &initActions) const {
-    // Allocating zero slices always succeeds...
-    if (slices.size() == 0)
-        return std::make_tuple(CanPackErrorCode::NO_ERROR,
-                               PHV::Allocation::ConditionalConstraints());
-
-    // no action will be applied on TPHV container.
-    const PHV::Container c = slices.front().container();
-    if (c.type().kind() == PHV::Kind::tagalong) {
-        return std::make_tuple(CanPackErrorCode::NO_ERROR,
-                               PHV::Allocation::ConditionalConstraints());
-    }
-
-    if (LOGGING(6)) constraint_tracker.print_field_ordering(slices);
-
-    const bool mocha_or_dark = c.is(PHV::Kind::dark) || c.is(PHV::Kind::mocha);
-
-    // mutual live (against any of @p slices) slices of this container
-    auto container_state = make_mutually_live_slices(slices, original_container_state);
-    if (LOGGING(4)) {
-        LOG4("\t\tChecking whether field slice(s) ");
-        for (const auto &slice : slices)
-            LOG4("\t\t\t" << slice.field()->name << " (" << slice.width() << "b)");
-        LOG4("\t\tcan be packed into container " << container_state << " already containing "
-                                                 << container_state.size() << " slices");
+    // Two independently seeded hashes: a colliding fingerprint would silently
+    // reuse the wrong verdict, so 64 bits are not enough for the millions of
+    // queries a large program generates.
+    std::pair<uint64_t, uint64_t> rv(0, 0x9e3779b97f4a7c15ULL);
+    auto mix = [&rv](uint64_t value) {
+        boost::hash_combine(rv.first, value);
+        boost::hash_combine(rv.second, ~value);
+    };
+    auto mix_access = [&mix](const PHV::StageAndAccess &access) {
+        mix(access.first);
+        mix((access.second.isRead() ? 1 : 0) | (access.second.isWrite() ? 2 : 0) |
+            (access.second.isLive() ? 4 : 0));
+    };
+    auto mix_slice = [&](const PHV::AllocSlice &slice) {
+        mix(slice.field()->id);
+        mix(hash_value(slice.container()));
+        mix(slice.field_slice().lo);
+        mix(slice.container_slice().lo);
+        mix(slice.width());
+        mix_access(slice.getEarliestLiveness());
+        mix_access(slice.getLatestLiveness());
+    };
+    mix(slices.size());
+    for (const auto &slice : slices) mix_slice(slice);
+    mix(container_state.size());
+    for (const auto &slice : container_state) mix_slice(slice);
+    mix(initActions.size());
+    for (const auto &kv : initActions) {
+        mix(kv.first->id);
+        for (const auto *action : kv.second) mix(reinterpret_cast<uintptr_t>(action));
     }
+    return rv;
+}
 
+CanPackErrorCode ActionPhvConstraints::alloc_independent_pack_checks(
+    const std::vector<PHV::AllocSlice> &slices,
+    PHV::Allocation::MutuallyLiveSlices &container_state,
+    const PHV::Allocation::LiveRangeShrinkingMap &initActions) const {
     // Check if table placement induced any no pack constraints on fields that are candidates for
     // packing. If yes, packing not possible.
     if (pack_conflicts_present(container_state, slices))
-        return std::make_tuple(CanPackErrorCode::PACK_CONSTRAINT_PRESENT, std::nullopt);
+        return CanPackErrorCode::PACK_CONSTRAINT_PRESENT;
 
     // Create candidate packing
     for (const auto &slice : slices) {
@@ -2645,7 +2663,7 @@ CanPackReturnType ActionPhvConstraints::can_pack(
     // Check if any of the fields are stateful ALU writes and check the data bus alignment
     // constraints.
     if (stateful_destinations_constraints_violated(container_state))
-        return std::make_tuple(CanPackErrorCode::STATEFUL_DEST_CONSTRAINT, std::nullopt);
+        return CanPackErrorCode::STATEFUL_DEST_CONSTRAINT;
 
 #if 0
     // Check for parser constant extract for non 8b containers.
@@ -2659,13 +2677,69 @@ CanPackReturnType ActionPhvConstraints::can_pack(
         LOG5(
             "\t\tThis packing requires a bitmasked-set instruction for a slice that reads "
             "special action data. Therefore, this packing is not possible.");
-        return std::make_tuple(CanPackErrorCode::BITMASK_CONSTRAINT, std::nullopt);
+        return CanPackErrorCode::BITMASK_CONSTRAINT;
     }
 
     // xxx(Deep): This function checks if any field that gets its value from METER_ALU, HASH_DIST,
     // RANDOM, or METER_COLOR is being packed with other fields written in the same action.
-    if (!check_speciality_packing(container_state))
-        return std::make_tuple(CanPackErrorCode::SPECIALTY_DATA, std::nullopt);
+    if (!check_speciality_packing(container_state)) return CanPackErrorCode::SPECIALTY_DATA;
+
+    return CanPackErrorCode::NO_ERROR;
+}
+
+CanPackReturnType ActionPhvConstraints::can_pack(
+    const PHV::Allocation &alloc, const std::vector<PHV::AllocSlice> &slices,
+    const PHV::Allocation::MutuallyLiveSlices &original_container_state,
+    const PHV::Allocation::LiveRangeShrinkingMap &initActions) const {
+    // Allocating zero slices always succeeds...
+    if (slices.size() == 0)
+        return std::make_tuple(CanPackErrorCode::NO_ERROR,
+                               PHV::Allocation::ConditionalConstraints());
+
+    // no action will be applied on TPHV container.
+    const PHV::Container c = slices.front().container();
+    if (c.type().kind() == PHV::Kind::tagalong) {
+        return std::make_tuple(CanPackErrorCode::NO_ERROR,
+                               PHV::Allocation::ConditionalConstraints());
+    }
+
+    if (LOGGING(6)) constraint_tracker.print_field_ordering(slices);
+
+    const bool mocha_or_dark = c.is(PHV::Kind::dark) || c.is(PHV::Kind::mocha);
+
+    // mutual live (against any of @p slices) slices of this container
+    auto container_state = make_mutually_live_slices(slices, original_container_state);
+    if (LOGGING(4)) {
+        LOG4("\t\tChecking whether field slice(s) ");
+        for (const auto &slice : slices)
+            LOG4("\t\t\t" << slice.field()->name << " (" << slice.width() << "b)");
+        LOG4("\t\tcan be packed into container " << container_state << " already containing "
+                                                 << container_state.size() << " slices");
+    }
+
+    // The pack-conflict, stateful-destination and speciality checks do not
+    // consult the surrounding allocation, so their verdict is memoized: the
+    // allocator asks about the same candidate packing many times while
+    // backtracking through different branches of its search.
+    const auto fingerprint = pack_query_fingerprint(slices, container_state, initActions);
+    CanPackErrorCode verdict;
+    if (auto cached = pack_verdict_cache.find(fingerprint); cached != pack_verdict_cache.end()) {
+        ++pack_cache_hits;
+        verdict = cached->second;
+        // Replay the candidate packing that alloc_independent_pack_checks
+        // would have created: the remaining checks expect the candidate slices
+        // to be part of the container state.
+        if (verdict == CanPackErrorCode::NO_ERROR)
+            for (const auto &slice : slices) container_state.insert(slice);
+    } else {
+        ++pack_cache_misses;
+        verdict = alloc_independent_pack_checks(slices, container_state, initActions);
+        pack_verdict_cache.emplace(fingerprint, verdict);
+    }
+    if ((pack_cache_hits + pack_cache_misses) % 100000 == 0)
+        LOG4("\t\tcan_pack verdict cache: " << pack_cache_hits << " hits, " << pack_cache_misses
+                                            << " misses");
+    if (verdict != CanPackErrorCode::NO_ERROR) return std::make_tuple(verdict, std::nullopt);
 
     const auto actions = make_writing_action_set(alloc, container_state, initActions);
     auto action_props = make_action_container_properties(alloc, actions, container_state,
@@ -23,6 +23,7 @@
 
 #include "backends/tofino/bf-p4c/common/map_tables_to_actions.h"
 #include "backends/tofino/bf-p4c/ir/bitrange.h"
+#include "backends/tofino/bf-p4c/lib/assoc.h"
 #include "backends/tofino/bf-p4c/lib/union_find.hpp"
 #include "backends/tofino/bf-p4c/mau/action_analysis.h"
 #include "backends/tofino/bf-p4c/mau/table_dependency_graph.h"
@@ -114,6 +115,17 @@ class ActionPhvConstraints : public Inspector {
 
     ordered_map<const PHV::Field *, ordered_set<const PHV::Field *>> same_byte_fields;
 
+    /// Memoized verdicts for the allocation-independent prefix of can_pack().
+    /// The pack-conflict, stateful-destination and speciality checks depend
+    /// only on the candidate slices, the mutually live container state and the
+    /// metadata initialization actions, so their outcome can be reused when the
+    /// allocator retries the same candidate packing from another branch of its
+    /// search. Keyed by a 128-bit fingerprint of those inputs; checks that
+    /// consult the surrounding allocation are never cached.
+    mutable assoc::hash_map<std::pair<uint64_t, uint64_t>, CanPackErrorCode> pack_verdict_cache;
+    mutable uint64_t pack_cache_hits = 0;
+    mutable uint64_t pack_cache_misses = 0;
+
     bool prelim_constraints_ok = true;
 
     struct ClassifiedSource {
@@ -902,6 +914,23 @@ class ActionPhvConstraints : public Inspector {
     bool pack_conflicts_present(const PHV::Allocation::MutuallyLiveSlices &container_state,
                                 const std::vector<PHV::AllocSlice> &slices) const;
 
+    /// @returns a fingerprint identifying a can_pack() query independently of
+    /// the surrounding allocation: the candidate @p slices, the mutually live
+    /// @p container_state and the metadata initialization @p initActions.
+    std::pair<uint64_t, uint64_t> pack_query_fingerprint(
+        const std::vector<PHV::AllocSlice> &slices,
+        const PHV::Allocation::MutuallyLiveSlices &container_state,
+        const PHV::Allocation::LiveRangeShrinkingMap &initActions) const;
+
+    /// Runs the can_pack() checks that do not consult the surrounding
+    /// allocation, inserting @p slices into @p container_state once the
+    /// pack-conflict check on the original state has passed. Verdicts are
+    /// memoized in pack_verdict_cache, keyed by pack_query_fingerprint().
+    CanPackErrorCode alloc_independent_pack_checks(
+        const std::vector<PHV::AllocSlice> &slices,
+        PHV::Allocation::MutuallyLiveSlices &container_state,
+        const PHV::Allocation::LiveRangeShrinkingMap &initActions) const;
+
     /// @returns true if parser constant extract constraints are satisfied for the candidate
     /// packing. This only applies to Tofino, where fields written to using constant extractors in
     /// the same parser state must be allocated within 4 consecutive bits of the same 16-bit
@@ -4121,6 +4121,15 @@ AllocResult AllocatePHV::brute_force_alloc(
     }
 
     AllocResult result(AllocResultCode::UNKNOWN, alloc.makeTransaction(), {});
+    // The configs form a portfolio that must run sequentially.  Racing them on
+    // worker threads and cancelling the losers would require each entry to own
+    // its state, but they share the transactions derived from @p alloc, the
+    // mutable constraint caches inside utils_i (ActionPhvConstraints
+    // memoization among them), and the process-wide PhvInfo::darkSpillARA flag
+    // that this very loop toggles.  Until those are per-strategy, the portfolio
+    // is ordered so the config that usually fits runs first, and the loop stops
+    // early on outcomes later configs cannot improve (success or unsat
+    // slicing).
     for (const auto &config : configs) {
         if (config.unsupported_devices &&
             config.unsupported_devices->count(Device::currentDevice())) {
@@ -26,45 +26,6 @@
 #include "backends/tofino/bf-p4c/phv/analysis/live_range_shrinking.h"
 #include "backends/tofino/bf-p4c/phv/utils/liverange_opti_utils.h"
 
-bool DarkLiveRange::overlaps(const int num_max_min_stages, const DarkLiveRangeEntry &range1,
-                             const DarkLiveRangeEntry &range2) {
-    const int DEPARSER = num_max_min_stages + 1;
-    bitvec f1Uses;
-    bitvec f2Uses;
-    unsigned index = 0;
-    for (int i = 0; i <= DEPARSER; i++) {
-        for (unsigned j : {READ, WRITE}) {
-            StageAndAccess stageAndAccess = std::make_pair(i, PHV::FieldUse(j));
-            if (range1.count(stageAndAccess)) {
-                if (!range1.at(stageAndAccess).second) {
-                    // Ignore dark uses for the purposes of deciding overlay
-                    f1Uses.setbit(index);
-                    LOG_DEBUG5(TAB2 "Setting f1 bit " << index << ", stage " << i << ": "
-                                                      << PHV::FieldUse(j));
-                } else {
-                    LOG_DEBUG5(TAB3 "Not setting f1 bit " << index << ", stage " << i << ": "
-                                                          << "DARK " << PHV::FieldUse(j));
-                }
-            }
-            if (range2.count(stageAndAccess)) {
-                if (!range2.at(stageAndAccess).second) {
-                    f2Uses.setbit(index);
-                    LOG_DEBUG5(TAB2 "Setting f2 bit " << index << ", stage " << i << ": "
-                                                      << PHV::FieldUse(j));
-                } else {
-                    LOG_DEBUG5(TAB3 "Not setting f2 bit " << index << ", stage " << i << ": "
-                                                          << "DARK " << PHV::FieldUse(j));
-                }
-            }
-            ++index;
-        }
-    }
-    LOG_DEBUG4(TAB2 "Field 1 use: " << f1Uses << ", Field 2 use: " << f2Uses);
-    bitvec combo = f1Uses & f2Uses;
-    LOG_DEBUG4(TAB2 "combo: " << combo << ", overlaps? " << (combo.popcount() != 0));
-    return (combo.popcount() != 0);
-}
-
 bool DarkLiveRange::increasesDependenceCriticalPath(const IR::MAU::Table *use,
                                                     const IR::MAU::Table *init) const {
     const int maxStages = dg.max_min_stage_per_gress[use->gress];
@@ -257,10 +218,10 @@ void DarkLiveRange::end_apply() {
                 overlay(f1->id, f2->id) = true;
                 continue;
             }
-            auto &access1 = livemap.at(f1);
-            auto &access2 = livemap.at(f2);
             LOG_DEBUG3(TAB1 "(" << f1->name << ", " << f2->name << ")");
-            if (!overlaps(dg.max_min_stage, access1, access2)) {
+            LOG_DEBUG4(TAB2 "Field 1 use: " << livemap.getUseTimeline(f1) << ", Field 2 use: "
+                                            << livemap.getUseTimeline(f2));
+            if (!livemap.nonDarkAccessesOverlap(f1, f2)) {
                 LOG_DEBUG4(TAB1 "Overlay possible between " << f1 << " and " << f2);
                 overlay(f1->id, f2->id) = true;
             }
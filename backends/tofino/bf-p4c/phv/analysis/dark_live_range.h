@@ -34,6 +34,7 @@
 #include "backends/tofino/bf-p4c/phv/pragma/phv_pragmas.h"
 #include "backends/tofino/bf-p4c/phv/utils/live_range_report.h"
 #include "backends/tofino/bf-p4c/specs/phv.h"
+#include "lib/bitvec.h"
 #include "lib/symbitmatrix.h"
 
 // Structure that represents the live range map.
@@ -52,6 +53,11 @@ class DarkLiveRangeMap {
     static constexpr unsigned WRITE = PHV::FieldUse::WRITE;
 
     ordered_map<const PHV::Field *, Entry> livemap;
+    /// Per-field timeline of non-dark accesses, two bits per stage (READ, then WRITE), with
+    /// the deparser occupying the stage after the last MAU stage. Kept in sync with
+    /// @a livemap by addAccess, so that overlap screening between two fields is a single
+    /// bitwise AND over the timelines instead of a walk over the per-stage access maps.
+    ordered_map<const PHV::Field *, bitvec> timelines;
     int DEPARSER = -1;
 
  public:
@@ -77,13 +83,19 @@ class DarkLiveRangeMap {
             units.insert(unit);
             AccessInfo val = std::make_pair(units, dark);
             livemap[f][key] = val;
-            return;
+        } else {
+            livemap[f][key].first.insert(unit);
+            livemap[f][key].second &= dark;
         }
-        livemap[f][key].first.insert(unit);
-        livemap[f][key].second &= dark;
+        // A non-dark access from any unit makes the access non-dark for good (AccessInfo's
+        // flag only ever transitions towards non-dark), so bits are set and never cleared.
+        if (!dark) timelines[f].setbit(2 * stage + (access == WRITE ? 1 : 0));
     }
 
-    void clear() { livemap.clear(); }
+    void clear() {
+        livemap.clear();
+        timelines.clear();
+    }
 
     bool count(const PHV::Field *f) const { return livemap.count(f); }
 
@@ -102,6 +114,17 @@ class DarkLiveRangeMap {
         return hasAccess(f, std::make_pair(stage, PHV::FieldUse(access)));
     }
 
+    /// @returns the timeline of non-dark accesses for @p f; empty if the field has none.
+    bitvec getUseTimeline(const PHV::Field *f) const {
+        return timelines.count(f) ? timelines.at(f) : bitvec();
+    }
+
+    /// @returns true if @p f1 and @p f2 have non-dark accesses in the same stage, i.e. their
+    /// live ranges rule out a dark overlay. Bulk bitwise AND over the precomputed timelines.
+    bool nonDarkAccessesOverlap(const PHV::Field *f1, const PHV::Field *f2) const {
+        return !(getUseTimeline(f1) & getUseTimeline(f2)).empty();
+    }
+
     std::optional<StageAndAccess> getEarliestAccess(const PHV::Field *f) const;
     std::optional<StageAndAccess> getLatestAccess(const PHV::Field *f) const;
 };
@@ -211,13 +234,6 @@ class DarkLiveRange : public Inspector {
 
     using OrderedFieldSummary = std::vector<OrderedFieldInfo>;
 
- public:
-    /// Given maximum number of MAU stages @p num_max_min_stages and two fields with read/write
-    /// accesses defined by @p range1 and @p range2, this method @returns true if the accesses
-    /// for the field overlap.
-    static bool overlaps(const int num_max_min_stages, const DarkLiveRangeEntry &range1,
-                         const DarkLiveRangeEntry &range2);
-
  private:
     PhvInfo &phv;
     const ClotInfo &clot;
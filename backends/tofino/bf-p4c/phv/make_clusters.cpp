@@ -1235,6 +1235,55 @@ Visitor::profile_t Clustering::MakeSuperClusters::init_apply(const IR::Node *roo
     return rv;
 }
 
+cstring Clustering::MakeSuperClusters::fingerprint(const PHV::SuperCluster *sc) {
+    auto emit_slice = [](std::stringstream &ss, const PHV::FieldSlice &slice) {
+        ss << slice.field()->name << "[" << slice.range().lo << ":" << slice.range().hi << "]";
+    };
+    // Aligned and rotational clusters carry no meaningful order, so their
+    // encodings are sorted to make the key insensitive to union-find
+    // enumeration order.  Order within a slice list is significant and kept.
+    std::vector<std::string> rotationals;
+    for (const auto *rotational : sc->clusters()) {
+        std::vector<std::string> aligneds;
+        for (auto *aligned : rotational->clusters()) {
+            std::stringstream ss;
+            ss << static_cast<int>(aligned->kind()) << "," << aligned->gress() << ",";
+            if (auto alignment = aligned->alignment())
+                ss << *alignment;
+            else
+                ss << "-";
+            ss << "," << aligned->exact_containers() << "," << aligned->max_width() << ","
+               << aligned->num_constraints() << "," << aligned->aggregate_size() << ","
+               << aligned->deparsed();
+            for (const auto &slice : *aligned) {
+                ss << "|";
+                emit_slice(ss, slice);
+            }
+            aligneds.push_back(ss.str());
+        }
+        std::sort(aligneds.begin(), aligneds.end());
+        std::stringstream ss;
+        for (const auto &aligned : aligneds) ss << aligned << "&";
+        rotationals.push_back(ss.str());
+    }
+    std::sort(rotationals.begin(), rotationals.end());
+    std::vector<std::string> lists;
+    for (const auto *slice_list : sc->slice_lists()) {
+        std::stringstream ss;
+        for (const auto &slice : *slice_list) {
+            ss << "|";
+            emit_slice(ss, slice);
+        }
+        lists.push_back(ss.str());
+    }
+    std::sort(lists.begin(), lists.end());
+    std::stringstream key;
+    for (const auto &rotational : rotationals) key << rotational << ";";
+    key << "#";
+    for (const auto &list : lists) key << list << ";";
+    return cstring(key.str());
+}
+
 void Clustering::MakeSuperClusters::end_apply() {
     auto slice_lists = place_togethers_i.get_slice_lists();
     LOG1("MakeSuperClusters slicelist input: ");
@@ -1274,19 +1323,31 @@ void Clustering::MakeSuperClusters::end_apply() {
         }
     }
 
+    // Cache the slice list membership of each slice up front, so that
+    // collecting the lists that induced each grouping below is a lookup per
+    // slice instead of a search through every slice list.
+    assoc::hash_map<PHV::FieldSlice, ordered_set<PHV::SuperCluster::SliceList *>>
+        slices_to_slice_lists;
+    for (auto *slice_list : slice_lists)
+        for (auto &slice : *slice_list) slices_to_slice_lists[slice].insert(slice_list);
+
+    // Fingerprints of the groups built in this round, which replace
+    // super_cluster_cache_i once the round is complete.
+    ordered_map<cstring, PHV::SuperCluster *> fingerprints;
+
     // Build SuperClusters.
     // copy cluster_set, we add to it
     for (auto cluster_set : cluster_union_find) {
         // Collect slice lists that induced this grouping.
-        // TODO: Caching would be much more efficient.
         ordered_set<PHV::SuperCluster::SliceList *> these_lists;
         ordered_set<PHV::FieldSlice> slices_in_these_lists;
         for (auto *rotational_cluster : cluster_set)
             for (auto *aligned_cluster : rotational_cluster->clusters())
-                for (const PHV::FieldSlice &slice : *aligned_cluster)
-                    for (auto *slist : slice_lists)
-                        if (std::find(slist->begin(), slist->end(), slice) != slist->end())
-                            these_lists.insert(slist);
+                for (const PHV::FieldSlice &slice : *aligned_cluster) {
+                    auto it = slices_to_slice_lists.find(slice);
+                    if (it == slices_to_slice_lists.end()) continue;
+                    for (auto *slist : it->second) these_lists.insert(slist);
+                }
 
         // Put each exact_containers slice in a rotational cluster but not in a
         // field list into a singelton field list.
@@ -1318,10 +1379,23 @@ void Clustering::MakeSuperClusters::end_apply() {
             })) {
             LOG1("ignore completely unreferenced SuperCluster: " << sc);
         } else {
+            // If an identical group was built in the previous allocation
+            // round, hand back the same object, so that its identity (and
+            // any pointer-keyed state downstream) stays stable across rounds.
+            auto key = fingerprint(sc);
+            auto cached = self.super_cluster_cache_i.find(key);
+            if (cached != self.super_cluster_cache_i.end() && *cached->second == *sc) {
+                LOG4("reusing unchanged SuperCluster from previous round: " << cached->second);
+                sc = cached->second;
+                self.super_cluster_cache_i.erase(cached);
+            }
+            fingerprints.emplace(key, sc);
             self.super_clusters_i.emplace_back(sc);
         }
     }
 
+    self.super_cluster_cache_i = std::move(fingerprints);
+
     if (LOGGING(1)) {
         LOG1("--- CLUSTERING RESULTS --------------------------------------------------------");
         LOG1("All fields are assigned to exactly one cluster.  Fields that are not read or");
@@ -86,6 +86,12 @@ class Clustering : public PassManager {
     /// group.  Every rotational cluster is in exactly one super cluster.
     std::list<PHV::SuperCluster *> super_clusters_i;
 
+    /// Fingerprints of the super clusters produced by the previous allocation
+    /// round, used by MakeSuperClusters to keep unchanged groups
+    /// pointer-stable across rounds.  Unlike the structures above, this map
+    /// deliberately survives ClearClusteringStructs.
+    ordered_map<cstring, PHV::SuperCluster *> super_cluster_cache_i;
+
     /// field pairs that cannot be packed in a container because of inconsistent
     /// extractions from flexible header fields.
     assoc::hash_map<const PHV::Field *, assoc::hash_set<const PHV::Field *>>
@@ -448,6 +454,14 @@ class Clustering : public PassManager {
         /// that appear in the same list.
         void end_apply() override;
 
+        /// @returns a key encoding everything a SuperCluster caches at
+        /// construction time: member slices, slice list contents, and the
+        /// constraint summaries of each aligned cluster.  Groups with equal
+        /// fingerprints are interchangeable; a changed field constraint
+        /// changes the fingerprint, so only groups whose fields are untouched
+        /// since the previous round are ever reused.
+        static cstring fingerprint(const PHV::SuperCluster *sc);
+
         /// Add padding into slice list for fields that will be marshaled, because they
         /// have exact_container requirement but might be non-byte-aligned.
         /// Singleton padding cluster will be inserted into @p cluster_set, if it is added
@@ -2103,18 +2103,20 @@ bool DfsItrContext::dfs(const IterateCb &yield, const ordered_set<SuperCluster *
     auto choices = make_choices(*target);
     bool has_non_rejected_slice_choice = false;
     std::optional<SplitChoice> max_slice_choice = std::nullopt;
-    std::stringstream ss;
-    ss << "{ ";
     for (const auto &c : choices) {
         if (!reject_sizes.count(c)) has_non_rejected_slice_choice = true;
         if (!max_slice_choice)
             max_slice_choice = c;
         else if (c > max_slice_choice)
             max_slice_choice = c;
-        ss << int(c) << " ";
     }
-    ss << "}";
-    LOG5("dfs_depth-" << dfs_depth_i << ": possible choices: " << ss.str());
+    if (LOGGING(5)) {
+        std::stringstream ss;
+        ss << "{ ";
+        for (const auto &c : choices) ss << int(c) << " ";
+        ss << "}";
+        LOG5("dfs_depth-" << dfs_depth_i << ": possible choices: " << ss.str());
+    }
     for (const auto &choice : choices) {
         LOG5("dfs_depth-" << dfs_depth_i << ": try to split @" << int(choice));
 
@@ -572,12 +572,14 @@ cstring PHV::Allocation::commit(Transaction &view) {
     std::stringstream ss;
     state_to_containers_i.clear();
 
-    // Merge the status from the view.
-    for (const auto &kv : view.getTransactionStatus()) {
-        bool c_status_chng = this->addStatus(kv.first, kv.second);
+    // Merge the status from the view.  Only containers in the view's journal
+    // were actually written; the rest of its status map caches parent state.
+    for (const auto &c : view.getDirtyContainers()) {
+        const auto &status = view.getTransactionStatus().at(c);
+        bool c_status_chng = this->addStatus(c, status);
         if (c_status_chng) {
-            ss << "   " << kv.first << " " << kv.second.parserGroupGress << " "
-               << kv.second.deparserGroupGress << "\n";
+            ss << "   " << c << " " << status.parserGroupGress << " "
+               << status.deparserGroupGress << "\n";
         }
     }
 
@@ -609,7 +611,11 @@ cstring PHV::Allocation::commit(Transaction &view) {
 PHV::Transaction *PHV::Allocation::clone(const Allocation &parent) const {
     PHV::Transaction *rv = new PHV::Transaction(parent);
 
+    const auto *child_view = dynamic_cast<const PHV::Transaction *>(this);
     for (const auto &kv : container_status_i) {
+        // A status entry this transaction never wrote is a read-through cache
+        // of parent state and cannot contribute to the difference.
+        if (child_view && !child_view->isDirty(kv.first)) continue;
         bool new_slice = false;
         const auto *parent_status = parent.getStatus(kv.first);
         BUG_CHECK(parent_status,
@@ -637,6 +643,7 @@ PHV::Transaction *PHV::Allocation::clone(const Allocation &parent) const {
         if (!new_slice && !gress_assign) continue;
 
         rv->container_status_i[kv.first] = kv.second;
+        rv->dirty_i.insert(kv.first);
     }
 
     for (const auto &kv : meta_init_points_i)
@@ -1565,6 +1572,9 @@ PHV::SuperCluster::SuperCluster(ordered_set<const PHV::RotationalCluster *> clus
 
 void PHV::SuperCluster::calc_pack_conflicts() {
     // calculate number of no pack conditions for each super cluster
+    // recomputed from scratch: clustering may hand back the same object in
+    // later allocation rounds
+    num_pack_conflicts_i = 0;
     forall_fieldslices([&](const PHV::FieldSlice &fs) {
         num_pack_conflicts_i += fs.field()->num_pack_conflicts();
     });
@@ -216,7 +216,7 @@ class Allocation {
     /// @returns the meta_init_points_i map for the current allocation object.
     ordered_map<AllocSlice, ActionSet> &get_meta_init_points() const { return meta_init_points_i; }
 
- private:
+ protected:
     /// Uniform abstraction for setting container state.  For internal use
     /// only.  @c must exist in this Allocation.
     virtual bool addStatus(PHV::Container c, const ContainerStatus &status);
@@ -559,8 +559,44 @@ class ConcreteAllocation : public Allocation {
  * allocation but rather add to it.
  */
 class Transaction : public Allocation {
+    /// Allocation::clone extracts transaction deltas and fills the journal directly.
+    friend class Allocation;
+
     const Allocation *parent_i;
 
+    /// The journal of this transaction: the containers actually written
+    /// through it.  Entries of container_status_i outside this set are only
+    /// read-through caches of parent state, so commit and clone need to look
+    /// at journaled containers only, making both O(writes) instead of
+    /// O(containers examined).  Rolling back remains a plain discard.
+    ordered_set<PHV::Container> dirty_i;
+
+    /// Journal-recording overrides of the Allocation mutators.
+    bool addStatus(PHV::Container c, const ContainerStatus &status) override {
+        dirty_i.insert(c);
+        return Allocation::addStatus(c, status);
+    }
+    void addSlice(PHV::Container c, AllocSlice slice) override {
+        dirty_i.insert(c);
+        Allocation::addSlice(c, slice);
+    }
+    void setGress(PHV::Container c, GressAssignment gress) override {
+        dirty_i.insert(c);
+        Allocation::setGress(c, gress);
+    }
+    void setParserGroupGress(PHV::Container c, GressAssignment gress) override {
+        dirty_i.insert(c);
+        Allocation::setParserGroupGress(c, gress);
+    }
+    void setDeparserGroupGress(PHV::Container c, GressAssignment gress) override {
+        dirty_i.insert(c);
+        Allocation::setDeparserGroupGress(c, gress);
+    }
+    void setParserExtractGroupSource(PHV::Container c, ExtractSource source) override {
+        dirty_i.insert(c);
+        Allocation::setParserExtractGroupSource(c, source);
+    }
+
  public:
     /// Uniform abstraction for accessing a container state.
     /// @returns the ContainerStatus of this allocation, if present.  Failing
@@ -624,11 +660,19 @@ class Transaction : public Allocation {
     /// @returns the set of actions in which @p slice must be initialized for live range shrinking.
     std::optional<ActionSet> getInitPoints(const AllocSlice &slice) const override;
 
-    /// Returns the outstanding writes in this view.
+    /// Returns the outstanding writes in this view.  Note that this also
+    /// contains read-through caches of parent state; see getDirtyContainers.
     const ordered_map<PHV::Container, ContainerStatus> &getTransactionStatus() const {
         return container_status_i;
     }
 
+    /// Returns the journal of this view: the containers actually written
+    /// through it, in write order.
+    const ordered_set<PHV::Container> &getDirtyContainers() const { return dirty_i; }
+
+    /// @returns true if @p c was written through this transaction.
+    bool isDirty(PHV::Container c) const { return dirty_i.count(c) > 0; }
+
     /// Returns the actual diff of outstanding writes in this view.
     ordered_map<PHV::Container, ContainerStatus> get_actual_diff() const;
 
@@ -700,8 +744,14 @@ class Transaction : public Allocation {
                 parent_i->isDarkWriteAvailable(c, minStage, maxStage));
     }
 
+    void removeAllocatedSlice(const ordered_set<PHV::AllocSlice> &slices) override {
+        for (const auto &slice : slices) dirty_i.insert(slice.container());
+        Allocation::removeAllocatedSlice(slices);
+    }
+
     /// Clears any allocation added to this transaction.
     void clearTransactionStatus() {
+        dirty_i.clear();
         container_status_i.clear();
         meta_init_points_i.clear();
         init_writes_i.clear();
@@ -69,8 +69,8 @@ void run_ubpf_backend(const EbpfOptions &options, const IR::ToplevelBlock *tople
     prog->emitH(&h, hfile);
     prog->emitC(&c, hfile.filename());
 
-    *cstream << c.toString();
-    *hstream << h.toString();
+    c.writeTo(*cstream);
+    h.writeTo(*hstream);
     cstream->flush();
     hstream->flush();
 }
@@ -541,6 +541,11 @@ std::optional<bool> BFRuntimeGenerator::actProfHasSelector(P4Id actProfId) const
 
 Util::JsonArray *BFRuntimeGenerator::makeActionSpecs(const p4configv1::Table &table,
                                                      P4Id *maxActionParamId) const {
+    auto cachedSpecs = actionSpecsCache.find(table.preamble().id());
+    if (cachedSpecs != actionSpecsCache.end()) {
+        if (maxActionParamId != nullptr) *maxActionParamId = cachedSpecs->second.second;
+        return cachedSpecs->second.first;
+    }
     auto *specs = new Util::JsonArray();
     P4Id maxId = 0;
     for (const auto &action_ref : table.action_refs()) {
@@ -549,6 +554,23 @@ Util::JsonArray *BFRuntimeGenerator::makeActionSpecs(const p4configv1::Table &ta
             ::P4::error(ErrorType::ERR_INVALID, "Invalid action id '%1%'", action_ref.id());
             continue;
         }
+        for (const auto &param : action->params())
+            if (param.id() > maxId) maxId = param.id();
+        // An action referenced by several tables gets the same spec in each of
+        // them as long as the scope and annotations on the reference match, so
+        // the fragment built for the first table can be appended to the others
+        // as-is.
+        std::string refAnnotations;
+        for (const auto &annotation : action_ref.annotations()) {
+            refAnnotations.append(annotation);
+            refAnnotations.push_back('\0');
+        }
+        auto specKey = std::make_tuple(action_ref.id(), int(action_ref.scope()), refAnnotations);
+        auto cachedSpec = actionSpecCache.find(specKey);
+        if (cachedSpec != actionSpecCache.end()) {
+            specs->append(cachedSpec->second);
+            continue;
+        }
         auto *spec = new Util::JsonObject();
         const auto &pre = action->preamble();
         spec->emplace("id", pre.id());
@@ -585,12 +607,13 @@ Util::JsonArray *BFRuntimeGenerator::makeActionSpecs(const p4configv1::Table &ta
                                    false /* read_only */, makeTypeBytes(param.bitwidth()),
                                    annotations);
             }
-            if (param.id() > maxId) maxId = param.id();
         }
         spec->emplace("data"_cs, dataJson);
+        actionSpecCache.emplace(specKey, spec);
         specs->append(spec);
     }
     if (maxActionParamId != nullptr) *maxActionParamId = maxId;
+    actionSpecsCache.emplace(table.preamble().id(), std::make_pair(specs, maxId));
     return specs;
 }
 
@@ -18,9 +18,12 @@ limitations under the License.
 #include <algorithm>
 #include <iosfwd>
 #include <iterator>
+#include <map>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <tuple>
+#include <utility>
 
 #include "control-plane/p4RuntimeSerializer.h"
 #include "lib/error.h"
@@ -411,6 +414,17 @@ class BFRuntimeGenerator {
     /// fields) need to receive a distinct id in the same space.
     Util::JsonArray *makeActionSpecs(const p4configv1::Table &table,
                                      P4Id *maxActionParamId = nullptr) const;
+
+    /// Memoized results of makeActionSpecs(), keyed on table id, along with
+    /// the maximum action parameter id for the table. A table's action specs
+    /// are requested both for the match table itself and for the action
+    /// profile it is implemented with, and the JSON tree is immutable once
+    /// built, so the emitted fragment can be shared.
+    mutable std::map<P4Id, std::pair<Util::JsonArray *, P4Id>> actionSpecsCache;
+    /// Shares the JSON spec emitted for a single action between all tables
+    /// that reference it with the same scope and annotations; programs built
+    /// from a common action library contain many such tables.
+    mutable std::map<std::tuple<P4Id, int, std::string>, Util::JsonObject *> actionSpecCache;
     virtual std::optional<Counter> getDirectCounter(P4Id counterId) const;
     virtual std::optional<Meter> getDirectMeter(P4Id meterId) const;
 
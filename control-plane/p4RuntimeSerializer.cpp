@@ -18,6 +18,8 @@ limitations under the License.
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #pragma GCC diagnostic ignored "-Wpedantic"
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/json_util.h>
 #pragma GCC diagnostic pop
@@ -96,6 +98,17 @@ static std::optional<cstring> explicitNameAnnotation(const IR::IAnnotated *item)
     return str->value;
 }
 
+/// Arena on which the generated P4Info and WriteRequest messages (and, through them,
+/// all of their sub-messages) are allocated.  The messages are handed out through
+/// P4RuntimeAPI and kept for the rest of the compile, so the arena is intentionally
+/// never torn down; what it buys us is that the tens of thousands of sub-messages a
+/// large program generates are bump-allocated together instead of individually
+/// heap-allocated, which fragments the heap and slows down construction.
+static google::protobuf::Arena &messageArena() {
+    static google::protobuf::Arena arena;
+    return arena;
+}
+
 namespace writers {
 
 using google::protobuf::Message;
@@ -138,21 +151,21 @@ static bool writeJsonTo(const Message &message, std::ostream *destination,
 static bool writeTextTo(const Message &message, std::ostream *destination) {
     CHECK_NULL(destination);
 
-    // According to the protobuf documentation, it would be better to use Print
-    // with a FileOutputStream object for performance reasons. However all we
-    // have here is a std::ostream and performance is not a concern.
-    std::string output;
     google::protobuf::TextFormat::Printer textPrinter;
     // set to expand google.protobuf.Any payloads
     textPrinter.SetExpandAny(true);
     *destination << "# proto-file: " << message.GetDescriptor()->file()->name() << "\n";
     *destination << "# proto-message: " << message.GetTypeName() << "\n\n";
-    if (!textPrinter.PrintToString(message, &output)) {
-        ::P4::error(ErrorType::ERR_IO, "Failed to serialize protobuf message to text");
-        return false;
+    {
+        // Stream the text directly to the output instead of materializing the whole
+        // text proto in a string first; for large programs the text form is many
+        // times the size of the binary message.
+        google::protobuf::io::OstreamOutputStream zeroCopyOut(destination);
+        if (!textPrinter.Print(message, &zeroCopyOut)) {
+            ::P4::error(ErrorType::ERR_IO, "Failed to serialize protobuf message to text");
+            return false;
+        }
     }
-
-    *destination << output;
     if (!destination->good()) {
         ::P4::error(ErrorType::ERR_IO, "Failed to write text protobuf message to the output");
         return false;
@@ -423,7 +436,7 @@ class P4RuntimeAnalyzer {
 
     P4RuntimeAnalyzer(const P4RuntimeSymbolTable &symbols, TypeMap *typeMap, ReferenceMap *refMap,
                       P4RuntimeArchHandlerIface *archHandler)
-        : p4Info(new P4Info),
+        : p4Info(google::protobuf::Arena::Create<P4Info>(&messageArena())),
           symbols(symbols),
           typeMap(typeMap),
           refMap(refMap),
@@ -1057,7 +1070,8 @@ class P4RuntimeEntriesConverter {
     friend class P4RuntimeAnalyzer;
 
     explicit P4RuntimeEntriesConverter(const P4RuntimeSymbolTable &symbols)
-        : entries(new p4v1::WriteRequest), symbols(symbols) {}
+        : entries(google::protobuf::Arena::Create<p4v1::WriteRequest>(&messageArena())),
+          symbols(symbols) {}
 
     /// @return the P4Runtime WriteRequest message generated by this analyzer.
     const p4v1::WriteRequest *getEntries() const {
@@ -1470,11 +1484,16 @@ class P4RuntimeEntriesConverter {
 P4RuntimeAPI P4RuntimeSerializer::generateP4Runtime(const IR::P4Program *program, cstring arch) {
     using namespace ControlPlaneAPI;
 
+    // The memoized type specs are only valid for the IR this analysis run is
+    // about to produce.
+    TypeSpecConverter::clearCache();
+
     auto archHandlerBuilderIt = archHandlerBuilders.find(arch);
     if (archHandlerBuilderIt == archHandlerBuilders.end()) {
         ::P4::error(ErrorType::ERR_UNSUPPORTED, "Arch '%1%' not supported by P4Runtime serializer",
                     arch);
-        return P4RuntimeAPI{new p4configv1::P4Info(), new p4v1::WriteRequest()};
+        return P4RuntimeAPI{google::protobuf::Arena::Create<p4configv1::P4Info>(&messageArena()),
+                            google::protobuf::Arena::Create<p4v1::WriteRequest>(&messageArena())};
     }
 
     // Generate a new version of the program that satisfies the prerequisites of
@@ -1494,7 +1513,8 @@ P4RuntimeAPI P4RuntimeSerializer::generateP4Runtime(const IR::P4Program *program
         ::P4::error(ErrorType::ERR_UNSUPPORTED,
                     "%1%: unsupported P4 program (cannot apply necessary program transformations)",
                     "Cannot generate P4Info message");
-        return P4RuntimeAPI{new p4configv1::P4Info(), new p4v1::WriteRequest()};
+        return P4RuntimeAPI{google::protobuf::Arena::Create<p4configv1::P4Info>(&messageArena()),
+                            google::protobuf::Arena::Create<p4v1::WriteRequest>(&messageArena())};
     }
 
     auto archHandler = (*archHandlerBuilderIt->second)(&refMap, &typeMap, evaluatedProgram);
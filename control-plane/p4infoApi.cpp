@@ -282,4 +282,116 @@ std::optional<p4rt_id_t> getP4RuntimeId(const p4::config::v1::P4Info &p4Info,
     return std::nullopt;
 }
 
+const p4::config::v1::Table *P4InfoIndex::findTable(cstring controlPlaneName) const {
+    return lookup(getIndex(tableIndex, p4Info.tables()), controlPlaneName);
+}
+
+const p4::config::v1::Table *P4InfoIndex::findTable(p4rt_id_t id) const {
+    return lookup(getIndex(tableIndex, p4Info.tables()), id);
+}
+
+const p4::config::v1::Action *P4InfoIndex::findAction(cstring controlPlaneName) const {
+    return lookup(getIndex(actionIndex, p4Info.actions()), controlPlaneName);
+}
+
+const p4::config::v1::Action *P4InfoIndex::findAction(p4rt_id_t id) const {
+    return lookup(getIndex(actionIndex, p4Info.actions()), id);
+}
+
+const p4::config::v1::ActionProfile *P4InfoIndex::findActionProfile(
+    cstring controlPlaneName) const {
+    return lookup(getIndex(actionProfileIndex, p4Info.action_profiles()), controlPlaneName);
+}
+
+const p4::config::v1::ActionProfile *P4InfoIndex::findActionProfile(p4rt_id_t id) const {
+    return lookup(getIndex(actionProfileIndex, p4Info.action_profiles()), id);
+}
+
+const p4::config::v1::Counter *P4InfoIndex::findCounter(cstring controlPlaneName) const {
+    return lookup(getIndex(counterIndex, p4Info.counters()), controlPlaneName);
+}
+
+const p4::config::v1::Counter *P4InfoIndex::findCounter(p4rt_id_t id) const {
+    return lookup(getIndex(counterIndex, p4Info.counters()), id);
+}
+
+const p4::config::v1::DirectCounter *P4InfoIndex::findDirectCounter(
+    cstring controlPlaneName) const {
+    return lookup(getIndex(directCounterIndex, p4Info.direct_counters()), controlPlaneName);
+}
+
+const p4::config::v1::DirectCounter *P4InfoIndex::findDirectCounter(p4rt_id_t id) const {
+    return lookup(getIndex(directCounterIndex, p4Info.direct_counters()), id);
+}
+
+const p4::config::v1::Meter *P4InfoIndex::findMeter(cstring controlPlaneName) const {
+    return lookup(getIndex(meterIndex, p4Info.meters()), controlPlaneName);
+}
+
+const p4::config::v1::Meter *P4InfoIndex::findMeter(p4rt_id_t id) const {
+    return lookup(getIndex(meterIndex, p4Info.meters()), id);
+}
+
+const p4::config::v1::DirectMeter *P4InfoIndex::findDirectMeter(cstring controlPlaneName) const {
+    return lookup(getIndex(directMeterIndex, p4Info.direct_meters()), controlPlaneName);
+}
+
+const p4::config::v1::DirectMeter *P4InfoIndex::findDirectMeter(p4rt_id_t id) const {
+    return lookup(getIndex(directMeterIndex, p4Info.direct_meters()), id);
+}
+
+const p4::config::v1::ControllerPacketMetadata *P4InfoIndex::findControllerPacketMetadata(
+    cstring controlPlaneName) const {
+    return lookup(getIndex(controllerPacketMetadataIndex, p4Info.controller_packet_metadata()),
+                  controlPlaneName);
+}
+
+const p4::config::v1::ControllerPacketMetadata *P4InfoIndex::findControllerPacketMetadata(
+    p4rt_id_t id) const {
+    return lookup(getIndex(controllerPacketMetadataIndex, p4Info.controller_packet_metadata()), id);
+}
+
+const p4::config::v1::ValueSet *P4InfoIndex::findValueSet(cstring controlPlaneName) const {
+    return lookup(getIndex(valueSetIndex, p4Info.value_sets()), controlPlaneName);
+}
+
+const p4::config::v1::ValueSet *P4InfoIndex::findValueSet(p4rt_id_t id) const {
+    return lookup(getIndex(valueSetIndex, p4Info.value_sets()), id);
+}
+
+const p4::config::v1::Register *P4InfoIndex::findRegister(cstring controlPlaneName) const {
+    return lookup(getIndex(registerIndex, p4Info.registers()), controlPlaneName);
+}
+
+const p4::config::v1::Register *P4InfoIndex::findRegister(p4rt_id_t id) const {
+    return lookup(getIndex(registerIndex, p4Info.registers()), id);
+}
+
+const p4::config::v1::Digest *P4InfoIndex::findDigest(cstring controlPlaneName) const {
+    return lookup(getIndex(digestIndex, p4Info.digests()), controlPlaneName);
+}
+
+const p4::config::v1::Digest *P4InfoIndex::findDigest(p4rt_id_t id) const {
+    return lookup(getIndex(digestIndex, p4Info.digests()), id);
+}
+
+const P4InfoIndex::KindIndex<p4::config::v1::Extern> &P4InfoIndex::getExternIndex() const {
+    if (!externIndex.built) {
+        for (const auto &p4Extern : p4Info.externs()) {
+            externIndex.byName.emplace(cstring(p4Extern.extern_type_name()), &p4Extern);
+            externIndex.byId.emplace(p4Extern.extern_type_id(), &p4Extern);
+        }
+        externIndex.built = true;
+    }
+    return externIndex;
+}
+
+const p4::config::v1::Extern *P4InfoIndex::findExtern(cstring controlPlaneName) const {
+    return lookup(getExternIndex(), controlPlaneName);
+}
+
+const p4::config::v1::Extern *P4InfoIndex::findExtern(p4rt_id_t id) const {
+    return lookup(getExternIndex(), id);
+}
+
 }  // namespace P4::ControlPlaneAPI
@@ -2,6 +2,7 @@
 #define CONTROL_PLANE_P4INFOAPI_H_
 
 #include <optional>
+#include <unordered_map>
 
 #include "control-plane/p4RuntimeArchHandler.h"
 #include "control-plane/p4RuntimeSerializer.h"
@@ -180,6 +181,96 @@ const p4::config::v1::Extern *findP4RuntimeExtern(const p4::config::v1::P4Info &
 std::optional<p4rt_id_t> getP4RuntimeId(const p4::config::v1::P4Info &p4Info,
                                         const P4RuntimeSymbolType &type, cstring controlPlaneName);
 
+/// Hash-based lookup index over a P4Info message. The findP4Runtime* functions above scan
+/// the repeated fields linearly on every call, which is fine for occasional queries;
+/// tooling that performs many lookups against the same message should build a P4InfoIndex
+/// once and query it in O(1). Each entity kind is indexed lazily on its first lookup.
+/// The P4Info message must outlive the index and must not be modified while the index is
+/// in use.
+class P4InfoIndex {
+ public:
+    explicit P4InfoIndex(const p4::config::v1::P4Info &p4Info) : p4Info(p4Info) {}
+
+    const p4::config::v1::Table *findTable(cstring controlPlaneName) const;
+    const p4::config::v1::Table *findTable(p4rt_id_t id) const;
+    const p4::config::v1::Action *findAction(cstring controlPlaneName) const;
+    const p4::config::v1::Action *findAction(p4rt_id_t id) const;
+    const p4::config::v1::ActionProfile *findActionProfile(cstring controlPlaneName) const;
+    const p4::config::v1::ActionProfile *findActionProfile(p4rt_id_t id) const;
+    const p4::config::v1::Counter *findCounter(cstring controlPlaneName) const;
+    const p4::config::v1::Counter *findCounter(p4rt_id_t id) const;
+    const p4::config::v1::DirectCounter *findDirectCounter(cstring controlPlaneName) const;
+    const p4::config::v1::DirectCounter *findDirectCounter(p4rt_id_t id) const;
+    const p4::config::v1::Meter *findMeter(cstring controlPlaneName) const;
+    const p4::config::v1::Meter *findMeter(p4rt_id_t id) const;
+    const p4::config::v1::DirectMeter *findDirectMeter(cstring controlPlaneName) const;
+    const p4::config::v1::DirectMeter *findDirectMeter(p4rt_id_t id) const;
+    const p4::config::v1::ControllerPacketMetadata *findControllerPacketMetadata(
+        cstring controlPlaneName) const;
+    const p4::config::v1::ControllerPacketMetadata *findControllerPacketMetadata(
+        p4rt_id_t id) const;
+    const p4::config::v1::ValueSet *findValueSet(cstring controlPlaneName) const;
+    const p4::config::v1::ValueSet *findValueSet(p4rt_id_t id) const;
+    const p4::config::v1::Register *findRegister(cstring controlPlaneName) const;
+    const p4::config::v1::Register *findRegister(p4rt_id_t id) const;
+    const p4::config::v1::Digest *findDigest(cstring controlPlaneName) const;
+    const p4::config::v1::Digest *findDigest(p4rt_id_t id) const;
+    /// Externs are keyed by their extern type name / extern type id, matching
+    /// findP4RuntimeExtern, since Extern messages have no preamble.
+    const p4::config::v1::Extern *findExtern(cstring controlPlaneName) const;
+    const p4::config::v1::Extern *findExtern(p4rt_id_t id) const;
+
+ private:
+    /// Lazily built maps from preamble name / id to the message for one entity kind.
+    template <typename T>
+    struct KindIndex {
+        bool built = false;
+        std::unordered_map<cstring, const T *> byName;
+        std::unordered_map<p4rt_id_t, const T *> byId;
+    };
+
+    /// Build @p idx from @p range on first use; keyed on each object's preamble.
+    template <typename T, typename Range>
+    const KindIndex<T> &getIndex(KindIndex<T> &idx, const Range &range) const {
+        if (!idx.built) {
+            for (const auto &object : range) {
+                idx.byName.emplace(cstring(object.preamble().name()), &object);
+                idx.byId.emplace(object.preamble().id(), &object);
+            }
+            idx.built = true;
+        }
+        return idx;
+    }
+
+    template <typename T>
+    static const T *lookup(const KindIndex<T> &idx, cstring controlPlaneName) {
+        auto it = idx.byName.find(controlPlaneName);
+        return it == idx.byName.end() ? nullptr : it->second;
+    }
+    template <typename T>
+    static const T *lookup(const KindIndex<T> &idx, p4rt_id_t id) {
+        auto it = idx.byId.find(id);
+        return it == idx.byId.end() ? nullptr : it->second;
+    }
+
+    /// Externs have no preamble, so they are indexed separately by extern type name / id.
+    const KindIndex<p4::config::v1::Extern> &getExternIndex() const;
+
+    const p4::config::v1::P4Info &p4Info;
+    mutable KindIndex<p4::config::v1::Table> tableIndex;
+    mutable KindIndex<p4::config::v1::Action> actionIndex;
+    mutable KindIndex<p4::config::v1::ActionProfile> actionProfileIndex;
+    mutable KindIndex<p4::config::v1::Counter> counterIndex;
+    mutable KindIndex<p4::config::v1::DirectCounter> directCounterIndex;
+    mutable KindIndex<p4::config::v1::Meter> meterIndex;
+    mutable KindIndex<p4::config::v1::DirectMeter> directMeterIndex;
+    mutable KindIndex<p4::config::v1::ControllerPacketMetadata> controllerPacketMetadataIndex;
+    mutable KindIndex<p4::config::v1::ValueSet> valueSetIndex;
+    mutable KindIndex<p4::config::v1::Register> registerIndex;
+    mutable KindIndex<p4::config::v1::Digest> digestIndex;
+    mutable KindIndex<p4::config::v1::Extern> externIndex;
+};
+
 }  // namespace P4::ControlPlaneAPI
 
 #endif /* CONTROL_PLANE_P4INFOAPI_H_ */
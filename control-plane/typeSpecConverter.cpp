@@ -19,6 +19,7 @@ limitations under the License.
 #include <limits>
 #include <map>
 #include <string>
+#include <tuple>
 
 #include "bytestrings.h"
 #include "flattenHeader.h"
@@ -40,6 +41,22 @@ namespace P4 {
 
 namespace ControlPlaneAPI {
 
+namespace {
+
+/// Memoized results of TypeSpecConverter::convert(), shared across the
+/// converter instances created for each call. Named types are keyed on their
+/// declaration, since every mention of the same type is a distinct
+/// IR::Type_Name node but translates to the same spec; other types are keyed
+/// on the IR node itself. The boolean distinguishes the spec for a mention of
+/// a named type from the (null) result of converting its declaration
+/// directly, and the target P4TypeInfo is part of the key because converting
+/// a named type also populates its side tables.
+using ConvertCacheKey =
+    std::tuple<const P4TypeInfo *, const IR::Node *, /* is named-type mention */ bool>;
+std::map<ConvertCacheKey, const P4DataTypeSpec *> convertCache;
+
+}  // namespace
+
 bool hasTranslationAnnotation(const IR::Type *type, TranslationAnnotation *payload) {
     const IR::Annotation *ann = nullptr;
     if (auto *annotated = type->to<IR::IAnnotated>())
@@ -390,11 +407,28 @@ bool TypeSpecConverter::preorder(const IR::Type_Error *type) {
 const P4DataTypeSpec *TypeSpecConverter::convert(const P4::ReferenceMap *refMap,
                                                  P4::TypeMap *typeMap, const IR::Type *type,
                                                  P4TypeInfo *typeInfo) {
+    // The same type is converted once for every table, digest, register, etc.
+    // that mentions it; memoize the result so each distinct type is only
+    // translated once.
+    const IR::Node *cacheNode = type;
+    bool isNameRef = false;
+    if (auto typeName = type->to<IR::Type_Name>()) {
+        cacheNode = refMap->getDeclaration(typeName->path, true)->getNode();
+        isNameRef = true;
+    }
+    auto cacheKey = std::make_tuple(typeInfo, cacheNode, isNameRef);
+    auto cached = convertCache.find(cacheKey);
+    if (cached != convertCache.end()) return cached->second;
+
     TypeSpecConverter typeSpecConverter(refMap, typeMap, typeInfo);
     type->apply(typeSpecConverter);
-    return typeSpecConverter.map.at(type);
+    auto typeSpec = typeSpecConverter.map.at(type);
+    convertCache.emplace(cacheKey, typeSpec);
+    return typeSpec;
 }
 
+void TypeSpecConverter::clearCache() { convertCache.clear(); }
+
 }  // namespace ControlPlaneAPI
 
 }  // namespace P4
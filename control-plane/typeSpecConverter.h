@@ -87,6 +87,10 @@ class TypeSpecConverter : public Inspector {
                                                            P4::TypeMap *typeMap,
                                                            const IR::Type *type,
                                                            ::p4::config::v1::P4TypeInfo *typeInfo);
+
+    /// Drops the memoized convert() results. Must be called whenever the IR
+    /// the cached specs were generated from is discarded or rewritten.
+    static void clearCache();
 };
 
 /// See section "User-defined types" in P4RT specification.
@@ -347,35 +347,35 @@ const IR::Constant *DoConstantFolding::cast(const IR::Constant *node, unsigned b
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Add *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a + b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a + b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::AddSat *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a + b; }, true);
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a + b; }, true);
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Sub *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a - b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a - b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::SubSat *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a - b; }, true);
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a - b; }, true);
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Mul *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a * b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a * b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::BXor *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a ^ b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a ^ b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::BAnd *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a & b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a & b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::BOr *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a | b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a | b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Equ *e) { return compare(e); }
@@ -383,23 +383,23 @@ const IR::Node *DoConstantFolding::postorder(IR::Equ *e) { return compare(e); }
 const IR::Node *DoConstantFolding::postorder(IR::Neq *e) { return compare(e); }
 
 const IR::Node *DoConstantFolding::postorder(IR::Lss *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a < b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a < b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Grt *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a > b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a > b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Leq *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a <= b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a <= b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Geq *e) {
-    return binary(e, [](big_int a, big_int b) -> big_int { return a >= b; });
+    return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a >= b; });
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Div *e) {
-    return binary(e, [e](big_int a, big_int b) -> big_int {
+    return binary(e, [e](const big_int &a, const big_int &b) -> big_int {
         if (a < 0 || b < 0) {
             ::P4::error(ErrorType::ERR_INVALID, "%1%: Division is not defined for negative numbers",
                         e);
@@ -414,7 +414,7 @@ const IR::Node *DoConstantFolding::postorder(IR::Div *e) {
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::Mod *e) {
-    return binary(e, [e](big_int a, big_int b) -> big_int {
+    return binary(e, [e](const big_int &a, const big_int &b) -> big_int {
         if (a < 0 || b < 0) {
             ::P4::error(ErrorType::ERR_INVALID, "%1%: Modulo is not defined for negative numbers",
                         e);
@@ -495,13 +495,51 @@ const IR::Node *DoConstantFolding::compare(const IR::Operation_Binary *e) {
     }
 
     if (eqTest)
-        return binary(e, [](big_int a, big_int b) -> big_int { return a == b; });
+        return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a == b; });
     else
-        return binary(e, [](big_int a, big_int b) -> big_int { return a != b; });
+        return binary(e, [](const big_int &a, const big_int &b) -> big_int { return a != b; });
 }
 
-const IR::Node *DoConstantFolding::binary(const IR::Operation_Binary *e,
-                                          std::function<big_int(big_int, big_int)> func,
+namespace {
+
+/// Evaluation kernel specialized on the operand width for the operator/width
+/// pairs that dominate folding in real programs.  @tparam U is the native
+/// unsigned type of the operands' width, so wrapping the result to the type
+/// width is just integer truncation.  Both operands must already have the
+/// (unsigned) type @p type; returns nullptr for operators the kernel does not
+/// handle.
+template <typename U>
+const IR::Node *foldNative(const IR::Operation_Binary *e, const IR::Constant *left,
+                           const IR::Constant *right, const IR::Type *type) {
+    U l = static_cast<U>(left->value);
+    U r = static_cast<U>(right->value);
+    U result;
+    if (e->is<IR::Add>())
+        result = static_cast<U>(l + r);
+    else if (e->is<IR::Sub>())
+        result = static_cast<U>(l - r);
+    else if (e->is<IR::BAnd>())
+        result = static_cast<U>(l & r);
+    else if (e->is<IR::BOr>())
+        result = static_cast<U>(l | r);
+    else if (e->is<IR::BXor>())
+        result = static_cast<U>(l ^ r);
+    else if (e->is<IR::Mul>())
+        result = static_cast<U>(l * r);
+    else
+        return nullptr;
+    // When the fold leaves an operand's value unchanged reuse its node; x+0
+    // and x&x-style expressions are common in unrolled code, and a fresh
+    // constant per fold adds up.
+    if (result == l) return left;
+    if (result == r) return right;
+    return new IR::Constant(e->srcInfo, type, big_int(result), left->base, true);
+}
+
+}  // namespace
+
+template <class Func>
+const IR::Node *DoConstantFolding::binary(const IR::Operation_Binary *e, Func &&func,
                                           bool saturating) {
     auto eleft = getConstant(e->left);
     auto eright = getConstant(e->right);
@@ -562,6 +600,32 @@ const IR::Node *DoConstantFolding::binary(const IR::Operation_Binary *e,
             right = cast(right, left->base, ltb);
         }
     }
+    // Width-specialized fast paths; operands of a common unsigned native
+    // width are evaluated without big_int temporaries.  The generic path
+    // below handles everything the kernels decline.
+    if (!saturating && !e->is<IR::Operation_Relation>()) {
+        if (auto rt = resultType->to<IR::Type_Bits>(); rt != nullptr && !rt->isSigned) {
+            const IR::Node *fast = nullptr;
+            switch (rt->width_bits()) {
+                case 8:
+                    fast = foldNative<uint8_t>(e, left, right, resultType);
+                    break;
+                case 16:
+                    fast = foldNative<uint16_t>(e, left, right, resultType);
+                    break;
+                case 32:
+                    fast = foldNative<uint32_t>(e, left, right, resultType);
+                    break;
+                case 64:
+                    fast = foldNative<uint64_t>(e, left, right, resultType);
+                    break;
+                default:
+                    break;
+            }
+            if (fast != nullptr) return fast;
+        }
+    }
+
     big_int value = func(left->value, right->value);
     if (saturating) {
         if ((rtb = resultType->to<IR::Type::Bits>())) {
@@ -581,8 +645,12 @@ const IR::Node *DoConstantFolding::binary(const IR::Operation_Binary *e,
 
     if (e->is<IR::Operation_Relation>())
         return new IR::BoolLiteral(e->srcInfo, IR::Type_Boolean::get(), value != 0);
-    else
-        return new IR::Constant(e->srcInfo, resultType, value, left->base, true);
+    // Each branch above leaves the operand types interchangeable with
+    // resultType, so an operand whose value equals the result can be
+    // returned directly instead of copied.
+    if (value == left->value) return left;
+    if (value == right->value) return right;
+    return new IR::Constant(e->srcInfo, resultType, value, left->base, true);
 }
 
 const IR::Node *DoConstantFolding::postorder(IR::LAnd *e) {
@@ -885,6 +953,19 @@ const IR::Node *DoConstantFolding::shift(const IR::Operation_Binary *e) {
     unsigned shift = static_cast<unsigned>(shift_amt->asInt());
     if (overflowWidth(e, shift)) return e;
 
+    // Width-specialized fast path: an in-range shift of an unsigned value of
+    // native width needs no big_int arithmetic.
+    if (const auto *tb = cl->type->to<IR::Type_Bits>()) {
+        if (!tb->isSigned && tb->width_bits() <= 64 &&
+            shift < static_cast<unsigned>(tb->width_bits())) {
+            uint64_t lv = static_cast<uint64_t>(cl->value);
+            uint64_t result = e->is<IR::Shl>() ? lv << shift : lv >> shift;
+            if (tb->width_bits() < 64) result &= (uint64_t(1) << tb->width_bits()) - 1;
+            if (result == lv) return left;
+            return new IR::Constant(e->srcInfo, cl->type, big_int(result), cl->base);
+        }
+    }
+
     if (e->is<IR::Shl>()) {
         value = Util::shift_left(value, shift);
     } else {
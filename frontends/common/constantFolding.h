@@ -90,9 +90,15 @@ class DoConstantFolding : public Transform, public ResolutionContext {
     const IR::Constant *cast(const IR::Constant *node, unsigned base, const IR::Type_Bits *type,
                              bool noWarning = false) const;
 
-    /// Statically evaluate binary operation @p e implemented by @p func.
-    const IR::Node *binary(const IR::Operation_Binary *op,
-                           std::function<big_int(big_int, big_int)> func, bool saturating = false);
+    /// Statically evaluate binary operation @p e implemented by @p func.  The
+    /// functor is dispatched statically (the definition lives in the one
+    /// translation unit with all the callers), so the arithmetic for the
+    /// common small operands inlines down to a few word operations on
+    /// big_int's inline limbs instead of a type-erased call with operand
+    /// copies.  Operands of a common unsigned native width bypass @p func
+    /// altogether and are evaluated by a kernel specialized on the width.
+    template <class Func>
+    const IR::Node *binary(const IR::Operation_Binary *op, Func &&func, bool saturating = false);
     /// Statically evaluate comparison operation @p e.
     /// Note that this only handles the case where @p e represents `==` or `!=`.
     const IR::Node *compare(const IR::Operation_Binary *op);
@@ -0,0 +1,392 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "frontends/common/frontendCache.h"
+
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "frontends/parsers/parserDriver.h"
+#include "ir/ir.h"
+#include "ir/json_generator.h"
+#include "ir/json_loader.h"
+#include "ir/json_parser.h"
+#include "lib/error.h"
+#include "lib/log.h"
+
+namespace P4 {
+
+namespace {
+
+/// 64-bit FNV-1a.  The key must be stable across processes and compiler runs, so we
+/// cannot use Util::Hash (which may be seeded per-process).
+class StableDigest {
+    uint64_t state = 0xcbf29ce484222325ULL;
+
+ public:
+    void add(const void *data, size_t len) {
+        auto *p = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < len; ++i) {
+            state ^= p[i];
+            state *= 0x100000001b3ULL;
+        }
+    }
+    void add(std::string_view s) { add(s.data(), s.size()); }
+    void add(uint64_t v) { add(&v, sizeof(v)); }
+    uint64_t value() const { return state; }
+};
+
+std::filesystem::path entryPath(const std::filesystem::path &cacheDir, const std::string &key) {
+    return cacheDir / (key + ".p4irb");
+}
+
+}  // namespace
+
+std::optional<std::string> FrontendCache::key(const CompilerOptions &options) {
+    auto preprocessorResult = options.preprocess();
+    if (!preprocessorResult) return std::nullopt;
+
+    StableDigest digest;
+    char buffer[16384];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), preprocessorResult->get())) > 0)
+        digest.add(buffer, got);
+
+    // Frontend-relevant options: anything that can change the post-frontend IR.
+    digest.add(uint64_t(options.langVersion));
+    digest.add(options.target ? options.target.string_view() : std::string_view());
+    digest.add(options.arch ? options.arch.string_view() : std::string_view());
+    digest.add(uint64_t(options.ndebug));
+    digest.add(options.compilerVersion ? options.compilerVersion.string_view()
+                                       : std::string_view());
+
+    return absl::StrFormat("%016x", digest.value());
+}
+
+const IR::P4Program *FrontendCache::load(const std::filesystem::path &cacheDir,
+                                         const std::string &key) {
+    std::ifstream in(entryPath(cacheDir, key), std::ios::binary);
+    if (!in) return nullptr;
+    try {
+        JSONLoader loader(in);
+        const IR::Node *node = nullptr;
+        loader >> node;
+        if (auto *program = node ? node->to<IR::P4Program>() : nullptr) {
+            LOG1("frontend cache hit for " << key);
+            return program;
+        }
+    } catch (...) {
+        // A corrupt or stale entry is not an error; fall through to a normal run.
+    }
+    LOG1("ignoring unusable frontend cache entry for " << key);
+    return nullptr;
+}
+
+void FrontendCache::store(const std::filesystem::path &cacheDir, const std::string &key,
+                          const IR::P4Program *program) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (ec) return;
+
+    // Write to a temporary file and rename it into place, so that concurrent compiles
+    // never observe a partially written entry.
+    auto path = entryPath(cacheDir, key);
+    auto tmp = path;
+    tmp += absl::StrFormat(".tmp.%d", getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out) return;
+        std::stringstream ss;
+        JSONGenerator(ss).emit(program);
+        std::unique_ptr<JsonData> doc;
+        ss >> doc;
+        writeBinaryJson(out, doc.get());
+        if (!out) {
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+    LOG1("stored frontend cache entry for " << key);
+}
+
+namespace {
+
+/// A cpp linemarker: '# <line> "<file>" <flags>' (or a plain #line directive).
+struct LineMarker {
+    std::string_view file;
+    bool enter = false;  // flag 1: entering an included file
+    bool exit = false;   // flag 2: returning to the includer
+};
+
+bool parseLineMarker(std::string_view line, LineMarker *marker) {
+    if (line.empty() || line[0] != '#') return false;
+    size_t pos = 1;
+    auto skipBlanks = [&] {
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) pos++;
+    };
+    skipBlanks();
+    if (line.compare(pos, 4, "line") == 0) pos += 4, skipBlanks();
+    if (pos >= line.size() || !isdigit(line[pos])) return false;
+    while (pos < line.size() && isdigit(line[pos])) pos++;
+    skipBlanks();
+    if (pos >= line.size() || line[pos] != '"') return false;
+    size_t fileStart = ++pos;
+    pos = line.find('"', pos);
+    if (pos == std::string_view::npos) return false;
+    marker->file = line.substr(fileStart, pos - fileStart);
+    // The rest of the line holds blank-separated single-digit flags.
+    for (++pos; pos < line.size(); ++pos) {
+        if (line[pos] == '1') marker->enter = true;
+        if (line[pos] == '2') marker->exit = true;
+    }
+    return true;
+}
+
+/// Split the preprocessed @text into the leading run of system-include
+/// sections and the remaining user program.  On success @systemText holds the
+/// concatenated system sections (with their linemarkers, so their own file
+/// names and line numbers survive a standalone parse) and @remainderStart is
+/// the offset of the linemarker that returns to the main file, so the
+/// remainder also parses with correct positions.  Fails if anything other
+/// than blank lines or system includes precedes the first user declaration.
+bool splitSystemPrefix(const std::string &text, std::string &systemText, size_t &remainderStart) {
+    size_t pos = 0;
+    int depth = 0;  // include-nesting depth inside the current system section
+    size_t sectionStart = 0;
+    bool found = false;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        size_t lineEnd = eol == std::string::npos ? text.size() : eol;
+        std::string_view line(text.data() + pos, lineEnd - pos);
+        LineMarker marker;
+        bool isMarker = parseLineMarker(line, &marker);
+        if (depth > 0) {
+            if (isMarker && marker.enter) {
+                depth++;
+            } else if (isMarker && marker.exit && --depth == 0) {
+                systemText.append(text, sectionStart, pos - sectionStart);
+                remainderStart = pos;
+                found = true;
+            }
+        } else if (isMarker) {
+            if (marker.enter) {
+                if (!isSystemFile(cstring(marker.file))) break;
+                depth = 1;
+                sectionStart = pos;
+            }
+            // Plain markers naming the main file are skipped.
+        } else if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+            break;  // the first user declaration
+        }
+        pos = lineEnd == text.size() ? lineEnd : lineEnd + 1;
+    }
+    return found;
+}
+
+/// One compilation unit of a preprocessed program: a half-open range of the
+/// text that is either a top-level include section (@library) or a stretch of
+/// the main file between include sections.
+struct CompilationUnit {
+    size_t start;
+    size_t length;
+    bool library;
+};
+
+/// Split the preprocessed @text into compilation units at top-level include
+/// sections, system or user alike.  Each section keeps its linemarkers, so it
+/// parses standalone with correct positions, and the linemarker returning to
+/// the includer opens the following main-file unit for the same reason.
+std::vector<CompilationUnit> splitUnits(const std::string &text) {
+    std::vector<CompilationUnit> units;
+    size_t pos = 0;
+    size_t segStart = 0;     // start of the current main-file unit
+    size_t sectionStart = 0;  // start of the current include section
+    int depth = 0;            // include-nesting depth inside the current section
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        size_t lineEnd = eol == std::string::npos ? text.size() : eol;
+        std::string_view line(text.data() + pos, lineEnd - pos);
+        LineMarker marker;
+        bool isMarker = parseLineMarker(line, &marker);
+        if (depth > 0) {
+            if (isMarker && marker.enter) {
+                depth++;
+            } else if (isMarker && marker.exit && --depth == 0) {
+                units.push_back({sectionStart, pos - sectionStart, true});
+                segStart = pos;
+            }
+        } else if (isMarker && marker.enter) {
+            if (pos > segStart) units.push_back({segStart, pos - segStart, false});
+            depth = 1;
+            sectionStart = pos;
+        }
+        pos = lineEnd == text.size() ? lineEnd : lineEnd + 1;
+    }
+    if (depth > 0) {
+        // Input ended inside an include section (no return marker); it is
+        // still self-contained text, so treat it as a library unit.
+        units.push_back({sectionStart, text.size() - sectionStart, true});
+    } else if (text.size() > segStart) {
+        units.push_back({segStart, text.size() - segStart, false});
+    }
+    return units;
+}
+
+/// Whether @text holds anything besides blank lines and linemarkers, i.e.
+/// whether handing it to the parser can produce declarations.
+bool hasCode(std::string_view text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        size_t lineEnd = eol == std::string_view::npos ? text.size() : eol;
+        std::string_view line = text.substr(pos, lineEnd - pos);
+        LineMarker marker;
+        if (!parseLineMarker(line, &marker) &&
+            line.find_first_not_of(" \t\r") != std::string_view::npos)
+            return true;
+        pos = lineEnd == text.size() ? lineEnd : lineEnd + 1;
+    }
+    return false;
+}
+
+/// Digest the top-level symbols of @program exactly as the parser's prefix
+/// support declares them (P4ParserDriver::declareProgramSymbols): the lexing
+/// of a subsequent unit depends on these facts and nothing else, so units
+/// preceded by symbol-equal prefixes parse identically.
+void addDeclaredSymbols(StableDigest &digest, const IR::P4Program *program) {
+    auto addName = [&](std::string_view name) {
+        digest.add(uint64_t(name.size()));
+        digest.add(name);
+    };
+    for (const auto *node : program->objects) {
+        if (const auto *ext = node->to<IR::Type_Extern>()) {
+            digest.add("extern");
+            addName(ext->name.name.string_view());
+            for (const auto *method : ext->methods) {
+                addName(method->name.name.string_view());
+                digest.add(uint64_t(!method->type->typeParameters->empty()));
+            }
+            digest.add(uint64_t(!ext->typeParameters->empty()));
+        } else if (const auto *td = node->to<IR::Type_Declaration>()) {
+            digest.add("type");
+            addName(td->name.name.string_view());
+            const auto *generic = node->to<IR::IMayBeGenericType>();
+            digest.add(uint64_t(generic && !generic->getTypeParameters()->empty()));
+        } else if (const auto *method = node->to<IR::Method>()) {
+            digest.add("method");
+            addName(method->name.name.string_view());
+            digest.add(uint64_t(!method->type->typeParameters->empty()));
+        } else if (const auto *decl = node->to<IR::Declaration>()) {
+            digest.add("object");
+            addName(decl->name.name.string_view());
+        }
+    }
+}
+
+}  // namespace
+
+const IR::P4Program *PrecompiledIncludes::parse(const std::filesystem::path &cacheDir, FILE *in,
+                                                std::string_view sourceFile) {
+    std::string text;
+    char buffer[16384];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), in)) > 0) text.append(buffer, got);
+
+    std::string systemText;
+    size_t remainderStart = 0;
+    if (!splitSystemPrefix(text, systemText, remainderStart)) {
+        std::istringstream whole(text);
+        return P4ParserDriver::parse(whole, sourceFile);
+    }
+
+    // The system sections carry absolute paths in their linemarkers, so the
+    // digest is naturally per-installation.
+    StableDigest digest;
+    digest.add(systemText);
+    std::string key = absl::StrFormat("include-%016x", digest.value());
+
+    const IR::P4Program *prefix = FrontendCache::load(cacheDir, key);
+    if (prefix == nullptr) {
+        std::istringstream prefixIn(systemText);
+        prefix = P4ParserDriver::parse(prefixIn, sourceFile);
+        if (prefix == nullptr) return nullptr;
+        if (::P4::errorCount() == 0) FrontendCache::store(cacheDir, key, prefix);
+    }
+
+    std::istringstream rest(text.substr(remainderStart));
+    const IR::P4Program *userPart = P4ParserDriver::parse(rest, sourceFile, prefix);
+    if (userPart == nullptr) return nullptr;
+
+    auto *combined = prefix->clone();
+    combined->objects.append(userPart->objects);
+    return combined;
+}
+
+const IR::P4Program *P4Modules::parse(const std::filesystem::path &moduleDir, FILE *in,
+                                      std::string_view sourceFile) {
+    std::string text;
+    char buffer[16384];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), in)) > 0) text.append(buffer, got);
+
+    IR::P4Program *linked = nullptr;
+    StableDigest environment;  // rolling digest of the symbols declared by linked units
+    for (const auto &unit : splitUnits(text)) {
+        std::string_view unitText(text.data() + unit.start, unit.length);
+        const IR::P4Program *part = nullptr;
+        if (unit.library) {
+            StableDigest digest;
+            digest.add(unitText);
+            digest.add(environment.value());
+            std::string key = absl::StrFormat("module-%016x", digest.value());
+            part = FrontendCache::load(moduleDir, key);
+            if (part == nullptr) {
+                std::istringstream unitIn{std::string(unitText)};
+                part = P4ParserDriver::parse(unitIn, sourceFile, linked);
+                if (part == nullptr) return nullptr;
+                if (::P4::errorCount() == 0) FrontendCache::store(moduleDir, key, part);
+            }
+        } else {
+            if (!hasCode(unitText)) continue;
+            std::istringstream unitIn{std::string(unitText)};
+            part = P4ParserDriver::parse(unitIn, sourceFile, linked);
+            if (part == nullptr) return nullptr;
+        }
+        if (linked == nullptr)
+            linked = part->clone();
+        else
+            linked->objects.append(part->objects);
+        addDeclaredSymbols(environment, part);
+    }
+    if (linked == nullptr) {
+        // No units produced declarations; parse the whole text so that an
+        // empty program still yields a well-formed (empty) P4Program.
+        std::istringstream whole(text);
+        return P4ParserDriver::parse(whole, sourceFile);
+    }
+    return linked;
+}
+
+}  // namespace P4
@@ -0,0 +1,94 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef FRONTENDS_COMMON_FRONTENDCACHE_H_
+#define FRONTENDS_COMMON_FRONTENDCACHE_H_
+
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "frontends/common/options.h"
+
+namespace P4::IR {
+class P4Program;
+}  // namespace P4::IR
+
+namespace P4 {
+
+/// On-disk cache of post-frontend IR, keyed by a digest of the preprocessed source
+/// and the frontend-relevant options.  Changing only backend options produces the
+/// same key, so a driver can skip parsing and the whole frontend on a cache hit.
+/// All failures (unreadable entries, version mismatches, I/O errors) are soft: the
+/// caller falls back to a normal frontend run and overwrites the entry.
+class FrontendCache {
+ public:
+    /// Compute the cache key for @options: a digest of the preprocessor output, the
+    /// language version, target/arch, and the compiler version.  Returns std::nullopt
+    /// if the input cannot be preprocessed (the normal compilation path will report
+    /// the error).
+    static std::optional<std::string> key(const CompilerOptions &options);
+
+    /// @return the cached post-frontend program stored under @key in @cacheDir, or
+    /// nullptr if there is no usable entry.
+    static const IR::P4Program *load(const std::filesystem::path &cacheDir,
+                                     const std::string &key);
+
+    /// Store @program under @key in @cacheDir (creating the directory if needed).
+    static void store(const std::filesystem::path &cacheDir, const std::string &key,
+                      const IR::P4Program *program);
+};
+
+/// Serves the parsed AST of the standard-include prefix of a preprocessed P4-16
+/// program from an on-disk cache.  Preprocessed output starts, for almost every
+/// program, with a run of system include sections (core.p4, the architecture
+/// header) delimited by cpp linemarkers; their text is identical across all
+/// programs compiled against one installation, so their AST is parsed once,
+/// stored in binary form, and spliced in front of each subsequent parse.  The
+/// cached declarations lose source positions, like all serialized IR.
+class PrecompiledIncludes {
+ public:
+    /// Parse the preprocessed input @in, equivalent to P4ParserDriver::parse
+    /// but loading the AST of the leading system-include sections from
+    /// @cacheDir when present and storing it when not.  Inputs that do not
+    /// start with system includes are parsed normally.
+    static const IR::P4Program *parse(const std::filesystem::path &cacheDir, FILE *in,
+                                      std::string_view sourceFile);
+};
+
+/// Generalizes PrecompiledIncludes from the standard-include prefix to every
+/// included file: the preprocessed input is split at cpp linemarkers into
+/// compilation units -- one per top-level include section, system or user --
+/// and each library unit's AST is served from an on-disk module cache, so a
+/// multi-file program tree stitched together via includes re-parses only the
+/// files that changed.  Units are linked back together in include order; each
+/// unit is parsed against the top-level symbols of the units preceding it, and
+/// a unit's cache entry is keyed by its text plus a digest of those symbols,
+/// since they are all that can influence how the unit lexes.  Type checking
+/// remains whole-program: P4 include semantics are textual, so a library's
+/// types cannot be finalized before its consumers are seen.
+class P4Modules {
+ public:
+    /// Parse the preprocessed input @in, equivalent to P4ParserDriver::parse
+    /// but loading the AST of each include section from @moduleDir when a
+    /// matching module is present and storing it when not.
+    static const IR::P4Program *parse(const std::filesystem::path &moduleDir, FILE *in,
+                                      std::string_view sourceFile);
+};
+
+}  // namespace P4
+
+#endif /* FRONTENDS_COMMON_FRONTENDCACHE_H_ */
@@ -16,10 +16,58 @@ limitations under the License.
 
 #include "options.h"
 
+#include <cstdlib>
+#include <fstream>
+
 #include "frontends/p4/frontend.h"
+#include "ir/node.h"
+#include "ir/pass_manager.h"
+#include "lib/heap_profiler.h"
+#include "lib/nullstream.h"
+#include "lib/telemetry.h"
 
 namespace P4 {
 
+/// Destination of the per-pass memory profile requested with --profile-passes. Written from
+/// an atexit handler so every backend gets the report without driver changes.
+static std::filesystem::path passProfileFile;
+
+static void writePassProfile() {
+    auto *out = openFile(passProfileFile, true);
+    if (out != nullptr) PassManager::dumpPassProfile(*out);
+}
+
+/// The sampling heap profiler installed by --heap-profile and the file its pprof profile is
+/// written to at exit; the IR-type/pass summary goes to the same name with ".types" appended.
+static HeapProfiler *heapProfiler = nullptr;
+static std::filesystem::path heapProfileFile;
+
+static void writeHeapProfile() {
+    heapProfiler->stop();
+    if (auto *out = openFile(heapProfileFile, true)) heapProfiler->writeProfile(*out);
+    auto typesFile = heapProfileFile;
+    typesFile += ".types";
+    if (auto *out = openFile(typesFile, true)) heapProfiler->writeSummary(*out);
+}
+
+/// Destination of the telemetry report requested with --telemetry, written from an atexit
+/// handler for the same reason as the pass profile above.
+static std::filesystem::path telemetryFile;
+
+static void writeTelemetry() {
+    auto *out = openFile(telemetryFile, true);
+    if (out != nullptr) Util::Telemetry::dump(*out);
+}
+
+/// Sidecar pass-cost profile requested with --pass-profile: loaded before compilation
+/// when the file already exists, and rewritten with this compile's numbers at exit.
+static std::filesystem::path passCostFile;
+
+static void writePassCosts() {
+    auto *out = openFile(passCostFile, true);
+    if (out != nullptr) PassManager::dumpPassCosts(*out);
+}
+
 CompilerOptions::CompilerOptions(std::string_view defaultMessage) : ParserOptions(defaultMessage) {
     registerOption(
         "--excludeFrontendPasses", "pass1[,pass2]",
@@ -59,6 +107,62 @@ CompilerOptions::CompilerOptions(std::string_view defaultMessage) : ParserOption
             return true;
         },
         "Dump the compiler IR after the midend as JSON in the specified file.");
+    registerOption(
+        "--toJSONBin", "file",
+        [this](const char *arg) {
+            dumpJsonBinFile = arg;
+            return true;
+        },
+        "Dump the compiler IR after the midend in the compact binary JSON encoding\n"
+        "in the specified file; --fromJSON accepts either encoding.");
+    registerOption(
+        "--frontend-cache", "dir",
+        [this](const char *arg) {
+            frontendCacheDir = arg;
+            return true;
+        },
+        "Cache the post-frontend IR in the given directory, keyed by a digest of the\n"
+        "preprocessed source and the frontend-relevant options, and skip the frontend\n"
+        "on a cache hit.");
+    registerOption(
+        "--module-cache", "dir",
+        [this](const char *arg) {
+            moduleCacheDir = arg;
+            return true;
+        },
+        "Treat each included file as a compilation unit whose parsed AST is cached as\n"
+        "a serialized module in the given directory, so multi-file programs re-parse\n"
+        "only the files that changed.");
+    registerOption(
+        "--artifact-cache", "dir",
+        [this](const char *arg) {
+            artifactCacheDir = arg;
+            return true;
+        },
+        "Cache final compilation artifacts in the given directory, keyed by a digest\n"
+        "of the preprocessed source and the complete compile command, so drivers and\n"
+        "test harnesses can skip compilation when an entry matches.");
+    registerOption(
+        "--incremental-typecheck", nullptr,
+        [this](const char *) {
+            incrementalTypeChecking = true;
+            return true;
+        },
+        "Retain type-map entries of unaffected top-level declarations when frontend\n"
+        "passes change the program, instead of re-inferring all types from scratch.");
+    registerOption(
+        "--parallel-typecheck", "threads",
+        [this](const char *arg) {
+            int threads = atoi(arg);
+            if (threads < 1) {
+                ::P4::error(ErrorType::ERR_INVALID, "Invalid thread count %1%", arg);
+                return false;
+            }
+            typeCheckThreads = threads;
+            return true;
+        },
+        "Type-check independent top-level declarations on the given number of\n"
+        "worker threads (1, the default, disables parallelism).");
     registerOption(
         "--ndebug", nullptr,
         [this](const char *) {
@@ -73,6 +177,77 @@ CompilerOptions::CompilerOptions(std::string_view defaultMessage) : ParserOption
             return true;
         },
         "[Compiler debugging] Dump and undump the IR");
+    registerOption(
+        "--profile-passes", "file",
+        [](const char *arg) {
+            passProfileFile = arg;
+            PassManager::enablePassProfiling();
+            static bool atexitRegistered = false;
+            if (!atexitRegistered) {
+                std::atexit(writePassProfile);
+                atexitRegistered = true;
+            }
+            return true;
+        },
+        "Record per-pass GC allocation, GC collection and peak-RSS numbers and "
+        "write them to the\n"
+        "specified file as JSON when the compiler exits. Forces a collection "
+        "around every pass, so\n"
+        "profiled compiles are slow. Requires the garbage collector.");
+    registerOption(
+        "--telemetry", "file",
+        [](const char *arg) {
+            telemetryFile = arg;
+            Util::Telemetry::enable();
+            Util::Telemetry::registerGauge("ir_nodes_allocated", [] {
+                return static_cast<uint64_t>(IR::Node::idsAllocated());
+            });
+            static bool atexitRegistered = false;
+            if (!atexitRegistered) {
+                std::atexit(writeTelemetry);
+                atexitRegistered = true;
+            }
+            return true;
+        },
+        "Record end-to-end compilation telemetry (per-phase spans and counters "
+        "such as passes\n"
+        "run, diagnostics emitted and IR nodes allocated) and write it to the "
+        "specified file as\n"
+        "one JSON document when the compiler exits.");
+    registerOption(
+        "--heap-profile", "file",
+        [](const char *arg) {
+            heapProfileFile = arg;
+            if (heapProfiler == nullptr) {
+                heapProfiler = new HeapProfiler(&PassManager::currentPassName);
+                heapProfiler->start();
+                std::atexit(writeHeapProfile);
+            }
+            return true;
+        },
+        "Sample heap allocations through the garbage collector and write a\n"
+        "pprof-compatible heap profile to the specified file on exit, plus a summary\n"
+        "attributing allocations to IR node types and passes to `file'.types.\n"
+        "Requires the garbage collector.");
+    registerOption(
+        "--pass-profile", "file",
+        [](const char *arg) {
+            passCostFile = arg;
+            std::ifstream in(passCostFile);
+            if (in) PassManager::loadPassCosts(in);
+            PassManager::recordPassCosts();
+            static bool atexitRegistered = false;
+            if (!atexitRegistered) {
+                std::atexit(writePassCosts);
+                atexitRegistered = true;
+            }
+            return true;
+        },
+        "Keep a sidecar profile of per-pass wall-clock costs in the specified file.\n"
+        "An existing profile (e.g. from an earlier compile of the same program) is\n"
+        "loaded first and used to schedule work, such as running the historically\n"
+        "most expensive parallel inspectors first; the file is rewritten with this\n"
+        "compile's numbers on exit.");
     registerOption(
         "--pp", "file",
         [this](const char *arg) {
@@ -57,6 +57,22 @@ class CompilerOptions : public ParserOptions {
     std::vector<cstring> passesToExcludeBackend;
     // Dump a JSON representation of the IR in the file.
     std::filesystem::path dumpJsonFile;
+    // Dump a binary-encoded JSON representation of the IR in the file.
+    std::filesystem::path dumpJsonBinFile;
+    // Directory for the on-disk cache of post-frontend IR; empty disables caching.
+    std::filesystem::path frontendCacheDir;
+    // Directory for the on-disk cache of per-include-section parsed modules; empty
+    // disables the compilation-unit model.
+    std::filesystem::path moduleCacheDir;
+    // Directory for the on-disk cache of final compilation artifacts; empty disables
+    // caching.  Consulted by backend drivers and test harnesses, not by the frontend.
+    std::filesystem::path artifactCacheDir;
+    // If true, type checking retains results for unaffected declarations across
+    // program changes instead of recomputing the whole type map.
+    bool incrementalTypeChecking = false;
+    // Number of worker threads used to type-check independent top-level
+    // declarations; 1 disables parallelism.
+    unsigned typeCheckThreads = 1;
     // Dump and undump the IR tree.
     bool debugJson = false;
     // if this flag is true, compile program in non-debug mode.
@@ -17,11 +17,13 @@ limitations under the License.
 #ifndef FRONTENDS_COMMON_PARSEINPUT_H_
 #define FRONTENDS_COMMON_PARSEINPUT_H_
 
+#include "frontends/common/frontendCache.h"
 #include "frontends/common/options.h"
 #include "frontends/common/parser_options.h"
 #include "frontends/p4-14/fromv1.0/converters.h"
 #include "frontends/parsers/parserDriver.h"
 #include "lib/error.h"
+#include "lib/telemetry.h"
 
 namespace P4::IR {
 class P4Program;
@@ -65,6 +67,7 @@ const IR::P4Program *parseP4File(const ParserOptions &options) {
               "Parsing using options that don't match the current "
               "compiler context");
 
+    Util::Telemetry::Span telemetrySpan("parse");
     const IR::P4Program *result = nullptr;
     if (options.doNotPreprocess) {
         auto *file = fopen(options.file.c_str(), "r");
@@ -81,12 +84,20 @@ const IR::P4Program *parseP4File(const ParserOptions &options) {
         if (!preprocessorResult.has_value()) {
             return nullptr;
         }
-        // Need to assign file here because the parser requires an lvalue.
-        result =
-            options.isv1()
-                ? parseV1Program<FILE *, C>(preprocessorResult.value().get(), options.file.string(),
-                                            1, options.getDebugHook())
-                : P4ParserDriver::parse(preprocessorResult.value().get(), options.file.string());
+        if (options.isv1()) {
+            result = parseV1Program<FILE *, C>(preprocessorResult.value().get(),
+                                               options.file.string(), 1, options.getDebugHook());
+        } else if (auto *compilerOptions = dynamic_cast<const CompilerOptions *>(&options);
+                   compilerOptions && !compilerOptions->moduleCacheDir.empty()) {
+            result = P4Modules::parse(compilerOptions->moduleCacheDir,
+                                      preprocessorResult.value().get(), options.file.string());
+        } else if (compilerOptions && !compilerOptions->frontendCacheDir.empty()) {
+            result = PrecompiledIncludes::parse(compilerOptions->frontendCacheDir,
+                                                preprocessorResult.value().get(),
+                                                options.file.string());
+        } else {
+            result = P4ParserDriver::parse(preprocessorResult.value().get(), options.file.string());
+        }
     }
 
     if (::P4::errorCount() > 0) {
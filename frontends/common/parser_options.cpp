@@ -23,6 +23,7 @@ limitations under the License.
 #include <sys/types.h>
 #include <sys/wait.h>
 
+#include <cstring>
 #include <filesystem>
 #include <memory>
 #include <regex>
@@ -277,6 +278,16 @@ ParserOptions::ParserOptions(std::string_view defaultMessage) : Util::Options(de
         "Report an error for a compiler diagnostic, or treat all warnings as "
         "errors if no diagnostic is specified.",
         OptionFlags::OptionalArgument);
+    registerOption(
+        "--Wlimit", "count",
+        [](const char *arg) {
+            auto limit = strtoul(arg, nullptr, 10);
+            P4CContext::get().errorReporter().setMaxMessagesPerKind(limit);
+            return true;
+        },
+        "Print at most this many info/warning messages per diagnostic kind\n"
+        "(0, the default, prints all of them). Suppressed messages are still\n"
+        "reflected in the warning counts.");
     registerOption(
         "--maxErrorCount", "errorCount",
         [](const char *arg) {
@@ -409,11 +420,43 @@ const char *ParserOptions::getIncludePath() const {
     return path.c_str();
 }
 
+namespace {
+
+/// Closer for inputs opened directly with fopen, bypassing the preprocessor.
+void closeRawFile(FILE *file) {
+    if (file != nullptr) fclose(file);
+}
+
+/// If the input contains no preprocessor directives and no line continuations,
+/// the cpp subprocess is an expensive no-op ('-C' keeps comments, so they reach
+/// the lexer either way) and we can feed the file to the parser directly.
+/// @return the opened file rewound to the start, or nullptr if cpp is needed.
+FILE *openWithoutPreprocessing(const std::filesystem::path &file) {
+    FILE *in = fopen(file.c_str(), "r");
+    if (in == nullptr) return nullptr;
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (memchr(buffer, '#', size) != nullptr || memchr(buffer, '\\', size) != nullptr) {
+            fclose(in);
+            return nullptr;
+        }
+    }
+    rewind(in);
+    return in;
+}
+
+}  // namespace
+
 std::optional<ParserOptions::PreprocessorResult> ParserOptions::preprocess() const {
     FILE *in = nullptr;
 
     if (file == "-") {
         in = stdin;
+    } else if (!doNotCompile && preprocessor_options.isNullOrEmpty() &&
+               (in = openWithoutPreprocessing(file)) != nullptr) {
+        if (Log::verbose()) std::cerr << "Skipping preprocessor for " << file << std::endl;
+        return ParserOptions::PreprocessorResult(in, &closeRawFile);
     } else {
 #ifdef __clang__
         std::string cmd("cc -E -x c -Wno-comment");
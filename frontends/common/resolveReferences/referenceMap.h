@@ -65,22 +65,28 @@ class DeclarationLookup {
 
 /// Class used to encode maps from paths to declarations.
 class ReferenceMap final : public ProgramMap, public NameGenerator, public DeclarationLookup {
+    /// Hash table type backing the reference tables below. Aliased so the container is a
+    /// one-line swap; P4::hvec_map provides the same API (heterogeneous lookup, reserve)
+    /// and can serve here when insertion-ordered iteration is wanted.
+    template <class K, class V>
+    using reference_table_t = absl::flat_hash_map<K, V, Util::Hash>;
+
     /// If `isv1` is true, then the map is for a P4_14 program
     /// (possibly translated into P4_16).
     bool isv1;
 
     /// Maps paths in the program to declarations.
-    absl::flat_hash_map<const IR::Path *, const IR::IDeclaration *, Util::Hash> pathToDeclaration;
+    reference_table_t<const IR::Path *, const IR::IDeclaration *> pathToDeclaration;
 
     /// Set containing all declarations in the program.
     absl::flat_hash_set<const IR::IDeclaration *, Util::Hash> used;
 
     /// Map from `This` to declarations (an experimental feature).
-    absl::flat_hash_map<const IR::This *, const IR::IDeclaration *, Util::Hash> thisToDeclaration;
+    reference_table_t<const IR::This *, const IR::IDeclaration *> thisToDeclaration;
 
     /// All names used in the program. Key is a name, value represents how many times
     /// this name was used as a base for newly generated unique names.
-    absl::flat_hash_map<cstring, int, Util::Hash> usedNames;
+    reference_table_t<cstring, int> usedNames;
 
  public:
     ReferenceMap();
@@ -22,27 +22,40 @@ namespace P4 {
 
 ResolutionContext::ResolutionContext() { anyOrder = P4CContext::get().options().isv1(); }
 
+ResolutionContext::NamespaceIndex &ResolutionContext::namespaceIndex() {
+    // One index per thread: visitors running on type-checking worker threads
+    // must not share lookup tables with the main thread.
+    static thread_local NamespaceIndex index;
+    return index;
+}
+
 const std::vector<const IR::IDeclaration *> &ResolutionContext::memoizeDeclarations(
     const IR::INamespace *ns) const {
-    std::vector<const IR::IDeclaration *> decls;
+    auto *decls = new std::vector<const IR::IDeclaration *>();
     if (const auto *nest = ns->to<IR::INestedNamespace>()) {
         for (const auto *nn : nest->getNestedNamespaces()) {
             auto *nnDecls = nn->getDeclarations();
-            decls.insert(decls.end(), nnDecls->begin(), nnDecls->end());
+            decls->insert(decls->end(), nnDecls->begin(), nnDecls->end());
         }
     }
 
     auto *nsDecls = ns->getDeclarations();
-    decls.insert(decls.end(), nsDecls->begin(), nsDecls->end());
+    decls->insert(decls->end(), nsDecls->begin(), nsDecls->end());
 
-    return (namespaceDecls[ns] = std::move(decls));
+    auto &index = namespaceIndex();
+    index.maybePrune();
+    index.decls[ns] = decls;
+    return *decls;
 }
 
 ResolutionContext::NamespaceDeclsByName &ResolutionContext::memoizeDeclsByName(
     const IR::INamespace *ns) const {
-    auto &namesToDecls = namespaceDeclNames[ns];
-    for (const auto *d : getDeclarations(ns)) namesToDecls[d->getName().name].push_back(d);
-    return namesToDecls;
+    auto *namesToDecls = new NamespaceDeclsByName();
+    for (const auto *d : getDeclarations(ns)) (*namesToDecls)[d->getName().name].push_back(d);
+    auto &index = namespaceIndex();
+    index.maybePrune();
+    index.declNames[ns] = namesToDecls;
+    return *namesToDecls;
 }
 
 std::vector<const IR::IDeclaration *> ResolutionContext::resolve(const IR::ID &name,
@@ -257,6 +270,40 @@ const IR::IDeclaration *ResolutionContext::resolveUnique(const IR::ID &name,
     return nullptr;
 }
 
+const IR::IDeclaration *ResolutionContext::resolveUniqueCached(const IR::Path *path,
+                                                               P4::ResolutionType type,
+                                                               const IR::INamespace *ns) const {
+    if (getChildContext() == nullptr) return resolveUnique(path->name, type, ns);
+
+    ResolutionCacheKey key;
+    key.path = path;
+    key.referent = getOriginal();
+    key.parent = getContext() != nullptr ? getContext()->original : nullptr;
+    const auto *decl = findOrigCtxt<IR::Declaration>();
+    key.enclosingDecl = decl != nullptr ? decl->getNode() : nullptr;
+    const auto *typeDecl = findOrigCtxt<IR::Type_Declaration>();
+    key.enclosingTypeDecl = typeDecl != nullptr ? typeDecl->getNode() : nullptr;
+    key.type = type;
+    key.anyOrder = anyOrder;
+    if (ns != nullptr) {
+        key.scopes.push_back(ns->getNode());
+    } else {
+        const Context *ctxt = nullptr;
+        while (const auto *scope = findOrigCtxt<IR::INamespace>(ctxt))
+            key.scopes.push_back(scope->getNode());
+    }
+
+    auto &index = namespaceIndex();
+    if (auto it = index.resolutions.find(key); it != index.resolutions.end()) return it->second;
+
+    const auto *result = resolveUnique(path->name, type, ns);
+    if (result != nullptr) {
+        index.maybePrune();
+        index.resolutions.emplace(std::move(key), result);
+    }
+    return result;
+}
+
 const IR::IDeclaration *ResolutionContext::getDeclaration(const IR::Path *path,
                                                           bool notNull) const {
     const IR::IDeclaration *result = nullptr;
@@ -280,7 +327,7 @@ const IR::IDeclaration *ResolutionContext::getDeclaration(const IR::Path *path,
         const IR::INamespace *ns = nullptr;
         if (path->absolute) ns = findOrigCtxt<IR::P4Program>();
 
-        result = resolveUnique(path->name, rtype, ns);
+        result = resolveUniqueCached(path, rtype, ns);
     }
     if (notNull) BUG_CHECK(result != nullptr, "Cannot find declaration for %1%", path);
     return result;
@@ -314,7 +361,7 @@ const IR::IDeclaration *ResolutionContext::resolvePath(const IR::Path *path, boo
     const IR::INamespace *ctxt = nullptr;
     if (path->absolute) ctxt = findOrigCtxt<IR::P4Program>();
     ResolutionType k = isType ? ResolutionType::Type : ResolutionType::Any;
-    return resolveUnique(path->name, k, ctxt);
+    return resolveUniqueCached(path, k, ctxt);
 }
 
 const IR::IDeclaration *ResolveReferences::resolvePath(const IR::Path *path, bool isType) const {
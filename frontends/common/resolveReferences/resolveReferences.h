@@ -46,11 +46,73 @@ class ResolutionContext : virtual public Visitor, public DeclarationLookup {
     // future lookups.
     NamespaceDeclsByName &memoizeDeclsByName(const IR::INamespace *ns) const;
 
-    mutable absl::flat_hash_map<const IR::INamespace *, std::vector<const IR::IDeclaration *>,
-                                Util::Hash>
-        namespaceDecls;
-    mutable absl::flat_hash_map<const IR::INamespace *, NamespaceDeclsByName, Util::Hash>
-        namespaceDeclNames;
+    /// Key for a memoized path resolution: everything a resolution reads.  The path
+    /// covers the name and its source position (the use-before-declaration filter), the
+    /// referring node and its parent cover overload selection at call sites, the
+    /// enclosing declarations cover the self-reference checks, and the scope chain
+    /// covers every namespace the lookup may consult.  All components are immutable IR
+    /// nodes, so an entry can never go stale: any rewrite that could affect the
+    /// resolution rebuilds at least one node on this list.
+    struct ResolutionCacheKey {
+        const IR::Path *path;
+        const IR::Node *referent;
+        const IR::Node *parent;
+        const IR::Node *enclosingDecl;
+        const IR::Node *enclosingTypeDecl;
+        absl::InlinedVector<const IR::Node *, 8> scopes;
+        ResolutionType type;
+        bool anyOrder;
+
+        bool operator==(const ResolutionCacheKey &other) const {
+            return path == other.path && referent == other.referent && parent == other.parent &&
+                   enclosingDecl == other.enclosingDecl &&
+                   enclosingTypeDecl == other.enclosingTypeDecl && type == other.type &&
+                   anyOrder == other.anyOrder && scopes == other.scopes;
+        }
+        template <typename H>
+        friend H AbslHashValue(H h, const ResolutionCacheKey &key) {
+            return H::combine(std::move(h), key.path, key.referent, key.parent,
+                              key.enclosingDecl, key.enclosingTypeDecl, key.scopes, key.type,
+                              key.anyOrder);
+        }
+    };
+
+    /// Per-thread index of namespace contents, shared by all ResolutionContext
+    /// instances and kept alive across passes.  IR nodes are immutable, so an
+    /// entry keyed by a namespace node can never go stale: a rewrite that
+    /// changes a scope produces a new node and therefore a fresh entry, while
+    /// untouched scopes keep their lookup tables from earlier passes.  The
+    /// values are allocated on the GC heap so that pruning the index never
+    /// invalidates ranges handed out to in-flight lookups.
+    struct NamespaceIndex {
+        absl::flat_hash_map<const IR::INamespace *, const std::vector<const IR::IDeclaration *> *,
+                            Util::Hash>
+            decls;
+        absl::flat_hash_map<const IR::INamespace *, NamespaceDeclsByName *, Util::Hash> declNames;
+        /// Memoized results of successful path resolutions, so passes that look up a
+        /// declaration per PathExpression skip the scope walk when nothing relevant to
+        /// that reference has been rewritten since the last resolution.
+        absl::flat_hash_map<ResolutionCacheKey, const IR::IDeclaration *> resolutions;
+        /// Entries pin their key nodes in the GC heap, so drop the whole index
+        /// once it has seen this many scopes; otherwise a long pass pipeline
+        /// would retain arbitrarily many superseded program versions.
+        static constexpr size_t pruneThreshold = 1 << 16;
+        void maybePrune() {
+            if (decls.size() >= pruneThreshold || declNames.size() >= pruneThreshold ||
+                resolutions.size() >= pruneThreshold) {
+                decls.clear();
+                declNames.clear();
+                resolutions.clear();
+            }
+        }
+    };
+    static NamespaceIndex &namespaceIndex();
+
+    /// Resolve @p path like resolveUnique, but memoize successful resolutions in the
+    /// per-thread index; failures and ambiguities are not cached so their diagnostics
+    /// are reported by every pass that encounters them.
+    const IR::IDeclaration *resolveUniqueCached(const IR::Path *path, ResolutionType type,
+                                                const IR::INamespace *ns) const;
 
  protected:
     // Note that all errors have been merged by the parser into
@@ -96,16 +158,17 @@ class ResolutionContext : virtual public Visitor, public DeclarationLookup {
 
     /// Returns the set of decls that exist in the given namespace.
     auto getDeclarations(const IR::INamespace *ns) const {
-        auto nsIt = namespaceDecls.find(ns);
-        const auto &decls = nsIt != namespaceDecls.end() ? nsIt->second : memoizeDeclarations(ns);
+        const auto &index = namespaceIndex().decls;
+        auto nsIt = index.find(ns);
+        const auto &decls = nsIt != index.end() ? *nsIt->second : memoizeDeclarations(ns);
         return Util::iterator_range(decls);
     }
 
     /// Returns the set of decls with the given name that exist in the given namespace.
     auto getDeclsByName(const IR::INamespace *ns, cstring name) const {
-        auto nsIt = namespaceDeclNames.find(ns);
-        const auto &namesToDecls =
-            nsIt != namespaceDeclNames.end() ? nsIt->second : memoizeDeclsByName(ns);
+        const auto &index = namespaceIndex().declNames;
+        auto nsIt = index.find(ns);
+        const auto &namesToDecls = nsIt != index.end() ? *nsIt->second : memoizeDeclsByName(ns);
 
         auto decls = namesToDecls.find(name);
         if (decls == namesToDecls.end())
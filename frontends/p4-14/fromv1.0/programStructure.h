@@ -18,6 +18,7 @@ limitations under the License.
 #define FRONTENDS_P4_14_FROMV1_0_PROGRAMSTRUCTURE_H_
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "frontends/p4/callGraph.h"
@@ -53,8 +54,12 @@ class ProgramStructure {
         // Key is a name, value represents how many times this name was used as a base
         // for newly generated unique names.
         std::unordered_map<cstring, int> *allNames;
+        // Iterated when emitting the converted program, so it must stay ordered by name.
+        // Lookups go through the hashed indexes below instead: conversion performs one
+        // for nearly every reference, and interned cstrings hash by address.
         std::map<cstring, T> nameToObject;
-        std::map<T, cstring> objectToNewName;
+        std::unordered_map<cstring, T> nameIndex;
+        std::unordered_map<T, cstring> objectToNewName;
 
         // Iterate in order of name, but return pair<T, newname>
         class iterator {
@@ -62,9 +67,9 @@ class ProgramStructure {
 
          private:
             typename std::map<cstring, T>::iterator it;
-            typename std::map<T, cstring> &objToName;
+            typename std::unordered_map<T, cstring> &objToName;
             iterator(typename std::map<cstring, T>::iterator it,
-                     typename std::map<T, cstring> &objToName)
+                     typename std::unordered_map<T, cstring> &objToName)
                 : it(it), objToName(objToName) {}
 
          public:
@@ -88,6 +93,7 @@ class ProgramStructure {
             }
 
             nameToObject.emplace(obj->name, obj);
+            nameIndex.emplace(obj->name, obj);
             cstring newName;
 
             if (allNames == nullptr || (allNames->find(obj->name) == allNames->end())) {
@@ -100,14 +106,14 @@ class ProgramStructure {
             objectToNewName.emplace(obj, newName);
         }
         /// Lookup using the original name
-        T get(cstring name) const { return ::P4::get(nameToObject, name); }
+        T get(cstring name) const { return ::P4::get(nameIndex, name); }
         /// Get the new name
         cstring get(T object) const {
             return ::P4::get(objectToNewName, object, object->name.name);
         }
         /// Get the new name from the old name
         cstring newname(cstring name) const { return get(get(name)); }
-        bool contains(cstring name) const { return nameToObject.find(name) != nameToObject.end(); }
+        bool contains(cstring name) const { return nameIndex.find(name) != nameIndex.end(); }
         iterator begin() { return iterator(nameToObject.begin(), objectToNewName); }
         iterator end() { return iterator(nameToObject.end(), objectToNewName); }
         void erase(cstring name) {
@@ -115,6 +121,7 @@ class ProgramStructure {
             auto obj = get(name);
             objectToNewName.erase(obj);
             nameToObject.erase(name);
+            nameIndex.erase(name);
         }
     };
 
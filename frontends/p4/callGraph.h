@@ -18,6 +18,8 @@ limitations under the License.
 #define FRONTENDS_P4_CALLGRAPH_H_
 
 #include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -44,6 +46,40 @@ class CallGraph {
     // Use an ordered map to make this deterministic
     ordered_map<T, std::vector<T> *> out_edges;  // map caller to list of callees
     ordered_map<T, std::vector<T> *> in_edges;
+    // Memoized results of reachable(): start node -> all nodes reachable from
+    // it.  Mutations invalidate only the entries they can actually affect:
+    // removing a node discards the sets that contain it, and adding an edge
+    // discards the sets that contain the caller.  Entries not mentioning the
+    // changed node stay valid, so repeated reachability queries interleaved
+    // with removals (e.g. successive parser simplification rounds) do not pay
+    // for a full re-traversal each time.
+    mutable std::map<T, std::set<T>> reachableCache;
+
+    /// Drop memoized reachability results that mention @p node.
+    void invalidateReachable(T node) const {
+        for (auto it = reachableCache.begin(); it != reachableCache.end();) {
+            if (it->second.find(node) != it->second.end())
+                it = reachableCache.erase(it);
+            else
+                ++it;
+        }
+    }
+    /// Drop memoized reachability results that mention any node in @p dirty.
+    void invalidateReachable(const std::set<T> &dirty) const {
+        for (auto it = reachableCache.begin(); it != reachableCache.end();) {
+            bool stale = false;
+            for (auto n : dirty) {
+                if (it->second.find(n) != it->second.end()) {
+                    stale = true;
+                    break;
+                }
+            }
+            if (stale)
+                it = reachableCache.erase(it);
+            else
+                ++it;
+        }
+    }
 
  public:
     ordered_set<T> nodes;  // all nodes; do not modify this directly
@@ -85,10 +121,13 @@ class CallGraph {
         add(callee);
         out_edges[caller]->push_back(callee);
         in_edges[callee]->push_back(caller);
+        // The new edge extends the reachable set of every node that reaches the caller.
+        invalidateReachable(caller);
     }
     void remove(T node) {
         auto n = nodes.find(node);
         BUG_CHECK(n != nodes.end(), "%1%: Node not in graph", node);
+        invalidateReachable(node);
         nodes.erase(n);
         auto in = in_edges.find(node);
         if (in != in_edges.end()) {
@@ -134,26 +173,51 @@ class CallGraph {
     void getCallees(T caller, std::set<T> &toAppend) {
         if (isCaller(caller)) toAppend.insert(out_edges[caller]->begin(), out_edges[caller]->end());
     }
-    // out will contain all nodes reachable from start
+    // out will contain all nodes reachable from start.  The result is
+    // memoized, so asking again for the same start node is a lookup unless an
+    // intervening mutation could have changed the answer.
     void reachable(T start, std::set<T> &out) const {
+        auto cached = reachableCache.find(start);
+        if (cached != reachableCache.end()) {
+            out.insert(cached->second.begin(), cached->second.end());
+            return;
+        }
+        std::set<T> result;
         std::set<T> work;
         work.emplace(start);
         while (!work.empty()) {
             T node = *work.begin();
             work.erase(node);
-            if (out.find(node) != out.end()) continue;
-            out.emplace(node);
+            if (result.find(node) != result.end()) continue;
+            result.emplace(node);
             auto edges = out_edges.find(node);
             if (edges == out_edges.end()) continue;
             for (auto c : *(edges->second)) work.emplace(c);
         }
+        out.insert(result.begin(), result.end());
+        reachableCache.emplace(start, std::move(result));
     }
     // remove all nodes not in 'to'
     void restrict(const std::set<T> &to) {
-        std::vector<T> toRemove;
+        std::set<T> removed;
         for (auto n : nodes)
-            if (to.find(n) == to.end()) toRemove.push_back(n);
-        for (auto n : toRemove) remove(n);
+            if (to.find(n) == to.end()) removed.emplace(n);
+        if (removed.empty()) return;
+        // Filter the removed nodes out in bulk: deleting them one by one with
+        // remove() would rescan each neighbor's edge vector per deletion.
+        for (auto n : removed) {
+            nodes.erase(n);
+            out_edges.erase(n);
+            in_edges.erase(n);
+        }
+        auto filter = [&removed](std::vector<T> *edges) {
+            edges->erase(std::remove_if(edges->begin(), edges->end(),
+                                        [&removed](T e) { return removed.count(e) != 0; }),
+                         edges->end());
+        };
+        for (auto &e : out_edges) filter(e.second);
+        for (auto &e : in_edges) filter(e.second);
+        invalidateReachable(removed);
     }
 
     using Set = std::unordered_set<T>;
@@ -368,6 +432,165 @@ class CallGraph {
         }
         return cycles;
     }
+
+    /// An immutable compiled form of a call-graph: the adjacency lists are
+    /// flattened into contiguous arrays indexed by a dense node numbering, and
+    /// the strongly-connected components and the topological order are computed
+    /// once at construction time.  Build it with compile() after the graph is
+    /// fully constructed and use it for the queries; it is a snapshot, so
+    /// add/calls/remove on the original graph are not reflected in it.
+    class Compiled {
+        std::vector<T> nodeOf;                    // dense index -> node
+        std::unordered_map<T, uint32_t> indexOf;  // node -> dense index
+        // Out-edges of node i are edgeTargets[firstEdge[i] .. firstEdge[i+1])
+        std::vector<uint32_t> firstEdge;
+        std::vector<uint32_t> edgeTargets;
+        std::vector<uint32_t> inDegree;
+        std::vector<uint32_t> sccOf;  // dense index -> component number
+        std::vector<T> order;         // all nodes in scc/topological order
+        bool cyclic = false;
+
+        // Iterative version of strongConnect over the flattened arrays; computes
+        // 'sccOf', 'order' and 'cyclic'.  Produces the same order as sort() on
+        // the source graph, but does not recurse, so it cannot overflow the
+        // stack on deep graphs.
+        void computeSccs() {
+            uint32_t size = nodeOf.size();
+            constexpr uint32_t unvisited = ~0U;
+            std::vector<uint32_t> index(size, unvisited);
+            std::vector<uint32_t> lowlink(size, 0);
+            std::vector<bool> onStack(size, false);
+            std::vector<uint32_t> stack;
+            struct Frame {
+                uint32_t node;
+                uint32_t nextEdge;
+            };
+            std::vector<Frame> frames;
+            uint32_t crtIndex = 0;
+            uint32_t sccCount = 0;
+            sccOf.assign(size, 0);
+            order.reserve(size);
+            for (uint32_t root = 0; root < size; root++) {
+                if (index[root] != unvisited) continue;
+                index[root] = lowlink[root] = crtIndex++;
+                stack.push_back(root);
+                onStack[root] = true;
+                frames.push_back({root, firstEdge[root]});
+                while (!frames.empty()) {
+                    auto &frame = frames.back();
+                    uint32_t node = frame.node;
+                    if (frame.nextEdge < firstEdge[node + 1]) {
+                        uint32_t next = edgeTargets[frame.nextEdge++];
+                        if (index[next] == unvisited) {
+                            index[next] = lowlink[next] = crtIndex++;
+                            stack.push_back(next);
+                            onStack[next] = true;
+                            frames.push_back({next, firstEdge[next]});
+                        } else if (onStack[next]) {
+                            lowlink[node] = std::min(lowlink[node], lowlink[next]);
+                            if (next == node)
+                                // popping the component does not find self-loops
+                                cyclic = true;
+                        }
+                    } else {
+                        if (lowlink[node] == index[node]) {
+                            uint32_t members = 0;
+                            while (true) {
+                                uint32_t member = stack.back();
+                                stack.pop_back();
+                                onStack[member] = false;
+                                sccOf[member] = sccCount;
+                                order.push_back(nodeOf[member]);
+                                members++;
+                                if (member == node) break;
+                            }
+                            sccCount++;
+                            if (members > 1) cyclic = true;
+                        }
+                        frames.pop_back();
+                        if (!frames.empty()) {
+                            uint32_t caller = frames.back().node;
+                            lowlink[caller] = std::min(lowlink[caller], lowlink[node]);
+                        }
+                    }
+                }
+            }
+        }
+
+     public:
+        explicit Compiled(const CallGraph &cg) {
+            uint32_t size = cg.nodes.size();
+            nodeOf.reserve(size);
+            indexOf.reserve(size);
+            for (auto n : cg.nodes) {
+                indexOf.emplace(n, nodeOf.size());
+                nodeOf.push_back(n);
+            }
+            firstEdge.assign(size + 1, 0);
+            inDegree.assign(size, 0);
+            for (uint32_t i = 0; i < size; i++) {
+                auto oe = ::P4::get(cg.out_edges, nodeOf[i]);
+                firstEdge[i + 1] = firstEdge[i] + (oe != nullptr ? oe->size() : 0);
+                auto ie = ::P4::get(cg.in_edges, nodeOf[i]);
+                inDegree[i] = ie != nullptr ? ie->size() : 0;
+            }
+            edgeTargets.reserve(firstEdge[size]);
+            for (uint32_t i = 0; i < size; i++) {
+                auto oe = ::P4::get(cg.out_edges, nodeOf[i]);
+                if (oe == nullptr) continue;
+                for (auto callee : *oe) edgeTargets.push_back(indexOf.at(callee));
+            }
+            computeSccs();
+        }
+
+        size_t size() const { return nodeOf.size(); }
+        /// All nodes in the order produced by sort() on the source graph:
+        /// callees precede their callers and the members of a
+        /// strongly-connected component are consecutive.
+        const std::vector<T> &sccOrder() const { return order; }
+        /// True if the source graph contained at least one cycle.
+        bool hasCycles() const { return cyclic; }
+        /// True if @p a and @p b belong to the same strongly-connected
+        /// component; both must be nodes of the source graph.
+        bool inSameScc(T a, T b) const {
+            return sccOf.at(indexOf.at(a)) == sccOf.at(indexOf.at(b));
+        }
+        bool isCallee(T callee) const {
+            auto it = indexOf.find(callee);
+            return it != indexOf.end() && inDegree[it->second] != 0;
+        }
+        bool isCaller(T caller) const {
+            auto it = indexOf.find(caller);
+            return it != indexOf.end() && firstEdge[it->second + 1] != firstEdge[it->second];
+        }
+        // out will contain all nodes reachable from start
+        void reachable(T start, std::set<T> &out) const {
+            auto it = indexOf.find(start);
+            if (it == indexOf.end()) {
+                // mirror CallGraph::reachable: a start outside the graph only reaches itself
+                out.emplace(start);
+                return;
+            }
+            std::vector<bool> seen(nodeOf.size(), false);
+            std::vector<uint32_t> work = {it->second};
+            seen[it->second] = true;
+            while (!work.empty()) {
+                uint32_t node = work.back();
+                work.pop_back();
+                out.emplace(nodeOf[node]);
+                for (uint32_t e = firstEdge[node]; e < firstEdge[node + 1]; e++) {
+                    uint32_t next = edgeTargets[e];
+                    if (!seen[next]) {
+                        seen[next] = true;
+                        work.push_back(next);
+                    }
+                }
+            }
+        }
+    };
+
+    /// Freeze the current contents of the graph into a Compiled snapshot.
+    const Compiled *compile() const { return new Compiled(*this); }
 };
 
 }  // namespace P4
@@ -100,9 +100,9 @@ class SimpleInlineList {
         P4::CallGraph<const Callable *> cg("Call-graph");
         for (auto c : toInline) cg.calls(c->caller, c->callee);
 
-        // must inline from leaves up
-        std::vector<const Callable *> order;
-        cg.sort(order);
+        // must inline from leaves up; the graph is complete here, so query
+        // its compiled form
+        const std::vector<const Callable *> &order = cg.compile()->sccOrder();
         for (auto c : order) {
             // This is quadratic, but hopefully the call graph is not too large
             for (auto ci : toInline) {
@@ -16,6 +16,9 @@ limitations under the License.
 
 #include "def_use.h"
 
+#include <algorithm>
+#include <type_traits>
+
 #include "absl/strings/str_cat.h"
 #include "frontends/p4/methodInstance.h"
 #include "frontends/p4/tableApply.h"
@@ -37,7 +40,9 @@ unsigned StorageLocation::crtid = 0;
 
 template <class T>
 T *StorageFactory::construct(const IR::Type *type, cstring name) const {
-    return storageLocations.emplace_back(new T(type, name)).get()->template to<T>();
+    T *result = storageLocations.emplace_back(new T(type, name)).get()->template to<T>();
+    if constexpr (std::is_base_of_v<BaseLocation, T>) result->setIndex(nextBaseIndex++);
+    return result;
 }
 
 StorageLocation *StorageFactory::create(const IR::Type *type, cstring name) const {
@@ -328,23 +333,18 @@ bool ProgramPoints::operator==(const ProgramPoints &other) const {
 
 Definitions *Definitions::joinDefinitions(const Definitions *other) const {
     auto result = new Definitions();
-    for (auto d : other->definitions) {
-        auto loc = d.first;
-        auto defs = d.second;
-        auto current = ::P4::get(definitions, loc);
-        if (current != nullptr) {
-            auto merged = current->merge(defs);
-            result->definitions.emplace(loc, merged);
-        } else {
-            result->definitions.emplace(loc, defs);
-        }
-    }
-    for (auto d : definitions) {
-        auto loc = d.first;
-        auto defs = d.second;
-        auto current = ::P4::get(other->definitions, loc);
-        if (current == nullptr) result->definitions.emplace(loc, defs);
-        // otherwise have have already done it in the loop above
+    result->present = present | other->present;
+    result->slots.resize(std::max(slots.size(), other->slots.size()));
+    // The location universe is split word-parallel: slots defined on only one
+    // side are copied; only shared locations merge their program points.
+    bitvec common = present & other->present;
+    for (int index : present - common) result->slots[index] = slots[index];
+    for (int index : other->present - common) result->slots[index] = other->slots[index];
+    for (int index : common) {
+        const auto *mine = slots[index].second;
+        const auto *theirs = other->slots[index].second;
+        result->slots[index] = {slots[index].first,
+                                mine == theirs ? mine : mine->merge(theirs)};
     }
     if (unreachable && other->unreachable) result->setUnreachable();
     return result;
@@ -356,15 +356,14 @@ void Definitions::setDefinition(const StorageLocation *location, const ProgramPo
 }
 
 void Definitions::setDefinition(const LocationSet &locations, const ProgramPoints *point) {
-    for (const auto *sl : locations.canonical()) definitions[sl->to<BaseLocation>()] = point;
+    for (const auto *sl : locations.canonical()) setDefintion(sl->to<BaseLocation>(), point);
 }
 
 void Definitions::removeLocation(const StorageLocation *location) {
     LocationSet locset(location);
     for (const auto *sl : locset.canonical()) {
-        auto bl = sl->to<BaseLocation>();
-        auto it = definitions.find(bl);
-        if (it != definitions.end()) definitions.erase(it);
+        const auto *bl = sl->to<BaseLocation>();
+        if (hasLocation(bl)) present.clrbit(bl->index());
     }
 }
 
@@ -380,16 +379,16 @@ const ProgramPoints *Definitions::getPoints(const LocationSet &locations) const
 Definitions *Definitions::writes(ProgramPoint point, const LocationSet &locations) const {
     auto result = new Definitions(*this);
     auto points = new ProgramPoints(point);
-    for (auto l : locations.canonical()) result->setDefinition(l->to<BaseLocation>(), points);
+    for (auto l : locations.canonical()) result->setDefintion(l->to<BaseLocation>(), points);
     return result;
 }
 
 bool Definitions::operator==(const Definitions &other) const {
-    if (definitions.size() != other.definitions.size()) return false;
-    for (auto d : definitions) {
-        auto od = ::P4::get(other.definitions, d.first);
-        if (od == nullptr) return false;
-        if (!d.second->operator==(*od)) return false;
+    if (present != other.present) return false;
+    for (int index : present) {
+        const auto *mine = slots[index].second;
+        const auto *theirs = other.slots[index].second;
+        if (mine != theirs && !mine->operator==(*theirs)) return false;
     }
     return true;
 }
@@ -23,6 +23,7 @@ limitations under the License.
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "ir/ir.h"
 #include "lib/alloc_trace.h"
+#include "lib/bitvec.h"
 #include "lib/flat_map.h"
 #include "lib/hash.h"
 #include "lib/hvec_map.h"
@@ -98,7 +99,15 @@ class StorageLocation : public IHasDbPrint, public ICastable {
 /** Represents a storage location with a simple type or a tuple type.
     It could be either a scalar variable, or a field of a struct, etc. */
 class BaseLocation : public StorageLocation {
+    /// Dense per-factory number, assigned at creation; keys the bitvec-backed
+    /// definition sets in Definitions.
+    unsigned idx = 0;
+    void setIndex(unsigned i) { idx = i; }
+    friend class StorageFactory;
+
  public:
+    unsigned index() const { return idx; }
+
     BaseLocation(const IR::Type *type, cstring name) : StorageLocation(type, name) {
         if (auto tt = type->to<IR::Type_Tuple>())
             BUG_CHECK(tt->getSize() == 0, "%1%: tuples with fields are not base locations", tt);
@@ -235,6 +244,8 @@ class ArrayLocation : public IndexedLocation {
 class StorageFactory {
     // FIXME: Allocate StorageLocations from an arena, not global allocator
     mutable std::vector<std::unique_ptr<StorageLocation>> storageLocations;
+    /// Next dense index to hand out to a BaseLocation.
+    mutable unsigned nextBaseIndex = 0;
 
     template <class T>
     T *construct(const IR::Type *type, cstring name) const;
@@ -247,6 +258,31 @@ class StorageFactory {
     static const cstring validFieldName;
 };
 
+/// Reuses storage location graphs across repeated def-use analyses of the same object
+/// within one compile.  The declarations of a control rarely change between
+/// SimplifyDefUse rounds, so a location is rebuilt only when a declaration (or the type
+/// computed for it) differs from what was cached; the cache owns the factory, and
+/// thereby every location it handed out, keeping cached graphs alive across runs.
+class StorageCache {
+    StorageFactory factory;
+    struct CacheEntry {
+        const IR::Type *type;
+        const StorageLocation *location;
+    };
+    hvec_map<const IR::IDeclaration *, CacheEntry> cache;
+
+ public:
+    const StorageLocation *getOrCreate(const IR::IDeclaration *decl, const IR::Type *type,
+                                       cstring name) {
+        auto [it, inserted] = cache.emplace(decl, CacheEntry{type, nullptr});
+        if (inserted || it->second.type != type) {
+            it->second.type = type;
+            it->second.location = factory.create(type, name);
+        }
+        return it->second.location;
+    }
+};
+
 /// A set of locations that may be read or written by a computation.
 /// In general this is a conservative approximation of the actual location set.
 class LocationSet : public IHasDbPrint {
@@ -358,19 +394,24 @@ class StorageMap : public IHasDbPrint {
     /// Storage location for each declaration.
     hvec_map<const IR::IDeclaration *, const StorageLocation *> storage;
     StorageFactory factory;
+    /// If non-null, locations are obtained from (and owned by) this cache instead of
+    /// the private factory, so repeated analyses reuse the same graphs.
+    StorageCache *cache = nullptr;
 
  public:
     ReferenceMap *refMap;
     TypeMap *typeMap;
 
-    StorageMap(ReferenceMap *refMap, TypeMap *typeMap) : refMap(refMap), typeMap(typeMap) {
+    StorageMap(ReferenceMap *refMap, TypeMap *typeMap, StorageCache *cache = nullptr)
+        : cache(cache), refMap(refMap), typeMap(typeMap) {
         CHECK_NULL(refMap);
         CHECK_NULL(typeMap);
     }
     const StorageLocation *add(const IR::IDeclaration *decl) {
         CHECK_NULL(decl);
         auto type = typeMap->getType(decl->getNode(), true);
-        auto loc = factory.create(type, decl->getName() + "/" + decl->externalName());
+        cstring name = decl->getName() + "/" + decl->externalName();
+        const auto *loc = cache ? cache->getOrCreate(decl, type, name) : factory.create(type, name);
         if (loc != nullptr) storage.emplace(decl, loc);
         return loc;
     }
@@ -498,23 +539,30 @@ class ProgramPoints : public IHasDbPrint {
 
 /// List of definers for each base storage (at a specific program point).
 class Definitions : public IHasDbPrint {
+    /// Which locations have definitions, indexed by BaseLocation::index();
+    /// joins and comparisons use this bitset, so set algebra on the location
+    /// universe is word-parallel.
+    bitvec present;
     /// Set of program points that have written last to each location
-    /// (conservative approximation).
-    hvec_map<const BaseLocation *, const ProgramPoints *> definitions;
+    /// (conservative approximation), indexed by BaseLocation::index().
+    /// Slots whose bit in `present` is clear are unused.
+    std::vector<std::pair<const BaseLocation *, const ProgramPoints *>> slots;
     /// If true the current program point is actually unreachable.
     bool unreachable = false;
 
  public:
     Definitions() = default;
     Definitions(const Definitions &other)
-        : definitions(other.definitions), unreachable(other.unreachable) {}
+        : present(other.present), slots(other.slots), unreachable(other.unreachable) {}
     Definitions *joinDefinitions(const Definitions *other) const;
     /// Point writes the specified LocationSet.
     Definitions *writes(ProgramPoint point, const LocationSet &locations) const;
     void setDefintion(const BaseLocation *loc, const ProgramPoints *point) {
         CHECK_NULL(loc);
         CHECK_NULL(point);
-        definitions[loc] = point;
+        if (slots.size() <= loc->index()) slots.resize(loc->index() + 1);
+        slots[loc->index()] = {loc, point};
+        present.setbit(loc->index());
     }
     void setDefinition(const StorageLocation *loc, const ProgramPoints *point);
     void setDefinition(const LocationSet &loc, const ProgramPoints *point);
@@ -524,12 +572,11 @@ class Definitions : public IHasDbPrint {
     }
     bool isUnreachable() const { return unreachable; }
     bool hasLocation(const BaseLocation *location) const {
-        return definitions.find(location) != definitions.end();
+        return location != nullptr && present.getbit(location->index());
     }
     const ProgramPoints *getPoints(const BaseLocation *location) const {
-        auto r = ::P4::get(definitions, location);
-        BUG_CHECK(r != nullptr, "no definitions found for %1%", location);
-        return r;
+        BUG_CHECK(hasLocation(location), "no definitions found for %1%", location);
+        return slots[location->index()].second;
     }
     const ProgramPoints *getPoints(const LocationSet &locations) const;
     bool operator==(const Definitions &other) const;
@@ -537,18 +584,18 @@ class Definitions : public IHasDbPrint {
         if (unreachable) {
             out << "  Unreachable" << Log::endl;
         }
-        if (definitions.empty()) out << "  Empty definitions";
+        if (present.empty()) out << "  Empty definitions";
         bool first = true;
-        for (auto d : definitions) {
+        for (int index : present) {
             if (!first) out << Log::endl;
-            out << "  " << *d.first << "=>" << *d.second;
+            out << "  " << *slots[index].first << "=>" << *slots[index].second;
             first = false;
         }
     }
     Definitions *cloneDefinitions() const { return new Definitions(*this); }
     void removeLocation(const StorageLocation *loc);
-    bool empty() const { return definitions.empty(); }
-    size_t size() const { return definitions.size(); }
+    bool empty() const { return present.empty(); }
+    size_t size() const { return present.popcount(); }
 };
 
 class AllDefinitions : public IHasDbPrint {
@@ -560,7 +607,8 @@ class AllDefinitions : public IHasDbPrint {
     StorageMap storageMap;
 
  public:
-    AllDefinitions(ReferenceMap *refMap, TypeMap *typeMap) : storageMap(refMap, typeMap) {}
+    AllDefinitions(ReferenceMap *refMap, TypeMap *typeMap, StorageCache *cache = nullptr)
+        : storageMap(refMap, typeMap, cache) {}
 
     Definitions *getDefinitions(ProgramPoint point, bool emptyIfNotFound = false) {
         auto it = atPoint.find(point);
@@ -17,6 +17,7 @@ limitations under the License.
 #include "entryPriorities.h"
 
 #include "coreLibrary.h"
+#include "lib/hvec_map.h"
 
 namespace P4 {
 
@@ -112,7 +113,9 @@ const IR::Node *EntryPriorities::preorder(IR::EntriesList *entries) {
 
     // Some priorities specified.
 
-    std::map<size_t, const IR::Entry *> usedPriorities;
+    // maps each priority seen so far to the first entry carrying it, so duplicates
+    // can be reported; hashed, so huge entry lists stay linear in this loop
+    hvec_map<size_t, const IR::Entry *> usedPriorities;
     size_t previousPriority = 0;
     bool out_of_order = false;
     for (size_t i = 0; i < entries->size(); ++i) {
@@ -178,13 +181,14 @@ const IR::Node *EntryPriorities::preorder(IR::EntriesList *entries) {
         currentPriority = nextPriority;
     }
     if (out_of_order) {
-        // sort entries so they are in order
-        std::sort(entries->entries.begin(), entries->entries.end(),
-                  [largestWins](const IR::Entry *a, const IR::Entry *b) -> bool {
-                      auto ap = a->priority->to<IR::Constant>()->asUnsigned();
-                      auto bp = b->priority->to<IR::Constant>()->asUnsigned();
-                      return largestWins ? ap > bp : bp > ap;
-                  });
+        // sort entries so they are in order; the sort must be stable so that entries
+        // sharing a priority keep their source order
+        std::stable_sort(entries->entries.begin(), entries->entries.end(),
+                         [largestWins](const IR::Entry *a, const IR::Entry *b) -> bool {
+                             auto ap = a->priority->to<IR::Constant>()->asUnsigned();
+                             auto bp = b->priority->to<IR::Constant>()->asUnsigned();
+                             return largestWins ? ap > bp : bp > ap;
+                         });
     }
     return entries;
 }
@@ -21,9 +21,64 @@ limitations under the License.
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/parameterSubstitution.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
+#include "lib/hash.h"
 
 namespace P4 {
 
+namespace {
+
+/// Structural fingerprint of an evaluated constructor argument.  Literals and value
+/// lists hash by content, since constant folding rebuilds them on every evaluation;
+/// blocks and declarations hash by node identity, so a nested block that had to be
+/// re-evaluated automatically retires every cached invocation built on top of it.
+uint64_t valueFingerprint(const IR::CompileTimeValue *value) {
+    if (value == nullptr) return 1;
+    if (auto *constant = value->to<IR::Constant>())
+        return Util::hash_combine(std::hash<cstring>()(constant->toString()),
+                                  std::hash<cstring>()(constant->type->toString()));
+    if (auto *boolean = value->to<IR::BoolLiteral>()) return boolean->value ? 2 : 3;
+    if (auto *str = value->to<IR::StringLiteral>()) return std::hash<cstring>()(str->value);
+    if (auto *list = value->to<IR::ListCompileTimeValue>()) {
+        uint64_t result = 4;
+        for (auto c : list->components)
+            result = Util::hash_combine(result, valueFingerprint(c->to<IR::CompileTimeValue>()));
+        return result;
+    }
+    if (auto *str = value->to<IR::StructCompileTimeValue>()) {
+        uint64_t result = 5;
+        for (auto c : str->components)
+            result = Util::hash_combine(result, valueFingerprint(c->to<IR::CompileTimeValue>()));
+        return result;
+    }
+    return std::hash<const void *>()(value);
+}
+
+/// A memoized constructor invocation, together with the toplevel values its evaluation
+/// read; the block is only reused when those values are unchanged in the current run.
+struct EvaluatedBlock {
+    const IR::Block *block;
+    std::vector<std::pair<const IR::Node *, const IR::CompileTimeValue *>> toplevelReads;
+};
+
+/// The invoking node, the resolved constructor declaration, the syntactic arguments and
+/// a fingerprint of the canonical instance type plus the evaluated argument values.  The
+/// node components are immutable, so a rewrite of anything inside the instantiation
+/// retires its entry; the fingerprint covers the values the instantiation closes over,
+/// which may change between runs without the syntax changing.
+using ConstructorCacheKey =
+    std::tuple<const IR::Node *, const IR::Node *, const IR::Vector<IR::Argument> *, uint64_t>;
+
+/// Cross-run cache of evaluated blocks: the evaluator rebuilds the toplevel block
+/// several times per compile, and instantiations whose inputs did not change in the
+/// meantime re-do identical work.  Entries pin their key nodes in the GC heap, so the
+/// cache is dropped wholesale once it grows past any reasonable single-program size.
+std::map<ConstructorCacheKey, EvaluatedBlock> &constructorCache() {
+    static thread_local std::map<ConstructorCacheKey, EvaluatedBlock> cache;
+    return cache;
+}
+
+}  // namespace
+
 Visitor::profile_t Evaluator::init_apply(const IR::Node *node) {
     BUG_CHECK(node->is<IR::P4Program>(), "Evaluation should be invoked on a program, not a %1%",
               node);
@@ -75,7 +130,10 @@ const IR::CompileTimeValue *Evaluator::getValue(const IR::Node *node) const {
     } else if (block != toplevelBlock) {
         // Try to lookup this value in the toplevel block:
         // this is needed for global declarations.
-        if (toplevelBlock->hasValue(node)) result = toplevelBlock->getValue(node);
+        if (toplevelBlock->hasValue(node)) {
+            result = toplevelBlock->getValue(node);
+            if (toplevelReads != nullptr) toplevelReads->emplace_back(node, result);
+        }
     }
     return result;
 }
@@ -171,8 +229,12 @@ const IR::Block *Evaluator::processConstructor(
     LOG2("Resolved constructor type declaration " << dbp(decl));
 
     auto current = currentBlock();
-    if (decl->is<IR::Type_Extern>()) {
-        auto exttype = decl->to<IR::Type_Extern>();
+
+    // Find the constructor parameters; for externs also the constructor method itself.
+    const IR::ParameterList *parameters = nullptr;
+    const IR::Method *constructor = nullptr;
+    auto exttype = decl->to<IR::Type_Extern>();
+    if (exttype != nullptr) {
         // We lookup the method in the instanceType, because it may contain compiler-synthesized
         // constructors with zero arguments that may not appear in the original extern declaration.
         auto canon = instanceType;
@@ -180,50 +242,102 @@ const IR::Block *Evaluator::processConstructor(
         if (auto tsc = canon->to<IR::Type_SpecializedCanonical>())
             canon = tsc->substituted->to<IR::Type>();
         BUG_CHECK(canon->is<IR::Type_Extern>(), "%1%: expected an extern", canon);
-        auto constructor = canon->to<IR::Type_Extern>()->lookupConstructor(arguments);
+        constructor = canon->to<IR::Type_Extern>()->lookupConstructor(arguments);
         BUG_CHECK(constructor != nullptr, "Type %1% has no constructor with %2% arguments", exttype,
                   arguments->size());
-        auto block = new IR::ExternBlock(node->srcInfo, node, instanceType, exttype, constructor);
-        pushBlock(block);
-        auto values = evaluateArguments(constructor->type->parameters, arguments, current);
-        if (values != nullptr) block->instantiate(values);
-        popBlock(block);
-        return block;
-    } else if (decl->is<IR::P4Control>()) {
-        auto cont = decl->to<IR::P4Control>();
-        auto block = new IR::ControlBlock(node->srcInfo, node, instanceType, cont);
-        pushBlock(block);
-        auto values = evaluateArguments(cont->getConstructorParameters(), arguments, current);
+        parameters = constructor->type->parameters;
+    } else if (auto cont = decl->to<IR::P4Control>()) {
+        parameters = cont->getConstructorParameters();
+    } else if (auto parser = decl->to<IR::P4Parser>()) {
+        parameters = parser->getConstructorParameters();
+    } else if (auto package = decl->to<IR::Type_Package>()) {
+        parameters = package->constructorParams;
+    } else {
+        BUG("Unhandled case %1%: type is %2%", node, type);
+    }
+
+    auto values = evaluateArguments(parameters, arguments, current);
+
+    // Reuse the block from a previous evaluation when every input is unchanged: the
+    // invoking node and the declaration are pointer-identical, the evaluated argument
+    // values and the canonical instance type fingerprint match, and the toplevel values
+    // the previous evaluation read still stand.  Argument evaluation above cannot be
+    // skipped, but it hits this cache itself for nested constructor calls.
+    ConstructorCacheKey key{node, decl->getNode(), arguments, 0};
+    if (values != nullptr) {
+        uint64_t fingerprint = std::hash<cstring>()(instanceType->toString());
+        for (auto v : *values) fingerprint = Util::hash_combine(fingerprint, valueFingerprint(v));
+        std::get<3>(key) = fingerprint;
+
+        auto &cache = constructorCache();
+        if (auto it = cache.find(key); it != cache.end()) {
+            bool usable = true;
+            for (auto &[ref, value] : it->second.toplevelReads) {
+                if (!toplevelBlock->hasValue(ref) || toplevelBlock->getValue(ref) != value) {
+                    usable = false;
+                    break;
+                }
+            }
+            if (usable) {
+                LOG2("Reusing evaluated block " << dbp(it->second.block) << " for " << dbp(node));
+                if (toplevelReads != nullptr)
+                    toplevelReads->insert(toplevelReads->end(), it->second.toplevelReads.begin(),
+                                          it->second.toplevelReads.end());
+                return it->second.block;
+            }
+            // A toplevel value this evaluation depends on changed; re-evaluate.
+            cache.erase(it);
+        }
+    }
+
+    std::vector<std::pair<const IR::Node *, const IR::CompileTimeValue *>> reads;
+    auto enclosingReads = toplevelReads;
+    toplevelReads = &reads;
+
+    IR::Block *block = nullptr;
+    if (exttype != nullptr) {
+        auto eb = new IR::ExternBlock(node->srcInfo, node, instanceType, exttype, constructor);
+        pushBlock(eb);
+        if (values != nullptr) eb->instantiate(values);
+        popBlock(eb);
+        block = eb;
+    } else if (auto cont = decl->to<IR::P4Control>()) {
+        auto cb = new IR::ControlBlock(node->srcInfo, node, instanceType, cont);
+        pushBlock(cb);
         if (values != nullptr) {
-            block->instantiate(values);
+            cb->instantiate(values);
             for (auto a : cont->controlLocals) visit(a);
         }
-        popBlock(block);
-        return block;
-    } else if (decl->is<IR::P4Parser>()) {
-        auto cont = decl->to<IR::P4Parser>();
-        auto block = new IR::ParserBlock(node->srcInfo, node, instanceType, cont);
-        pushBlock(block);
-        auto values = evaluateArguments(cont->getConstructorParameters(), arguments, current);
+        popBlock(cb);
+        block = cb;
+    } else if (auto parser = decl->to<IR::P4Parser>()) {
+        auto pb = new IR::ParserBlock(node->srcInfo, node, instanceType, parser);
+        pushBlock(pb);
         if (values != nullptr) {
-            block->instantiate(values);
-            for (auto a : cont->parserLocals) visit(a);
-            for (auto a : cont->states) visit(a);
+            pb->instantiate(values);
+            for (auto a : parser->parserLocals) visit(a);
+            for (auto a : parser->states) visit(a);
         }
-        popBlock(block);
-        return block;
-    } else if (decl->is<IR::Type_Package>()) {
+        popBlock(pb);
+        block = pb;
+    } else {
         auto package = decl->to<IR::Type_Package>();
-        auto block = new IR::PackageBlock(node->srcInfo, node, instanceType, package);
-        pushBlock(block);
-        auto values = evaluateArguments(package->constructorParams, arguments, current);
-        if (values != nullptr) block->instantiate(values);
-        popBlock(block);
-        return block;
+        auto gb = new IR::PackageBlock(node->srcInfo, node, instanceType, package);
+        pushBlock(gb);
+        if (values != nullptr) gb->instantiate(values);
+        popBlock(gb);
+        block = gb;
     }
 
-    BUG("Unhandled case %1%: type is %2%", node, type);
-    return nullptr;
+    toplevelReads = enclosingReads;
+    if (enclosingReads != nullptr)
+        enclosingReads->insert(enclosingReads->end(), reads.begin(), reads.end());
+    if (values != nullptr) {
+        auto &cache = constructorCache();
+        if (cache.size() >= (1 << 16)) cache.clear();
+        cache.emplace(std::move(key), EvaluatedBlock{block, std::move(reads)});
+    }
+    return block;
 }
 
 bool Evaluator::preorder(const IR::Member *expression) {
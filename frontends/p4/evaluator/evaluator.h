@@ -35,6 +35,12 @@ class Evaluator final : public Inspector, public IHasBlock {
     const TypeMap *typeMap;
     std::vector<IR::Block *> blockStack;
     IR::ToplevelBlock *toplevelBlock;
+    /// While a constructor invocation is being recorded for the cross-run block cache,
+    /// every value its evaluation reads from the toplevel block (i.e., references to
+    /// global declarations) is logged here, so that a cached block is only reused when
+    /// those toplevel values are unchanged.  Null outside of constructor evaluation.
+    std::vector<std::pair<const IR::Node *, const IR::CompileTimeValue *>> *toplevelReads =
+        nullptr;
 
  protected:
     void pushBlock(IR::Block *block);
@@ -38,6 +38,9 @@ const IR::Node *SubstituteParameters::postorder(IR::PathExpression *expr) {
         return cloned;
     }
 
+    // An unsubstituted reference can be shared with the original subtree.
+    if (shareUnchanged) return expr;
+
     // Path expressions always need to be cloned.
     IR::ID newid = expr->path->name;
     auto path = new IR::Path(newid, expr->path->absolute);
@@ -56,6 +59,8 @@ const IR::Node *SubstituteParameters::postorder(IR::Type_Name *type) {
         return repl;
     }
 
+    if (shareUnchanged) return type;
+
     IR::ID newid = type->path->name;
     auto path = new IR::Path(newid, type->path->absolute);
     auto result = new IR::Type_Name(type->srcInfo, path);
@@ -30,6 +30,15 @@ class SubstituteParameters : public TypeVariableSubstitutionVisitor, public Reso
  protected:
     const DeclarationLookup *refMap;     // input
     const ParameterSubstitution *subst;  // input
+    /// When set (in a derived class constructor), references that are neither
+    /// substituted parameters nor bound type variables are left untouched
+    /// instead of cloned, so the enclosing Transform shares every unmodified
+    /// subtree between the original and the substituted copy.  Only sound
+    /// when such references resolve to the same declaration at the
+    /// destination, which holds once UniqueNames has run; the inliners use it
+    /// so their cost scales with the substituted nodes, not the callee size.
+    bool shareUnchanged = false;
+
  public:
     SubstituteParameters(const DeclarationLookup *refMap, const ParameterSubstitution *subst,
                          const TypeVariableSubstitution *tvs)
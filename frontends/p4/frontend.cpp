@@ -21,9 +21,12 @@ limitations under the License.
 #include "../common/options.h"
 #include "frontends/common/resolveReferences/resolveReferences.h"
 #include "frontends/p4/typeChecking/bindVariables.h"
+#include "frontends/p4/typeChecking/parallelTypeInference.h"
 #include "frontends/p4/typeMap.h"
+#include "ir/id-compaction.h"
 #include "ir/ir.h"
 #include "lib/nullstream.h"
+#include "lib/telemetry.h"
 // Passes
 #include "actionsInlining.h"
 #include "checkConstants.h"
@@ -182,6 +185,8 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
     if (program == nullptr && options.listFrontendPasses == 0) return nullptr;
 
     TypeMap typeMap;
+    typeMap.setIncremental(options.incrementalTypeChecking);
+    ParallelTypeInference::setParallelism(options.typeCheckThreads);
 
     MetricsPassManager metricsPassManager(options, &typeMap, P4CContext::get().options().metrics);
 
@@ -203,18 +208,25 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
         // First pass of constant folding, before types are known --
         // may be needed to compute types.
         new ConstantFolding(constantFoldingPolicy),
-        new ValidateSwitchStatements(),
-        // Validate @name/@deprecated/@noWarn. Should run after constant folding.
-        new ValidateStringAnnotations(),
+        // Independent validation inspectors; run concurrently.
+        new ParallelInspect({
+            new ValidateSwitchStatements(),
+            // Validate @name/@deprecated/@noWarn. Should run after constant folding.
+            new ValidateStringAnnotations(),
+        }),
         // Desugars direct parser and control applications
         // into instantiations followed by application
         new InstantiateDirectCalls(),
-        new Deprecated(),
-        new CheckNamedArgs(),
+        new ParallelInspect({
+            new Deprecated(),
+            new CheckNamedArgs(),
+        }),
         // Type checking and type inference.  Also inserts
         // explicit casts where implicit casts exist.
         new SetStrictStruct(&typeMap, true),        // Next pass uses strict struct checking
-        new TypeInference(&typeMap, false, false),  // insert casts, don't check arrays
+        // insert casts, don't check arrays; runs independent declarations on
+        // worker threads when --parallel-typecheck asks for them
+        new ParallelTypeInference(&typeMap, /* checkArrays */ false),
         new SetStrictStruct(&typeMap, false),
         new ValidateMatchAnnotations(&typeMap),
         new ValidateValueSets(),
@@ -317,6 +329,10 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
         // check during inlining since it significantly slows compilation.
         new CheckShadowing(),
         new HierarchicalNames(),
+        // The frontend allocated an id for every intermediate clone; move the
+        // surviving nodes into a dense id range before the midend builds
+        // id-indexed tables over them.
+        new CompactNodeIds(),
         new FrontEndLast(),
     });
     if (options.listFrontendPasses) {
@@ -332,6 +348,7 @@ const IR::P4Program *FrontEnd::run(const CompilerOptions &options, const IR::P4P
     passes.setName("FrontEnd");
     passes.setStopOnError(true);
     passes.addDebugHooks(hooks, true);
+    Util::Telemetry::Span telemetrySpan("frontend");
     const IR::P4Program *result = program->apply(passes);
     return result;
 }
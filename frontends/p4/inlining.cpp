@@ -237,6 +237,9 @@ class Substitutions : public SubstituteParameters {
         : SubstituteParameters(refMap, subst, tvs), refMap(refMap), renameMap(renameMap) {
         CHECK_NULL(refMap);
         CHECK_NULL(renameMap);
+        // UniqueNames ran before inlining, so unrenamed references resolve to
+        // the same declarations inside the caller; share those subtrees.
+        shareUnchanged = true;
     }
     const IR::Node *postorder(IR::P4Table *table) override {
         auto orig = getOriginal<IR::IDeclaration>();
@@ -298,10 +301,15 @@ class Substitutions : public SubstituteParameters {
         }
 
         cstring newName;
-        if (renameMap->isRenamed(decl))
+        if (renameMap->isRenamed(decl)) {
             newName = renameMap->getName(decl);
-        else
+        } else if (shareUnchanged) {
+            // Neither substituted nor renamed: keep the node (and its refMap
+            // entry) shared with the original subtree.
+            return expression;
+        } else {
             newName = expression->path->name;
+        }
         IR::ID newid(expression->path->srcInfo, newName, expression->path->name.originalName);
         auto newpath = new IR::Path(newid, expression->path->absolute);
         auto result = new IR::PathExpression(newpath);
@@ -345,9 +353,9 @@ void InlineList::analyze() {
         cg.calls(inl->caller, inl->callee);
     }
 
-    // must inline from leaves up
-    std::vector<const IR::IContainer *> order;
-    cg.sort(order);
+    // must inline from leaves up; the graph is complete here, so query its
+    // compiled form
+    const std::vector<const IR::IContainer *> &order = cg.compile()->sccOrder();
     for (auto c : order) {
         // This is quadratic, but hopefully the call graph is not too large
         for (auto m : inlineMap) {
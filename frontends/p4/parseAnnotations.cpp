@@ -16,6 +16,8 @@ limitations under the License.
 
 #include "parseAnnotations.h"
 
+#include "frontends/common/constantParsing.h"
+
 namespace P4 {
 
 ParseAnnotations::HandlerMap ParseAnnotations::standardHandlers() {
@@ -59,6 +61,21 @@ ParseAnnotations::HandlerMap ParseAnnotations::standardHandlers() {
     };
 }
 
+const IR::Expression *ParseAnnotations::parseTrivialBody(const IR::Annotation *annotation) {
+    const auto &unparsed = annotation->getUnparsed();
+    if (unparsed.size() != 1) return nullptr;
+    const IR::AnnotationToken *token = unparsed.front();
+    switch (token->token_type) {
+        case P4Parser::token_type::TOK_STRING_LITERAL:
+            return new IR::StringLiteral(token->srcInfo, token->text);
+        case P4Parser::token_type::TOK_INTEGER:
+            if (token->constInfo == nullptr) return nullptr;
+            return parseConstant(token->srcInfo, *token->constInfo, 0);
+        default:
+            return nullptr;
+    }
+}
+
 bool ParseAnnotations::parseSkip(IR::Annotation *) { return false; }
 
 bool ParseAnnotations::parseEmpty(IR::Annotation *annotation) {
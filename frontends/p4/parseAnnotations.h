@@ -35,8 +35,11 @@ namespace P4 {
 // Parses an annotation with a single-element body.
 #define PARSE(aname, tname)                                                                    \
     {aname, [](IR::Annotation *annotation) {                                                   \
-         const IR::tname *parsed =                                                             \
-             P4::P4ParserDriver::parse##tname(annotation->srcInfo, annotation->getUnparsed()); \
+         const IR::tname *parsed = P4::ParseAnnotations::parseTrivial<IR::tname>(annotation);  \
+         if (parsed == nullptr)                                                                \
+             parsed =                                                                          \
+                 P4::P4ParserDriver::parse##tname(annotation->srcInfo,                         \
+                                                  annotation->getUnparsed());                  \
          if (parsed != nullptr) {                                                              \
              annotation->body.emplace<IR::Annotation::ExpressionAnnotation>(parsed);           \
          }                                                                                     \
@@ -44,20 +47,25 @@ namespace P4 {
      }}
 
 // Parses an annotation that is either an integer constant or a string literal.
-#define PARSE_CONSTANT_OR_STRING_LITERAL(aname)                                           \
-    {aname, [](IR::Annotation *annotation) {                                              \
-         const IR::Expression *parsed = P4::P4ParserDriver::parseConstantOrStringLiteral( \
-             annotation->srcInfo, annotation->getUnparsed());                             \
-         if (parsed != nullptr) {                                                         \
-             annotation->body.emplace<IR::Annotation::ExpressionAnnotation>(parsed);      \
-         }                                                                                \
-         return parsed != nullptr;                                                        \
+#define PARSE_CONSTANT_OR_STRING_LITERAL(aname)                                               \
+    {aname, [](IR::Annotation *annotation) {                                                  \
+         const IR::Expression *parsed = P4::ParseAnnotations::parseTrivialBody(annotation);   \
+         if (parsed == nullptr)                                                               \
+             parsed = P4::P4ParserDriver::parseConstantOrStringLiteral(                       \
+                 annotation->srcInfo, annotation->getUnparsed());                             \
+         if (parsed != nullptr) {                                                             \
+             annotation->body.emplace<IR::Annotation::ExpressionAnnotation>(parsed);          \
+         }                                                                                    \
+         return parsed != nullptr;                                                            \
      }}
 
 #define PARSE_CONSTANT(aname)                                                                   \
     {aname, [](IR::Annotation *annotation) {                                                    \
          const IR::Expression *parsed =                                                         \
-             P4::P4ParserDriver::parseConstant(annotation->srcInfo, annotation->getUnparsed()); \
+             P4::ParseAnnotations::parseTrivial<IR::Constant>(annotation);                      \
+         if (parsed == nullptr)                                                                 \
+             parsed = P4::P4ParserDriver::parseConstant(annotation->srcInfo,                    \
+                                                        annotation->getUnparsed());            \
          if (parsed != nullptr) {                                                               \
              annotation->body.emplace<IR::Annotation::ExpressionAnnotation>(parsed);            \
          }                                                                                      \
@@ -66,8 +74,11 @@ namespace P4 {
 
 #define PARSE_STRING_LITERAL(aname)                                                  \
     {aname, [](IR::Annotation *annotation) {                                         \
-         const IR::Expression *parsed = P4::P4ParserDriver::parseStringLiteral(      \
-             annotation->srcInfo, annotation->getUnparsed());                        \
+         const IR::Expression *parsed =                                              \
+             P4::ParseAnnotations::parseTrivial<IR::StringLiteral>(annotation);      \
+         if (parsed == nullptr)                                                      \
+             parsed = P4::P4ParserDriver::parseStringLiteral(                        \
+                 annotation->srcInfo, annotation->getUnparsed());                    \
          if (parsed != nullptr) {                                                    \
              annotation->body.emplace<IR::Annotation::ExpressionAnnotation>(parsed); \
          }                                                                           \
@@ -153,6 +164,20 @@ class ParseAnnotations : public Modifier {
 
     static HandlerMap standardHandlers();
 
+    /// If the unparsed body of @annotation is a single string-literal or
+    /// integer token, builds the corresponding literal directly; returns
+    /// nullptr for any other body.  The vast majority of annotations
+    /// (@name("..."), numeric pragmas, ...) take this form, and the fast
+    /// path avoids instantiating a nested annotation parser for each one.
+    static const IR::Expression *parseTrivialBody(const IR::Annotation *annotation);
+
+    /// Typed wrapper around parseTrivialBody for the singleton handlers.
+    template <typename T>
+    static const T *parseTrivial(const IR::Annotation *annotation) {
+        const IR::Expression *e = parseTrivialBody(annotation);
+        return e == nullptr ? nullptr : e->to<T>();
+    }
+
     static bool parseSkip(IR::Annotation *annotation);
     static bool parseEmpty(IR::Annotation *annotation);
     static bool parseExpressionList(IR::Annotation *annotation);
@@ -1516,7 +1516,8 @@ class ProcessDefUse : public PassManager {
     HasUses hasUses;
 
  public:
-    ProcessDefUse(ReferenceMap *refMap, TypeMap *typeMap) : definitions(refMap, typeMap) {
+    ProcessDefUse(ReferenceMap *refMap, TypeMap *typeMap, StorageCache *cache)
+        : definitions(refMap, typeMap, cache) {
         passes.push_back(new ComputeWriteSet(&definitions, refMap, typeMap));
         passes.push_back(new FindUninitialized(&definitions, refMap, typeMap, hasUses));
         passes.push_back(new RemoveUnused(hasUses, refMap, typeMap));
@@ -1526,7 +1527,11 @@ class ProcessDefUse : public PassManager {
 }  // namespace
 
 const IR::Node *DoSimplifyDefUse::process(const IR::Node *node) {
-    ProcessDefUse process(refMap, typeMap);
+    // Reuse the storage graphs built for this object by previous rounds; its name is
+    // stable across rounds even though the rewritten node is not.
+    auto *&cache = storageCaches[node->checkedTo<IR::IDeclaration>()->getName().name];
+    if (cache == nullptr) cache = new StorageCache();
+    ProcessDefUse process(refMap, typeMap, cache);
     process.setCalledBy(this);
     LOG5("ProcessDefUse of:" << Log::endl << node);
     return node->apply(process, getChildContext());
@@ -21,12 +21,18 @@ limitations under the License.
 #include "frontends/p4/cloner.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
+#include "lib/ordered_map.h"
 
 namespace P4 {
 
+class StorageCache;
+
 class DoSimplifyDefUse : public Transform {
     ReferenceMap *refMap;
     TypeMap *typeMap;
+    /// Storage graphs reused across PassRepeated rounds, one per processed object
+    /// (keyed by name, which is stable while the rounds rewrite the object itself).
+    ordered_map<cstring, StorageCache *> storageCaches;
 
     const IR::Node *process(const IR::Node *node);
 
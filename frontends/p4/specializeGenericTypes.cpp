@@ -16,6 +16,8 @@ limitations under the License.
 
 #include "specializeGenericTypes.h"
 
+#include <algorithm>
+
 #include "absl/strings/str_replace.h"
 #include "frontends/p4/typeChecking/typeSubstitutionVisitor.h"
 
@@ -61,35 +63,51 @@ void TypeSpecializationMap::fillInsertionSet(const IR::Type_StructLike *decl,
 }
 
 void TypeSpecializationMap::add(const IR::Type_Specialized *t, const IR::Type_StructLike *decl,
-                                NameGenerator *nameGen) {
+                                const IR::Vector<IR::Type> *argTypes, NameGenerator *nameGen) {
     const auto sig = SpecSignature::get(t);
     if (!sig) {
         return;
     }
-    if (map.count(*sig)) return;
+    if (map.count(*sig) || sameTypes.count(*sig)) return;
+
+    // A differently-spelled instantiation of the same declaration with the same
+    // canonical arguments (e.g. via typedefs) reuses the existing specialization.
+    for (const auto &[otherSig, other] : map) {
+        if (other.declaration->name != decl->name) continue;
+        if (std::equal(argTypes->begin(), argTypes->end(), other.argumentTypes->begin(),
+                       other.argumentTypes->end(), [this](const IR::Type *a, const IR::Type *b) {
+                           return typeMap->equivalent(a, b);
+                       })) {
+            LOG3("Found to specialize: " << dbp(t) << " reusing " << other.name);
+            sameTypes.emplace(*sig, otherSig);
+            return;
+        }
+    }
 
     cstring name = nameGen->newName(sig->name());
     LOG3("Found to specialize: " << dbp(t) << " with name " << name << " insert after "
                                  << dbp(decl));
-    map.emplace(*sig, TypeSpecialization{name, t, decl, {decl->name.name}, t->arguments});
+    map.emplace(*sig, TypeSpecialization{name, t, decl, {decl->name.name}, argTypes});
 }
 
 namespace {
 
 // depending on constness of Map returns a const or non-const pointer
-template <typename Map>
-auto *_get(Map &map, const IR::Type_Specialized *type) {
+template <typename TSM>
+auto *_get(TSM &self, const IR::Type_Specialized *type) {
     const auto sig = SpecSignature::get(type);
-    return sig ? getref(map, *sig) : nullptr;
+    if (!sig) return decltype(getref(self.map, *sig))(nullptr);
+    if (const auto *canonical = getref(self.sameTypes, *sig)) return getref(self.map, *canonical);
+    return getref(self.map, *sig);
 }
 }  // namespace
 
 const TypeSpecialization *TypeSpecializationMap::get(const IR::Type_Specialized *type) const {
-    return _get(map, type);
+    return _get(*this, type);
 }
 
 TypeSpecialization *TypeSpecializationMap::get(const IR::Type_Specialized *type) {
-    return _get(map, type);
+    return _get(*this, type);
 }
 
 namespace {
@@ -128,6 +146,7 @@ void FindTypeSpecializations::postorder(const IR::Type_Specialized *type) {
     if (st == nullptr || st->typeParameters->size() == 0)
         // nothing to specialize
         return;
+    auto *argTypes = new IR::Vector<IR::Type>();
     for (auto tp : *type->arguments) {
         auto argType = specMap->typeMap->getTypeType(tp, true);
         if (ContainsTypeVariable::inspect(argType))
@@ -138,14 +157,18 @@ void FindTypeSpecializations::postorder(const IR::Type_Specialized *type) {
             // then we won't specialize this now, but only when encountered in
             // specialized instances of G, e.g., G<bit<32>>.
             return;
+        argTypes->push_back(argType);
     }
-    specMap->add(type, st, &nameGen);
+    specMap->add(type, st, argTypes, &nameGen);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
 void CreateSpecializedTypes::postorder(IR::Type_Specialized *spec) {
     if (auto *specialization = specMap->get(spec)) {
+        if (specialization->replacement != nullptr)
+            // Already synthesized for an earlier use of the same instantiation.
+            return;
         const auto *declT = getDeclaration(spec->baseType->path)->to<IR::Type_Declaration>();
         BUG_CHECK(declT, "Could not get declaration for %1%", spec);
         auto genDecl = declT->to<IR::IMayBeGenericType>();
@@ -99,15 +99,22 @@ std::string toString(const SpecSignature &);
 struct TypeSpecializationMap : IHasDbPrint {
     TypeMap *typeMap;
     ordered_map<SpecSignature, TypeSpecialization> map;
+    /// Signatures that are spelled differently (e.g. through typedefs) but whose
+    /// arguments canonicalize to those of an entry already in 'map'; they share
+    /// that entry's specialized declaration instead of synthesizing their own.
+    ordered_map<SpecSignature, SpecSignature> sameTypes;
 
     void add(const IR::Type_Specialized *t, const IR::Type_StructLike *decl,
-             NameGenerator *nameGen);
+             const IR::Vector<IR::Type> *argTypes, NameGenerator *nameGen);
     const TypeSpecialization *get(const IR::Type_Specialized *t) const;
     TypeSpecialization *get(const IR::Type_Specialized *t);
     void dbprint(std::ostream &out) const override {
         for (auto it : map) {
             out << toString(it.first) << " => " << it.second << std::endl;
         }
+        for (auto it : sameTypes) {
+            out << toString(it.first) << " same as " << toString(it.second) << std::endl;
+        }
     }
 
     /// @brief Get a single specialization that is already available (i.e. it does not require any
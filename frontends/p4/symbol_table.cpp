@@ -68,9 +68,10 @@ class Namespace : public NamedSymbol {
  public:
     Namespace(cstring name, Util::SourceInfo si, bool allowDuplicates)
         : NamedSymbol(name, si), allowDuplicates(allowDuplicates) {}
-    void declare(NamedSymbol *symbol) {
+    /// @return true if @symbol was entered as a new name in this namespace.
+    bool declare(NamedSymbol *symbol) {
         cstring symname = symbol->getName();
-        if (symname.isNullOrEmpty()) return;
+        if (symname.isNullOrEmpty()) return false;
 
         auto it = contents.find(symname);
         if (it != contents.end()) {
@@ -79,17 +80,20 @@ class Namespace : public NamedSymbol {
                 ::P4::error(ErrorType::ERR_DUPLICATE,
                             "Re-declaration of %1%%2% with different type: %3%", symbol->getName(),
                             symbol->getSourceInfo(), it->second->getSourceInfo());
-                return;
+                return false;
             }
 
             if (!allowDuplicates) {
                 ::P4::error(ErrorType::ERR_DUPLICATE,
                             "Duplicate declaration of %1%%2%; previous at %3%", symbol->getName(),
                             symbol->getSourceInfo(), it->second->getSourceInfo());
-                return;
+                return false;
             }
+            // the first declaration stays in the table
+            return false;
         }
         contents.emplace(symbol->getName(), symbol);
+        return true;
     }
     NamedSymbol *lookup(cstring name) const {
         auto it = contents.find(name);
@@ -155,14 +159,32 @@ ProgramStructure::ProgramStructure()
     debugStream = stderr;
 }
 
+// Declare @symbol in the current namespace and, if it entered the table,
+// make it the visible binding of its name, remembering what it shadowed so
+// pop() can restore it.
+void ProgramStructure::declare(NamedSymbol *symbol) {
+    if (!currentNamespace->declare(symbol)) return;
+    cstring symname = symbol->getName();
+    NamedSymbol *shadowed = nullptr;
+    if (auto it = visibleBindings.find(symname); it != visibleBindings.end()) {
+        shadowed = it->second;
+        it->second = symbol;
+    } else {
+        visibleBindings.emplace(symname, symbol);
+    }
+    // bindings in the root scope are never undone; clear() drops them all
+    if (!scopeUndo.empty()) scopeUndo.back().emplace_back(symname, shadowed);
+}
+
 void ProgramStructure::push(Namespace *ns) {
     CHECK_NULL(ns);
     if (debug) fprintf(debugStream, "ProgramStructure: pushing %s\n", ns->toString().c_str());
     LOG4("ProgramStructure: pushing " << ns->toString());
     BUG_CHECK(currentNamespace != nullptr, "Null currentNamespace");
-    currentNamespace->declare(ns);
+    declare(ns);
     ns->setParent(currentNamespace);
     currentNamespace = ns;
+    scopeUndo.emplace_back();
 }
 
 void ProgramStructure::pushNamespace(SourceInfo si, bool allowDuplicates) {
@@ -184,6 +206,14 @@ void ProgramStructure::pop() {
                 currentNamespace->toString().c_str());
     LOG4("ProgramStructure: popping " << currentNamespace->toString());
     currentNamespace = parent;
+    BUG_CHECK(!scopeUndo.empty(), "Scope undo stack out of sync with namespace stack");
+    for (auto &[symname, shadowed] : scopeUndo.back()) {
+        if (shadowed)
+            visibleBindings[symname] = shadowed;
+        else
+            visibleBindings.erase(symname);
+    }
+    scopeUndo.pop_back();
 }
 
 void ProgramStructure::declareType(IR::ID id) {
@@ -191,7 +221,7 @@ void ProgramStructure::declareType(IR::ID id) {
 
     LOG3("ProgramStructure: adding type " << id);
     auto st = new SimpleType(id.name, id.srcInfo);
-    currentNamespace->declare(st);
+    declare(st);
 }
 
 void ProgramStructure::declareObject(IR::ID id, cstring type) {
@@ -202,7 +232,7 @@ void ProgramStructure::declareObject(IR::ID id, cstring type) {
     auto o = new Object(id.name, id.srcInfo);
     if (type_sym)
         if (auto tns = type_sym->to<Namespace>()) o->setNamespace(tns);
-    currentNamespace->declare(o);
+    declare(o);
 }
 
 void ProgramStructure::markAsTemplate(IR::ID id) {
@@ -229,16 +259,10 @@ NamedSymbol *ProgramStructure::lookup(cstring identifier) {
     const Namespace *parent = identifierContext.lookupContext;
     NamedSymbol *rv = nullptr;
     if (parent == nullptr) {
-        // We don't have a parent, try lookup up the stack
-        parent = currentNamespace;
-        while (parent != nullptr) {
-            NamedSymbol *symbol = parent->lookup(identifier);
-            if (symbol != nullptr) {
-                rv = symbol;
-                break;
-            }
-            parent = parent->getParent();
-        }
+        // We don't have a parent: the flat binding map holds the innermost
+        // visible declaration from the whole namespace stack.
+        auto it = visibleBindings.find(identifier);
+        if (it != visibleBindings.end()) rv = it->second;
     } else {
         rv = parent->lookup(identifier);
     }
@@ -286,6 +310,8 @@ cstring ProgramStructure::toString() const {
 void ProgramStructure::clear() {
     rootNamespace->clear();
     currentNamespace = rootNamespace;
+    visibleBindings.clear();
+    scopeUndo.clear();
     debugStream = stderr;
 }
 }  // namespace P4::Util
@@ -23,6 +23,7 @@ limitations under the License.
    the v1.2 grammar is ambiguous without type information */
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ir/ir.h"
@@ -49,6 +50,17 @@ class ProgramStructure final {
         PathContext() : previousSymbol(nullptr), lookupContext(nullptr) {}
     } identifierContext;
 
+    // Flat view of every symbol visible from the current scope chain: the
+    // innermost binding of each name.  Identifier lookup is then a single
+    // hash probe regardless of nesting depth, entering a scope is O(1), and
+    // leaving one only undoes the bindings that scope introduced, restoring
+    // whatever they shadowed.  The per-namespace maps are kept unchanged,
+    // since path-based lookups address namespaces directly.
+    std::unordered_map<cstring, NamedSymbol *> visibleBindings;
+    // For each open scope, the binding each of its declarations replaced
+    // (nullptr if the name was previously unbound).
+    std::vector<std::vector<std::pair<cstring, NamedSymbol *>>> scopeUndo;
+
     void push(Namespace *ns);
     NamedSymbol *lookup(const cstring identifier);
     void declare(NamedSymbol *symbol);
@@ -37,8 +37,9 @@ Visitor::profile_t ToP4::init_apply(const IR::Node *node) {
 
 void ToP4::end_apply(const IR::Node *) {
     if (outStream != nullptr) {
-        cstring result = builder.toString();
-        *outStream << result.c_str();
+        // Stream the rope chunk by chunk; flattening it into a cstring would
+        // copy the whole program and intern it permanently.
+        builder.writeTo(*outStream);
         outStream->flush();
     }
     BUG_CHECK(listTerminators.size() == listTerminators_init_apply_size,
@@ -517,13 +518,14 @@ bool ToP4::process(const IR::Type_StructLike *t, const char *name) {
 
     std::map<const IR::StructField *, cstring> type;
     size_t len = 0;
+    Util::SourceCodeBuilder fieldBuilder;
     for (auto f : t->fields) {
-        Util::SourceCodeBuilder builder;
-        ToP4 rec(builder, showIR);
+        fieldBuilder.clear();
+        ToP4 rec(fieldBuilder, showIR);
         rec.isDeclaration = false;
 
         f->type->apply(rec);
-        cstring t = builder.toString();
+        cstring t = fieldBuilder.toString();
         if (t.size() > len) len = t.size();
         type.emplace(f, t);
     }
@@ -1512,12 +1514,13 @@ bool ToP4::preorder(const IR::Key *v) {
 
     std::map<const IR::KeyElement *, cstring> kf;
     size_t len = 0;
+    Util::SourceCodeBuilder keyBuilder;
     for (auto f : v->keyElements) {
-        Util::SourceCodeBuilder builder;
-        ToP4 rec(builder, showIR);
+        keyBuilder.clear();
+        ToP4 rec(keyBuilder, showIR);
 
         f->expression->apply(rec);
-        cstring s = builder.toString();
+        cstring s = keyBuilder.toString();
         if (s.size() > len) len = s.size();
         kf.emplace(f, s);
     }
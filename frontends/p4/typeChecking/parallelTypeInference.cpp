@@ -0,0 +1,207 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "parallelTypeInference.h"
+
+#include <mutex>
+#include <thread>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "lib/error.h"
+#include "lib/gc.h"
+#include "lib/log.h"
+
+namespace P4 {
+
+unsigned ParallelTypeInference::maxThreads = 1;
+
+namespace {
+
+/// Collects all names referenced in a subtree.  Local names are not
+/// distinguished from top-level ones, which can only make the partition
+/// more conservative.
+class CollectPathNames : public Inspector {
+ public:
+    absl::flat_hash_set<cstring, Util::Hash> names;
+    bool preorder(const IR::Path *path) override {
+        names.insert(path->name.name);
+        return true;
+    }
+};
+
+}  // namespace
+
+const IR::Node *ParallelTypeInference::serialFallback(const IR::Node *node) {
+    TypeInference serial(typeMap, /* readOnly */ false, checkArrays);
+    return node->apply(serial, getChildContext());
+}
+
+const IR::Node *ParallelTypeInference::apply_visitor(const IR::Node *node, const char *) {
+    const auto *program = node != nullptr ? node->to<IR::P4Program>() : nullptr;
+    if (program == nullptr || maxThreads < 2) return serialFallback(node);
+
+    // Partition the top-level objects.  Candidates are controls and parsers;
+    // an object referencing the name of a candidate (or, transitively, of
+    // anything deferred) cannot be checked before it and is deferred to the
+    // final serial run; a candidate doing so is demoted to deferred as well.
+    struct Info {
+        const IR::Node *object;
+        cstring name;  // empty if not a declaration
+        absl::flat_hash_set<cstring, Util::Hash> references;
+        bool candidate;
+        bool deferred = false;
+    };
+    std::vector<Info> infos;
+    absl::flat_hash_set<cstring, Util::Hash> unavailable;
+    for (const auto *obj : program->objects) {
+        const auto *decl = obj->to<IR::IDeclaration>();
+        cstring name = decl != nullptr ? decl->getName().name : cstring::empty;
+        bool candidate = obj->is<IR::P4Control>() || obj->is<IR::P4Parser>();
+        if (candidate) unavailable.insert(name);
+        CollectPathNames refs;
+        obj->apply(refs, getChildContext());
+        infos.push_back({obj, name, std::move(refs.names), candidate});
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto &info : infos) {
+            if (info.deferred) continue;
+            for (cstring ref : info.references) {
+                if (ref == info.name || !unavailable.count(ref)) continue;
+                info.deferred = true;
+                info.candidate = false;
+                if (!info.name.isNullOrEmpty()) unavailable.insert(info.name);
+                changed = true;
+                break;
+            }
+        }
+    }
+    size_t candidates = 0;
+    for (const auto &info : infos) candidates += info.candidate;
+    if (candidates < 2) return serialFallback(node);
+
+    // Phase 1: check the environment - everything that is neither a candidate
+    // nor deferred - serially, so the workers see the types of all
+    // declarations their candidates may reference.
+    unsigned initialErrors = ::P4::errorCount();
+    IR::Vector<IR::Node> envObjects;
+    for (const auto &info : infos)
+        if (!info.candidate && !info.deferred) envObjects.push_back(info.object);
+    const auto *envProgram = new IR::P4Program(program->srcInfo, envObjects);
+    TypeInference envInference(typeMap, /* readOnly */ false, checkArrays);
+    const auto *checkedEnv =
+        envProgram->apply(envInference, getChildContext())->to<IR::P4Program>();
+    if (checkedEnv == nullptr || ::P4::errorCount() > initialErrors) return node;
+    BUG_CHECK(checkedEnv->objects.size() == envObjects.size(),
+              "type inference changed the number of top-level objects");
+
+    // Phase 2: check each candidate on a worker thread, against a scratch
+    // program holding the checked environment followed by the candidate, into
+    // a TypeMap seeded from the shared one.  Revisiting the environment is
+    // cheap: every node there is already typed, so inference prunes it.
+    struct Job {
+        const IR::Node *candidate = nullptr;
+        const IR::Node *checked = nullptr;
+        TypeMap map;
+        std::exception_ptr failure;
+    };
+    std::vector<Job> jobs(candidates);
+    size_t jobIndex = 0;
+    for (const auto &info : infos)
+        if (info.candidate) jobs[jobIndex++].candidate = info.object;
+
+    static std::once_flag allow_threads;
+    std::call_once(allow_threads, gc_allow_threads);
+
+    const Visitor::Context *ctxt = getChildContext();
+    size_t next = 0;
+    std::mutex worklist;
+    auto worker = [&]() {
+        gc_thread_scope gc_scope;
+        while (true) {
+            size_t idx;
+            {
+                std::lock_guard<std::mutex> lock(worklist);
+                if (next >= jobs.size()) return;
+                idx = next++;
+            }
+            auto &job = jobs[idx];
+            try {
+                job.map.copyEntriesFrom(*typeMap);
+                IR::Vector<IR::Node> objects = checkedEnv->objects;
+                objects.push_back(job.candidate);
+                const auto *scratch = new IR::P4Program(program->srcInfo, objects);
+                TypeInference inference(&job.map, /* readOnly */ false, checkArrays);
+                const auto *checked = scratch->apply(inference, ctxt)->to<IR::P4Program>();
+                BUG_CHECK(checked != nullptr && checked->objects.size() == objects.size(),
+                          "type inference changed the number of top-level objects");
+                job.checked = checked->objects.back();
+            } catch (...) {
+                job.failure = std::current_exception();
+            }
+        }
+    };
+    unsigned nthreads = maxThreads < jobs.size() ? maxThreads : jobs.size();
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < nthreads; ++i) threads.emplace_back(worker);
+    for (auto &t : threads) t.join();
+    for (auto &job : jobs)
+        if (job.failure) std::rethrow_exception(job.failure);
+
+    // Merge the worker maps.  Environment entries are duplicated in every
+    // worker map and skipped; the substitutions only bind type variables
+    // freshly created by that worker, so composing them cannot conflict.
+    for (auto &job : jobs) {
+        typeMap->copyEntriesFrom(job.map);
+        typeMap->addSubstitutions(job.map.getSubstitutions());
+    }
+
+    // Reassemble the program in the original declaration order.
+    absl::flat_hash_map<const IR::Node *, const IR::Node *, Util::Hash> replacement;
+    size_t envIndex = 0;
+    for (const auto &info : infos)
+        if (!info.candidate && !info.deferred)
+            replacement[info.object] = checkedEnv->objects.at(envIndex++);
+    for (const auto &job : jobs) replacement[job.candidate] = job.checked;
+    IR::Vector<IR::Node> objects;
+    bool rewritten = false;
+    for (const auto *obj : program->objects) {
+        auto it = replacement.find(obj);
+        const IR::Node *repl = it != replacement.end() ? it->second : obj;
+        rewritten |= repl != obj;
+        objects.push_back(repl);
+    }
+    const IR::P4Program *result = program;
+    if (rewritten) {
+        auto *clone = program->clone();
+        clone->objects = std::move(objects);
+        result = clone;
+    }
+    LOG2("Parallel type inference: " << candidates << " independent, " << envObjects.size()
+                                     << " environment, "
+                                     << program->objects.size() - candidates - envObjects.size()
+                                     << " deferred declarations");
+
+    // Phase 3: a serial run over the merged program checks the deferred
+    // declarations (everything else is already in the map and prunes) and
+    // registers the final program with the type map.
+    TypeInference remainder(typeMap, /* readOnly */ false, checkArrays);
+    return result->apply(remainder, getChildContext());
+}
+
+}  // namespace P4
@@ -0,0 +1,61 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef FRONTENDS_P4_TYPECHECKING_PARALLELTYPEINFERENCE_H_
+#define FRONTENDS_P4_TYPECHECKING_PARALLELTYPEINFERENCE_H_
+
+#include "frontends/p4/typeChecking/typeChecker.h"
+#include "frontends/p4/typeMap.h"
+#include "ir/ir.h"
+#include "ir/visitor.h"
+
+namespace P4 {
+
+/// Type-checks a P4Program by partitioning its top-level declarations:
+/// controls and parsers that reference no other control or parser are
+/// independent once the rest of the program has been checked, so they are
+/// inferred on worker threads, each into its own TypeMap seeded from the
+/// shared one; the per-thread maps are merged back at the end.  Declarations
+/// that do depend on a control or parser (e.g. the "main" instance) are
+/// checked by a final serial TypeInference run, which also acts as a safety
+/// net for anything the partition left untyped.
+///
+/// The result is identical to a plain TypeInference run except for the ids of
+/// freshly created nodes, which depend on the thread schedule.  With fewer
+/// than two worker threads (see setParallelism, the default), or when there
+/// are fewer than two independent declarations, the pass degenerates to an
+/// ordinary serial TypeInference.
+class ParallelTypeInference : public Visitor {
+    TypeMap *typeMap;
+    bool checkArrays;
+    static unsigned maxThreads;  // < 2 forces serial execution
+
+    const IR::Node *serialFallback(const IR::Node *node);
+
+ public:
+    explicit ParallelTypeInference(TypeMap *typeMap, bool checkArrays = true)
+        : typeMap(typeMap), checkArrays(checkArrays) {
+        CHECK_NULL(typeMap);
+    }
+    const IR::Node *apply_visitor(const IR::Node *node, const char *name = nullptr) override;
+    /// Number of worker threads used for independent declarations;
+    /// 0 or 1 (the default) force serial execution.
+    static void setParallelism(unsigned threads) { maxThreads = threads; }
+};
+
+}  // namespace P4
+
+#endif /* FRONTENDS_P4_TYPECHECKING_PARALLELTYPEINFERENCE_H_ */
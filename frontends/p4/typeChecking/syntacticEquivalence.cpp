@@ -16,8 +16,60 @@ limitations under the License.
 
 #include "syntacticEquivalence.h"
 
+#include "lib/hash.h"
+
 namespace P4 {
 
+/// Hash everything sameExpression compares structurally, and nothing it compares
+/// semantically: types are left out entirely (they are checked through the TypeMap) and
+/// path expressions contribute only their last name, since equal declarations are always
+/// referenced by the same name.  Equivalent expressions therefore always hash equal, and
+/// a weaker hash is merely less discriminating, never wrong.
+uint64_t SameExpression::structuralHash(const IR::Expression *e) const {
+    if (auto it = hashCache.find(e); it != hashCache.end()) return it->second;
+    uint64_t h = Util::Hash{}(e->node_type_name());
+    if (auto *m = e->to<IR::Member>()) {
+        h = Util::hash_combine(h, Util::Hash{}(m->member.name));
+        h = Util::hash_combine(h, structuralHash(m->expr));
+    } else if (auto *u = e->to<IR::Operation_Unary>()) {
+        h = Util::hash_combine(h, structuralHash(u->expr));
+    } else if (auto *b = e->to<IR::Operation_Binary>()) {
+        h = Util::hash_combine(h, structuralHash(b->left));
+        h = Util::hash_combine(h, structuralHash(b->right));
+    } else if (auto *t = e->to<IR::Operation_Ternary>()) {
+        h = Util::hash_combine(h, structuralHash(t->e0));
+        h = Util::hash_combine(h, structuralHash(t->e1));
+        h = Util::hash_combine(h, structuralHash(t->e2));
+    } else if (auto *c = e->to<IR::Constant>()) {
+        // saturating truncation is fine for a hash
+        h = Util::hash_combine(h, static_cast<uint64_t>(c->value.convert_to<int64_t>()));
+    } else if (auto *bl = e->to<IR::BoolLiteral>()) {
+        h = Util::hash_combine(h, Util::Hash{}(bl->value));
+    } else if (auto *sl = e->to<IR::StringLiteral>()) {
+        h = Util::hash_combine(h, Util::Hash{}(sl->value));
+    } else if (auto *p = e->to<IR::PathExpression>()) {
+        h = Util::hash_combine(h, Util::Hash{}(p->path->name.name));
+    } else if (auto *l = e->to<IR::ListExpression>()) {
+        for (auto *c : l->components) h = Util::hash_combine(h, structuralHash(c));
+    } else if (auto *mc = e->to<IR::MethodCallExpression>()) {
+        h = Util::hash_combine(h, structuralHash(mc->method));
+        h = Util::hash_combine(h, Util::Hash{}(mc->typeArguments->size()));
+        for (auto *arg : *mc->arguments) h = Util::hash_combine(h, structuralHash(arg->expression));
+    } else if (auto *cc = e->to<IR::ConstructorCallExpression>()) {
+        for (auto *arg : *cc->arguments) h = Util::hash_combine(h, structuralHash(arg->expression));
+    } else if (auto *s = e->to<IR::StructExpression>()) {
+        // components are matched by name, so combine them order-independently
+        uint64_t members = 0;
+        for (auto *ne : s->components)
+            members += Util::hash_combine(Util::Hash{}(ne->name.name),
+                                          structuralHash(ne->expression));
+        h = Util::hash_combine(h, members);
+    }
+    // anything else hashes by node type alone
+    hashCache.emplace(e, h);
+    return h;
+}
+
 bool SameExpression::sameType(const IR::Type *left, const IR::Type *right) const {
     auto lt = typeMap->getType(left, true);
     auto rt = typeMap->getType(right, true);
@@ -43,6 +95,15 @@ bool SameExpression::sameExpressions(const IR::Vector<IR::Argument> *left,
 bool SameExpression::sameExpression(const IR::Expression *left, const IR::Expression *right) const {
     CHECK_NULL(left);
     CHECK_NULL(right);
+    if (left == right) return true;
+    // Expressions that originate unmodified from source carry the span of the tokens
+    // they were parsed from (positions are global across the whole input, so a span
+    // identifies its source text uniquely).  Identical valid spans with matching
+    // structural hashes -- e.g. a default_action cloned from its actions-list entry --
+    // are equivalent without walking the trees.
+    if (left->srcInfo.isValid() && left->srcInfo == right->srcInfo &&
+        structuralHash(left) == structuralHash(right))
+        return true;
     if (left->node_type_name() != right->node_type_name()) return false;
     if (auto lu = left->to<IR::Operation_Unary>()) {
         auto ru = right->to<IR::Operation_Unary>();
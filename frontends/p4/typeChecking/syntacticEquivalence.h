@@ -20,6 +20,7 @@ limitations under the License.
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/typeMap.h"
 #include "ir/ir.h"
+#include "lib/hvec_map.h"
 
 namespace P4 {
 
@@ -27,6 +28,11 @@ namespace P4 {
 class SameExpression {
     const DeclarationLookup *refMap;
     const TypeMap *typeMap;
+    /// Memoized structural hashes backing the fast path in sameExpression; keyed by
+    /// node identity, so entries stay valid for the lifetime of this object.
+    mutable hvec_map<const IR::Expression *, uint64_t> hashCache;
+
+    uint64_t structuralHash(const IR::Expression *e) const;
 
  public:
     explicit SameExpression(const DeclarationLookup *refMap, const TypeMap *typeMap)
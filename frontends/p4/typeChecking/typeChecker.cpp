@@ -49,6 +49,28 @@ TypeChecking::TypeChecking(ReferenceMap *refMap, TypeMap *typeMap, bool updateEx
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Looks for type variables anywhere in a type; the unification of types
+/// containing one can depend on the current substitution, so its outcome
+/// must not be memoized.
+class HasTypeVariable : public Inspector {
+ public:
+    bool found = false;
+    bool preorder(const IR::Node *node) override {
+        if (node->is<IR::ITypeVar>()) found = true;
+        return !found;
+    }
+};
+
+bool containsTypeVariable(const IR::Type *type) {
+    HasTypeVariable scan;
+    type->apply(scan);
+    return scan.found;
+}
+
+}  // namespace
+
 bool TypeInferenceBase::learn(const IR::Node *node, Visitor *caller, const Visitor::Context *ctxt) {
     auto *learner = readOnlyClone();
     learner->setCalledBy(caller);
@@ -173,6 +195,10 @@ TypeVariableSubstitution *TypeInferenceBase::unifyBase(
     CHECK_NULL(destType);
     CHECK_NULL(srcType);
     if (srcType == destType) return new TypeVariableSubstitution();
+    if (typeMap->isKnownUnification(destType, srcType, allowCasts)) {
+        LOG3("Unification of " << dbp(srcType) << " with " << dbp(destType) << " memoized");
+        return new TypeVariableSubstitution();
+    }
 
     TypeConstraint *constraint;
     TypeConstraints constraints(typeMap->getSubstitutions(), typeMap);
@@ -184,6 +210,11 @@ TypeVariableSubstitution *TypeInferenceBase::unifyBase(
     constraints.add(constraint);
     auto tvs = constraints.solve();
     addSubstitutions(tvs);
+    // A success that bound nothing for a pair of variable-free types will
+    // repeat itself; remember it so the next solve is a hash lookup.
+    if (tvs != nullptr && tvs->isIdentity() && !containsTypeVariable(destType) &&
+        !containsTypeVariable(srcType))
+        typeMap->addKnownUnification(destType, srcType, allowCasts);
     return tvs;
 }
 
@@ -42,8 +42,10 @@ class ClearTypeMap : public Inspector {
         // otherwise we can reuse it.  The 'force' flag is needed
         // because the program is saved only *after* typechecking,
         // so if the program changes during type-checking, the
-        // typeMap may not be complete.
-        if (force || !typeMap->checkMap(program)) typeMap->clear();
+        // typeMap may not be complete.  In incremental mode the map
+        // may instead retain the entries of unaffected declarations.
+        if (force || (!typeMap->checkMap(program) && !typeMap->tryIncrementalUpdate(program)))
+            typeMap->clear();
         return false;  // prune()
     }
 };
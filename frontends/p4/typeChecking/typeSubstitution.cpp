@@ -24,6 +24,36 @@ limitations under the License.
 namespace P4 {
 using namespace literals;
 
+namespace {
+
+/// Collects the type variables the substitution visitor would replace in a type.
+class TypeVariableCollector : public Inspector {
+ public:
+    ordered_set<const IR::ITypeVar *> vars;
+
+    TypeVariableCollector() { setName("TypeVariableCollector"); }
+    bool preorder(const IR::Type_Var *tv) override {
+        vars.insert(tv);
+        return true;
+    }
+    bool preorder(const IR::Type_InfInt *ti) override {
+        vars.insert(ti);
+        return true;
+    }
+    bool preorder(const IR::Type_Any *ta) override {
+        vars.insert(ta);
+        return true;
+    }
+};
+
+}  // namespace
+
+void TypeVariableSubstitution::trackVariables(const IR::ITypeVar *id, const IR::Type *type) {
+    TypeVariableCollector collector;
+    type->apply(collector);
+    for (const auto *v : collector.vars) dependents[v].insert(id);
+}
+
 // FIXME: see if we can not return format string as cstring here
 cstring TypeVariableSubstitution::compose(const IR::ITypeVar *var, const IR::Type *substitution) {
     LOG3("Adding " << var << "->" << dbp(substitution) << "=" << substitution
@@ -63,17 +93,30 @@ cstring TypeVariableSubstitution::compose(const IR::ITypeVar *var, const IR::Typ
 
     TypeVariableSubstitutionVisitor visitor(tvs);
     bool cycle = false;  // set if we detect X -> V and V -> X substitutions.
-    for (auto &bound : binding) {
-        const IR::Type *type = bound.second;
-        const IR::Node *newType = type->apply(visitor);
-        if (newType == nullptr) return "Could not replace '%1%' with '%2%'"_cs;
-        if (newType == type) continue;
-
-        if (bound.first->asType() == newType) {
-            cycle = true;
-        } else {
-            LOG3("Refining substitution for " << bound.first->getNode() << " to " << newType);
-            bound.second = newType->to<IR::Type>();
+    // Only bindings whose replacement type mentions var can be affected, and the
+    // dependents index knows exactly which those are; every other binding is left
+    // untouched, so long chains of compositions no longer rewrite the whole
+    // substitution at each step.
+    if (auto depIt = dependents.find(var); depIt != dependents.end()) {
+        auto affected = std::move(depIt->second);
+        dependents.erase(depIt);
+        for (const auto *dependent : affected) {
+            auto bound = binding.find(dependent);
+            if (bound == binding.end()) continue;  // entry outlived its binding
+            const IR::Type *type = bound->second;
+            const IR::Node *newType = type->apply(visitor);
+            if (newType == nullptr) return "Could not replace '%1%' with '%2%'"_cs;
+            if (newType == type) continue;
+
+            if (bound->first->asType() == newType) {
+                cycle = true;
+                // var stays unbound below, so this binding still depends on it
+                dependents[var].insert(dependent);
+            } else {
+                LOG3("Refining substitution for " << bound->first->getNode() << " to " << newType);
+                bound->second = newType->to<IR::Type>();
+                trackVariables(bound->first, bound->second);
+            }
         }
     }
 
@@ -97,6 +140,7 @@ void TypeVariableSubstitution::simpleCompose(const TypeVariableSubstitution *oth
             BUG("Changing binding for %1% from %2% to %3%", v.first, it->second, subst);
         LOG3("Setting substitution for " << v.first->getNode() << " to " << subst);
         binding[v.first] = subst;
+        trackVariables(v.first, subst);
     }
     debugValidate();
 }
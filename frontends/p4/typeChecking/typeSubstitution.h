@@ -22,6 +22,9 @@ limitations under the License.
 
 #include "ir/ir.h"
 #include "lib/exceptions.h"
+#include "lib/ordered_flat_map.h"
+#include "lib/ordered_map.h"
+#include "lib/ordered_set.h"
 
 namespace P4 {
 
@@ -29,7 +32,10 @@ namespace P4 {
 template <class T>
 class TypeSubstitution : public IHasDbPrint {
  protected:
-    ordered_map<T, const IR::Type *> binding;
+    /// Substitutions are small, lookup-dominated and built afresh for every
+    /// unification, so flat storage beats the node-based ordered_map here.
+    using Bindings = ordered_flat_map<T, const IR::Type *>;
+    Bindings binding;
 
  public:
     TypeSubstitution() = default;
@@ -71,6 +77,16 @@ class TypeSubstitution : public IHasDbPrint {
 };
 
 class TypeVariableSubstitution final : public TypeSubstitution<const IR::ITypeVar *> {
+    /// For each unbound variable, the bound variables whose replacement types mention
+    /// it.  compose() must refine exactly those bindings when the variable is bound;
+    /// the index lets it skip the rest instead of rewriting the whole substitution on
+    /// every step.  Entries may linger after a binding was refined away from a
+    /// variable; compose() tolerates that, so the index is conservative, never stale.
+    ordered_map<const IR::ITypeVar *, ordered_set<const IR::ITypeVar *>> dependents;
+
+    /// Record @id as depending on every type variable occurring in @type.
+    void trackVariables(const IR::ITypeVar *id, const IR::Type *type);
+
  public:
     TypeVariableSubstitution() = default;
     TypeVariableSubstitution(const TypeVariableSubstitution &other) = default;
@@ -86,6 +102,7 @@ class TypeVariableSubstitution final : public TypeSubstitution<const IR::ITypeVa
     void debugValidate();
     bool setBinding(const IR::ITypeVar *id, const IR::Type *type) override {
         auto result = TypeSubstitution::setBinding(id, type);
+        if (result) trackVariables(id, type);
         debugValidate();
         return result;
     }
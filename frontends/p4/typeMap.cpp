@@ -16,6 +16,8 @@ limitations under the License.
 
 #include "typeMap.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace P4 {
 
 bool TypeMap::typeIsEmpty(const IR::Type *type) const {
@@ -46,7 +48,9 @@ bool TypeMap::typeIsEmpty(const IR::Type *type) const {
 
 void TypeMap::dbprint(std::ostream &out) const {
     out << "TypeMap for " << dbp(program) << std::endl;
-    for (auto it : typeMap) out << "\t" << dbp(it.first) << "->" << dbp(it.second) << std::endl;
+    typeMap.forEach([&out](const IR::Node *node, const IR::Type *type) {
+        out << "\t" << dbp(node) << "->" << dbp(type) << std::endl;
+    });
     out << "Left values" << std::endl;
     for (auto it : leftValues) out << "\t" << dbp(it) << std::endl;
     out << "Constants" << std::endl;
@@ -80,6 +84,14 @@ void TypeMap::cloneExpressionProperties(const IR::Expression *to, const IR::Expr
     if (isCompileTimeConstant(from)) setCompileTimeConstant(to);
 }
 
+void TypeMap::copyEntriesFrom(const TypeMap &other) {
+    strictStruct = other.strictStruct;
+    other.typeMap.forEach(
+        [this](const IR::Node *node, const IR::Type *type) { typeMap.emplace(node, type); });
+    leftValues.insert(other.leftValues.begin(), other.leftValues.end());
+    constants.insert(other.constants.begin(), other.constants.end());
+}
+
 void TypeMap::clear() {
     LOG3("Clearing typeMap");
     typeMap.clear();
@@ -90,6 +102,144 @@ void TypeMap::clear() {
     ProgramMap::clear();
 }
 
+namespace {
+
+/// Collects every node of a subtree, so that its map entries can be dropped.
+class CollectSubtree : public Inspector {
+ public:
+    std::vector<const IR::Node *> nodes;
+    CollectSubtree() { visitDagOnce = true; }
+    bool preorder(const IR::Node *node) override {
+        nodes.push_back(node);
+        return true;
+    }
+};
+
+/// Collects all names referenced anywhere in a subtree.
+class CollectReferencedNames : public Inspector {
+ public:
+    absl::flat_hash_set<cstring, Util::Hash> names;
+    bool preorder(const IR::Path *path) override {
+        names.insert(path->name.name);
+        return true;
+    }
+};
+
+/// True if replacing @oldNode with @newNode cannot change the types seen by
+/// declarations referencing it by name: bodies of controls, parsers, actions
+/// and functions may change freely as long as their signature nodes are the
+/// same.  Any other change invalidates the referrers.
+bool sameInterface(const IR::Node *oldNode, const IR::Node *newNode) {
+    if (const auto *oc = oldNode->to<IR::P4Control>()) {
+        const auto *nc = newNode->to<IR::P4Control>();
+        return nc != nullptr && oc->type == nc->type &&
+               oc->constructorParams == nc->constructorParams;
+    }
+    if (const auto *op = oldNode->to<IR::P4Parser>()) {
+        const auto *np = newNode->to<IR::P4Parser>();
+        return np != nullptr && op->type == np->type &&
+               op->constructorParams == np->constructorParams;
+    }
+    if (const auto *oa = oldNode->to<IR::P4Action>()) {
+        const auto *na = newNode->to<IR::P4Action>();
+        return na != nullptr && oa->parameters == na->parameters;
+    }
+    if (const auto *of = oldNode->to<IR::Function>()) {
+        const auto *nf = newNode->to<IR::Function>();
+        return nf != nullptr && of->type == nf->type;
+    }
+    return false;
+}
+
+}  // namespace
+
+void TypeMap::forgetSubtree(const IR::Node *root) {
+    CollectSubtree nodes;
+    root->apply(nodes);
+    for (const auto *node : nodes.nodes) {
+        typeMap.erase(node);
+        if (const auto *expression = node->to<IR::Expression>()) {
+            leftValues.erase(expression);
+            constants.erase(expression);
+        }
+    }
+}
+
+bool TypeMap::tryIncrementalUpdate(const IR::Node *node) {
+    if (!incremental) return false;
+    const auto *newProgram = node ? node->to<IR::P4Program>() : nullptr;
+    const auto *oldProgram = program ? program->to<IR::P4Program>() : nullptr;
+    if (newProgram == nullptr || oldProgram == nullptr || program == fake) return false;
+
+    // Match top-level declarations by name; bail out to a full recompute if
+    // the programs cannot be matched unambiguously (e.g. overloaded names).
+    absl::flat_hash_map<cstring, const IR::Node *, Util::Hash> oldDecls;
+    for (const auto *obj : oldProgram->objects) {
+        const auto *decl = obj->to<IR::IDeclaration>();
+        if (decl == nullptr || !oldDecls.emplace(decl->getName().name, obj).second) return false;
+    }
+
+    /// Names whose exported type may have changed.
+    absl::flat_hash_set<cstring, Util::Hash> dirty;
+    std::vector<const IR::Node *> unchanged, replaced;
+    for (const auto *obj : newProgram->objects) {
+        const auto *decl = obj->to<IR::IDeclaration>();
+        if (decl == nullptr) return false;
+        auto it = oldDecls.find(decl->getName().name);
+        if (it == oldDecls.end()) continue;  // a new declaration: nothing is cached for it
+        if (it->second == obj) {
+            unchanged.push_back(obj);
+        } else {
+            replaced.push_back(obj);
+            if (!sameInterface(it->second, obj)) dirty.insert(decl->getName().name);
+        }
+    }
+
+    // Propagate dirtiness to a fixpoint: an unchanged declaration referencing
+    // a dirty name must be re-inferred, and its own users may in turn see
+    // different types.
+    std::vector<std::tuple<const IR::Node *, cstring, absl::flat_hash_set<cstring, Util::Hash>>>
+        references;
+    for (const auto *obj : unchanged) {
+        CollectReferencedNames refs;
+        obj->apply(refs);
+        references.emplace_back(obj, obj->to<IR::IDeclaration>()->getName().name,
+                                std::move(refs.names));
+    }
+    absl::flat_hash_set<const IR::Node *, Util::Hash> stale;
+    bool changedSomething = true;
+    while (changedSomething) {
+        changedSomething = false;
+        for (const auto &[obj, name, refs] : references) {
+            if (stale.count(obj)) continue;
+            for (cstring ref : refs) {
+                if (!dirty.count(ref)) continue;
+                stale.insert(obj);
+                dirty.insert(name);
+                changedSomething = true;
+                break;
+            }
+        }
+    }
+
+    // Re-inferring an unchanged generic declaration would re-bind its own
+    // type variables, which the substitution machinery rejects.
+    for (const auto *obj : stale) {
+        if (const auto *generic = obj->to<IR::IMayBeGenericType>())
+            if (!generic->getTypeParameters()->empty()) return false;
+    }
+
+    // Forget everything that needs re-inference.  Replaced declarations may
+    // reuse inner nodes whose environment changed, so their whole (new)
+    // subtree is dropped too.
+    for (const auto *obj : replaced) forgetSubtree(obj);
+    for (const auto *obj : stale) forgetSubtree(obj);
+    LOG2("TypeMap retained incrementally; " << unchanged.size() - stale.size() << " of "
+                                            << newProgram->objects.size()
+                                            << " declarations reused");
+    return true;
+}
+
 void TypeMap::checkPrecondition(const IR::Node *element, const IR::Type *type) const {
     CHECK_NULL(element);
     CHECK_NULL(type);
@@ -99,9 +249,8 @@ void TypeMap::checkPrecondition(const IR::Node *element, const IR::Type *type) c
 
 void TypeMap::setType(const IR::Node *element, const IR::Type *type) {
     checkPrecondition(element, type);
-    auto [it, inserted] = typeMap.emplace(element, type);
+    auto [existingType, inserted] = typeMap.emplace(element, type);
     if (!inserted) {
-        const IR::Type *existingType = it->second;
         if (!implicitlyConvertibleTo(type, existingType))
             BUG("Changing type of %1% in type map from %2% to %3%", dbp(element), dbp(existingType),
                 dbp(type));
@@ -112,7 +261,7 @@ void TypeMap::setType(const IR::Node *element, const IR::Type *type) {
 
 const IR::Type *TypeMap::getType(const IR::Node *element, bool notNull) const {
     CHECK_NULL(element);
-    const auto *result = get(typeMap, element);
+    const auto *result = typeMap.get(element);
     LOG4("Looking up type for " << dbp(element) << " => " << dbp(result));
     if (notNull && result == nullptr)
         BUG_CHECK(errorCount() > 0, "Could not find type for %1%", dbp(element));
@@ -334,23 +483,28 @@ bool TypeMap::implicitlyConvertibleTo(const IR::Type *from, const IR::Type *to)
 
 // Used for tuples, stacks and lists only
 const IR::Type *TypeMap::getCanonical(const IR::Type *type) {
-    // Currently a linear search; hopefully this won't be too expensive in practice
-    std::vector<const IR::Type *> *searchIn;
-    if (type->is<IR::Type_Array>())
-        searchIn = &canonicalStacks;
-    else if (type->is<IR::Type_Tuple>())
-        searchIn = &canonicalTuples;
-    else if (type->is<IR::Type_List>())
-        searchIn = &canonicalLists;
-    else if (type->is<IR::Type_P4List>())
-        searchIn = &canonicalP4lists;
-    else
-        BUG("%1%: unexpected type", type);
+    BUG_CHECK(type->is<IR::Type_Array>() || type->is<IR::Type_Tuple>() ||
+                  type->is<IR::Type_List>() || type->is<IR::Type_P4List>(),
+              "%1%: unexpected type", type);
+    // Equivalent types agree on their outermost and component node kinds, so
+    // a shallow fingerprint of those selects the only bucket that can contain
+    // an equivalent candidate.
+    Util::Hash hash;
+    uint64_t fingerprint = hash(type->node_type_name());
+    if (const auto *list = type->to<IR::Type_BaseList>()) {
+        for (const auto *component : list->components)
+            fingerprint = Util::hash_combine(fingerprint, hash(component->node_type_name()));
+    } else if (const auto *stack = type->to<IR::Type_Array>()) {
+        fingerprint = Util::hash_combine(fingerprint, hash(stack->elementType->node_type_name()));
+    } else if (const auto *p4list = type->to<IR::Type_P4List>()) {
+        fingerprint = Util::hash_combine(fingerprint, hash(p4list->elementType->node_type_name()));
+    }
 
-    for (auto t : *searchIn) {
+    auto &bucket = canonicalTypes[fingerprint];
+    for (const auto *t : bucket) {
         if (equivalent(type, t, true)) return t;
     }
-    searchIn->push_back(type);
+    bucket.push_back(type);
     return type;
 }
 
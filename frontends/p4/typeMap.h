@@ -17,6 +17,12 @@ limitations under the License.
 #ifndef FRONTENDS_P4_TYPEMAP_H_
 #define FRONTENDS_P4_TYPEMAP_H_
 
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "frontends/common/programMap.h"
@@ -39,15 +45,87 @@ Objects that have a type in the map:
 - type declarations - map name to the actual type
 */
 class TypeMap final : public ProgramMap {
-    // We want to have the same canonical type for two
-    // different tuples, lists, stacks, or p4lists with the same signature.
-    std::vector<const IR::Type *> canonicalTuples;
-    std::vector<const IR::Type *> canonicalStacks;
-    std::vector<const IR::Type *> canonicalP4lists;
-    std::vector<const IR::Type *> canonicalLists;
+    /// Maps nodes to types through flat pages indexed by IR::Node::id.  Ids
+    /// are unique and assigned sequentially, so the key space is dense and a
+    /// lookup is a single index load instead of a hash probe.  Entries carry a
+    /// generation tag; clear() just bumps the generation, leaving the pages in
+    /// place for the next program.
+    class NodeTypeTable {
+        struct Entry {
+            uint32_t generation = 0;
+            const IR::Node *node = nullptr;
+            const IR::Type *type = nullptr;
+        };
+        static constexpr size_t pageSize = 1 << 12;
+        std::vector<std::unique_ptr<Entry[]>> pages;
+        uint32_t generation = 1;
+        size_t entries = 0;
+
+        Entry *find(const IR::Node *n) const {
+            size_t id = n->id;
+            size_t page = id / pageSize;
+            if (page >= pages.size() || pages[page] == nullptr) return nullptr;
+            Entry *entry = &pages[page][id % pageSize];
+            return entry->generation == generation && entry->type != nullptr ? entry : nullptr;
+        }
+
+     public:
+        const IR::Type *get(const IR::Node *n) const {
+            const Entry *entry = find(n);
+            return entry != nullptr ? entry->type : nullptr;
+        }
+        /// If @n already has a type return it and false, else record @type
+        /// and return it with true.
+        std::pair<const IR::Type *, bool> emplace(const IR::Node *n, const IR::Type *type) {
+            size_t id = n->id;
+            size_t page = id / pageSize;
+            if (page >= pages.size()) pages.resize(page + 1);
+            if (pages[page] == nullptr) pages[page] = std::make_unique<Entry[]>(pageSize);
+            Entry &entry = pages[page][id % pageSize];
+            if (entry.generation == generation && entry.type != nullptr)
+                return {entry.type, false};
+            entry = {generation, n, type};
+            ++entries;
+            return {type, true};
+        }
+        void erase(const IR::Node *n) {
+            if (Entry *entry = find(n)) {
+                entry->type = nullptr;
+                --entries;
+            }
+        }
+        size_t size() const { return entries; }
+        void clear() {
+            ++generation;
+            entries = 0;
+        }
+        /// Invoke @func on every (node, type) pair in the table.
+        template <typename Func>
+        void forEach(Func func) const {
+            for (const auto &page : pages) {
+                if (page == nullptr) continue;
+                for (size_t i = 0; i < pageSize; i++)
+                    if (page[i].generation == generation && page[i].type != nullptr)
+                        func(page[i].node, page[i].type);
+            }
+        }
+    };
+
+    // We want to have the same canonical type for two different tuples,
+    // lists, stacks, or p4lists with the same signature.  Candidates are
+    // bucketed by a shallow structural fingerprint; only a bucket needs to be
+    // searched with the deep equivalence check.
+    absl::flat_hash_map<uint64_t, std::vector<const IR::Type *>, Util::Hash> canonicalTypes;
+
+    /// Unifications that succeeded without binding any type variable, keyed
+    /// on the two types, the cast-allowed flag and the strictStruct mode.
+    /// Such unifications are pure structural facts, so re-solving them can be
+    /// skipped; see isKnownUnification.
+    using UnificationKey = std::tuple<const IR::Type *, const IR::Type *, bool, bool>;
+    absl::flat_hash_set<UnificationKey, Util::Hash> successfulUnifications;
 
     // Map each node to its canonical type
-    absl::flat_hash_map<const IR::Node *, const IR::Type *, Util::Hash> typeMap;
+    NodeTypeTable typeMap;
     // All left-values in the program.
     absl::flat_hash_set<const IR::Expression *, Util::Hash> leftValues;
     // All compile-time constants.  A compile-time constant
@@ -61,6 +139,12 @@ class TypeMap final : public ProgramMap {
     // checks some preconditions before setting the type
     void checkPrecondition(const IR::Node *element, const IR::Type *type) const;
 
+    /// If true, tryIncrementalUpdate may retain entries across program changes.
+    bool incremental = false;
+
+    /// Drop all entries referring to nodes in the subtree rooted at @root.
+    void forgetSubtree(const IR::Node *root);
+
  public:
     TypeMap() : ProgramMap("TypeMap"), strictStruct(false) {}
 
@@ -68,19 +152,37 @@ class TypeMap final : public ProgramMap {
     /// equivalent, if false only that the have the same fields.
     bool strictStruct;
     void setStrictStruct(bool value) { strictStruct = value; }
-    bool contains(const IR::Node *element) { return typeMap.count(element) != 0; }
+    bool contains(const IR::Node *element) { return typeMap.get(element) != nullptr; }
     void setType(const IR::Node *element, const IR::Type *type);
     const IR::Type *getType(const IR::Node *element, bool notNull = false) const;
     // unwraps a TypeType into its contents
     const IR::Type *getTypeType(const IR::Node *element, bool notNull) const;
     void dbprint(std::ostream &out) const override;
     void clear();
+    /// Enable incremental mode: when the program changes, ClearTypeMap first
+    /// offers the map a chance to retain the entries of unaffected subtrees.
+    void setIncremental(bool value) { incremental = value; }
+    /// Called when the map was computed for a different program than @node.
+    /// Diffs the top-level declarations of the two programs: declarations that
+    /// are pointer-identical and reference (transitively) no changed
+    /// declaration keep their entries, everything else is forgotten and will
+    /// be re-inferred.  @return true if the map was retained, false if the
+    /// caller should clear() it (also the answer whenever the programs cannot
+    /// be matched up or incremental mode is off).
+    bool tryIncrementalUpdate(const IR::Node *node);
     bool isLeftValue(const IR::Expression *expression) const {
         return leftValues.count(expression) > 0;
     }
     bool isCompileTimeConstant(const IR::Expression *expression) const;
     size_t size() const { return typeMap.size(); }
 
+    /// Copy every node type, left-value and constant flag (and the
+    /// strictStruct setting) from @other into this map; nodes already present
+    /// keep their entries.  Type variable substitutions are not copied - use
+    /// addSubstitutions for those.  This is used to seed and to merge the
+    /// per-thread maps of parallel type checking.
+    void copyEntriesFrom(const TypeMap &other);
+
     void setLeftValue(const IR::Expression *expression);
     void cloneExpressionProperties(const IR::Expression *to, const IR::Expression *from);
     void setCompileTimeConstant(const IR::Expression *expression);
@@ -101,6 +203,19 @@ class TypeMap final : public ProgramMap {
 
     // Used for tuples and stacks only
     const IR::Type *getCanonical(const IR::Type *type);
+
+    /// True if unifying @src with @dest (with @allowCasts) is already known
+    /// to succeed without binding type variables, so the caller may skip
+    /// constraint solving altogether.
+    bool isKnownUnification(const IR::Type *dest, const IR::Type *src, bool allowCasts) const {
+        return successfulUnifications.contains({dest, src, allowCasts, strictStruct});
+    }
+    /// Record such a unification.  Only sound for type pairs that contain no
+    /// type variables: their unification cannot depend on the current
+    /// substitution, so the outcome never changes.
+    void addKnownUnification(const IR::Type *dest, const IR::Type *src, bool allowCasts) {
+        successfulUnifications.insert({dest, src, allowCasts, strictStruct});
+    }
     /// The width in bits of this type.  If the width is not
     /// well-defined this will report an error and return -1.
     /// max indicates whether we want the max width or min width.
@@ -33,27 +33,32 @@ Visitor::profile_t UnusedDeclarations::init_apply(const IR::Node *node) {
     return Transform::init_apply(node);
 }
 
+void CollectUsedDeclarations::record(const IR::IDeclaration *decl) {
+    used.setUsed(decl);
+    if (graph != nullptr) graph->addReference(findContext<IR::IDeclaration>(), decl);
+}
+
 bool CollectUsedDeclarations::preorder(const IR::KeyElement *ke) {
     visit(ke->annotations, "annotations");
     visit(ke->expression, "expression");
 
     auto decls = lookupMatchKind(ke->matchType->path->name);
     BUG_CHECK(decls.size() == 1, "");
-    used.setUsed(decls.front());
+    record(decls.front());
 
     return false;
 }
 
 bool CollectUsedDeclarations::preorder(const IR::PathExpression *path) {
     auto decl = resolvePath(path->path, false);
-    if (decl) used.setUsed(decl);
+    if (decl) record(decl);
 
     return true;
 }
 
 bool CollectUsedDeclarations::preorder(const IR::Type_Name *type) {
     auto decl = resolvePath(type->path, true);
-    if (decl) used.setUsed(decl);
+    if (decl) record(decl);
 
     return true;
 }
@@ -245,4 +250,61 @@ const IR::Node *UnusedDeclarations::preorder(IR::ParserState *state) {
 // backend may synthesize code to use the extern functions.
 const IR::Node *UnusedDeclarations::preorder(IR::Method *method) { return method; }
 
+namespace {
+
+/// Collects every declaration in a subtree; used to propagate the removal of
+/// the declarations nested inside a removed one.
+class CollectNestedDeclarations : public Inspector {
+    std::vector<const IR::IDeclaration *> &out;
+
+ public:
+    explicit CollectNestedDeclarations(std::vector<const IR::IDeclaration *> &out) : out(out) {}
+
+    bool preorder(const IR::Node *node) override {
+        if (const auto *decl = node->to<IR::IDeclaration>()) out.push_back(decl);
+        return true;
+    }
+};
+
+}  // namespace
+
+RemoveAllUnusedDeclarations::RemoveAllUnusedDeclarations(const RemoveUnusedPolicy &policy,
+                                                         bool infoRemoved) {
+    setName("RemoveAllUnusedDeclarations");
+    auto *remove = policy.getUnusedDeclarationsPass(used, true, false, infoRemoved);
+    remove->setOnNodeTransformedHook([this](const IR::Node *from, const IR::Node *to) {
+        if (!from->is<IR::IDeclaration>()) return;
+        if (to == nullptr)
+            removed.push_back(from);
+        else if (to->is<IR::IDeclaration>())
+            renamed.emplace_back(from, to);
+    });
+    // Collect the used set and the reference edges once; each subsequent
+    // iteration removes declarations and then propagates the references that
+    // disappeared with them, so only genuinely affected declarations are
+    // reconsidered until the fixpoint.
+    addPasses({[this]() {
+                   // The pass instance may be applied repeatedly; drop logs
+                   // left over from an aborted earlier application.
+                   removed.clear();
+                   renamed.clear();
+               },
+               new CollectUsedDeclarations(used, &graph),
+               new PassRepeated({remove, [this]() { propagateRemovals(); }})});
+    setStopOnError(true);
+}
+
+void RemoveAllUnusedDeclarations::propagateRemovals() {
+    for (const auto &[from, to] : renamed)
+        graph.renamed(from->to<IR::IDeclaration>(), to->to<IR::IDeclaration>(), used);
+    renamed.clear();
+
+    std::vector<const IR::IDeclaration *> gone;
+    CollectNestedDeclarations nested(gone);
+    for (const auto *node : removed) node->apply(nested);
+    removed.clear();
+
+    for (const auto *decl : gone) graph.declarationRemoved(decl, used);
+}
+
 }  // namespace P4
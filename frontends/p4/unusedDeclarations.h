@@ -18,6 +18,7 @@ limitations under the License.
 #define FRONTENDS_P4_UNUSEDDECLARATIONS_H_
 
 #include "../common/resolveReferences/resolveReferences.h"
+#include "absl/container/flat_hash_map.h"
 #include "ir/ir.h"
 #include "ir/pass_manager.h"
 #include "lib/stringify.h"
@@ -33,6 +34,8 @@ class UsedDeclSet : public IHasDbPrint {
  public:
     bool setUsed(const IR::IDeclaration *decl) { return usedDecls.emplace(decl).second; }
 
+    void setUnused(const IR::IDeclaration *decl) { usedDecls.erase(decl); }
+
     [[nodiscard]] auto begin() const { return usedDecls.begin(); }
 
     [[nodiscard]] auto end() const { return usedDecls.end(); }
@@ -45,6 +48,92 @@ class UsedDeclSet : public IHasDbPrint {
     bool isUsed(const IR::IDeclaration *decl) const { return usedDecls.contains(decl); }
 };
 
+/** @brief Reference edges between declarations, collected alongside the used set.
+ *
+ * RemoveAllUnusedDeclarations uses the edges to update the used set by
+ * worklist propagation when declarations are removed: the references made
+ * from inside a removed declaration are dropped, and declarations whose last
+ * reference went away become unused, without re-collecting references over
+ * the unchanged rest of the program on every iteration.
+ */
+class DeclarationUseGraph {
+    /// Number of references to each declaration, keyed by the node seen at
+    /// collection time.
+    absl::flat_hash_map<const IR::IDeclaration *, unsigned, Util::Hash> refCount;
+
+    /// For each declaration, the declarations referenced from its subtree
+    /// (attributed to the nearest enclosing declaration; one entry per
+    /// reference). References made outside any declaration have no edge and
+    /// thus never go away.
+    absl::flat_hash_map<const IR::IDeclaration *, std::vector<const IR::IDeclaration *>,
+                        Util::Hash>
+        edges;
+
+    /// Maps clones introduced by the removal transform back to the node seen
+    /// at collection time.
+    absl::flat_hash_map<const IR::IDeclaration *, const IR::IDeclaration *, Util::Hash> aliasOf;
+
+    /// Inverse of @aliasOf: all later identities of a collected declaration,
+    /// needed to drop every name of a declaration from the used set.
+    absl::flat_hash_map<const IR::IDeclaration *, std::vector<const IR::IDeclaration *>,
+                        Util::Hash>
+        aliases;
+
+    /// Declarations whose removal was already propagated.
+    absl::flat_hash_set<const IR::IDeclaration *, Util::Hash> removed;
+
+    const IR::IDeclaration *canonical(const IR::IDeclaration *decl) const {
+        auto it = aliasOf.find(decl);
+        return it == aliasOf.end() ? decl : it->second;
+    }
+
+ public:
+    void clear() {
+        refCount.clear();
+        edges.clear();
+        aliasOf.clear();
+        aliases.clear();
+        removed.clear();
+    }
+
+    /// Records a reference to @to made from inside declaration @from (which
+    /// may be null for references outside any declaration).
+    void addReference(const IR::IDeclaration *from, const IR::IDeclaration *to) {
+        ++refCount[to];
+        if (from != nullptr) edges[from].push_back(to);
+    }
+
+    /// The removal transform replaced @from by @to without removing it; keep
+    /// the new identity resolvable and visible in @used.
+    void renamed(const IR::IDeclaration *from, const IR::IDeclaration *to, UsedDeclSet &used) {
+        const auto *c = canonical(from);
+        aliasOf[to] = c;
+        aliases[c].push_back(to);
+        if (used.isUsed(c)) used.setUsed(to);
+    }
+
+    /// Declaration @decl was removed: drop the references its subtree made
+    /// and mark declarations whose last reference disappeared as unused.
+    void declarationRemoved(const IR::IDeclaration *decl, UsedDeclSet &used) {
+        const auto *c = canonical(decl);
+        if (!removed.emplace(c).second) return;
+        auto it = edges.find(c);
+        if (it == edges.end()) return;
+        for (const auto *target : it->second) {
+            const auto *t = canonical(target);
+            auto cnt = refCount.find(t);
+            if (cnt == refCount.end() || cnt->second == 0) continue;
+            if (--cnt->second == 0) {
+                used.setUnused(t);
+                auto al = aliases.find(t);
+                if (al != aliases.end())
+                    for (const auto *a : al->second) used.setUnused(a);
+            }
+        }
+        edges.erase(it);
+    }
+};
+
 class RemoveUnusedPolicy {
  public:
     virtual ~RemoveUnusedPolicy() = default;
@@ -56,17 +145,27 @@ class RemoveUnusedPolicy {
 };
 
 /// @brief Collects all used declarations into @used set
+///
+/// When @graph is provided, additionally records a reference edge from the
+/// nearest enclosing declaration for every resolved reference, so the caller
+/// can later propagate removals without re-running the collection.
 class CollectUsedDeclarations : public Inspector, ResolutionContext {
     UsedDeclSet &used;
+    DeclarationUseGraph *graph;
+
+    /// Marks @decl used and records the reference edge when tracking edges.
+    void record(const IR::IDeclaration *decl);
 
  public:
-    explicit CollectUsedDeclarations(UsedDeclSet &used) : used(used) {}
+    explicit CollectUsedDeclarations(UsedDeclSet &used, DeclarationUseGraph *graph = nullptr)
+        : used(used), graph(graph) {}
 
     // We might be invoked in PassRepeated scenario, so the used set should be
     // force cleared.
     Visitor::profile_t init_apply(const IR::Node *node) override {
         auto rv = Inspector::init_apply(node);
         used.clear();
+        if (graph != nullptr) graph->clear();
 
         return rv;
     }
@@ -192,19 +291,27 @@ class UnusedDeclarations : public Transform, ResolutionContext {
 };
 
 /** @brief Iterates UnusedDeclarations until convergence.
+ *
+ * References are collected once; afterwards each iteration only removes
+ * declarations and propagates the references that disappeared with them
+ * through the DeclarationUseGraph, instead of re-scanning unchanged code, so
+ * reaching the fixpoint costs time proportional to the removed code.
  */
 class RemoveAllUnusedDeclarations : public PassManager {
     UsedDeclSet used;
+    DeclarationUseGraph graph;
+
+    /// Declarations removed and identities changed by the last removal
+    /// iteration, captured via the transform's node-transformed hook.
+    std::vector<const IR::Node *> removed;
+    std::vector<std::pair<const IR::Node *, const IR::Node *>> renamed;
+
+    /// Updates @used from @removed / @renamed by worklist propagation.
+    void propagateRemovals();
 
  public:
     explicit RemoveAllUnusedDeclarations(const RemoveUnusedPolicy &policy,
-                                         bool infoRemoved = false) {
-        setName("RemoveAllUnusedDeclarations");
-        addPasses(
-            {new PassRepeated({new CollectUsedDeclarations(used),
-                               policy.getUnusedDeclarationsPass(used, true, false, infoRemoved)})});
-        setStopOnError(true);
-    }
+                                         bool infoRemoved = false);
 };
 
 /** @brief Emits warnings about unused instances without modifying IR.
@@ -60,7 +60,12 @@ class ValidateParsedProgram final : public Inspector {
                             const IR::ParameterList *constr);
 
  public:
-    ValidateParsedProgram() { setName("ValidateParsedProgram"); }
+    ValidateParsedProgram() {
+        setName("ValidateParsedProgram");
+        // A freshly parsed program is a tree (only cached leaf types are
+        // shared), so the visited tracker is pure overhead here.
+        neverRevisit = true;
+    }
     void end_apply(const IR::Node *) override { annNames.clear(); }
     void postorder(const IR::Annotation *annotations) override;
     void postorder(const IR::P4Program *program) override;
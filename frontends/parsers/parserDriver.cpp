@@ -1,8 +1,12 @@
 #include "parserDriver.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <cerrno>
 #include <cstdio>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string_view>
 
@@ -67,6 +71,51 @@ struct AutoStdioInputStream {
 
 #endif
 
+namespace {
+
+/// A streambuf whose get area is an existing memory region; reading through it
+/// copies nothing.
+class MemoryBuffer : public std::streambuf {
+ public:
+    MemoryBuffer(char *base, size_t size) { setg(base, base, base + size); }
+};
+
+/// A RAII helper class that maps a regular input file into memory and exposes
+/// the mapping as an istream, so the lexer scans the kernel's page cache in
+/// place instead of copying the whole source through stdio buffers.  Piped
+/// input (e.g. from the preprocessor) cannot be mapped; create() returns null
+/// and the caller falls back to AutoStdioInputStream.
+class AutoMmapInputStream {
+    char *base;
+    size_t length;
+    MemoryBuffer buffer;
+    std::istream stream;
+
+    AutoMmapInputStream(char *base, size_t length, size_t skip)
+        : base(base), length(length), buffer(base + skip, length - skip), stream(&buffer) {}
+
+ public:
+    static std::unique_ptr<AutoMmapInputStream> create(FILE *in) {
+        int fd = fileno(in);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+            return nullptr;
+        // respect whatever the caller has already consumed through stdio
+        off_t pos = ftello(in);
+        if (pos < 0 || pos >= st.st_size) return nullptr;
+        void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) return nullptr;
+        return std::unique_ptr<AutoMmapInputStream>(
+            new AutoMmapInputStream(static_cast<char *>(mapped), st.st_size, pos));
+    }
+
+    ~AutoMmapInputStream() { munmap(base, length); }
+
+    std::istream &get() { return stream; }
+};
+
+}  // namespace
+
 namespace P4 {
 
 AbstractParserDriver::AbstractParserDriver() : sources(new Util::InputSources()) {}
@@ -150,10 +199,54 @@ bool P4ParserDriver::parse(AbstractP4Lexer &lexer, std::string_view sourceFile,
 
 /* static */ const IR::P4Program *P4ParserDriver::parse(FILE *in, std::string_view sourceFile,
                                                         unsigned sourceLine /* = 1 */) {
+    if (auto mapped = AutoMmapInputStream::create(in))
+        return parse(mapped->get(), sourceFile, sourceLine);
     AutoStdioInputStream inputStream(in);
     return parse(inputStream.get(), sourceFile, sourceLine);
 }
 
+void P4ParserDriver::declareProgramSymbols(const IR::P4Program *program) {
+    for (const auto *node : program->objects) {
+        if (const auto *ext = node->to<IR::Type_Extern>()) {
+            // Externs form a namespace: method symbols must be visible so that
+            // calls of generic methods (e.g. packet.extract<H>(...)) lex their
+            // '<' as template arguments.
+            structure->pushContainerType(ext->name, /* allowDuplicates */ true);
+            for (const auto *method : ext->methods) {
+                structure->declareObject(method->name, cstring::empty);
+                if (!method->type->typeParameters->empty())
+                    structure->markAsTemplate(method->name);
+            }
+            structure->pop();
+            if (!ext->typeParameters->empty()) structure->markAsTemplate(ext->name);
+        } else if (const auto *td = node->to<IR::Type_Declaration>()) {
+            structure->declareType(td->name);
+            if (const auto *generic = node->to<IR::IMayBeGenericType>())
+                if (!generic->getTypeParameters()->empty()) structure->markAsTemplate(td->name);
+        } else if (const auto *method = node->to<IR::Method>()) {
+            structure->declareObject(method->name, cstring::empty);
+            if (!method->type->typeParameters->empty()) structure->markAsTemplate(method->name);
+        } else if (const auto *decl = node->to<IR::Declaration>()) {
+            structure->declareObject(decl->name, cstring::empty);
+        }
+    }
+}
+
+/* static */ const IR::P4Program *P4ParserDriver::parse(std::istream &in,
+                                                        std::string_view sourceFile,
+                                                        const IR::P4Program *prefix,
+                                                        unsigned sourceLine /* = 1 */) {
+    LOG1("Parsing P4-16 program " << sourceFile << " after precompiled prefix");
+
+    P4ParserDriver driver;
+    if (prefix != nullptr) driver.declareProgramSymbols(prefix);
+    P4Lexer lexer(in);
+    if (!driver.parse(lexer, sourceFile, sourceLine)) return nullptr;
+    IR::P4Program *rv = driver.result->to<IR::P4Program>();
+    BUG_CHECK(rv, "parse result is not a program?");
+    return rv;
+}
+
 /* static */ std::pair<const IR::P4Program *, const Util::InputSources *>
 P4ParserDriver::parseProgramSources(std::istream &in, std::string_view sourceFile,
                                     unsigned sourceLine /* = 1 */) {
@@ -173,6 +266,8 @@ P4ParserDriver::parseProgramSources(std::istream &in, std::string_view sourceFil
 /*static */ std::pair<const IR::P4Program *, const Util::InputSources *>
 P4ParserDriver::parseProgramSources(FILE *in, std::string_view sourceFile,
                                     unsigned sourceLine /* = 1 */) {
+    if (auto mapped = AutoMmapInputStream::create(in))
+        return parseProgramSources(mapped->get(), sourceFile, sourceLine);
     AutoStdioInputStream inputStream(in);
     return parseProgramSources(inputStream.get(), sourceFile, sourceLine);
 }
@@ -336,6 +431,8 @@ V1ParserDriver::V1ParserDriver() : global(new IR::V1Program) {}
 
 /* static */ const IR::V1Program *V1ParserDriver::parse(FILE *in, std::string_view sourceFile,
                                                         unsigned sourceLine /* = 1 */) {
+    if (auto mapped = AutoMmapInputStream::create(in))
+        return parse(mapped->get(), sourceFile, sourceLine);
     AutoStdioInputStream inputStream(in);
     return parse(inputStream.get(), sourceFile, sourceLine);
 }
@@ -124,6 +124,17 @@ class P4ParserDriver final : public AbstractParserDriver {
     static std::pair<const IR::P4Program *, const Util::InputSources *> parseProgramSources(
         FILE *in, std::string_view sourceFile, unsigned sourceLine = 1);
 
+    /**
+     * Parse a P4-16 program whose leading declarations (e.g. a precompiled
+     * standard-include prefix) were parsed separately.  The top-level symbols
+     * of @prefix are declared before parsing starts, so identifier/type
+     * disambiguation behaves as if the two sources had been concatenated.
+     * Only the newly parsed declarations are returned; the caller is
+     * responsible for splicing @prefix back in front of them.
+     */
+    static const IR::P4Program *parse(std::istream &in, std::string_view sourceFile,
+                                      const IR::P4Program *prefix, unsigned sourceLine = 1);
+
     /**
      * Parses a P4-16 annotation body.
      *
@@ -217,6 +228,11 @@ class P4ParserDriver final : public AbstractParserDriver {
     /// Common functionality for parsing.
     bool parse(AbstractP4Lexer &lexer, std::string_view sourceFile, unsigned sourceLine = 1);
 
+    /// Declare the top-level symbols of @program in the symbol table, as if
+    /// its source text had just been parsed.  Used to resume parsing after a
+    /// precompiled prefix.
+    void declareProgramSymbols(const IR::P4Program *program);
+
     /// Common functionality for parsing annotation bodies.
     template <typename T>
     const T *parse(P4AnnotationLexer::Type type, const Util::SourceInfo &srcInfo,
@@ -0,0 +1,136 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "ir/alloc_stats.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lib/n4.h"
+
+namespace P4::IR::AllocStats {
+
+namespace {
+
+struct Counter {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+/// Tallies for one thread.  Visitors on worker threads create nodes too, so each thread
+/// accumulates into its own map without locking and dump() merges them.
+struct ThreadCounters {
+    std::unordered_map<cstring, Counter> byType;
+    /// Constructor-chain deduplication: the generated constructor of every class in a
+    /// node's inheritance chain records the same node, base classes first.  Remembering
+    /// the last node recorded on this thread lets the next, more derived record replace
+    /// the previous one.
+    const void *lastNode = nullptr;
+    Counter *lastCounter = nullptr;
+    size_t lastBytes = 0;
+
+    static ThreadCounters &get() {
+        // As in lib/timer.cpp: the registry owns the per-thread instances from static
+        // storage; the thread_local is only a cached pointer into it, so libgc's
+        // inability to scan thread local data is not a problem.
+        static thread_local ThreadCounters *counters = nullptr;
+        if (counters == nullptr) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            registry().emplace_back(new ThreadCounters);
+            counters = registry().back().get();
+        }
+        return *counters;
+    }
+
+    static std::vector<std::unique_ptr<ThreadCounters>> &registry() {
+        static std::vector<std::unique_ptr<ThreadCounters>> REGISTRY;
+        return REGISTRY;
+    }
+
+    static std::mutex &registryMutex() {
+        static std::mutex MUTEX;
+        return MUTEX;
+    }
+};
+
+}  // namespace
+
+namespace Detail {
+
+Log::Detail::CachedLevelCheck levelCheck;
+const char *const controlFile = __FILE__;
+
+void recordImpl(const void *node, cstring type, size_t bytes) {
+    auto &tc = ThreadCounters::get();
+    if (node == tc.lastNode) {
+        // A base-class constructor of the same node already recorded it; the most
+        // derived class wins.
+        tc.lastCounter->count--;
+        tc.lastCounter->bytes -= tc.lastBytes;
+    }
+    auto &ctr = tc.byType[type];
+    ctr.count++;
+    ctr.bytes += bytes;
+    tc.lastNode = node;
+    tc.lastCounter = &ctr;
+    tc.lastBytes = bytes;
+    // Collection was requested explicitly, so always deliver the report: print it at
+    // process exit to wherever -Talloc_stats logging is directed.
+    static std::once_flag once;
+    std::call_once(once, [] {
+        std::atexit([]() { dump(Log::Detail::fileLogOutput(controlFile)); });
+    });
+}
+
+}  // namespace Detail
+
+void dump(std::ostream &out) {
+    std::unordered_map<cstring, Counter> merged;
+    {
+        std::lock_guard<std::mutex> lock(ThreadCounters::registryMutex());
+        for (const auto &tc : ThreadCounters::registry()) {
+            for (const auto &[type, ctr] : tc->byType) {
+                auto &m = merged[type];
+                m.count += ctr.count;
+                m.bytes += ctr.bytes;
+            }
+        }
+    }
+    std::vector<std::pair<cstring, Counter>> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+        if (a.second.bytes != b.second.bytes) return a.second.bytes > b.second.bytes;
+        return a.first < b.first;
+    });
+    Counter total;
+    out << "IR node allocations by type (live and garbage; node bytes only):\n";
+    out << std::setw(14) << "count"
+        << "  bytes  type\n";
+    for (const auto &[type, ctr] : sorted) {
+        out << std::setw(14) << ctr.count << ' ' << n4(ctr.bytes) << "B  " << type << '\n';
+        total.count += ctr.count;
+        total.bytes += ctr.bytes;
+    }
+    out << std::setw(14) << total.count << ' ' << n4(total.bytes) << "B  (total)" << std::endl;
+}
+
+}  // namespace P4::IR::AllocStats
@@ -0,0 +1,58 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef IR_ALLOC_STATS_H_
+#define IR_ALLOC_STATS_H_
+
+#include <cstddef>
+#include <iosfwd>
+
+#include "lib/cstring.h"
+#include "lib/log.h"
+
+/// Per-node-type allocation counters, so one can see which IR node kinds dominate the
+/// heap of a large compile.  Collection is off by default; enable it with -Talloc_stats:1
+/// on the command line, which also prints the report at process exit (redirectable like
+/// any log, e.g. -Talloc_stats:1>stats.txt).  Counters are fed by the generated node
+/// constructors and by clone(), so they cover garbage as well as live nodes; the byte
+/// counts are the nodes themselves, not out-of-line storage they point to.
+namespace P4::IR::AllocStats {
+
+namespace Detail {
+/// The gate is the log level of ir/alloc_stats.cpp, cached per the usual LOGGING scheme
+/// so the disabled check in every node constructor is two relaxed loads.
+extern Log::Detail::CachedLevelCheck levelCheck;
+extern const char *const controlFile;
+void recordImpl(const void *node, cstring type, size_t bytes);
+}  // namespace Detail
+
+/// True when per-node-type allocation counters are being collected.
+inline bool enabled() { return Detail::levelCheck.enabled(Detail::controlFile, 1); }
+
+/// Tally one allocation of an IR node of @type (an interned static_type_name) occupying
+/// @bytes.  Base-class constructors of @node record before the derived ones; the tally
+/// uses @node to collapse that chain so only the most derived class is counted.
+inline void record(const void *node, cstring type, size_t bytes) {
+    if (enabled()) Detail::recordImpl(node, type, bytes);
+}
+
+/// Write the counters collected so far to @out, one line per type sorted by total bytes,
+/// largest first, with counters from all threads merged.
+void dump(std::ostream &out);
+
+}  // namespace P4::IR::AllocStats
+
+#endif /* IR_ALLOC_STATS_H_ */
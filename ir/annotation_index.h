@@ -0,0 +1,68 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef IR_ANNOTATION_INDEX_H_
+#define IR_ANNOTATION_INDEX_H_
+
+#include "ir/visitor.h"
+#include "lib/hvec_map.h"
+#include "lib/safe_vector.h"
+
+namespace P4::IR {
+
+/// One-pass index of every annotated node in a program fragment.  Passes that
+/// process pragmas one name at a time end up re-walking the whole tree (or
+/// linearly probing every node) per name; applying this inspector once and
+/// querying it instead makes each subsequent "all nodes with annotation X"
+/// question a single hash lookup.  The index is a snapshot: it holds plain
+/// pointers into the tree it was applied to and must be rebuilt after any
+/// transformation.
+class AnnotationIndex : public Inspector {
+ public:
+    /// A node carrying an annotation, together with the annotation itself.
+    struct Entry {
+        const Node *node;
+        const Annotation *annotation;
+    };
+
+    /// All nodes carrying annotation @name, in visit order.  Nodes with
+    /// repeated annotations of the same name contribute one entry each.
+    const safe_vector<Entry> &get(cstring name) const {
+        static const safe_vector<Entry> empty;
+        auto it = byName.find(name);
+        return it != byName.end() ? it->second : empty;
+    }
+
+    /// Whether any visited node carries annotation @name.
+    bool any(cstring name) const { return byName.count(name) != 0; }
+
+ private:
+    profile_t init_apply(const Node *root) override {
+        byName.clear();
+        return Inspector::init_apply(root);
+    }
+
+    bool preorder(const Node *n) override {
+        if (const auto *annotated = n->to<IAnnotated>())
+            for (const auto *a : annotated->getAnnotations())
+                byName[a->name.name].push_back(Entry{n, a});
+        return true;
+    }
+
+    hvec_map<cstring, safe_vector<Entry>> byName;
+};
+
+}  // namespace P4::IR
+
+#endif /* IR_ANNOTATION_INDEX_H_ */
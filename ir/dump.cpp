@@ -16,7 +16,11 @@ limitations under the License.
 
 #include "dump.h"
 
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <set>
+#include <streambuf>
 
 #include "ir/ir.h"
 #include "ir/node.h"
@@ -34,16 +38,30 @@ namespace {
 class IRDumper : public Inspector {
     std::ostream &out;
     unsigned maxdepth;
+    unsigned maxwidth;
     cstring ignore;
     bool source;
+    // @brief print the handle that expands an elided subtree on demand; emitted
+    // once per parent, for the first child a bound cuts off
+    void elide(const Visitor::Context *ctxt) const {
+        out << indent_t(ctxt->depth) << "... (dump("
+            << static_cast<const void *>(ctxt->parent->node) << ") to expand)" << std::endl;
+    }
     // @brief (maybe) output a one-line summary of a node (no newline or children)
     // @return false if the node should not be printed (nothing output)
     // @return true if the node is printed
     bool firstLine(const IR::Node *n) const {
         if (auto ctxt = getContext()) {
-            if (unsigned(ctxt->depth) > maxdepth) return false;
+            if (unsigned(ctxt->depth) > maxdepth) {
+                if (ctxt->parent && ctxt->parent->child_index == 0) elide(ctxt);
+                return false;
+            }
             if (ctxt->parent && ctxt->parent->child_name && ignore == ctxt->parent->child_name)
                 return false;
+            if (ctxt->parent && unsigned(ctxt->parent->child_index) >= maxwidth) {
+                if (unsigned(ctxt->parent->child_index) == maxwidth) elide(ctxt);
+                return false;
+            }
             out << indent_t(ctxt->depth);
             if (ctxt->child_name) out << ctxt->child_name << ": ";
         }
@@ -77,28 +95,86 @@ class IRDumper : public Inspector {
     }
 
  public:
-    IRDumper(std::ostream &o, unsigned m, cstring ign, bool src)
-        : out(o), maxdepth(m), ignore(ign), source(src) {}
+    IRDumper(std::ostream &o, unsigned m, unsigned w, cstring ign, bool src)
+        : out(o), maxdepth(m), maxwidth(w), ignore(ign), source(src) {}
 };
+
+/// Bounds used by dump_brief: small enough that triage on a whole P4Program
+/// stays sub-second, with expansion handles for everything cut off.
+constexpr unsigned briefDepth = 4;
+constexpr unsigned briefWidth = 10;
 }  // namespace
 
+void dump(std::ostream &out, const IR::Node *n, unsigned maxdepth, unsigned maxwidth) {
+    n->apply(IRDumper(out, maxdepth, maxwidth, nullptr, false));
+}
 void dump(std::ostream &out, const IR::Node *n, unsigned maxdepth) {
-    n->apply(IRDumper(out, maxdepth, nullptr, false));
+    dump(out, n, maxdepth, ~0U);
 }
 void dump(std::ostream &out, const IR::Node *n) { dump(out, n, ~0U); }
+void dump(const IR::Node *n, unsigned maxdepth, unsigned maxwidth) {
+    dump(std::cout, n, maxdepth, maxwidth);
+}
 void dump(const IR::Node *n, unsigned maxdepth) { dump(std::cout, n, maxdepth); }
 void dump(const IR::Node *n) { dump(n, ~0U); }
 void dump(const IR::INode *n, unsigned maxdepth) { dump(std::cout, n->getNode(), maxdepth); }
 void dump(const IR::INode *n) { dump(n, ~0U); }
+void dump(uintptr_t p, unsigned maxdepth, unsigned maxwidth) {
+    dump(reinterpret_cast<const IR::Node *>(p), maxdepth, maxwidth);
+}
 void dump(uintptr_t p, unsigned maxdepth) { dump(reinterpret_cast<const IR::Node *>(p), maxdepth); }
 void dump(uintptr_t p) { dump(p, ~0U); }
 
+void dump_brief(const IR::Node *n) { dump(n, briefDepth, briefWidth); }
+void dump_brief(const IR::INode *n) { dump_brief(n->getNode()); }
+void dump_brief(uintptr_t p) { dump_brief(reinterpret_cast<const IR::Node *>(p)); }
+
+namespace {
+/// Minimal streambuf over a popen'd FILE, so dump output reaches the pager as
+/// it is produced instead of being buffered whole.
+class FILEbuf : public std::streambuf {
+    FILE *fp;
+    int overflow(int ch) override {
+        return ch != EOF && fputc(ch, fp) != EOF ? ch : EOF;
+    }
+    std::streamsize xsputn(const char *s, std::streamsize sz) override {
+        return fwrite(s, 1, sz, fp);
+    }
+
+ public:
+    explicit FILEbuf(FILE *f) : fp(f) {}
+};
+}  // namespace
+
+void dump_pager(const IR::Node *n, unsigned maxdepth, unsigned maxwidth) {
+    const char *pager = getenv("PAGER");
+    if (pager == nullptr || pager[0] == 0) pager = "less";
+    FILE *pipe = popen(pager, "w");
+    if (pipe == nullptr) {
+        dump(std::cout, n, maxdepth, maxwidth);
+        return;
+    }
+    // quitting the pager early must not kill the process hosting the debugger
+    auto prev = signal(SIGPIPE, SIG_IGN);
+    {
+        FILEbuf buf(pipe);
+        std::ostream out(&buf);
+        dump(out, n, maxdepth, maxwidth);
+    }
+    pclose(pipe);
+    signal(SIGPIPE, prev);
+}
+void dump_pager(const IR::Node *n, unsigned maxdepth) { dump_pager(n, maxdepth, ~0U); }
+void dump_pager(const IR::Node *n) { dump_pager(n, ~0U, ~0U); }
+void dump_pager(const IR::INode *n) { dump_pager(n->getNode()); }
+void dump_pager(uintptr_t p) { dump_pager(reinterpret_cast<const IR::Node *>(p)); }
+
 void dump_notype(const IR::Node *n, unsigned maxdepth) {
-    n->apply(IRDumper(std::cout, maxdepth, "type"_cs, false));
+    n->apply(IRDumper(std::cout, maxdepth, ~0U, "type"_cs, false));
 }
 void dump_notype(const IR::Node *n) { dump_notype(n, ~0U); }
 void dump_notype(const IR::INode *n, unsigned maxdepth) {
-    n->getNode()->apply(IRDumper(std::cout, maxdepth, "type"_cs, false));
+    n->getNode()->apply(IRDumper(std::cout, maxdepth, ~0U, "type"_cs, false));
 }
 void dump_notype(const IR::INode *n) { dump_notype(n, ~0U); }
 void dump_notype(uintptr_t p, unsigned maxdepth) {
@@ -107,11 +183,11 @@ void dump_notype(uintptr_t p, unsigned maxdepth) {
 void dump_notype(uintptr_t p) { dump_notype(p, ~0U); }
 
 void dump_src(const IR::Node *n, unsigned maxdepth) {
-    n->apply(IRDumper(std::cout, maxdepth, "type"_cs, true));
+    n->apply(IRDumper(std::cout, maxdepth, ~0U, "type"_cs, true));
 }
 void dump_src(const IR::Node *n) { dump_src(n, ~0U); }
 void dump_src(const IR::INode *n, unsigned maxdepth) {
-    n->getNode()->apply(IRDumper(std::cout, maxdepth, "type"_cs, true));
+    n->getNode()->apply(IRDumper(std::cout, maxdepth, ~0U, "type"_cs, true));
 }
 void dump_src(const IR::INode *n) { dump_src(n, ~0U); }
 
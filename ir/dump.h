@@ -29,12 +29,28 @@ namespace P4 {
 /* overloads rather than optional arguments to make it easier to call from the debugger */
 void dump(std::ostream &out, const IR::Node *n);
 void dump(std::ostream &out, const IR::Node *n, unsigned maxdepth);
+void dump(std::ostream &out, const IR::Node *n, unsigned maxdepth, unsigned maxwidth);
 void dump(const IR::Node *n);
 void dump(const IR::Node *n, unsigned maxdepth);
+void dump(const IR::Node *n, unsigned maxdepth, unsigned maxwidth);
 void dump(const IR::INode *n);
 void dump(const IR::INode *n, unsigned maxdepth);
 void dump(uintptr_t p);
 void dump(uintptr_t p, unsigned maxdepth);
+void dump(uintptr_t p, unsigned maxdepth, unsigned maxwidth);
+/* bounded depth and width, for interactive triage on production-size IRs; every
+ * subtree cut off by a bound is printed with a dump(0x...) handle that expands
+ * it on demand */
+void dump_brief(const IR::Node *n);
+void dump_brief(const IR::INode *n);
+void dump_brief(uintptr_t p);
+/* write through $PAGER (default less); output streams to the pager as it is
+ * produced, so large dumps can be browsed and quit early */
+void dump_pager(const IR::Node *n);
+void dump_pager(const IR::Node *n, unsigned maxdepth);
+void dump_pager(const IR::Node *n, unsigned maxdepth, unsigned maxwidth);
+void dump_pager(const IR::INode *n);
+void dump_pager(uintptr_t p);
 void dump_notype(const IR::Node *n);
 void dump_notype(const IR::Node *n, unsigned maxdepth);
 void dump_notype(const IR::INode *n);
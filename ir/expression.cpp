@@ -14,6 +14,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <mutex>
 #include <ostream>
 
 #include "absl/container/flat_hash_map.h"
@@ -153,16 +154,22 @@ IR::Constant IR::Constant::GetMask(unsigned width) {
 }
 
 const IR::Constant *IR::Constant::get(const IR::Type *t, big_int v, Util::SourceInfo si) {
-    // Only cache bits with width lower than 16 bit to restrict the size of the cache.
+    // Only cache bits up to 64 bit wide; the cache stays bounded in practice because
+    // programs use few distinct (width, value) pairs, while the 8-to-64-bit range is
+    // where generated programs produce millions of structurally identical constants.
     // Do not cache values with a non-empty source info (yet).
     const auto *tb = t->to<Type_Bits>();
-    if (t->width_bits() > 16 || tb == nullptr || si.isValid()) {
+    if (t->width_bits() > 64 || tb == nullptr || si.isValid()) {
         return new IR::Constant(si, t, v);
     }
     // Constants are interned. Keys in the intern map are pairs of types and values.
+    // The map is guarded by a mutex since type inference interns from worker threads
+    // under --parallel-typecheck.
     using key_t = std::tuple<int, RTTI::TypeId, bool, big_int>;
+    static std::mutex CONSTANTS_MUTEX;
     static absl::flat_hash_map<key_t, const Constant *, Util::Hash> CONSTANTS;
 
+    std::lock_guard<std::mutex> lock(CONSTANTS_MUTEX);
     auto *&result = CONSTANTS[{tb->width_bits(), t->typeId(), tb->isSigned, v}];
     if (result == nullptr) {
         result = new Constant(si, tb, v);
@@ -188,10 +195,13 @@ const IR::StringLiteral *IR::StringLiteral::get(cstring value, const IR::Type *t
     if (si.isValid()) {
         return new IR::StringLiteral(si, t, value);
     }
-    // String literals are interned.
+    // String literals are interned.  Guarded by a mutex for the same reason as
+    // Constant::get above.
     using key_t = std::pair<cstring, const IR::Type *>;
+    static std::mutex STRINGS_MUTEX;
     static absl::flat_hash_map<key_t, const IR::StringLiteral *, Util::Hash> STRINGS;
 
+    std::lock_guard<std::mutex> lock(STRINGS_MUTEX);
     auto *&result = STRINGS[{value, t}];
     if (result == nullptr) {
         result = new IR::StringLiteral(si, t, value);
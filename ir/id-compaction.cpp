@@ -0,0 +1,58 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "ir/id-compaction.h"
+
+#include "lib/log.h"
+
+namespace P4 {
+
+Visitor::profile_t CompactNodeIds::init_apply(const IR::Node *root) {
+    order.clear();
+    oldToNew.clear();
+    first = 0;
+    return Inspector::init_apply(root);
+}
+
+bool CompactNodeIds::preorder(const IR::Node *node) {
+    // Node ids are identity metadata, not IR structure: equiv(), operator==
+    // and the cached structural hashes never read them, and visitors track
+    // nodes by pointer.  At a barrier no visitor is in flight, so the ids of
+    // the quiescent tree can be rewritten in place once the walk is complete.
+    order.push_back(const_cast<IR::Node *>(node));
+    return true;
+}
+
+void CompactNodeIds::end_apply(const IR::Node *) {
+    first = IR::Node::reserveIds(static_cast<int>(order.size()));
+    oldToNew.reserve(order.size());
+    int next = first;
+    for (auto *node : order) {
+        oldToNew.emplace(node->id, next);
+        node->id = next++;
+    }
+    // clone_ids record the (transitive) origin of a clone; keep them in step
+    // with the renumbering when the origin is itself a live node.
+    for (auto *node : order) {
+        auto it = oldToNew.find(node->clone_id);
+        if (it != oldToNew.end()) node->clone_id = it->second;
+    }
+    order.clear();
+    LOG2("CompactNodeIds: " << oldToNew.size() << " live nodes renumbered into [" << first << ", "
+                            << next << ")");
+}
+
+}  // namespace P4
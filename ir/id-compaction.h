@@ -0,0 +1,73 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef IR_ID_COMPACTION_H_
+#define IR_ID_COMPACTION_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "ir/node.h"
+#include "ir/visitor.h"
+
+namespace P4 {
+
+/** Renumbers every node reachable from the root into one freshly reserved,
+ * contiguous id block.
+ *
+ * Node ids grow monotonically, and clone-heavy pipelines allocate an id for
+ * every intermediate copy, so a program of a few million live nodes can end
+ * up with ids spread over a range a hundred times larger.  Any side table
+ * indexed by node id pays for that whole range.  Running this pass at a
+ * pipeline barrier (no visitor in flight, e.g. right after the frontend)
+ * moves the live nodes into the dense range [firstId(), firstId() + size());
+ * tables built afterwards can index by id - firstId().
+ *
+ * The nodes are renumbered into a fresh block rather than reusing low ids so
+ * that ids stay globally unique: nodes that are alive but not reachable from
+ * the root -- interned types and constants, entries in caches -- keep their
+ * old ids.  The old-to-new mapping is retained so that ids stored before the
+ * pass ran can be translated with remap().
+ */
+class CompactNodeIds : public Inspector {
+    std::vector<IR::Node *> order;
+    std::unordered_map<int, int> oldToNew;
+    int first = 0;
+
+    profile_t init_apply(const IR::Node *root) override;
+    bool preorder(const IR::Node *node) override;
+    void end_apply(const IR::Node *root) override;
+
+ public:
+    CompactNodeIds() { setName("CompactNodeIds"); }
+
+    /// First id of the block the renumbered nodes occupy; the live nodes
+    /// cover [firstId(), firstId() + size()).  Valid after the pass has run.
+    int firstId() const { return first; }
+    /// Number of nodes renumbered.
+    size_t size() const { return oldToNew.size(); }
+    /// Translate a stored id: @returns the new id of the node that had
+    /// @p oldId before the pass ran, or @p oldId unchanged if that node was
+    /// not reachable from the root.
+    int remap(int oldId) const {
+        auto it = oldToNew.find(oldId);
+        return it != oldToNew.end() ? it->second : oldId;
+    }
+};
+
+}  // namespace P4
+
+#endif /* IR_ID_COMPACTION_H_ */
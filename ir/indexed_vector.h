@@ -41,8 +41,11 @@ class IndexedVector : public Vector<T> {
     string_map<const IDeclaration *> declarations;
     bool invalid = false;  // set when an error occurs; then we don't
                            // expect the validity check to succeed.
+    bool indexDeferred = false;  // set by deferIndex(); the declarations map is
+                                 // stale until freezeIndex() rebuilds it.
 
     void insertInMap(const T *a) {
+        if (indexDeferred) return;
         if (a == nullptr || !a->template is<IDeclaration>()) return;
         auto decl = a->template to<IDeclaration>();
         auto name = decl->getName().name;
@@ -53,7 +56,7 @@ class IndexedVector : public Vector<T> {
         }
     }
     void removeFromMap(const T *a) {
-        if (a == nullptr) return;
+        if (indexDeferred || a == nullptr) return;
         auto decl = a->template to<IDeclaration>();
         if (decl == nullptr) return;
         cstring name = decl->getName().name;
@@ -79,6 +82,9 @@ class IndexedVector : public Vector<T> {
         insert(Vector<T>::end(), a.begin(), a.end());
     }
     explicit IndexedVector(const Vector<T> &a) { insert(Vector<T>::end(), a.begin(), a.end()); }
+    explicit IndexedVector(Vector<T> &&a) : Vector<T>(std::move(a)) {
+        for (auto el : *this) insertInMap(el);
+    }
     template <typename It>
     explicit IndexedVector(It start, It end) {
         insert(Vector<T>::end(), start, end);
@@ -95,29 +101,48 @@ class IndexedVector : public Vector<T> {
     using iterator = typename Vector<T>::iterator;
     using const_iterator = typename Vector<T>::const_iterator;
 
+    /// Suspends maintenance of the declaration name map: elements inserted or
+    /// removed while deferred do not touch the map.  Useful when building a large
+    /// vector element-by-element, where per-insert index updates are wasted work;
+    /// freezeIndex() must be called before any name lookup.
+    void deferIndex() { indexDeferred = true; }
+    /// Rebuilds the declaration name map in one pass and resumes per-insert
+    /// maintenance.  A no-op unless deferIndex() was called.
+    void freezeIndex() {
+        if (!indexDeferred) return;
+        indexDeferred = false;
+        declarations.clear();
+        for (auto el : *this) insertInMap(el);
+    }
+
     const IDeclaration *getDeclaration(cstring name) const {
+        BUG_CHECK(!indexDeferred, "name lookup on IndexedVector with deferred index");
         auto it = declarations.find(name);
         if (it == declarations.end()) return nullptr;
         return it->second;
     }
     const IDeclaration *getDeclaration(std::string_view name) const {
+        BUG_CHECK(!indexDeferred, "name lookup on IndexedVector with deferred index");
         auto it = declarations.find(name);
         if (it == declarations.end()) return nullptr;
         return it->second;
     }
     template <class U>
     const U *getDeclaration(cstring name) const {
+        BUG_CHECK(!indexDeferred, "name lookup on IndexedVector with deferred index");
         auto it = declarations.find(name);
         if (it == declarations.end()) return nullptr;
         return it->second->template to<U>();
     }
     template <class U>
     const U *getDeclaration(std::string_view name) const {
+        BUG_CHECK(!indexDeferred, "name lookup on IndexedVector with deferred index");
         auto it = declarations.find(name);
         if (it == declarations.end()) return nullptr;
         return it->second->template to<U>();
     }
     Util::Enumerator<const IDeclaration *> *getDeclarations() const {
+        BUG_CHECK(!indexDeferred, "name lookup on IndexedVector with deferred index");
         return Util::enumerate(Values(declarations));
     }
     iterator erase(iterator from, iterator to) {
@@ -145,6 +170,12 @@ class IndexedVector : public Vector<T> {
     iterator append(const Container &toAppend) {
         return insert(Vector<T>::end(), toAppend.begin(), toAppend.end());
     }
+    /// Move-appends the elements of a plain Vector, indexing them as they arrive
+    /// (or not at all if the index is deferred).
+    iterator append(Vector<T> &&toMove) {
+        for (auto el : toMove) insertInMap(el);
+        return Vector<T>::append(std::move(toMove));
+    }
     template <typename Container>
     iterator prepend(const Container &toAppend) {
         return insert(Vector<T>::begin(), toAppend.begin(), toAppend.end());
@@ -223,6 +254,7 @@ class IndexedVector : public Vector<T> {
     static Node *fromJSON(JSONLoader &json);
     void validate() const override {
         if (invalid) return;  // don't crash the compiler because an error happened
+        BUG_CHECK(!indexDeferred, "IndexedVector in the IR tree with a deferred index");
         for (auto el : *this) {
             auto decl = el->template to<IR::IDeclaration>();
             if (!decl) continue;
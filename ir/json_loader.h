@@ -32,6 +32,7 @@ limitations under the License.
 #include "lib/ltbitmatrix.h"
 #include "lib/match.h"
 #include "lib/null.h"
+#include "lib/ordered_flat_map.h"
 #include "lib/ordered_map.h"
 #include "lib/ordered_set.h"
 #include "lib/safe_vector.h"
@@ -68,7 +69,10 @@ class JSONLoader {
  public:
     explicit JSONLoader(std::istream &in, JsonData::LocationInfo *li = nullptr)
         : node_refs(*(new std::unordered_map<int, IR::Node *>())), locinfo(li) {
-        in >> json_root;
+        // large dumps parse their top-level members on worker threads; the
+        // node-id cross references are resolved afterwards through node_refs
+        // as usual, so no further fixup is needed here
+        json_root = parseJsonParallel(in);
         json = json_root.get();
     }
 
@@ -230,6 +234,23 @@ class JSONLoader {
             }
         }
     }
+    template <typename K, typename V, typename COMP, typename ALLOC>
+    void unpack_json(ordered_flat_map<K, V, COMP, ALLOC> &v) {
+        std::pair<K, V> temp;
+        v.clear();
+        if (is<JsonVector>()) {
+            for (auto &e : as<JsonVector>()) {
+                load(e, temp);
+                v.insert(temp);
+            }
+        } else {
+            for (auto &e : as<JsonObject>()) {
+                load(JsonString(e.first), temp.first);
+                load(e.second, temp.second);
+                v.insert(temp);
+            }
+        }
+    }
     template <typename V>
     void unpack_json(string_map<V> &v) {
         std::pair<cstring, V> temp;
@@ -17,8 +17,15 @@ limitations under the License.
 #include "ir/json_parser.h"
 
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <optional>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include "absl/strings/escaping.h"
@@ -88,7 +95,178 @@ static std::string token(std::istream &in) {
     return rv;
 }
 
+// Binary JSON encoding: a magic/version header, a deduplicated string table, then the
+// value tree.  All counts and lengths are LEB128 varints; numbers are stored as a sign
+// byte plus the big-endian magnitude; strings (and object keys) are varint references
+// into the string table.  The leading magic byte cannot begin a text JSON document, so
+// operator>> can detect the format by peeking a single character.
+namespace {
+
+constexpr char BINARY_JSON_MAGIC[] = "\xb1P4IRBIN";
+constexpr size_t BINARY_JSON_MAGIC_LEN = 8;
+constexpr uint8_t BINARY_JSON_VERSION = 1;
+
+enum class BinTag : uint8_t { Null = 0, False = 1, True = 2, Number = 3, String = 4,
+                              Vector = 5, Object = 6 };
+
+void writeVarint(std::ostream &out, uint64_t v) {
+    while (v >= 0x80) {
+        out.put(char(v | 0x80));
+        v >>= 7;
+    }
+    out.put(char(v));
+}
+
+uint64_t readVarint(std::istream &in) {
+    uint64_t rv = 0;
+    int ch, shift = 0;
+    while ((ch = in.get()) != EOF) {
+        rv |= uint64_t(ch & 0x7f) << shift;
+        if (!(ch & 0x80)) return rv;
+        if ((shift += 7) > 63) break;
+    }
+    throw JsonData::error("truncated varint in binary JSON", lastpos(in));
+}
+
+using string_table_index_t = std::unordered_map<std::string, uint64_t>;
+
+void collectStrings(const JsonData *json, string_table_index_t &index,
+                    std::vector<const std::string *> &table) {
+    auto add = [&](const std::string &s) {
+        auto [it, inserted] = index.emplace(s, table.size());
+        if (inserted) table.push_back(&it->first);
+    };
+    if (auto *obj = json->to<JsonObject>()) {
+        for (auto &e : *obj) {
+            add(std::string(e.first.string_view()));
+            collectStrings(e.second.get(), index, table);
+        }
+    } else if (auto *vec = json->to<JsonVector>()) {
+        for (auto &e : *vec) collectStrings(e.get(), index, table);
+    } else if (auto *s = json->to<JsonString>()) {
+        add(*s);
+    }
+}
+
+void writeBinaryValue(std::ostream &out, const JsonData *json, const string_table_index_t &index) {
+    if (auto *obj = json->to<JsonObject>()) {
+        out.put(char(BinTag::Object));
+        writeVarint(out, obj->size());
+        for (auto &e : *obj) {
+            writeVarint(out, index.at(std::string(e.first.string_view())));
+            writeBinaryValue(out, e.second.get(), index);
+        }
+    } else if (auto *vec = json->to<JsonVector>()) {
+        out.put(char(BinTag::Vector));
+        writeVarint(out, vec->size());
+        for (auto &e : *vec) writeBinaryValue(out, e.get(), index);
+    } else if (auto *s = json->to<JsonString>()) {
+        out.put(char(BinTag::String));
+        writeVarint(out, index.at(*s));
+    } else if (auto *num = json->to<JsonNumber>()) {
+        out.put(char(BinTag::Number));
+        out.put(num->val < 0 ? 1 : 0);
+        std::vector<uint8_t> bytes;
+        if (num->val != 0) export_bits(big_int(abs(num->val)), std::back_inserter(bytes), 8);
+        writeVarint(out, bytes.size());
+        out.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    } else if (auto *b = json->to<JsonBoolean>()) {
+        out.put(char(b->val ? BinTag::True : BinTag::False));
+    } else {
+        out.put(char(BinTag::Null));
+    }
+}
+
+std::unique_ptr<JsonData> readBinaryValue(std::istream &in, const std::vector<cstring> &table) {
+    auto stringAt = [&](uint64_t idx) -> cstring {
+        if (idx >= table.size())
+            throw JsonData::error("string table index out of range in binary JSON", lastpos(in));
+        return table[idx];
+    };
+    int tag = in.get();
+    if (tag == EOF) throw JsonData::error("truncated binary JSON", lastpos(in));
+    switch (BinTag(tag)) {
+        case BinTag::Null:
+            return std::make_unique<JsonNull>();
+        case BinTag::False:
+            return std::make_unique<JsonBoolean>(false);
+        case BinTag::True:
+            return std::make_unique<JsonBoolean>(true);
+        case BinTag::Number: {
+            int negative = in.get();
+            uint64_t nbytes = readVarint(in);
+            std::vector<uint8_t> bytes(nbytes);
+            in.read(reinterpret_cast<char *>(bytes.data()), nbytes);
+            if (!in) throw JsonData::error("truncated number in binary JSON", lastpos(in));
+            big_int val;
+            if (nbytes > 0) import_bits(val, bytes.begin(), bytes.end(), 8);
+            if (negative) val = -val;
+            return std::make_unique<JsonNumber>(val);
+        }
+        case BinTag::String:
+            return std::make_unique<JsonString>(stringAt(readVarint(in)).string_view());
+        case BinTag::Vector: {
+            uint64_t count = readVarint(in);
+            std::vector<std::unique_ptr<JsonData>> vec;
+            vec.reserve(count);
+            for (uint64_t i = 0; i < count; ++i) vec.emplace_back(readBinaryValue(in, table));
+            return std::make_unique<JsonVector>(std::move(vec));
+        }
+        case BinTag::Object: {
+            uint64_t count = readVarint(in);
+            string_map<std::unique_ptr<JsonData>> obj;
+            for (uint64_t i = 0; i < count; ++i) {
+                cstring key = stringAt(readVarint(in));
+                obj[key] = readBinaryValue(in, table);
+            }
+            return std::make_unique<JsonObject>(std::move(obj));
+        }
+    }
+    throw JsonData::error("unknown tag in binary JSON", lastpos(in));
+}
+
+}  // namespace
+
+void writeBinaryJson(std::ostream &out, const JsonData *json) {
+    out.write(BINARY_JSON_MAGIC, BINARY_JSON_MAGIC_LEN);
+    out.put(char(BINARY_JSON_VERSION));
+    string_table_index_t index;
+    std::vector<const std::string *> table;
+    collectStrings(json, index, table);
+    writeVarint(out, table.size());
+    for (auto *s : table) {
+        writeVarint(out, s->size());
+        out.write(s->data(), s->size());
+    }
+    writeBinaryValue(out, json, index);
+}
+
+std::unique_ptr<JsonData> readBinaryJson(std::istream &in) {
+    char magic[BINARY_JSON_MAGIC_LEN];
+    in.read(magic, BINARY_JSON_MAGIC_LEN);
+    if (!in || memcmp(magic, BINARY_JSON_MAGIC, BINARY_JSON_MAGIC_LEN) != 0)
+        throw JsonData::error("not a binary JSON file", lastpos(in));
+    int version = in.get();
+    if (version != BINARY_JSON_VERSION)
+        throw JsonData::error("unsupported binary JSON version", lastpos(in));
+    uint64_t count = readVarint(in);
+    std::vector<cstring> table;
+    table.reserve(count);
+    std::string buf;
+    for (uint64_t i = 0; i < count; ++i) {
+        buf.resize(readVarint(in));
+        in.read(buf.data(), buf.size());
+        if (!in) throw JsonData::error("truncated string table in binary JSON", lastpos(in));
+        table.push_back(cstring(buf));
+    }
+    return readBinaryValue(in, table);
+}
+
 std::istream &operator>>(std::istream &in, std::unique_ptr<JsonData> &json) {
+    if (in && in.peek() == (BINARY_JSON_MAGIC[0] & 0xff)) {
+        json = readBinaryJson(in);
+        return in;
+    }
     while (in) {
         char ch;
         in >> std::ws >> ch;
@@ -255,6 +433,203 @@ std::istream &operator>>(std::istream &in, std::unique_ptr<JsonData> &json) {
     return in;
 }
 
+namespace {
+
+/// A streambuf whose get area is a range of an in-memory buffer; no copying.
+/// Seeking is supported so that the parser can record value offsets (which
+/// the error messages report) with tellg, just as it does on a file stream.
+class RangeBuf : public std::streambuf {
+    std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir,
+                           std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) return -1;
+        char *target = dir == std::ios_base::beg   ? eback() + off
+                       : dir == std::ios_base::cur ? gptr() + off
+                                                   : egptr() + off;
+        if (target < eback() || target > egptr()) return -1;
+        setg(eback(), target, egptr());
+        return target - eback();
+    }
+    std::streampos seekpos(std::streampos pos, std::ios_base::openmode which) override {
+        return seekoff(pos, std::ios_base::beg, which);
+    }
+
+ public:
+    RangeBuf(char *base, size_t size) { setg(base, base, base + size); }
+};
+
+/// Inputs smaller than this always take the sequential path when the thread
+/// count is automatic; the scan and thread startup are not worth it.
+constexpr size_t PARALLEL_JSON_MIN_SIZE = 4 << 20;
+
+/// Where the depth-1 elements of the top-level container live in the text.
+struct TopLevelIndex {
+    char open;                   // '{' or '['
+    size_t close;                // offset of the matching closing bracket
+    std::vector<size_t> starts;  // offset of the first byte of each element
+};
+
+/// The index pass: one scan over the bytes tracking string/escape state and
+/// nesting depth.  Returns nullopt for scalar documents and for anything
+/// unbalanced, which the sharded path should not attempt.
+std::optional<TopLevelIndex> indexTopLevel(const std::string &text) {
+    size_t pos = 0;
+    while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    if (pos >= text.size() || (text[pos] != '{' && text[pos] != '[')) return std::nullopt;
+    TopLevelIndex index;
+    index.open = text[pos];
+    int depth = 0;
+    bool instr = false;
+    bool atBoundary = false;
+    for (size_t i = pos; i < text.size(); ++i) {
+        char ch = text[i];
+        if (instr) {
+            if (ch == '\\')
+                ++i;
+            else if (ch == '"')
+                instr = false;
+            continue;
+        }
+        if (depth == 1 && atBoundary && !isspace(static_cast<unsigned char>(ch)) && ch != ',' &&
+            ch != '}' && ch != ']') {
+            index.starts.push_back(i);
+            atBoundary = false;
+        }
+        switch (ch) {
+            case '"':
+                instr = true;
+                break;
+            case '{':
+            case '[':
+                if (++depth == 1) atBoundary = true;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0) {
+                    index.close = i;
+                    return index;
+                }
+                break;
+            case ',':
+                if (depth == 1) atBoundary = true;
+                break;
+        }
+    }
+    return std::nullopt;
+}
+
+/// Parse the object members in @text[start, end) into @shard, mirroring the
+/// member loop of operator>>.
+void parseObjectShard(std::string &text, size_t start, size_t end,
+                      string_map<std::unique_ptr<JsonData>> &shard) {
+    RangeBuf buf(text.data() + start, end - start);
+    std::istream in(&buf);
+    char ch;
+    while (in >> std::ws, in && in.peek() != EOF) {
+        std::unique_ptr<JsonData> key, val;
+        in >> key >> std::ws >> ch;
+        if (!key) break;
+        if (JsonData::strict && (!in || ch != ':'))
+            throw JsonData::error("missing ':' in object", lastpos(in));
+        in >> val;
+        shard[key->as<JsonString>()] = std::move(val);
+        in >> std::ws >> ch;
+        if (!in) break;
+        if (JsonData::strict && ch != ',')
+            throw JsonData::error("missing ',' in object", lastpos(in));
+    }
+}
+
+/// Parse the vector elements in @text[start, end) into @shard.
+void parseVectorShard(std::string &text, size_t start, size_t end,
+                      std::vector<std::unique_ptr<JsonData>> &shard) {
+    RangeBuf buf(text.data() + start, end - start);
+    std::istream in(&buf);
+    char ch;
+    while (in >> std::ws, in && in.peek() != EOF) {
+        std::unique_ptr<JsonData> elem;
+        in >> elem;
+        if (!elem) break;
+        shard.emplace_back(std::move(elem));
+        in >> std::ws >> ch;
+        if (!in) break;
+        if (JsonData::strict && ch != ',')
+            throw JsonData::error("missing ',' in vector", lastpos(in));
+    }
+}
+
+std::unique_ptr<JsonData> parseSequential(std::string &text) {
+    RangeBuf buf(text.data(), text.size());
+    std::istream in(&buf);
+    std::unique_ptr<JsonData> rv;
+    in >> rv;
+    return rv;
+}
+
+}  // namespace
+
+std::unique_ptr<JsonData> parseJsonParallel(std::istream &in, unsigned threads) {
+    if (in && in.peek() == (BINARY_JSON_MAGIC[0] & 0xff)) return readBinaryJson(in);
+    std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (threads == 0 && text.size() >= PARALLEL_JSON_MIN_SIZE)
+        threads = std::thread::hardware_concurrency();
+    if (threads < 2) return parseSequential(text);
+
+    auto index = indexTopLevel(text);
+    if (!index || index->starts.size() < 2) return parseSequential(text);
+    size_t nshards = std::min<size_t>(threads, index->starts.size());
+
+    // cut the element list into shards of roughly equal byte size
+    std::vector<std::pair<size_t, size_t>> ranges;  // [start, end) in text
+    size_t target = (index->close - index->starts.front()) / nshards;
+    size_t shardStart = index->starts.front();
+    for (size_t e = 1; e < index->starts.size(); ++e) {
+        if (index->starts[e] - shardStart >= target && ranges.size() + 1 < nshards) {
+            ranges.emplace_back(shardStart, index->starts[e]);
+            shardStart = index->starts[e];
+        }
+    }
+    ranges.emplace_back(shardStart, index->close);
+
+    // the workers only build JsonData (plain heap) and intern cstring keys,
+    // which the sharded intern table handles; the GC heap is never touched,
+    // so the threads need no gc registration
+    std::vector<string_map<std::unique_ptr<JsonData>>> objShards(ranges.size());
+    std::vector<std::vector<std::unique_ptr<JsonData>>> vecShards(ranges.size());
+    std::vector<std::exception_ptr> failures(ranges.size());
+    const bool isObject = index->open == '{';
+    auto worker = [&](size_t i) {
+        try {
+            if (isObject)
+                parseObjectShard(text, ranges[i].first, ranges[i].second, objShards[i]);
+            else
+                parseVectorShard(text, ranges[i].first, ranges[i].second, vecShards[i]);
+        } catch (...) {
+            failures[i] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < ranges.size(); ++i) workers.emplace_back(worker, i);
+    worker(0);
+    for (auto &t : workers) t.join();
+    for (auto &fail : failures)
+        if (fail) std::rethrow_exception(fail);
+
+    // splice the shards back together in order
+    std::unique_ptr<JsonData> rv;
+    if (isObject) {
+        string_map<std::unique_ptr<JsonData>> all = std::move(objShards.front());
+        for (size_t i = 1; i < objShards.size(); ++i)
+            for (auto &e : objShards[i]) all[e.first] = std::move(e.second);
+        rv = std::make_unique<JsonObject>(std::move(all));
+    } else {
+        std::vector<std::unique_ptr<JsonData>> all = std::move(vecShards.front());
+        for (size_t i = 1; i < vecShards.size(); ++i)
+            for (auto &e : vecShards[i]) all.emplace_back(std::move(e));
+        rv = std::make_unique<JsonVector>(std::move(all));
+    }
+    return rv;
+}
+
 std::pair<int, int> JsonData::LocationInfo::loc(std::streamoff l) {
     if (l < 0) return std::make_pair(-1, -1);
     auto it = line.upper_bound(l);
@@ -104,7 +104,11 @@ class JsonObject : public JsonData, public string_map<std::unique_ptr<JsonData>>
     JsonObject(const JsonObject &obj) = delete;
     JsonObject &operator=(JsonObject &&) = default;
     explicit JsonObject(string_map<std::unique_ptr<JsonData>> &&v)
-        : string_map<std::unique_ptr<JsonData>>(std::move(v)) {}
+        : string_map<std::unique_ptr<JsonData>>(std::move(v)) {
+        // parsed objects are read-only in practice, and millions of them can be
+        // alive at once when loading a large IR dump; mutation transparently thaws
+        freeze();
+    }
 
     DECLARE_TYPEINFO(JsonObject, JsonData);
 };
@@ -119,6 +123,29 @@ std::ostream &operator<<(std::ostream &out, const JsonData *json);
 inline std::ostream &operator<<(std::ostream &out, const JsonData &json) { return out << &json; }
 std::istream &operator>>(std::istream &in, std::unique_ptr<JsonData> &json);
 
+/// Parse one JSON document from @in like operator>>, sharding the members of the
+/// top-level object (or elements of the top-level vector) across worker threads:
+/// an index pass scans the bytes once to find the depth-1 boundaries, the shards
+/// parse independently, and the pieces are spliced back together in order.  With
+/// @threads == 0 a thread per hardware core is used, but only for inputs large
+/// enough to benefit; an explicit count is always honored, and 1 forces the
+/// sequential path.  Binary-encoded inputs and documents whose top level is not
+/// a container always parse sequentially.  The result is identical either way,
+/// except that the stream offsets recorded on sharded members (used only for
+/// strict-mode error messages) are relative to their shard.
+std::unique_ptr<JsonData> parseJsonParallel(std::istream &in, unsigned threads = 0);
+
+/// Write @json in the compact binary encoding: a magic/version header, a deduplicated
+/// length-prefixed string table (object keys and string values), and a length-prefixed
+/// value tree.  Files in this format are accepted transparently wherever a JSON IR dump
+/// is read back (operator>> recognizes the magic), and are typically several times
+/// smaller and much faster to load than their text equivalent.
+void writeBinaryJson(std::ostream &out, const JsonData *json);
+
+/// Read a JSON document in the binary encoding produced by writeBinaryJson.
+/// @throws JsonData::error on a malformed or truncated input.
+std::unique_ptr<JsonData> readBinaryJson(std::istream &in);
+
 }  // namespace P4
 
 #endif /* IR_JSON_PARSER_H_ */
@@ -137,6 +137,7 @@ class NameMap : public Node {
     bool equiv(const Node &a_) const override {
         if (static_cast<const Node *>(this) == &a_) return true;
         if (this->typeId() != a_.typeId()) return false;
+        if (this->getEquivHash() != a_.getEquivHash()) return false;
         auto &a = static_cast<const NameMap<T, MAP, COMP, ALLOC> &>(a_);
         if (size() != a.size()) return false;
         auto it = a.begin();
@@ -144,6 +145,15 @@ class NameMap : public Node {
             if (el.first != it->first || !el.second->equiv(*(it++)->second)) return false;
         return true;
     }
+    uint64_t computeEquivHash() const override {
+        uint64_t h = Node::computeEquivHash();
+        h = Util::hash_combine(h, size());
+        for (auto &el : symbols) {
+            h = Util::hash_combine(h, Util::Hasher<cstring>()(el.first));
+            h = Util::hash_combine(h, el.second->getEquivHash());
+        }
+        return h;
+    }
     cstring node_type_name() const override { return "NameMap<" + T::static_type_name() + ">"; }
     static cstring static_type_name() { return "NameMap<" + T::static_type_name() + ">"; }
     void visit_children(Visitor &v, const char *) override;
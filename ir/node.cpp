@@ -47,7 +47,7 @@ void IR::Node::traceCreation() const {
     LOG5("Created node " << id);
 }
 
-int IR::Node::currentId = 0;
+std::atomic<int> IR::Node::currentId = 0;
 
 void IR::Node::toJSON(JSONGenerator &json) const {
     json.emit("Node_ID", id);
@@ -57,7 +57,7 @@ void IR::Node::toJSON(JSONGenerator &json) const {
 IR::Node::Node(JSONLoader &json) : id(-1) {
     json.load("Node_ID", id) || json.error("missing field Node_Id");
     if (id < 0)
-        id = currentId++;
+        id = nextId();
     else if (id >= currentId)
         currentId = id + 1;
     clone_id = id;
@@ -113,7 +113,7 @@ Util::JsonObject *IR::Node::sourceInfoJsonObj() const {
     unsigned lineNumber, columnNumber;
     cstring fName = prepareSourceInfoForJSON(si, &lineNumber, &columnNumber);
     if (fName == nullptr) {
-        if (si.line == -1) {
+        if (si.getLine() == -1) {
             // -1 is default value for objects when SourceInfo
             // was not read from jsonFile using "--fromJSON" flag
             return nullptr;
@@ -121,10 +121,10 @@ Util::JsonObject *IR::Node::sourceInfoJsonObj() const {
             // Added source_info for jsonObject when "--fromJSON" flag is used
             // which parameters are saved in srcInfo fileds(filename, line, column and srcBrief)
             auto json1 = new Util::JsonObject();
-            json1->emplace("filename", srcInfo.filename);
-            json1->emplace("line", srcInfo.line);
-            json1->emplace("column", srcInfo.column);
-            json1->emplace("source_fragment", srcInfo.srcBrief);
+            json1->emplace("filename", srcInfo.getFilename());
+            json1->emplace("line", srcInfo.getLine());
+            json1->emplace("column", srcInfo.getColumn());
+            json1->emplace("source_fragment", srcInfo.getSrcBrief());
             return json1;
         }
     } else {
@@ -156,10 +156,14 @@ void IR::Node::sourceInfoToJSON(JSONGenerator &json) const {
 
 void IR::Node::sourceInfoFromJSON(JSONLoader &json) {
     if (auto si = JSONLoader(json, "Source_Info")) {
-        si.load("filename", srcInfo.filename);
-        si.load("line", srcInfo.line);
-        si.load("column", srcInfo.column);
-        si.load("source_fragment", srcInfo.srcBrief);
+        cstring filename = ""_cs;
+        int line = -1, column = -1;
+        cstring srcBrief = ""_cs;
+        si.load("filename", filename);
+        si.load("line", line);
+        si.load("column", column);
+        si.load("source_fragment", srcBrief);
+        srcInfo = Util::SourceInfo(filename, line, column, srcBrief);
     }
 }
 
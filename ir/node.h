@@ -17,12 +17,17 @@ limitations under the License.
 #ifndef IR_NODE_H_
 #define IR_NODE_H_
 
+#include <atomic>
+#include <cstdint>
 #include <iosfwd>
+#include <type_traits>
 
+#include "ir/alloc_stats.h"
 #include "ir/gen-tree-macro.h"
 #include "ir/inode.h"
 #include "ir/ir-tree-macros.h"
 #include "lib/cstring.h"
+#include "lib/hash.h"
 #include "lib/source_file.h"
 
 namespace P4 {
@@ -50,6 +55,32 @@ class Vector;  // IWYU pragma: keep
 template <class T>
 class IndexedVector;  // IWYU pragma: keep
 
+namespace Detail {
+/// Detects whether Util::Hasher<T> provides a hash for T.
+template <class T, class = void>
+struct has_equiv_hasher : std::false_type {};
+template <class T>
+struct has_equiv_hasher<T, std::void_t<decltype(Util::Hasher<T>()(std::declval<const T &>()))>>
+    : std::true_type {};
+}  // namespace Detail
+
+/// Hashes a non-IR field for Node::computeEquivHash().  The result must be consistent
+/// with the operator== comparison that equiv() performs on the field: equal fields
+/// must produce equal hashes.  Field types without a known ==-consistent hash
+/// contribute a fixed value instead, which weakens the hash but keeps it sound.
+template <class T>
+uint64_t equivHashValue(const T &v) {
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<uint64_t>(v);
+    } else if constexpr (std::is_integral_v<T>) {
+        return static_cast<uint64_t>(v);
+    } else if constexpr (Detail::has_equiv_hasher<T>::value) {
+        return Util::Hasher<T>()(v);
+    } else {
+        return 1;  // no ==-consistent hash known for this type
+    }
+}
+
 class Node : public virtual INode {
  public:
     virtual bool apply_visitor_preorder(Modifier &v);
@@ -68,7 +99,24 @@ class Node : public virtual INode {
     Node &operator=(Node &&) = default;
 
  protected:
-    static int currentId;
+    // Atomic so that visitors running on worker threads may create nodes.
+    static std::atomic<int> currentId;
+    /// Ids are handed out from a per-thread block carved out of currentId, so
+    /// clone-heavy visitors running on worker threads do not contend on the
+    /// counter.  At most idBlockSize - 1 ids per thread go unused.
+    static constexpr int idBlockSize = 1024;
+    static int nextId() {
+        thread_local static int next = 0;
+        thread_local static int end = 0;
+        if (next == end) {
+            next = currentId.fetch_add(idBlockSize, std::memory_order_relaxed);
+            end = next + idBlockSize;
+        }
+        return next++;
+    }
+    /// Cached structural hash backing getEquivHash(); 0 means not yet computed.
+    /// Deliberately not copied by the copy constructor, so clones recompute it.
+    mutable uint64_t equivHash = 0;
     void traceVisit(const char *visitor) const;
     friend class ::P4::Visitor;
     friend class ::P4::Inspector;
@@ -82,13 +130,21 @@ class Node : public virtual INode {
     int id;        // unique id for each node
     int clone_id;  // unique id this node was cloned from (recursively)
     void traceCreation() const;
-    Node() : id(currentId++), clone_id(id) { traceCreation(); }
-    explicit Node(Util::SourceInfo si) : srcInfo(si), id(currentId++), clone_id(id) {
+    Node() : id(nextId()), clone_id(id) { traceCreation(); }
+    explicit Node(Util::SourceInfo si) : srcInfo(si), id(nextId()), clone_id(id) {
         traceCreation();
     }
-    Node(const Node &other) : srcInfo(other.srcInfo), id(currentId++), clone_id(other.clone_id) {
+    Node(const Node &other) : srcInfo(other.srcInfo), id(nextId()), clone_id(other.clone_id) {
         traceCreation();
     }
+    /// Reserve @p count consecutive ids and return the first one; used when
+    /// renumbering live nodes into a dense block (see P4::CompactNodeIds).
+    static int reserveIds(int count) {
+        return currentId.fetch_add(count, std::memory_order_relaxed);
+    }
+    /// Number of node ids handed out so far; an upper bound on the nodes created
+    /// (worker threads may leave part of their id blocks unused).
+    static int idsAllocated() { return currentId.load(std::memory_order_relaxed); }
     virtual ~Node() {}
     const Node *apply(Visitor &v, const Visitor_Context *ctxt = nullptr) const;
     const Node *apply(Visitor &&v, const Visitor_Context *ctxt = nullptr) const {
@@ -115,6 +171,22 @@ class Node : public virtual INode {
     /* 'equiv' does a deep-equals comparison, comparing all non-pointer fields and recursing
      * though all Node subclass pointers to compare them with 'equiv' as well. */
     virtual bool equiv(const Node &a) const { return this->typeId() == a.typeId(); }
+    /* computes the structural hash cached by getEquivHash.  The IR generator emits an
+     * override per class mixing in the same fields that equiv compares; classes with a
+     * hand-written equiv body inherit their parent's (weaker, but still sound) hash. */
+    virtual uint64_t computeEquivHash() const { return Util::hash_avalanche(typeId()); }
+    /* returns a structural hash with the invariant that equiv(a, b) implies equal hashes
+     * (the converse need not hold), letting equiv reject unequal trees in O(1) once the
+     * hashes are cached.  Computed lazily; since nodes are immutable once construction
+     * finishes the cache never needs invalidation, and clones recompute it.  Must not be
+     * called on a node that is still being mutated (e.g. inside a Transform). */
+    uint64_t getEquivHash() const {
+        if (equivHash == 0) {
+            uint64_t h = computeEquivHash();
+            equivHash = h ? h : 1;
+        }
+        return equivHash;
+    }
 #define DEFINE_OPEQ_FUNC(CLASS, BASE) \
     virtual bool operator==(const CLASS &) const { return false; }
     IRNODE_ALL_SUBCLASSES(DEFINE_OPEQ_FUNC)
@@ -148,9 +220,13 @@ inline bool equiv(const INode *a, const INode *b) {
 }
 // NOLINTBEGIN(bugprone-macro-parentheses)
 /* common things that ALL Node subclasses must define */
-#define IRNODE_SUBCLASS(T)                             \
- public:                                               \
-    T *clone() const override { return new T(*this); } \
+#define IRNODE_SUBCLASS(T)                                            \
+ public:                                                              \
+    T *clone() const override {                                       \
+        auto *rv = new T(*this);                                      \
+        AllocStats::record(rv, T::static_type_name(), sizeof(T));     \
+        return rv;                                                    \
+    }                                                                 \
     IRNODE_COMMON_SUBCLASS(T)
 #define IRNODE_ABSTRACT_SUBCLASS(T) \
  public:                            \
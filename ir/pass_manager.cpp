@@ -16,14 +16,28 @@ limitations under the License.
 
 #include "pass_manager.h"
 
+#include <config.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "ir/dump.h"
+#include "ir/ir.h"
 #include "ir/node.h"
 #include "ir/visitor.h"
 #include "lib/error.h"
@@ -31,9 +45,187 @@ limitations under the License.
 #include "lib/indent.h"
 #include "lib/log.h"
 #include "lib/n4.h"
+#include "lib/telemetry.h"
+#include "lib/timer.h"
 
 namespace P4 {
 
+/// Whether apply_visitor should record a Util::ScopedTimer around each pass.
+static bool passTimersEnabled = false;
+
+void PassManager::enablePassTimers() { passTimersEnabled = true; }
+
+/// Whether apply_visitor should sample memory counters around each pass.
+static bool passProfilingEnabled = false;
+
+/// Accumulated profile rows, keyed by pass name. Passes sharing a name (e.g. a pass manager
+/// applied from several places) share a row.
+static std::map<std::string, PassManager::PassProfile> passProfiles;
+
+/// Bytes allocated on the GC heap since profiling was enabled, accumulated by the
+/// allocator's trace callback.
+static size_t tracedAllocBytes = 0;
+
+#if HAVE_LIBGC
+static void countAllocation(void *, void **, size_t sz) { tracedAllocBytes += sz; }
+#endif /* HAVE_LIBGC */
+
+void PassManager::enablePassProfiling() {
+#if HAVE_LIBGC
+    if (!passProfilingEnabled) {
+        passProfilingEnabled = true;
+        set_alloc_trace(countAllocation, nullptr);
+    }
+#endif /* HAVE_LIBGC */
+}
+
+namespace {
+
+/// Samples the GC heap, the allocation counter and the process peak RSS around one pass
+/// application and folds the deltas into the pass's profile row on destruction.
+struct PassProfiler {
+    const char *passName;
+    size_t inuseBefore;
+    size_t allocBefore;
+    size_t peakRssBefore;
+
+    static size_t peakRss() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    explicit PassProfiler(const char *passName)
+        : passName(passName),
+          inuseBefore(gc_mem_inuse()),
+          allocBefore(tracedAllocBytes),
+          peakRssBefore(peakRss()) {}
+
+    ~PassProfiler() {
+        size_t allocated = tracedAllocBytes - allocBefore;
+        // gc_mem_inuse forces a collection, so the in-use delta is meaningful: whatever the
+        // pass allocated but did not keep live has been reclaimed by now.
+        size_t inuseAfter = gc_mem_inuse();
+        auto &row = passProfiles[passName];
+        row.allocatedBytes += allocated;
+        if (inuseBefore + allocated > inuseAfter)
+            row.collectedBytes += inuseBefore + allocated - inuseAfter;
+        row.peakRssDelta += peakRss() - peakRssBefore;
+        ++row.invocations;
+    }
+};
+
+}  // namespace
+
+/// Whether apply_visitor should accumulate per-pass wall-clock costs.
+static bool passCostRecordingEnabled = false;
+
+/// Costs measured in this compile, keyed by pass name.
+static std::map<std::string, PassManager::PassCost> recordedPassCosts;
+
+/// Costs loaded from a sidecar profile written by an earlier compile.
+static std::map<std::string, PassManager::PassCost> loadedPassCosts;
+
+void PassManager::recordPassCosts() { passCostRecordingEnabled = true; }
+
+/// Name of the pass apply_visitor is currently running; see currentPassName().
+static const char *currentlyRunningPass = nullptr;
+
+const char *PassManager::currentPassName() { return currentlyRunningPass; }
+
+namespace {
+
+/// Keeps currentlyRunningPass pointing at the innermost pass while pass managers nest.
+struct CurrentPassScope {
+    const char *prev;
+
+    explicit CurrentPassScope(const char *passName) : prev(currentlyRunningPass) {
+        currentlyRunningPass = passName;
+    }
+    ~CurrentPassScope() { currentlyRunningPass = prev; }
+};
+
+/// Accumulates the wall-clock time of one pass application into its cost row.
+struct PassCostRecorder {
+    const char *passName;
+    std::chrono::steady_clock::time_point start;
+
+    explicit PassCostRecorder(const char *passName)
+        : passName(passName), start(std::chrono::steady_clock::now()) {}
+
+    ~PassCostRecorder() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        // ParallelInspect records from its worker threads
+        static std::mutex lock;
+        std::lock_guard<std::mutex> guard(lock);
+        auto &row = recordedPassCosts[passName];
+        row.usec += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        ++row.invocations;
+    }
+};
+
+}  // namespace
+
+void PassManager::dumpPassCosts(std::ostream &out) {
+    std::vector<const std::pair<const std::string, PassCost> *> rows;
+    for (auto &row : recordedPassCosts) rows.push_back(&row);
+    std::sort(rows.begin(), rows.end(),
+              [](auto *a, auto *b) { return a->second.usec > b->second.usec; });
+    out << "[";
+    const char *sep = "\n";
+    for (auto *row : rows) {
+        out << sep << "  {\"pass\": \"" << row->first << "\", \"usec\": " << row->second.usec
+            << ", \"invocations\": " << row->second.invocations << "}";
+        sep = ",\n";
+    }
+    out << "\n]" << std::endl;
+}
+
+bool PassManager::loadPassCosts(std::istream &in) {
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    static const std::string passKey = "{\"pass\": \"";
+    static const std::string usecKey = "\"usec\": ";
+    bool any = false;
+    for (size_t pos = text.find(passKey); pos != std::string::npos;
+         pos = text.find(passKey, pos)) {
+        pos += passKey.size();
+        size_t end = text.find('"', pos);
+        if (end == std::string::npos) break;
+        size_t usec = text.find(usecKey, end);
+        if (usec == std::string::npos) break;
+        auto &row = loadedPassCosts[text.substr(pos, end - pos)];
+        row.usec += strtoull(text.c_str() + usec + usecKey.size(), nullptr, 10);
+        ++row.invocations;
+        any = true;
+        pos = usec;
+    }
+    return any;
+}
+
+const PassManager::PassCost *PassManager::lookupPassCost(const char *pass) {
+    auto it = loadedPassCosts.find(pass);
+    return it != loadedPassCosts.end() ? &it->second : nullptr;
+}
+
+void PassManager::dumpPassProfile(std::ostream &out) {
+    std::vector<const std::pair<const std::string, PassProfile> *> rows;
+    for (auto &row : passProfiles) rows.push_back(&row);
+    std::sort(rows.begin(), rows.end(), [](auto *a, auto *b) {
+        return a->second.allocatedBytes > b->second.allocatedBytes;
+    });
+    out << "[";
+    const char *sep = "\n";
+    for (auto *row : rows) {
+        out << sep << "  {\"pass\": \"" << row->first
+            << "\", \"allocated_bytes\": " << row->second.allocatedBytes
+            << ", \"collected_bytes\": " << row->second.collectedBytes
+            << ", \"peak_rss_delta\": " << row->second.peakRssDelta
+            << ", \"invocations\": " << row->second.invocations << "}";
+        sep = ",\n";
+    }
+    out << "\n]" << std::endl;
+}
+
 void PassManager::removePasses(const std::vector<cstring> &exclude) {
     for (auto it : exclude) {
         bool excluded = false;
@@ -81,7 +273,17 @@ const IR::Node *PassManager::apply_visitor(const IR::Node *program, const char *
         try {
             try {
                 LOG1(log_indent << name() << " invoking " << v->name());
-                program = program->apply(**it, getChildContext());
+                {
+                    CurrentPassScope currentPass(v->name());
+                    std::optional<Util::ScopedTimer> passTimer;
+                    if (passTimersEnabled) passTimer.emplace(v->name());
+                    std::optional<PassProfiler> passProfiler;
+                    if (passProfilingEnabled) passProfiler.emplace(v->name());
+                    std::optional<PassCostRecorder> passCost;
+                    if (passCostRecordingEnabled) passCost.emplace(v->name());
+                    if (Util::Telemetry::enabled()) Util::Telemetry::count("passes_run");
+                    program = program->apply(**it, getChildContext());
+                }
                 if (LOGGING(3)) {
                     size_t maxmem, mem = gc_mem_inuse(&maxmem);  // triggers gc
                     LOG3(log_indent << "heap after " << v->name() << ": in use " << n4(mem)
@@ -146,20 +348,154 @@ void PassManager::runDebugHooks(const char *visitorName, const IR::Node *program
     for (auto h : debugHooks) h(name(), seqNo, visitorName, program);
 }
 
+unsigned ParallelInspect::maxThreads = 0;
+
+const IR::Node *ParallelInspect::apply_visitor(const IR::Node *program, const char *name) {
+    for (auto *v : passes)
+        BUG_CHECK(dynamic_cast<Inspector *>(v) != nullptr,
+                  "ParallelInspect pass %1% is not an Inspector", v->name());
+    if (passes.size() < 2 || maxThreads == 1) return PassManager::apply_visitor(program, name);
+
+    static std::once_flag allow_threads;
+    std::call_once(allow_threads, gc_allow_threads);
+
+    // With a loaded pass-cost profile, hand out the historically most expensive
+    // passes first: longest-first order keeps the workers balanced when pass
+    // costs are skewed.  Without a profile all costs are zero and the stable
+    // sort preserves the declared order.
+    safe_vector<size_t> order(passes.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        auto *ca = lookupPassCost(passes[a]->name());
+        auto *cb = lookupPassCost(passes[b]->name());
+        return (ca ? ca->usec : 0) > (cb ? cb->usec : 0);
+    });
+
+    // Run the whole group before checking for errors or running hooks: the tree is
+    // immutable here, so there is no partial result to lose, and the hooks expect to
+    // run on the pass manager's own thread.
+    safe_vector<std::exception_ptr> failures(passes.size());
+    size_t next = 0;
+    std::mutex worklist;
+    unsigned nthreads = maxThreads ? maxThreads : passes.size();
+    if (nthreads > passes.size()) nthreads = passes.size();
+    auto worker = [&]() {
+        gc_thread_scope gc_scope;
+        while (true) {
+            size_t idx;
+            {
+                std::lock_guard<std::mutex> lock(worklist);
+                if (next >= order.size()) return;
+                idx = order[next++];
+            }
+            try {
+                std::optional<PassCostRecorder> passCost;
+                if (passCostRecordingEnabled) passCost.emplace(passes[idx]->name());
+                program->apply(*passes[idx], getChildContext());
+            } catch (...) {
+                failures[idx] = std::current_exception();
+            }
+        }
+    };
+    safe_vector<std::thread> threads;
+    for (unsigned i = 0; i < nthreads; ++i) threads.emplace_back(worker);
+    for (auto &t : threads) t.join();
+    for (auto &fail : failures)
+        if (fail) std::rethrow_exception(fail);
+
+    for (auto *v : passes) {
+        runDebugHooks(v->name(), program);
+        seqNo++;
+    }
+    // An enclosing PassManager checks the global error count after every pass, so
+    // stop-on-error behavior is preserved simply by returning here.
+    running = false;
+    return program;
+}
+
+namespace {
+
+/// Names of the top-level declarations that differ between two versions of a
+/// program. Unchanged declarations are recognized by node identity, which
+/// transforms preserve for untouched subtrees. Returns nullopt when the roots
+/// are not P4Program nodes and no summary can be computed.
+std::optional<std::set<cstring>> summarizeChanges(const IR::Node *before, const IR::Node *after) {
+    const auto *oldProg = before->to<IR::P4Program>();
+    const auto *newProg = after->to<IR::P4Program>();
+    if (oldProg == nullptr || newProg == nullptr) return std::nullopt;
+
+    // Names may be overloaded (e.g. functions), so keep all nodes per name.
+    std::map<cstring, std::vector<const IR::Node *>> oldByName;
+    for (const auto *obj : oldProg->objects)
+        if (const auto *decl = obj->to<IR::IDeclaration>())
+            oldByName[decl->getName().name].push_back(obj);
+
+    std::set<cstring> changed;
+    for (const auto *obj : newProg->objects) {
+        const auto *decl = obj->to<IR::IDeclaration>();
+        if (decl == nullptr) continue;
+        auto it = oldByName.find(decl->getName().name);
+        const bool same = it != oldByName.end() &&
+                          std::find(it->second.begin(), it->second.end(), obj) != it->second.end();
+        if (!same) changed.insert(decl->getName().name);
+        if (it != oldByName.end()) {
+            auto pos = std::find(it->second.begin(), it->second.end(), obj);
+            if (pos != it->second.end()) it->second.erase(pos);
+            if (it->second.empty()) oldByName.erase(it);
+        }
+    }
+    // Whatever is left was removed (or replaced) in this round.
+    for (const auto &[delName, nodes] : oldByName) changed.insert(delName);
+    return changed;
+}
+
+}  // namespace
+
+void PassRepeated::announceChanges(const std::set<cstring> *changed) {
+    for (auto *pass : passes)
+        if (auto *tracking = dynamic_cast<DeclarationChangeTracking *>(pass))
+            tracking->setChangedDeclarations(changed);
+}
+
 const IR::Node *PassRepeated::apply_visitor(const IR::Node *program, const char *name) {
     bool done = false;
     unsigned iterations = 0;
     unsigned initial_error_count = ::P4::errorCount();
+    announceChanges(nullptr);
     while (!done) {
         LOG5("PassRepeated state is:\n" << dumpToString(program));
         running = true;
         auto newprogram = PassManager::apply_visitor(program, name);
-        if (program == newprogram || newprogram == nullptr) done = true;
-        if (stop_on_error && ::P4::errorCount() > initial_error_count) return program;
+        if (program == newprogram || newprogram == nullptr) {
+            done = true;
+        } else if (program->equiv(*newprogram)) {
+            // Some pass rebuilt the root without changing it structurally.
+            // Treat that as convergence rather than charging every member
+            // pass another full round, and keep the old tree so that side
+            // state computed against its nodes stays valid.
+            LOG3("PassRepeated converged on a structurally identical program");
+            done = true;
+            newprogram = program;
+        }
+        if (stop_on_error && ::P4::errorCount() > initial_error_count) {
+            announceChanges(nullptr);
+            return program;
+        }
         iterations++;
         if (repeats != 0 && iterations > repeats) done = true;
+        if (!done) {
+            // Tell interested member passes which top-level declarations the
+            // round actually modified, so the next round can skip the rest.
+            if (auto changed = summarizeChanges(program, newprogram)) {
+                lastRoundChanges = std::move(*changed);
+                announceChanges(&lastRoundChanges);
+            } else {
+                announceChanges(nullptr);
+            }
+        }
         program = newprogram;
     }
+    announceChanges(nullptr);
     return program;
 }
 
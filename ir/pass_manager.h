@@ -17,9 +17,12 @@ limitations under the License.
 #ifndef IR_PASS_MANAGER_H_
 #define IR_PASS_MANAGER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iosfwd>
+#include <set>
 #include <type_traits>
 #include <vector>
 
@@ -106,6 +109,52 @@ class PassManager : virtual public Visitor, virtual public Backtrack {
     bool backtrack(trigger &trig) override;
     bool never_backtracks() override;
     void setStopOnError(bool stop) { stop_on_error = stop; }
+    /// Wrap every pass applied by any PassManager in a Util::ScopedTimer named after the pass,
+    /// so that Util::getTimers() attributes wall-clock time to individual passes (nested pass
+    /// managers show up as dotted timer names). Off by default since the timers accumulate in
+    /// process-global state; enabled by timing consumers such as the p4c-bench harness.
+    static void enablePassTimers();
+    /// One row of the per-pass memory profile collected by enablePassProfiling(), accumulated
+    /// over all invocations of the pass.
+    struct PassProfile {
+        /// Bytes allocated on the GC heap while the pass ran.
+        size_t allocatedBytes = 0;
+        /// Bytes the collector reclaimed again by the end of the pass.
+        size_t collectedBytes = 0;
+        /// Growth of the process peak RSS during the pass, in the units of ru_maxrss
+        /// (kilobytes on Linux).
+        size_t peakRssDelta = 0;
+        uint64_t invocations = 0;
+    };
+    /// Record GC allocation, GC collection and peak-RSS numbers for every pass applied by any
+    /// PassManager. A collection is forced before and after each pass to attribute reclaimed
+    /// bytes, so profiled compiles run noticeably slower. Requires the collector; a no-op
+    /// when compiled without it.
+    static void enablePassProfiling();
+    /// Write the profile collected so far to @param out as a JSON array, sorted by allocated
+    /// bytes, largest first.
+    static void dumpPassProfile(std::ostream &out);
+    /// Wall-clock cost of one pass, accumulated over all of its invocations by
+    /// recordPassCosts().
+    struct PassCost {
+        uint64_t usec = 0;
+        uint64_t invocations = 0;
+    };
+    /// Record the wall-clock time of every pass applied by any PassManager, for
+    /// dumpPassCosts(). Much cheaper than enablePassProfiling(): two clock reads per pass.
+    static void recordPassCosts();
+    /// Write the costs recorded so far to @param out as a JSON array, most expensive first.
+    static void dumpPassCosts(std::ostream &out);
+    /// Load a sidecar profile previously written by dumpPassCosts(), typically from an
+    /// earlier compile of the same program; the costs become available through
+    /// lookupPassCost(). @return false if @param in does not look like such a profile.
+    static bool loadPassCosts(std::istream &in);
+    /// The loaded cost of @param pass, or nullptr if the profile has no entry for it.
+    static const PassCost *lookupPassCost(const char *pass);
+    /// The name of the pass some PassManager is currently applying, or nullptr outside of any
+    /// pass. When pass managers nest the innermost pass wins. Used by profilers (e.g. the
+    /// --heap-profile allocation sampler) to attribute work to passes.
+    static const char *currentPassName();
     void addDebugHook(DebugHook h, bool recursive = false) {
         debugHooks.push_back(h);
         if (recursive)
@@ -142,9 +191,54 @@ class OnBacktrack : virtual public Visitor, virtual public Backtrack {
     }
 };
 
+/// Runs a group of Inspector passes concurrently over the same (immutable) tree.
+///
+/// By grouping passes under a ParallelInspect the caller asserts that they are
+/// independent: none of them writes state that another one in the group reads (the
+/// tree itself is never modified, since only Inspectors are accepted).  Each pass
+/// runs on its own thread, registered with the garbage collector for the duration
+/// of the group.  Diagnostics reported through ErrorReporter are serialized, but
+/// their interleaving across passes is nondeterministic; passes that must see each
+/// other's results belong in an ordinary PassManager.
+///
+/// If the group contains fewer than two passes, or parallelism has been disabled
+/// (see setParallelism), the passes run sequentially exactly as in PassManager.
+class ParallelInspect : public PassManager {
+    static unsigned maxThreads;  // 0 = unlimited
+
+ public:
+    ParallelInspect() = default;
+    explicit ParallelInspect(const std::initializer_list<VisitorRef> &init) : PassManager(init) {}
+    const IR::Node *apply_visitor(const IR::Node *, const char * = 0) override;
+    /// Caps the number of worker threads used by all ParallelInspect groups;
+    /// 1 forces sequential execution, 0 (the default) uses one thread per pass.
+    static void setParallelism(unsigned threads) { maxThreads = threads; }
+    ParallelInspect *clone() const override { return new ParallelInspect(*this); }
+};
+
 // Repeat a pass until convergence (or up to a fixed number of repeats)
+/// Interface for member passes of a PassRepeated group that can restrict
+/// their work to the top-level declarations changed in the previous round.
+/// PassRepeated calls setChangedDeclarations before each round after the
+/// first with the names of the top-level declarations the previous round
+/// modified, added or removed; an opted-in pass may skip declarations not in
+/// the set. It is called with nullptr before the first round and after
+/// convergence, meaning "everything may have changed".
+class DeclarationChangeTracking {
+ public:
+    virtual ~DeclarationChangeTracking() = default;
+    virtual void setChangedDeclarations(const std::set<cstring> *changed) = 0;
+};
+
 class PassRepeated : virtual public PassManager {
     unsigned repeats;  // 0 = until convergence
+    /// Names of top-level declarations changed by the last completed round.
+    std::set<cstring> lastRoundChanges;
+
+    /// Distributes @changed to the member passes implementing
+    /// DeclarationChangeTracking.
+    void announceChanges(const std::set<cstring> *changed);
+
  public:
     PassRepeated() : repeats(0) {}
     explicit PassRepeated(const std::initializer_list<VisitorRef> &init, unsigned repeats = 0)
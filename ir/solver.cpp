@@ -0,0 +1,48 @@
+#include "ir/solver.h"
+
+#include <algorithm>
+
+namespace P4 {
+
+std::vector<int> SolverService::cacheKey(const std::vector<const Constraint *> &asserts) {
+    std::vector<int> key;
+    key.reserve(asserts.size());
+    for (const auto *constraint : asserts) key.push_back(constraint->id);
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+std::optional<bool> SolverService::checkSat(cstring client,
+                                            const std::vector<const Constraint *> &asserts) {
+    auto &clientStats = stats[client];
+    clientStats.queries++;
+    auto key = cacheKey(asserts);
+    if (knownUnsat.count(key)) {
+        clientStats.cacheHits++;
+        clientStats.unsat++;
+        return false;
+    }
+    auto result = solver.checkSat(asserts);
+    if (!result.has_value()) {
+        clientStats.unknown++;
+    } else if (*result) {
+        clientStats.sat++;
+    } else {
+        clientStats.unsat++;
+        knownUnsat.emplace(std::move(key));
+    }
+    return result;
+}
+
+SolverService::ClientStats SolverService::getStats(cstring client) const {
+    if (auto it = stats.find(client); it != stats.end()) return it->second;
+    return ClientStats();
+}
+
+void SolverService::dumpStats(std::ostream &out) const {
+    for (const auto &[client, s] : stats)
+        out << client << ": " << s.queries << " queries, " << s.cacheHits << " cached, " << s.sat
+            << " sat, " << s.unsat << " unsat, " << s.unknown << " unknown\n";
+}
+
+}  // namespace P4
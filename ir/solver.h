@@ -2,6 +2,8 @@
 #define IR_SOLVER_H_
 
 #include <optional>
+#include <ostream>
+#include <set>
 #include <vector>
 
 #include "ir/compare.h"
@@ -9,6 +11,7 @@
 #include "lib/castable.h"
 #include "lib/cstring.h"
 #include "lib/flat_map.h"
+#include "lib/ordered_map.h"
 
 namespace P4 {
 
@@ -58,6 +61,59 @@ class AbstractSolver : public ICastable {
     DECLARE_TYPEINFO(AbstractSolver);
 };
 
+/**
+ * Routes the satisfiability queries of several compilation phases through one long-lived
+ * AbstractSolver, so a sequence of related solves shares the solver's learned state instead
+ * of each phase starting cold.  Queries are assumption-based: the constraints of one query
+ * are not permanently asserted, so clients cannot invalidate each other's results.
+ *
+ * Constraint sets proven unsatisfiable are additionally memoized, keyed by the (order
+ * independent) set of constraint nodes, so a phase re-issuing a query over the same nodes is
+ * answered without a solver call.  Satisfiable results are never memoized, because they are
+ * usually followed by getSymbolicMapping(), which must reflect actual solver state.  Clients
+ * identify themselves by name and the service keeps per-client statistics for triage.
+ */
+class SolverService {
+ public:
+    /// Query statistics of one client.
+    struct ClientStats {
+        size_t queries = 0;    ///< checkSat calls issued by the client.
+        size_t cacheHits = 0;  ///< Queries answered from the unsat memo without a solver call.
+        size_t sat = 0;        ///< Queries answered satisfiable.
+        size_t unsat = 0;      ///< Queries answered unsatisfiable, including memoized ones.
+        size_t unknown = 0;    ///< Queries the solver could not decide (e.g. timeout).
+    };
+
+    explicit SolverService(AbstractSolver &solver) : solver(solver) {}
+
+    /// Checks the conjunction of @p asserts on behalf of @p client; the result has the same
+    /// meaning as AbstractSolver::checkSat.
+    std::optional<bool> checkSat(cstring client, const std::vector<const Constraint *> &asserts);
+
+    /// The solution of the last satisfiable checkSat query; see
+    /// AbstractSolver::getSymbolicMapping.
+    [[nodiscard]] const SymbolicMapping &getSymbolicMapping() const {
+        return solver.getSymbolicMapping();
+    }
+
+    /// The statistics accumulated for @p client; all-zero if the client never queried.
+    [[nodiscard]] ClientStats getStats(cstring client) const;
+
+    /// Writes one line of statistics per client, in the order clients first queried.
+    void dumpStats(std::ostream &out) const;
+
+ private:
+    /// The memoization key of @p asserts: the sorted node ids of the constraint set.  Keying
+    /// on node identity is conservative -- a structurally equal but rebuilt constraint misses
+    /// the memo -- but can never conflate two different constraint systems.
+    static std::vector<int> cacheKey(const std::vector<const Constraint *> &asserts);
+
+    AbstractSolver &solver;
+    ordered_map<cstring, ClientStats> stats;
+    /// Keys of the constraint sets already proven unsatisfiable.
+    std::set<std::vector<int>> knownUnsat;
+};
+
 }  // namespace P4
 
 #endif /* IR_SOLVER_H_ */
@@ -15,9 +15,10 @@ limitations under the License.
 */
 
 #include <cstddef>
-#include <map>
+#include <mutex>
 #include <utility>
 
+#include "absl/container/flat_hash_map.h"
 #include "frontends/common/parser_options.h"
 #include "ir/configuration.h"
 #include "ir/id.h"
@@ -56,12 +57,19 @@ long Type_Any::nextId = 0;
 const Type *Type_Array::at(size_t) const { return elementType; }
 
 const Type_Bits *Type_Bits::get(int width, bool isSigned) {
-    // map (width, signed) to type
+    // Bit types are interned, keyed by (width, signed).  The map is guarded by a
+    // mutex since type inference interns from worker threads under
+    // --parallel-typecheck.
     using bit_type_key = std::pair<int, bool>;
-    static std::map<bit_type_key, const IR::Type_Bits *> *type_map = nullptr;
-    if (type_map == nullptr) type_map = new std::map<bit_type_key, const IR::Type_Bits *>();
-    auto &result = (*type_map)[std::make_pair(width, isSigned)];
-    if (!result) result = new Type_Bits(width, isSigned);
+    static std::mutex TYPES_MUTEX;
+    static absl::flat_hash_map<bit_type_key, const IR::Type_Bits *> TYPES;
+    const IR::Type_Bits *result;
+    {
+        std::lock_guard<std::mutex> lock(TYPES_MUTEX);
+        auto *&interned = TYPES[std::make_pair(width, isSigned)];
+        if (!interned) interned = new Type_Bits(width, isSigned);
+        result = interned;
+    }
     if (width > P4CContext::getConfig().maximumWidthSupported())
         ::P4::error(ErrorType::ERR_UNSUPPORTED, "%1%: Compiler only supports widths up to %2%",
                     result, P4CContext::getConfig().maximumWidthSupported());
@@ -148,7 +156,16 @@ const Type_Varbits *Type_Varbits::get(const Util::SourceInfo &si, int sz) {
     return result;
 }
 
-const Type_Varbits *Type_Varbits::get(int sz) { return new Type_Varbits(sz); }
+const Type_Varbits *Type_Varbits::get(int sz) {
+    // Varbit types without source info are interned, keyed by width.  Guarded by a
+    // mutex for the same reason as Type_Bits::get above.
+    static std::mutex TYPES_MUTEX;
+    static absl::flat_hash_map<int, const IR::Type_Varbits *> TYPES;
+    std::lock_guard<std::mutex> lock(TYPES_MUTEX);
+    auto *&result = TYPES[sz];
+    if (!result) result = new Type_Varbits(sz);
+    return result;
+}
 
 const Type_Varbits *Type_Varbits::get() { return new Type_Varbits(0); }
 
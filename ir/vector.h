@@ -69,6 +69,7 @@ class Vector : public VectorBase {
     Vector &operator=(Vector &&) = default;
     explicit Vector(const T *a) { vec.emplace_back(a); }
     explicit Vector(const safe_vector<const T *> &a) { vec.insert(vec.end(), a.begin(), a.end()); }
+    explicit Vector(safe_vector<const T *> &&a) : vec(std::move(a)) {}
     Vector(std::initializer_list<const T *> a) : vec(a) {}
     template <class InputIt>
     Vector(InputIt first, InputIt last) : vec(first, last) {}
@@ -97,6 +98,8 @@ class Vector : public VectorBase {
     std::reverse_iterator<const_iterator> rend() const { return vec.rend(); }
     size_t size() const override { return vec.size(); }
     void resize(size_t sz) { vec.resize(sz); }
+    void reserve(size_t sz) { vec.reserve(sz); }
+    size_t capacity() const { return vec.capacity(); }
     bool empty() const override { return vec.empty(); }
     const T *const &front() const { return vec.front(); }
     const T *&front() { return vec.front(); }
@@ -112,6 +115,19 @@ class Vector : public VectorBase {
     iterator append(const Container &toAppend) {
         return insert(end(), toAppend.begin(), toAppend.end());
     }
+    /// Moves the elements of another Vector onto the end of this one, stealing the
+    /// other vector's storage when this one is empty.  The argument is left empty.
+    iterator append(Vector &&toMove) {
+        if (vec.empty()) {
+            vec = std::move(toMove.vec);
+            toMove.vec.clear();
+            return vec.begin();
+        }
+        size_t at = vec.size();
+        vec.insert(vec.end(), toMove.vec.begin(), toMove.vec.end());
+        toMove.vec.clear();
+        return vec.begin() + at;
+    }
     template <typename Container>
     iterator prepend(const Container &toAppend) {
         return insert(begin(), toAppend.begin(), toAppend.end());
@@ -178,6 +194,7 @@ class Vector : public VectorBase {
     bool equiv(const Node &a_) const override {
         if (static_cast<const Node *>(this) == &a_) return true;
         if (this->typeId() != a_.typeId()) return false;
+        if (this->getEquivHash() != a_.getEquivHash()) return false;
         auto &a = static_cast<const Vector<T> &>(a_);
         if (size() != a.size()) return false;
         auto it = a.begin();
@@ -185,6 +202,12 @@ class Vector : public VectorBase {
             if (!el->equiv(**it++)) return false;
         return true;
     }
+    uint64_t computeEquivHash() const override {
+        uint64_t h = Node::computeEquivHash();
+        h = Util::hash_combine(h, size());
+        for (auto *el : *this) h = Util::hash_combine(h, el->getEquivHash());
+        return h;
+    }
     cstring node_type_name() const override { return "Vector<" + T::static_type_name() + ">"; }
     static cstring static_type_name() { return "Vector<" + T::static_type_name() + ">"; }
     void visit_children(Visitor &v, const char *name) override;
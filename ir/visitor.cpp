@@ -17,9 +17,12 @@ limitations under the License.
 #include "visitor.h"
 
 #include <config.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
 
+#include <vector>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -38,6 +41,7 @@ limitations under the License.
 #include "ir/ir.h"
 #include "ir/vector.h"
 #include "lib/algorithm.h"
+#include "lib/bitvec.h"
 #include "lib/error_catalog.h"
 #include "lib/indent.h"
 #include "lib/log.h"
@@ -56,15 +60,43 @@ enum class VisitStatus : unsigned { New, Revisit, Busy, Done };
  *  returns the new IR if it changed.
  */
 class Visitor::ChangeTracker {
-    struct visit_info_t {
-        // FIXME: We should be able to put these two bools into low 2 bits of
-        // `result` saving 8 bytes per record
-        bool visit_in_progress;
-        bool visitOnce;
-        const IR::Node *result;
+    /// Packs the result pointer and the two visit flags into a single word: IR nodes
+    /// are at least 8-byte aligned, so the low bits of the pointer are free.  This
+    /// halves the record size, which directly improves the density (and therefore the
+    /// probe behavior) of the open-addressing visited table below.
+    class visit_info_t {
+        static constexpr uintptr_t IN_PROGRESS = 1;
+        static constexpr uintptr_t VISIT_ONCE = 2;
+        static constexpr uintptr_t FLAGS = IN_PROGRESS | VISIT_ONCE;
+        uintptr_t data;
+
+     public:
+        visit_info_t(bool in_progress, bool visit_once, const IR::Node *result)
+            : data(reinterpret_cast<uintptr_t>(result) | (in_progress ? IN_PROGRESS : 0) |
+                   (visit_once ? VISIT_ONCE : 0)) {}
+        bool visit_in_progress() const { return data & IN_PROGRESS; }
+        void setVisitInProgress(bool b) {
+            data = b ? (data | IN_PROGRESS) : (data & ~IN_PROGRESS);
+        }
+        bool visitOnce() const { return data & VISIT_ONCE; }
+        void setVisitOnce(bool b) { data = b ? (data | VISIT_ONCE) : (data & ~VISIT_ONCE); }
+        const IR::Node *result() const { return reinterpret_cast<const IR::Node *>(data & ~FLAGS); }
+        void setResult(const IR::Node *r) {
+            data = reinterpret_cast<uintptr_t>(r) | (data & FLAGS);
+        }
     };
+    static_assert(alignof(IR::Node) >= 4, "tagged visit_info_t needs two free pointer bits");
+    /// The container behind this alias is a one-line swap; P4::hvec_map matches the API
+    /// used here (find/emplace/count/erase and capacity hints) if insertion-ordered
+    /// iteration ever becomes useful for revisit_visited().
     using visited_t = absl::flat_hash_map<const IR::Node *, visit_info_t, Util::Hash>;
     bool forceClone;
+    /// Set whenever apply_visitor returns a different node than it was given; each
+    /// Transform frame saves/resets it around visiting its children (like prune_flag)
+    /// to learn whether anything below changed without a structural comparison.  It
+    /// lives here rather than in the visitor because cloned flow visitors share the
+    /// tracker, so changes made by split child visits propagate to the parent frame.
+    bool child_changed = false;
     visited_t visited;
 
  public:
@@ -73,6 +105,42 @@ class Visitor::ChangeTracker {
           visited(16) {}  // Pre-allocate 16 slots as usually these maps are small, but we do create
                           // lots of them. This saves quite some time for rehashes
 
+    /** Obtain a tracker from the calling thread's pool, or allocate a fresh one.
+     * A tracker is created for every apply() -- tens of thousands of times per
+     * compile, often nested -- so instead of re-growing each map from scratch the
+     * backing table is recycled: clearing an absl::flat_hash_map keeps its buckets.
+     * The deleter clears eagerly (dropping node pointers while they may still be
+     * collectable) and returns the tracker to the pool of whichever thread drops
+     * the last reference, so visitor clones can release on any thread.
+     */
+    static std::shared_ptr<ChangeTracker> acquire(bool forceClone) {
+        auto &pool = freeList();
+        ChangeTracker *t;
+        if (pool.empty()) {
+            t = new ChangeTracker(forceClone);
+        } else {
+            t = pool.back().release();
+            pool.pop_back();
+            t->forceClone = forceClone;
+            t->child_changed = false;
+        }
+        return std::shared_ptr<ChangeTracker>(t, [](ChangeTracker *t) {
+            t->visited.clear();
+            auto &pool = freeList();
+            if (pool.size() < 64)
+                pool.emplace_back(t);
+            else
+                delete t;
+        });
+    }
+
+ private:
+    static std::vector<std::unique_ptr<ChangeTracker>> &freeList() {
+        static thread_local std::vector<std::unique_ptr<ChangeTracker>> pool;
+        return pool;
+    }
+
+ public:
     /** Begin tracking @n during a visiting pass.  Use `finish(@n)` to mark @n as
      * visited once the pass completes.
      *
@@ -83,12 +151,12 @@ class Visitor::ChangeTracker {
      */
     [[nodiscard]] VisitStatus try_start(const IR::Node *n, bool defaultVisitOnce) {
         // Initialization
-        auto [it, inserted] = visited.emplace(n, visit_info_t{true, defaultVisitOnce, n});
+        auto [it, inserted] = visited.emplace(n, visit_info_t(true, defaultVisitOnce, n));
 
         if (!inserted) {  // We already seen this node, determine its status
-            if (it->second.visit_in_progress) return VisitStatus::Busy;
-            if (it->second.visitOnce) return VisitStatus::Done;
-            it->second.visit_in_progress = true;
+            if (it->second.visit_in_progress()) return VisitStatus::Busy;
+            if (it->second.visitOnce()) return VisitStatus::Done;
+            it->second.setVisitInProgress(true);
             return VisitStatus::Revisit;
         }
 
@@ -103,28 +171,32 @@ class Visitor::ChangeTracker {
      * If @final is a new node, that node is marked as finished as well, as if
      * `start(@final); finish(@final);` were invoked.
      *
+     * @param knownChanged the caller has already established that @final differs
+     * structurally from @orig (e.g. a descendant was replaced), so the equality
+     * comparison can be skipped.
+     *
      * @return true if the node has changed or been removed or coalesced.
      *
      * @exception Util::CompilerBug This method fails if `start(@orig)` has not
      * previously been invoked.
      */
-    bool finish(const IR::Node *orig, const IR::Node *final) {
+    bool finish(const IR::Node *orig, const IR::Node *final, bool knownChanged = false) {
         auto it = visited.find(orig);
         if (it == visited.end()) BUG("visitor state tracker corrupted");
 
         visit_info_t *orig_visit_info = &(it->second);
-        orig_visit_info->visit_in_progress = false;
+        orig_visit_info->setVisitInProgress(false);
         if (!final) {
-            orig_visit_info->result = final;
+            orig_visit_info->setResult(final);
             return true;
-        } else if (forceClone || (final != orig && *final != *orig)) {
-            orig_visit_info->result = final;
-            visited.emplace(final, visit_info_t{false, orig_visit_info->visitOnce, final});
+        } else if (forceClone || (final != orig && (knownChanged || *final != *orig))) {
+            orig_visit_info->setResult(final);
+            visited.emplace(final, visit_info_t(false, orig_visit_info->visitOnce(), final));
             return true;
-        } else if (visited.count(final)) {
+        } else if (final != orig && visited.count(final)) {
             // coalescing with some previously visited node, so we don't want to undo
             // the coalesce
-            orig_visit_info->result = final;
+            orig_visit_info->setResult(final);
             return true;
         } else {
             // FIXME -- not safe if the visitor resurrects the node (which it shouldn't)
@@ -134,18 +206,21 @@ class Visitor::ChangeTracker {
         }
     }
 
+    [[nodiscard]] bool childChanged() const { return child_changed; }
+    void setChildChanged(bool v) { child_changed = v; }
+
     /** Return a visitOnce flag for node @n */
     [[nodiscard]] bool shouldVisitOnce(const IR::Node *n) const {
         auto it = visited.find(n);
         if (it == visited.end()) BUG("visitor state tracker corrupted");
-        return it->second.visitOnce;
+        return it->second.visitOnce();
     }
 
     /** Forget nodes that have already been visited, allowing them to be visited
      * again. */
     void revisit_visited() {
         for (auto it = visited.begin(); it != visited.end();) {
-            if (!it->second.visit_in_progress)
+            if (!it->second.visit_in_progress())
                 // `visited` is abseil map, therefore erase does not return iterator, use
                 // post-increment
                 visited.erase(it++);
@@ -161,7 +236,7 @@ class Visitor::ChangeTracker {
      */
     [[nodiscard]] bool busy(const IR::Node *n) const {
         auto it = visited.find(n);
-        return it != visited.end() && it->second.visit_in_progress;
+        return it != visited.end() && it->second.visit_in_progress();
     }
 
     /** Determine whether @n has been visited and the visitor has finished
@@ -173,7 +248,7 @@ class Visitor::ChangeTracker {
      */
     [[nodiscard]] bool done(const IR::Node *n) const {
         auto it = visited.find(n);
-        return it != visited.end() && !it->second.visit_in_progress && it->second.visitOnce;
+        return it != visited.end() && !it->second.visit_in_progress() && it->second.visitOnce();
     }
 
     /** Produce the result of visiting @n.
@@ -185,7 +260,7 @@ class Visitor::ChangeTracker {
     const IR::Node *result(const IR::Node *n) const {
         auto it = visited.find(n);
         if (it == visited.end()) return n;
-        return it->second.result;
+        return it->second.result();
     }
 
     /** Produce the final result of visiting @n.
@@ -195,20 +270,21 @@ class Visitor::ChangeTracker {
      */
     const IR::Node *finalResult(const IR::Node *n) const {
         auto it = visited.find(n);
-        bool done = it != visited.end() && !it->second.visit_in_progress && it->second.visitOnce;
-        return done ? it->second.result : nullptr;
+        bool done =
+            it != visited.end() && !it->second.visit_in_progress() && it->second.visitOnce();
+        return done ? it->second.result() : nullptr;
     }
 
     void visitOnce(const IR::Node *n) {
         auto it = visited.find(n);
         if (it == visited.end()) BUG("visitor state tracker corrupted");
-        it->second.visitOnce = true;
+        it->second.setVisitOnce(true);
     }
 
     void visitAgain(const IR::Node *n) {
         auto it = visited.find(n);
         if (it == visited.end()) BUG("visitor state tracker corrupted");
-        it->second.visitOnce = false;
+        it->second.setVisitOnce(false);
     }
 };
 
@@ -232,6 +308,35 @@ class Visitor::Tracker {
         : visited(16) {}  // Pre-allocate 16 slots as usually these maps are small, but we do create
                           // lots of them. This saves quite some time for rehashes
 
+    /// Obtain a tracker from the calling thread's pool, or allocate a fresh one;
+    /// see ChangeTracker::acquire for the rationale and the recycling contract.
+    static std::shared_ptr<Tracker> acquire() {
+        auto &pool = freeList();
+        Tracker *t;
+        if (pool.empty()) {
+            t = new Tracker();
+        } else {
+            t = pool.back().release();
+            pool.pop_back();
+        }
+        return std::shared_ptr<Tracker>(t, [](Tracker *t) {
+            t->visited.clear();
+            auto &pool = freeList();
+            if (pool.size() < 64)
+                pool.emplace_back(t);
+            else
+                delete t;
+        });
+    }
+
+ private:
+    static std::vector<std::unique_ptr<Tracker>> &freeList() {
+        static thread_local std::vector<std::unique_ptr<Tracker>> pool;
+        return pool;
+    }
+
+ public:
+
     /** Forget nodes that have already been visited, allowing them to be visited
      * again. */
     void revisit_visited() {
@@ -361,17 +466,21 @@ Visitor::profile_t Visitor::init_apply(const IR::Node *root, const Context *pare
 }
 Visitor::profile_t Modifier::init_apply(const IR::Node *root) {
     auto rv = Visitor::init_apply(root);
-    visited = std::make_shared<ChangeTracker>(forceClone);
+    visited = ChangeTracker::acquire(forceClone);
     return rv;
 }
 Visitor::profile_t Inspector::init_apply(const IR::Node *root) {
     auto rv = Visitor::init_apply(root);
-    visited = std::make_shared<Tracker>();
+    if (neverRevisit) {
+        BUG_CHECK(!joinFlows, "%s: neverRevisit cannot be combined with joinFlows", name());
+    } else {
+        visited = Tracker::acquire();
+    }
     return rv;
 }
 Visitor::profile_t Transform::init_apply(const IR::Node *root) {
     auto rv = Visitor::init_apply(root);
-    visited = std::make_shared<ChangeTracker>(forceClone);
+    visited = ChangeTracker::acquire(forceClone);
     return rv;
 }
 void Visitor::end_apply() {}
@@ -399,11 +508,17 @@ Visitor::profile_t::~profile_t() {
     }
 }
 
-void Inspector::visitOnce() const { visited->visitOnce(getOriginal()); }
+void Inspector::visitOnce() const {
+    BUG_CHECK(visited != nullptr, "%s: visitOnce with neverRevisit set", name());
+    visited->visitOnce(getOriginal());
+}
 void Modifier::visitOnce() const { visited->visitOnce(getOriginal()); }
 void Transform::visitOnce() const { visited->visitOnce(getOriginal()); }
 
-void Inspector::visitAgain() const { visited->visitAgain(getOriginal()); }
+void Inspector::visitAgain() const {
+    BUG_CHECK(visited != nullptr, "%s: visitAgain with neverRevisit set", name());
+    visited->visitAgain(getOriginal());
+}
 void Modifier::visitAgain() const { visited->visitAgain(getOriginal()); }
 void Transform::visitAgain() const { visited->visitAgain(getOriginal()); }
 
@@ -460,18 +575,114 @@ namespace {
 class ForwardChildren : public Visitor {
     const ChangeTracker &visited;
     const IR::Node *apply_visitor(const IR::Node *n, const char * = 0) {
-        if (const auto *result = visited.finalResult(n)) return result;
+        if (const auto *result = visited.finalResult(n)) {
+            if (result != n) changed = true;
+            return result;
+        }
         return n;
     }
 
  public:
     explicit ForwardChildren(const ChangeTracker &v) : visited(v) {}
+    bool changed = false;  // did forwarding replace any child?
 };
 }  // namespace
 
+/// Dispatch interest of a visitor that called dispatchOnly<>(): one bit per
+/// generated node kind, plus separate sets for the Vector/IndexedVector
+/// template instantiations, which are keyed by the kind of the element type.
+/// reachWords holds the kind of every registered class (the element kind for
+/// the template instantiations) as a word array matching the layout of the
+/// generated IR::nodeKindReachable rows, so a subtree that cannot contain any
+/// registered kind is detected with a word-wise intersection.
+struct Visitor::DispatchMask {
+    bitvec kinds;
+    bitvec vectorKinds;
+    bitvec indexedVectorKinds;
+    std::vector<uint64_t> reachWords =
+        std::vector<uint64_t>(sizeof(IR::nodeKindReachable[0]) / sizeof(uint64_t), 0);
+};
+
+void Visitor::addDispatchInterest(RTTI::TypeId id) {
+    auto *mask = const_cast<DispatchMask *>(dispatchMask);
+    if (!mask) dispatchMask = mask = new DispatchMask;
+    size_t inner = RTTI::innerTypeId(id);
+    BUG_CHECK(inner < IR::NodeKindCount, "dispatchOnly: invalid node typeid %1%", id);
+    switch (RTTI::typeidDiscriminator(id)) {
+        case 0:
+            mask->kinds[inner] = 1;
+            break;
+        case RTTI::TypeId(IR::NodeDiscriminator::VectorT):
+            mask->vectorKinds[inner] = 1;
+            break;
+        case RTTI::TypeId(IR::NodeDiscriminator::IndexedVectorT):
+            mask->indexedVectorKinds[inner] = 1;
+            break;
+        default:
+            BUG("dispatchOnly: unsupported typeid %1%", id);
+    }
+    // A Vector<T> or IndexedVector<T> can only occur where a T element can,
+    // so the element kind stands in for the container in the reachability
+    // intersection as well.
+    mask->reachWords[inner / 64] |= UINT64_C(1) << (inner % 64);
+}
+
+bool Visitor::wantDispatchSlow(const IR::Node *n) const {
+    RTTI::TypeId id = n->typeId();
+    size_t kind = RTTI::innerTypeId(id);
+    switch (RTTI::typeidDiscriminator(id)) {
+        case 0:
+            break;
+        case RTTI::TypeId(IR::NodeDiscriminator::VectorT):
+            if (kind < IR::NodeKindCount && dispatchMask->vectorKinds.getbit(kind)) return true;
+            // the default Vector<T> handlers forward directly to the Node overload
+            kind = size_t(IR::NodeKind::Node);
+            break;
+        case RTTI::TypeId(IR::NodeDiscriminator::IndexedVectorT):
+            // the default IndexedVector<T> handlers forward to Vector<T>, then Node
+            if (kind < IR::NodeKindCount && (dispatchMask->indexedVectorKinds.getbit(kind) ||
+                                             dispatchMask->vectorKinds.getbit(kind)))
+                return true;
+            kind = size_t(IR::NodeKind::Node);
+            break;
+        default:
+            return true;  // not a generated node kind -- never skip
+    }
+    if (kind >= IR::NodeKindCount) return true;
+    // Walk the generated default dispatch chain, which terminates at Node.
+    while (true) {
+        if (dispatchMask->kinds.getbit(kind)) return true;
+        if (kind == size_t(IR::NodeKind::Node)) return false;
+        kind = size_t(IR::nodeKindDispatchParent[kind]);
+    }
+}
+
+bool Visitor::wantVisitSlow(const IR::Node *n) const {
+    RTTI::TypeId id = n->typeId();
+    size_t kind = RTTI::innerTypeId(id);
+    switch (RTTI::typeidDiscriminator(id)) {
+        case 0:
+        case RTTI::TypeId(IR::NodeDiscriminator::VectorT):
+        case RTTI::TypeId(IR::NodeDiscriminator::IndexedVectorT):
+            // For the containers the inner kind is the element type, whose
+            // subclass-closed row covers everything the elements can hold.
+            break;
+        default:
+            return true;  // not a generated node kind -- never skip
+    }
+    if (kind >= IR::NodeKindCount) return true;
+    const auto &interest = dispatchMask->reachWords;
+    const uint64_t *row = IR::nodeKindReachable[kind];
+    for (size_t i = 0; i < interest.size(); ++i)
+        if ((row[i] & interest[i]) != 0) return true;
+    return false;
+}
+
 const IR::Node *Modifier::apply_visitor(const IR::Node *n, const char *name) {
     if (ctxt) ctxt->child_name = name;
-    if (n) {
+    if (n && !wantVisit(n)) {
+        // nothing the visitor dispatches can occur in this subtree -- skip it
+    } else if (n) {
         PushContext local(ctxt, n);
         switch (visited->try_start(n, visitDagOnce)) {
             case VisitStatus::Busy:
@@ -480,19 +691,20 @@ const IR::Node *Modifier::apply_visitor(const IR::Node *n, const char *name) {
                 // by the visitor somehow, but it is tough
                 break;
             case VisitStatus::Done:
-                n->apply_visitor_revisit(*this, visited->result(n));
+                if (wantDispatch(n)) n->apply_visitor_revisit(*this, visited->result(n));
                 n = visited->result(n);
                 break;
             default: {  // New or Revisit
+                bool dispatch = wantDispatch(n);
                 IR::Node *copy = n->clone();
                 local.current.node = copy;
                 if (!dontForwardChildrenBeforePreorder) {
                     ForwardChildren forward_children(*visited);
                     copy->visit_children(forward_children, name);
                 }
-                if (copy->apply_visitor_preorder(*this)) {
+                if (!dispatch || copy->apply_visitor_preorder(*this)) {
                     copy->visit_children(*this, name);
-                    copy->apply_visitor_postorder(*this);
+                    if (dispatch) copy->apply_visitor_postorder(*this);
                 }
                 if (visited->finish(n, copy)) {
                     copy->validate();
@@ -512,21 +724,32 @@ const IR::Node *Modifier::apply_visitor(const IR::Node *n, const char *name) {
 
 const IR::Node *Inspector::apply_visitor(const IR::Node *n, const char *name) {
     if (ctxt) ctxt->child_name = name;
-    if (n && !join_flows(n)) {
+    if (n && !wantVisit(n)) {
+        // nothing the visitor dispatches can occur in this subtree -- skip it
+    } else if (n && !join_flows(n)) {
         PushContext local(ctxt, n);
-        switch (visited->try_start(n, visitDagOnce)) {
-            case VisitStatus::Busy:
-                n->apply_visitor_loop_revisit(*this);
-                break;
-            case VisitStatus::Done:
-                n->apply_visitor_revisit(*this);
-                break;
-            default:  // New or Revisit
-                if (n->apply_visitor_preorder(*this)) {
-                    n->visit_children(*this, name);
-                    n->apply_visitor_postorder(*this);
-                }
-                visited->finish(n);
+        bool dispatch = wantDispatch(n);
+        if (neverRevisit) {
+            // No visited bookkeeping: every path to a node inspects it.
+            if (!dispatch || n->apply_visitor_preorder(*this)) {
+                n->visit_children(*this, name);
+                if (dispatch) n->apply_visitor_postorder(*this);
+            }
+        } else {
+            switch (visited->try_start(n, visitDagOnce)) {
+                case VisitStatus::Busy:
+                    n->apply_visitor_loop_revisit(*this);
+                    break;
+                case VisitStatus::Done:
+                    if (dispatch) n->apply_visitor_revisit(*this);
+                    break;
+                default:  // New or Revisit
+                    if (!dispatch || n->apply_visitor_preorder(*this)) {
+                        n->visit_children(*this, name);
+                        if (dispatch) n->apply_visitor_postorder(*this);
+                    }
+                    visited->finish(n);
+            }
         }
         post_join_flows(n, n);
     }
@@ -539,8 +762,11 @@ const IR::Node *Inspector::apply_visitor(const IR::Node *n, const char *name) {
 }
 
 const IR::Node *Transform::apply_visitor(const IR::Node *n, const char *name) {
+    const IR::Node *orig_n = n;
     if (ctxt) ctxt->child_name = name;
-    if (n) {
+    if (n && !wantVisit(n)) {
+        // nothing the visitor dispatches can occur in this subtree -- skip it
+    } else if (n) {
         PushContext local(ctxt, n);
         switch (visited->try_start(n, visitDagOnce)) {
             case VisitStatus::Busy:
@@ -549,20 +775,28 @@ const IR::Node *Transform::apply_visitor(const IR::Node *n, const char *name) {
                 // by the visitor somehow, but it is tough
                 break;
             case VisitStatus::Done:
-                n->apply_visitor_revisit(*this, visited->result(n));
+                if (wantDispatch(n)) n->apply_visitor_revisit(*this, visited->result(n));
                 n = visited->result(n);
                 break;
             default: {  // New or Revisit
+                bool dispatch = wantDispatch(n);
                 auto *copy = n->clone();
                 local.current.node = copy;
+                bool forwarded_change = false;
                 if (!dontForwardChildrenBeforePreorder) {
                     ForwardChildren forward_children(*visited);
                     copy->visit_children(forward_children, name);
+                    forwarded_change = forward_children.changed;
                 }
                 bool save_prune_flag = prune_flag;
                 prune_flag = false;
+                // track whether any visit below this node replaced its node, so unchanged
+                // subtrees can be recognized without a structural comparison afterwards
+                bool save_child_changed = visited->childChanged();
+                visited->setChildChanged(forwarded_change);
                 bool extra_clone = false;
-                const IR::Node *preorder_result = copy->apply_visitor_preorder(*this);
+                const IR::Node *preorder_result =
+                    dispatch ? copy->apply_visitor_preorder(*this) : copy;
                 assert(preorder_result != n);  // should never happen
                 const IR::Node *final_result = preorder_result;
                 if (preorder_result != copy) {
@@ -574,6 +808,7 @@ const IR::Node *Transform::apply_visitor(const IR::Node *n, const char *name) {
                     } else if (visited->done(preorder_result)) {
                         final_result = visited->result(preorder_result);
                         prune_flag = true;
+                        if (eagerDiscardClones) delete copy;
                     } else {
                         extra_clone = true;
                         auto status =
@@ -581,27 +816,47 @@ const IR::Node *Transform::apply_visitor(const IR::Node *n, const char *name) {
                         // Sanity check for IR loops
                         if (status == VisitStatus::Busy) BUG("IR loop detected ");
                         local.current.node = copy = preorder_result->clone();
+                        // a preorder handler that visited children explicitly may have
+                        // left a typed-ancestor memo for the node we just replaced
+                        local.current.memoKey = nullptr;
                     }
                 }
                 if (!prune_flag) {
                     copy->visit_children(*this, name);
-                    final_result = copy->apply_visitor_postorder(*this);
+                    final_result = dispatch ? copy->apply_visitor_postorder(*this) : copy;
                 }
                 prune_flag = save_prune_flag;
+                bool children_changed = visited->childChanged();
+                visited->setChildChanged(save_child_changed);
                 if (final_result == copy && final_result != preorder_result &&
-                    *final_result == *preorder_result)
+                    !children_changed && *final_result == *preorder_result) {
                     final_result = preorder_result;
-                if (visited->finish(n, final_result)) {
+                    if (eagerDiscardClones) delete copy;
+                }
+                if (!dispatch && !children_changed && !forceClone && final_result == copy) {
+                    // the visitor never dispatched on this node and no descendant changed,
+                    // so the clone is identical to the original by construction -- keep the
+                    // original without comparing
+                    if (eagerDiscardClones) delete copy;
+                    final_result = n;
+                }
+                if (visited->finish(n, final_result, children_changed && final_result == copy)) {
                     if (final_result) final_result->validate();
                     if (n != final_result && onNodeTransformedHook)
                         onNodeTransformedHook(n, final_result);
                     n = final_result;
+                } else if (eagerDiscardClones && final_result == copy && !extra_clone) {
+                    // the clone compared equal to the original, which stays in the tree;
+                    // reclaim the clone immediately rather than leaving it to the GC
+                    delete copy;
+                    final_result = n;
                 }
                 if (extra_clone) visited->finish(preorder_result, final_result);
                 break;
             }
         }
     }
+    if (n != orig_n) visited->setChildChanged(true);  // tell the parent's frame we changed
     if (ctxt)
         ctxt->child_index++;
     else
@@ -609,8 +864,12 @@ const IR::Node *Transform::apply_visitor(const IR::Node *n, const char *name) {
     return n;
 }
 
-void Inspector::revisit_visited() { visited->revisit_visited(); }
-bool Inspector::visit_in_progress(const IR::Node *n) const { return visited->busy(n); }
+void Inspector::revisit_visited() {
+    if (visited) visited->revisit_visited();
+}
+bool Inspector::visit_in_progress(const IR::Node *n) const {
+    return visited != nullptr && visited->busy(n);
+}
 void Modifier::revisit_visited() { visited->revisit_visited(); }
 bool Modifier::visit_in_progress(const IR::Node *n) const { return visited->busy(n); }
 void Transform::revisit_visited() { visited->revisit_visited(); }
@@ -652,6 +911,9 @@ IRNODE_ALL_SUBCLASSES(DEFINE_VISIT_FUNCTIONS)
 void ControlFlowVisitor::init_join_flows(const IR::Node *root) {
     if (!dynamic_cast<Inspector *>(static_cast<Visitor *>(this)))
         BUG("joinFlows only works for Inspector passes currently, not Modifier or Transform");
+    BUG_CHECK(!dispatchMask,
+              "dispatchOnly cannot be combined with joinFlows, whose "
+              "control-flow merges depend on the full traversal");
     if (flow_join_points)
         flow_join_points->clear();
     else
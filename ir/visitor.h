@@ -53,7 +53,25 @@ struct Visitor_Context {
     const IR::Node *node = nullptr, *original = nullptr;
     mutable const char *child_name = nullptr;
     mutable int child_index = 0;
+    // single-slot memo of the most recent typed-ancestor query answered at this
+    // frame.  Filled lazily by nearest() and inherited by descendant frames, so
+    // per-node findContext calls for the same type cost one load instead of an
+    // upward scan.  Only read below this frame while it is on the stack, where
+    // the ancestor chain (and each frame's node) is stable.
+    mutable const void *memoKey = nullptr;
+    mutable const void *memoAncestor = nullptr;
     int depth = 0;
+    /// nearest enclosing node of type @T, *including* this frame's own node
+    template <class T>
+    const T *nearest() const {
+        const void *key = &typeid(T);
+        if (memoKey == key) return static_cast<const T *>(memoAncestor);
+        const T *rv = node->to<T>();
+        if (!rv && parent) rv = parent->nearest<T>();
+        memoKey = key;
+        memoAncestor = rv;
+        return rv;
+    }
     template <class T>
     inline const T *findContext(const Visitor_Context *&c) const {
         c = this;
@@ -63,8 +81,7 @@ struct Visitor_Context {
     }
     template <class T>
     inline const T *findContext() const {
-        const Visitor_Context *c = this;
-        return findContext<T>(c);
+        return parent ? parent->nearest<T>() : nullptr;
     }
 };
 
@@ -258,8 +275,9 @@ class Visitor {
     }
     template <class T>
     inline const T *findContext() const {
-        const Context *c = ctxt;
-        return findContext<T>(c);
+        // memoized in the context frames; the resumable form above still walks,
+        // since its caller wants the frame in order to continue upward from it
+        return ctxt ? ctxt->findContext<T>() : nullptr;
     }
     template <class T>
     inline const T *findOrigCtxt(const Context *&c) const {
@@ -284,8 +302,7 @@ class Visitor {
     }
     template <class T>
     inline bool isInContext() const {
-        const Context *c = ctxt;
-        return isInContext<T>(c);
+        return findContext<T>() != nullptr;
     }
     inline bool isInContext(const IR::Node *n) const {
         for (auto *c = ctxt; c; c = c->parent) {
@@ -334,6 +351,46 @@ class Visitor {
     // flow_merge the visitor from all the parents before visiting the node and its
     // children.  This only works for Inspector (not Modifier/Transform) currently.
     bool joinFlows = false;
+    // if neverRevisit is set to 'true' (in the derived Inspector class
+    // constructor), the pass keeps no record of visited nodes at all: the
+    // traversal is pure pointer chasing with no per-node bookkeeping, and
+    // revisit/loop_revisit are never called.  Only sound for read-only passes
+    // for which re-inspecting a shared subtree through each of its parents is
+    // harmless, and the IR is known to be loop-free.  This only works for
+    // Inspector, and not together with joinFlows.
+    bool neverRevisit = false;
+
+    // dispatchOnly<T...>() (called from the derived visitor class
+    // constructor) tells apply_visitor that the visitor only overrides
+    // preorder/postorder/revisit handlers for the given IR classes.  Nodes of
+    // any other type are then visited without the virtual handler dispatch
+    // and its walk through the generated per-class default handlers, and
+    // subtrees whose generated reachability mask shows that no node of a
+    // listed type (or subclass) can occur within them are not entered at all.
+    // loop_revisit is still always delivered on the subtrees that are
+    // traversed.  The listed classes must cover every handler override (their
+    // subclasses are covered implicitly), so this is only sound in visitor
+    // classes that cannot gain further overrides -- declare the pass final.
+    // Not usable together with joinFlows, whose control-flow merges depend on
+    // the full traversal.  A visitor that never calls dispatchOnly dispatches
+    // every node, as before.
+    template <class... T>
+    void dispatchOnly() {
+        static_assert((std::is_base_of_v<IR::Node, T> && ...),
+                      "dispatchOnly arguments must be IR::Node classes");
+        (addDispatchInterest(RTTI::TypeInfo<T>::id()), ...);
+    }
+    /// @return true if the visitor may override a handler for @n's type, so
+    /// the preorder/postorder/revisit calls for @n cannot be skipped.
+    bool wantDispatch(const IR::Node *n) const {
+        return dispatchMask == nullptr || wantDispatchSlow(n);
+    }
+    /// @return true if a node the visitor overrides a handler for may occur
+    /// in the subtree rooted at @n (including @n itself), so the subtree
+    /// cannot be skipped entirely.
+    bool wantVisit(const IR::Node *n) const {
+        return dispatchMask == nullptr || wantVisitSlow(n);
+    }
 
     virtual void init_join_flows(const IR::Node *) {
         BUG("joinFlows only supported in ControlFlowVisitor currently");
@@ -374,6 +431,11 @@ class Visitor {
     virtual void visitAgain() const { BUG("do not know how to handle request"); }
 
  private:
+    struct DispatchMask;
+    const DispatchMask *dispatchMask = nullptr;
+    void addDispatchInterest(RTTI::TypeId);
+    bool wantDispatchSlow(const IR::Node *) const;
+    bool wantVisitSlow(const IR::Node *) const;
     virtual void visitor_const_error();
     const Context *ctxt = nullptr;  // should be readonly to subclasses
     friend class Inspector;
@@ -478,6 +540,14 @@ class Transform : public virtual Visitor {
         return rv;
     }
     bool forceClone = false;  // force clone whole tree even if unchanged
+    /// When set, clones that apply_visitor proves dead (the result compared equal to
+    /// the original, so the original was kept) are returned to the allocator
+    /// immediately instead of being left for the garbage collector.  This acts as a
+    /// per-visit region for the transient clones made on every visited node, which
+    /// dominate allocation in rewrite-light passes.  Only passes that do not retain
+    /// pointers to the in-flight clones (e.g. in maps keyed by node pointer) may
+    /// enable this.
+    bool eagerDiscardClones = false;
 };
 
 // turn this on for extra info tracking control joinFlows for debugging
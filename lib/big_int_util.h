@@ -99,8 +99,24 @@ static inline int floor_log2(big_int v) {
 
 static inline int ceil_log2(big_int v) { return v ? floor_log2(v - 1) + 1 : -1; }
 
+/// big_int keys are overwhelmingly single-limb values (bit widths, constant
+/// operands), so hash those with one mixing round of the limb and the sign
+/// instead of boost's generic per-limb combine.  Wider values hash their limb
+/// array in a single pass; cpp_int stores values canonically (no leading zero
+/// limbs), so equal values always produce equal hashes.
 template <>
-struct Util::Hasher<big_int> : Detail::StdHasher {};
+struct Util::Hasher<big_int> {
+    size_t operator()(const big_int &val) const {
+        const auto &backend = val.backend();
+        if (backend.size() == 1)
+            return static_cast<size_t>(Util::hash_combine(
+                static_cast<uint64_t>(backend.limbs()[0]), static_cast<uint64_t>(backend.sign())));
+        uint64_t limbsHash =
+            Util::hash(backend.limbs(), backend.size() * sizeof(backend.limbs()[0]));
+        return static_cast<size_t>(
+            Util::hash_combine(limbsHash, static_cast<uint64_t>(backend.sign())));
+    }
+};
 
 }  // namespace P4
 
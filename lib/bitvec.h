@@ -124,6 +124,10 @@ class bitvec {
         uintptr_t *ptr;
     };
     uintptr_t word(size_t i) const { return i < size ? size > 1 ? ptr[i] : data : 0; }
+    /// The backing words as a contiguous array of length `size`.  Hot loops index this
+    /// directly instead of calling word(i), avoiding two branches per word and letting
+    /// the compiler unroll/vectorize the word-at-a-time operations.
+    const uintptr_t *words() const { return size > 1 ? ptr : &data; }
 
  public:
     static constexpr size_t bits_per_unit = CHAR_BIT * sizeof(uintptr_t);
@@ -421,8 +425,9 @@ class bitvec {
     nonconst_bitref begin() & { return min(); }
     nonconst_bitref end() & { return nonconst_bitref(*this, -1); }
     bool empty() const {
+        const uintptr_t *w = words();
         for (size_t i = 0; i < size; i++)
-            if (word(i) != 0) return false;
+            if (w[i] != 0) return false;
         return true;
     }
     explicit operator bool() const { return !empty(); }
@@ -561,8 +566,14 @@ class bitvec {
         return rv;
     }
     bool operator==(const bitvec &a) const {
-        for (size_t i = 0; i < size || i < a.size; i++)
-            if (word(i) != a.word(i)) return false;
+        const uintptr_t *w = words(), *aw = a.words();
+        size_t common = std::min(size, a.size);
+        for (size_t i = 0; i < common; i++)
+            if (w[i] != aw[i]) return false;
+        for (size_t i = common; i < size; i++)
+            if (w[i]) return false;
+        for (size_t i = common; i < a.size; i++)
+            if (aw[i]) return false;
         return true;
     }
     bool operator!=(const bitvec &a) const { return !(*this == a); }
@@ -578,15 +589,19 @@ class bitvec {
     bool operator>=(const bitvec &a) const { return !(*this < a); }
     bool operator<=(const bitvec &a) const { return !(a < *this); }
     bool intersects(const bitvec &a) const {
-        for (size_t i = 0; i < size && i < a.size; i++)
-            if (word(i) & a.word(i)) return true;
+        const uintptr_t *w = words(), *aw = a.words();
+        size_t common = std::min(size, a.size);
+        for (size_t i = 0; i < common; i++)
+            if (w[i] & aw[i]) return true;
         return false;
     }
     bool contains(const bitvec &a) const {  // is 'a' a subset or equal to 'this'?
-        for (size_t i = 0; i < size && i < a.size; i++)
-            if ((word(i) & a.word(i)) != a.word(i)) return false;
-        for (size_t i = size; i < a.size; i++)
-            if (a.word(i)) return false;
+        const uintptr_t *w = words(), *aw = a.words();
+        size_t common = std::min(size, a.size);
+        for (size_t i = 0; i < common; i++)
+            if ((w[i] & aw[i]) != aw[i]) return false;
+        for (size_t i = common; i < a.size; i++)
+            if (aw[i]) return false;
         return true;
     }
     bitvec &operator>>=(size_t count);
@@ -605,7 +620,8 @@ class bitvec {
     bitvec rotate_right_copy(size_t start_bit, size_t rotation_idx, size_t end_bit) const;
     int popcount() const {
         int rv = 0;
-        for (size_t i = 0; i < size; i++) rv += bv::popcount(word(i));
+        const uintptr_t *w = words();
+        for (size_t i = 0; i < size; i++) rv += bv::popcount(w[i]);
         return rv;
     }
     bool is_contiguous() const;
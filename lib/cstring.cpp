@@ -34,6 +34,7 @@ limitations under the License.
 #include <functional>
 #include <iomanip>
 #include <ios>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -169,31 +170,73 @@ struct TableEntryHash {
     }
 };
 
-auto &cache() {
-    // We need node_hash_set due to SSO: we return address of embedded string
-    // that should be stable
-    static absl::node_hash_set<table_entry, TableEntryHash, std::equal_to<>> g_cache;
+// The intern table is sharded by string hash so that threads interning different
+// strings (e.g. name-mangling passes running under ParallelInspect) rarely contend:
+// each shard has its own lock and its own node_hash_set.  We need node_hash_set due
+// to SSO: we return the address of the embedded string, which must be stable.
+constexpr std::size_t cache_shard_count = 32;  // must be a power of two
 
+struct cache_shard_t {
+    std::mutex lock;
+    absl::node_hash_set<table_entry, TableEntryHash, std::equal_to<>> table;
+};
+
+cache_shard_t *cache_shards() {
+    static cache_shard_t g_cache[cache_shard_count];
     return g_cache;
 }
 
+// Small per-thread cache of recently interned strings, checked before taking any
+// shard lock.  It only ever stores pointers that are already in the global table,
+// so a hit returns the same canonical pointer that interning would.
+struct local_cache_entry_t {
+    std::size_t hash = 0;
+    std::size_t length = 0;
+    const char *string = nullptr;
+};
+constexpr std::size_t local_cache_size = 256;  // must be a power of two
+
 const char *save_to_cache(const char *string, std::size_t length, table_entry_flags flags) {
-    // Checks if string is already cached and if not, calls ctor to construct in
-    // place.  As a result, only a single lookup is performed regardless whether
-    // entry is in cache or not.
-    return cache()
-        .lazy_emplace(table_entry(string, length, table_entry_flags::no_need_copy),
-                      [string, length, flags](const auto &ctor) { ctor(string, length, flags); })
-        ->string();
+    std::size_t hash = Util::hash(string, length);
+
+    static thread_local local_cache_entry_t local_cache[local_cache_size];
+    auto &local = local_cache[hash & (local_cache_size - 1)];
+    if (local.hash == hash && local.length == length &&
+        std::memcmp(local.string, string, length) == 0)
+        return local.string;
+
+    auto &shard = cache_shards()[hash & (cache_shard_count - 1)];
+    const char *rv;
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        // Checks if string is already cached and if not, calls ctor to construct in
+        // place.  As a result, only a single lookup is performed regardless whether
+        // entry is in cache or not.
+        rv = shard.table
+                 .lazy_emplace(
+                     table_entry(string, length, table_entry_flags::no_need_copy),
+                     [string, length, flags](const auto &ctor) { ctor(string, length, flags); })
+                 ->string();
+    }
+    local = {hash, length, rv};
+    return rv;
 }
 
 }  // namespace
 
-bool cstring::is_cached(std::string_view s) { return cache().contains(s); }
+bool cstring::is_cached(std::string_view s) {
+    std::size_t hash = Util::hash(s.data(), s.length());
+    auto &shard = cache_shards()[hash & (cache_shard_count - 1)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.contains(s);
+}
 
 cstring cstring::get_cached(std::string_view s) {
-    auto entry = cache().find(s);
-    if (entry == cache().end()) return nullptr;
+    std::size_t hash = Util::hash(s.data(), s.length());
+    auto &shard = cache_shards()[hash & (cache_shard_count - 1)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto entry = shard.table.find(s);
+    if (entry == shard.table.end()) return nullptr;
 
     cstring res;
     res.str = entry->string();
@@ -216,8 +259,13 @@ void cstring::construct_from_literal(const char *string, std::size_t length) {
 
 size_t cstring::cache_size(size_t &count) {
     size_t rv = 0;
-    count = cache().size();
-    for (auto &s : cache()) rv += sizeof(s) + s.length();
+    count = 0;
+    for (std::size_t i = 0; i < cache_shard_count; ++i) {
+        auto &shard = cache_shards()[i];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        count += shard.table.size();
+        for (auto &s : shard.table) rv += sizeof(s) + s.length();
+    }
     return rv;
 }
 
@@ -435,7 +435,15 @@ struct hash<P4::cstring> {
 namespace P4::Util {
 template <>
 struct Hasher<cstring> {
+    using is_transparent = void;
     size_t operator()(const cstring &c) const { return Util::Hash{}(c.c_str()); }
+    /// Heterogeneous probe: hash the interned copy of @s, if any, so callers
+    /// can look up string data without constructing (and caching) a cstring.
+    /// Strings that were never interned hash like a null cstring and cannot
+    /// compare equal to any key, so such lookups correctly miss.
+    size_t operator()(std::string_view s) const {
+        return Util::Hash{}(cstring::get_cached(s).c_str());
+    }
 };
 
 }  // namespace P4::Util
@@ -678,6 +678,318 @@ auto concat(Args &&...inputs) {
     return concat(init);
 }
 
+////////////////// value-semantics enumerators //////////////
+
+/* The Enumerator combinators above heap-allocate one object per pipeline stage and
+ * dispatch every element virtually, which shows up on hot paths that build a short
+ * pipeline per query (getDeclarations().where(...) and the like).  The Value*
+ * enumerators below implement the same moveNext/getCurrent protocol, but each
+ * combinator holds its input by value, so a whole pipeline is one stack object,
+ * composition is resolved at compile time, and per-element calls can inline.
+ * Pipelines are built with valueEnumerate() and the same where/map/as/concat
+ * vocabulary; apply combinators before starting the iteration, as combinators copy
+ * their input including its position.  heapEnumerator() bridges a finished pipeline
+ * to code expecting the type-erased interface with a single allocation, and
+ * valueEnumerate(Enumerator<T> *) composes on top of a type-erased source.
+ */
+
+template <typename Input, typename Filter>
+class ValueFilterEnumerator;
+template <typename Input, typename S, typename Mapper>
+class ValueMapEnumerator;
+template <typename Input, typename S>
+class ValueAsEnumerator;
+template <typename Input1, typename Input2>
+class ValueConcatEnumerator;
+template <typename Input>
+class ValueEnumeratorAdapter;
+
+/// Past-the-end marker for value-semantics enumerators.
+struct ValueEnumeratorSentinel {};
+
+/// Input iterator over a value-semantics enumerator, for C++ range for loops.
+template <typename Input>
+class ValueEnumeratorIterator {
+    Input *input;
+    bool valid;
+
+ public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename Input::value_type;
+    using reference = value_type;
+    using pointer = void;
+
+    explicit ValueEnumeratorIterator(Input *input) : input(input), valid(input->moveNext()) {}
+    reference operator*() const { return input->getCurrent(); }
+    ValueEnumeratorIterator &operator++() {
+        valid = input->moveNext();
+        return *this;
+    }
+    bool operator==(ValueEnumeratorSentinel) const { return !valid; }
+    bool operator!=(ValueEnumeratorSentinel) const { return valid; }
+};
+
+/// CRTP base providing the shared Enumerator<T> vocabulary for the value-semantics
+/// enumerators.  Derived must implement moveNext(), getCurrent() and reset().
+template <typename Derived, typename T>
+class ValueEnumerator {
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+    Derived &self() { return static_cast<Derived &>(*this); }
+
+ public:
+    using value_type = T;
+
+    /// Return an enumerator returning all elements that pass the filter
+    template <typename Filter>
+    auto where(Filter filter) const {
+        return ValueFilterEnumerator<Derived, Filter>(self(), std::move(filter));
+    }
+    /// Apply specified function to all elements of this enumerator
+    template <typename Mapper>
+    auto map(Mapper map) const {
+        return ValueMapEnumerator<Derived, std::invoke_result_t<Mapper, T>, Mapper>(
+            self(), std::move(map));
+    }
+    /// Cast to an enumerator of S objects
+    template <typename S>
+    auto as() const {
+        return ValueAsEnumerator<Derived, S>(self());
+    }
+    /// Append all elements of other after all elements of this
+    template <typename Other>
+    auto concat(Other other) const {
+        return ValueConcatEnumerator<Derived, Other>(self(), std::move(other));
+    }
+    /// Adapt to the type-erased Enumerator<T> interface; the only allocation of
+    /// the whole pipeline
+    Enumerator<T> *heapEnumerator() const { return new ValueEnumeratorAdapter<Derived>(self()); }
+
+    ValueEnumeratorIterator<Derived> begin() { return ValueEnumeratorIterator<Derived>(&self()); }
+    ValueEnumeratorSentinel end() const { return {}; }
+
+    std::vector<T> toVector() {
+        std::vector<T> result;
+        while (self().moveNext()) result.push_back(self().getCurrent());
+        return result;
+    }
+
+    /// Enumerate all elements and return the count
+    uint64_t count() {
+        uint64_t found = 0;
+        while (self().moveNext()) found++;
+        return found;
+    }
+
+    /// True if the enumerator has at least one element
+    bool any() { return self().moveNext(); }
+
+    /// Next element, or the default value if none exists
+    T nextOrDefault() {
+        if (!self().moveNext()) return T{};
+        return self().getCurrent();
+    }
+
+    /// Next element; throws if there are no elements
+    T next() {
+        if (!self().moveNext()) throw std::logic_error("There is no element for `next()'");
+        return self().getCurrent();
+    }
+};
+
+/// A generic iterator returning elements of type T; the value-semantics
+/// counterpart of IteratorEnumerator.
+template <typename Iter>
+class ValueIteratorEnumerator
+    : public ValueEnumerator<ValueIteratorEnumerator<Iter>,
+                             typename std::iterator_traits<Iter>::value_type> {
+    Iter beginIt;
+    Iter endIt;
+    Iter current;
+    bool started = false;
+
+ public:
+    ValueIteratorEnumerator(Iter begin, Iter end)
+        : beginIt(begin), endIt(end), current(begin) {}
+
+    bool moveNext() {
+        if (!started) {
+            started = true;
+            current = beginIt;
+        } else if (current != endIt) {
+            ++current;
+        }
+        return current != endIt;
+    }
+    typename std::iterator_traits<Iter>::value_type getCurrent() const { return *current; }
+    void reset() { started = false; }
+};
+
+/// Composes on top of a type-erased enumerator, so a value-semantics pipeline
+/// can extend an Enumerator<T> * received from an existing interface without
+/// allocating per combinator.  Does not take ownership.
+template <typename T>
+class ValueSourceEnumerator : public ValueEnumerator<ValueSourceEnumerator<T>, T> {
+    Enumerator<T> *input;
+
+ public:
+    explicit ValueSourceEnumerator(Enumerator<T> *input) : input(input) {}
+    bool moveNext() { return input->moveNext(); }
+    T getCurrent() const { return input->getCurrent(); }
+    void reset() { input->reset(); }
+};
+
+/// The value-semantics counterpart of FilterEnumerator.
+template <typename Input, typename Filter>
+class ValueFilterEnumerator
+    : public ValueEnumerator<ValueFilterEnumerator<Input, Filter>, typename Input::value_type> {
+    Input input;
+    Filter filter;
+    typename Input::value_type current{};  // must prevent repeated evaluation
+
+ public:
+    ValueFilterEnumerator(Input input, Filter filter)
+        : input(std::move(input)), filter(std::move(filter)) {}
+
+    bool moveNext() {
+        while (input.moveNext()) {
+            current = input.getCurrent();
+            if (filter(current)) return true;
+        }
+        return false;
+    }
+    typename Input::value_type getCurrent() const { return current; }
+    void reset() { input.reset(); }
+};
+
+/// The value-semantics counterpart of MapEnumerator.
+template <typename Input, typename S, typename Mapper>
+class ValueMapEnumerator : public ValueEnumerator<ValueMapEnumerator<Input, S, Mapper>, S> {
+    Input input;
+    Mapper map;
+    S current{};
+
+ public:
+    ValueMapEnumerator(Input input, Mapper map) : input(std::move(input)), map(std::move(map)) {}
+
+    bool moveNext() {
+        if (!input.moveNext()) return false;
+        current = map(input.getCurrent());
+        return true;
+    }
+    S getCurrent() const { return current; }
+    void reset() { input.reset(); }
+};
+
+/// The value-semantics counterpart of AsEnumerator.
+template <typename Input, typename S>
+class ValueAsEnumerator : public ValueEnumerator<ValueAsEnumerator<Input, S>, S> {
+    Input input;
+
+    template <typename U = S>
+    std::enable_if_t<!Detail::can_be_casted<typename Input::value_type, S>, U> getCurrentImpl()
+        const {
+        return dynamic_cast<S>(input.getCurrent());
+    }
+    template <typename U = S>
+    std::enable_if_t<Detail::can_be_casted<typename Input::value_type, S>, U> getCurrentImpl()
+        const {
+        return input.getCurrent()->template to<std::remove_pointer_t<S>>();
+    }
+
+ public:
+    explicit ValueAsEnumerator(Input input) : input(std::move(input)) {}
+
+    bool moveNext() { return input.moveNext(); }
+    S getCurrent() const { return getCurrentImpl(); }
+    void reset() { input.reset(); }
+};
+
+/// The value-semantics counterpart of ConcatEnumerator; chains of concat()
+/// calls nest instead of collecting into a vector.
+template <typename Input1, typename Input2>
+class ValueConcatEnumerator
+    : public ValueEnumerator<ValueConcatEnumerator<Input1, Input2>, typename Input1::value_type> {
+    static_assert(std::is_same_v<typename Input1::value_type, typename Input2::value_type>,
+                  "Cannot concatenate enumerators of different element types");
+    Input1 first;
+    Input2 second;
+    bool inSecond = false;
+
+ public:
+    ValueConcatEnumerator(Input1 first, Input2 second)
+        : first(std::move(first)), second(std::move(second)) {}
+
+    bool moveNext() {
+        if (!inSecond) {
+            if (first.moveNext()) return true;
+            inSecond = true;
+        }
+        return second.moveNext();
+    }
+    typename Input1::value_type getCurrent() const {
+        return inSecond ? second.getCurrent() : first.getCurrent();
+    }
+    void reset() {
+        first.reset();
+        second.reset();
+        inSecond = false;
+    }
+};
+
+/// Adapts a value-semantics pipeline to the type-erased Enumerator<T>
+/// interface: one allocation for the whole pipeline instead of one per stage.
+template <typename Input>
+class ValueEnumeratorAdapter final : public Enumerator<typename Input::value_type> {
+    Input input;
+
+ public:
+    explicit ValueEnumeratorAdapter(Input input) : input(std::move(input)) {}
+
+    bool moveNext() override {
+        bool result = input.moveNext();
+        this->state = result ? EnumeratorState::Valid : EnumeratorState::PastEnd;
+        return result;
+    }
+    typename Input::value_type getCurrent() const override {
+        switch (this->state) {
+            case EnumeratorState::NotStarted:
+                throw std::logic_error("You cannot call 'getCurrent' before 'moveNext'");
+            case EnumeratorState::PastEnd:
+                throw std::logic_error("You cannot call 'getCurrent' past the collection end");
+            case EnumeratorState::Valid:
+                return input.getCurrent();
+        }
+        throw std::logic_error("Unexpected state " + std::to_string(static_cast<int>(this->state)));
+    }
+    void reset() override {
+        input.reset();
+        Enumerator<typename Input::value_type>::reset();
+    }
+};
+
+template <typename Iter>
+auto valueEnumerate(Iter begin, Iter end) {
+    return ValueIteratorEnumerator<Iter>(begin, end);
+}
+
+template <typename Iter>
+auto valueEnumerate(iterator_range<Iter> range) {
+    return ValueIteratorEnumerator<Iter>(range.begin(), range.end());
+}
+
+template <typename Container>
+auto valueEnumerate(const Container &data) {
+    using std::begin;
+    using std::end;
+    return ValueIteratorEnumerator<decltype(begin(data))>(begin(data), end(data));
+}
+
+template <typename T>
+auto valueEnumerate(Enumerator<T> *input) {
+    return ValueSourceEnumerator<T>(input);
+}
+
 }  // namespace P4::Util
 
 #endif /* LIB_ENUMERATOR_H_ */
@@ -16,10 +16,13 @@ limitations under the License.
 #ifndef LIB_ERROR_HELPER_H_
 #define LIB_ERROR_HELPER_H_
 
+#include <mutex>
 #include <type_traits>
 
 #include <boost/format.hpp>
 
+#include "absl/container/flat_hash_map.h"
+#include "lib/cstring.h"
 #include "lib/error_message.h"
 #include "lib/source_file.h"
 #include "lib/stringify.h"
@@ -27,6 +30,18 @@ limitations under the License.
 namespace P4 {
 namespace priv {
 
+/// Return a precompiled boost::format for @format.  Parsing a format pattern is
+/// the dominant cost of emitting a diagnostic, and the patterns come from a small
+/// fixed set of literals, so each distinct pattern is parsed once and copies of
+/// the compiled object are handed out afterwards: copying duplicates the parsed
+/// directive slots without re-parsing the pattern text.
+inline boost::format cachedFormat(const char *format) {
+    static std::mutex lock;
+    static absl::flat_hash_map<cstring, boost::format> cache;
+    std::lock_guard<std::mutex> guard(lock);
+    return cache.try_emplace(cstring(format), format).first->second;
+}
+
 // All these methods return std::string because this is the native format of boost::format
 // Position is printed at the beginning.
 static inline ErrorMessage error_helper(boost::format &f, ErrorMessage out) {
@@ -17,11 +17,14 @@ limitations under the License.
 #ifndef LIB_ERROR_REPORTER_H_
 #define LIB_ERROR_REPORTER_H_
 
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <ostream>
-#include <set>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -30,6 +33,8 @@ limitations under the License.
 #include "error_catalog.h"
 #include "error_helper.h"
 #include "exceptions.h"
+#include "hash.h"
+#include "telemetry.h"
 
 namespace P4 {
 
@@ -55,13 +60,66 @@ class ErrorReporter {
 
     std::ostream *outputstream;
 
+    /// Deduplicates diagnostics by a 64-bit fingerprint of the error code and source
+    /// position instead of storing every (code, SourceInfo) pair: lookup and insert are
+    /// a single probe sequence in a fixed-size table, so suppression stays O(1) no
+    /// matter how many messages a pathological program produces.  The table is
+    /// partitioned by severity so a flood of duplicate warnings cannot crowd out error
+    /// deduplication, and it is bounded: once a partition fills up, new fingerprints
+    /// are reported rather than suppressed (duplicates may then print again, but no
+    /// message is ever lost).
+    class DedupIndex {
+        static constexpr size_t slotCount = 1 << 14;       // per partition; power of two
+        static constexpr size_t maxFill = slotCount - slotCount / 8;  // keep probes short
+        struct Partition {
+            std::vector<uint64_t> slots;  // open-addressed; 0 marks an empty slot
+            size_t used = 0;
+        };
+        std::array<Partition, 3> partitions;  // Info / Warn / Error
+
+        static size_t partitionFor(DiagnosticAction action) {
+            return action == DiagnosticAction::Error ? 2
+                   : action == DiagnosticAction::Warn ? 1
+                                                      : 0;
+        }
+
+     public:
+        /// @return true if @fingerprint was already recorded for this severity;
+        /// record it otherwise.
+        bool seen(DiagnosticAction action, uint64_t fingerprint) {
+            auto &part = partitions[partitionFor(action)];
+            if (part.slots.empty()) part.slots.resize(slotCount, 0);
+            if (fingerprint == 0) fingerprint = 1;
+            size_t i = fingerprint & (slotCount - 1);
+            while (part.slots[i] != 0) {
+                if (part.slots[i] == fingerprint) return true;
+                i = (i + 1) & (slotCount - 1);
+            }
+            if (part.used >= maxFill) return false;  // overflow: emit rather than suppress
+            part.slots[i] = fingerprint;
+            ++part.used;
+            return false;
+        }
+    };
+
     /// Track errors or warnings that have already been issued for a particular source location
-    std::set<std::pair<int, const Util::SourceInfo>> errorTracker;
+    DedupIndex errorTracker;
+
+    /// Serializes counting and emission of diagnostics, so that passes running
+    /// concurrently (e.g. under ParallelInspect) may report messages safely.
+    std::mutex reportMutex;
+
+    /// Per-kind cap on printed info/warning messages; 0 means unlimited.
+    unsigned maxMessagesPerKind = 0;
+    /// How many messages of each kind have been seen (only tracked when capped).
+    std::unordered_map<cstring, unsigned> messageCounts;
 
-    /// Output the message and flush the stream
+    /// Output the message; errors force a flush so that they are not lost if
+    /// compilation aborts, while info/warning output is left batched in the
+    /// stream buffer.
     virtual void emit_message(const ErrorMessage &msg) {
         *outputstream << msg.toString();
-        outputstream->flush();
+        if (msg.type == ErrorMessage::MessageType::Error) outputstream->flush();
     }
 
     virtual void emit_message(const ParserErrorMessage &msg) {
@@ -73,10 +131,14 @@ class ErrorReporter {
     /// and source info.
     /// If the error has been reported, return true. Otherwise, insert add the error to the
     /// list of seen errors, and return false.
-    bool error_reported(int err, const Util::SourceInfo source) {
+    bool error_reported(int err, const Util::SourceInfo source, DiagnosticAction action) {
         if (!source.isValid()) return false;
-        auto p = errorTracker.emplace(err, source);
-        return !p.second;  // if insertion took place, then we have not seen the error.
+        // fingerprint on the start position only, matching how SourceInfos were
+        // previously ordered in the tracking set
+        uint64_t fingerprint = Util::Hash{}(err, source.getStart().getLineNumber(),
+                                            source.getStart().getColumnNumber());
+        std::lock_guard<std::mutex> lock(reportMutex);
+        return errorTracker.seen(action, fingerprint);
     }
 
     /// retrieve the format from the error catalog
@@ -98,7 +160,7 @@ class ErrorReporter {
     // error message for a bug
     template <typename... Args>
     std::string bug_message(const char *format, Args &&...args) {
-        boost::format fmt(format);
+        boost::format fmt(priv::cachedFormat(format));
         // FIXME: This will implicitly take location of the first argument having
         // SourceInfo. Not sure if this always desireable or not.
         return ::P4::bug_helper(fmt, "", "", std::forward<Args>(args)...);
@@ -106,14 +168,14 @@ class ErrorReporter {
 
     template <typename... Args>
     std::string format_message(const char *format, Args &&...args) {
-        boost::format fmt(format);
+        boost::format fmt(priv::cachedFormat(format));
         return ::P4::error_helper(fmt, std::forward<Args>(args)...).toString();
     }
 
     template <class T, typename = decltype(std::declval<T>()->getSourceInfo()), typename... Args>
     void diagnose(DiagnosticAction action, const int errorCode, const char *format,
                   const char *suffix, T node, Args &&...args) {
-        if (!node || error_reported(errorCode, node->getSourceInfo())) return;
+        if (!node || error_reported(errorCode, node->getSourceInfo(), action)) return;
 
         if (cstring name = get_error_name(errorCode))
             diagnose(getDiagnosticAction(errorCode, name, action), name.c_str(), format, suffix,
@@ -139,6 +201,7 @@ class ErrorReporter {
                   const char *suffix, Args &&...args) {
         if (action == DiagnosticAction::Ignore) return;
 
+        std::lock_guard<std::mutex> lock(reportMutex);
         ErrorMessage::MessageType msgType = ErrorMessage::MessageType::None;
         if (action == DiagnosticAction::Info) {
             // Avoid burying errors in a pile of info messages:
@@ -154,15 +217,31 @@ class ErrorReporter {
 
             warningCount++;
             msgType = ErrorMessage::MessageType::Warning;
+            if (Util::Telemetry::enabled()) Util::Telemetry::count("warnings");
         } else if (action == DiagnosticAction::Error) {
             errorCount++;
             msgType = ErrorMessage::MessageType::Error;
+            if (Util::Telemetry::enabled()) Util::Telemetry::count("errors");
+        }
+
+        // Bound the formatting cost of warning-heavy compiles: once a kind of
+        // info/warning has been printed maxMessagesPerKind times, further
+        // occurrences are still counted but neither formatted nor printed.
+        bool lastBeforeSuppression = false;
+        if (maxMessagesPerKind != 0 && msgType != ErrorMessage::MessageType::Error) {
+            cstring kind = diagnosticName ? cstring(diagnosticName) : cstring(format);
+            unsigned &seen = messageCounts[kind];
+            if (++seen > maxMessagesPerKind) return;
+            lastBeforeSuppression = seen == maxMessagesPerKind;
         }
 
-        boost::format fmt(format);
+        boost::format fmt(priv::cachedFormat(format));
         ErrorMessage msg(msgType, diagnosticName ? diagnosticName : "", suffix);
         msg = ::P4::error_helper(fmt, msg, std::forward<Args>(args)...);
         emit_message(msg);
+        if (lastBeforeSuppression)
+            *outputstream << "[--Wlimit] further messages of this kind will not be printed"
+                          << std::endl;
 
         if (errorCount > maxErrorCount)
             FATAL_ERROR("Number of errors exceeded set maximum of %1%", maxErrorCount);
@@ -178,6 +257,16 @@ class ErrorReporter {
         return r;
     }
 
+    unsigned getMaxMessagesPerKind() const { return maxMessagesPerKind; }
+    /// Limit how many info/warning messages are printed per diagnostic kind
+    /// (0 = unlimited) and return the previous limit.  Suppressed messages are
+    /// still reflected in the diagnostic counts.
+    unsigned setMaxMessagesPerKind(unsigned newMax) {
+        auto r = maxMessagesPerKind;
+        maxMessagesPerKind = newMax;
+        return r;
+    }
+
     unsigned getWarningCount() const { return warningCount; }
 
     unsigned getInfoCount() const { return infoCount; }
@@ -194,7 +283,9 @@ class ErrorReporter {
     /// position information provided by Bison.
     template <typename T>
     void parser_error(const Util::SourceInfo &location, const T &message) {
+        std::lock_guard<std::mutex> lock(reportMutex);
         errorCount++;
+        if (Util::Telemetry::enabled()) Util::Telemetry::count("errors");
         std::stringstream ss;
         ss << message;
 
@@ -209,7 +300,9 @@ class ErrorReporter {
      */
     template <typename... Args>
     void parser_error(const Util::InputSources *sources, const char *fmt, Args &&...args) {
+        std::lock_guard<std::mutex> lock(reportMutex);
         errorCount++;
+        if (Util::Telemetry::enabled()) Util::Telemetry::count("errors");
 
         Util::SourcePosition position = sources->getCurrentPosition();
         position--;
@@ -76,11 +76,25 @@ static void maybe_initialize_gc() {
     }
 }
 
+// Blocks at least this large -- in practice the backing stores of big IR vectors, hash
+// tables and strings -- go through GC_malloc_ignore_off_page, which places them in the
+// collector's large-object space and retains them only while a pointer near the start of
+// the block survives.  libgc already size-classes small objects; without this, a single
+// stale interior pointer anywhere into a multi-megabyte block keeps the whole block
+// alive.  Containers keep their base pointer, so the "pointer near the start" promise
+// holds for the allocations that reach this size.
+constexpr std::size_t large_object_threshold = 1 << 16;
+
+static void *gc_alloc(std::size_t size) {
+    if (size >= large_object_threshold) return GC_malloc_ignore_off_page(size);
+    return ::operator new(size, UseGC, 0, 0);
+}
+
 void *operator new(std::size_t size) {
     TRACE_ALLOC(size)
 
     maybe_initialize_gc();
-    auto *rv = ::operator new(size, UseGC, 0, 0);
+    auto *rv = gc_alloc(size);
     if (!rv && emergency_ptr && emergency_ptr + size < emergency_pool + sizeof(emergency_pool)) {
         rv = emergency_ptr;
         size = (size + 15) / 16 * 16;  // align to 16 bytes
@@ -99,7 +113,7 @@ void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
     maybe_initialize_gc();
     // FIXME: Call nothrow operator new from libgc with suitable new libgc
     // versions
-    auto *rv = ::operator new(size, UseGC, 0, 0);
+    auto *rv = gc_alloc(size);
     if (!rv && emergency_ptr && emergency_ptr + size < emergency_pool + sizeof(emergency_pool)) {
         rv = emergency_ptr;
         size = (size + 15) / 16 * 16;  // align to 16 bytes
@@ -258,6 +272,7 @@ void *malloc(size_t size) {
     if (!done_init) return realloc(nullptr, size);
 
     TRACE_ALLOC(size)
+    if (size >= large_object_threshold) return GC_malloc_ignore_off_page(size);
     return GC_malloc(size);
 }
 void free(void *ptr) {
@@ -321,6 +336,27 @@ void setup_gc_logging() {
 #endif /* HAVE_LIBGC */
 }
 
+void gc_allow_threads() {
+#if HAVE_LIBGC
+    maybe_initialize_gc();
+    GC_allow_register_threads();
+#endif /* HAVE_LIBGC */
+}
+
+gc_thread_scope::gc_thread_scope() {
+#if HAVE_LIBGC
+    struct GC_stack_base sb;
+    GC_get_stack_base(&sb);
+    GC_register_my_thread(&sb);
+#endif /* HAVE_LIBGC */
+}
+
+gc_thread_scope::~gc_thread_scope() {
+#if HAVE_LIBGC
+    GC_unregister_my_thread();
+#endif /* HAVE_LIBGC */
+}
+
 size_t gc_mem_inuse(size_t *max) {
 #if HAVE_LIBGC
     GC_word heapsize, heapfree;
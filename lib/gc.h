@@ -31,4 +31,19 @@ struct alloc_trace_cb_t {
 alloc_trace_cb_t set_alloc_trace(alloc_trace_cb_t cb);
 alloc_trace_cb_t set_alloc_trace(void (*fn)(void *arg, void **pc, size_t sz), void *arg);
 
+/// Must be called (once, from the main thread) before any thread other than the main
+/// thread may allocate garbage-collected memory.  Safe to call when the GC is disabled.
+void gc_allow_threads();
+
+/// RAII helper registering the calling thread with the garbage collector for the
+/// lifetime of the object.  Any thread created by the compiler itself (rather than by
+/// the GC) must hold one of these while it allocates; otherwise the collector will not
+/// scan its stack and may reclaim live objects.  A no-op when the GC is disabled.
+struct gc_thread_scope {
+    gc_thread_scope();
+    ~gc_thread_scope();
+    gc_thread_scope(const gc_thread_scope &) = delete;
+    gc_thread_scope &operator=(const gc_thread_scope &) = delete;
+};
+
 #endif /* LIB_GC_H_ */
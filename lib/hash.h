@@ -196,8 +196,24 @@ struct Hasher<std::string_view> {
     }
 };
 
+/// Pairs of small integers (node ids, bit positions, coordinates, ...) are the
+/// dominant composite keys; pack them into a single 64-bit word and take one
+/// avalanche round instead of hashing each half and combining.
 template <typename T1, typename T2>
-struct Hasher<std::pair<T1, T2>> {
+struct Hasher<std::pair<T1, T2>,
+              std::enable_if_t<std::is_integral_v<T1> && std::is_integral_v<T2> &&
+                               sizeof(T1) <= 4 && sizeof(T2) <= 4>> {
+    constexpr size_t operator()(const std::pair<T1, T2> &val) const noexcept {
+        uint64_t word = (static_cast<uint64_t>(static_cast<uint32_t>(val.first)) << 32) |
+                        static_cast<uint32_t>(val.second);
+        return static_cast<size_t>(Detail::XXH64_avalanche(word));
+    }
+};
+
+template <typename T1, typename T2>
+struct Hasher<std::pair<T1, T2>,
+              std::enable_if_t<!(std::is_integral_v<T1> && std::is_integral_v<T2> &&
+                                 sizeof(T1) <= 4 && sizeof(T2) <= 4)>> {
     size_t operator()(const std::pair<T1, T2> &val) const { return Hash()(val.first, val.second); }
 };
 template <typename... Types>
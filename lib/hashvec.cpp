@@ -277,6 +277,38 @@ size_t hash_vector_base::find(const void *key, lookup_cache *cache) const {
     return idx;
 }
 
+size_t hash_vector_base::find_pred(size_t hashval, bool (*eq)(const void *, size_t),
+                                   const void *ctx, lookup_cache *cache) const {
+    size_t hash = mod_hashsize[log_hashsize](hashval);
+    size_t idx, collisions = 0;
+    while ((idx = info->gethash(this, hash)) && (erased[idx - 1] || !eq(ctx, idx - 1))) {
+        if (++collisions >= hashsize) {
+            idx = 0;
+            break;
+        }
+        if (++hash == hashsize) hash = 0;
+    }
+    cache->slot = hash;
+    cache->collisions = collisions;
+    return idx;
+}
+
+void hash_vector_base::hv_reserve(size_t capacity) {
+    if (hashsize / 2 >= capacity && info->maxset >= capacity) return;
+    freehash();
+    while (hashsize / 2 < capacity) {
+        hashsize += hashsize + 1;
+        log_hashsize++;
+    }
+    BUG_CHECK(hashsize + 1 == (1UL << log_hashsize), "hash corrupt");
+    while (capacity > info->maxset) {
+        info++;
+        BUG_CHECK(info->ismap == info[-1].ismap, "capacity %d exceeds max", capacity);
+    }
+    allochash();
+    redo_hash();
+}
+
 size_t hash_vector_base::find_next(const void *key, lookup_cache *cache) const {
     size_t hash = cache->slot;
     size_t idx, collisions = cache->collisions;
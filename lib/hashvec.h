@@ -79,6 +79,12 @@ class hash_vector_base {
 
     void clear();
     size_t find(const void *key, lookup_cache *cache) const;
+    // Variant of find() for lookups whose key is not a KEY object: the caller supplies the
+    // key's hash value and a predicate comparing it against the element at a data index.
+    size_t find_pred(size_t hashval, bool (*eq)(const void *ctx, size_t idx), const void *ctx,
+                     lookup_cache *cache) const;
+    // Grow the hash table in one step so that `capacity` elements fit without rehashing.
+    void hv_reserve(size_t capacity);
     size_t find_next(const void *key, lookup_cache *cache) const;
     void *lookup(const void *key, lookup_cache *cache = nullptr);
     void *lookup_next(const void *key, lookup_cache *cache = nullptr);
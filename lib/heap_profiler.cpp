@@ -0,0 +1,113 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "heap_profiler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "absl/debugging/symbolize.h"
+#include "alloc_trace.h"
+#include "n4.h"
+
+namespace P4 {
+
+void HeapProfiler::record(void **bt, size_t sz) {
+    pendingBytes += sz;
+    pendingCount++;
+    if (pendingBytes >= sampleInterval) {
+        // Charge everything accumulated since the last sample to the stack that crossed the
+        // threshold; over many samples the per-site totals converge on the true distribution.
+        auto &stats = samples[Site(bt, currentPass ? currentPass() : nullptr)];
+        stats.bytes += pendingBytes;
+        stats.count += pendingCount;
+        pendingBytes = pendingCount = 0;
+    }
+    if (forward.fn) forward.fn(forward.arg, bt, sz);
+}
+
+void HeapProfiler::writeProfile(std::ostream &out) const {
+#if HAVE_LIBGC
+    PauseTrace temp_pause;
+#endif
+    size_t totalBytes = 0, totalCount = 0;
+    for (auto &s : samples) {
+        totalBytes += s.second.bytes;
+        totalCount += s.second.count;
+    }
+    // The legacy gperftools text format; pprof symbolizes the addresses itself using the
+    // MAPPED_LIBRARIES section. We never see frees, so in-use and cumulative stats coincide.
+    out << "heap profile: " << totalCount << ": " << totalBytes << " [" << totalCount << ": "
+        << totalBytes << "] @ heapprofile\n";
+    for (auto &s : samples) {
+        out << std::dec << s.second.count << ": " << s.second.bytes << " [" << s.second.count
+            << ": " << s.second.bytes << "] @";
+        for (void *pc : s.first.trace)
+            out << " 0x" << std::hex << reinterpret_cast<uintptr_t>(pc);
+        out << "\n";
+    }
+    out << std::dec << "\nMAPPED_LIBRARIES:\n";
+    std::ifstream maps("/proc/self/maps");
+    out << maps.rdbuf();
+}
+
+/// Extract the IR node type from a symbolized frame, e.g. "P4::IR::Member::clone()" yields
+/// "IR::Member"; returns an empty string if the frame is not in an IR class.
+static std::string irTypeOfSymbol(const char *symbol) {
+    const char *p = strstr(symbol, "IR::");
+    if (!p) return "";
+    const char *e = p + 4;
+    while (*e && (isalnum(*e) || *e == '_')) ++e;
+    return std::string(p, e);
+}
+
+void HeapProfiler::writeSummary(std::ostream &out) const {
+#if HAVE_LIBGC
+    PauseTrace temp_pause;
+#endif
+    std::map<std::pair<std::string, std::string>, Stats> byType;
+    char tmp[1024];
+    for (auto &s : samples) {
+        std::string irType;
+        for (void *pc : s.first.trace) {
+            if (!absl::Symbolize(pc, tmp, sizeof(tmp))) continue;
+            if (!(irType = irTypeOfSymbol(tmp)).empty()) break;
+        }
+        if (irType.empty()) irType = "(non-IR)";
+        auto &stats = byType[{irType, s.first.pass ? s.first.pass : "(no pass)"}];
+        stats.bytes += s.second.bytes;
+        stats.count += s.second.count;
+    }
+    using entry_t = decltype(byType)::value_type;
+    std::vector<const entry_t *> sorted;
+    size_t totalBytes = 0;
+    for (auto &e : byType) {
+        sorted.push_back(&e);
+        totalBytes += e.second.bytes;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](auto *a, auto *b) { return a->second.bytes > b->second.bytes; });
+    out << "Sampled " << n4(totalBytes) << "B of allocations by IR type and pass:\n";
+    for (auto *e : sorted)
+        out << n4(e->second.bytes) << "B " << std::setw(9) << e->second.count << " allocs  "
+            << std::setw(30) << std::left << e->first.first << std::right << "  "
+            << e->first.second << "\n";
+}
+
+}  // namespace P4
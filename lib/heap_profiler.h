@@ -0,0 +1,111 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef LIB_HEAP_PROFILER_H_
+#define LIB_HEAP_PROFILER_H_
+
+#include <cstring>
+#include <map>
+#include <ostream>
+
+#include "config.h"
+#include "exceptions.h"
+#include "gc.h"
+
+namespace P4 {
+
+/**
+ * Sampling heap profiler built on the allocator's trace hook (set_alloc_trace).
+ *
+ * While running it attributes heap allocations to their call stack and to the pass that was
+ * executing (obtained through an injected callback, so this file does not depend on the
+ * PassManager). Small allocations are sampled: their bytes are pooled and charged to the
+ * stack that makes the pooled total cross the sampling interval, so every byte is accounted
+ * for at a bounded per-allocation cost; allocations of at least the interval are always
+ * recorded. writeProfile() emits the stacks in the gperftools heap-profile text format that
+ * pprof can symbolize and display; writeSummary() symbolizes the stacks itself and emits a
+ * table of bytes per IR node type and per pass.
+ */
+class HeapProfiler {
+ public:
+    /// Returns the name of the currently executing pass, or nullptr; typically
+    /// &PassManager::currentPassName.
+    using PassNameFn = const char *(*)();
+
+    explicit HeapProfiler(PassNameFn currentPass = nullptr,
+                          size_t sampleInterval = defaultSampleInterval)
+        : currentPass(currentPass), sampleInterval(sampleInterval) {}
+
+#if HAVE_LIBGC
+    /// Install the profiler as the allocation trace callback. Any previously installed
+    /// callback keeps being invoked for every traced allocation, so the profiler composes
+    /// with other trace consumers (e.g. --profile-passes).
+    void start() { forward = set_alloc_trace(callback, this); }
+    void stop() {
+        auto tmp = set_alloc_trace(forward);
+        BUG_CHECK(tmp.fn == callback && tmp.arg == this, "HeapProfiler stopped when not running");
+    }
+#else
+    void start() { BUG("Can't profile the heap without garbage collection"); }
+    void stop() {}
+#endif
+
+    /// Write the sampled allocation stacks in the gperftools heap-profile text format
+    /// understood by pprof (including the MAPPED_LIBRARIES section).
+    void writeProfile(std::ostream &out) const;
+    /// Symbolize the sampled stacks and write a table attributing bytes to IR node types
+    /// (the innermost IR::* frame of each stack) and to the passes they were sampled in.
+    void writeSummary(std::ostream &out) const;
+
+    static constexpr size_t defaultSampleInterval = 64 * 1024;
+
+ private:
+    /// A sampled allocation site: the stack of the sampled allocation plus the pass that
+    /// was running when it was taken.
+    struct Site {
+        void *trace[ALLOC_TRACE_DEPTH];
+        const char *pass;
+
+        Site(void **bt, const char *pass) : pass(pass) { memcpy(trace, bt, sizeof(trace)); }
+        bool operator<(const Site &a) const {
+            if (pass != a.pass) return pass < a.pass;
+            for (int i = 0; i < ALLOC_TRACE_DEPTH; ++i)
+                if (trace[i] != a.trace[i]) return trace[i] < a.trace[i];
+            return false;
+        }
+    };
+    struct Stats {
+        size_t bytes = 0;
+        size_t count = 0;
+    };
+
+    void record(void **bt, size_t sz);
+    static void callback(void *t, void **bt, size_t sz) {
+        static_cast<HeapProfiler *>(t)->record(bt, sz);
+    }
+
+    std::map<Site, Stats> samples;
+    PassNameFn currentPass;
+    size_t sampleInterval;
+    /// Bytes and allocations seen since the last sample was taken.
+    size_t pendingBytes = 0;
+    size_t pendingCount = 0;
+    alloc_trace_cb_t forward = {};
+};
+
+}  // namespace P4
+
+#endif /* LIB_HEAP_PROFILER_H_ */
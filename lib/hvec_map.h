@@ -19,6 +19,7 @@ limitations under the License.
 
 #include <initializer_list>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "exceptions.h"
@@ -160,6 +161,17 @@ class hvec_map : hash_vector_base {
         hash_vector_base::clear();
         data.clear();
     }
+    /// Grow the hash table and the backing vector in one step so that @p n entries fit
+    /// without further rehashing, for callers that know their size up front.
+    void reserve(size_t n) {
+        hv_reserve(n);
+        data.reserve(n);
+    }
+
+    /// Copy of the current entries in iteration order. Rehashing and erase compaction may
+    /// invalidate iterators, so walks that insert into or erase from the map can iterate
+    /// over a snapshot instead.
+    std::vector<value_type> snapshot() const { return std::vector<value_type>(begin(), end()); }
 
     iterator find(const KEY &k) {
         hash_vector_base::lookup_cache cache;
@@ -177,6 +189,46 @@ class hvec_map : hash_vector_base {
         return idx > 0;
     }
 
+    // Heterogeneous lookup, enabled when both the hasher and the equality predicate are
+    // transparent: e.g. a cstring-keyed map can then be probed with a std::string_view
+    // without materializing a cstring.
+    template <class K2, class H = hasher, class E = key_equal,
+              class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K2 &k) {
+        hash_vector_base::lookup_cache cache;
+        size_t idx = het_find(k, &cache);
+        return idx ? iterator(*this, idx - 1) : end();
+    }
+    template <class K2, class H = hasher, class E = key_equal,
+              class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K2 &k) const {
+        hash_vector_base::lookup_cache cache;
+        size_t idx = het_find(k, &cache);
+        return idx ? const_iterator(*this, idx - 1) : end();
+    }
+    template <class K2, class H = hasher, class E = key_equal,
+              class = typename H::is_transparent, class = typename E::is_transparent>
+    size_t count(const K2 &k) const {
+        hash_vector_base::lookup_cache cache;
+        return het_find(k, &cache) > 0;
+    }
+    template <class K2, class H = hasher, class E = key_equal,
+              class = typename H::is_transparent, class = typename E::is_transparent>
+    VAL &at(const K2 &k) {
+        hash_vector_base::lookup_cache cache;
+        size_t idx = het_find(k, &cache);
+        if (!idx) throw std::out_of_range("hvec_map::at");
+        return data[idx - 1].second;
+    }
+    template <class K2, class H = hasher, class E = key_equal,
+              class = typename H::is_transparent, class = typename E::is_transparent>
+    const VAL &at(const K2 &k) const {
+        hash_vector_base::lookup_cache cache;
+        size_t idx = het_find(k, &cache);
+        if (!idx) throw std::out_of_range("hvec_map::at");
+        return data[idx - 1].second;
+    }
+
     VAL &at(const KEY &k) {
         hash_vector_base::lookup_cache cache;
         size_t idx = hash_vector_base::find(&k, &cache);
@@ -304,6 +356,19 @@ class hvec_map : hash_vector_base {
 
  private:
     std::vector<value_type, ALLOC> data;
+    // Probes the table with a key of a different type, routing the comparison back through
+    // the transparent predicate via a captureless lambda (find_pred is not a template).
+    template <class K2>
+    size_t het_find(const K2 &k, hash_vector_base::lookup_cache *cache) const {
+        std::pair<const hvec_map *, const K2 *> ctx(this, &k);
+        return hash_vector_base::find_pred(
+            hf(k),
+            [](const void *c, size_t i) -> bool {
+                auto *ctx = static_cast<const std::pair<const hvec_map *, const K2 *> *>(c);
+                return ctx->first->eql(*ctx->second, ctx->first->data[i].first);
+            },
+            &ctx, cache);
+    }
     size_t hashfn(const void *a) const override { return hf(*static_cast<const KEY *>(a)); }
     bool cmpfn(const void *a, const void *b) const override {
         return eql(*static_cast<const KEY *>(a), *static_cast<const KEY *>(b));
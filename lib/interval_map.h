@@ -0,0 +1,208 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef LIB_INTERVAL_MAP_H_
+#define LIB_INTERVAL_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "iterator_range.h"
+
+namespace P4 {
+
+/// A map from ranges to values supporting efficient overlap and containment
+/// queries, for the range types in lib/bitrange.h (anything exposing `lo`/`hi`
+/// endpoints, `overlaps()`, `contains()` and the lexicographic `operator<`).
+///
+/// Entries are kept in a vector sorted by range, augmented with a running
+/// maximum of the upper endpoints.  Since that maximum is non-decreasing, an
+/// overlap query binary searches for the first entry that can reach the probe
+/// and stops at the first entry starting beyond it, instead of scanning the
+/// whole map the way a plain ordered map forces callers to.  Like flat_map,
+/// mutation is O(n); the intended use is build-mostly tables (slice layouts
+/// and the like) that are queried many times per mutation.
+template <typename Range, typename V>
+struct interval_map {
+    using key_type = Range;
+    using mapped_type = V;
+    using value_type = std::pair<Range, V>;
+    using container_type = std::vector<value_type>;
+    using const_iterator = typename container_type::const_iterator;
+    using size_type = typename container_type::size_type;
+
+    /// Iterates the entries within a candidate window whose key satisfies the
+    /// query predicate against the probe range.
+    class query_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = interval_map::value_type;
+        using reference = const value_type &;
+        using pointer = const value_type *;
+        using difference_type = std::ptrdiff_t;
+
+        reference operator*() const { return map->entries[index]; }
+        pointer operator->() const { return &map->entries[index]; }
+        query_iterator &operator++() {
+            ++index;
+            advance();
+            return *this;
+        }
+        bool operator==(const query_iterator &other) const { return index == other.index; }
+        bool operator!=(const query_iterator &other) const { return index != other.index; }
+
+     private:
+        friend struct interval_map;
+        enum class Query { Overlapping, Containing };
+
+        query_iterator(const interval_map *map, size_type index, size_type last, Range probe,
+                       Query query)
+            : map(map), index(index), last(last), probe(probe), query(query) {
+            advance();
+        }
+        bool matches(const Range &key) const {
+            return query == Query::Overlapping ? key.overlaps(probe) : key.contains(probe);
+        }
+        void advance() {
+            while (index < last && !matches(map->entries[index].first)) ++index;
+        }
+
+        const interval_map *map;
+        size_type index, last;
+        Range probe;
+        Query query;
+    };
+
+    interval_map() = default;
+
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+    size_type size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    void clear() {
+        entries.clear();
+        maxEnd.clear();
+    }
+
+    /// @return the entry whose key is exactly @key, or end().
+    const_iterator find(const Range &key) const {
+        auto it = lowerBound(key);
+        if (it != entries.end() && !(key < it->first)) return it;
+        return entries.end();
+    }
+    size_type count(const Range &key) const { return find(key) == entries.end() ? 0 : 1; }
+
+    V &operator[](const Range &key) {
+        auto it = lowerBound(key);
+        if (it == entries.end() || key < it->first)
+            it = insertAt(it, value_type(key, mapped_type()));
+        return it->second;
+    }
+    V &at(const Range &key) {
+        auto it = lowerBound(key);
+        if (it == entries.end() || key < it->first) throw std::out_of_range("key is out of range");
+        return it->second;
+    }
+    const V &at(const Range &key) const {
+        auto it = find(key);
+        if (it == entries.end()) throw std::out_of_range("key is out of range");
+        return it->second;
+    }
+
+    std::pair<const_iterator, bool> insert(const value_type &value) {
+        auto it = lowerBound(value.first);
+        if (it != entries.end() && !(value.first < it->first)) return {it, false};
+        return {insertAt(it, value), true};
+    }
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args &&...args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const Range &key) {
+        auto it = find(key);
+        if (it == entries.end()) return 0;
+        size_type index = it - entries.begin();
+        entries.erase(entries.begin() + index);
+        recomputeFrom(index);
+        return 1;
+    }
+
+    /// @return the entries whose key overlaps @probe, in key order.
+    Util::iterator_range<query_iterator> overlapping(const Range &probe) const {
+        return makeQuery(probe, query_iterator::Query::Overlapping);
+    }
+
+    /// @return the entries whose key contains all of @probe, in key order.
+    Util::iterator_range<query_iterator> containing(const Range &probe) const {
+        return makeQuery(probe, query_iterator::Query::Containing);
+    }
+
+    /// @return true if any entry's key overlaps @probe.
+    bool has_overlap(const Range &probe) const { return !overlapping(probe).empty(); }
+
+ private:
+    typename container_type::iterator lowerBound(const Range &key) {
+        return std::lower_bound(
+            entries.begin(), entries.end(), key,
+            [](const value_type &entry, const Range &k) { return entry.first < k; });
+    }
+    const_iterator lowerBound(const Range &key) const {
+        return std::lower_bound(
+            entries.begin(), entries.end(), key,
+            [](const value_type &entry, const Range &k) { return entry.first < k; });
+    }
+
+    typename container_type::iterator insertAt(typename container_type::iterator pos,
+                                               value_type value) {
+        size_type index = pos - entries.begin();
+        auto it = entries.insert(pos, std::move(value));
+        recomputeFrom(index);
+        return it;
+    }
+
+    void recomputeFrom(size_type index) {
+        maxEnd.resize(entries.size());
+        for (size_type i = index; i < entries.size(); ++i)
+            maxEnd[i] = i == 0 ? entries[i].first.hi : std::max(maxEnd[i - 1], entries[i].first.hi);
+    }
+
+    Util::iterator_range<query_iterator> makeQuery(const Range &probe,
+                                                   typename query_iterator::Query query) const {
+        // Entries starting beyond the probe's upper endpoint cannot match;
+        // boundary entries are rejected by the per-entry predicate, so this
+        // bound is merely conservative for half-open ranges.
+        auto lastIt =
+            std::upper_bound(entries.begin(), entries.end(), probe.hi,
+                             [](int hi, const value_type &entry) { return hi < entry.first.lo; });
+        size_type last = lastIt - entries.begin();
+        // The first entry that reaches the probe's lower endpoint; everything
+        // before it ends strictly below the probe and cannot match.
+        size_type first =
+            std::lower_bound(maxEnd.begin(), maxEnd.begin() + last, probe.lo) - maxEnd.begin();
+        return {query_iterator(this, first, last, probe, query),
+                query_iterator(this, last, last, probe, query)};
+    }
+
+    container_type entries;
+    /// maxEnd[i] is the maximum upper endpoint among entries[0..i].
+    std::vector<int> maxEnd;
+};
+
+}  // namespace P4
+
+#endif /* LIB_INTERVAL_MAP_H_ */
@@ -43,6 +43,7 @@ namespace Detail {
 
 int verbosity = 0;
 int maximumLogLevel = 0;
+std::atomic<uint32_t> levelConfigEpoch{1};
 bool enableLoggingGlobally = true;
 bool enableLoggingInContext = false;
 
@@ -245,6 +246,16 @@ LevelAndOutput *cachedFileLogInfo(const char *file) {
     return mostRecentInfo = &logLevelCache[file];
 }
 
+bool CachedLevelCheck::recompute(const char *file, int level, uint32_t epoch) {
+    bool result = Log::fileLogLevelIsAtLeast(file, level);
+    // Levels outside [-1, 29] cannot be encoded; such callsites stay uncached.
+    uint32_t levelKey = uint32_t(level + 1);
+    if (levelKey < 0x1f)
+        state.store(((epoch & EPOCH_MASK) << 6) | (levelKey << 1) | uint32_t(result),
+                    std::memory_order_relaxed);
+    return result;
+}
+
 int fileLogLevel(const char *file) {
     auto *info = cachedFileLogInfo(file);
     if (info->level == -1) {
@@ -297,6 +308,7 @@ void invalidateCaches(int possibleNewMaxLogLevel) {
     mostRecentFile = nullptr;
     mostRecentInfo = nullptr;
     logLevelCache.clear();
+    levelConfigEpoch.fetch_add(1, std::memory_order_relaxed);
     maximumLogLevel = std::max(maximumLogLevel, possibleNewMaxLogLevel);
     for (auto fn : invalidateCallbacks) fn();
 }
@@ -17,6 +17,8 @@ limitations under the License.
 #ifndef LIB_LOG_H_
 #define LIB_LOG_H_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <set>
@@ -69,6 +71,34 @@ class OutputLogPrefix {
 
 void addInvalidateCallback(void (*)(void));
 std::ostream &clearPrefix(std::ostream &out);
+
+// Epoch of the log level configuration. Bumped whenever the per-file levels may change
+// (new debug spec, verbosity increase) so that per-callsite caches recheck. Starts at 1
+// so that zero-initialized callsite caches are always stale.
+extern std::atomic<uint32_t> levelConfigEpoch;
+
+// Per-callsite cache for LOGGING() level checks, so a disabled log statement in a hot
+// loop costs one relaxed load instead of a map lookup in fileLogLevel(). The level takes
+// part in the validity check because a few callsites pass a runtime-computed level.
+class CachedLevelCheck {
+    // Encodes (epoch << 6) | (level + 1) << 1 | enabled, zero-initialized to "stale".
+    // Only the low 26 bits of the epoch are kept; once the true epoch outgrows them the
+    // cache never validates again and every check falls back to the slow path.
+    std::atomic<uint32_t> state{0};
+    static constexpr uint32_t EPOCH_MASK = 0x3ffffff;
+
+    // Slow path: consult the file log level and refresh the cache.
+    bool recompute(const char *file, int level, uint32_t epoch);
+
+ public:
+    bool enabled(const char *file, int level) {
+        uint32_t cached = state.load(std::memory_order_relaxed);
+        uint32_t epoch = levelConfigEpoch.load(std::memory_order_relaxed);
+        if ((cached >> 6) == (epoch & EPOCH_MASK) && ((cached >> 1) & 0x1f) == uint32_t(level + 1))
+            return (cached & 1) != 0;
+        return recompute(file, level, epoch);
+    }
+};
 }  // namespace Detail
 
 inline std::ostream &endl(std::ostream &out) {
@@ -111,7 +141,13 @@ void increaseVerbosity();
 // NOLINTBEGIN(bugprone-macro-parentheses)
 #define LOGGING_FEATURE(TAG, N) \
     ((N) <= MAX_LOGGING_LEVEL && P4::Log::fileLogLevelIsAtLeast(TAG, N) && P4::Log::enableLogging())
-#define LOGGING(N) LOGGING_FEATURE(__FILE__, N)
+// Unlike LOGGING_FEATURE, whose tag may be a runtime value, __FILE__ is a per-callsite
+// constant, so the level check can be cached in a callsite-local static.
+#define LOGGING(N)                                               \
+    ((N) <= MAX_LOGGING_LEVEL && [](int level_) {                \
+        static P4::Log::Detail::CachedLevelCheck check_;         \
+        return check_.enabled(__FILE__, level_);                 \
+    }((N)) && P4::Log::enableLogging())
 
 #define LOGN(N, X)                                                          \
     (LOGGING(N) ? P4::Log::Detail::fileLogOutput(__FILE__)                  \
@@ -18,6 +18,44 @@ limitations under the License.
 
 namespace P4 {
 
+compiled_match_t::compiled_match_t(const match_t &m, int width) : width_(width) {
+    match_t norm = m;
+    norm.setwidth(width);
+    big_int care = norm.word0 ^ norm.word1;
+    big_int value = norm.word1 & care;
+    for (int bit = 0; bit < width; bit += 64) {
+        care_.push_back((care & UINT64_MAX).convert_to<uint64_t>());
+        value_.push_back((value & UINT64_MAX).convert_to<uint64_t>());
+        care >>= 64;
+        value >>= 64;
+    }
+    // input bits between the width and the top of the last limb must be zero, like
+    // any other bit the normalized expression requires to be 0
+    if (width % 64) care_.back() |= ~uint64_t(0) << (width % 64);
+}
+
+bool compiled_match_t::matches(const big_int &v) const {
+    big_int rest = v;
+    for (size_t i = 0; i < care_.size(); ++i) {
+        uint64_t limb = (rest & UINT64_MAX).convert_to<uint64_t>();
+        if ((limb & care_[i]) != value_[i]) return false;
+        rest >>= 64;
+    }
+    return rest == 0;  // input bits beyond the key width never match
+}
+
+int match_first(const std::vector<compiled_match_t> &entries, uint64_t input) {
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i].matches(input)) return i;
+    return -1;
+}
+
+int match_first(const std::vector<compiled_match_t> &entries, const big_int &input) {
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i].matches(input)) return i;
+    return -1;
+}
+
 static int chkmask(const match_t &m, int maskbits) {
     big_int mask = (big_int(1) << maskbits) - 1;
     int shift = 0;
@@ -20,7 +20,9 @@ limitations under the License.
 #include <stdint.h>
 
 #include <iostream>
+#include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "big_int_util.h"
 
 namespace P4 {
@@ -57,6 +59,38 @@ struct match_t {
     static match_t dont_care(int size) { return match_t(size, 0, 0); }
 };
 
+/// A match_t compiled for repeated matching against a fixed-width key.  The
+/// (word0, word1) pair is normalized to the key width up front (so in-width bits
+/// specified in neither word become don't-care, as setwidth would make them) and
+/// flattened into 64-bit limbs of "care" and "value" bits, low limb first.  Each
+/// probe is then a word-parallel compare per limb instead of big_int arithmetic,
+/// which matters when thousands of const entries are checked per lookup.
+class compiled_match_t {
+    int width_ = 0;
+    absl::InlinedVector<uint64_t, 2> care_, value_;
+
+ public:
+    compiled_match_t() = default;
+    compiled_match_t(const match_t &m, int width);
+
+    int width() const { return width_; }
+    /// Fast path for keys that fit in a machine word.
+    bool matches(uint64_t v) const {
+        if (care_.empty()) return v == 0;
+        if ((v & care_[0]) != value_[0]) return false;
+        for (size_t i = 1; i < care_.size(); ++i)
+            if (value_[i] != 0) return false;
+        return true;
+    }
+    bool matches(const big_int &v) const;
+};
+
+/// Return the index of the first entry matching @input, or -1 if none does.
+/// Entries are probed in order, so a vector sorted by priority yields the
+/// winning entry directly.
+int match_first(const std::vector<compiled_match_t> &entries, uint64_t input);
+int match_first(const std::vector<compiled_match_t> &entries, const big_int &input);
+
 std::ostream &operator<<(std::ostream &, const match_t &);
 bool operator>>(const char *, match_t &);
 
@@ -0,0 +1,264 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef LIB_ORDERED_FLAT_MAP_H_
+#define LIB_ORDERED_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace P4 {
+
+/// A map ordered by order of element insertion, like ordered_map, but with
+/// contiguous storage: the elements live in a vector in insertion order and a
+/// sorted slot-index array (in the spirit of flat_map) provides O(log n) key
+/// lookup without any per-node allocations or pointer chasing.
+///
+/// Differences from ordered_map that consumers must tolerate:
+/// - value_type is std::pair<K, V> (non-const key), as in flat_map;
+/// - iterators and references are invalidated by insertion and erasure;
+/// - erase is O(n).
+/// It is therefore best suited for small, lookup-dominated tables that are
+/// built once and iterated in a deterministic order.
+///
+/// The ALLOC parameter exists so the template signature matches the other
+/// map-shaped containers (std::map, ordered_map) and the class can be passed
+/// wherever a four-argument map template is expected, e.g. as the MAP argument
+/// of IR::NameMap; since the stored value_type has a non-const key, the
+/// allocator is rebound for the internal storage.
+template <class K, class V, class COMP = std::less<K>,
+          class ALLOC = std::allocator<std::pair<K, V>>>
+class ordered_flat_map {
+ public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef COMP key_compare;
+    typedef ALLOC allocator_type;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+
+ private:
+    typedef typename std::allocator_traits<ALLOC>::template rebind_alloc<value_type> storage_alloc;
+    typedef std::vector<value_type, storage_alloc> storage_type;
+    storage_type data;  // elements, in insertion order
+
+ public:
+    typedef typename storage_type::size_type size_type;
+    typedef typename storage_type::iterator iterator;
+    typedef typename storage_type::const_iterator const_iterator;
+    typedef typename storage_type::reverse_iterator reverse_iterator;
+    typedef typename storage_type::const_reverse_iterator const_reverse_iterator;
+
+ private:
+    typedef typename std::allocator_traits<ALLOC>::template rebind_alloc<size_type> index_alloc;
+    typedef std::vector<size_type, index_alloc> index_type;
+    index_type index;  // slots of 'data', sorted by key
+
+    typename index_type::iterator index_lower_bound(const key_type &k) {
+        return std::lower_bound(index.begin(), index.end(), k,
+                                [this](size_type slot, const key_type &key) {
+                                    return key_compare()(data[slot].first, key);
+                                });
+    }
+    typename index_type::const_iterator index_lower_bound(const key_type &k) const {
+        return std::lower_bound(index.begin(), index.end(), k,
+                                [this](size_type slot, const key_type &key) {
+                                    return key_compare()(data[slot].first, key);
+                                });
+    }
+    typename index_type::const_iterator index_upper_bound(const key_type &k) const {
+        return std::upper_bound(index.begin(), index.end(), k,
+                                [this](const key_type &key, size_type slot) {
+                                    return key_compare()(key, data[slot].first);
+                                });
+    }
+    bool index_matches(typename index_type::const_iterator it, const key_type &k) const {
+        return it != index.end() && !key_compare()(k, data[*it].first);
+    }
+    void rebuild_index() {
+        index.resize(data.size());
+        std::iota(index.begin(), index.end(), size_type(0));
+        std::sort(index.begin(), index.end(), [this](size_type a, size_type b) {
+            return key_compare()(data[a].first, data[b].first);
+        });
+    }
+
+ public:
+    ordered_flat_map() {}
+    template <typename InputIt>
+    ordered_flat_map(InputIt first, InputIt last) {
+        insert(first, last);
+    }
+    ordered_flat_map(std::initializer_list<value_type> il)
+        : ordered_flat_map(il.begin(), il.end()) {}
+
+    iterator begin() noexcept { return data.begin(); }
+    const_iterator begin() const noexcept { return data.begin(); }
+    iterator end() noexcept { return data.end(); }
+    const_iterator end() const noexcept { return data.end(); }
+    reverse_iterator rbegin() noexcept { return data.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return data.rbegin(); }
+    reverse_iterator rend() noexcept { return data.rend(); }
+    const_reverse_iterator rend() const noexcept { return data.rend(); }
+    const_iterator cbegin() const noexcept { return data.cbegin(); }
+    const_iterator cend() const noexcept { return data.cend(); }
+    const_reverse_iterator crbegin() const noexcept { return data.crbegin(); }
+    const_reverse_iterator crend() const noexcept { return data.crend(); }
+
+    bool empty() const noexcept { return data.empty(); }
+    size_type size() const noexcept { return data.size(); }
+    size_type max_size() const noexcept { return data.max_size(); }
+    void reserve(size_type n) {
+        data.reserve(n);
+        index.reserve(n);
+    }
+    bool operator==(const ordered_flat_map &a) const { return data == a.data; }
+    bool operator!=(const ordered_flat_map &a) const { return data != a.data; }
+    bool operator<(const ordered_flat_map &a) const {
+        // As for ordered_map, this order is INDEPENDENT of the insertion
+        // order: it compares the key sequences in key order, so maps holding
+        // the same keys in a different order are unordered relative to each
+        // other even though they are not ==.
+        auto it = a.index.begin();
+        for (auto slot : index) {
+            if (it == a.index.end()) return false;
+            if (key_compare()(data[slot].first, a.data[*it].first)) return true;
+            if (key_compare()(a.data[*it].first, data[slot].first)) return false;
+            ++it;
+        }
+        return it != a.index.end();
+    }
+    void clear() {
+        data.clear();
+        index.clear();
+    }
+
+    iterator find(const key_type &a) {
+        auto it = index_lower_bound(a);
+        if (!index_matches(it, a)) return data.end();
+        return data.begin() + *it;
+    }
+    const_iterator find(const key_type &a) const {
+        auto it = index_lower_bound(a);
+        if (!index_matches(it, a)) return data.end();
+        return data.begin() + *it;
+    }
+    size_type count(const key_type &a) const { return index_matches(index_lower_bound(a), a); }
+    iterator lower_bound(const key_type &a) {
+        auto it = index_lower_bound(a);
+        return it == index.end() ? data.end() : data.begin() + *it;
+    }
+    const_iterator lower_bound(const key_type &a) const {
+        auto it = index_lower_bound(a);
+        return it == index.end() ? data.end() : data.begin() + *it;
+    }
+    iterator upper_bound(const key_type &a) {
+        auto it = index_upper_bound(a);
+        return it == index.end() ? data.end() : data.begin() + *it;
+    }
+    const_iterator upper_bound(const key_type &a) const {
+        auto it = index_upper_bound(a);
+        return it == index.end() ? data.end() : data.begin() + *it;
+    }
+    // The keys are unique, so the range holds at most one element; it is in
+    // terms of the insertion-order iterators, like find.
+    std::pair<iterator, iterator> equal_range(const key_type &a) {
+        auto it = find(a);
+        return std::make_pair(it, it == data.end() ? it : it + 1);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &a) const {
+        auto it = find(a);
+        return std::make_pair(it, it == data.end() ? it : it + 1);
+    }
+    iterator upper_bound_pred(const key_type &a) {
+        auto it = index_upper_bound(a);
+        if (it == index.begin()) return data.end();
+        return data.begin() + *--it;
+    }
+    const_iterator upper_bound_pred(const key_type &a) const {
+        auto it = index_upper_bound(a);
+        if (it == index.begin()) return data.end();
+        return data.begin() + *--it;
+    }
+
+    V &operator[](const K &x) { return emplace(x).first->second; }
+    V &operator[](K &&x) { return emplace(std::move(x)).first->second; }
+    V &at(const K &x) {
+        auto it = find(x);
+        if (it == data.end()) throw std::out_of_range("ordered_flat_map::at");
+        return it->second;
+    }
+    const V &at(const K &x) const {
+        auto it = find(x);
+        if (it == data.end()) throw std::out_of_range("ordered_flat_map::at");
+        return it->second;
+    }
+
+    template <typename KK, typename... VV>
+    std::pair<iterator, bool> emplace(KK &&k, VV &&...v) {
+        auto it = index_lower_bound(k);
+        if (index_matches(it, k)) return std::make_pair(data.begin() + *it, false);
+        size_type slot = data.size();
+        data.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<KK>(k)),
+                          std::forward_as_tuple(std::forward<VV>(v)...));
+        index.insert(it, slot);
+        return std::make_pair(data.begin() + slot, true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type &v) { return emplace(v.first, v.second); }
+    std::pair<iterator, bool> insert(value_type &&v) {
+        return emplace(std::move(v.first), std::move(v.second));
+    }
+    template <class InputIterator>
+    void insert(InputIterator b, InputIterator e) {
+        while (b != e) insert(*b++);
+    }
+
+    iterator erase(const_iterator pos) {
+        size_type slot = pos - data.cbegin();
+        index.erase(index_lower_bound(pos->first));
+        for (auto &s : index)
+            if (s > slot) --s;
+        return data.erase(data.begin() + slot);
+    }
+    size_type erase(const K &k) {
+        auto it = find(k);
+        if (it == data.end()) return 0;
+        erase(const_iterator(it));
+        return 1;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        auto it = data.erase(first, last);
+        rebuild_index();
+        return it;
+    }
+
+    /// Reorder the elements with @p comp, as ordered_map::sort does; the key
+    /// index is rebuilt afterwards.
+    template <class Compare>
+    void sort(Compare comp) {
+        std::stable_sort(data.begin(), data.end(), comp);
+        rebuild_index();
+    }
+};
+
+}  // namespace P4
+
+#endif /* LIB_ORDERED_FLAT_MAP_H_ */
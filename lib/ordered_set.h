@@ -17,6 +17,7 @@ limitations under the License.
 #ifndef LIB_ORDERED_SET_H_
 #define LIB_ORDERED_SET_H_
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <initializer_list>
@@ -24,10 +25,15 @@ limitations under the License.
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace P4 {
 
-// Remembers items in insertion order
+// Remembers items in insertion order.  Most instances stay tiny, so sets at or below
+// smallSize elements are kept as a plain list and searched linearly; the sorted index is
+// only built when a set grows past that, or lazily on the first sorted_begin().
+// Iterators and element addresses are stable either way.  When COMP is transparent, find
+// and count accept any key COMP can compare.
 template <class T, class COMP = std::less<T>, class ALLOC = std::allocator<T>>
 class ordered_set {
  public:
@@ -57,7 +63,16 @@ class ordered_set {
  private:
     struct mapcmp {
         COMP comp;
+        using is_transparent = void;
         bool operator()(const T *a, const T *b) const { return comp(*a, *b); }
+        template <class U>
+        bool operator()(const T *a, const U &b) const {
+            return comp(*a, b);
+        }
+        template <class U>
+        bool operator()(const U &a, const T *b) const {
+            return comp(a, *b);
+        }
     };
     using map_alloc = typename std::allocator_traits<ALLOC>::template rebind_alloc<
         std::pair<const T *const, list_iterator>>;
@@ -76,6 +91,54 @@ class ordered_set {
         return i->second;
     }
 
+    /// Sets up to this size have no data_map and are searched linearly.
+    static constexpr typename list_type::size_type smallSize = 8;
+    /// True while the sorted index has not been built; the invariant is that data_map is
+    /// either empty or tracks every element of data.
+    bool small() const { return data_map.empty(); }
+    /// Linear search used in the small representation.
+    template <class U>
+    const_iterator small_find(const U &a) const {
+        COMP comp;
+        for (auto it = data.begin(); it != data.end(); ++it)
+            if (!comp(*it, a) && !comp(a, *it)) return it;
+        return data.end();
+    }
+    /// Small-representation lower_bound (or upper_bound when @strict): the smallest
+    /// element >= a (resp. > a), found by scanning.
+    const_iterator small_bound(const T &a, bool strict) const {
+        COMP comp;
+        const_iterator best = data.end();
+        for (auto it = data.begin(); it != data.end(); ++it) {
+            if (strict ? !comp(a, *it) : comp(*it, a)) continue;  // *it too small
+            if (best == data.end() || comp(*it, *best)) best = it;
+        }
+        return best;
+    }
+    /// Build the sorted index of a small set for sorted_begin().  The index is a cache of
+    /// data, so building it from a const accessor is safe (though, like the rest of the
+    /// container, not against concurrent use of the same set).
+    void ensure_map() const {
+        if (data_map.empty() && !data.empty()) const_cast<ordered_set *>(this)->init_data_map();
+    }
+    /// Element pointers in sorted order, whichever representation is current.
+    std::vector<const T *> sorted_ptrs() const {
+        std::vector<const T *> rv;
+        rv.reserve(data.size());
+        if (small()) {
+            for (auto &el : data) rv.push_back(&el);
+            std::sort(rv.begin(), rv.end(), mapcmp());
+        } else {
+            for (auto &el : data_map) rv.push_back(el.first);
+        }
+        return rv;
+    }
+    /// Called before linking a new element into a small set: once it outgrows the small
+    /// representation, index the existing elements.
+    void spill_if_full() {
+        if (small() && data.size() >= smallSize) init_data_map();
+    }
+
  public:
     typedef typename map_type::size_type size_type;
     class sorted_iterator : public std::iterator<std::bidirectional_iterator_tag, T> {
@@ -110,16 +173,21 @@ class ordered_set {
     };
 
     ordered_set() {}
-    ordered_set(const ordered_set &a) : data(a.data) { init_data_map(); }
-    ordered_set(std::initializer_list<T> init) : data(init) { init_data_map(); }
+    ordered_set(const ordered_set &a) : data(a.data) {
+        if (data.size() > smallSize) init_data_map();
+    }
+    ordered_set(std::initializer_list<T> init) {
+        for (auto &v : init) insert(v);
+    }
     template <typename InputIt>
-    ordered_set(InputIt first, InputIt last) : data(first, last) {
-        init_data_map();
+    ordered_set(InputIt first, InputIt last) {
+        for (; first != last; ++first) insert(*first);
     }
     ordered_set(ordered_set &&a) = default; /* move is ok? */
     ordered_set &operator=(const ordered_set &a) {
         data = a.data;
-        init_data_map();
+        data_map.clear();
+        if (data.size() > smallSize) init_data_map();
         return *this;
     }
     ordered_set &operator=(ordered_set &&a) = default; /* move is ok? */
@@ -132,14 +200,9 @@ class ordered_set {
         // have a set of ordered_sets (or use ordered_set as a map key).
         // For individual element comparison, we defer to COMP, which is 'operator<' in the
         // common case.
-        auto it = a.data_map.begin();
-        for (auto &el : data_map) {
-            if (it == a.data_map.end()) return false;
-            if (mapcmp()(el.first, it->first)) return true;
-            if (mapcmp()(it->first, el.first)) return false;
-            ++it;
-        }
-        return it != a.data_map.end();
+        auto mine = sorted_ptrs(), theirs = a.sorted_ptrs();
+        return std::lexicographical_compare(mine.begin(), mine.end(), theirs.begin(),
+                                            theirs.end(), mapcmp());
     }
 
     // FIXME add allocator and comparator ctors...
@@ -156,33 +219,77 @@ class ordered_set {
     const_iterator cend() const noexcept { return data.cend(); }
     const_reverse_iterator crbegin() const noexcept { return data.crbegin(); }
     const_reverse_iterator crend() const noexcept { return data.crend(); }
-    sorted_iterator sorted_begin() const noexcept { return data_map.begin(); }
-    sorted_iterator sorted_end() const noexcept { return data_map.end(); }
+    sorted_iterator sorted_begin() const {
+        ensure_map();
+        return data_map.begin();
+    }
+    sorted_iterator sorted_end() const {
+        ensure_map();
+        return data_map.end();
+    }
 
     reference front() const noexcept { return *data.begin(); }
     reference back() const noexcept { return *data.rbegin(); }
 
     bool empty() const noexcept { return data.empty(); }
-    size_type size() const noexcept { return data_map.size(); }
-    size_type max_size() const noexcept { return data_map.max_size(); }
+    size_type size() const noexcept { return data.size(); }
+    size_type max_size() const noexcept { return data.max_size(); }
     void clear() {
         data.clear();
         data_map.clear();
     }
 
-    iterator find(const T &a) { return tr_iter(data_map.find(&a)); }
-    const_iterator find(const T &a) const { return tr_iter(data_map.find(&a)); }
-    size_type count(const T &a) const { return data_map.count(&a); }
-    iterator upper_bound(const T &a) { return tr_iter(data_map.upper_bound(&a)); }
-    const_iterator upper_bound(const T &a) const { return tr_iter(data_map.upper_bound(&a)); }
-    iterator lower_bound(const T &a) { return tr_iter(data_map.lower_bound(&a)); }
-    const_iterator lower_bound(const T &a) const { return tr_iter(data_map.lower_bound(&a)); }
+    iterator find(const T &a) {
+        if (small()) return small_find(a);
+        return tr_iter(data_map.find(&a));
+    }
+    const_iterator find(const T &a) const {
+        if (small()) return small_find(a);
+        return tr_iter(data_map.find(&a));
+    }
+    size_type count(const T &a) const { return find(a) != data.end() ? 1 : 0; }
+    /// Heterogeneous lookup, available when COMP is transparent: any key COMP can compare
+    /// against T works without materializing a T.
+    template <class U, class C = COMP, class = typename C::is_transparent>
+    iterator find(const U &a) {
+        if (small()) return small_find(a);
+        return tr_iter(data_map.find(a));
+    }
+    template <class U, class C = COMP, class = typename C::is_transparent>
+    const_iterator find(const U &a) const {
+        if (small()) return small_find(a);
+        return tr_iter(data_map.find(a));
+    }
+    template <class U, class C = COMP, class = typename C::is_transparent>
+    size_type count(const U &a) const {
+        return find(a) != data.end() ? 1 : 0;
+    }
+    // Note that even via the sorted index these return iterators in insertion order, so
+    // they are point queries (the smallest element not less/greater than the key), not
+    // the start of a sorted range; the small representation computes them by scanning.
+    iterator upper_bound(const T &a) {
+        if (small()) return small_bound(a, true);
+        return tr_iter(data_map.upper_bound(&a));
+    }
+    const_iterator upper_bound(const T &a) const {
+        if (small()) return small_bound(a, true);
+        return tr_iter(data_map.upper_bound(&a));
+    }
+    iterator lower_bound(const T &a) {
+        if (small()) return small_bound(a, false);
+        return tr_iter(data_map.lower_bound(&a));
+    }
+    const_iterator lower_bound(const T &a) const {
+        if (small()) return small_bound(a, false);
+        return tr_iter(data_map.lower_bound(&a));
+    }
 
     std::pair<iterator, bool> insert(const T &v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(data.end(), v);
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
             return std::make_pair(it, true);
         }
         return std::make_pair(it, false);
@@ -190,8 +297,9 @@ class ordered_set {
     std::pair<iterator, bool> insert(T &&v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(data.end(), std::move(v));
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
             return std::make_pair(it, true);
         }
         return std::make_pair(it, false);
@@ -202,8 +310,9 @@ class ordered_set {
     iterator insert(const_iterator pos, const T &v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(pos, v);
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
             return it;
         }
         return it;
@@ -211,8 +320,9 @@ class ordered_set {
     iterator insert(const_iterator pos, T &&v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(pos, std::move(v));
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
             return it;
         }
         return it;
@@ -221,8 +331,9 @@ class ordered_set {
     void push_back(const T &v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(data.end(), v);
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
         } else {
             data.splice(data.end(), data, it);
         }
@@ -230,8 +341,9 @@ class ordered_set {
     void push_back(T &&v) {
         iterator it = find(v);
         if (it == data.end()) {
+            spill_if_full();
             list_iterator it = data.insert(data.end(), std::move(v));
-            data_map.emplace(&*it, it);
+            if (!small()) data_map.emplace(&*it, it);
         } else {
             data.splice(data.end(), data, it);
         }
@@ -240,9 +352,26 @@ class ordered_set {
     template <class... Args>
     std::pair<iterator, bool> emplace(Args &&...args) {
         auto it = data.emplace(data.end(), std::forward<Args>(args)...);
-        auto old = find(*it);
+        // find an equivalent pre-existing element; the just-added one is not in the
+        // data_map yet and the linear scan stops before it
+        const_iterator old = data.end();
+        if (small()) {
+            COMP comp;
+            for (auto sit = data.begin(); sit != const_iterator(it); ++sit)
+                if (!comp(*sit, *it) && !comp(*it, *sit)) {
+                    old = sit;
+                    break;
+                }
+        } else {
+            // const T* is the exact key type; &*it would be T* and take the
+            // heterogeneous path
+            old = tr_iter(data_map.find(static_cast<const T *>(&*it)));
+        }
         if (old == data.end()) {
-            data_map.emplace(&*it, it);
+            if (small() && data.size() > smallSize)
+                init_data_map();  // indexes the new element too
+            else if (!small())
+                data_map.emplace(&*it, it);
             return std::make_pair(it, true);
         } else {
             data.erase(it);
@@ -253,15 +382,27 @@ class ordered_set {
     template <class... Args>
     std::pair<iterator, bool> emplace_back(Args &&...args) {
         auto it = data.emplace(data.end(), std::forward<Args>(args)...);
-        auto old = find(*it);
-        if (old != data.end()) {
-            data.erase(old);
+        const_iterator old = data.end();
+        if (small()) {
+            COMP comp;
+            for (auto sit = data.begin(); sit != const_iterator(it); ++sit)
+                if (!comp(*sit, *it) && !comp(*it, *sit)) {
+                    old = sit;
+                    break;
+                }
+        } else {
+            old = tr_iter(data_map.find(static_cast<const T *>(&*it)));
         }
-        data_map.emplace(&*it, it);
+        if (old != data.end()) erase(old);
+        if (small() && data.size() > smallSize)
+            init_data_map();
+        else if (!small())
+            data_map.emplace(&*it, it);
         return std::make_pair(it, true);
     }
 
     iterator erase(const_iterator pos) {
+        if (small()) return data.erase(pos);
         auto it = data_map.find(&*pos);
         assert(it != data_map.end());
         // get the non-const std::list iterator -- libstdc++ is missing
@@ -273,7 +414,7 @@ class ordered_set {
     size_type erase(const T &v) {
         auto it = find(v);
         if (it != data.end()) {
-            data_map.erase(&v);
+            if (!small()) data_map.erase(&*it);
             data.erase(it);
             return 1;
         }
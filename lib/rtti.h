@@ -296,6 +296,33 @@ struct Base {
     };                                                                                     \
     DECLARE_TYPEINFO_COMMON(T, ##__VA_ARGS__)
 
+/// Same as DECLARE_TYPEINFO_WITH_TYPEID, but dynamic isA() queries whose target id is
+/// below `TableSize` are answered with a single bit test against `Table[Id]`: a
+/// precomputed bitmap of every typeid this class derives from or implements.  Target
+/// ids outside the table (hash-derived or discriminator-combined ones) fall back to
+/// the base-chain walk.  The table must be generated together with the dense typeids
+/// (as ir-generator does), which is what guarantees every id below `TableSize`
+/// belongs to the same hierarchy.
+#define DECLARE_TYPEINFO_WITH_TYPEID_AND_ISA_TABLE(T, Id, Table, TableSize, ...)          \
+ public:                                                                                  \
+    static constexpr P4::RTTI::TypeId static_typeId() { return P4::RTTI::TypeId(Id); }    \
+    static constexpr T *rttiEnabledMarker(T *);                                           \
+    using TypeInfo = P4::RTTI::TypeInfo<T, ##__VA_ARGS__>;                                \
+    [[nodiscard, gnu::const]] P4::RTTI::TypeId typeId() const noexcept override {         \
+        return TypeInfo::id();                                                            \
+    }                                                                                     \
+    [[nodiscard, gnu::const]] bool isA(P4::RTTI::TypeId typeId) const noexcept override { \
+        if (typeId < P4::RTTI::TypeId(TableSize))                                         \
+            return (Table[static_typeId()][typeId >> 6] >> (typeId & 63)) & 1;            \
+        return TypeInfo::isA(typeId);                                                     \
+    }                                                                                     \
+                                                                                          \
+ protected:                                                                               \
+    [[nodiscard, gnu::pure]] const void *toImpl(P4::RTTI::TypeId typeId) const noexcept   \
+        override {                                                                        \
+        return T::isA(typeId) ? TypeInfo::dyn_cast(typeId, this) : nullptr;               \
+    }
+
 // Common typeinfo boilerplate methods. Note that they are marked pure / const, so consecutive
 // calls to is<> / to<> on the same pointer could be eliminated by a compiler.
 //   - typeId() / isA are const as they do not access any global state, they
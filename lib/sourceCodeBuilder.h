@@ -19,6 +19,10 @@ limitations under the License.
 
 #include <ctype.h>
 
+#include <algorithm>
+#include <ostream>
+#include <string_view>
+
 #include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
 #include "lib/cstring.h"
@@ -76,6 +80,14 @@ class SourceCodeBuilder {
         endsInSpace = ::isspace(str[strlen(str) - 1]);
         buffer.Append(str);
     }
+    /// Appends the contents of another builder by reference: the underlying rope
+    /// shares the other builder's chunks instead of copying them, so a fragment of
+    /// boilerplate can be built once and appended to many outputs in O(1).
+    void append(const SourceCodeBuilder &other) {
+        if (other.buffer.empty()) return;
+        buffer.Append(other.buffer);
+        endsInSpace = other.endsInSpace;
+    }
 
     template <typename... Args>
     void appendFormat(const absl::FormatSpec<Args...> &format, Args &&...args) {
@@ -99,7 +111,12 @@ class SourceCodeBuilder {
     }
 
     void emitIndent() {
-        buffer.Append(std::string(indentLevel, ' '));
+        static constexpr std::string_view spaces = "                                ";
+        for (int remaining = indentLevel; remaining > 0;) {
+            auto chunk = std::min<int>(remaining, spaces.size());
+            buffer.Append(spaces.substr(0, chunk));
+            remaining -= chunk;
+        }
         if (indentLevel > 0) endsInSpace = true;
     }
 
@@ -110,7 +127,24 @@ class SourceCodeBuilder {
         if (nl) newline();
     }
 
+    /// Discard the contents and reset the indentation state so the builder can
+    /// be reused.  Emission loops that need a scratch builder per element can
+    /// hoist one out of the loop and clear it each iteration instead of paying
+    /// for a fresh buffer every time.
+    void clear() {
+        buffer.Clear();
+        indentLevel = 0;
+        endsInSpace = false;
+        supressSemi = false;
+    }
+
     std::string toString() const { return std::string(buffer); }
+    /// Stream the contents chunk by chunk, without first flattening the
+    /// underlying rope into one contiguous string.
+    void writeTo(std::ostream &out) const {
+        for (std::string_view chunk : buffer.Chunks()) out.write(chunk.data(), chunk.size());
+    }
+    size_t size() const { return buffer.size(); }
     void commentStart() { append("/* "); }
     void commentEnd() { append(" */"); }
     bool lastIsSpace() const { return endsInSpace; }
@@ -19,6 +19,13 @@ limitations under the License.
 #include <algorithm>
 #include <sstream>
 
+#ifdef P4C_COMPACT_SOURCE_INFO
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <tuple>
+#endif
+
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -48,6 +55,75 @@ cstring SourcePosition::toString() const {
 
 //////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef P4C_COMPACT_SOURCE_INFO
+bool SourceInfo::Data::operator<(const Data &rhs) const {
+    return std::tie(filename, line, column, srcBrief, sources, start, end) <
+           std::tie(rhs.filename, rhs.line, rhs.column, rhs.srcBrief, rhs.sources, rhs.start,
+                    rhs.end);
+}
+
+/* The side table is a fixed array of lazily allocated chunks: entries never move
+ * and new chunks are published with release stores, so lookup() needs no lock
+ * even while another thread is interning.  Interning itself is serialized. */
+static constexpr unsigned sourceInfoChunkBits = 16;
+static constexpr uint32_t sourceInfoChunkSize = 1U << sourceInfoChunkBits;
+
+const SourceInfo::Data &SourceInfo::lookup(uint32_t id) {
+    static const Data invalid;  // id 0, the default SourceInfo, never touches the table
+    if (id == 0) return invalid;
+    return *internedData(id);
+}
+
+uint32_t SourceInfo::intern(const Data &data) {
+    static std::map<Data, uint32_t> ids = {{Data(), 0}};  // id 0 is the invalid SourceInfo
+    static uint32_t nextId = 1;
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+    auto [it, isNew] = ids.emplace(data, nextId);
+    if (isNew) {
+        *internedData(nextId, true) = data;
+        ++nextId;
+    }
+    return it->second;
+}
+
+SourceInfo::Data *SourceInfo::internedData(uint32_t id, bool alloc) {
+    static std::atomic<Data *> chunks[1U << (32 - sourceInfoChunkBits)] = {};
+    auto &chunk = chunks[id >> sourceInfoChunkBits];
+    auto *entries = chunk.load(std::memory_order_acquire);
+    if (entries == nullptr && alloc) {
+        // Only called with the intern() lock held, so no other thread can be allocating.
+        entries = new Data[sourceInfoChunkSize];
+        chunk.store(entries, std::memory_order_release);
+    }
+    BUG_CHECK(entries != nullptr, "Lookup of SourceInfo id %1% that was never interned", id);
+    return entries + (id & (sourceInfoChunkSize - 1));
+}
+
+SourceInfo::SourceInfo(const InputSources *sources, SourcePosition start, SourcePosition end) {
+    BUG_CHECK(sources != nullptr, "Invalid InputSources in SourceInfo");
+    if (!start.isValid() || !end.isValid()) {
+        BUG("Invalid source position in SourceInfo %1%-%2% for %3%", start.toString(),
+            end.toString(), sources->toDebugString());
+    }
+    if (start > end)
+        BUG("SourceInfo position start %1% after end %2%", start.toString(), end.toString());
+    Data data;
+    data.sources = sources;
+    data.start = start;
+    data.end = end;
+    id = intern(data);
+}
+
+SourceInfo::SourceInfo(cstring filename, int line, int column, cstring srcBrief) {
+    Data data;
+    data.filename = filename;
+    data.line = line;
+    data.column = column;
+    data.srcBrief = srcBrief;
+    id = intern(data);
+}
+#else
 SourceInfo::SourceInfo(const InputSources *sources, SourcePosition start, SourcePosition end)
     : sources(sources), start(start), end(end) {
     BUG_CHECK(sources != nullptr, "Invalid InputSources in SourceInfo");
@@ -59,22 +135,23 @@ SourceInfo::SourceInfo(const InputSources *sources, SourcePosition start, Source
         BUG("SourceInfo position start %1% after end %2%", start.toString(), end.toString());
 }
 
-SourceInfo::SourceInfo(const InputSources *sources, SourcePosition point)
-    : SourceInfo(sources, point, point) {}
-
 SourceInfo::SourceInfo(cstring filename, int line, int column, cstring srcBrief) {
     this->filename = filename;
     this->line = line;
     this->column = column;
     this->srcBrief = srcBrief;
 }
+#endif
+
+SourceInfo::SourceInfo(const InputSources *sources, SourcePosition point)
+    : SourceInfo(sources, point, point) {}
 
 cstring SourceInfo::toString() const {
-    return absl::StrFormat("(%v)-(%v)", start.toString(), end.toString());
+    return absl::StrFormat("(%v)-(%v)", getStart().toString(), getEnd().toString());
 }
 
 std::ostream &operator<<(std::ostream &os, const SourceInfo &info) {
-    os << absl::StrFormat("(%v)-(%v)", info.start, info.end);
+    os << absl::StrFormat("(%v)-(%v)", info.getStart(), info.getEnd());
     return os;
 }
 
@@ -82,7 +159,7 @@ std::ostream &operator<<(std::ostream &os, const SourceInfo &info) {
 
 InputSources::InputSources() : sealed(false) {
     mapLine("", 1);  // the first line read will be line 1 of stdin
-    contents.push_back("");
+    lineStarts.push_back(0);
 }
 
 void InputSources::addComment(SourceInfo srcInfo, bool singleLine, cstring body) {
@@ -102,8 +179,8 @@ void InputSources::seal() {
 }
 
 unsigned InputSources::lineCount() const {
-    int size = contents.size();
-    if (contents.back().empty()) {
+    int size = lineStarts.size();
+    if (lineStarts.back() == contents.size()) {
         // do not count the last line if it is empty.
         size -= 1;
         if (size < 0) BUG("Negative line count");
@@ -119,14 +196,14 @@ void InputSources::appendToLastLine(std::string_view text) {
         char c = text[i];
         if (c == '\n') BUG("Text contains newlines");
     }
-    contents.back() += text;
+    contents += text;
 }
 
 // Append a newline and start a new line
 void InputSources::appendNewline(std::string_view newline) {
     if (sealed) BUG("Appending to sealed InputSources");
-    contents.back() += newline;
-    contents.push_back("");  // start a new line
+    contents += newline;
+    lineStarts.push_back(contents.size());  // start a new line
 }
 
 void InputSources::appendText(const char *text) {
@@ -168,7 +245,9 @@ std::string_view InputSources::getLine(unsigned lineNumber) const {
         // don't throw: this code may be called by exceptions
         // reporting on elements that have no source position
     }
-    return contents.at(lineNumber - 1);
+    size_t start = lineStarts.at(lineNumber - 1);
+    size_t end = lineNumber < lineStarts.size() ? lineStarts[lineNumber] : contents.size();
+    return std::string_view(contents).substr(start, end - start);
 }
 
 void InputSources::mapLine(std::string_view file, unsigned originalSourceLineNo) {
@@ -198,11 +277,11 @@ SourceFileLine InputSources::getSourceLine(unsigned line) const {
     return SourceFileLine(it->second.fileName, realLine);
 }
 
-unsigned InputSources::getCurrentLineNumber() const { return contents.size(); }
+unsigned InputSources::getCurrentLineNumber() const { return lineStarts.size(); }
 
 SourcePosition InputSources::getCurrentPosition() const {
     unsigned line = getCurrentLineNumber();
-    unsigned column = contents.back().size();
+    unsigned column = contents.size() - lineStarts.back();
     return SourcePosition(line, column);
 }
 
@@ -317,7 +396,7 @@ cstring InputSources::getBriefSourceFragment(const SourceInfo &position) const {
 
 cstring InputSources::toDebugString() const {
     std::stringstream builder;
-    for (const auto &line : contents) builder << line;
+    builder << contents;
     builder << "---------------" << std::endl;
     for (const auto &lf : line_file_map)
         builder << lf.first << ": " << lf.second.toString() << std::endl;
@@ -328,46 +407,46 @@ cstring InputSources::toDebugString() const {
 
 cstring SourceInfo::toSourceFragment(int trimWidth, bool useMarker) const {
     if (!isValid()) return ""_cs;
-    return sources->getSourceFragment(*this, trimWidth, useMarker);
+    return getSources()->getSourceFragment(*this, trimWidth, useMarker);
 }
 
 cstring SourceInfo::toBriefSourceFragment() const {
     if (!isValid()) return ""_cs;
-    return sources->getBriefSourceFragment(*this);
+    return getSources()->getBriefSourceFragment(*this);
 }
 
 cstring SourceInfo::toPositionString() const {
     if (!isValid()) return ""_cs;
-    SourceFileLine position = sources->getSourceLine(start.getLineNumber());
+    SourceFileLine position = getSources()->getSourceLine(getStart().getLineNumber());
     return position.toString();
 }
 
 cstring SourceInfo::toSourcePositionData(unsigned *outLineNumber, unsigned *outColumnNumber) const {
-    SourceFileLine position = sources->getSourceLine(start.getLineNumber());
+    SourceFileLine position = getSources()->getSourceLine(getStart().getLineNumber());
     if (outLineNumber != nullptr) {
         *outLineNumber = position.sourceLine;
     }
     if (outColumnNumber != nullptr) {
-        *outColumnNumber = start.getColumnNumber();
+        *outColumnNumber = getStart().getColumnNumber();
     }
     return position.fileName;
 }
 
 SourceFileLine SourceInfo::toPosition() const {
-    return sources->getSourceLine(start.getLineNumber());
+    return getSources()->getSourceLine(getStart().getLineNumber());
 }
 
 SourceFileLine SourceInfo::toPositionEnd() const {
-    return sources->getSourceLine(end.getLineNumber());
+    return getSources()->getSourceLine(getEnd().getLineNumber());
 }
 
 cstring SourceInfo::getSourceFile() const {
-    auto sourceLine = sources->getSourceLine(start.getLineNumber());
+    auto sourceLine = getSources()->getSourceLine(getStart().getLineNumber());
     return sourceLine.fileName;
 }
 
 cstring SourceInfo::getLineNum() const {
-    SourceFileLine sourceLine = sources->getSourceLine(start.getLineNumber());
+    SourceFileLine sourceLine = getSources()->getSourceLine(getStart().getLineNumber());
     return Util::toString(sourceLine.sourceLine);
 }
 
@@ -21,6 +21,7 @@ limitations under the License.
 #ifndef LIB_SOURCE_FILE_H_
 #define LIB_SOURCE_FILE_H_
 
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string_view>
@@ -131,10 +132,6 @@ SourceInfo can also be "invalid"
 */
 class SourceInfo final {
  public:
-    cstring filename = ""_cs;
-    int line = -1;
-    int column = -1;
-    cstring srcBrief = ""_cs;
     SourceInfo(cstring filename, int line, int column, cstring srcBrief);
     /// Creates an "invalid" SourceInfo
     SourceInfo() = default;
@@ -154,21 +151,21 @@ class SourceInfo final {
     SourceInfo operator+(const SourceInfo &rhs) const {
         if (!this->isValid()) return rhs;
         if (!rhs.isValid()) return *this;
-        SourcePosition s = start.min(rhs.start);
-        SourcePosition e = end.max(rhs.end);
-        return SourceInfo(sources, s, e);
+        SourcePosition s = getStart().min(rhs.getStart());
+        SourcePosition e = getEnd().max(rhs.getEnd());
+        return SourceInfo(getSources(), s, e);
     }
     SourceInfo &operator+=(const SourceInfo &rhs) {
-        if (!isValid()) {
+        if (!isValid())
             *this = rhs;
-        } else if (rhs.isValid()) {
-            start = start.min(rhs.start);
-            end = end.max(rhs.end);
-        }
+        else if (rhs.isValid())
+            *this = *this + rhs;
         return *this;
     }
 
-    bool operator==(const SourceInfo &rhs) const { return start == rhs.start && end == rhs.end; }
+    bool operator==(const SourceInfo &rhs) const {
+        return getStart() == rhs.getStart() && getEnd() == rhs.getEnd();
+    }
 
     cstring toString() const;
 
@@ -188,15 +185,31 @@ class SourceInfo final {
     SourceFileLine toPosition() const;
     SourceFileLine toPositionEnd() const;
 
-    bool isValid() const { return this->start.isValid(); }
+    bool isValid() const { return this->getStart().isValid(); }
     explicit operator bool() const { return isValid(); }
 
     cstring getSourceFile() const;
     cstring getLineNum() const;
 
+#ifdef P4C_COMPACT_SOURCE_INFO
+    const SourcePosition &getStart() const { return data().start; }
+    const SourcePosition &getEnd() const { return data().end; }
+    /// The position recorded when this SourceInfo was loaded from JSON rather than
+    /// parsed from source; see Node::sourceInfoFromJSON.
+    cstring getFilename() const { return data().filename; }
+    int getLine() const { return data().line; }
+    int getColumn() const { return data().column; }
+    cstring getSrcBrief() const { return data().srcBrief; }
+#else
     const SourcePosition &getStart() const { return this->start; }
-
     const SourcePosition &getEnd() const { return this->end; }
+    /// The position recorded when this SourceInfo was loaded from JSON rather than
+    /// parsed from source; see Node::sourceInfoFromJSON.
+    cstring getFilename() const { return filename; }
+    int getLine() const { return line; }
+    int getColumn() const { return column; }
+    cstring getSrcBrief() const { return srcBrief; }
+#endif
 
     /**
        True if this comes 'before' this source position.
@@ -206,7 +219,7 @@ class SourceInfo final {
     bool operator<(const SourceInfo &rhs) const {
         if (!rhs.isValid()) return false;
         if (!isValid()) return true;
-        return this->start < rhs.start;
+        return this->getStart() < rhs.getStart();
     }
     inline bool operator>(const SourceInfo &rhs) const { return rhs.operator<(*this); }
     inline bool operator<=(const SourceInfo &rhs) const { return !this->operator>(rhs); }
@@ -214,10 +227,44 @@ class SourceInfo final {
 
     friend std::ostream &operator<<(std::ostream &os, const SourceInfo &info);
 
+#ifdef P4C_COMPACT_SOURCE_INFO
  private:
+    /// Everything a SourceInfo denotes.  In compact mode a SourceInfo is just a 32-bit
+    /// index into a process-wide side table of interned Data records, so every IR node
+    /// shrinks by the difference and cloning a node copies four bytes of position
+    /// information instead of the whole record.
+    struct Data {
+        cstring filename = ""_cs;
+        int line = -1;
+        int column = -1;
+        cstring srcBrief = ""_cs;
+        const InputSources *sources = nullptr;
+        SourcePosition start = SourcePosition();
+        SourcePosition end = SourcePosition();
+        bool operator<(const Data &rhs) const;
+    };
+    /// The interned record for @p id; wait-free and safe against concurrent intern().
+    static const Data &lookup(uint32_t id);
+    /// The id of the record equal to @p data, adding it to the side table if new.
+    static uint32_t intern(const Data &data);
+    /// The side-table slot of @p id; allocates the containing chunk when @p alloc is set.
+    static Data *internedData(uint32_t id, bool alloc = false);
+    const Data &data() const { return lookup(id); }
+    const InputSources *getSources() const { return data().sources; }
+
+    uint32_t id = 0;  // 0 is the invalid SourceInfo
+#else
+ private:
+    const InputSources *getSources() const { return sources; }
+
+    cstring filename = ""_cs;
+    int line = -1;
+    int column = -1;
+    cstring srcBrief = ""_cs;
     const InputSources *sources = nullptr;
     SourcePosition start = SourcePosition();
     SourcePosition end = SourcePosition();
+#endif
 };
 
 class IHasSourceInfo {
@@ -338,8 +385,13 @@ class InputSources final {
 
     std::map<unsigned, SourceFileLine> line_file_map;
 
-    /// Each line also stores the end-of-line character(s)
-    std::vector<std::string> contents;
+    /// The whole input concatenated into a single buffer; lines (including
+    /// their end-of-line characters) are views into it.
+    std::string contents;
+    /// Byte offset in `contents` where each line starts; entry i is the start
+    /// of line i+1.  Never empty: the last entry is the current (open) line,
+    /// so line lookup is a single index instead of per-line bookkeeping.
+    std::vector<size_t> lineStarts;
     /// The commends found in the file.
     std::vector<Comment *> comments;
 };
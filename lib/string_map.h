@@ -15,10 +15,13 @@ limitations under the License.
 #ifndef LIB_STRING_MAP_H_
 #define LIB_STRING_MAP_H_
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <list>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "cstring.h"
@@ -61,6 +64,11 @@ class string_map {
  private:
     using map_type = absl::flat_hash_map<cstring, list_iterator>;
     map_type data_map;
+    /// The sorted-dense index built by freeze(): entries ordered by the address of
+    /// the interned key, so a lookup is a binary search over pointers with no
+    /// hashing at all.  While frozen, data_map is released entirely.
+    std::vector<std::pair<const char *, list_iterator>> frozen_index;
+    bool is_frozen = false;
     void init_data_map() {
         data_map.clear();
         for (auto it = data.begin(); it != data.end(); it++) data_map.emplace(it->first, it);
@@ -73,6 +81,13 @@ class string_map {
         if (i == data_map.end()) return data.end();
         return i->second;
     }
+    const std::pair<const char *, list_iterator> *frozen_entry(cstring a) const {
+        auto it = std::lower_bound(
+            frozen_index.begin(), frozen_index.end(), a.c_str(),
+            [](const auto &e, const char *p) { return std::less<const char *>()(e.first, p); });
+        if (it != frozen_index.end() && it->first == a.c_str()) return &*it;
+        return nullptr;
+    }
 
  public:
     using size_type = typename map_type::size_type;
@@ -86,6 +101,8 @@ class string_map {
     string_map(string_map &&a) = default;
     string_map &operator=(const string_map &a) {
         if (this != &a) {
+            frozen_index.clear();
+            is_frozen = false;
             data.clear();
             data.insert(data.end(), a.data.begin(), a.data.end());
             init_data_map();
@@ -109,8 +126,38 @@ class string_map {
     const_reverse_iterator crend() const noexcept { return data.crend(); }
 
     bool empty() const noexcept { return data.empty(); }
-    size_type size() const noexcept { return data_map.size(); }
+    size_type size() const noexcept { return data.size(); }
     size_type max_size() const noexcept { return data_map.max_size(); }
+
+    /// Switch to a sorted-dense index, for maps whose key set is fixed from now
+    /// on (primitive tables, parsed JSON objects): lookups become a binary search
+    /// over the interned key pointers and the hash table is released, which is a
+    /// substantial saving when many such maps are alive at once.  Any mutation
+    /// transparently rebuilds the hash table, so freezing is never unsafe, merely
+    /// wasted work if the map changes afterwards.
+    void freeze() {
+        if (is_frozen) return;
+        frozen_index.reserve(data.size());
+        for (auto it = data.begin(); it != data.end(); ++it)
+            frozen_index.emplace_back(it->first.c_str(), it);
+        std::sort(frozen_index.begin(), frozen_index.end(), [](const auto &a, const auto &b) {
+            return std::less<const char *>()(a.first, b.first);
+        });
+        map_type().swap(data_map);
+        is_frozen = true;
+    }
+    bool frozen() const { return is_frozen; }
+
+ private:
+    void thaw() {
+        if (!is_frozen) return;
+        is_frozen = false;
+        frozen_index.clear();
+        frozen_index.shrink_to_fit();
+        init_data_map();
+    }
+
+ public:
     /// As the map is ordered, two maps are only considered equal if the elements
     /// are inserted in the same order. Same as with ordered_map though.
     bool operator==(const string_map &a) const { return data == a.data; }
@@ -118,9 +165,17 @@ class string_map {
     void clear() {
         data.clear();
         data_map.clear();
+        frozen_index.clear();
+        is_frozen = false;
     }
 
-    iterator find(cstring a) { return tr_iter(data_map.find(a)); }
+    iterator find(cstring a) {
+        if (is_frozen) {
+            auto *e = frozen_entry(a);
+            return e ? e->second : data.end();
+        }
+        return tr_iter(data_map.find(a));
+    }
     /// Functions below do have `std::string_view` versions. Here we are having
     /// important special case: if `a` is not something that was interned, we do
     /// not copy / intern it, we know for sure that `a` is not in the map and we
@@ -129,36 +184,43 @@ class string_map {
         cstring key = cstring::get_cached(a);
         if (key.isNull()) return data.end();
 
-        return tr_iter(data_map.find(key));
+        return find(key);
+    }
+    const_iterator find(cstring a) const {
+        if (is_frozen) {
+            auto *e = frozen_entry(a);
+            return e ? const_iterator(e->second) : data.end();
+        }
+        return tr_iter(data_map.find(a));
     }
-    const_iterator find(cstring a) const { return tr_iter(data_map.find(a)); }
     const_iterator find(std::string_view a) const {
         cstring key = cstring::get_cached(a);
         if (key.isNull()) return data.end();
 
-        return tr_iter(data_map.find(key));
+        return find(key);
     }
 
-    size_type count(cstring a) const { return data_map.count(a); }
+    size_type count(cstring a) const { return find(a) != data.end() ? 1 : 0; }
     size_type count(std::string_view a) const {
         cstring key = cstring::get_cached(a);
         if (key.isNull()) return 0;
 
-        return data_map.count(key);
+        return count(key);
     }
 
-    bool contains(cstring a) const { return data_map.contains(a); }
+    bool contains(cstring a) const { return find(a) != data.end(); }
     bool contains(std::string_view a) const {
         cstring key = cstring::get_cached(a);
         if (key.isNull()) return false;
 
-        return data_map.contains(key);
+        return contains(key);
     }
 
     template <typename Key>
     V &operator[](Key &&k) {
         auto it = find(key_type(std::forward<Key>(k)));
         if (it == data.end()) {
+            thaw();
             it = data.emplace(data.end(), std::piecewise_construct, std::forward_as_tuple(k),
                               std::forward_as_tuple());
             data_map.emplace(it->first, it);
@@ -183,6 +245,7 @@ class string_map {
     std::pair<iterator, bool> emplace(Key &&k, VV &&...v) {
         auto it = find(key_type(std::forward<Key>(k)));
         if (it == data.end()) {
+            thaw();
             it = data.emplace(data.end(), std::piecewise_construct, std::forward_as_tuple(k),
                               std::forward_as_tuple(std::forward<VV>(v)...));
             data_map.emplace(it->first, it);
@@ -204,6 +267,7 @@ class string_map {
     }
 
     iterator erase(const_iterator pos) {
+        thaw();
         auto it = data_map.find(pos->first);
         assert(it != data_map.end());
         // get the non-const std::list iterator -- libstdc++ is missing
@@ -213,6 +277,7 @@ class string_map {
         return data.erase(list_it);
     }
     size_type erase(cstring k) {
+        thaw();
         auto it = find(k);
         if (it != data.end()) {
             data_map.erase(k);
@@ -222,6 +287,7 @@ class string_map {
         return 0;
     }
     size_type erase(std::string_view k) {
+        thaw();
         auto it = find(k);
         if (it != data.end()) {
             data_map.erase(it->first);
@@ -235,6 +301,8 @@ class string_map {
         using std::swap;
         swap(data, other.data);
         swap(data_map, other.data_map);
+        swap(frozen_index, other.frozen_index);
+        swap(is_frozen, other.is_frozen);
     }
 };
 
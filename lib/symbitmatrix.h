@@ -17,7 +17,10 @@ limitations under the License.
 #ifndef LIB_SYMBITMATRIX_H_
 #define LIB_SYMBITMATRIX_H_
 
+#include <utility>
+
 #include "bitvec.h"
+#include "hvec_map.h"
 
 namespace P4 {
 
@@ -103,6 +106,208 @@ class SymBitMatrix : private bitvec {
     bool operator|=(const SymBitMatrix &a) { return bitvec::operator|=(a); }
 };
 
+/* A SymBitMatrix alternative whose storage scales with the number of set bits rather than
+ * with the square of the largest id.  The same triangular bit index space is carved into
+ * fixed-size blocks held in a hash map, so a huge, mostly-empty matrix (mutual exclusivity
+ * or alignment over tens of thousands of field ids) only pays for the blocks that contain
+ * actual conflicts.  The accessor API mirrors SymBitMatrix so callers can switch between
+ * the two; mergeRows additionally provides the union step needed when closing a relation
+ * over ids discovered to be equivalent. */
+class SparseSymBitMatrix {
+    static constexpr size_t word_bits = bitvec::bits_per_unit;
+    static constexpr size_t words_per_block = 4;
+    static constexpr size_t block_bits = word_bits * words_per_block;
+    struct Block {
+        uintptr_t words[words_per_block] = {};
+    };
+    hvec_map<size_t, Block> blocks;
+
+    static size_t index(unsigned r, unsigned c) {
+        if (r < c) std::swap(r, c);
+        return (size_t(r) * r + r) / 2 + c;
+    }
+    bool getbit(size_t idx) const {
+        auto it = blocks.find(idx / block_bits);
+        if (it == blocks.end()) return false;
+        return (it->second.words[idx % block_bits / word_bits] >> (idx % word_bits)) & 1;
+    }
+    void setbit(size_t idx, bool value) {
+        if (value) {
+            blocks[idx / block_bits].words[idx % block_bits / word_bits] |= (uintptr_t)1
+                                                                            << (idx % word_bits);
+        } else if (auto it = blocks.find(idx / block_bits); it != blocks.end()) {
+            // zeroed blocks are kept; clearing bits is rare and erasure would
+            // invalidate outstanding references for no memory benefit
+            it->second.words[idx % block_bits / word_bits] &= ~((uintptr_t)1 << (idx % word_bits));
+        }
+    }
+    uintptr_t loadWord(size_t w) const {
+        auto it = blocks.find(w / words_per_block);
+        return it == blocks.end() ? 0 : it->second.words[w % words_per_block];
+    }
+    /// Visit every set bit in the contiguous triangle segment [@idx, @idx + @sz) a word at a
+    /// time; @fn receives the offset of the bit from @idx and may return true to stop early.
+    template <class Fn>
+    bool scanRange(size_t idx, size_t sz, Fn fn) const {
+        for (size_t off = 0; off < sz;) {
+            size_t shift = (idx + off) % word_bits;
+            uintptr_t word = loadWord((idx + off) / word_bits) >> shift;
+            size_t chunk = std::min(sz - off, word_bits - shift);
+            if (chunk < word_bits) word &= (((uintptr_t)1 << chunk) - 1);
+            while (word) {
+                int bit = bv::count_trailing_zeroes(word);
+                if (fn(off + bit)) return true;
+                word &= word - 1;
+            }
+            off += chunk;
+        }
+        return false;
+    }
+
+ public:
+    class bitref {
+        friend class SparseSymBitMatrix;
+        SparseSymBitMatrix &self;
+        size_t idx;
+        bitref(SparseSymBitMatrix &s, size_t i) : self(s), idx(i) {}
+
+     public:
+        bitref(const bitref &) = default;
+        operator bool() const { return self.getbit(idx); }
+        bool operator=(bool b) const {  // NOLINT(misc-unconventional-assign-operator)
+            self.setbit(idx, b);
+            return b;
+        }
+        bool operator|=(bool b) const {
+            if (b) self.setbit(idx, true);
+            return self.getbit(idx);
+        }
+    };
+
+    bitref operator()(unsigned r, unsigned c) { return bitref(*this, index(r, c)); }
+    bool operator()(unsigned r, unsigned c) const { return getbit(index(r, c)); }
+
+    unsigned size() const {
+        bool any = false;
+        size_t m = 0;
+        for (auto &[base, blk] : blocks) {
+            for (int w = words_per_block - 1; w >= 0; --w) {
+                if (!blk.words[w]) continue;
+                size_t top = base * block_bits + w * word_bits + word_bits - 1 -
+                             bv::count_leading_zeroes(blk.words[w]);
+                if (!any || top > m) m = top;
+                any = true;
+                break;
+            }
+        }
+        if (!any) return 0;
+        unsigned r = 1;
+        while ((r * r + r) / 2 <= m) r++;
+        return r;
+    }
+    bool empty() const {
+        for (auto &[base, blk] : blocks)
+            for (auto word : blk.words)
+                if (word) return false;
+        return true;
+    }
+    explicit operator bool() const { return !empty(); }
+    void clear() { blocks.clear(); }
+
+ private:
+    template <class T>
+    class rowref {
+        friend class SparseSymBitMatrix;
+        T &self;
+        unsigned row;
+        rowref(T &s, unsigned r) : self(s), row(r) {}
+
+     public:
+        rowref(const rowref &) = default;
+        rowref(rowref &&) = default;
+        explicit operator bool() const {
+            if (self.scanRange((row * size_t(row) + row) / 2, row + 1, [](size_t) {
+                    return true;
+                }))
+                return true;
+            const auto size = self.size();
+            for (auto c = row + 1; c < size; ++c)
+                if (self(row, c)) return true;
+            return false;
+        }
+        operator bitvec() const {
+            bitvec rv;
+            self.scanRange((row * size_t(row) + row) / 2, row + 1, [&rv](size_t c) {
+                rv[c] = 1;
+                return false;
+            });
+            const auto size = self.size();
+            for (auto c = row + 1; c < size; ++c)
+                if (self(row, c)) rv[c] = 1;
+            return rv;
+        }
+    };
+    class nonconst_rowref : public rowref<SparseSymBitMatrix> {
+     public:
+        friend class SparseSymBitMatrix;
+        using rowref<SparseSymBitMatrix>::rowref;
+        void operator|=(bitvec a) const {
+            for (size_t v : a) self(row, v) = 1;
+        }
+        bitref operator[](unsigned col) const { return self(row, col); }
+    };
+    class const_rowref : public rowref<const SparseSymBitMatrix> {
+     public:
+        friend class SparseSymBitMatrix;
+        using rowref<const SparseSymBitMatrix>::rowref;
+        bool operator[](unsigned col) const { return self(row, col); }
+    };
+
+ public:
+    nonconst_rowref operator[](unsigned r) { return nonconst_rowref(*this, r); }
+    const_rowref operator[](unsigned r) const { return const_rowref(*this, r); }
+
+    bool operator==(const SparseSymBitMatrix &a) const {
+        for (auto &[base, blk] : blocks)
+            for (size_t w = 0; w < words_per_block; ++w)
+                if (blk.words[w] != a.loadWord(base * words_per_block + w)) return false;
+        for (auto &[base, blk] : a.blocks)
+            if (!blocks.count(base))
+                for (auto word : blk.words)
+                    if (word) return false;
+        return true;
+    }
+    bool operator!=(const SparseSymBitMatrix &a) const { return !(*this == a); }
+    bool operator|=(const SparseSymBitMatrix &a) {
+        bool changed = false;
+        for (auto &[base, ablk] : a.blocks) {
+            Block *mine = nullptr;
+            for (size_t w = 0; w < words_per_block; ++w) {
+                if (!ablk.words[w]) continue;
+                if (!mine) mine = &blocks[base];
+                if (~mine->words[w] & ablk.words[w]) {
+                    mine->words[w] |= ablk.words[w];
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    /// Union the relations of @a and @b into both rows/columns: the closure step applied
+    /// when two ids turn out to denote the same thing (aliased fields, merged slices), so
+    /// that afterwards anything related to either id is related to both.  The diagonal and
+    /// the (@a, @b) bit itself are left untouched.
+    void mergeRows(unsigned a, unsigned b) {
+        bitvec merged = (*this)[a];
+        merged |= (*this)[b];
+        merged.clrbit(a);
+        merged.clrbit(b);
+        (*this)[a] |= merged;
+        (*this)[b] |= merged;
+    }
+};
+
 }  // namespace P4
 
 #endif /* LIB_SYMBITMATRIX_H_ */
@@ -0,0 +1,131 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lib/telemetry.h"
+
+#include <chrono>  // NOLINT linter forbids using chrono, but we don't have alternatives
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace P4::Util {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct SpanRecord {
+    const char *name;
+    int64_t parent;  // index of the enclosing span in the exported list, -1 for a root
+    Clock::time_point start;
+    Clock::duration duration{};
+    bool open = true;
+};
+
+/// All telemetry state behind one lock.  Spans mark coarse phases and counters
+/// count whole passes or diagnostics, so contention is not a concern.
+struct State {
+    Clock::time_point epoch;
+    std::vector<SpanRecord> spans;
+    std::vector<size_t> active;  // stack of open span indexes, innermost last
+    std::map<std::string, uint64_t> counters;
+    std::vector<std::pair<const char *, std::function<uint64_t()>>> gauges;
+    std::mutex mutex;
+
+    static State &get() {
+        static State STATE;
+        return STATE;
+    }
+};
+
+}  // namespace
+
+std::atomic<bool> Telemetry::enabledFlag{false};
+
+void Telemetry::enable() {
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!enabledFlag.exchange(true)) state.epoch = Clock::now();
+}
+
+void Telemetry::count(const char *counter, uint64_t delta) {
+    if (!enabled()) return;
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.counters[counter] += delta;
+}
+
+void Telemetry::registerGauge(const char *name, std::function<uint64_t()> provider) {
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.gauges.emplace_back(name, std::move(provider));
+}
+
+Telemetry::Span::Span(const char *name) : index(SIZE_MAX) {
+    if (!enabled()) return;
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    int64_t parent = state.active.empty() ? -1 : static_cast<int64_t>(state.active.back());
+    index = state.spans.size();
+    state.spans.push_back({name, parent, Clock::now()});
+    state.active.push_back(index);
+}
+
+Telemetry::Span::~Span() {
+    if (index == SIZE_MAX) return;
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto &record = state.spans[index];
+    record.duration = Clock::now() - record.start;
+    record.open = false;
+    // Spans close in scope order; anything still above us on the stack was
+    // abandoned by an exception and is closed along with us.
+    while (!state.active.empty() && state.active.back() >= index) state.active.pop_back();
+}
+
+void Telemetry::dump(std::ostream &out) {
+    auto &state = State::get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto now = Clock::now();
+    auto ns = [](Clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    };
+    out << "{\n  \"service\": \"p4c\",\n  \"spans\": [";
+    const char *sep = "\n";
+    for (const auto &span : state.spans) {
+        auto duration = span.open ? now - span.start : span.duration;
+        out << sep << "    {\"name\": \"" << span.name << "\", \"parent\": " << span.parent
+            << ", \"start_ns\": " << ns(span.start - state.epoch)
+            << ", \"duration_ns\": " << ns(duration) << "}";
+        sep = ",\n";
+    }
+    out << "\n  ],\n  \"counters\": {";
+    sep = "\n";
+    for (const auto &counter : state.counters) {
+        out << sep << "    \"" << counter.first << "\": " << counter.second;
+        sep = ",\n";
+    }
+    for (const auto &gauge : state.gauges) {
+        out << sep << "    \"" << gauge.first << "\": " << gauge.second();
+        sep = ",\n";
+    }
+    out << "\n  }\n}" << std::endl;
+}
+
+}  // namespace P4::Util
@@ -0,0 +1,69 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef LIB_TELEMETRY_H_
+#define LIB_TELEMETRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+
+namespace P4::Util {
+
+/// Structured compilation telemetry for operating the compiler as a fleet service.
+/// Collects named spans (compilation phases such as parse/frontend/midend/backend,
+/// nested by scope), monotonically increasing counters, and gauges sampled at
+/// export time, and writes them all as one JSON document.  Everything is a no-op
+/// until enable() is called (by the --telemetry option), so instrumentation can
+/// stay on hot paths unconditionally behind an enabled() check.
+class Telemetry {
+ public:
+    /// Start collecting; records the session start used as the span epoch.
+    static void enable();
+    static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+
+    /// Add @p delta to the named counter, creating it at zero on first use.
+    /// @p counter must outlive the telemetry session (a string literal in practice).
+    static void count(const char *counter, uint64_t delta = 1);
+
+    /// Register a value sampled once at export time (e.g. total IR nodes allocated).
+    static void registerGauge(const char *name, std::function<uint64_t()> provider);
+
+    /// Write everything collected so far as a single JSON document.  Spans still
+    /// open (e.g. when dumping from a crash handler) are exported with their
+    /// duration measured up to now.
+    static void dump(std::ostream &out);
+
+    /// Records one span from construction to destruction.  Spans nest: a span
+    /// opened while another is open is exported with a reference to its parent.
+    class Span {
+     public:
+        explicit Span(const char *name);
+        Span(const Span &) = delete;
+        ~Span();
+
+     private:
+        size_t index;
+    };
+
+ private:
+    static std::atomic<bool> enabledFlag;
+};
+
+}  // namespace P4::Util
+
+#endif /* LIB_TELEMETRY_H_ */
@@ -4,6 +4,8 @@
 #include <chrono>  // NOLINT linter forbids using chrono, but we don't have alternatives
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <unordered_map>
 #include <utility>
 
@@ -49,15 +51,31 @@ struct RootCounter {
     Clock::time_point start;
 
     static RootCounter &get() {
-        // TODO: not threadsafe currently. Instance of RootCounter could be thread_local:
-        //
-        // thread_local RootCounter root;
-        //
-        // however libgc cannot scan thread local data, which can lead to premature object
-        // garbage collection.
-        static RootCounter ROOT;
-        ROOT.counter.duration = Clock::now() - ROOT.start;
-        return ROOT;
+        // Each thread accumulates into its own counter tree, so timers on worker threads
+        // (e.g. under ParallelInspect) need no locking on the hot path.  The registry owns
+        // the per-thread instances from static storage; the thread_local below is only a
+        // cached pointer into it, so it is safe even though libgc cannot scan thread local
+        // data (nothing in the counter tree is GC-allocated in any case).
+        static thread_local RootCounter *root = nullptr;
+        if (root == nullptr) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            registry().emplace_back(new RootCounter);
+            root = registry().back().get();
+        }
+        root->counter.duration = Clock::now() - root->start;
+        return *root;
+    }
+
+    /// All threads' root counters, in thread registration order (the main thread first in
+    /// practice).  Guarded by registryMutex().
+    static std::vector<std::unique_ptr<RootCounter>> &registry() {
+        static std::vector<std::unique_ptr<RootCounter>> REGISTRY;
+        return REGISTRY;
+    }
+
+    static std::mutex &registryMutex() {
+        static std::mutex MUTEX;
+        return MUTEX;
     }
 
     CounterEntry *getCurrent() const { return current; }
@@ -68,6 +86,32 @@ struct RootCounter {
     RootCounter() : counter(""), current(&counter) { start = Clock::now(); }
 };
 
+/// Adds @from and (recursively) its children into @into, matching children by name.
+static void mergeCounters(CounterEntry &into, const CounterEntry &from) {
+    into.duration += from.duration;
+    into.invocations += from.invocations;
+    for (const auto &sub : from.counters)
+        mergeCounters(*into.openSubcounter(sub.second->name), *sub.second);
+}
+
+/// Merges the counter trees of all threads into a single tree keyed by counter name, so a
+/// timer accumulates the same way no matter which worker thread ran inside it.  Reports are
+/// expected to run while worker threads are quiescent (pass managers join their workers
+/// before any hook or report runs); a thread's root duration is wall time since its first
+/// timer, so the merged root takes the longest-lived thread rather than a sum.
+static CounterEntry mergedCounters() {
+    CounterEntry merged("");
+    std::lock_guard<std::mutex> lock(RootCounter::registryMutex());
+    for (const auto &root : RootCounter::registry()) {
+        root->counter.duration = Clock::now() - root->start;
+        for (const auto &sub : root->counter.counters)
+            mergeCounters(*merged.openSubcounter(sub.second->name), *sub.second);
+        merged.duration = std::max(merged.duration, root->counter.duration);
+        merged.invocations = std::max(merged.invocations, root->counter.invocations);
+    }
+    return merged;
+}
+
 }  // namespace
 
 #pragma GCC diagnostic push
@@ -142,8 +186,31 @@ static void formatCounters(std::vector<TimerEntry> &out, CounterEntry &current,
 std::vector<TimerEntry> getTimers() {
     std::vector<TimerEntry> ret;
     std::string namePrefix;
-    formatCounters(ret, RootCounter::get().counter, namePrefix, 0);
+    auto merged = mergedCounters();
+    formatCounters(ret, merged, namePrefix, 0);
     return ret;
 }
 
+// Helper function, walks the counter tree emitting one "A;B;C <usec>" line per counter.
+// The value is self time (the counter's duration minus its children's), as flamegraph
+// tools sum a frame's children back into it.
+static void formatCollapsed(std::ostream &out, const CounterEntry &current, std::string &stack) {
+    auto prevSize = stack.size();
+    if (!stack.empty()) stack += ';';
+    stack += current.name;
+    auto self = current.duration;
+    for (const auto &sub : current.counters) self -= sub.second->duration;
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(self).count();
+    out << stack << ' ' << std::max<int64_t>(usec, 0) << '\n';
+    for (const auto &sub : current.counters) formatCollapsed(out, *sub.second, stack);
+    stack.resize(prevSize);
+}
+
+void dumpCollapsedStacks(std::ostream &out) {
+    std::string stack;
+    auto merged = mergedCounters();
+    // The root counter is process wall time, not a measured scope; start from its children.
+    for (const auto &sub : merged.counters) formatCollapsed(out, *sub.second, stack);
+}
+
 }  // namespace P4::Util
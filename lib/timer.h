@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,12 @@ struct TimerEntry {
 /// Returns list of all timers for and their current values.
 std::vector<TimerEntry> getTimers();
 
+/// Writes all timers to @out in collapsed-stack form: one "Outer;Inner <microseconds>" line
+/// per timer, the input format of flame graph tools (e.g. flamegraph.pl --countname=us).
+/// Values are self time, so a frame's children sum back into it in the rendered graph.
+/// Timers from all threads are merged by name before emission.
+void dumpCollapsedStacks(std::ostream &out);
+
 // Internal implementation.
 struct ScopedTimerCtx;
 
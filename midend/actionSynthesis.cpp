@@ -106,8 +106,10 @@ bool DoSynthesizeActions::mustMove(const IR::BaseAssignmentStatement *assign) {
 
 const IR::Node *DoSynthesizeActions::preorder(IR::P4Control *control) {
     actions.clear();
+    actionsByBodyHash.clear();
     changes = false;
     if (policy != nullptr && !policy->convert(getContext(), control)) prune();  // skip this one
+    shareActions = policy != nullptr && policy->can_share(getContext(), control);
     return control;
 }
 
@@ -186,19 +188,41 @@ static cstring createName(const Util::SourceInfo &si) {
 
 const IR::Statement *DoSynthesizeActions::createAction(const IR::Statement *toAdd) {
     changes = true;
-    cstring name = refMap->newName(createName(toAdd->srcInfo).string_view());
     const IR::BlockStatement *body;
     if (toAdd->is<IR::BlockStatement>()) {
         body = toAdd->to<IR::BlockStatement>();
     } else {
         body = new IR::BlockStatement(toAdd->srcInfo, {toAdd});
     }
-    LOG3("Adding new action " << name << body);
 
-    auto action = new IR::P4Action(toAdd->srcInfo, name,
-                                   {new IR::Annotation(IR::Annotation::hiddenAnnotation, {})},
-                                   new IR::ParameterList(), body);
-    actions.push_back(action);
+    // If the policy allows it, reuse an action synthesized earlier in this
+    // control with a structurally equivalent body (equiv ignores source
+    // positions) instead of minting a duplicate.  Generated code repeats the
+    // same statement groups a lot, and the synthesized actions have no
+    // parameters, so equivalent bodies resolve to the same behavior.
+    const IR::P4Action *reuse = nullptr;
+    if (shareActions) {
+        for (auto *a : actionsByBodyHash[body->getEquivHash()]) {
+            if (a->body->equiv(*body)) {
+                reuse = a;
+                break;
+            }
+        }
+    }
+    cstring name;
+    if (reuse != nullptr) {
+        name = reuse->name;
+        LOG3("Reusing equivalent action " << name << " for " << body);
+    } else {
+        name = refMap->newName(createName(toAdd->srcInfo).string_view());
+        LOG3("Adding new action " << name << body);
+
+        auto action = new IR::P4Action(toAdd->srcInfo, name,
+                                       {new IR::Annotation(IR::Annotation::hiddenAnnotation, {})},
+                                       new IR::ParameterList(), body);
+        actions.push_back(action);
+        if (shareActions) actionsByBodyHash[body->getEquivHash()].push_back(action);
+    }
     auto actpath = new IR::PathExpression(name);
     auto repl = new IR::MethodCallExpression(toAdd->srcInfo, actpath);
     auto result = new IR::MethodCallStatement(toAdd->srcInfo, repl);
@@ -17,6 +17,8 @@ limitations under the License.
 #ifndef MIDEND_ACTIONSYNTHESIS_H_
 #define MIDEND_ACTIONSYNTHESIS_H_
 
+#include <unordered_map>
+
 #include "frontends/common/resolveReferences/referenceMap.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
@@ -50,6 +52,21 @@ class ActionSynthesisPolicy {
                              const IR::StatOrDecl *) {
         return true;
     }
+
+    /**
+       Called once per control block to decide whether a statement group that
+       is structurally equivalent to the body of an action synthesized earlier
+       in the same control may reuse that action instead of getting a fresh
+       copy.  Generated code commonly repeats the same statement groups, and
+       each duplicate otherwise becomes a separate action that the backend
+       must place.
+        @param ctxt context of the code being processed
+        @param control the control block being processed
+        @returns
+            true  equivalent statement groups share one synthesized action
+            false every statement group gets its own action
+    */
+    virtual bool can_share(const Visitor::Context *, const IR::P4Control *) { return false; }
 };
 
 /**
@@ -122,7 +139,11 @@ class DoSynthesizeActions : public Transform {
     ReferenceMap *refMap;
     TypeMap *typeMap;
     std::vector<const IR::P4Action *> actions;  // inserted actions
+    // inserted actions in the current control, bucketed by the structural hash
+    // of their bodies; only maintained when the policy allows sharing
+    std::unordered_map<uint64_t, std::vector<const IR::P4Action *>> actionsByBodyHash;
     bool changes = false;
+    bool shareActions = false;  // policy->can_share() for the current control
     ActionSynthesisPolicy *policy;
 
  public:
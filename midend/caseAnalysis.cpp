@@ -0,0 +1,91 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "caseAnalysis.h"
+
+#include <algorithm>
+
+namespace P4 {
+
+bool CaseLabelIndex::encodeType(const IR::Type *type, Key &key) const {
+    if (auto tb = type->to<IR::Type_Bits>()) {
+        key.push_back(1);
+        key.push_back(tb->size);
+        key.push_back(tb->isSigned ? 1 : 0);
+        return true;
+    }
+    if (type->is<IR::Type_InfInt>()) {
+        key.push_back(2);
+        return true;
+    }
+    return false;
+}
+
+bool CaseLabelIndex::encode(const IR::Expression *label, Key &key) const {
+    // the node kind tag keeps differently-shaped labels from colliding
+    key.push_back(big_int(label->typeId()));
+    if (auto c = label->to<IR::Constant>()) {
+        // equiv() distinguishes the base the constant was written in, so the
+        // key does too
+        if (!encodeType(c->type, key)) return false;
+        key.push_back(c->value);
+        key.push_back(c->base);
+        return true;
+    }
+    if (auto b = label->to<IR::BoolLiteral>()) {
+        key.push_back(b->value ? 1 : 0);
+        return true;
+    }
+    if (label->is<IR::DefaultExpression>()) return true;
+    if (label->is<IR::Mask>() || label->is<IR::Range>()) {
+        auto bin = label->to<IR::Operation_Binary>();
+        return encode(bin->left, key) && encode(bin->right, key);
+    }
+    if (auto list = label->to<IR::ListExpression>()) {
+        key.push_back(list->components.size());
+        for (auto e : list->components)
+            if (!encode(e, key)) return false;
+        return true;
+    }
+    if (auto member = label->to<IR::Member>()) {
+        // an enum member, e.g. E.A; names are interned, so their addresses
+        // identify them
+        if (auto tn = member->expr->to<IR::TypeNameExpression>()) {
+            if (auto typeName = tn->typeName->to<IR::Type_Name>()) {
+                key.push_back(reinterpret_cast<uintptr_t>(typeName->path->name.name.c_str()));
+                key.push_back(reinterpret_cast<uintptr_t>(member->member.name.c_str()));
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+bool CaseLabelIndex::add(const IR::Expression *label) {
+    Key key;
+    if (!encode(label, key)) return true;
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), key);
+    if (it != sorted.end() && *it == key) return false;
+    sorted.insert(it, std::move(key));
+    return true;
+}
+
+bool CaseLabelIndex::contains(const IR::Expression *label) const {
+    Key key;
+    if (!encode(label, key)) return false;
+    return std::binary_search(sorted.begin(), sorted.end(), key);
+}
+
+}  // namespace P4
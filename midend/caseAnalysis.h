@@ -0,0 +1,63 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MIDEND_CASEANALYSIS_H_
+#define MIDEND_CASEANALYSIS_H_
+
+#include <vector>
+
+#include "ir/ir.h"
+
+namespace P4 {
+
+/**
+ * Sorted index of constant select/switch case labels, shared by the passes
+ * that analyze cases (DoSimplifySelectCases, DoEliminateSwitch).
+ *
+ * Each label is canonicalized once into a flat numeric key; duplicate checks
+ * are then binary searches in a sorted vector of keys instead of pairwise
+ * structural-equivalence tests, which are quadratic in the number of cases
+ * and take seconds on generated parsers with thousands of select cases.
+ *
+ * Keys distinguish exactly what IR::Node::equiv distinguishes for the
+ * compile-time constant label forms (constants including their base,
+ * boolean literals, default expressions, masks, ranges, lists thereof, and
+ * enum members); labels in any other form are never reported as duplicates.
+ * The index is meant for the labels of a single select or switch statement,
+ * which share a key type.
+ */
+class CaseLabelIndex {
+ public:
+    /// Adds @label to the index.  Returns true if the label was not already
+    /// present; returns false for duplicates, which are not added again.
+    /// Labels that cannot be canonicalized are always considered new.
+    bool add(const IR::Expression *label);
+
+    /// Whether an equivalent label has already been added.
+    bool contains(const IR::Expression *label) const;
+
+ private:
+    using Key = std::vector<big_int>;
+
+    /// Appends the canonical encoding of @label to @key; returns false if the
+    /// label is not one of the recognized compile-time constant forms.
+    bool encode(const IR::Expression *label, Key &key) const;
+    bool encodeType(const IR::Type *type, Key &key) const;
+
+    std::vector<Key> sorted;
+};
+
+}  // namespace P4
+
+#endif /* MIDEND_CASEANALYSIS_H_ */
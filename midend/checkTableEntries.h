@@ -23,7 +23,7 @@
 
 namespace P4 {
 
-class CheckTableEntries : public Inspector {
+class CheckTableEntries final : public Inspector {
     bool genError;  // if true, generate errors for duplicates rather than just warnings
     bool preorder(const IR::P4Table *);
     bool preorder(const IR::P4Parser *) { return false; }
@@ -32,7 +32,11 @@ class CheckTableEntries : public Inspector {
     bool ternary_covers(const IR::Expression *k1, const IR::Expression *k2);
 
  public:
-    explicit CheckTableEntries(bool err = false) : genError(err) {}
+    explicit CheckTableEntries(bool err = false) : genError(err) {
+        // Only tables matter; skip everything that cannot contain one (in
+        // particular expression and type subtrees) instead of walking it.
+        dispatchOnly<IR::P4Table, IR::P4Parser, IR::Statement>();
+    }
 };
 
 }  // namespace P4
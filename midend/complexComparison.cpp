@@ -93,6 +93,23 @@ const IR::Expression *RemoveComplexComparisons::explode(Util::SourceInfo srcInfo
         return result;
     } else if (auto st = leftType->to<IR::Type_StructLike>()) {
         // Works for structs and unions
+        if (st->is<IR::Type_Struct>() && !rightTuple && !right->is<IR::StructExpression>()) {
+            auto *layout = layouts.get(st);
+            if (layout->onlyScalars) {
+                // a struct of scalars (the common metadata case): emit the
+                // comparisons straight off the cached flattened layout instead
+                // of recursing a level per nested struct.  The inner 'true &&'
+                // of the recursive expansion only disappear, so after constant
+                // folding the result is the same left-deep conjunction.
+                const IR::Expression *result = new IR::BoolLiteral(true);
+                for (auto &field : layout->fields) {
+                    auto eq =
+                        new IR::Equ(srcInfo, field.makeMember(left), field.makeMember(right));
+                    result = new IR::LAnd(srcInfo, result, eq);
+                }
+                return result;
+            }
+        }
         const IR::Expression *result = new IR::BoolLiteral(true);
         size_t index = 0;
         for (auto f : st->fields) {
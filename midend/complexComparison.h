@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
+#include "structLayout.h"
 
 namespace P4 {
 
@@ -29,6 +30,9 @@ namespace P4 {
 class RemoveComplexComparisons : public Transform {
  protected:
     TypeMap *typeMap;
+    /// Flattened layouts of the struct types being compared; lets structs of
+    /// scalars expand without re-walking the type per comparison site.
+    StructLayoutCache layouts;
 
     /// Expands left == right into sub-field comparisons
     const IR::Expression *explode(Util::SourceInfo srcInfo, const IR::Type *leftType,
@@ -36,7 +40,7 @@ class RemoveComplexComparisons : public Transform {
                                   const IR::Expression *right);
 
  public:
-    explicit RemoveComplexComparisons(TypeMap *typeMap) : typeMap(typeMap) {
+    explicit RemoveComplexComparisons(TypeMap *typeMap) : typeMap(typeMap), layouts(typeMap) {
         CHECK_NULL(typeMap);
         setName("RemoveComplexComparisons");
     }
@@ -172,10 +172,22 @@ const IR::Node *DoCopyStructures::postorder(IR::AssignmentStatement *statement)
         BUG_CHECK(statement->right->is<IR::PathExpression>() ||
                       statement->right->is<IR::Member>() || statement->right->is<IR::ArrayIndex>(),
                   "%1%: Unexpected operation when eliminating struct copying", statement->right);
-        for (const auto *f : strct->fields) {
-            const auto *right = new IR::Member(statement->right, f->name);
-            const auto *left = new IR::Member(statement->left, f->name);
-            retval.push_back(new IR::AssignmentStatement(statement->srcInfo, left, right));
+        const auto *layout = layouts.get(strct);
+        if (layout->onlyScalars) {
+            // All leaves are scalars, so the cached layout lets us expand the
+            // copy all the way down in one step instead of peeling one level
+            // of nesting per iteration of the repeated pass.
+            for (const auto &field : layout->fields) {
+                const auto *left = field.makeMember(statement->left);
+                const auto *right = field.makeMember(statement->right);
+                retval.push_back(new IR::AssignmentStatement(statement->srcInfo, left, right));
+            }
+        } else {
+            for (const auto *f : strct->fields) {
+                const auto *right = new IR::Member(statement->right, f->name);
+                const auto *left = new IR::Member(statement->left, f->name);
+                retval.push_back(new IR::AssignmentStatement(statement->srcInfo, left, right));
+            }
         }
     }
     return IR::inlineBlock(*this, std::move(retval));
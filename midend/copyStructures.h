@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
+#include "structLayout.h"
 
 namespace P4 {
 
@@ -55,6 +56,9 @@ namespace P4 {
  */
 class DoCopyStructures : public Transform {
     TypeMap *typeMap;
+    /// Flattened layouts of the struct types being copied; lets structs of
+    /// structs be expanded to their scalar leaves in one step.
+    StructLayoutCache layouts;
     /// Specific targets may allow functions or methods to return structs.
     /// Such methods will not be converted in this pass. Setting the
     /// errorOnMethodCall flag will produce an error message if such a
@@ -70,6 +74,7 @@ class DoCopyStructures : public Transform {
     explicit DoCopyStructures(TypeMap *typeMap, bool errorOnMethodCall, bool copyHeaders = false,
                               bool copyTuples = true)
         : typeMap(typeMap),
+          layouts(typeMap),
           errorOnMethodCall(errorOnMethodCall),
           copyHeaders(copyHeaders),
           copyTuples(copyTuples) {
@@ -63,6 +63,50 @@ bool CollectNodes::preorder(const IR::ParserState *state) {
     return true;
 }
 
+CoverageBitmap::CoverageBitmap(const CoverageSet &coverableNodes) {
+    size_t idx = 0;
+    for (const auto *node : coverableNodes) {
+        nodeIndex.emplace(node, idx++);
+    }
+}
+
+std::optional<size_t> CoverageBitmap::indexOf(const IR::Node *node) const {
+    auto memo = pointerMemo.find(node);
+    if (memo != pointerMemo.end()) {
+        return memo->second;
+    }
+    auto it = nodeIndex.find(node);
+    if (it == nodeIndex.end()) {
+        return std::nullopt;
+    }
+    pointerMemo.emplace(node, it->second);
+    return it->second;
+}
+
+std::optional<bool> CoverageBitmap::markVisited(const IR::Node *node) {
+    auto idx = indexOf(node);
+    if (!idx.has_value()) {
+        return std::nullopt;
+    }
+    if (visited.getbit(*idx)) {
+        return false;
+    }
+    visited.setbit(*idx);
+    return true;
+}
+
+std::optional<bool> CoverageBitmap::isVisited(const IR::Node *node) const {
+    auto idx = indexOf(node);
+    if (!idx.has_value()) {
+        return std::nullopt;
+    }
+    return visited.getbit(*idx);
+}
+
+void CoverageBitmap::mergeVisited(const CoverageBitmap &other) { visited |= other.visited; }
+
+size_t CoverageBitmap::visitedCount() const { return visited.popcount(); }
+
 void printCoverageReport(const CoverageSet &all, const CoverageSet &visited) {
     if (all.empty()) {
         return;
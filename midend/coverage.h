@@ -1,11 +1,16 @@
 #ifndef MIDEND_COVERAGE_H_
 #define MIDEND_COVERAGE_H_
 
+#include <cstddef>
+#include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/ir.h"
 #include "ir/visitor.h"
+#include "lib/bitvec.h"
 #include "lib/source_file.h"
 
 /// This file is a collection of utilities for coverage tracking in P4 programs.
@@ -70,6 +75,43 @@ class CollectNodes : public Inspector {
     const CoverageSet &getCoverableNodes();
 };
 
+/// Numbers the nodes of a fixed coverable set densely and tracks visited nodes in a bitmap keyed
+/// by that index, using the same source-info identity as CoverageSet. Repeated queries for the
+/// same node pointer are answered from an O(1) memo instead of source-info comparisons, and
+/// merging two bitmaps over the same coverable set is a word-wise OR. A single mutator thread is
+/// assumed, like everywhere else in the interpreters using this file.
+class CoverageBitmap {
+ public:
+    explicit CoverageBitmap(const CoverageSet &coverableNodes);
+
+    /// Marks @p node as visited. @returns true if the node was not visited before and
+    /// std::nullopt if the node is not part of the coverable set.
+    std::optional<bool> markVisited(const IR::Node *node);
+
+    /// @returns whether @p node has been marked visited, or std::nullopt if the node is not part
+    /// of the coverable set.
+    [[nodiscard]] std::optional<bool> isVisited(const IR::Node *node) const;
+
+    /// Merges the visited bits of @p other, which must number the same coverable set.
+    void mergeVisited(const CoverageBitmap &other);
+
+    /// @returns the number of visited nodes.
+    [[nodiscard]] size_t visitedCount() const;
+
+ private:
+    /// Looks up the dense index of @p node, memoizing the node pointer.
+    std::optional<size_t> indexOf(const IR::Node *node) const;
+
+    /// Maps each coverable node to its dense index.
+    std::map<const IR::Node *, size_t, SourceIdCmp> nodeIndex;
+
+    /// Answers repeated queries for the same node pointer without source-info comparisons.
+    mutable std::unordered_map<const IR::Node *, size_t> pointerMemo;
+
+    /// Bit i is set iff the node numbered i has been visited.
+    bitvec visited;
+};
+
 /// Produces detailed final coverage log.
 void printCoverageReport(const CoverageSet &all, const CoverageSet &visited);
 
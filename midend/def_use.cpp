@@ -54,6 +54,8 @@ void ComputeDefUse::clear() {
     def_info.clear();
     defuse.defs.clear();
     defuse.uses.clear();
+    computedFor = nullptr;
+    cacheValid = false;
 }
 
 void ComputeDefUse::flow_merge(Visitor &a_) {
@@ -217,6 +219,7 @@ class ComputeDefUse::SetupJoinPoints : public ControlFlowVisitor::SetupJoinPoint
 };
 
 void ComputeDefUse::applySetupJoinPoints(const IR::Node *root) {
+    if (cacheValid) return;
     root->apply(SetupJoinPoints(*flow_join_points));
 }
 
@@ -321,6 +324,7 @@ void ComputeDefUse::def_info_t::split_slice(le_bitrange range) {
 }
 
 bool ComputeDefUse::preorder(const IR::P4Control *c) {
+    if (cacheValid) return false;
     BUG_CHECK(state == SKIPPING, "Nested %s not supported in ComputeDefUse", c);
     IndentCtl::TempIndent indent;
     LOG5("ComputeDefUse" << uid << "(P4Control " << c->name << ")" << indent);
@@ -372,6 +376,7 @@ bool ComputeDefUse::preorder(const IR::P4Action *act) {
 }
 
 bool ComputeDefUse::preorder(const IR::Function *fn) {
+    if (cacheValid) return false;
     IndentCtl::TempIndent indent;
     LOG5("ComputeDefUse" << uid << "(Function " << fn->name << ")" << indent);
     auto oldstate = state;
@@ -383,6 +388,7 @@ bool ComputeDefUse::preorder(const IR::Function *fn) {
 }
 
 bool ComputeDefUse::preorder(const IR::P4Parser *p) {
+    if (cacheValid) return false;
     BUG_CHECK(state == SKIPPING, "Nested %s not supported in ComputeDefUse", p);
     IndentCtl::TempIndent indent;
     LOG5("ComputeDefUse" << uid << "(P4Parser " << p->name << ")" << indent);
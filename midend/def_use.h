@@ -37,6 +37,14 @@ namespace P4 {
  * of the IR to that node -- actions that are used by mulitple tables or parser states
  * reachable via multiple paths may have mulitple entries as a result
  *
+ * The computed chains are kept as a persistent analysis product: applying the
+ * same ComputeDefUse instance again to an unchanged program (the same root
+ * node — IR nodes are immutable, so pointer identity implies an unchanged
+ * tree) reuses the stored result instead of recomputing it.  Consecutive
+ * consumer passes can therefore share one instance and one computation; any
+ * transform that changes the program produces a new root, which invalidates
+ * the cache automatically.  Call clear() to invalidate it explicitly.
+ *
  * @pre Currently the code does not consider calls between controls or parsers, as it is
  * expected to run after inlining when all such calls have been flattened.
  * It could be extended to deal with the before inlining case.
@@ -59,6 +67,11 @@ class ComputeDefUse : public Inspector,
 
     enum { SKIPPING, NORMAL, READ_ONLY, WRITE_ONLY } state = SKIPPING;
 
+    // Root of the tree the stored defuse result was computed for, and whether
+    // the current application is reusing that result.
+    const IR::Node *computedFor = nullptr;
+    bool cacheValid = false;
+
  public:
     // a location in the program.  Includes the context from the visitor, which needs to
     // be copied out of the Visitor::Context objects, as they are allocated on the stack and
@@ -150,11 +163,17 @@ class ComputeDefUse : public Inspector,
     static const locset_t empty;
 
     profile_t init_apply(const IR::Node *root) override {
+        cacheValid = root == computedFor;
         auto rv = Inspector::init_apply(root);
         LOG3("## Midend ComputeDefUse");
         uid_ctr = 0;
         state = SKIPPING;
-        clear();
+        if (cacheValid) {
+            LOG3("  reusing previous result: tree is unchanged");
+        } else {
+            clear();
+            computedFor = root;
+        }
         return rv;
     }
     bool preorder(const IR::P4Control *) override;
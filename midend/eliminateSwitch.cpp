@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "eliminateSwitch.h"
 
+#include "caseAnalysis.h"
 #include "frontends/p4/coreLibrary.h"
 
 namespace P4 {
@@ -85,6 +86,7 @@ const IR::Node *DoEliminateSwitch::postorder(IR::SwitchStatement *statement) {
             new IR::DefaultExpression(IR::Type_Dontcare::get()), new IR::BlockStatement));
     }
     // Create actions
+    CaseLabelIndex seenLabels;                 // detects duplicate labels in O(log n) per case
     IR::Vector<IR::Expression> pendingLabels;  // switch labels with no statement
     for (auto sc : statement->cases) {
         auto scSrc = sc->srcInfo;
@@ -108,6 +110,11 @@ const IR::Node *DoEliminateSwitch::postorder(IR::SwitchStatement *statement) {
 
             for (auto lab : pendingLabels) {
                 if (!lab->is<IR::DefaultExpression>()) {
+                    if (!seenLabels.add(lab)) {
+                        // a duplicate exact-match entry could never fire
+                        warn(ErrorType::WARN_DUPLICATE, "%1%: duplicate switch label ignored", lab);
+                        continue;
+                    }
                     auto entry = new IR::Entry(scSrc, true, nullptr, new IR::ListExpression({lab}),
                                                actionCall, false);
                     entries.push_back(entry);
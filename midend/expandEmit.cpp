@@ -60,42 +60,78 @@ bool DoExpandEmit::expandArg(const IR::Type *type, const IR::Argument *arg,
     }
 }
 
-const IR::Node *DoExpandEmit::postorder(IR::MethodCallStatement *statement) {
+bool DoExpandEmit::expandEmit(const IR::MethodCallStatement *statement,
+                              IR::IndexedVector<IR::StatOrDecl> *result) {
     auto mi = MethodInstance::resolve(statement->methodCall, this, typeMap);
-    if (auto em = mi->to<P4::ExternMethod>()) {
-        if (em->originalExternType->name.name == P4::P4CoreLibrary::instance().packetOut.name &&
-            em->method->name.name == P4::P4CoreLibrary::instance().packetOut.emit.name) {
-            if (em->expr->arguments->size() != 1) {
-                ::P4::error(ErrorType::ERR_UNEXPECTED, "%1%: expected exactly 1 argument",
-                            statement);
-                return statement;
-            }
+    auto em = mi->to<P4::ExternMethod>();
+    if (em == nullptr) return false;
+    if (em->originalExternType->name.name != P4::P4CoreLibrary::instance().packetOut.name ||
+        em->method->name.name != P4::P4CoreLibrary::instance().packetOut.emit.name)
+        return false;
+    if (em->expr->arguments->size() != 1) {
+        ::P4::error(ErrorType::ERR_UNEXPECTED, "%1%: expected exactly 1 argument", statement);
+        return false;
+    }
 
-            auto arg0 = em->expr->arguments->at(0);
-            auto type = typeMap->getType(arg0, true);
-            std::vector<const IR::Argument *> expansion;
-            std::vector<const IR::Type *> expansionTypes;
-            if (expandArg(type, arg0, &expansion, &expansionTypes)) {
-                IR::IndexedVector<IR::StatOrDecl> vec;
-                auto it = expansionTypes.begin();
-                for (auto e : expansion) {
-                    auto method = statement->methodCall->method->clone();
-                    auto argType = *it;
-                    auto args = new IR::Vector<IR::Argument>();
-                    args->push_back(e);
-                    auto typeArgs = new IR::Vector<IR::Type>();
-                    typeArgs->push_back(argType->getP4Type());
-                    auto mce = new IR::MethodCallExpression(statement->methodCall->srcInfo, method,
-                                                            typeArgs, args);
-                    auto stat = new IR::MethodCallStatement(mce);
-                    vec.push_back(stat);
-                    ++it;
-                }
-                return new IR::BlockStatement(std::move(vec));
-            }
-        }
+    auto arg0 = em->expr->arguments->at(0);
+    auto type = typeMap->getType(arg0, true);
+    std::vector<const IR::Argument *> expansion;
+    std::vector<const IR::Type *> expansionTypes;
+    if (!expandArg(type, arg0, &expansion, &expansionTypes)) return false;
+    auto it = expansionTypes.begin();
+    for (auto e : expansion) {
+        auto method = statement->methodCall->method->clone();
+        auto argType = *it;
+        auto args = new IR::Vector<IR::Argument>();
+        args->push_back(e);
+        auto typeArgs = new IR::Vector<IR::Type>();
+        typeArgs->push_back(argType->getP4Type());
+        auto mce =
+            new IR::MethodCallExpression(statement->methodCall->srcInfo, method, typeArgs, args);
+        auto stat = new IR::MethodCallStatement(mce);
+        result->push_back(stat);
+        ++it;
     }
+    return true;
+}
+
+const IR::Node *DoExpandEmit::postorder(IR::MethodCallStatement *statement) {
+    // Emits that are direct children of a block are expanded in batch by the
+    // BlockStatement postorder below.
+    if (getContext()->node->is<IR::BlockStatement>()) return statement;
+    IR::IndexedVector<IR::StatOrDecl> vec;
+    if (expandEmit(statement, &vec)) return new IR::BlockStatement(std::move(vec));
     return statement;
 }
 
+const IR::Node *DoExpandEmit::postorder(IR::BlockStatement *block) {
+    // First traversal: expand each emit exactly once and compute the size of
+    // the final statement sequence.
+    std::map<size_t, IR::IndexedVector<IR::StatOrDecl>> expansions;
+    size_t finalCount = block->components.size();
+    for (size_t i = 0; i < block->components.size(); i++) {
+        auto mcs = block->components.at(i)->to<IR::MethodCallStatement>();
+        if (mcs == nullptr) continue;
+        IR::IndexedVector<IR::StatOrDecl> expansion;
+        if (!expandEmit(mcs, &expansion)) continue;
+        finalCount += expansion.size() - 1;
+        expansions.emplace(i, std::move(expansion));
+    }
+    if (expansions.empty()) return block;
+
+    // Build the replacement statement sequence in one pass.
+    IR::IndexedVector<IR::StatOrDecl> components;
+    components.reserve(finalCount);
+    for (size_t i = 0; i < block->components.size(); i++) {
+        auto it = expansions.find(i);
+        if (it == expansions.end()) {
+            components.push_back(block->components.at(i));
+        } else {
+            for (auto s : it->second) components.push_back(s);
+        }
+    }
+    block->components = std::move(components);
+    return block;
+}
+
 }  // namespace P4
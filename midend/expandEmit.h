@@ -41,20 +41,32 @@ namespace P4 {
  * emit(s.h1);
  * emit(s.h2[0]);
  * emit(s.h2[1]);
+ *
+ * Emits that appear directly in a block are expanded in batch: the
+ * enclosing BlockStatement is rebuilt exactly once, with its statement
+ * vector pre-sized to the final count and the expansions spliced in
+ * place of the original calls.  Only emits in other positions (e.g., a
+ * branch consisting of a single statement) are wrapped in a new block.
  */
-class DoExpandEmit : public Transform, public ResolutionContext {
+class DoExpandEmit final : public Transform, public ResolutionContext {
     TypeMap *typeMap;
 
  public:
     explicit DoExpandEmit(TypeMap *typeMap) : typeMap(typeMap) {
         CHECK_NULL(typeMap);
         setName("DoExpandEmit");
+        dispatchOnly<IR::MethodCallStatement, IR::BlockStatement>();
     }
     // return true if the expansion produced something "new"
     bool expandArg(const IR::Type *type, const IR::Argument *argument,
                    std::vector<const IR::Argument *> *result,
                    std::vector<const IR::Type *> *resultTypes);
+    // If @statement is an emit whose argument requires expansion, append the
+    // sequence of single-header emits to @result and return true.
+    bool expandEmit(const IR::MethodCallStatement *statement,
+                    IR::IndexedVector<IR::StatOrDecl> *result);
     const IR::Node *postorder(IR::MethodCallStatement *statement) override;
+    const IR::Node *postorder(IR::BlockStatement *block) override;
 };
 
 class ExpandEmit : public PassManager {
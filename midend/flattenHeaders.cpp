@@ -29,13 +29,7 @@ void FindHeaderTypesToReplace::createReplacement(const IR::Type_Header *type,
 
 bool FindHeaderTypesToReplace::preorder(const IR::Type_Header *type) {
     // check if header has structs in it and create flat replacement if it does
-    for (auto f : type->fields) {
-        auto ft = typeMap->getType(f, true);
-        if (ft->is<IR::Type_Struct>()) {
-            createReplacement(type, policy);
-            break;
-        }
-    }
+    if (layouts.get(type)->nested) createReplacement(type, policy);
     return false;
 }
 
@@ -21,6 +21,7 @@ limitations under the License.
 #include "flattenInterfaceStructs.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
+#include "structLayout.h"
 
 namespace P4 {
 
@@ -30,11 +31,13 @@ Find the types to replace and insert them in the nested struct map.
 class FindHeaderTypesToReplace : public Inspector {
     P4::TypeMap *typeMap;
     AnnotationSelectionPolicy *policy;
+    /// Caches which header types contain nested structs.
+    StructLayoutCache layouts;
     ordered_map<cstring, StructTypeReplacement<IR::Type_StructLike> *> replacement;
 
  public:
     explicit FindHeaderTypesToReplace(P4::TypeMap *typeMap, AnnotationSelectionPolicy *policy)
-        : typeMap(typeMap), policy(policy) {
+        : typeMap(typeMap), policy(policy), layouts(typeMap) {
         setName("FindHeaderTypesToReplace");
         CHECK_NULL(typeMap);
     }
@@ -0,0 +1,69 @@
+/*
+Copyright 2018 VMware, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MIDEND_FLATTENSTRUCTS_H_
+#define MIDEND_FLATTENSTRUCTS_H_
+
+#include "flattenHeaders.h"
+#include "flattenInterfaceStructs.h"
+#include "frontends/p4/typeChecking/typeChecker.h"
+#include "ir/ir.h"
+
+namespace P4 {
+
+/**
+ * Unified driver for the type-flattening passes.
+ *
+ * Runs the header flattening of FlattenHeaders and the interface struct
+ * flattening of FlattenInterfaceStructs as one pass with a single shared
+ * annotation policy, and only pays for the stages that have work to do:
+ * each program rewrite — and the type map invalidation and re-typechecking
+ * it forces — is skipped entirely when the corresponding analysis found
+ * nothing to flatten.  Programs without nested headers or nested interface
+ * structs are traversed twice by the cheap analyses and never rebuilt,
+ * where the separate passes unconditionally re-typechecked the program
+ * twice.
+ *
+ * The two rewrites cannot be fused into one traversal: the member
+ * rewriting of FlattenInterfaceStructs needs a type map for the program
+ * produced by the header rewrite.
+ *
+ * Replaces the back-to-back FlattenHeaders + FlattenInterfaceStructs
+ * sequence; like those passes it should run after NestedStructs.
+ */
+class FlattenStructs final : public PassManager {
+    NestedStructMap sm;
+
+ public:
+    explicit FlattenStructs(TypeMap *typeMap, AnnotationSelectionPolicy *policy = nullptr)
+        : sm(typeMap) {
+        auto findHeadersToReplace = new FindHeaderTypesToReplace(typeMap, policy);
+        passes.push_back(new TypeChecking(nullptr, typeMap));
+        passes.push_back(findHeadersToReplace);
+        passes.push_back(
+            new PassIf([findHeadersToReplace]() { return !findHeadersToReplace->empty(); },
+                       {new ReplaceHeaders(typeMap, findHeadersToReplace),
+                        new ClearTypeMap(typeMap), new TypeChecking(nullptr, typeMap)}));
+        passes.push_back(new FindTypesToReplace(&sm));
+        passes.push_back(new PassIf([this]() { return !sm.empty(); },
+                                    {new ReplaceStructs(&sm), new ClearTypeMap(typeMap)}));
+        setName("FlattenStructs");
+    }
+};
+
+}  // namespace P4
+
+#endif /* MIDEND_FLATTENSTRUCTS_H_ */
@@ -64,6 +64,109 @@ void checkParametersForMap(const IR::ParameterList *params,
         if (param->hasOut()) removeVarsContaining(vars, param->name.name);
 }
 
+// Records a write of 'val' (a literal, or nullptr for an unknown value) to the location
+// 'name' in the summary 'writes'. Conflicting writes to the same location degrade to
+// nullptr, meaning the location holds no single known literal after the callee runs.
+static void addWriteToSummary(std::map<cstring, const IR::Expression *> &writes, cstring name,
+                              const IR::Expression *val) {
+    if (name.isNullOrEmpty()) return;
+    auto it = writes.find(name);
+    if (it == writes.end())
+        writes.emplace(name, val);
+    else if (it->second != nullptr && (val == nullptr || !val->equiv(*it->second)))
+        it->second = nullptr;
+}
+
+const std::map<cstring, const IR::Expression *> *getWriteSummary(
+    const IR::Node *node, ReferenceMap *refMap, TypeMap *typeMap,
+    std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *summaries);
+
+// Invalidates entries of 'vars' for locations overlapping a location recorded in 'summary'.
+// An entry whose summarized value is a literal equivalent to the value currently stored for
+// it is still valid and is kept, mirroring the check made when the corresponding assignments
+// are visited directly.
+void applyWriteSummary(std::map<cstring, const IR::Expression *> *vars,
+                       const std::map<cstring, const IR::Expression *> *summary) {
+    for (auto &entry : *summary) {
+        auto stored = (*vars)[entry.first];
+        if (stored == nullptr || entry.second == nullptr || !entry.second->equiv(*stored))
+            removeVarsContaining(vars, entry.first);
+    }
+}
+
+/** Collects the write summary of a subtree: every lvalue name possibly modified by the code
+ * visited, mapped to the literal the location is known to be left with, or to nullptr when
+ * there is no single known value. Direct action calls are composed from the callee's cached
+ * summary, so each callee body is only analyzed once per program.
+ */
+class FindModifiedValues : public Inspector {
+    ReferenceMap *refMap;
+    TypeMap *typeMap;
+    std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *summaries;
+    std::map<cstring, const IR::Expression *> &writes;
+
+    bool preorder(const IR::BaseAssignmentStatement *stat) override {
+        // Only a plain assignment of a literal to an unsliced lvalue leaves the
+        // location with a known value.
+        const IR::Expression *val = nullptr;
+        if (stat->is<IR::AssignmentStatement>() && !stat->left->is<IR::AbstractSlice>())
+            val = stat->right->to<IR::Literal>();
+        addWriteToSummary(writes, GlobalCopyProp::lValueName(stat->left), val);
+        return true;
+    }
+    bool preorder(const IR::ForInStatement *stat) override {
+        addWriteToSummary(writes, stat->ref->path->name, nullptr);
+        return true;
+    }
+    bool preorder(const IR::MethodCallExpression *mc) override {
+        auto *mi = MethodInstance::resolve(mc, refMap, typeMap, true);
+        if (auto aCall = mi->to<ActionCall>()) {
+            for (auto &entry : *getWriteSummary(aCall->action->body, refMap, typeMap, summaries))
+                addWriteToSummary(writes, entry.first, entry.second);
+        } else if (auto eFun = mi->to<ExternFunction>()) {
+            for (auto param : eFun->method->getParameters()->parameters)
+                if (param->hasOut()) addWriteToSummary(writes, param->name.name, nullptr);
+        } else if (auto fCall = mi->to<FunctionCall>()) {
+            for (auto param : fCall->function->getParameters()->parameters)
+                if (param->hasOut()) addWriteToSummary(writes, param->name.name, nullptr);
+        }
+        return true;
+    }
+
+ public:
+    FindModifiedValues(ReferenceMap *rM, TypeMap *tM,
+                       std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *s,
+                       std::map<cstring, const IR::Expression *> &w)
+        : refMap(rM), typeMap(tM), summaries(s), writes(w) {}
+};
+
+// Returns the write summary for 'node' (an action body, table or loop subtree), computing
+// and caching it in 'summaries' on first use so that every apply site composes the cached
+// summary instead of re-analyzing the callee. A table is summarized as the merge of the
+// summaries of all the actions on its action list.
+const std::map<cstring, const IR::Expression *> *getWriteSummary(
+    const IR::Node *node, ReferenceMap *refMap, TypeMap *typeMap,
+    std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *summaries) {
+    auto it = summaries->find(node);
+    if (it != summaries->end()) return it->second;
+    auto *writes = new std::map<cstring, const IR::Expression *>;
+    (*summaries)[node] = writes;
+    if (auto tbl = node->to<IR::P4Table>()) {
+        LOG6("Summarizing writes of table: " << tbl->name);
+        for (auto ale : tbl->getActionList()->actionList) {
+            auto decl = refMap->getDeclaration(ale->getPath(), true);
+            BUG_CHECK(decl->is<IR::P4Action>(), "%1% is not an action", decl);
+            for (auto &entry : *getWriteSummary(decl->to<IR::P4Action>()->body, refMap, typeMap,
+                                                summaries))
+                addWriteToSummary(*writes, entry.first, entry.second);
+        }
+    } else {
+        LOG6("Summarizing writes of: " << node);
+        node->apply(FindModifiedValues(refMap, typeMap, summaries, *writes));
+    }
+    return writes;
+}
+
 bool FindVariableValues::preorder(const IR::P4Control *ctrl) {
     LOG2("FindVariableValues working on control: " << ctrl->name);
     working = true;
@@ -189,7 +292,21 @@ bool FindVariableValues::preorder(const IR::OpAssignmentStatement *stat) {
 // An entry in the 'actions' map is set for the action node that was acquired by resolving
 // the 'ActionCall'.
 void FindVariableValues::postorder(const IR::MethodCallExpression *mc) {
-    if (!working || mc->method->is<IR::Member>()) return;
+    if (!working) return;
+    if (mc->method->is<IR::Member>()) {
+        // Applying a table modifies whatever the actions on its action list modify;
+        // compose the table's cached write summary instead of analyzing its actions
+        // at every apply site.
+        auto *mi = MethodInstance::resolve(mc, refMap, typeMap, true);
+        if (auto aMet = mi->to<ApplyMethod>()) {
+            if (aMet->isTableApply()) {
+                LOG5("Composing write summary for table apply: " << mc);
+                applyWriteSummary(&vars, getWriteSummary(aMet->object->to<IR::P4Table>(), refMap,
+                                                         typeMap, writeSummaries));
+            }
+        }
+        return;
+    }
 
     LOG5("Working on 'MethodCallexpression': " << mc);
     auto *mi = MethodInstance::resolve(mc, refMap, typeMap, true);
@@ -204,6 +321,11 @@ void FindVariableValues::postorder(const IR::MethodCallExpression *mc) {
             visit(aCall->action->body);
         } else {
             LOG6("  Is 'ActionCall'. Entry already exists for this action: " << aCall->action);
+            // The body was analyzed and optimized for an earlier call site; account for
+            // its effects here by composing its cached write summary.
+            applyWriteSummary(&vars,
+                              getWriteSummary(aCall->action->body, refMap, typeMap,
+                                              writeSummaries));
         }
     } else if (auto eFun = mi->to<ExternFunction>()) {
         LOG6("  Is 'ExternFunction'. Checking params for: " << eFun->method);
@@ -317,47 +439,22 @@ IR::IfStatement *DoGlobalCopyPropagation::preorder(IR::IfStatement *stat) {
     return stat;
 }
 
-/** remove all the vars that might be modified by the code visited from the `vars` map
- */
-class RemoveModifiedValues : public Inspector {
-    ReferenceMap *refMap;
-    TypeMap *typeMap;
-    std::map<cstring, const IR::Expression *> *vars;
-
-    bool preorder(const IR::BaseAssignmentStatement *stat) override {
-        if ((*vars)[GlobalCopyProp::lValueName(stat->left)] == nullptr ||
-            !(stat->right->equiv(*((*vars)[GlobalCopyProp::lValueName(stat->left)]))))
-            removeVarsContaining(vars, GlobalCopyProp::lValueName(stat->left));
-        return true;
-    }
-    bool preorder(const IR::MethodCallExpression *mc) override {
-        auto *mi = MethodInstance::resolve(mc, refMap, typeMap, true);
-        if (auto eFun = mi->to<ExternFunction>()) {
-            LOG6("  Is 'ExternFunction'. Checking params for: " << eFun->method);
-            checkParametersForMap(eFun->method->getParameters(), vars);
-        } else if (auto fCall = mi->to<P4::FunctionCall>()) {
-            LOG6("  Is 'FunctionCall'. Checking params for: " << fCall->function);
-            checkParametersForMap(fCall->function->getParameters(), vars);
-        }
-        return true;
-    }
-
- public:
-    RemoveModifiedValues(ReferenceMap *rM, TypeMap *tM,
-                         std::map<cstring, const IR::Expression *> *v)
-        : refMap(rM), typeMap(tM), vars(v) {}
-};
-
 IR::ForStatement *DoGlobalCopyPropagation::preorder(IR::ForStatement *stat) {
     if (!performRewrite) return stat;
     visit(stat->init, "init");
-    stat->body->apply(RemoveModifiedValues(refMap, typeMap, vars));
-    stat->updates.apply(RemoveModifiedValues(refMap, typeMap, vars));
+    // Summarize the vars that might be modified by the body and updates once; the
+    // summary is keyed on the original subtrees so it is shared with the Inspector
+    // pass and with any enclosing loop.
+    auto orig = getOriginal<IR::ForStatement>();
+    auto *bodyWrites = getWriteSummary(orig->body, refMap, typeMap, writeSummaries);
+    auto *updateWrites = getWriteSummary(&orig->updates, refMap, typeMap, writeSummaries);
+    applyWriteSummary(vars, bodyWrites);
+    applyWriteSummary(vars, updateWrites);
     visit(stat->condition, "condition");
     visit(stat->body, "body");
     visit(stat->updates, "updates");
-    stat->body->apply(RemoveModifiedValues(refMap, typeMap, vars));
-    stat->updates.apply(RemoveModifiedValues(refMap, typeMap, vars));
+    applyWriteSummary(vars, bodyWrites);
+    applyWriteSummary(vars, updateWrites);
     prune();
     return stat;
 }
@@ -366,9 +463,11 @@ IR::ForInStatement *DoGlobalCopyPropagation::preorder(IR::ForInStatement *stat)
     if (!performRewrite) return stat;
     visit(stat->collection, "collection");
     removeVarsContaining(vars, stat->ref->path->name);
-    stat->body->apply(RemoveModifiedValues(refMap, typeMap, vars));
+    auto *bodyWrites =
+        getWriteSummary(getOriginal<IR::ForInStatement>()->body, refMap, typeMap, writeSummaries);
+    applyWriteSummary(vars, bodyWrites);
     visit(stat->body, "body");
-    stat->body->apply(RemoveModifiedValues(refMap, typeMap, vars));
+    applyWriteSummary(vars, bodyWrites);
     prune();
     return stat;
 }
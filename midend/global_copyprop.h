@@ -19,6 +19,11 @@ LocalCopyPropagation pass, and therefore doesn't introduce some of the features
 The logic of this pass is divided into 2 passes, an Inspector pass that collects information
 on the variables used in the program and their values at the time of the action call and a
 Transformer pass that uses this information to edit the action bodies.
+Callee effects are summarized at most once per callee: the locations an action, table or loop
+body may write (together with the literal each location is known to be left with, when there
+is one) are cached in a shared write-summary map and composed into the variable state at every
+apply site, so the cost of the pass stays proportional to the program size rather than to the
+number of apply sites times the callee sizes.
 The nature of the below mentionied optimization is such that it requires retroactive
 transformations to the action bodies, and this was the reason for having 2 separate passes.
 
@@ -73,6 +78,12 @@ class FindVariableValues final : public Inspector {
     // This inner map uses the name of the variable as a key and the pointer to the 'Expression'
     // node, that represents a literal, as a value.
     std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *actions;
+    // Cache of per-callee write summaries, shared with the Transformer pass. Keys are
+    // action bodies, tables or loop subtrees; values map every lvalue name the callee
+    // may write to the literal the location is known to be left with, or to nullptr
+    // when no single literal value is known. Each callee is summarized at most once
+    // and the summary is composed into 'vars' at every apply site.
+    std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *writeSummaries;
     // Flag for controlling which IR nodes this pass operates on
     bool working = false;
 
@@ -91,11 +102,13 @@ class FindVariableValues final : public Inspector {
  public:
     FindVariableValues(
         ReferenceMap *refMap, TypeMap *typeMap,
-        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *acts)
+        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *acts,
+        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *summaries)
         : refMap(refMap),
           typeMap(typeMap),
           vars(*new std::map<cstring, const IR::Expression *>),
-          actions(acts) {}
+          actions(acts),
+          writeSummaries(summaries) {}
 };
 
 /**
@@ -116,14 +129,18 @@ class DoGlobalCopyPropagation final : public Transform {
     // the name of the variable as a key and the pointer to the 'Expression' node, that represents a
     // literal, as a value.
     std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *actions;
+    // Cache of per-callee write summaries shared with the Inspector pass, see the
+    // description in FindVariableValues.
+    std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *writeSummaries;
     // Flag for controlling which IR nodes this pass operates on
     bool performRewrite = false;
 
  public:
     explicit DoGlobalCopyPropagation(
         ReferenceMap *rM, TypeMap *tM,
-        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *acts)
-        : refMap(rM), typeMap(tM), actions(acts) {}
+        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *acts,
+        std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *> *summaries)
+        : refMap(rM), typeMap(tM), actions(acts), writeSummaries(summaries) {}
 
     // Returns the stored value for the used variable
     const IR::Expression *copyprop_name(cstring name);
@@ -146,8 +163,10 @@ class GlobalCopyPropagation : public PassManager {
     GlobalCopyPropagation(ReferenceMap *rM, TypeMap *tM) {
         passes.push_back(new TypeChecking(rM, tM, true));
         auto acts = new std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *>;
-        passes.push_back(new FindVariableValues(rM, tM, acts));
-        passes.push_back(new DoGlobalCopyPropagation(rM, tM, acts));
+        auto summaries =
+            new std::map<const IR::Node *, std::map<cstring, const IR::Expression *> *>;
+        passes.push_back(new FindVariableValues(rM, tM, acts, summaries));
+        passes.push_back(new DoGlobalCopyPropagation(rM, tM, acts, summaries));
         setName("GlobalCopyPropagation");
     }
 };
@@ -55,6 +55,37 @@ const IR::Node *HSIndexTransform::postorder(IR::ArrayIndex *curArrayIndex) {
 
 int HSIndexContretizer::idCtr;
 
+const HSStackDescriptor &HSIndexContretizer::stackDescriptor(const IR::ArrayIndex *arrayIndex) {
+    const auto *typeStack = arrayIndex->left->type->checkedTo<IR::Type_Array>();
+    auto it = stackDescriptors->find(typeStack);
+    if (it == stackDescriptors->end()) {
+        HSStackDescriptor descriptor{typeStack->getSize(), typeStack->elementType};
+        it = stackDescriptors->emplace(typeStack, descriptor).first;
+        LOG5("HSIndexContretizer(" << id << ") stack descriptor: depth=" << descriptor.depth
+                                   << " element=" << descriptor.elementType);
+    }
+    return it->second;
+}
+
+IR::IfStatement *HSIndexContretizer::buildDispatchTree(HSIndexFinder &aiFinder,
+                                                       IR::Statement *statement, size_t lo,
+                                                       size_t hi, IR::IfStatement *outOfBound) {
+    const auto *indexType = aiFinder.arrayIndex->right->type;
+    if (hi - lo == 1) {
+        HSIndexTransform aiRewriter(aiFinder, lo);
+        const auto *newStatement = statement->apply(aiRewriter)->to<IR::Statement>();
+        auto *newCondition = new IR::Equ(aiFinder.newVariable, new IR::Constant(indexType, lo));
+        // Only the rightmost leaf receives outOfBound; indexes beyond the stack end
+        // up there after failing every comparison on the way down.
+        return new IR::IfStatement(newCondition, newStatement, outOfBound);
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    auto *ifTrue = buildDispatchTree(aiFinder, statement, lo, mid, nullptr);
+    auto *ifFalse = buildDispatchTree(aiFinder, statement, mid, hi, outOfBound);
+    auto *newCondition = new IR::Lss(aiFinder.newVariable, new IR::Constant(indexType, mid));
+    return new IR::IfStatement(newCondition, ifTrue, ifFalse);
+}
+
 IR::Node *HSIndexContretizer::eliminateArrayIndexes(HSIndexFinder &aiFinder,
                                                     IR::Statement *statement,
                                                     const IR::Expression *expr) {
@@ -73,11 +104,7 @@ IR::Node *HSIndexContretizer::eliminateArrayIndexes(HSIndexFinder &aiFinder,
                 aiFinder.arrayIndex->srcInfo, aiFinder.newVariable, aiFinder.arrayIndex->right));
         }
     }
-    IR::IfStatement *result = nullptr;
-    IR::IfStatement *curResult = nullptr;
-    IR::IfStatement *newIf = nullptr;
-    const auto *typeStack = aiFinder.arrayIndex->left->type->checkedTo<IR::Type_Array>();
-    size_t sz = typeStack->getSize();
+    size_t sz = stackDescriptor(aiFinder.arrayIndex).depth;
     if ((expansion += (sz - 1)) > maxExpansion) {
         if (expansion - sz < maxExpansion)
             error(ErrorType::ERR_OVERLIMIT, "%1%Too much expansion from non-const array indexes",
@@ -86,24 +113,7 @@ IR::Node *HSIndexContretizer::eliminateArrayIndexes(HSIndexFinder &aiFinder,
     }
     LOG5("HSIndexContretizer(" << id << ") expand " << aiFinder.arrayIndex << " by " << sz
                                << ",  expansion = " << expansion);
-    for (size_t i = 0; i < sz; i++) {
-        HSIndexTransform aiRewriter(aiFinder, i);
-        const auto *newStatement = statement->apply(aiRewriter)->to<IR::Statement>();
-        auto *newIndex = new IR::Constant(aiFinder.arrayIndex->right->type, i);
-        auto *newCondition = new IR::Equ(aiFinder.newVariable, newIndex);
-        if (curIf != nullptr) {
-            newIf = newStatement->checkedTo<IR::IfStatement>()->clone();
-            newIf->condition = new IR::LAnd(newCondition, newIf->condition);
-        } else {
-            newIf = new IR::IfStatement(newCondition, newStatement, nullptr);
-        }
-        if (result == nullptr) {
-            result = newIf;
-        } else {
-            curResult->ifFalse = newIf;
-        }
-        curResult = newIf;
-    }
+    IR::IfStatement *outOfBound = nullptr;
     if (expr != nullptr && locals != nullptr) {
         // Add case for write out of bound.
         cstring typeString = expr->type->toString();
@@ -133,10 +143,45 @@ IR::Node *HSIndexContretizer::eliminateArrayIndexes(HSIndexFinder &aiFinder,
 
         auto *newCondition = new IR::Geq(
             aiFinder.newVariable, new IR::Constant(aiFinder.arrayIndex->right->type, sz - 1));
-        newIf = new IR::IfStatement(newCondition, newStatement, nullptr);
-        curResult->ifFalse = newIf;
+        outOfBound = new IR::IfStatement(newCondition, newStatement, nullptr);
+    }
+    // A deep stack in a plain statement dispatches through a balanced tree of index
+    // comparisons: downstream passes cope with log-depth control flow far better than
+    // with a linear else-if chain.  Short stacks keep the chain, which is cheaper to
+    // match for them.  Conditional statements also keep the chain: the original
+    // condition is merged into every arm and a failed arm must still reach the
+    // original else branch, which only the shared fall-through of a chain expresses.
+    constexpr size_t maxLinearDispatch = 8;
+    IR::IfStatement *result = nullptr;
+    if (curIf == nullptr && sz > maxLinearDispatch) {
+        result = buildDispatchTree(aiFinder, statement, 0, sz, outOfBound);
+    } else {
+        IR::IfStatement *curResult = nullptr;
+        for (size_t i = 0; i < sz; i++) {
+            HSIndexTransform aiRewriter(aiFinder, i);
+            const auto *newStatement = statement->apply(aiRewriter)->to<IR::Statement>();
+            auto *newIndex = new IR::Constant(aiFinder.arrayIndex->right->type, i);
+            auto *newCondition = new IR::Equ(aiFinder.newVariable, newIndex);
+            IR::IfStatement *newIf = nullptr;
+            if (curIf != nullptr) {
+                newIf = newStatement->checkedTo<IR::IfStatement>()->clone();
+                newIf->condition = new IR::LAnd(newCondition, newIf->condition);
+            } else {
+                newIf = new IR::IfStatement(newCondition, newStatement, nullptr);
+            }
+            if (result == nullptr) {
+                result = newIf;
+            } else {
+                curResult->ifFalse = newIf;
+            }
+            curResult = newIf;
+        }
+        if (outOfBound != nullptr) {
+            curResult->ifFalse = outOfBound;
+            curResult = outOfBound;
+        }
+        curResult->ifFalse = elseBody;
     }
-    newIf->ifFalse = elseBody;
     newComponents.push_back(result);
     return new IR::BlockStatement(newComponents);
 }
@@ -185,7 +230,7 @@ IR::Node *HSIndexContretizer::preorder(IR::P4Control *control) {
     IR::IndexedVector<IR::Declaration> newControlLocals;
     GeneratedVariablesMap blockGeneratedVariables;
     HSIndexContretizer hsSimplifier(typeMap, maxExpansion, nameGen, &newControlLocals,
-                                    &blockGeneratedVariables);
+                                    &blockGeneratedVariables, stackDescriptors);
     newControl->body = newControl->body->apply(hsSimplifier)->to<IR::BlockStatement>();
     for (const auto *declaration : controlKeySimplified->controlLocals) {
         if (declaration->is<IR::P4Action>()) {
@@ -210,7 +255,8 @@ IR::Node *HSIndexContretizer::preorder(IR::BlockStatement *blockStatement) {
     if (aiFinder.arrayIndex == nullptr) {
         return blockStatement;
     }
-    HSIndexContretizer hsSimplifier(typeMap, maxExpansion, nameGen, locals, generatedVariables);
+    HSIndexContretizer hsSimplifier(typeMap, maxExpansion, nameGen, locals, generatedVariables,
+                                    stackDescriptors);
     hsSimplifier.expansion = expansion;
     auto *newBlock = blockStatement->clone();
     IR::IndexedVector<IR::StatOrDecl> newComponents;
@@ -11,6 +11,15 @@ namespace P4 {
 
 using GeneratedVariablesMap = std::map<cstring, const IR::PathExpression *>;
 
+/// Precomputed facts about one header-stack type, computed on first use and
+/// shared by all dynamic accesses into stacks of that type.
+struct HSStackDescriptor {
+    size_t depth;                 ///< Number of elements in the stack.
+    const IR::Type *elementType;  ///< Type of one stack element.
+};
+
+using StackDescriptorMap = std::map<const IR::Type_Array *, HSStackDescriptor>;
+
 /// This class finds innermost header stack with non-concrete index.
 /// For each found innermost header stack it generates new local variable and
 /// adds it to the corresponded local definitions.
@@ -66,11 +75,17 @@ class HSIndexTransform : public Transform {
 /// hdivr0 = hdr.i;
 /// if (hdivr0 == 0) { hdr.h[0] = 1;}
 /// else if (hdivr0 == 1){hdr.h[1] = 1;}
+/// Deep stacks in plain statements dispatch through a balanced tree of index
+/// comparisons (if (hdivr0 < 4) {...} else {...}) instead of the linear else-if
+/// chain, so the generated control flow stays log-depth.  Conditional statements
+/// always keep the chain, because the original condition is merged into every arm
+/// and a failed arm must fall through to the original else branch.
 class HSIndexContretizer : public Transform {
     TypeMap *typeMap;
     std::shared_ptr<MinimalNameGenerator> nameGen;
     IR::IndexedVector<IR::Declaration> *locals;
     GeneratedVariablesMap *generatedVariables;
+    StackDescriptorMap *stackDescriptors;
     size_t expansion = 0, maxExpansion;
     int id;
     static int idCtr;
@@ -79,11 +94,13 @@ class HSIndexContretizer : public Transform {
     explicit HSIndexContretizer(TypeMap *typeMap, size_t maxExpansion,
                                 std::shared_ptr<MinimalNameGenerator> nameGen = nullptr,
                                 IR::IndexedVector<IR::Declaration> *locals = nullptr,
-                                GeneratedVariablesMap *generatedVariables = nullptr)
+                                GeneratedVariablesMap *generatedVariables = nullptr,
+                                StackDescriptorMap *stackDescriptors = nullptr)
         : typeMap(typeMap),
           nameGen(nameGen),
           locals(locals),
           generatedVariables(generatedVariables),
+          stackDescriptors(stackDescriptors ? stackDescriptors : new StackDescriptorMap()),
           maxExpansion(maxExpansion) {
         id = ++idCtr;
         if (generatedVariables == nullptr) generatedVariables = new GeneratedVariablesMap();
@@ -111,6 +128,9 @@ class HSIndexContretizer : public Transform {
  protected:
     IR::Node *eliminateArrayIndexes(HSIndexFinder &aiFinder, IR::Statement *statement,
                                     const IR::Expression *expr);
+    const HSStackDescriptor &stackDescriptor(const IR::ArrayIndex *arrayIndex);
+    IR::IfStatement *buildDispatchTree(HSIndexFinder &aiFinder, IR::Statement *statement, size_t lo,
+                                       size_t hi, IR::IfStatement *outOfBound);
 };
 
 class HSIndexSimplifier : public PassManager {
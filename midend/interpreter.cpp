@@ -9,6 +9,18 @@ namespace P4 {
 
 unsigned SymbolicValue::crtid = 0;
 
+void ValueMap::widen() {
+    for (auto &v : map) {
+        if (v.second->is<SymbolicExtern>()) continue;
+        auto it = shared.find(v.first);
+        if (it != shared.end()) {
+            v.second = v.second->clone();
+            shared.erase(it);
+        }
+        v.second->setAllUnknown();
+    }
+}
+
 SymbolicValue *SymbolicValueFactory::create(const IR::Type *type, bool uninitialized) const {
     type = typeMap->getTypeType(type, true);
     if (type->is<IR::Type_Bits>())
@@ -1064,7 +1076,10 @@ void ExpressionEvaluator::postorder(const IR::PathExpression *expression) {
     if (type->is<IR::Type_Error>())
         result = new SymbolicEnum(type, decl->getName());
     else
-        result = valueMap->get(decl);
+        // Values reached from an evaluated expression may later be mutated in
+        // place (assignment, setValid, extract, out arguments), so detach the
+        // root from any value maps sharing it.
+        result = valueMap->getWritable(decl);
     set(expression, result);
 }
 
@@ -1173,7 +1188,8 @@ void ExpressionEvaluator::postorder(const IR::MethodCallExpression *expression)
                 }
 
                 auto decl = em->object;
-                auto obj = valueMap->get(decl);
+                // The packet is advanced below, so it needs a private copy.
+                auto obj = valueMap->getWritable(decl);
                 CHECK_NULL(obj);
                 if (obj->is<SymbolicError>()) {
                     set(expression, obj);
@@ -37,6 +37,9 @@ class SymbolicValue : public IHasDbPrint, public ICastable {
  public:
     const unsigned id;
     const IR::Type *type;
+    /// Total number of symbolic values allocated so far in this process;
+    /// a cheap proxy for the memory consumed by symbolic evaluation.
+    static unsigned getAllocatedCount() { return crtid; }
     virtual bool isScalar() const = 0;
     virtual SymbolicValue *clone() const = 0;
     virtual void setAllUnknown() = 0;
@@ -68,12 +71,29 @@ class SymbolicValueFactory {
     unsigned getWidth(const IR::Type *type) const;
 };
 
+/**
+ * Maps declarations to their symbolic values. Cloning is copy-on-write at the
+ * granularity of a slot: the clone shares the values of the source map and both
+ * maps mark their slots as shared; the first map that needs to mutate a value
+ * detaches a private copy through getWritable(). Symbolic values are mutated in
+ * place, so any code that obtains a value in order to modify it must use
+ * getWritable() (the expression evaluator does so for every root it touches);
+ * get() is reserved for read-only access such as comparing states.
+ */
 class ValueMap final : public IHasDbPrint {
+    /// Slots whose value may also be referenced by another ValueMap and
+    /// therefore must be detached before being mutated.
+    std::set<const IR::IDeclaration *> shared;
+
  public:
     std::map<const IR::IDeclaration *, SymbolicValue *> map;
-    ValueMap *clone() const {
+    ValueMap *clone() {
         auto result = new ValueMap();
-        for (auto v : map) result->map.emplace(v.first, v.second->clone());
+        result->map = map;
+        for (auto v : map) {
+            shared.emplace(v.first);
+            result->shared.emplace(v.first);
+        }
         return result;
     }
     ValueMap *filter(std::function<bool(const IR::IDeclaration *, const SymbolicValue *)> filter) {
@@ -86,11 +106,30 @@ class ValueMap final : public IHasDbPrint {
         CHECK_NULL(left);
         CHECK_NULL(right);
         map[left] = right;
+        shared.erase(left);
     }
     SymbolicValue *get(const IR::IDeclaration *left) const {
         CHECK_NULL(left);
         return ::P4::get(map, left);
     }
+    /// Returns the value stored for @left like get(), but detaches it from any
+    /// maps sharing it first, so the caller may mutate the result in place.
+    SymbolicValue *getWritable(const IR::IDeclaration *left) {
+        CHECK_NULL(left);
+        auto *value = ::P4::get(map, left);
+        auto it = shared.find(left);
+        if (value != nullptr && it != shared.end()) {
+            value = value->clone();
+            map[left] = value;
+            shared.erase(it);
+        }
+        return value;
+    }
+    /// Degrades every value in the map to "unknown", detaching slots shared
+    /// with other maps so their values are undisturbed. Externs (including the
+    /// packet) are left alone: they are read-only, and the packet carries the
+    /// stream offset that loop detection relies on.
+    void widen();
 
     void dbprint(std::ostream &out) const {
         bool first = true;
@@ -106,7 +145,12 @@ class ValueMap final : public IHasDbPrint {
         for (auto d : map) {
             auto v = other->get(d.first);
             CHECK_NULL(v);
-            change = change || d.second->merge(v);
+            if (shared.count(d.first)) {
+                if (d.second->equals(v)) continue;
+                change = change || getWritable(d.first)->merge(v);
+            } else {
+                change = change || d.second->merge(v);
+            }
         }
         return change;
     }
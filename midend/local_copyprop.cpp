@@ -72,7 +72,7 @@ class DoLocalCopyPropagation::ElimDead : public Transform {
      * of the block, so it only removes those vars declared in the block */
     DoLocalCopyPropagation &self;
     const IR::Node *preorder(IR::Declaration_Variable *var) override {
-        if (auto local = ::P4::getref(self.available, var->name)) {
+        if (auto local = ::P4::getref(self.available.ro(), var->name)) {
             if (local->local && !local->live) {
                 LOG3("  removing dead local " << var->name);
                 return nullptr;
@@ -82,7 +82,7 @@ class DoLocalCopyPropagation::ElimDead : public Transform {
     }
     const IR::Statement *postorder(IR::BaseAssignmentStatement *as) override {
         if (auto dest = lvalue_out(as->left)->to<IR::PathExpression>()) {
-            if (auto var = ::P4::getref(self.available, dest->path->name)) {
+            if (auto var = ::P4::getref(self.available.ro(), dest->path->name)) {
                 if (var->local && !var->live) {
                     LOG3("  removing dead assignment to " << dest->path->name);
                     if (self.hasSideEffects(as->right, getChildContext()))
@@ -187,8 +187,14 @@ void DoLocalCopyPropagation::flow_merge(Visitor &a_) {
     BUG_CHECK(working == a.working, "inconsitent DoLocalCopyPropagation state on merge");
     LOG8("flow_merge " << a.uid << " into " << uid);
     unreachable &= a.unreachable;
-    for (auto &var : available) {
-        if (auto merge = ::P4::getref(a.available, var.first)) {
+    if (available.sharesRepWith(a.available)) {
+        // The branches share the same (copy-on-write) table, so the
+        // entry-wise merge would be an identity; skip it.
+        need_key_rewrite |= a.need_key_rewrite;
+        return;
+    }
+    for (auto &var : available.rw()) {
+        if (auto merge = ::P4::getref(a.available.ro(), var.first)) {
             if (merge->val != var.second.val) {
                 if (var.second.val) {
                     LOG4("    dropping " << var.first << " = " << var.second.val
@@ -220,16 +226,18 @@ bool DoLocalCopyPropagation::operator==(const ControlFlowVisitor &a_) const {
     auto &a = dynamic_cast<const DoLocalCopyPropagation &>(a_);
     BUG_CHECK(working == a.working, "inconsistent DoLocalCopyPropagation state on ==");
     if (unreachable != a.unreachable) return false;
-    auto it = a.available.begin();
-    for (auto &var : available) {
-        if (it == a.available.end()) return false;
-        if (var.first != it->first) return false;
-        if (var.second.local != it->second.local) return false;
-        if (var.second.live != it->second.live) return false;
-        if (var.second.val != it->second.val) return false;
-        ++it;
-    }
-    if (it != a.available.end()) return false;
+    if (!available.sharesRepWith(a.available)) {
+        auto it = a.available.ro().begin();
+        for (auto &var : available.ro()) {
+            if (it == a.available.ro().end()) return false;
+            if (var.first != it->first) return false;
+            if (var.second.local != it->second.local) return false;
+            if (var.second.live != it->second.live) return false;
+            if (var.second.val != it->second.val) return false;
+            ++it;
+        }
+        if (it != a.available.ro().end()) return false;
+    }
     if (need_key_rewrite != a.need_key_rewrite) return false;
     return true;
 }
@@ -256,12 +264,13 @@ bool DoLocalCopyPropagation::isHeaderUnionIsValid(const IR::Expression *e) {
 
 void DoLocalCopyPropagation::forOverlapAvail(cstring name,
                                              std::function<void(cstring, VarInfo *)> fn) {
+    auto &avail = available.rw();
     for (const char *pfx = name.c_str(); *pfx; pfx += strspn(pfx, ".[")) {
         pfx += strcspn(pfx, ".[");
-        auto it = available.find(name.before(pfx));
-        if (it != available.end()) fn(it->first, &it->second);
+        auto it = avail.find(name.before(pfx));
+        if (it != avail.end()) fn(it->first, &it->second);
     }
-    for (auto it = available.upper_bound(name); it != available.end(); ++it) {
+    for (auto it = avail.upper_bound(name); it != avail.end(); ++it) {
         if (!it->first.startsWith(name) || !strchr(".[", it->first.get(name.size()))) break;
         fn(it->first, &it->second);
     }
@@ -269,7 +278,7 @@ void DoLocalCopyPropagation::forOverlapAvail(cstring name,
 
 void DoLocalCopyPropagation::dropValuesUsing(cstring name) {
     LOG6("dropValuesUsing(" << name << ")");
-    for (auto &var : available) {
+    for (auto &var : available.rw()) {
         LOG7("  checking " << var.first << " = " << var.second.val);
         if (name_overlap(var.first, name)) {
             LOG4("   dropping " << (var.second.val ? "" : "(nop) ") << "as " << name
@@ -285,7 +294,7 @@ void DoLocalCopyPropagation::dropValuesUsing(cstring name) {
 
 void DoLocalCopyPropagation::visit_local_decl(const IR::Declaration_Variable *var) {
     LOG4("Visiting " << var);
-    auto [it, inserted] = available.emplace(var->name, VarInfo());
+    auto [it, inserted] = available.rw().emplace(var->name, VarInfo());
     BUG_CHECK(inserted, "duplicate var declaration for %s", var->name);
     auto &local = it->second;
     local.local = true;
@@ -340,7 +349,7 @@ const IR::Expression *DoLocalCopyPropagation::copyprop_name(cstring name,
         }
         return nullptr;
     }
-    if (auto var = ::P4::getref(available, name)) {
+    if (auto var = ::P4::getref(available.rw(), name)) {
         if (var->val) {
             if (policy(getChildContext(), var->val, this)) {
                 LOG3("  propagating value for " << name << ": " << var->val);
@@ -433,7 +442,7 @@ IR::AssignmentStatement *DoLocalCopyPropagation::postorder(IR::AssignmentStateme
                 return as;
             }
             LOG3("  saving value for " << dest << ": " << as->right);
-            available[dest].val = as->right;
+            available.rw()[dest].val = as->right;
         } else {
             LOG3("Can't copyprop " << as->right << " due to side effects");
         }
@@ -590,7 +599,7 @@ IR::MethodCallExpression *DoLocalCopyPropagation::postorder(IR::MethodCallExpres
         }
     }
     LOG3("unknown method call " << mc->method << " clears all nonlocal saved values");
-    for (auto &var : available) {
+    for (auto &var : available.rw()) {
         if (!var.second.local) {
             LOG7("    may access non-local " << var.first);
             var.second.val = nullptr;
@@ -669,7 +678,7 @@ void DoLocalCopyPropagation::LoopPrepass::postorder(const IR::MethodCallExpressi
         }
     }
     LOG3("loop prepass unknown method call " << mc->method << " clears all nonlocal saved values");
-    for (auto &var : self.available) {
+    for (auto &var : self.available.rw()) {
         if (!var.second.local) {
             LOG7("    may access non-local " << var.first);
             var.second.val = nullptr;
@@ -77,7 +77,32 @@ class DoLocalCopyPropagation : public ControlFlowVisitor,
         /// values on the left and the right side, the assignment becomes a self-assignment
         bool is_first_write_insert = false;
     };
-    std::map<cstring, VarInfo> available;
+    /** Table of variables with available values, shared copy-on-write between
+     * the visitor clones made at control-flow splits: cloning costs O(1) and
+     * joins of branches that did not touch the table merge by representation
+     * identity instead of walking every entry. Mutators must go through rw(),
+     * which detaches a shared representation first.
+     */
+    class AvailableMap {
+        using Rep = std::map<cstring, VarInfo>;
+        std::shared_ptr<Rep> rep = std::make_shared<Rep>();
+
+     public:
+        const Rep &ro() const { return *rep; }
+        Rep &rw() {
+            if (rep.use_count() > 1) rep = std::make_shared<Rep>(*rep);
+            return *rep;
+        }
+        bool sharesRepWith(const AvailableMap &other) const { return rep == other.rep; }
+        bool empty() const { return rep->empty(); }
+        void clear() {
+            if (rep.use_count() > 1)
+                rep = std::make_shared<Rep>();
+            else
+                rep->clear();
+        }
+    };
+    AvailableMap available;
     std::shared_ptr<std::map<cstring, TableInfo>> tables;
     std::shared_ptr<std::map<cstring, FuncInfo>> actions;
     std::shared_ptr<std::map<cstring, FuncInfo>> methods;
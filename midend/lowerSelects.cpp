@@ -0,0 +1,82 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lowerSelects.h"
+
+#include "singleArgumentSelect.h"
+
+namespace P4 {
+
+/// Cast boolean values to bit<1> values, but only at the top level.  This is the same rewrite as
+/// DoRemoveSelectBooleans::addToplevelCasts; it runs on the original, type-checked expressions,
+/// before the single-argument conversion introduces nodes the type map does not know about.
+const IR::Expression *DoLowerSelects::lowerBooleans(const IR::Expression *expression) {
+    if (auto list = expression->to<IR::ListExpression>()) {
+        IR::Vector<IR::Expression> vec;
+        bool changes = false;
+        for (auto e : list->components) {
+            auto type = typeMap->getType(e, true);
+            if (type->is<IR::Type_Boolean>()) {
+                changes = true;
+                vec.push_back(new IR::Cast(IR::Type_Bits::get(1), e));
+            } else {
+                vec.push_back(e);
+            }
+        }
+        if (changes) return new IR::ListExpression(expression->srcInfo, vec);
+        return expression;
+    }
+    auto type = typeMap->getType(expression, true);
+    if (type->is<IR::Type_Boolean>())
+        expression = new IR::Cast(IR::Type_Bits::get(1), expression);
+    return expression;
+}
+
+bool DoLowerSelects::preorder(IR::SelectExpression *expression) {
+    auto type = typeMap->getType(expression->select, true);
+    // Derive the lowered component types once; the keysets are converted against these.
+    auto tt = type->checkedTo<IR::Type_List>();
+    IR::Vector<IR::Type> lowered;
+    for (auto t : tt->components) {
+        if (t->is<IR::Type_Boolean>()) {
+            lowered.push_back(IR::Type_Bits::get(1));
+        } else if (t->is<IR::Type_Bits>()) {
+            lowered.push_back(t);
+        } else {
+            ::P4::error(ErrorType::ERR_UNSUPPORTED,
+                        "%1%: expression type %2% not supported in select expression",
+                        expression->select, t);
+            lowered.push_back(t);
+        }
+    }
+    selectListType = new IR::Type_List(std::move(lowered));
+
+    auto select = lowerBooleans(expression->select);
+    auto conv = DoSingleArgumentSelect::convertList(select, selectListType);
+    auto list = new IR::ListExpression(IR::Vector<IR::Expression>());
+    list->push_back(conv);
+    expression->select = list;
+    return true;
+}
+
+bool DoLowerSelects::preorder(IR::SelectCase *selCase) {
+    // Range and Mask expressions cannot be applied to booleans, so top-level casts suffice.
+    auto keyset = lowerBooleans(selCase->keyset);
+    selCase->keyset = DoSingleArgumentSelect::convertList(keyset, selectListType);
+    return false;
+}
+
+}  // namespace P4
@@ -0,0 +1,66 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MIDEND_LOWERSELECTS_H_
+#define MIDEND_LOWERSELECTS_H_
+
+#include "frontends/p4/typeChecking/typeChecker.h"
+#include "frontends/p4/typeMap.h"
+#include "ir/ir.h"
+
+namespace P4 {
+
+/**
+   Lowers select expressions in a single traversal, combining the rewrites of
+   DoRemoveSelectBooleans and DoSingleArgumentSelect: boolean components are cast to bit<1> and
+   the component list is folded into one concatenated argument (with a concatenated mask if any
+   keyset uses one).  Each select and each keyset is rebuilt exactly once, and no type checking
+   is needed between the two rewrites because the lowered component types are derived up front.
+   The result is the same as running RemoveSelectBooleans followed by SingleArgumentSelect.
+   @pre This should be run after SimplifySelectList, so select arguments are scalar values of
+   type Type_Bits or Type_Boolean.
+*/
+class DoLowerSelects : public Modifier {
+    const P4::TypeMap *typeMap;
+    /// Component types of the enclosing select with booleans lowered to bit<1>.
+    const IR::Type *selectListType = nullptr;
+
+    const IR::Expression *lowerBooleans(const IR::Expression *expression);
+
+ public:
+    explicit DoLowerSelects(const P4::TypeMap *typeMap) : typeMap(typeMap) {
+        CHECK_NULL(typeMap);
+        setName("DoLowerSelects");
+    }
+
+    bool preorder(IR::SelectExpression *expression) override;
+    bool preorder(IR::SelectCase *selCase) override;
+};
+
+class LowerSelects : public PassManager {
+ public:
+    explicit LowerSelects(TypeMap *typeMap, TypeChecking *typeChecking = nullptr) {
+        if (!typeChecking) typeChecking = new TypeChecking(nullptr, typeMap);
+        passes.push_back(typeChecking);
+        passes.push_back(new DoLowerSelects(typeMap));
+        passes.push_back(new ClearTypeMap(typeMap));  // some types have changed
+        setName("LowerSelects");
+    }
+};
+
+}  // namespace P4
+
+#endif /* MIDEND_LOWERSELECTS_H_ */
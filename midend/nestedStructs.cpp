@@ -7,17 +7,11 @@ namespace P4 {
 using namespace literals;
 
 bool ComplexValues::isNestedStruct(const IR::Type *type) const {
-    if (!type->is<IR::Type_Struct>()) return false;
     auto st = type->to<IR::Type_Struct>();
-    for (const auto *f : st->fields) {
-        auto ftype = typeMap->getType(f, true);
-        if (ftype->is<IR::Type_StructLike>() || ftype->is<IR::Type_Tuple>() ||
-            ftype->is<IR::Type_Array>()) {
-            LOG3("Type " << dbp(type) << " is nested");
-            return true;
-        }
-    }
-    return false;
+    if (st == nullptr) return false;
+    if (!layouts.get(st)->nested) return false;
+    LOG3("Type " << dbp(type) << " is nested");
+    return true;
 }
 
 template <class T>
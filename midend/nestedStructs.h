@@ -20,6 +20,7 @@ limitations under the License.
 #include "frontends/common/resolveReferences/resolveReferences.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
+#include "structLayout.h"
 
 namespace P4 {
 
@@ -73,8 +74,12 @@ class ComplexValues final {
 
     TypeMap *typeMap;
     NameGenerator &nameGen;
+    /// Caches which struct types are nested; isNestedStruct is queried
+    /// repeatedly for the same types while exploding declarations.
+    mutable StructLayoutCache layouts;
 
-    ComplexValues(TypeMap *typeMap, NameGenerator &nameGen) : typeMap(typeMap), nameGen(nameGen) {
+    ComplexValues(TypeMap *typeMap, NameGenerator &nameGen)
+        : typeMap(typeMap), nameGen(nameGen), layouts(typeMap) {
         CHECK_NULL(typeMap);
     }
     /// Helper function that test if a struct is nested
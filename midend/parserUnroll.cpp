@@ -7,6 +7,8 @@
 
 namespace P4 {
 
+unsigned ParserStructure::symbolicValueBudget = 0;
+
 StackVariable::StackVariable(const IR::Expression *expr) : variable(expr) {
     CHECK_NULL(expr);
     BUG_CHECK(repOk(expr), "Invalid stack variable %1%", expr);
@@ -362,7 +364,16 @@ class ParserSymbolicInterpreter {
     ParserInfo *synthesizedParser;  // output produced
     bool unroll;
     StatesVisitedMap visitedStates;
+    /// For every visited (state, header stack indexes) key, fingerprints of
+    /// the value maps the state has already been evaluated with. Paths that
+    /// reconverge on an identical configuration would regenerate the same
+    /// successor states, so run() cuts them off instead of re-executing them.
+    std::map<VisitedKey, std::unordered_set<cstring>> evaluatedConfigs;
     bool &wasError;
+    /// Allocation count at construction; the symbolic value budget, if any,
+    /// is charged against allocations made while unrolling this parser.
+    unsigned startAllocations;
+    bool budgetExceeded = false;
 
     ValueMap *initializeVariables() {
         wasError = false;
@@ -407,8 +418,20 @@ class ParserSymbolicInterpreter {
         if (stateName == IR::ParserState::accept || stateName == IR::ParserState::reject)
             return nullptr;
         auto state = structure->get(stateName);
-        auto pi =
-            new ParserStateInfo(stateName, parser, state, predecessor, values->clone(), index);
+        auto before = values->clone();
+        if (auto budget = ParserStructure::getSymbolicValueBudget()) {
+            if (SymbolicValue::getAllocatedCount() - startAllocations > budget) {
+                if (!budgetExceeded) {
+                    budgetExceeded = true;
+                    ::P4::warning(ErrorType::WARN_INVALID,
+                                  "%1%: symbolic value budget exceeded while unrolling; "
+                                  "continuing with widened values",
+                                  parser);
+                }
+                before->widen();
+            }
+        }
+        auto pi = new ParserStateInfo(stateName, parser, state, predecessor, before, index);
         synthesizedParser->add(pi);
         return pi;
     }
@@ -708,6 +731,17 @@ class ParserSymbolicInterpreter {
         return false;
     }
 
+    /// A textual fingerprint of the symbolic values flowing into a state;
+    /// together with the state name and the header stack indexes it
+    /// identifies an evaluation configuration completely. The rendering is
+    /// canonical because the value map is ordered by declaration and the
+    /// declarations are shared across all states of a parser.
+    static cstring valueMapFingerprint(const ValueMap *values) {
+        std::stringstream repr;
+        values->dbprint(repr);
+        return repr.str();
+    }
+
     /// Gets new name for a state
     IR::ID getNewName(ParserStateInfo *state) {
         if (state->currentIndex == 0) {
@@ -772,7 +806,8 @@ class ParserSymbolicInterpreter {
           typeMap(typeMap),
           synthesizedParser(nullptr),
           unroll(unroll),
-          wasError(wasError) {
+          wasError(wasError),
+          startAllocations(SymbolicValue::getAllocatedCount()) {
         CHECK_NULL(structure);
         CHECK_NULL(refMap);
         CHECK_NULL(typeMap);
@@ -844,6 +879,15 @@ class ParserSymbolicInterpreter {
             }
             IR::ID newName = getNewName(stateInfo);
             bool notAdded = newStates.count(newName) == 0;
+            // If this state was already evaluated with exactly the same
+            // symbolic inputs it produces the same successors, which are
+            // already on the worklist or explored; reconverging paths thus
+            // traverse a DAG instead of re-expanding identical subtrees.
+            auto &seen = evaluatedConfigs[VisitedKey(newName.name, stateInfo->statesIndexes)];
+            if (!seen.insert(valueMapFingerprint(stateInfo->before)).second) {
+                LOG2("Reusing previous evaluation of " << dbp(stateInfo->state));
+                continue;
+            }
             auto nextStates = evaluateState(stateInfo, newStates);
             if (get<0>(nextStates) == nullptr) {
                 if (get<1>(nextStates) && stateInfo->predecessor &&
@@ -143,6 +143,7 @@ class ParserStructure {
     friend class ParserSymbolicInterpreter;
     friend class AnalyzeParser;
     std::map<cstring, const IR::ParserState *> stateMap;
+    static unsigned symbolicValueBudget;
 
  public:
     const IR::P4Parser *parser;
@@ -167,6 +168,14 @@ class ParserStructure {
     /// check reachability for usage of header stack
     bool reachableHSUsage(IR::ID id, const ParserStateInfo *state) const;
 
+    /// Caps the number of symbolic values the symbolic interpreter may allocate
+    /// while unrolling one parser. Once the budget is exceeded, newly created
+    /// states are widened — every value degraded to "unknown" — so evaluation
+    /// converges quickly instead of exhausting memory; loops then get reported
+    /// as not unrollable. 0 (the default) means no limit.
+    static void setSymbolicValueBudget(unsigned values) { symbolicValueBudget = values; }
+    static unsigned getSymbolicValueBudget() { return symbolicValueBudget; }
+
  protected:
     /// evaluates rechable states with HS operations for each path.
     void evaluateReachability();
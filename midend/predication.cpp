@@ -15,7 +15,6 @@ limitations under the License.
 */
 #include "predication.h"
 
-#include "frontends/p4/cloner.h"
 namespace P4 {
 
 namespace Pred {
@@ -75,7 +74,7 @@ void Predication::ExpressionReplacer::setVisitingIndex(bool val) { visitingIndex
 /// Right side of the statement is emplaced into the appropriate part of
 /// the Mux expression, according to the IF/ELSE branch currently visited
 void Predication::ExpressionReplacer::emplaceExpression(IR::Mux *mux) {
-    auto condition = conditions[conditions.size() - currentNestingLevel];
+    auto condition = conditions[currentNestingLevel - 1];
     bool thenElsePass = traversalPath[currentNestingLevel - 1];
     mux->e0 = condition;
     if (thenElsePass) {
@@ -88,7 +87,7 @@ void Predication::ExpressionReplacer::emplaceExpression(IR::Mux *mux) {
 /// Here "visit" is recursively called on nested Mux expressions,
 /// according to the current nesting level and also the structure of the 'mux' variable
 void Predication::ExpressionReplacer::visitBranch(IR::Mux *mux, bool then) {
-    auto condition = conditions[conditions.size() - currentNestingLevel - 1];
+    auto condition = conditions[currentNestingLevel];
     auto leftName = Pred::lvalueName(statement->left);
     auto thenExprName = Pred::lvalueName(mux->e1);
     auto elseExprName = Pred::lvalueName(mux->e2);
@@ -139,8 +138,9 @@ const IR::Expression *Predication::clone(const IR::Expression *expression) {
     // Expressions often need to be cloned. This is necessary because
     // in the end different code will be generated for the different clones of
     // an expression. This is most obvious if one clone is on the LHS and one
-    // on the RHS of an assigment.
-    CloneExpressions cloner;
+    // on the RHS of an assigment. Conditions are never written to, though, so
+    // the cloner shares them between all the Mux expressions that test them.
+    ExpressionCloner cloner;
     cloner.setCalledBy(this);
     return expression->apply(cloner);
 }
@@ -149,7 +149,7 @@ const IR::AssignmentStatement *Predication::clone(const IR::AssignmentStatement
     // Expressions often need to be cloned. This is necessary because
     // in the end different code will be generated for the different clones of
     // an expression.
-    CloneExpressions cloner;
+    ExpressionCloner cloner;
     cloner.setCalledBy(this);
     return statement->apply(cloner)->to<IR::AssignmentStatement>();
 }
@@ -160,11 +160,6 @@ const IR::Node *Predication::preorder(IR::AssignmentStatement *statement) {
         return statement;
     }
     LOG1("In preorder for statement: " << *statement);
-    const Context *ctxt = nullptr;
-    std::vector<const IR::Expression *> conditions;
-    while (auto ifs = findContext<IR::IfStatement>(ctxt)) {
-        conditions.push_back(ifs->condition);
-    }
     // Checks to see if index modification is needed
     if (statement->left->is<IR::Member>() || statement->left->is<IR::ArrayIndex>()) {
         modifyIndex = true;
@@ -172,7 +167,7 @@ const IR::Node *Predication::preorder(IR::AssignmentStatement *statement) {
         modifyIndex = false;
     }
     // The expressionReplacer responsible for transforming this statement
-    ExpressionReplacer replacer(clone(statement), traversalPath, conditions);
+    ExpressionReplacer replacer(clone(statement), traversalPath, conditionStack);
     replacer.setCalledBy(this);
     dependencies.clear();
     visit(statement->right);
@@ -201,7 +196,7 @@ const IR::Node *Predication::preorder(IR::AssignmentStatement *statement) {
     // Push liveAssignments in liveAssigns in adequate order
     // If current statement is dependent, it should be pushed on liveAssigns.
     if (depNestingLevel < ifNestingLevel && isStatementDependent[statementName]) {
-        statement->right = new IR::Mux(conditions.back(), statement->right, statement->left);
+        statement->right = new IR::Mux(conditionStack.front(), statement->right, statement->left);
         if (!traversalPath[ifNestingLevel - 1]) {
             // change statement name, if the current branch is the 'else' branch
             statementName = generator.newName("elseStatement");
@@ -214,7 +209,7 @@ const IR::Node *Predication::preorder(IR::AssignmentStatement *statement) {
             statement->right = foundAssignment->second->right;
         } else if (!statement->right->is<IR::Mux>()) {
             auto clonedLeft = clone(statement->left);
-            statement->right = new IR::Mux(conditions.back(), clonedLeft, clonedLeft);
+            statement->right = new IR::Mux(conditionStack.front(), clonedLeft, clonedLeft);
         }
         // Remove statement for 'then' if there is a statement
         // with the same statement name in the else branch.
@@ -258,12 +253,6 @@ const IR::Node *Predication::preorder(IR::Member *member) {
 }
 const IR::Node *Predication::preorder(IR::ArrayIndex *arrInd) {
     visit(arrInd->left);
-    // Collect conditions from IF-ELSE blocks surrounding this ArrayIndex
-    const Context *ctxt = nullptr;
-    std::vector<const IR::Expression *> conditions;
-    while (auto ifs = findContext<IR::IfStatement>(ctxt)) {
-        conditions.push_back(ifs->condition);
-    }
     // The index modification isn't necessary if the index is a Constant
     if (!(arrInd->right->is<IR::Constant>()) && modifyIndex) {
         // Creates a new variable that has the value of the original index when the
@@ -272,12 +261,12 @@ const IR::Node *Predication::preorder(IR::ArrayIndex *arrInd) {
         auto indexDecl = new IR::Declaration_Variable(indexName, arrInd->right->type->getP4Type());
         auto index = new IR::PathExpression(IR::ID(indexName));
         auto indexAssignment = new IR::AssignmentStatement(index, clone(arrInd->right));
-        ExpressionReplacer replacer(clone(indexAssignment), traversalPath, conditions);
+        ExpressionReplacer replacer(clone(indexAssignment), traversalPath, conditionStack);
         // Creates the initial Mux expression
         replacer.setVisitingIndex(true);
-        indexAssignment->right =
-            new IR::Mux(conditions.back(), new IR::Constant(arrInd->right->type->getP4Type(), 0),
-                        new IR::Constant(arrInd->right->type->getP4Type(), 0));
+        indexAssignment->right = new IR::Mux(conditionStack.front(),
+                                             new IR::Constant(arrInd->right->type->getP4Type(), 0),
+                                             new IR::Constant(arrInd->right->type->getP4Type(), 0));
         // Applies the replacer and adds the declaration and assignment to vectors
         indexDeclarations.push_back(indexDecl);
         liveAssignments[indexName] = new IR::AssignmentStatement(
@@ -312,6 +301,7 @@ const IR::Node *Predication::preorder(IR::IfStatement *statement) {
         statement->condition = condition;  // replace with variable cond
     }
     // Visit the IF block of this IF-ELSE statement
+    conditionStack.push_back(statement->condition);
     traversalPath.push_back(true);
     visit(statement->ifTrue);
     LOG1("Finished visiting IF block");
@@ -337,6 +327,7 @@ const IR::Node *Predication::preorder(IR::IfStatement *statement) {
     liveAssigns.clear();
     liveAssignments.clear();
     traversalPath.pop_back();
+    conditionStack.pop_back();
     LOG1("Finished visiting IF statement on level: " << ifNestingLevel);
     --ifNestingLevel;
     prune();
@@ -17,6 +17,7 @@ limitations under the License.
 #ifndef MIDEND_PREDICATION_H_
 #define MIDEND_PREDICATION_H_
 
+#include "frontends/p4/cloner.h"
 #include "frontends/p4/typeChecking/typeChecker.h"
 #include "ir/ir.h"
 
@@ -48,6 +49,21 @@ class Predication final : public Transform {
         const IR::Node *postorder(IR::EmptyStatement *statement) override;
         const IR::Node *postorder(IR::BlockStatement *statement) override;
     };
+    /**
+     * Private cloner only for the Predication pass.
+     * Clones like CloneExpressions, but shares Mux predicates instead of
+     * cloning them: each unique condition is cloned (or aliased) once when its
+     * if statement is entered and is read-only afterwards, so re-cloning it in
+     * every assignment only duplicated the condition once per nesting level.
+     */
+    class ExpressionCloner final : public CloneExpressions {
+        const IR::Node *preorder(IR::Mux *mux) override {
+            visit(mux->e1, "e1");
+            visit(mux->e2, "e2");
+            prune();
+            return mux;
+        }
+    };
     /**
      * Private Transformer only for Predication pass.
      * This pass operates on nested Mux expressions(?:).
@@ -61,16 +77,16 @@ class Predication final : public Transform {
         // To keep track of the path used while traversing nested if-else statements:
         //      IF - true / ELSE - false
         const std::vector<bool> &traversalPath;
-        // To store the condition used in every if-else statement
-        std::vector<const IR::Expression *> &conditions;
+        // The conditions of the enclosing if-else statements, outermost first
+        const std::vector<const IR::Expression *> &conditions;
         // Nesting level of Mux expressions
         unsigned currentNestingLevel = 0;
         // An indicator used to implement the logic for ArrayIndex transformation
         bool visitingIndex = false;
 
      public:
-        explicit ExpressionReplacer(const IR::AssignmentStatement *a, std::vector<bool> &t,
-                                    std::vector<const IR::Expression *> &c)
+        explicit ExpressionReplacer(const IR::AssignmentStatement *a, const std::vector<bool> &t,
+                                    const std::vector<const IR::Expression *> &c)
             : statement(a), traversalPath(t), conditions(c) {
             CHECK_NULL(a);
         }
@@ -98,6 +114,10 @@ class Predication final : public Transform {
     // Traverse path of nested if-else statements.
     // Size of this vector is the current IF nesting level. IF - true / ELSE - false
     std::vector<bool> traversalPath;
+    // The (possibly aliased) conditions of the enclosing if-else statements,
+    // outermost first. Maintained by preorder(IfStatement) so that every
+    // assignment can reuse it instead of re-walking the visitor context chain.
+    std::vector<const IR::Expression *> conditionStack;
     std::vector<cstring> dependencies;
     // Collects assignment statements with transformed right expression.
     // liveAssignments are pushed at the back of liveAssigns vector.
@@ -32,13 +32,14 @@ namespace P4 {
  * @pre none
  * @post no field slice operator in the lhs of assignment statement
  */
-class DoRemoveLeftSlices : public Transform {
+class DoRemoveLeftSlices final : public Transform {
     P4::TypeMap *typeMap;
 
  public:
     explicit DoRemoveLeftSlices(P4::TypeMap *typeMap) : typeMap(typeMap) {
         CHECK_NULL(typeMap);
         setName("DoRemoveLeftSlices");
+        dispatchOnly<IR::AssignmentStatement>();
     }
     const IR::Node *postorder(IR::AssignmentStatement *stat) override;
 };
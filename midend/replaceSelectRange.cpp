@@ -20,9 +20,45 @@
 
 namespace P4 {
 
+const ReplaceSelectRange::MaskCover &ReplaceSelectRange::maskCover(const big_int &min,
+                                                                   const big_int &max, int width) {
+    auto [it, inserted] = covers.try_emplace(std::make_tuple(min, max, width));
+    if (!inserted) return it->second;
+
+    auto &cover = it->second;
+    big_int size_mask = ((((big_int)1) << width) - 1);
+    big_int lo = min;
+    big_int range_size_remaining = max - lo + 1;
+
+    while (range_size_remaining > 0) {
+        // this generates two kinds of mask entries
+        // - 0..2^N - 1 where N is the largest number such that this does not
+        //              overshoot max -- to cover all numbers lower then 2^N - 1
+        //              with one mask entry.
+        // - M..M+2^N - 1 to cover remaining entries with masks that fix a bit
+        //                prefix and leave the last N bits arbitrary.
+        // Each entry is the largest power-of-two aligned block that starts at
+        // the first uncovered value and stays within the range; since any
+        // aligned block containing that value and staying within the range
+        // must start there, no cover made of aligned blocks can use fewer
+        // entries.
+        big_int match_stride = ((big_int)1) << ((lo == 0) ? floor_log2(max + 1) : ffs(lo));
+
+        while (match_stride > range_size_remaining) match_stride >>= 1;
+
+        big_int mask = ~(match_stride - 1) & size_mask;
+        cover.emplace_back(lo, mask);
+
+        range_size_remaining -= match_stride;
+        lo += match_stride;
+    }
+
+    return cover;
+}
+
 // expands subranges that do not cross over zero
-static void expandRange(const IR::Range *r, std::vector<const IR::Mask *> *masks,
-                        const IR::Type *maskType, big_int min, big_int max) {
+void ReplaceSelectRange::expandRange(const IR::Range *r, std::vector<const IR::Mask *> *masks,
+                                     const IR::Type *maskType, big_int min, big_int max) {
     int width = r->type->width_bits();
     BUG_CHECK(width > 0, "zero-width range is not allowed %1%", r->type);
     big_int size_mask = ((((big_int)1) << width) - 1);
@@ -37,27 +73,10 @@ static void expandRange(const IR::Range *r, std::vector<const IR::Mask *> *masks
 
     BUG_CHECK(min <= max, "range bounds inverted %1%..%2%", min, max);
 
-    big_int range_size_remaining = max - min + 1;
-
-    while (range_size_remaining > 0) {
-        // this generates two kinds of mask entries
-        // - 0..2^N - 1 where N is the largest number such that this does not
-        //              overshoot max -- to cover all numbers lower then 2^N - 1
-        //              with one mask entry.
-        // - M..M+2^N - 1 to cover remaining entries with masks that fix a bit
-        //                prefix and leave the last N bits arbitrary.
-        big_int match_stride = ((big_int)1) << ((min == 0) ? floor_log2(max + 1) : ffs(min));
-
-        while (match_stride > range_size_remaining) match_stride >>= 1;
-
-        big_int mask = ~(match_stride - 1) & size_mask;
-
-        auto valConst = new IR::Constant(maskType, min, base, true);
+    for (const auto &[value, mask] : maskCover(min, max, width)) {
+        auto valConst = new IR::Constant(maskType, value, base, true);
         auto maskConst = new IR::Constant(maskType, mask, base, true);
         masks->push_back(new IR::Mask(r->srcInfo, valConst, maskConst));
-
-        range_size_remaining -= match_stride;
-        min += match_stride;
     }
 }
 
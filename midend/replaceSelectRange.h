@@ -18,7 +18,10 @@
 #ifndef MIDEND_REPLACESELECTRANGE_H_
 #define MIDEND_REPLACESELECTRANGE_H_
 
+#include <map>
 #include <set>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "ir/ir.h"
@@ -54,6 +57,21 @@ class ReplaceSelectRange : public Transform {
         const std::vector<const IR::Mask *> &masks);
     std::vector<IR::Vector<IR::Expression>> cartesianAppend(
         const std::vector<IR::Vector<IR::Expression>> &vecs, const IR::Expression *e);
+
+    /// A range cover as (value, mask) pairs; stored as plain numbers rather than
+    /// IR nodes so each use can materialize masks with its own source info, base
+    /// and type.
+    using MaskCover = std::vector<std::pair<big_int, big_int>>;
+    /// The minimal aligned-block cover of [min, max] at the given bit width.
+    /// Covers are cached per (min, max, width) triple: generated parsers repeat
+    /// the same ranges across many select cases and states.
+    const MaskCover &maskCover(const big_int &min, const big_int &max, int width);
+
+ private:
+    void expandRange(const IR::Range *r, std::vector<const IR::Mask *> *masks,
+                     const IR::Type *maskType, big_int min, big_int max);
+
+    std::map<std::tuple<big_int, big_int, int>, MaskCover> covers;
 };
 
 }  // namespace P4
@@ -16,8 +16,10 @@ limitations under the License.
 
 #include "simplifySelectCases.h"
 
+#include <algorithm>
+
 #include "frontends/p4/enumInstance.h"
-#include "lib/algorithm.h"
+#include "midend/caseAnalysis.h"
 
 namespace P4 {
 
@@ -88,12 +90,10 @@ const IR::Node *DoSimplifySelectCases::preorder(IR::SelectExpression *expression
     });
     // Remove all duplicated select cases by keyset.
     if (allConst) {
+        CaseLabelIndex seen;
         IR::Vector<IR::SelectCase> tmp;
-        for (auto c : cases) {  // exclude last
-            auto pred = [&](const IR::SelectCase *other) {
-                return c->keyset->equiv(*other->keyset);
-            };
-            if (!contains_if(tmp, pred)) tmp.push_back(c);
+        for (auto c : cases) {
+            if (seen.add(c->keyset)) tmp.push_back(c);
         }
         if (cases.size() != tmp.size()) {
             cases = tmp;
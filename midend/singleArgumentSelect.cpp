@@ -23,8 +23,8 @@ DoSingleArgumentSelect::Pair::Pair(const IR::Expression *e, const IR::Type *type
     }
 }
 
-static const IR::Expression *convertList(const IR::Expression *expression,
-                                         const IR::Type *selectListType) {
+const IR::Expression *DoSingleArgumentSelect::convertList(const IR::Expression *expression,
+                                                          const IR::Type *selectListType) {
     if (expression->is<IR::DefaultExpression>()) {
         int width = selectListType->width_bits();
         auto type = IR::Type_Bits::get(width, false);
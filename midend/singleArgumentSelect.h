@@ -51,6 +51,13 @@ class DoSingleArgumentSelect : public Modifier {
     // of supported types.
     void checkExpressionType(const IR::Expression *expression);
 
+    /// Convert a select argument or keyset @p expression of type @p selectListType into a single
+    /// expression, concatenating the components (and their masks, if any keyset component uses
+    /// one).  Also used by LowerSelects, which performs this conversion as part of its combined
+    /// select rewrite.
+    static const IR::Expression *convertList(const IR::Expression *expression,
+                                             const IR::Type *selectListType);
+
     bool preorder(IR::SelectCase *selCase) override;
     bool preorder(IR::SelectExpression *expression) override;
 };
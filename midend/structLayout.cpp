@@ -0,0 +1,54 @@
+/*
+Copyright 2016 VMware, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "structLayout.h"
+
+namespace P4 {
+
+void StructLayoutCache::flatten(const IR::Type *type, safe_vector<cstring> &prefix,
+                                StructLayout *layout) {
+    if (auto st = type->to<IR::Type_Struct>()) {
+        for (auto f : st->fields) {
+            auto ft = typeMap->getType(f, true);
+            prefix.push_back(f->name.name);
+            flatten(ft, prefix, layout);
+            prefix.pop_back();
+        }
+        return;
+    }
+    if (type->is<IR::Type_StructLike>() || type->is<IR::Type_Tuple>() || type->is<IR::Type_Array>())
+        layout->onlyScalars = false;
+    layout->fields.push_back(FlatField{prefix, type, type->width_bits()});
+}
+
+const StructLayout *StructLayoutCache::get(const IR::Type_StructLike *type) {
+    auto it = layouts.find(type);
+    if (it != layouts.end()) return it->second;
+    auto layout = new StructLayout();
+    safe_vector<cstring> prefix;
+    for (auto f : type->fields) {
+        auto ft = typeMap->getType(f, true);
+        if (ft->is<IR::Type_StructLike>() || ft->is<IR::Type_Tuple>() || ft->is<IR::Type_Array>())
+            layout->nested = true;
+        prefix.push_back(f->name.name);
+        flatten(ft, prefix, layout);
+        prefix.pop_back();
+    }
+    layouts.emplace(type, layout);
+    return layout;
+}
+
+}  // namespace P4
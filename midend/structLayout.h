@@ -0,0 +1,79 @@
+/*
+Copyright 2016 VMware, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MIDEND_STRUCTLAYOUT_H_
+#define MIDEND_STRUCTLAYOUT_H_
+
+#include "frontends/p4/typeMap.h"
+#include "ir/ir.h"
+#include "lib/cstring.h"
+
+namespace P4 {
+
+/// One leaf of a flattened struct-like type: the chain of field names
+/// leading to it from the root, its canonical type, and its width in bits
+/// (0 for types without a fixed width, such as varbits).
+struct FlatField {
+    safe_vector<cstring> path;
+    const IR::Type *type;
+    int width;
+
+    /// Builds the expression root.f1.f2...fn selecting this leaf.
+    const IR::Expression *makeMember(const IR::Expression *root) const {
+        const IR::Expression *result = root;
+        for (auto name : path) result = new IR::Member(result, IR::ID(name));
+        return result;
+    }
+};
+
+/// The flattened field layout of a struct-like type.
+struct StructLayout {
+    /// Leaves in declaration order.  Flattening recurses through nested
+    /// structs only; headers, header unions, stacks and tuples are kept as
+    /// leaves, since they cannot be copied field-by-field without extra
+    /// handling (validity bits, stack indexing).
+    safe_vector<FlatField> fields;
+    /// True if any immediate field is itself a struct-like, tuple or stack
+    /// type, i.e., the type needs flattening at all.
+    bool nested = false;
+    /// True if every leaf is a scalar: the type is a tree of structs whose
+    /// leaves can be copied with plain assignments.
+    bool onlyScalars = true;
+};
+
+/**
+ * Computes and caches the flattened field layout of struct-like types, so
+ * that the passes lowering struct operations (CopyStructures,
+ * FlattenHeaders, NestedStructs) do O(fields) work per query instead of
+ * re-deriving the flattening through the TypeMap each time.  Layouts are
+ * keyed by the queried type node, so a cache must not be reused across a
+ * pass that replaces the type declarations.
+ */
+class StructLayoutCache {
+    const TypeMap *typeMap;
+    std::map<const IR::Type *, const StructLayout *> layouts;
+
+    void flatten(const IR::Type *type, safe_vector<cstring> &prefix, StructLayout *layout);
+
+ public:
+    explicit StructLayoutCache(const TypeMap *typeMap) : typeMap(typeMap) { CHECK_NULL(typeMap); }
+    /// The layout for @type; computed on first use.
+    const StructLayout *get(const IR::Type_StructLike *type);
+};
+
+}  // namespace P4
+
+#endif /* MIDEND_STRUCTLAYOUT_H_ */
@@ -130,6 +130,43 @@ class ReplaceIndexRefs : public Transform, P4WriteContext {
     ReplaceIndexRefs(cstring iv, long v) : indexVar(iv), value(v) { forceClone = true; }
 };
 
+/* check whether a subtree contains any reference to a given name */
+class UsesName : public Inspector {
+    cstring name;
+
+    bool preorder(const IR::PathExpression *pe) override {
+        if (pe->path->name == name) found = true;
+        return false;
+    }
+    bool preorder(const IR::Node *) override { return !found; }
+
+ public:
+    bool found = false;
+    explicit UsesName(cstring n) : name(n) {}
+};
+
+unsigned UnrollLoops::growthBudget = 0;
+
+bool UnrollLoops::withinGrowthBudget(const IR::LoopStatement *loop, const loop_bounds_t &bounds) {
+    if (growthBudget == 0) return true;
+    // An explicit request to unroll wins over the budget.
+    if (loop->hasAnnotation("unroll"_cs)) return true;
+    struct CountNodes : Inspector {
+        size_t count = 0;
+        bool preorder(const IR::Node *) override {
+            ++count;
+            return true;
+        }
+    } cn;
+    loop->apply(cn);
+    size_t estimate = cn.count * bounds.indexes.size();
+    if (estimate <= growthBudget) return true;
+    LOG3("Not unrolling loop: estimated growth " << estimate << " exceeds budget " << growthBudget
+                                                 << Log::indent << Log::endl
+                                                 << loop << Log::unindent);
+    return false;
+}
+
 long UnrollLoops::evalLoop(const IR::Expression *exp, long val,
                            const ComputeDefUse::locset_t &idefs, bool &fail) {
     if (fail) return 1;
@@ -275,10 +312,15 @@ const IR::Statement *UnrollLoops::doUnroll(const loop_bounds_t &bounds, const IR
     if (rbc.breakFlag) rv->append(rbc.breakFlag);
     if (rbc.continueFlag) rv->append(rbc.continueFlag);
     if (rbc.breakFlag) rv->append(setFlag(rbc.breakFlag->name, false));
+    // If the body never mentions the index variable, every unrolled copy is
+    // identical: append the same (immutable) subtree for each iteration
+    // instead of deep-cloning it once per iteration.
+    UsesName usesIndex(bounds.index->name);
+    body->apply(usesIndex);
     IR::BlockStatement *blk = rv;
     for (long indexval : bounds.indexes) {
         ReplaceIndexRefs rir(bounds.index->name, indexval);
-        blk->append(body->apply(rir));
+        blk->append(usesIndex.found ? body->apply(rir) : body);
         if (rbc.breakFlag) {
             auto newblk = new IR::BlockStatement;
             auto cond = new IR::LNot(new IR::PathExpression(rbc.breakFlag->name));
@@ -299,7 +341,7 @@ const IR::Statement *UnrollLoops::doUnroll(const loop_bounds_t &bounds, const IR
 const IR::Statement *UnrollLoops::preorder(IR::ForStatement *fstmt) {
     loop_bounds_t bounds;
     bool canUnroll = findLoopBounds(fstmt, bounds);
-    bool shouldUnroll = policy(fstmt, canUnroll, bounds);
+    bool shouldUnroll = policy(fstmt, canUnroll, bounds) && withinGrowthBudget(fstmt, bounds);
     if (canUnroll && shouldUnroll) {
         LOG3("Unrolling loop" << Log::indent << Log::endl << fstmt << Log::unindent);
         auto *rv = new IR::BlockStatement;
@@ -314,7 +356,7 @@ const IR::Statement *UnrollLoops::preorder(IR::ForStatement *fstmt) {
 const IR::Statement *UnrollLoops::preorder(IR::ForInStatement *fstmt) {
     loop_bounds_t bounds;
     bool canUnroll = findLoopBounds(fstmt, bounds);
-    bool shouldUnroll = policy(fstmt, canUnroll, bounds);
+    bool shouldUnroll = policy(fstmt, canUnroll, bounds) && withinGrowthBudget(fstmt, bounds);
     if (canUnroll && shouldUnroll) {
         LOG3("Unrolling loop" << Log::indent << Log::endl << fstmt << Log::unindent);
         auto rv = doUnroll(bounds, fstmt->body);
@@ -25,8 +25,16 @@ namespace P4 {
 class UnrollLoops : public Transform, public P4::ResolutionContext {
     NameGenerator &nameGen;
     const ComputeDefUse *defUse;
+    /// Upper bound on the estimated number of IR nodes a single unrolled loop
+    /// may expand to.  Loops whose unrolling would exceed the budget are left
+    /// rolled up, unless explicitly annotated @unroll.  0 (the default) means
+    /// no limit.
+    static unsigned growthBudget;
 
  public:
+    static void setGrowthBudget(unsigned nodes) { growthBudget = nodes; }
+    static unsigned getGrowthBudget() { return growthBudget; }
+
     struct loop_bounds_t {
         const IR::Declaration_Variable *index = nullptr;
         std::vector<long> indexes;
@@ -44,6 +52,7 @@ class UnrollLoops : public Transform, public P4::ResolutionContext {
                   bool &);
     bool findLoopBounds(IR::ForStatement *, loop_bounds_t &);
     bool findLoopBounds(IR::ForInStatement *, loop_bounds_t &);
+    bool withinGrowthBudget(const IR::LoopStatement *, const loop_bounds_t &);
     const IR::Statement *doUnroll(const loop_bounds_t &, const IR::Statement *,
                                   const IR::IndexedVector<IR::StatOrDecl> * = nullptr);
 
@@ -0,0 +1,107 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "frontends/common/parseInput.h"
+#include "helpers.h"
+#include "ir/ir.h"
+#include "midend/actionSynthesis.h"
+
+using namespace P4;
+
+namespace P4::Test {
+
+namespace {
+
+// The ingress below repeats the statement 's.g = 64w2;' in three separate
+// groups, so action synthesis creates three structurally equivalent actions
+// unless the policy lets them share one.
+const char *programWithDuplicates = R"(
+struct S {
+    bit<64> f;
+    bit<64> g;
+}
+
+control C(inout S s) {
+    apply {
+        if (s.f == 64w1) {
+            s.g = 64w2;
+        } else {
+            s.g = 64w2;
+        }
+        if (s.f == 64w3) {
+            s.g = 64w2;
+        }
+    }
+}
+
+control proto(inout S s);
+package top(proto p);
+top(C()) main;
+)";
+
+class TestPolicy : public P4::ActionSynthesisPolicy {
+    bool share;
+    bool convert(const Visitor::Context *, const IR::P4Control *) override { return true; }
+    bool can_share(const Visitor::Context *, const IR::P4Control *) override { return share; }
+
+ public:
+    explicit TestPolicy(bool share) : share(share) {}
+};
+
+class CountSynthesizedActions : public Inspector {
+ public:
+    unsigned actions = 0;
+    bool preorder(const IR::P4Action *) override {
+        ++actions;
+        return false;
+    }
+};
+
+unsigned synthesizeAndCount(bool share) {
+    const auto *pgm =
+        P4::parseP4String(programWithDuplicates, CompilerOptions::FrontendVersion::P4_16);
+    EXPECT_TRUE(pgm);
+    EXPECT_EQ(::P4::errorCount(), 0u);
+    if (!pgm) return 0;
+
+    P4::ReferenceMap refMap;
+    P4::TypeMap typeMap;
+    P4::SynthesizeActions synth(&refMap, &typeMap, new TestPolicy(share));
+    const auto *result = pgm->apply(synth);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(::P4::errorCount(), 0u);
+    if (!result) return 0;
+
+    CountSynthesizedActions count;
+    result->apply(count);
+    return count.actions;
+}
+
+}  // namespace
+
+class ActionSynthesisTest : public P4CTest {};
+
+TEST_F(ActionSynthesisTest, NoSharingByDefault) {
+    EXPECT_EQ(synthesizeAndCount(false), 3u);
+}
+
+TEST_F(ActionSynthesisTest, SharesEquivalentBodies) {
+    EXPECT_EQ(synthesizeAndCount(true), 1u);
+}
+
+}  // namespace P4::Test
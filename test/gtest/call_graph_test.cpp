@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <set>
 #include <vector>
 
 #include "frontends/p4/callGraph.h"
@@ -25,13 +26,13 @@ namespace P4::Test {
 template <class T>
 static void sameSet(std::unordered_set<T> &set, std::vector<T> vector) {
     EXPECT_EQ(vector.size(), set.size());
-    for (T v : vector) EXPECT_NEQ(set.end(), set.find(v));
+    for (T v : vector) EXPECT_NE(set.end(), set.find(v));
 }
 
 template <class T>
 static void sameSet(std::set<T> &set, std::vector<T> vector) {
     EXPECT_EQ(vector.size(), set.size());
-    for (T v : vector) EXPECT_NEQ(set.end(), set.find(v));
+    for (T v : vector) EXPECT_NE(set.end(), set.find(v));
 }
 
 TEST(CallGraph, Acyclic) {
@@ -51,4 +52,117 @@ TEST(CallGraph, Acyclic) {
     EXPECT_EQ('a', sorted.at(2));
 }
 
+TEST(CallGraph, MemoizedReachable) {
+    P4::CallGraph<char> cg("memo");
+    // a->b->c  d->e
+    cg.calls('a', 'b');
+    cg.calls('b', 'c');
+    cg.calls('d', 'e');
+
+    std::set<char> reach;
+    cg.reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c'});
+
+    // the memoized answer must reflect subsequent mutations
+    cg.calls('c', 'd');
+    reach.clear();
+    cg.reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c', 'd', 'e'});
+
+    cg.remove('d');
+    reach.clear();
+    cg.reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c'});
+
+    // restricting to the reachable set keeps the graph and the answer stable
+    cg.restrict(reach);
+    EXPECT_EQ(3u, cg.size());
+    reach.clear();
+    cg.reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c'});
+    reach.clear();
+    cg.reachable('b', reach);
+    sameSet(reach, {'b', 'c'});
+}
+
+TEST(CallGraph, Restrict) {
+    P4::CallGraph<char> cg("restrict");
+    // a->b->c, b->d->c, e->b
+    cg.calls('a', 'b');
+    cg.calls('b', 'c');
+    cg.calls('b', 'd');
+    cg.calls('d', 'c');
+    cg.calls('e', 'b');
+
+    cg.restrict({'a', 'b', 'c'});
+    EXPECT_EQ(3u, cg.size());
+    EXPECT_TRUE(cg.isCaller('a'));
+    EXPECT_FALSE(cg.isCallee('a'));
+    EXPECT_TRUE(cg.isCallee('c'));
+    EXPECT_EQ(std::vector<char>{'c'}, *cg.getCallees('b'));
+    EXPECT_EQ(std::vector<char>{'a'}, *cg.getCallers('b'));
+
+    std::set<char> reach;
+    cg.reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c'});
+}
+
+TEST(CallGraph, CompiledAcyclic) {
+    P4::CallGraph<char> acyclic("acyclic");
+    // a->b->c
+    // \_____^
+
+    acyclic.calls('a', 'b');
+    acyclic.calls('a', 'c');
+    acyclic.calls('b', 'c');
+
+    auto compiled = acyclic.compile();
+    EXPECT_FALSE(compiled->hasCycles());
+
+    // same order as sort()
+    std::vector<char> sorted;
+    acyclic.sort(sorted);
+    EXPECT_EQ(sorted, compiled->sccOrder());
+
+    EXPECT_TRUE(compiled->isCaller('a'));
+    EXPECT_FALSE(compiled->isCallee('a'));
+    EXPECT_TRUE(compiled->isCallee('c'));
+    EXPECT_FALSE(compiled->isCaller('c'));
+    EXPECT_FALSE(compiled->inSameScc('a', 'b'));
+
+    std::set<char> reach;
+    compiled->reachable('b', reach);
+    sameSet(reach, {'b', 'c'});
+}
+
+TEST(CallGraph, CompiledCyclic) {
+    P4::CallGraph<char> cyclic("cyclic");
+    // a->b<->c  d->d
+    cyclic.calls('a', 'b');
+    cyclic.calls('b', 'c');
+    cyclic.calls('c', 'b');
+    cyclic.calls('d', 'd');
+
+    auto compiled = cyclic.compile();
+    EXPECT_TRUE(compiled->hasCycles());
+    EXPECT_EQ(4u, compiled->size());
+
+    std::vector<char> sorted;
+    cyclic.sort(sorted);
+    EXPECT_EQ(sorted, compiled->sccOrder());
+
+    EXPECT_TRUE(compiled->inSameScc('b', 'c'));
+    EXPECT_FALSE(compiled->inSameScc('a', 'b'));
+    EXPECT_TRUE(compiled->inSameScc('d', 'd'));
+
+    std::set<char> reach;
+    compiled->reachable('a', reach);
+    sameSet(reach, {'a', 'b', 'c'});
+
+    // a node outside the graph only reaches itself
+    reach.clear();
+    compiled->reachable('z', reach);
+    sameSet(reach, {'z'});
+}
+
 }  // namespace P4::Test
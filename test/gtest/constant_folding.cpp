@@ -130,4 +130,34 @@ TEST_F(P4CConstantFoldingValidation, filter) {
     EXPECT_TRUE(ts_2->size->is<IR::Constant>());
 }
 
+using P4CConstantFoldingKernels = P4CTest;
+
+// The width-specialized kernels must wrap results like the generic big_int path
+TEST_F(P4CConstantFoldingKernels, native_width_wrap) {
+    const auto *t8 = IR::Type_Bits::get(8);
+    const auto *add = new IR::Add(new IR::Constant(t8, 250), new IR::Constant(t8, 10));
+    P4::DoConstantFolding folder;
+    const auto *folded = add->apply(folder)->to<IR::Constant>();
+    ASSERT_TRUE(folded);
+    EXPECT_EQ(folded->value, 4);  // 260 mod 2^8
+
+    const auto *t16 = IR::Type_Bits::get(16);
+    const auto *shl = new IR::Shl(new IR::Constant(t16, 0xf0), new IR::Constant(4));
+    const auto *shifted = shl->apply(folder)->to<IR::Constant>();
+    ASSERT_TRUE(shifted);
+    EXPECT_EQ(shifted->value, 0xf00);
+}
+
+// Folds that leave an operand's value unchanged reuse the operand node
+TEST_F(P4CConstantFoldingKernels, operand_reuse) {
+    const auto *t32 = IR::Type_Bits::get(32);
+    const auto *x = new IR::Constant(t32, 0x1234);
+    const auto *add = new IR::Add(x, new IR::Constant(t32, 0));
+    P4::DoConstantFolding folder;
+    EXPECT_EQ(add->apply(folder), x);
+
+    const auto *band = new IR::BAnd(x, new IR::Constant(t32, 0xffffffffU));
+    EXPECT_EQ(band->apply(folder), x);
+}
+
 }  // namespace P4::Test
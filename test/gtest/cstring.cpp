@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <unordered_set>
+
 namespace P4::Test {
 
 using namespace P4::literals;
@@ -158,4 +160,13 @@ TEST(cstring, get_cached) {
     EXPECT_FALSE(cstring::get_cached("test").isNullOrEmpty());
 }
 
+TEST(cstring, transparent_lookup) {
+    std::unordered_set<cstring, Util::Hasher<cstring>, std::equal_to<>> set;
+    set.insert("interned"_cs);
+    EXPECT_NE(set.find(std::string_view("interned")), set.end());
+    EXPECT_EQ(
+        set.find(std::string_view("we really do not expect that this string is already interned")),
+        set.end());
+}
+
 }  // namespace P4::Test
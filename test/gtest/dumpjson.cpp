@@ -62,6 +62,29 @@ TEST(JSON, string_map) {
     EXPECT_EQ(data[1], copy[1]);
 }
 
+TEST(JSON, string_map_freeze) {
+    string_map<int> m;
+    m["zulu"] = 1;
+    m["alpha"] = 2;
+    m["mike"] = 3;
+
+    m.freeze();
+    EXPECT_TRUE(m.frozen());
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m.at("alpha"), 2);
+    EXPECT_EQ(m.count("mike"), 1u);
+    EXPECT_FALSE(m.contains("november"));
+    // insertion order survives freezing
+    EXPECT_EQ(m.begin()->first, "zulu");
+
+    // mutation transparently thaws
+    m["november"] = 4;
+    EXPECT_FALSE(m.frozen());
+    EXPECT_EQ(m.size(), 4u);
+    EXPECT_EQ(m.at("november"), 4);
+    EXPECT_EQ(m.at("alpha"), 2);
+}
+
 TEST(JSON, std_map) {
     std::map<big_int, bitvec> data, copy;
     data[big_int(1) << 100].setrange(100, 100);
@@ -77,6 +100,38 @@ TEST(JSON, std_map) {
     EXPECT_EQ(data, copy);
 }
 
+TEST(JSON, parallel_parse) {
+    // build a document with enough top-level members to shard, with brackets,
+    // commas and escaped quotes hiding inside strings
+    std::stringstream ss;
+    const char *sep = "";
+    ss << "{";
+    for (int i = 0; i < 100; ++i) {
+        ss << sep << "\"key" << i << "\": {\"n\": " << i << ", \"s\": \"br[a{ce,s\\\"\", "
+           << "\"v\": [1, 2, [3, {\"deep\": true}]]}";
+        sep = ",\n";
+    }
+    ss << "}";
+
+    std::stringstream sequential(ss.str()), sharded(ss.str());
+    std::unique_ptr<JsonData> expected;
+    sequential >> expected;
+    auto parsed = parseJsonParallel(sharded, 4);
+    ASSERT_TRUE(parsed != nullptr);
+
+    // element order and content must be preserved exactly
+    std::stringstream out1, out2;
+    out1 << expected.get();
+    out2 << parsed.get();
+    EXPECT_EQ(out1.str(), out2.str());
+
+    // scalar documents take the sequential path transparently
+    std::stringstream scalar("42");
+    auto num = parseJsonParallel(scalar, 4);
+    ASSERT_TRUE(num != nullptr);
+    EXPECT_EQ(num->as<JsonNumber>().val, 42);
+}
+
 TEST(JSON, variant) {
     std::vector<std::variant<int, std::string>> data, copy;
     data.emplace_back(2);
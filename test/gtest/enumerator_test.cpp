@@ -218,4 +218,69 @@ TEST_F(UtilEnumerator, Linq) {
     }
 }
 
+TEST_F(UtilEnumerator, ValuePipeline) {
+    // a whole where+map pipeline lives on the stack; no allocation, no virtual calls
+    auto pipeline =
+        Util::valueEnumerate(vec).where([](int x) { return x % 2 == 1; }).map([](int x) {
+            return x * 10;
+        });
+    std::vector<int> result = pipeline.toVector();
+    EXPECT_EQ((std::vector<int>{10, 30}), result);
+
+    pipeline.reset();
+    EXPECT_EQ(2u, pipeline.count());
+
+    // range for via the sentinel iterator
+    auto inc = Util::valueEnumerate(vec).map([](int x) { return x + 1; });
+    int sum = 0;
+    for (int x : inc) sum += x;
+    EXPECT_EQ(9, sum);
+
+    // concat nests by value
+    std::vector<int> more{4, 5};
+    auto cat = Util::valueEnumerate(vec).concat(Util::valueEnumerate(more));
+    EXPECT_EQ(5u, cat.count());
+    cat.reset();
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4, 5}), cat.toVector());
+
+    // as
+    std::vector<B *> bs;
+    bs.push_back(new B(1));
+    bs.push_back(new B(2));
+    auto as = Util::valueEnumerate(bs).as<A *>();
+    EXPECT_TRUE(as.moveNext());
+    EXPECT_EQ(1, as.getCurrent()->a);
+    EXPECT_TRUE(as.moveNext());
+    EXPECT_EQ(2, as.getCurrent()->a);
+    EXPECT_FALSE(as.moveNext());
+
+    // next & co.
+    auto vi = Util::valueEnumerate(vec);
+    EXPECT_EQ(1, vi.next());
+    EXPECT_EQ(2, vi.nextOrDefault());
+    EXPECT_EQ(3, vi.nextOrDefault());
+    EXPECT_EQ(0, vi.nextOrDefault());
+    auto none = Util::valueEnumerate(vec).where([](int) { return false; });
+    EXPECT_FALSE(none.any());
+    none.reset();
+    EXPECT_THROW(none.next(), std::logic_error);
+}
+
+TEST_F(UtilEnumerator, ValueAdapters) {
+    // compose a value pipeline on top of a type-erased enumerator
+    Enumerator<int> *heap = Util::enumerate(vec);
+    auto small = Util::valueEnumerate(heap).where([](int x) { return x < 3; });
+    EXPECT_EQ((std::vector<int>{1, 2}), small.toVector());
+
+    // and hand a value pipeline back as Enumerator<int> *: one allocation total
+    Enumerator<int> *bridged =
+        Util::valueEnumerate(vec).map([](int x) { return x * x; }).heapEnumerator();
+    EXPECT_TRUE(bridged->moveNext());
+    EXPECT_EQ(1, bridged->getCurrent());
+    EXPECT_EQ((std::vector<int>{4, 9}), bridged->toVector());
+    bridged->reset();
+    EXPECT_THROW(bridged->getCurrent(), std::logic_error);
+    EXPECT_EQ(3u, bridged->count());
+}
+
 }  // namespace P4::Util
@@ -72,3 +72,29 @@ TEST(IR, Equiv) {
     pr2->add("listb"_cs, list1);
     EXPECT_FALSE(pr1->equiv(*pr2));
 }
+
+TEST(IR, EquivHash) {
+    auto *t = IR::Type::Bits::get(16);
+    auto *a1 = new IR::Constant(t, 10);
+    auto *a2 = new IR::Constant(t, 10);
+    auto *c = new IR::Constant(t, 20);
+    auto *d1m = new IR::Member(new IR::PathExpression("d"), "m");
+    auto *d2m = new IR::Member(new IR::PathExpression("d"), "m");
+
+    // equiv nodes must hash equal, and the cached hash is stable across calls.
+    EXPECT_EQ(a1->getEquivHash(), a2->getEquivHash());
+    EXPECT_EQ(a1->getEquivHash(), a1->getEquivHash());
+    EXPECT_EQ(d1m->getEquivHash(), d2m->getEquivHash());
+    // Collisions are allowed in principle, but these values must hash apart in practice
+    // for the O(1) rejection in equiv() to be worth anything.
+    EXPECT_NE(a1->getEquivHash(), c->getEquivHash());
+    EXPECT_NE(d1m->getEquivHash(), a1->getEquivHash());
+    EXPECT_TRUE(a1->equiv(*a2));
+    EXPECT_FALSE(a1->equiv(*c));
+
+    // A mutated clone recomputes its hash rather than inheriting a stale one.
+    auto *m = a1->clone();
+    m->value = 20;
+    EXPECT_EQ(m->getEquivHash(), c->getEquivHash());
+    EXPECT_TRUE(m->equiv(*c));
+}
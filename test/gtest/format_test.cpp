@@ -55,4 +55,14 @@ TEST(Util, Format) {
     EXPECT_EQ("x 5\n", message);
 }
 
+TEST(Util, FormatCacheReuse) {
+    // repeated uses of the same pattern come from the precompiled-format cache;
+    // each copy must format independently of earlier argument bindings
+    auto &reporter = BaseCompileContext::get().errorReporter();
+    for (int i = 0; i < 3; ++i) {
+        cstring message = reporter.format_message("iter %1% of %2%", i, 3);
+        EXPECT_EQ("iter " + std::to_string(i) + " of 3\n", message.string());
+    }
+}
+
 }  // namespace P4::Util
@@ -19,6 +19,7 @@ limitations under the License.
 #include <unordered_map>
 #include <unordered_set>
 
+#include "lib/big_int_util.h"
 #include "lib/cstring.h"
 
 namespace P4::Test {
@@ -290,4 +291,27 @@ TEST(Hash, SharedPtr) { pointerTestWithHash<std::shared_ptr>(); }
 
 TEST(Hash, Pointer) { pointerTestWithHash<Pointer>(); }
 
+TEST(Hash, SmallIntPair) {
+    Util::Hasher<std::pair<int, int>> hasher;
+    EXPECT_NE(hasher({1, 2}), hasher({2, 1}));
+
+    std::unordered_map<std::pair<uint32_t, uint32_t>, int, Util::Hash> m;
+    m.emplace(std::make_pair(1u, 2u), 42);
+    EXPECT_EQ(m.at({1u, 2u}), 42);
+}
+
+TEST(Hash, BigInt) {
+    Util::Hasher<big_int> hasher;
+    // Equal values hash equal regardless of how they were computed.
+    big_int wide = (big_int(1) << 200) + 42;
+    EXPECT_EQ(hasher(wide), hasher((big_int(1) << 200) + 42));
+    EXPECT_EQ(hasher(big_int(42)), hasher(wide - (big_int(1) << 200)));
+    // Sign participates in the hash.
+    EXPECT_NE(hasher(big_int(42)), hasher(big_int(-42)));
+
+    std::unordered_map<big_int, int, Util::Hash> m;
+    m.emplace(wide, 42);
+    EXPECT_EQ(m.at(wide), 42);
+}
+
 }  // namespace P4::Test
@@ -18,6 +18,9 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
+
 namespace P4::Test {
 
 TEST(hvec_map, map_equal) {
@@ -177,4 +180,63 @@ TEST(hvec_map, string_map) {
     }
 }
 
+TEST(hvec_map, reserve) {
+    hvec_map<unsigned, unsigned> m;
+    for (unsigned i = 0; i < 10; ++i) m[i] = i * 10;
+    m.reserve(1000);
+    for (unsigned i = 0; i < 10; ++i) EXPECT_EQ(m.at(i), i * 10);
+    for (unsigned i = 10; i < 1000; ++i) m[i] = i * 10;
+    EXPECT_EQ(m.size(), 1000U);
+    EXPECT_EQ(m.at(999), 9990U);
+}
+
+namespace {
+struct TransparentStringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+struct TransparentStringEq {
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const { return a == b; }
+};
+}  // namespace
+
+TEST(hvec_map, heterogeneous_lookup) {
+    hvec_map<std::string, int, TransparentStringHash, TransparentStringEq> m;
+    m["alpha"] = 1;
+    m["beta"] = 2;
+
+    // Probe with a std::string_view without materializing a std::string.
+    auto it = m.find(std::string_view("alpha"));
+    ASSERT_TRUE(it != m.end());
+    EXPECT_EQ(it->second, 1);
+    EXPECT_EQ(m.count(std::string_view("beta")), 1U);
+    EXPECT_EQ(m.count(std::string_view("gamma")), 0U);
+    EXPECT_EQ(m.at(std::string_view("beta")), 2);
+    EXPECT_THROW(m.at(std::string_view("gamma")), std::out_of_range);
+
+    m.erase("beta");
+    EXPECT_EQ(m.count(std::string_view("beta")), 0U);
+}
+
+TEST(hvec_map, snapshot) {
+    hvec_map<unsigned, unsigned> m;
+    for (unsigned i = 0; i < 100; ++i) m[i] = i;
+    auto snap = m.snapshot();
+
+    // The snapshot preserves the map's insertion order ...
+    for (unsigned i = 0; i < 100; ++i) EXPECT_EQ(snap[i].first, i);
+
+    // ... and stays valid while the map is mutated, even across rehashes.
+    for (auto &el : snap) {
+        m.erase(el.first);
+        m[el.first + 1000] = el.second;
+    }
+    EXPECT_EQ(m.size(), 100U);
+    for (unsigned i = 0; i < 100; ++i) {
+        EXPECT_EQ(m.count(i), 0U);
+        EXPECT_EQ(m.at(i + 1000), i);
+    }
+}
+
 }  // namespace P4::Test
@@ -140,4 +140,50 @@ TEST(IndexedVector, erase) {
     vec.validate();
 }
 
+TEST(IndexedVector, move_append) {
+    TestVector vec;
+    Vector<StructField> tail{testItem("a"_cs), testItem("b"_cs)};
+    vec.append(std::move(tail));
+    EXPECT_TRUE(tail.empty());
+    EXPECT_EQ(vec.size(), 2u);
+    EXPECT_TRUE(vec.getDeclaration("a"));
+    EXPECT_TRUE(vec.getDeclaration("b"));
+    vec.validate();
+
+    Vector<StructField> tail2{testItem("c"_cs)};
+    vec.append(std::move(tail2));
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec[2]->name.name, "c");
+    EXPECT_TRUE(vec.getDeclaration("c"));
+    vec.validate();
+}
+
+TEST(IndexedVector, deferred_index) {
+    TestVector vec;
+    vec.deferIndex();
+    vec.reserve(3);
+    vec.push_back(testItem("a"_cs));
+    vec.push_back(testItem("b"_cs));
+    vec.push_back(testItem("c"_cs));
+    vec.freezeIndex();
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_TRUE(vec.getDeclaration("a"));
+    EXPECT_TRUE(vec.getDeclaration("b"));
+    EXPECT_TRUE(vec.getDeclaration("c"));
+    vec.validate();
+
+    // elements removed while deferred disappear from the rebuilt index
+    vec.deferIndex();
+    vec.pop_back();
+    vec.freezeIndex();
+    EXPECT_EQ(vec.size(), 2u);
+    EXPECT_FALSE(vec.getDeclaration("c"));
+    vec.validate();
+
+    // after freezing, per-insert maintenance resumes
+    vec.push_back(testItem("d"_cs));
+    EXPECT_TRUE(vec.getDeclaration("d"));
+    vec.validate();
+}
+
 }  // namespace P4::Test
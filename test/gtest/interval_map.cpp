@@ -0,0 +1,82 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lib/interval_map.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "lib/bitrange.h"
+
+namespace P4::Test {
+
+TEST(IntervalMap, InsertFindErase) {
+    interval_map<le_bitrange, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.insert({le_bitrange(0, 7), 1}).second);
+    EXPECT_FALSE(map.insert({le_bitrange(0, 7), 2}).second);
+    map[le_bitrange(8, 15)] = 2;
+    map[le_bitrange(32, 47)] = 3;
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.at(le_bitrange(8, 15)), 2);
+    // find() is exact: a subrange of an entry is not a hit.
+    EXPECT_EQ(map.find(le_bitrange(8, 14)), map.end());
+    EXPECT_EQ(map.erase(le_bitrange(8, 15)), 1u);
+    EXPECT_EQ(map.count(le_bitrange(8, 15)), 0u);
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(IntervalMap, Overlapping) {
+    interval_map<le_bitrange, char> map;
+    map[le_bitrange(0, 7)] = 'a';
+    map[le_bitrange(4, 31)] = 'b';
+    map[le_bitrange(8, 15)] = 'c';
+    map[le_bitrange(48, 63)] = 'd';
+
+    std::string hits;
+    for (const auto &entry : map.overlapping(le_bitrange(6, 9))) hits += entry.second;
+    EXPECT_EQ(hits, "abc");
+
+    EXPECT_TRUE(map.has_overlap(le_bitrange(31, 31)));
+    EXPECT_FALSE(map.has_overlap(le_bitrange(32, 47)));
+    EXPECT_FALSE(map.has_overlap(le_bitrange(64, 64)));
+}
+
+TEST(IntervalMap, Containing) {
+    interval_map<le_bitrange, char> map;
+    map[le_bitrange(0, 7)] = 'a';
+    map[le_bitrange(0, 31)] = 'b';
+    map[le_bitrange(8, 15)] = 'c';
+
+    std::string hits;
+    for (const auto &entry : map.containing(le_bitrange(2, 5))) hits += entry.second;
+    EXPECT_EQ(hits, "ab");
+}
+
+TEST(IntervalMap, HalfOpenBoundaries) {
+    interval_map<le_bitinterval, int> map;
+    map[le_bitinterval(0, 8)] = 1;
+    map[le_bitinterval(8, 16)] = 2;
+
+    // Half-open ranges that merely touch do not overlap.
+    EXPECT_FALSE(map.has_overlap(le_bitinterval(16, 24)));
+
+    std::vector<int> hits;
+    for (const auto &entry : map.overlapping(le_bitinterval(7, 9))) hits.push_back(entry.second);
+    EXPECT_EQ(hits, (std::vector<int>{1, 2}));
+}
+
+}  // namespace P4::Test
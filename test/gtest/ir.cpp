@@ -19,9 +19,13 @@ limitations under the License.
 #include <gtest/gtest.h>
 
 #include "helpers.h"
+#include "ir/annotation_index.h"
+#include "ir/id-compaction.h"
 
 namespace P4::Test {
 
+using namespace P4::literals;
+
 struct IrTest : P4CTest {};
 struct ConstantTest : IrTest {};
 
@@ -77,4 +81,61 @@ TEST_F(ConstantTest, ConstantBit1NoOverflow) {
     EXPECT_EQ(con->value, 1);
 }
 
+struct IdCompactionTest : IrTest {};
+
+TEST_F(IdCompactionTest, DenseRenumbering) {
+    const auto *a = new IR::Constant(IR::Type_Bits::get(8), 1);
+    // burn some ids so the tree is sparse
+    for (int i = 0; i < 100; i++) new IR::Constant(i);
+    const auto *b = new IR::Constant(IR::Type_Bits::get(8), 2);
+    const auto *add = new IR::Add(a, b);
+    int oldA = a->id;
+    int oldB = b->id;
+
+    CompactNodeIds compact;
+    add->apply(compact);
+
+    // every reachable node now lives in the reserved dense block
+    int lo = compact.firstId();
+    int hi = lo + static_cast<int>(compact.size());
+    for (const auto *n : {static_cast<const IR::Node *>(add), a->getNode(), b->getNode()}) {
+        EXPECT_GE(n->id, lo);
+        EXPECT_LT(n->id, hi);
+    }
+    EXPECT_NE(a->id, b->id);
+
+    // stored ids translate through the remapping service
+    EXPECT_EQ(compact.remap(oldA), a->id);
+    EXPECT_EQ(compact.remap(oldB), b->id);
+    // ids of nodes outside the tree are left alone
+    EXPECT_EQ(compact.remap(-42), -42);
+}
+
+TEST(AnnotationIndexTest, CollectByName) {
+    auto *hidden = new IR::Declaration_Variable(IR::ID{"h"_cs, nullptr}, IR::Type_Bits::get(8));
+    hidden->addAnnotation(IR::Annotation::hiddenAnnotation, new IR::Constant(1));
+    auto *plain = new IR::Declaration_Variable(IR::ID{"p"_cs, nullptr}, IR::Type_Bits::get(8));
+    auto *both = new IR::Declaration_Variable(IR::ID{"b"_cs, nullptr}, IR::Type_Bits::get(8));
+    both->addAnnotation(IR::Annotation::hiddenAnnotation, new IR::Constant(2));
+    both->addAnnotation(IR::Annotation::optionalAnnotation, new IR::Constant(3));
+
+    auto *decls = new IR::IndexedVector<IR::Declaration>();
+    decls->push_back(hidden);
+    decls->push_back(plain);
+    decls->push_back(both);
+
+    IR::AnnotationIndex index;
+    decls->apply(index);
+
+    const auto &hiddenNodes = index.get(IR::Annotation::hiddenAnnotation);
+    ASSERT_EQ(hiddenNodes.size(), 2u);
+    EXPECT_EQ(hiddenNodes[0].node, hidden);
+    EXPECT_EQ(hiddenNodes[1].node, both);
+    EXPECT_EQ(hiddenNodes[1].annotation->name, IR::Annotation::hiddenAnnotation);
+
+    EXPECT_TRUE(index.any(IR::Annotation::optionalAnnotation));
+    EXPECT_FALSE(index.any(IR::Annotation::atomicAnnotation));
+    EXPECT_TRUE(index.get(IR::Annotation::atomicAnnotation).empty());
+}
+
 }  // namespace P4::Test
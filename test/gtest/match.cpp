@@ -0,0 +1,77 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lib/match.h"
+
+#include <gtest/gtest.h>
+
+namespace P4::Test {
+
+TEST(Match, CompiledAgreesWithMatchT) {
+    for (int width : {1, 8, 63, 64, 65, 128, 200}) {
+        big_int wmask = (big_int(1) << width) - 1;
+        big_int val = (big_int(0x123456789abcdef0ULL) << 70) | 0xa5a5a5a5;
+        big_int mask = (big_int(0xff00ff00ff00ff00ULL) << 70) | 0xffff0000;
+        match_t m(width, val & wmask, mask & wmask);
+        compiled_match_t cm(m, width);
+        for (big_int v :
+             {big_int(0), val & mask & wmask, val & wmask, wmask, big_int(1) << (width + 3)})
+            EXPECT_EQ(cm.matches(v), m.matches(v)) << "width " << width << " input " << v;
+    }
+}
+
+TEST(Match, CompiledNormalizesToWidth) {
+    // in-width bits specified in neither word become don't-care, as with setwidth
+    match_t raw(big_int(0), big_int(1));  // bit 0 must be 1, everything else unspecified
+    compiled_match_t cm(raw, 8);
+    EXPECT_TRUE(cm.matches(uint64_t(0xf1)));
+    EXPECT_FALSE(cm.matches(uint64_t(0xf0)));
+    EXPECT_FALSE(cm.matches(uint64_t(0x101)));  // out of width
+}
+
+TEST(Match, CompiledParsedPattern) {
+    match_t m;
+    ASSERT_TRUE("0x1*2" >> m);
+    compiled_match_t cm(m, 12);
+    EXPECT_TRUE(cm.matches(uint64_t(0x102)));
+    EXPECT_TRUE(cm.matches(uint64_t(0x1f2)));
+    EXPECT_FALSE(cm.matches(uint64_t(0x1f3)));
+    EXPECT_TRUE(cm.matches(big_int(0x1a2)));
+}
+
+TEST(Match, CompiledWideFastPath) {
+    // a uint64_t input probed against a key wider than one limb
+    match_t m(128, big_int(0x12) << 80, big_int(0xff) << 80);
+    compiled_match_t cm(m, 128);
+    EXPECT_FALSE(cm.matches(uint64_t(0x12)));  // required-1 bits are in the upper limb
+    EXPECT_TRUE(cm.matches(big_int(0x12) << 80));
+    compiled_match_t dc(match_t::dont_care(128), 128);
+    EXPECT_TRUE(dc.matches(uint64_t(0x12)));
+}
+
+TEST(Match, MatchFirstPriorityOrder) {
+    match_t wild;
+    ASSERT_TRUE("0x1*2" >> wild);
+    std::vector<compiled_match_t> entries;
+    entries.emplace_back(wild, 12);
+    entries.emplace_back(match_t(12, 0x102, 0xfff), 12);
+    entries.emplace_back(match_t::dont_care(12), 12);
+    EXPECT_EQ(match_first(entries, uint64_t(0x102)), 0);  // first match wins, not best
+    EXPECT_EQ(match_first(entries, uint64_t(0x999)), 2);
+    EXPECT_EQ(match_first(entries, big_int(1) << 100), -1);
+}
+
+}  // namespace P4::Test
@@ -24,6 +24,7 @@ limitations under the License.
 #include "helpers.h"
 #include "ir/ir.h"
 #include "lib/log.h"
+#include "midend/caseAnalysis.h"
 #include "midend/convertEnums.h"
 #include "midend/replaceSelectRange.h"
 
@@ -287,4 +288,44 @@ TEST_F(P4CMidend, replaceSelectRangeSigned5) {
         {{0, 15}}, [](CollectRangesAndMasks collect) { ASSERT_EQ(collect.masks.size(), 1u); });
 }
 
+TEST_F(P4CMidend, caseLabelIndexDuplicates) {
+    CaseLabelIndex index;
+    auto t8 = IR::Type_Bits::get(8);
+    EXPECT_TRUE(index.add(new IR::Constant(t8, 1)));
+    // an equivalent label on a distinct node is a duplicate
+    EXPECT_FALSE(index.add(new IR::Constant(t8, 1)));
+    // equiv() distinguishes the base and the width, and so does the index
+    EXPECT_TRUE(index.add(new IR::Constant(t8, 1, 16)));
+    EXPECT_TRUE(index.add(new IR::Constant(IR::Type_Bits::get(9), 1)));
+    EXPECT_TRUE(index.add(new IR::DefaultExpression(IR::Type_Dontcare::get())));
+    EXPECT_FALSE(index.add(new IR::DefaultExpression(IR::Type_Dontcare::get())));
+    // lists compare element-wise
+    auto l1 = new IR::ListExpression({new IR::Constant(t8, 1), new IR::Constant(t8, 2)});
+    auto l2 = new IR::ListExpression({new IR::Constant(t8, 1), new IR::Constant(t8, 2)});
+    EXPECT_TRUE(index.add(l1));
+    EXPECT_FALSE(index.add(l2));
+    EXPECT_TRUE(index.contains(l2));
+    // labels that are not recognized constants are never duplicates
+    auto add = new IR::Add(new IR::Constant(t8, 1), new IR::Constant(t8, 2));
+    EXPECT_TRUE(index.add(add));
+    EXPECT_FALSE(index.contains(add));
+    EXPECT_TRUE(index.add(add));
+}
+
+TEST_F(P4CMidend, replaceSelectRangeCoverCache) {
+    P4::ReplaceSelectRange rsr;
+    const auto &cover = rsr.maskCover(16, 255, 16);
+    ASSERT_EQ(cover.size(), 4u);
+    // repeated queries for the same triple return the cached cover
+    EXPECT_EQ(&rsr.maskCover(16, 255, 16), &cover);
+    // the cover matches exactly the values in the range
+    for (int i = 0; i < 1 << 16; ++i) {
+        bool inMask = std::any_of(cover.begin(), cover.end(),
+                                  [&](const std::pair<big_int, big_int> &m) {
+                                      return (big_int(i) & m.second) == (m.first & m.second);
+                                  });
+        ASSERT_EQ(inMask, i >= 16 && i <= 255) << "value " << i;
+    }
+}
+
 }  // namespace P4::Test
@@ -0,0 +1,143 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lib/ordered_flat_map.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "lib/map.h"
+
+namespace P4::Test {
+
+TEST(OrderedFlatMap, InsertionOrderIteration) {
+    ordered_flat_map<unsigned, unsigned> m;
+
+    m[4] = 444;
+    m[1] = 111;
+    m[3] = 333;
+    m[2] = 222;
+
+    std::vector<unsigned> keys;
+    for (auto &kv : m) keys.push_back(kv.first);
+    EXPECT_EQ(keys, (std::vector<unsigned>{4, 1, 3, 2}));
+
+    // Re-assigning an existing key must not change the order.
+    m[1] = 11;
+    keys.clear();
+    for (auto &kv : m) keys.push_back(kv.first);
+    EXPECT_EQ(keys, (std::vector<unsigned>{4, 1, 3, 2}));
+    EXPECT_EQ(m.at(1), 11u);
+}
+
+TEST(OrderedFlatMap, MapEqual) {
+    ordered_flat_map<unsigned, unsigned> a;
+    ordered_flat_map<unsigned, unsigned> b;
+
+    EXPECT_TRUE(a == b);
+
+    a[1] = 111;
+    a[2] = 222;
+    b[1] = 111;
+    b[2] = 222;
+    EXPECT_TRUE(a == b);
+
+    // Same elements in a different insertion order compare unequal.
+    ordered_flat_map<unsigned, unsigned> c;
+    c[2] = 222;
+    c[1] = 111;
+    EXPECT_TRUE(a != c);
+
+    a.clear();
+    b.clear();
+    EXPECT_TRUE(a == b);
+}
+
+TEST(OrderedFlatMap, FindEmplaceErase) {
+    ordered_flat_map<unsigned, unsigned> m;
+
+    for (auto v : {5u, 3u, 8u, 1u}) EXPECT_TRUE(m.emplace(v, 10 * v).second);
+    EXPECT_FALSE(m.emplace(3u, 0u).second);
+    EXPECT_EQ(m.size(), 4u);
+
+    auto it = m.find(8);
+    ASSERT_TRUE(it != m.end());
+    EXPECT_EQ(it->second, 80u);
+    EXPECT_TRUE(m.find(7) == m.end());
+    EXPECT_EQ(m.count(5), 1u);
+
+    EXPECT_EQ(m.erase(3), 1u);
+    EXPECT_EQ(m.erase(3), 0u);
+    EXPECT_EQ(m.size(), 3u);
+
+    // Erasure preserves the insertion order of the remaining elements and
+    // leaves the key index usable.
+    std::vector<unsigned> keys;
+    for (auto &kv : m) keys.push_back(kv.first);
+    EXPECT_EQ(keys, (std::vector<unsigned>{5, 8, 1}));
+    EXPECT_EQ(m.at(1), 10u);
+    EXPECT_EQ(m.at(8), 80u);
+}
+
+TEST(OrderedFlatMap, EqualRangeAndRangeErase) {
+    ordered_flat_map<unsigned, unsigned> m{{10, 1}, {30, 3}, {20, 2}};
+
+    // Unique keys: equal_range holds exactly the matching element, or nothing.
+    auto [lo, hi] = m.equal_range(30);
+    ASSERT_TRUE(lo != hi);
+    EXPECT_EQ(lo->second, 3u);
+    EXPECT_EQ(std::distance(lo, hi), 1);
+    auto none = m.equal_range(25);
+    EXPECT_TRUE(none.first == none.second);
+
+    m.erase(m.begin(), m.begin() + 2);
+    EXPECT_EQ(m.size(), 1u);
+    EXPECT_EQ(m.at(20), 2u);
+    EXPECT_TRUE(m.find(10) == m.end());
+}
+
+TEST(OrderedFlatMap, ReboundAllocator) {
+    // Callers that pass the map as a template-template argument (IR::NameMap)
+    // supply a pair<const K, V> allocator as std::map would expect; it must be
+    // rebound for the flat storage rather than rejected.
+    ordered_flat_map<unsigned, unsigned, std::less<unsigned>,
+                     std::allocator<std::pair<const unsigned, unsigned>>>
+        m;
+    m[2] = 22;
+    m[1] = 11;
+    EXPECT_EQ(m.find(2)->second, 22u);
+    EXPECT_EQ(m.begin()->first, 2u);
+}
+
+TEST(OrderedFlatMap, Bounds) {
+    ordered_flat_map<unsigned, unsigned> m{{10, 1}, {30, 3}, {20, 2}};
+
+    EXPECT_EQ(m.lower_bound(20)->first, 20u);
+    EXPECT_EQ(m.upper_bound(20)->first, 30u);
+    EXPECT_TRUE(m.upper_bound(30) == m.end());
+    EXPECT_EQ(m.upper_bound_pred(25)->first, 20u);
+    EXPECT_TRUE(m.upper_bound_pred(5) == m.end());
+}
+
+TEST(OrderedFlatMap, GetHelper) {
+    ordered_flat_map<int, std::string> m{{1, "One"}, {2, "Two"}};
+
+    EXPECT_EQ(get(m, 1), "One");
+    EXPECT_EQ(get(m, 3), "");
+}
+
+}  // namespace P4::Test
@@ -19,6 +19,7 @@ limitations under the License.
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <string>
 
 namespace P4::Test {
 
@@ -119,6 +120,48 @@ TEST(ordered_set, set_intersect) {
     EXPECT_EQ(res, expect);
 }
 
+TEST(ordered_set, small_and_spilled_agree) {
+    // grow across the small-representation threshold and check that lookup, order and
+    // erasure behave identically on both sides of the spill
+    ordered_set<unsigned> set;
+    std::vector<unsigned> vec;
+    for (unsigned i = 0; i < 40; ++i) {
+        unsigned v = i * 13 % 31;
+        bool fresh = std::find(vec.begin(), vec.end(), v) == vec.end();
+        EXPECT_EQ(set.insert(v).second, fresh);
+        if (fresh) vec.push_back(v);
+        EXPECT_EQ(set.size(), vec.size());
+        EXPECT_TRUE(std::equal(set.begin(), set.end(), vec.begin(), vec.end()));
+        EXPECT_EQ(set.count(v), 1U);
+        EXPECT_EQ(set.count(1000), 0U);
+    }
+    EXPECT_EQ(set.erase(13U), 1U);
+    EXPECT_EQ(set.erase(13U), 0U);
+    EXPECT_EQ(set.find(13U), set.end());
+}
+
+TEST(ordered_set, sorted_iteration_small) {
+    // sorted iteration of a set still in the small representation
+    ordered_set<unsigned> set = {4, 1, 3};
+    std::vector<unsigned> sorted(set.sorted_begin(), set.sorted_end());
+    EXPECT_EQ(sorted, (std::vector<unsigned>{1, 3, 4}));
+    // insertion order is unaffected
+    EXPECT_EQ(*set.begin(), 4U);
+    EXPECT_EQ(*set.lower_bound(2), 3U);
+    EXPECT_EQ(*set.upper_bound(3), 4U);
+    EXPECT_EQ(set.upper_bound(4), set.end());
+}
+
+TEST(ordered_set, heterogeneous_find) {
+    ordered_set<std::string, std::less<>> set = {"foo", "bar"};
+    EXPECT_EQ(set.count("foo"), 1U);  // no std::string temporary
+    EXPECT_EQ(*set.find("bar"), "bar");
+    EXPECT_EQ(set.find("baz"), set.end());
+    for (int i = 0; i < 12; ++i) set.insert("k" + std::to_string(i));  // spill
+    EXPECT_EQ(set.count("k7"), 1U);
+    EXPECT_EQ(set.find("nope"), set.end());
+}
+
 TEST(ordered_set, x_is_strict_prefix_of_y) {
     ordered_set<unsigned> x;
     x.insert(1);
@@ -10,6 +10,7 @@
 #include "frontends/common/parseInput.h"
 #include "frontends/p4/frontend.h"
 #include "ir/ir.h"
+#include "midend/interpreter.h"
 #include "test/gtest/env.h"
 #include "test/gtest/helpers.h"
 #include "test/gtest/midend_pass.h"
@@ -152,4 +153,35 @@ TEST_F(P4CParserUnroll, stringTypes) {
     ASSERT_EQ(parsers.first->states.size(), parsers.second->states.size());
 }
 
+TEST_F(P4CParserUnroll, valueMapCopyOnWrite) {
+    auto *decl = new IR::Declaration_Variable(IR::ID("x"), IR::Type_Boolean::get());
+    auto *map = new ValueMap();
+    map->set(decl, new SymbolicBool(true));
+
+    // A clone shares the stored value until somebody asks to write it.
+    auto *copy = map->clone();
+    EXPECT_EQ(map->get(decl), copy->get(decl));
+
+    copy->getWritable(decl)->assign(new SymbolicBool(false));
+    EXPECT_NE(map->get(decl), copy->get(decl));
+    EXPECT_TRUE(map->get(decl)->to<SymbolicBool>()->value);
+    EXPECT_FALSE(copy->get(decl)->to<SymbolicBool>()->value);
+
+    // Detaching in the original map afterwards leaves the copy undisturbed.
+    map->getWritable(decl)->setAllUnknown();
+    EXPECT_TRUE(map->get(decl)->to<SymbolicBool>()->isUnknown());
+    EXPECT_TRUE(copy->get(decl)->to<SymbolicBool>()->isKnown());
+}
+
+TEST_F(P4CParserUnroll, valueMapWiden) {
+    auto *decl = new IR::Declaration_Variable(IR::ID("x"), IR::Type_Boolean::get());
+    auto *map = new ValueMap();
+    map->set(decl, new SymbolicBool(true));
+
+    auto *copy = map->clone();
+    copy->widen();
+    EXPECT_TRUE(copy->get(decl)->to<SymbolicBool>()->isUnknown());
+    EXPECT_TRUE(map->get(decl)->to<SymbolicBool>()->isKnown());
+}
+
 }  // namespace P4::Test
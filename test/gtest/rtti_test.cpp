@@ -24,6 +24,8 @@ limitations under the License.
 
 namespace P4::Test {
 
+using namespace P4::literals;
+
 TEST(RTTI, TypeId) {
     auto *c = new IR::Constant(2);
     IR::Expression *e1 = new IR::Add(Util::SourceInfo(), c, c);
@@ -86,6 +88,26 @@ TEST(RTTI, Casts) {
     EXPECT_EQ(id->to<IR::NamedExpression>(), decl);
 }
 
+/// The generated dense-id bitmap must agree with the recursive base-chain walk
+/// for every node kind; the virtual isA() answers dense queries from the table.
+template <class T>
+static void checkIsARow(const IR::Node *node) {
+    auto kind = RTTI::TypeId(T::TypeInfo::id());
+    for (RTTI::TypeId t = 0; t < IR::NodeKindCount; ++t) {
+        bool table = (IR::nodeKindIsA[kind][t >> 6] >> (t & 63)) & 1;
+        EXPECT_EQ(table, T::TypeInfo::isA(t)) << "kind " << kind << " target " << t;
+        if (node) EXPECT_EQ(table, node->isA(t)) << "kind " << kind << " target " << t;
+    }
+}
+
+TEST(RTTI, IsATable) {
+    checkIsARow<IR::Constant>(new IR::Constant(2));
+    checkIsARow<IR::Add>(new IR::Add(new IR::Constant(1), new IR::Constant(2)));
+    checkIsARow<IR::Declaration_Variable>(
+        new IR::Declaration_Variable(IR::ID{"v"_cs, nullptr}, IR::Type_Bits::get(8)));
+    checkIsARow<IR::Declaration>(nullptr);  // abstract: row only
+}
+
 TEST(RTTI, JsonRestore) {
     auto *c = new IR::Constant(2);
     IR::Expression *e1 = new IR::Add(Util::SourceInfo(), c, c);
@@ -0,0 +1,100 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "ir/solver.h"
+
+#include <gtest/gtest.h>
+
+#include "ir/ir.h"
+
+using namespace P4;
+using namespace P4::literals;
+
+namespace {
+
+/// A solver stub whose answers are scripted by the test; counts the queries reaching it.
+class FakeSolver : public AbstractSolver {
+ public:
+    std::optional<bool> answer = false;
+    size_t calls = 0;
+
+    void comment(cstring) override {}
+    void seed(unsigned) override {}
+    void timeout(unsigned) override {}
+    std::optional<bool> checkSat(const std::vector<const Constraint *> &) override {
+        calls++;
+        return answer;
+    }
+    [[nodiscard]] const SymbolicMapping &getSymbolicMapping() const override { return mapping; }
+    void toJSON(JSONGenerator &) const override {}
+    [[nodiscard]] bool isInIncrementalMode() const override { return true; }
+
+ private:
+    SymbolicMapping mapping;
+
+    DECLARE_TYPEINFO(FakeSolver, AbstractSolver);
+};
+
+}  // namespace
+
+TEST(SolverService, MemoizesUnsat) {
+    FakeSolver solver;
+    SolverService service(solver);
+    const Constraint *a = new IR::BoolLiteral(false);
+    const Constraint *b = new IR::BoolLiteral(true);
+
+    EXPECT_EQ(std::optional<bool>(false), service.checkSat("phase1"_cs, {a, b}));
+    EXPECT_EQ(1u, solver.calls);
+    // The same constraint set, even reordered and from another client, skips the solver.
+    EXPECT_EQ(std::optional<bool>(false), service.checkSat("phase2"_cs, {b, a}));
+    EXPECT_EQ(1u, solver.calls);
+    // A different constraint set does not.
+    EXPECT_EQ(std::optional<bool>(false), service.checkSat("phase2"_cs, {a}));
+    EXPECT_EQ(2u, solver.calls);
+
+    auto stats1 = service.getStats("phase1"_cs);
+    EXPECT_EQ(1u, stats1.queries);
+    EXPECT_EQ(0u, stats1.cacheHits);
+    EXPECT_EQ(1u, stats1.unsat);
+    auto stats2 = service.getStats("phase2"_cs);
+    EXPECT_EQ(2u, stats2.queries);
+    EXPECT_EQ(1u, stats2.cacheHits);
+    EXPECT_EQ(2u, stats2.unsat);
+}
+
+TEST(SolverService, SatAndUnknownNotMemoized) {
+    FakeSolver solver;
+    SolverService service(solver);
+    const Constraint *a = new IR::BoolLiteral(true);
+
+    solver.answer = true;
+    EXPECT_EQ(std::optional<bool>(true), service.checkSat("client"_cs, {a}));
+    EXPECT_EQ(std::optional<bool>(true), service.checkSat("client"_cs, {a}));
+    EXPECT_EQ(2u, solver.calls);
+
+    solver.answer = std::nullopt;
+    EXPECT_EQ(std::nullopt, service.checkSat("client"_cs, {a}));
+    EXPECT_EQ(std::nullopt, service.checkSat("client"_cs, {a}));
+    EXPECT_EQ(4u, solver.calls);
+
+    auto stats = service.getStats("client"_cs);
+    EXPECT_EQ(4u, stats.queries);
+    EXPECT_EQ(0u, stats.cacheHits);
+    EXPECT_EQ(2u, stats.sat);
+    EXPECT_EQ(2u, stats.unknown);
+    // A client that never queried has all-zero statistics.
+    EXPECT_EQ(0u, service.getStats("idle"_cs).queries);
+}
@@ -0,0 +1,80 @@
+/*
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lib/symbitmatrix.h"
+
+#include <gtest/gtest.h>
+
+namespace P4::Test {
+
+/// Exercises the accessor API shared by the dense and the sparse matrix.
+template <class Matrix>
+static void exerciseMatrix() {
+    Matrix m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0u);
+
+    m(3, 5) = true;
+    EXPECT_TRUE(m(5, 3));  // symmetric
+    EXPECT_FALSE(m(3, 4));
+    EXPECT_EQ(m.size(), 6u);
+
+    // Far-away ids: the sparse variant only materializes touched blocks.
+    m(40000, 2) = true;
+    EXPECT_TRUE(m(2, 40000));
+    EXPECT_EQ(m.size(), 40001u);
+
+    bitvec row2 = m[2];
+    EXPECT_TRUE(row2.getbit(40000));
+    EXPECT_FALSE(row2.getbit(3));
+    EXPECT_TRUE((bool)m[5]);
+    EXPECT_FALSE((bool)m[6]);
+    EXPECT_TRUE(m[5][3]);
+
+    Matrix n;
+    n(3, 5) = true;
+    n(40000, 2) = true;
+    EXPECT_TRUE(m == n);
+    n(7, 7) = true;
+    EXPECT_TRUE(m != n);
+    EXPECT_TRUE(m |= n);
+    EXPECT_TRUE(m(7, 7));
+    EXPECT_FALSE(m |= n);  // second union changes nothing
+
+    m(3, 5) = false;
+    EXPECT_FALSE(m(5, 3));
+    m.clear();
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(SymBitMatrix, Dense) { exerciseMatrix<SymBitMatrix>(); }
+
+TEST(SymBitMatrix, Sparse) { exerciseMatrix<SparseSymBitMatrix>(); }
+
+TEST(SymBitMatrix, SparseMergeRows) {
+    SparseSymBitMatrix m;
+    m(1, 4) = true;
+    m(2, 9) = true;
+    m(1, 2) = true;  // ids 1 and 2 discovered equivalent
+    m.mergeRows(1, 2);
+    EXPECT_TRUE(m(1, 9));
+    EXPECT_TRUE(m(2, 4));
+    EXPECT_TRUE(m(1, 4));
+    EXPECT_TRUE(m(2, 9));
+    EXPECT_TRUE(m(1, 2));   // the merged pair's own relation is preserved
+    EXPECT_FALSE(m(1, 1));  // no diagonal entries introduced
+    EXPECT_FALSE(m(2, 2));
+}
+
+}  // namespace P4::Test
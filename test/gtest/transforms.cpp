@@ -16,10 +16,15 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <optional>
+#include <set>
+#include <vector>
+
 #include "helpers.h"
 #include "ir/ir-generated.h"
 #include "ir/ir.h"
 #include "ir/irutils.h"
+#include "ir/pass_manager.h"
 #include "ir/visitor.h"
 #include "lib/source_file.h"
 
@@ -82,4 +87,154 @@ TEST_F(P4C_IR, InlineBlock) {
     EXPECT_TRUE(ifs->ifFalse->is<IR::BlockStatement>());
 }
 
+// Change tracking: replacing one leaf must rebuild its ancestors without disturbing
+// unchanged siblings, and a no-op pass must hand back the original tree.
+TEST_F(P4C_IR, TransformChildChangeTracking) {
+    struct Replace7 : public Transform {
+        const IR::Node *postorder(IR::Constant *c) override {
+            if (c->asInt() == 7) return new IR::Constant(8);
+            return c;
+        }
+    };
+
+    const auto *left = new IR::Add(Util::SourceInfo(), new IR::Constant(1), new IR::Constant(2));
+    const auto *right = new IR::Add(Util::SourceInfo(), new IR::Constant(7), new IR::Constant(2));
+    const IR::Expression *root = new IR::Mul(Util::SourceInfo(), left, right);
+
+    const auto *result = root->apply(Replace7());
+    ASSERT_TRUE(result);
+    const auto *mul = result->to<IR::Mul>();
+    ASSERT_TRUE(mul);
+    EXPECT_NE(result, root);     // a descendant changed, so the root was rebuilt
+    EXPECT_EQ(mul->left, left);  // ... but the untouched subtree is shared, not cloned
+    const auto *r = mul->right->to<IR::Add>();
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r->left->to<IR::Constant>()->asInt(), 8);
+
+    const auto *again = result->apply(Replace7());
+    EXPECT_EQ(again, result);  // nothing left to change: the same tree comes back
+}
+
+// Exercise every discard site behind Transform::eagerDiscardClones; the results must
+// be the same as without the flag, and under a sanitizer these runs also prove the
+// reclaimed clones are never reachable afterwards.
+TEST_F(P4C_IR, TransformEagerDiscardClones) {
+    // A no-op postorder handler: the clone compares equal to the original, so the
+    // change tracker keeps the original and the clone is reclaimed.
+    struct KeepOriginal : public Transform {
+        KeepOriginal() { eagerDiscardClones = true; }
+        const IR::Node *postorder(IR::Constant *c) override { return c; }
+    };
+    const IR::Expression *sum =
+        new IR::Add(Util::SourceInfo(), new IR::Constant(1), new IR::Constant(2));
+    EXPECT_EQ(sum->apply(KeepOriginal()), sum);
+
+    // A preorder handler that returns a fresh but structurally identical node: the
+    // postorder result compares equal to the preorder result, whose clone is
+    // reclaimed.  The undispatched constants below discard their clones as well.
+    struct RebuildAdd : public Transform {
+        RebuildAdd() { eagerDiscardClones = true; }
+        const IR::Node *preorder(IR::Add *a) override {
+            return new IR::Add(a->srcInfo, a->left, a->right);
+        }
+    };
+    const auto *rebuilt = sum->apply(RebuildAdd());
+    ASSERT_TRUE(rebuilt);
+    EXPECT_NE(rebuilt, sum);
+    EXPECT_TRUE(*rebuilt == *sum);
+
+    // A preorder handler that coalesces with a node the pass already finished: the
+    // replacement is looked up instead of revisited and the clone is reclaimed.
+    const auto *add = new IR::Add(Util::SourceInfo(), new IR::Constant(1), new IR::Constant(2));
+    const auto *sub = new IR::Sub(Util::SourceInfo(), new IR::Constant(3), new IR::Constant(4));
+    struct CoalesceWithAdd : public Transform {
+        explicit CoalesceWithAdd(const IR::Node *target) : target(target) {
+            eagerDiscardClones = true;
+        }
+        const IR::Node *preorder(IR::Sub *) override { return target; }
+        const IR::Node *target;
+    };
+    const IR::Expression *root = new IR::Mul(Util::SourceInfo(), add, sub);
+    const auto *result = root->apply(CoalesceWithAdd(add));
+    ASSERT_TRUE(result);
+    const auto *mul = result->to<IR::Mul>();
+    ASSERT_TRUE(mul);
+    EXPECT_NE(result, root);
+    EXPECT_EQ(mul->left, add);
+    EXPECT_EQ(mul->right, add);
+}
+
+namespace {
+
+IR::P4Program *makeProgramWithConstant(const char *name, int value) {
+    IR::Vector<IR::Node> objects;
+    objects.push_back(
+        new IR::Declaration_Constant(IR::ID(name), IR::Type_Bits::get(8), new IR::Constant(value)));
+    return new IR::P4Program(objects);
+}
+
+}  // namespace
+
+// A pass that rebuilds the root without changing it structurally must not
+// force PassRepeated into another round (or an endless loop).
+TEST_F(P4C_IR, PassRepeatedEquivConvergence) {
+    struct CloneRoot : public Transform {
+        const IR::Node *postorder(IR::P4Program *program) override { return program->clone(); }
+    };
+    struct CountRounds : public Inspector {
+        unsigned rounds = 0;
+        bool preorder(const IR::P4Program *) override {
+            ++rounds;
+            return false;
+        }
+    };
+
+    auto *count = new CountRounds();
+    const auto *program = makeProgramWithConstant("a", 1);
+    PassRepeated rep({new CloneRoot(), count});
+    const auto *result = program->apply(rep);
+
+    // The structurally identical clone is discarded and the old tree kept.
+    EXPECT_EQ(result, program);
+    EXPECT_EQ(count->rounds, 1u);
+}
+
+// Member passes implementing DeclarationChangeTracking are told which
+// top-level declarations the previous round changed.
+TEST_F(P4C_IR, PassRepeatedChangeSummary) {
+    struct ChangeOnce : public Transform {
+        bool done = false;
+        const IR::Node *preorder(IR::Declaration_Constant *decl) override {
+            if (!done && decl->name.name == "a") {
+                done = true;
+                decl->initializer = new IR::Constant(42);
+            }
+            return decl;
+        }
+    };
+    struct TrackChanges : public Inspector, public DeclarationChangeTracking {
+        std::vector<std::optional<std::set<cstring>>> log;
+        void setChangedDeclarations(const std::set<cstring> *changed) override {
+            if (changed != nullptr)
+                log.push_back(*changed);
+            else
+                log.push_back(std::nullopt);
+        }
+        bool preorder(const IR::Node *) override { return false; }
+    };
+
+    auto *tracker = new TrackChanges();
+    const auto *program = makeProgramWithConstant("a", 1);
+    PassRepeated rep({new ChangeOnce(), tracker});
+    program->apply(rep);
+
+    // nullptr before the first round, the summary of round one, and nullptr
+    // again after convergence.
+    ASSERT_EQ(tracker->log.size(), 3u);
+    EXPECT_FALSE(tracker->log[0].has_value());
+    ASSERT_TRUE(tracker->log[1].has_value());
+    EXPECT_EQ(*tracker->log[1], std::set<cstring>{cstring("a")});
+    EXPECT_FALSE(tracker->log[2].has_value());
+}
+
 }  // namespace P4::Test
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "frontends/common/parseInput.h"
+#include "frontends/p4/unusedDeclarations.h"
+#include "helpers.h"
+#include "ir/ir.h"
+
+using namespace P4;
+
+namespace P4::Test {
+
+struct RemoveAllUnusedDeclarationsTest : P4CTest {
+    const IR::P4Program *parseAndRemove(const std::string &program) {
+        const auto *pgm = P4::parseP4String(program, CompilerOptions::FrontendVersion::P4_16);
+        EXPECT_TRUE(pgm);
+        EXPECT_EQ(::P4::errorCount(), 0);
+        if (!pgm) return nullptr;
+
+        RemoveUnusedPolicy policy;
+        RemoveAllUnusedDeclarations remove(policy);
+        return pgm->apply(remove)->to<IR::P4Program>();
+    }
+
+    static bool hasDeclaration(const IR::P4Program *program, cstring name) {
+        for (const auto *obj : program->objects) {
+            if (const auto *decl = obj->to<IR::IDeclaration>())
+                if (decl->getName().name == name) return true;
+        }
+        return false;
+    }
+};
+
+// A chain of declarations where each becomes unused only once its user is
+// removed: the worklist propagation must reach the end of the chain.
+TEST_F(RemoveAllUnusedDeclarationsTest, RemovesChainedUnusedDeclarations) {
+    std::string program_source = P4_SOURCE(R"(
+const bit<8> bottom = 8w1;
+const bit<8> middle = bottom + 8w1;
+const bit<8> top = middle + 8w1;
+const bit<8> kept = 8w7;
+
+control C(inout bit<8> x) {
+    apply {
+        x = kept;
+    }
+}
+
+control proto(inout bit<8> x);
+package pack(proto p);
+pack(C()) main;
+    )");
+
+    const auto *program = parseAndRemove(program_source);
+    ASSERT_TRUE(program);
+    ASSERT_EQ(::P4::errorCount(), 0);
+
+    EXPECT_FALSE(hasDeclaration(program, "top"_cs));
+    EXPECT_FALSE(hasDeclaration(program, "middle"_cs));
+    EXPECT_FALSE(hasDeclaration(program, "bottom"_cs));
+    EXPECT_TRUE(hasDeclaration(program, "kept"_cs));
+    EXPECT_TRUE(hasDeclaration(program, "C"_cs));
+}
+
+// Declarations referenced only from inside a removed declaration must be
+// removed as well, even though their direct user was deleted in an earlier
+// iteration than they were.
+TEST_F(RemoveAllUnusedDeclarationsTest, RemovesDeclarationsUsedByRemovedControl) {
+    std::string program_source = P4_SOURCE(R"(
+const bit<8> onlyUsedByDead = 8w3;
+
+control Dead(inout bit<8> x) {
+    apply {
+        x = onlyUsedByDead;
+    }
+}
+
+control C(inout bit<8> x) {
+    apply {
+        x = 8w0;
+    }
+}
+
+control proto(inout bit<8> x);
+package pack(proto p);
+pack(C()) main;
+    )");
+
+    const auto *program = parseAndRemove(program_source);
+    ASSERT_TRUE(program);
+    ASSERT_EQ(::P4::errorCount(), 0);
+
+    EXPECT_FALSE(hasDeclaration(program, "Dead"_cs));
+    EXPECT_FALSE(hasDeclaration(program, "onlyUsedByDead"_cs));
+    EXPECT_TRUE(hasDeclaration(program, "C"_cs));
+}
+
+}  // namespace P4::Test
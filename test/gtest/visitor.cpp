@@ -14,6 +14,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <map>
+
 #include "frontends/common/parseInput.h"
 #include "frontends/common/resolveReferences/resolveReferences.h"
 #include "gtest/gtest.h"
@@ -160,4 +162,112 @@ TEST_F(P4CVisitor, MultiVisitModifierLoop) {
     ASSERT_TRUE(program != nullptr);
 }
 
+struct DispatchCountingInspector final : public Inspector {
+    unsigned statements = 0, paths = 0, others = 0;
+
+    explicit DispatchCountingInspector(bool restricted) {
+        if (restricted) dispatchOnly<IR::Statement>();
+    }
+
+ private:
+    bool preorder(const IR::Node *) override {
+        ++others;
+        return true;
+    }
+    bool preorder(const IR::Statement *) override {
+        ++statements;
+        return true;
+    }
+    bool preorder(const IR::Path *) override {
+        ++paths;
+        return true;
+    }
+};
+
+// dispatchOnly must suppress handler dispatch for unlisted node types while
+// still delivering the handlers of the listed class and all its subclasses.
+TEST_F(P4CVisitor, DispatchOnlyFiltersHandlers) {
+    auto *program =
+        P4::parseP4String(getMultiVisitLoopSource(), CompilerOptions::FrontendVersion::P4_16);
+    ASSERT_TRUE(program != nullptr);
+
+    DispatchCountingInspector full(false);
+    program->apply(full);
+    EXPECT_GT(full.statements, 0u);
+    EXPECT_GT(full.paths, 0u);
+    EXPECT_GT(full.others, 0u);
+
+    DispatchCountingInspector restricted(true);
+    program->apply(restricted);
+    EXPECT_EQ(restricted.statements, full.statements);
+    EXPECT_EQ(restricted.paths, 0u);
+    EXPECT_EQ(restricted.others, 0u);
+}
+
+struct ConstantCountingInspector final : public Inspector {
+    unsigned constants = 0;
+
+    explicit ConstantCountingInspector(bool restricted) {
+        if (restricted) dispatchOnly<IR::Constant>();
+    }
+
+ private:
+    bool preorder(const IR::Constant *) override {
+        ++constants;
+        return true;
+    }
+};
+
+// dispatchOnly also skips subtrees whose reachability mask shows they cannot
+// contain any listed type.  The skipping must never prune a subtree that can
+// still contain one: constants sit deep under the parser select expressions,
+// and a visitor interested only in them must reach every single one.
+TEST_F(P4CVisitor, DispatchOnlyReachesNestedTypes) {
+    auto *program =
+        P4::parseP4String(getMultiVisitLoopSource(), CompilerOptions::FrontendVersion::P4_16);
+    ASSERT_TRUE(program != nullptr);
+
+    ConstantCountingInspector full(false);
+    program->apply(full);
+    EXPECT_GT(full.constants, 0u);
+
+    ConstantCountingInspector restricted(true);
+    program->apply(restricted);
+    EXPECT_EQ(restricted.constants, full.constants);
+}
+
+struct AncestorQueryInspector final : public Inspector {
+    std::map<big_int, const IR::Add *> addOf;
+    std::map<big_int, const IR::Mul *> mulOf;
+
+ private:
+    bool preorder(const IR::Constant *c) override {
+        // query twice: the second call must come out of the frame memo
+        addOf[c->value] = findContext<IR::Add>();
+        EXPECT_EQ(findContext<IR::Add>(), addOf[c->value]);
+        mulOf[c->value] = findContext<IR::Mul>();
+        EXPECT_EQ(findContext<IR::Mul>(), mulOf[c->value]);
+        EXPECT_EQ(isInContext<IR::Shl>(), false);
+        return true;
+    }
+};
+
+// findContext answers are memoized in the context frames; the memo inherited
+// from an ancestor frame must not leak a match into a sibling subtree that
+// does not have that ancestor.
+TEST_F(P4CVisitor, TypedAncestorMemo) {
+    auto *add = new IR::Add(new IR::Constant(1), new IR::Constant(2));
+    const auto *mul = new IR::Mul(add, new IR::Constant(3));
+
+    AncestorQueryInspector queries;
+    mul->apply(queries);
+
+    EXPECT_EQ(queries.addOf[1], add);
+    EXPECT_EQ(queries.addOf[2], add);
+    EXPECT_EQ(queries.addOf[3], nullptr);
+    EXPECT_EQ(queries.mulOf[1], mul);
+    EXPECT_EQ(queries.mulOf[2], mul);
+    EXPECT_EQ(queries.mulOf[3], mul);
+}
+
 }  // namespace P4::Test
@@ -202,7 +202,11 @@ def main():
         "-b",
         "--target",
         dest="target",
-        help="specify target device",
+        help=(
+            "specify target device; a comma-separated list"
+            " compiles the same source for every listed"
+            " target, sharing the frontend work between them"
+        ),
         action="store",
         default=p4c_default_target,
     )
@@ -213,7 +217,12 @@ def main():
         "-a",
         "--arch",
         dest="arch",
-        help="specify target architecture",
+        help=(
+            "specify target architecture; with a multi-target"
+            " build this is either one architecture shared by"
+            " all targets or a comma-separated list paired"
+            " with the targets"
+        ),
         action="store",
         default=p4c_default_arch,
     )
@@ -527,23 +536,37 @@ def main():
         print(display_supported_targets(cfg))
         sys.exit(0)
 
-    # check that the tuple value is correct
-    backend = (opts.target, opts.arch)
-    if len(backend) != 2:
+    # Pair up the requested targets and architectures.  A comma-separated
+    # target list compiles the same source for every listed target in one
+    # driver invocation; a single architecture applies to all targets, or a
+    # comma-separated architecture list is matched up with the targets.
+    requested_targets = opts.target.split(",")
+    requested_archs = opts.arch.split(",")
+    if len(requested_archs) == 1:
+        requested_archs = requested_archs * len(requested_targets)
+    if len(requested_archs) != len(requested_targets):
         parser.error(
-            "Invalid target and arch tuple: {}\n{}".format(backend, display_supported_targets(cfg))
+            "{} targets but {} architectures specified; either give one"
+            " architecture for all targets or one per target".format(
+                len(requested_targets), len(requested_archs)
+            )
         )
 
-    # find the backend
-    backend = None
-    for target in cfg.target:
-        regex = target._backend.replace("*", "[a-zA-Z0-9*]*")
-        pattern = re.compile(regex)
-        if pattern.match(opts.target + "-" + opts.arch):
-            backend = target
-            break
-    if backend is None:
-        parser.error("Unknown backend: {}-{}".format(str(opts.target), str(opts.arch)))
+    # find the backend for each requested target
+    backends = []
+    for req_target, req_arch in zip(requested_targets, requested_archs):
+        backend = None
+        for target in cfg.target:
+            regex = target._backend.replace("*", "[a-zA-Z0-9*]*")
+            pattern = re.compile(regex)
+            if pattern.match(req_target + "-" + req_arch):
+                backend = target
+                break
+        if backend is None:
+            parser.error("Unknown backend: {}-{}".format(str(req_target), str(req_arch)))
+        if backend not in backends:
+            backends.append(backend)
+    backend = backends[0]
     error_count = 0
 
     JSON_input_specified = env_indicates_developer_build and opts.json_source
@@ -691,8 +714,24 @@ def main():
     opts.__setattr__("source_file", string_to_pass_as___source_file)
 
     # set all configuration and command line options for backend
-    backend.process_command_line_options(opts)
-
-    # run all commands
-    rc = backend.run()
+    if len(backends) == 1:
+        backend.process_command_line_options(opts)
+
+        # run all commands
+        rc = backend.run()
+        sys.exit(rc)
+
+    # Multi-target dispatch: run every backend in turn, pointing all of the
+    # compiler invocations at one shared frontend cache under the output
+    # directory.  The first target parses and runs the frontend and the rest
+    # start from the cached post-frontend IR, so the frontend work for the
+    # common source is only done once.
+    frontend_cache_dir = os.path.join(opts.output_directory, ".p4c-frontend-cache")
+    rc = 0
+    for backend in backends:
+        backend.process_command_line_options(opts)
+        backend.add_command_option("compiler", "--frontend-cache {}".format(frontend_cache_dir))
+        rc = backend.run()
+        if rc != 0:
+            break
     sys.exit(rc)
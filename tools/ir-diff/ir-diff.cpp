@@ -0,0 +1,318 @@
+/*
+Copyright 2013-present Barefoot Networks, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+/* Structural differ for --toJSON IR dumps.  Compares two dumps as trees rather
+ * than as text, so it stays usable on multi-gigabyte dumps where generic diff
+ * tools thrash: node ids are matched up by position instead of by value (two
+ * compiler versions rarely number the IR identically), the children of the top
+ * level are compared on worker threads, and reporting stops after a difference
+ * limit so a regression triage run answers "what changed first" in seconds. */
+
+#include <getopt.h>
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ir/json_parser.h"
+
+using namespace P4;
+
+namespace {
+
+class Differ {
+    unsigned maxDiffs;
+    bool remapIds;
+
+    /// Bijection between the node ids of the two dumps, grown as full nodes are
+    /// matched up and checked again on every back-reference.  Two dumps of the
+    /// same program number their nodes differently across compiler versions, so
+    /// ids only ever participate in the comparison through this mapping.
+    std::map<big_int, big_int> idAtoB;
+    std::map<big_int, big_int> idBtoA;
+    std::mutex idLock;
+
+    std::atomic<unsigned> diffCount{0};
+    std::vector<std::string> messages;
+    std::mutex messageLock;
+
+    bool limitReached() { return diffCount.load(std::memory_order_relaxed) >= maxDiffs; }
+
+    void report(const std::string &path, const std::string &what) {
+        if (diffCount.fetch_add(1, std::memory_order_relaxed) >= maxDiffs) return;
+        std::lock_guard<std::mutex> lock(messageLock);
+        messages.push_back(path + ": " + what);
+    }
+
+    static std::string describe(const JsonData *d) {
+        if (d->is<JsonObject>()) return "object";
+        if (d->is<JsonVector>()) return "array";
+        if (d->is<JsonNull>()) return "null";
+        std::stringstream ss;
+        if (auto *s = d->to<JsonString>())
+            ss << '"' << static_cast<const std::string &>(*s) << '"';
+        else if (auto *n = d->to<JsonNumber>())
+            ss << n->val;
+        else if (auto *b = d->to<JsonBoolean>())
+            ss << (b->val ? "true" : "false");
+        return ss.str();
+    }
+
+    static const JsonNumber *getId(const JsonObject *obj) {
+        auto it = obj->find("Node_ID");
+        return it == obj->end() ? nullptr : it->second->to<JsonNumber>();
+    }
+
+    /// Record (or check) the id pairing for a matched-up node.  Returns false
+    /// if either id is already paired with a different one, which means the two
+    /// dumps share nodes differently at this point.
+    bool mapIds(const big_int &a, const big_int &b) {
+        std::lock_guard<std::mutex> lock(idLock);
+        auto [itA, newA] = idAtoB.emplace(a, b);
+        auto [itB, newB] = idBtoA.emplace(b, a);
+        return itA->second == b && itB->second == a && newA == newB;
+    }
+
+    void compareObject(const std::string &path, const JsonObject *a, const JsonObject *b) {
+        auto *aId = getId(a);
+        auto *bId = getId(b);
+        if (remapIds && aId && bId) {
+            if (!mapIds(aId->val, bId->val)) {
+                std::stringstream ss;
+                ss << "node ids pair up inconsistently (" << aId->val << " vs " << bId->val << ")";
+                report(path, ss.str());
+                return;
+            }
+            // a bare { "Node_ID" : n } is a back-reference to an already-dumped
+            // node; the mapping check above is the entire comparison
+            if (a->size() == 1 && b->size() == 1) return;
+        }
+        for (auto &[key, aVal] : *a) {
+            if (limitReached()) return;
+            if (remapIds && key == "Node_ID") continue;
+            auto it = b->find(key);
+            if (it == b->end()) {
+                report(path + "/" + key.string(), "only in first dump");
+                continue;
+            }
+            compare(path + "/" + key.string(), aVal.get(), it->second.get());
+        }
+        for (auto &[key, bVal] : *b) {
+            if (limitReached()) return;
+            if (a->find(key) == a->end()) report(path + "/" + key.string(), "only in second dump");
+        }
+    }
+
+    void compareVector(const std::string &path, const JsonVector *a, const JsonVector *b) {
+        if (a->size() != b->size()) {
+            std::stringstream ss;
+            ss << "size mismatch (" << a->size() << " vs " << b->size() << ")";
+            report(path, ss.str());
+        }
+        size_t common = std::min(a->size(), b->size());
+        for (size_t i = 0; i < common && !limitReached(); i++)
+            compare(path + "/" + std::to_string(i), (*a)[i].get(), (*b)[i].get());
+    }
+
+ public:
+    Differ(unsigned maxDiffs, bool remapIds) : maxDiffs(maxDiffs), remapIds(remapIds) {}
+
+    void compare(const std::string &path, const JsonData *a, const JsonData *b) {
+        if (limitReached()) return;
+        if (auto *aObj = a->to<JsonObject>()) {
+            if (auto *bObj = b->to<JsonObject>()) {
+                // name the node type in the path so a difference deep in the
+                // tree is attributable without opening the dumps
+                if (auto it = aObj->find("Node_Type"); it != aObj->end())
+                    if (auto *type = it->second->to<JsonString>())
+                        return compareObject(path + "<" + *type + ">", aObj, bObj);
+                return compareObject(path, aObj, bObj);
+            }
+        } else if (auto *aVec = a->to<JsonVector>()) {
+            if (auto *bVec = b->to<JsonVector>()) return compareVector(path, aVec, bVec);
+        } else if (auto *aNum = a->to<JsonNumber>()) {
+            if (auto *bNum = b->to<JsonNumber>()) {
+                if (aNum->val != bNum->val) report(path, describe(a) + " vs " + describe(b));
+                return;
+            }
+        } else if (auto *aStr = a->to<JsonString>()) {
+            if (auto *bStr = b->to<JsonString>()) {
+                if (static_cast<const std::string &>(*aStr) !=
+                    static_cast<const std::string &>(*bStr))
+                    report(path, describe(a) + " vs " + describe(b));
+                return;
+            }
+        } else if (auto *aBool = a->to<JsonBoolean>()) {
+            if (auto *bBool = b->to<JsonBoolean>()) {
+                if (aBool->val != bBool->val) report(path, describe(a) + " vs " + describe(b));
+                return;
+            }
+        } else if (a->is<JsonNull>()) {
+            if (b->is<JsonNull>()) return;
+        }
+        report(path, describe(a) + " vs " + describe(b));
+    }
+
+    /// Compare the children of the two roots on @threads worker threads.  The
+    /// top level of an IR dump is a handful of large independent subtrees, so
+    /// sharding there is enough to keep all cores busy.
+    void compareParallel(const JsonData *a, const JsonData *b, unsigned threads) {
+        struct Task {
+            std::string path;
+            const JsonData *a, *b;
+        };
+        std::vector<Task> tasks;
+
+        if (auto *aObj = a->to<JsonObject>()) {
+            if (auto *bObj = b->to<JsonObject>()) {
+                // pair up the roots' ids like compareObject would
+                auto *aId = getId(aObj);
+                auto *bId = getId(bObj);
+                if (remapIds && aId && bId) mapIds(aId->val, bId->val);
+                for (auto &[key, aVal] : *aObj) {
+                    if (remapIds && key == "Node_ID") continue;
+                    auto it = bObj->find(key);
+                    if (it == bObj->end())
+                        report("/" + key.string(), "only in first dump");
+                    else
+                        tasks.push_back({"/" + key.string(), aVal.get(), it->second.get()});
+                }
+                for (auto &[key, bVal] : *bObj)
+                    if (aObj->find(key) == aObj->end())
+                        report("/" + key.string(), "only in second dump");
+            }
+        } else if (auto *aVec = a->to<JsonVector>()) {
+            if (auto *bVec = b->to<JsonVector>()) {
+                if (aVec->size() != bVec->size()) {
+                    std::stringstream ss;
+                    ss << "size mismatch (" << aVec->size() << " vs " << bVec->size() << ")";
+                    report("/", ss.str());
+                }
+                for (size_t i = 0; i < std::min(aVec->size(), bVec->size()); i++)
+                    tasks.push_back({"/" + std::to_string(i), (*aVec)[i].get(), (*bVec)[i].get()});
+            }
+        }
+
+        if (tasks.empty()) {
+            compare("", a, b);
+            return;
+        }
+
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads <= 1 || tasks.size() <= 1) {
+            for (auto &task : tasks) compare(task.path, task.a, task.b);
+            return;
+        }
+
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::min<size_t>(threads, tasks.size()); t++)
+            workers.emplace_back([&]() {
+                size_t i;
+                while ((i = next.fetch_add(1)) < tasks.size() && !limitReached())
+                    compare(tasks[i].path, tasks[i].a, tasks[i].b);
+            });
+        for (auto &worker : workers) worker.join();
+    }
+
+    /// Print the collected differences; returns the exit status (0 = same).
+    int summarize(std::ostream &out) {
+        for (auto &message : messages) out << message << std::endl;
+        unsigned total = diffCount.load();
+        if (total == 0) return 0;
+        if (total > maxDiffs)
+            out << "... stopped after " << maxDiffs << " differences (more exist)" << std::endl;
+        else
+            out << total << " difference" << (total > 1 ? "s" : "") << std::endl;
+        return 1;
+    }
+};
+
+std::unique_ptr<JsonData> parseFile(const char *name, unsigned threads) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << name << std::endl;
+        return nullptr;
+    }
+    try {
+        return parseJsonParallel(in, threads);
+    } catch (const JsonData::error &e) {
+        std::cerr << name << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void usage(const char *progname) {
+    std::cerr << progname << ": structurally compare two --toJSON IR dumps" << std::endl;
+    std::cerr << "usage: " << progname << " [options] a.json b.json" << std::endl;
+    std::cerr << "options supported:" << std::endl;
+    std::cerr << "     -j n: use n worker threads (default: all cores)" << std::endl;
+    std::cerr << "     -n n: stop after n differences (default 20, 0 = no limit)" << std::endl;
+    std::cerr << "     -s: require node ids to be identical instead of remapping them"
+              << std::endl;
+    std::cerr << "     -h: print this message and exit" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    unsigned threads = 0;
+    unsigned maxDiffs = 20;
+    bool remapIds = true;
+
+    while (true) {
+        int opt = getopt(argc, argv, "j:n:sh");
+        if (opt == -1) break;
+
+        switch (opt) {
+            case 'j':
+                threads = std::stoul(optarg);
+                break;
+            case 'n':
+                maxDiffs = std::stoul(optarg);
+                if (maxDiffs == 0) maxDiffs = ~0U;
+                break;
+            case 's':
+                remapIds = false;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 2;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if (argc - optind != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    auto a = parseFile(argv[optind], threads);
+    auto b = parseFile(argv[optind + 1], threads);
+    if (!a || !b) return 2;
+
+    Differ differ(maxDiffs, remapIds);
+    differ.compareParallel(a.get(), b.get(), threads);
+    return differ.summarize(std::cout);
+}
@@ -38,6 +38,7 @@ void usage(const char *progname) {
     fprintf(stderr, "     -t file: file where the tree macro is written\n");
     fprintf(stderr, "     -h: print this message and exit\n");
     fprintf(stderr, "     -P: don't generate #line directives\n");
+    fprintf(stderr, "     -F: don't mark leaf IR classes 'final'\n");
 }
 
 int main(int argc, char *argv[]) {
@@ -46,7 +47,7 @@ int main(int argc, char *argv[]) {
     std::unique_ptr<std::ostream> impl = std::make_unique<nullstream>();
 
     while (true) {
-        int opt = getopt(argc, argv, "o:i:t:hP");
+        int opt = getopt(argc, argv, "o:i:t:hPF");
         if (opt == -1) break;
 
         switch (opt) {
@@ -68,6 +69,9 @@ int main(int argc, char *argv[]) {
             case 'P':
                 LineDirective::inhibit = true;
                 break;
+            case 'F':
+                IrClass::finalLeaves = false;
+                break;
             default:
                 std::cerr << "Unknown option: " << opt << std::endl;
                 usage(argv[0]);
@@ -16,12 +16,15 @@ limitations under the License.
 
 #include "irclass.h"
 
+#include <cstdint>
+
 #include "lib/enumerator.h"
 #include "lib/exceptions.h"
 
 namespace P4 {
 
 const char *IrClass::indent = "    ";
+bool IrClass::finalLeaves = true;
 IrNamespace &IrNamespace::global() {
     static IrNamespace irn({}, {});
     return irn;
@@ -163,6 +166,7 @@ void IrDefinitions::generate(std::ostream &t, std::ostream &out, std::ostream &i
         << "#include \"ir/node.h\"            // IWYU pragma: keep\n"
         << "#include \"ir/nodemap.h\"         // IWYU pragma: keep\n"
         << "#include \"ir/vector.h\"          // IWYU pragma: keep\n"
+        << "#include \"lib/ordered_flat_map.h\"  // IWYU pragma: keep\n"
         << "#include \"lib/ordered_map.h\"    // IWYU pragma: keep\n"
         << std::endl
         << "namespace P4 {\n"
@@ -284,6 +288,38 @@ void IrDefinitions::generate(std::ostream &t, std::ostream &out, std::ostream &i
     t << "  IDeclaration = " << nkId++ << ",\n";
     t << "  VectorBase = " << nkId++ << "\n"
       << "};\n";
+
+    // Emit the visitor dispatch parent of every node kind: the class whose
+    // preorder/postorder/revisit overload the generated default handler for
+    // this kind forwards to.  This is the concrete parent chain (interfaces
+    // have no visitor overloads), which always terminates at Node.  Interface
+    // and nested kinds never occur as the dynamic type of a node, so their
+    // entries are never looked up.
+    t << "/// For each NodeKind (as index), the kind of the class its default visitor\n"
+      << "/// preorder/postorder handlers forward to; chains terminate at Node.\n"
+      << "inline constexpr NodeKind nodeKindDispatchParent[] = {\n"
+      << "  NodeKind::Auto,   // Auto\n"
+      << "  NodeKind::INode,  // INode\n"
+      << "  NodeKind::Node,   // Node\n";
+    for (auto *cls : *getClasses()) {
+        cstring parent = "Node"_cs;
+        if (cls->kind != NodeKind::Interface && cls->kind != NodeKind::Nested) {
+            if (const auto *p = cls->getParent(); p && p != IrClass::nodeClass())
+                parent = p->qualified_name(irNamespace).replace("::", "_");
+        }
+        t << "  NodeKind::" << parent << ",  // "
+          << cls->qualified_name(irNamespace).replace("::", "_") << "\n";
+    }
+    t << "  NodeKind::INode,  // IDeclaration\n"
+      << "  NodeKind::Node    // VectorBase\n"
+      << "};\n";
+    t << "/// The number of NodeKind values; nodeKindDispatchParent is indexed by [0, count).\n"
+      << "inline constexpr auto NodeKindCount = sizeof(nodeKindDispatchParent) / "
+         "sizeof(nodeKindDispatchParent[0]);\n";
+
+    generateReachabilityMasks(t);
+    generateIsATable(t);
+
     t << "enum class NodeDiscriminator : RTTI::TypeId {\n"
       << "  NodeT = UINT64_C(1),\n"
       << "  VectorT = UINT64_C(1),\n"
@@ -309,6 +345,243 @@ void IrDefinitions::generate(std::ostream &t, std::ostream &out, std::ostream &i
     t << "}  // namespace P4::IR" << std::endl;
 }
 
+/* Emit per-node-kind reachability masks used by Visitor dispatch filtering.
+ * For each NodeKind, the mask records which kinds can occur anywhere in the
+ * subtree of a node of that type.  This mirrors the generated visit_children
+ * methods: a class visits its own and inherited fields whose types resolve to
+ * IR classes, including the element types of template containers (Vector,
+ * IndexedVector, NameMap, safe_vector, ...) and the alternatives of variant
+ * fields.  Rows are closed over subclasses -- the row of an abstract class
+ * covers every dynamic type that can appear in its place -- and include the
+ * dispatch ancestors of every reachable kind, so intersecting a row with the
+ * set of kinds a visitor declared via dispatchOnly() tells whether any of its
+ * handlers can fire within the subtree. */
+void IrDefinitions::generateReachabilityMasks(std::ostream &t) const {
+    std::vector<IrClass *> classes;
+    for (auto *cls : *getClasses()) classes.push_back(cls);
+
+    std::map<const IrClass *, size_t> kindId;
+    size_t nextKind = 3;  // Auto, INode and Node come first
+    for (auto *cls : classes) kindId[cls] = nextKind++;
+    const size_t kindCount = nextKind + 2;  // trailing IDeclaration and VectorBase
+    const size_t maskWords = (kindCount + 63) / 64;
+
+    // Subtyping edges: the concrete parent plus any implemented interfaces.
+    std::map<const IrClass *, std::vector<const IrClass *>> derived;
+    for (auto *cls : classes) {
+        if (const auto *p = cls->getParent(); p && p != cls) derived[p].push_back(cls);
+        for (const auto *p : cls->parentClasses) derived[p].push_back(cls);
+    }
+
+    // Memoized set of all classes at or below a class in the subtype order.
+    std::map<const IrClass *, std::vector<const IrClass *>> subtrees;
+    auto subtree = [&](const IrClass *cls) -> const std::vector<const IrClass *> & {
+        auto [it, isNew] = subtrees.emplace(cls, std::vector<const IrClass *>());
+        if (isNew) {
+            std::set<const IrClass *> seen;
+            std::vector<const IrClass *> work = {cls};
+            while (!work.empty()) {
+                const auto *c = work.back();
+                work.pop_back();
+                if (!seen.insert(c).second) continue;
+                it->second.push_back(c);
+                if (auto d = derived.find(c); d != derived.end())
+                    work.insert(work.end(), d->second.begin(), d->second.end());
+            }
+        }
+        return it->second;
+    };
+
+    // The IR classes each class's visit_children can visit directly: own and
+    // inherited field types, expanded through template arguments and variant
+    // alternatives.  Template classes themselves (Vector, NameMap, ...) only
+    // contribute their element types.
+    std::map<const IrClass *, std::vector<const IrClass *>> feeds;
+    for (auto *cls : classes) {
+        auto &targets = feeds[cls];
+        for (const auto *c = cls; c && c != IrClass::nodeClass(); c = c->getParent()) {
+            auto addFieldType = [&](const Type *type) {
+                std::vector<const Type *> work = {type};
+                while (!work.empty()) {
+                    const auto *ft = work.back();
+                    work.pop_back();
+                    if (const auto *resolved = ft->resolve(c->containedIn))
+                        if (resolved->kind != NodeKind::Template) targets.push_back(resolved);
+                    if (const auto *ti = dynamic_cast<const TemplateInstantiation *>(ft))
+                        work.insert(work.end(), ti->args.begin(), ti->args.end());
+                }
+            };
+            for (auto *f : *c->getFields()) {
+                if (const auto *variant = dynamic_cast<const IrVariantField *>(f)) {
+                    for (const auto *alt : *variant->types) addFieldType(alt);
+                } else if (f->type) {
+                    addFieldType(f->type);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<uint64_t>> reach(kindCount, std::vector<uint64_t>(maskWords, 0));
+    auto setBit = [](std::vector<uint64_t> &row, size_t bit) {
+        row[bit / 64] |= UINT64_C(1) << (bit % 64);
+    };
+    auto orInto = [](std::vector<uint64_t> &dst, const std::vector<uint64_t> &src) {
+        bool changed = false;
+        for (size_t i = 0; i < dst.size(); ++i) {
+            changed |= (src[i] & ~dst[i]) != 0;
+            dst[i] |= src[i];
+        }
+        return changed;
+    };
+
+    // Seed each row with the class itself and its dispatch ancestors, then
+    // propagate field reachability to a fixpoint.  A field of some static
+    // type can hold any of its subclasses, so each target expands to its
+    // whole subtree.
+    for (auto *cls : classes) {
+        auto &row = reach[kindId[cls]];
+        for (const auto *c = cls; c; c = c->getParent()) {
+            auto id = kindId.find(c);
+            setBit(row, id != kindId.end() ? id->second : size_t(2) /* Node */);
+            if (c == IrClass::nodeClass()) break;
+        }
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (auto *cls : classes) {
+            auto &row = reach[kindId[cls]];
+            for (const auto *target : feeds[cls])
+                for (const auto *d : subtree(target))
+                    if (auto id = kindId.find(d); id != kindId.end())
+                        if (orInto(row, reach[id->second])) changed = true;
+        }
+    }
+
+    auto *irNamespace = IrNamespace::get(nullptr, "IR"_cs);
+    t << "/// For each NodeKind (as index), a bitmap over NodeKind of every kind that can\n"
+      << "/// occur in the subtree of a node of that type, including the node itself and\n"
+      << "/// the dispatch ancestors of every such kind.  Rows of abstract classes cover\n"
+      << "/// all their subclasses; kinds that are not generated nodes get all-ones rows.\n"
+      << "inline constexpr uint64_t nodeKindReachable[][" << maskWords << "] = {\n";
+    auto emitRow = [&t, maskWords](const std::vector<uint64_t> &row, cstring name) {
+        t << "  {";
+        for (size_t i = 0; i < maskWords; ++i)
+            t << (i ? ", " : "") << "UINT64_C(0x" << std::hex << row[i] << std::dec << ")";
+        t << "},  // " << name << "\n";
+    };
+    const std::vector<uint64_t> allOnes(maskWords, ~UINT64_C(0));
+    emitRow(allOnes, "Auto"_cs);
+    emitRow(allOnes, "INode"_cs);
+    emitRow(allOnes, "Node"_cs);
+    for (auto *cls : classes) {
+        std::vector<uint64_t> closed(maskWords, 0);
+        for (const auto *d : subtree(cls))
+            if (auto id = kindId.find(d); id != kindId.end()) orInto(closed, reach[id->second]);
+        emitRow(closed, cls->qualified_name(irNamespace).replace("::", "_"));
+    }
+    emitRow(allOnes, "IDeclaration"_cs);
+    emitRow(allOnes, "VectorBase"_cs);
+    t << "};\n"
+      << "static_assert(sizeof(nodeKindReachable) / sizeof(nodeKindReachable[0]) == "
+         "NodeKindCount,\n"
+      << "              \"reachability table must cover every node kind\");\n";
+}
+
+/* Emit the subtype matrix backing the generated isA() overrides.  For each
+ * NodeKind, the row records every kind the class derives from or implements,
+ * mirroring exactly what the recursive TypeInfo::isA base-chain walk would
+ * answer: the class itself, its concrete parent chain, all implemented
+ * interfaces, and the Node/INode roots.  Since the generated typeids are the
+ * dense NodeKind values, a dynamic isA() against another generated class
+ * becomes one row lookup and one bit test instead of a comparison chain. */
+void IrDefinitions::generateIsATable(std::ostream &t) const {
+    std::vector<IrClass *> classes;
+    for (auto *cls : *getClasses()) classes.push_back(cls);
+
+    std::map<const IrClass *, size_t> kindId;
+    size_t nextKind = 3;  // Auto, INode and Node come first
+    for (auto *cls : classes) kindId[cls] = nextKind++;
+    const size_t ideclKind = nextKind++;      // trailing IDeclaration
+    const size_t vectorBaseKind = nextKind++;  // trailing VectorBase
+    const size_t kindCount = nextKind;
+    const size_t maskWords = (kindCount + 63) / 64;
+
+    auto setBit = [](std::vector<uint64_t> &row, size_t bit) {
+        row[bit / 64] |= UINT64_C(1) << (bit % 64);
+    };
+
+    auto *irNamespace = IrNamespace::get(nullptr, "IR"_cs);
+    t << "/// For each NodeKind (as index), a bitmap over NodeKind with bit j set iff a\n"
+      << "/// node whose dynamic kind is the index derives from or implements kind j; the\n"
+      << "/// generated isA() overrides answer dense-id queries with one test against their\n"
+      << "/// row.  Nested kinds carry no typeinfo, so their rows are just themselves.\n"
+      << "inline constexpr uint64_t nodeKindIsA[][" << maskWords << "] = {\n";
+    auto emitRow = [&t, maskWords](const std::vector<uint64_t> &row, cstring name) {
+        t << "  {";
+        for (size_t i = 0; i < maskWords; ++i)
+            t << (i ? ", " : "") << "UINT64_C(0x" << std::hex << row[i] << std::dec << ")";
+        t << "},  // " << name << "\n";
+    };
+
+    std::vector<uint64_t> row(maskWords, 0);
+    setBit(row, 0);
+    emitRow(row, "Auto"_cs);
+    row.assign(maskWords, 0);
+    setBit(row, 1);
+    emitRow(row, "INode"_cs);
+    setBit(row, 2);  // Node implements INode
+    emitRow(row, "Node"_cs);
+
+    for (auto *cls : classes) {
+        row.assign(maskWords, 0);
+        // Closure over the declared bases, matching the base list emitted by
+        // generate_hdr: the explicit parents plus the implicit Node/INode root
+        // when no concrete parent was declared.
+        std::set<const IrClass *> seen;
+        std::vector<const IrClass *> work = {cls};
+        while (!work.empty()) {
+            const auto *c = work.back();
+            work.pop_back();
+            if (!seen.insert(c).second) continue;
+            if (c == IrClass::nodeClass()) {
+                setBit(row, 2);
+                setBit(row, 1);
+                continue;
+            }
+            if (c == IrClass::ideclaration()) {
+                setBit(row, ideclKind);
+                setBit(row, 1);
+                continue;
+            }
+            setBit(row, kindId.at(c));
+            if (c->kind == NodeKind::Nested) continue;
+            bool concreteParent = false;
+            for (const auto *p : c->parentClasses) {
+                if (p->kind != NodeKind::Interface) concreteParent = true;
+                work.push_back(p);
+            }
+            if (!concreteParent) {
+                if (c->kind != NodeKind::Interface) setBit(row, 2);  // Node
+                setBit(row, 1);                                      // INode
+            }
+        }
+        emitRow(row, cls->qualified_name(irNamespace).replace("::", "_"));
+    }
+
+    row.assign(maskWords, 0);
+    setBit(row, ideclKind);
+    setBit(row, 1);
+    emitRow(row, "IDeclaration"_cs);
+    row.assign(maskWords, 0);
+    setBit(row, vectorBaseKind);
+    setBit(row, 2);
+    setBit(row, 1);
+    emitRow(row, "VectorBase"_cs);
+    t << "};\n"
+      << "static_assert(sizeof(nodeKindIsA) / sizeof(nodeKindIsA[0]) == NodeKindCount,\n"
+      << "              \"isA table must cover every node kind\");\n";
+}
+
 void IrClass::generateTreeMacro(std::ostream &out) const {
     auto *p = this;
     for (; p && p != nodeClass(); p = p->getParent()) {
@@ -446,6 +719,7 @@ void IrClass::generate_hdr(std::ostream &out) const {
     }
     for (auto cblock : comments) cblock->generate_hdr(out);
     out << "class " << name;
+    if (finalLeaves && kind == NodeKind::Concrete && !subclassed) out << " final";
 
     bool concreteParent = false;
     for (auto p : parentClasses) {
@@ -481,8 +755,9 @@ void IrClass::generate_hdr(std::ostream &out) const {
 
     auto *irNamespace = IrNamespace::get(nullptr, "IR"_cs);
     if (kind != NodeKind::Nested) {
-        out << indent << "DECLARE_TYPEINFO_WITH_TYPEID(" << name
-            << ", NodeKind::" << qualified_name(irNamespace).replace("::", "_");
+        out << indent << "DECLARE_TYPEINFO_WITH_TYPEID_AND_ISA_TABLE(" << name
+            << ", NodeKind::" << qualified_name(irNamespace).replace("::", "_")
+            << ", nodeKindIsA, NodeKindCount";
         if (!concreteParent) out << ", " << (kind != NodeKind::Interface ? "Node" : "INode");
         for (const auto *p : parentClasses) out << ", " << p->qualified_name(containedIn);
         out << ");" << std::endl;
@@ -540,8 +815,19 @@ int IrClass::generateConstructor(const ctor_args_t &arglist, const IrMethod *use
             sep = "(";
             end_parent = ")";
         }
-        body << sep << arg.first->name;
-        if (arg.second == this) body << "(" << arg.first->name << ")";
+        // Inline IR-class fields (Vector<T>, IndexedVector<T>, NameMap, ...) are passed
+        // by value, so move the parameter into place rather than copying it again; callers
+        // handing over a collected vector then pay one move, not a second deep copy.  Not
+        // done when there is a user-supplied body, as that may still read the parameter.
+        bool move = user == nullptr && arg.first->isInline &&
+                    arg.first->type->resolve(arg.first->clss ? arg.first->clss->containedIn
+                                                             : nullptr) != nullptr;
+        std::string argref(arg.first->name.c_str());
+        if (move) argref = "std::move(" + argref + ")";
+        if (arg.second == this)
+            body << sep << arg.first->name << "(" << argref << ")";
+        else
+            body << sep << argref;
         sep = ", ";
     }
 
@@ -550,7 +836,8 @@ int IrClass::generateConstructor(const ctor_args_t &arglist, const IrMethod *use
         body << '\n'
              << LineDirective(user->getSourceInfo()) << user->body << '\n'
              << LineDirective() << indent;
-    if (kind != NodeKind::Nested) body << " validate(); ";
+    if (kind != NodeKind::Nested)
+        body << " AllocStats::record(this, static_type_name(), sizeof(*this)); validate(); ";
     body << "}";
     auto ctor = new IrMethod(name, body.str());
     ctor->clss = this;
@@ -616,6 +903,7 @@ void IrClass::resolve() {
                     concreteParent, p);
         }
         parentClasses.push_back(p);
+        p->subclassed = true;
     }
     generateMethods();
     for (auto e : elements) e->resolve();
@@ -293,9 +293,14 @@ class IrClass : public IrElement {
     mutable bool needIndexedVector = false;  // using an IndexedVecor of this class
     mutable bool needNameMap = false;        // using a NameMap of this class
     mutable bool needNodeMap = false;        // using a NodeMap of this class
+    mutable bool subclassed = false;         // some other IR class derives from this one
     access_t current_access = Public;        // used while parsing the class body
 
     static const char *indent;
+    // Mark concrete leaf classes 'final' so calls through pointers of the leaf type
+    // (e.g. after to<T>() or in typed visitor handlers) devirtualize; clone() and the
+    // apply_visitor hooks are the main beneficiaries.  Cleared by the -F option.
+    static bool finalLeaves;
 
     IrClass(Util::SourceInfo info, IrNamespace *ns, NodeKind kind, cstring name,
             const std::initializer_list<const Type *> &parents,
@@ -372,6 +377,8 @@ class IrEnumType : public IrElement {
 class IrDefinitions {
     std::vector<IrElement *> elements;
     Util::Enumerator<IrClass *> *getClasses() const;
+    void generateReachabilityMasks(std::ostream &t) const;
+    void generateIsATable(std::ostream &t) const;
 
  public:
     explicit IrDefinitions(std::vector<IrElement *> classes) : elements(classes) {}
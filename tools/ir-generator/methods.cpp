@@ -75,6 +75,50 @@ const ordered_map<cstring, IrMethod::info_t> IrMethod::Generate = {
           buf << cl->indent << "}";
           return {buf};
       }}},
+    {"computeEquivHash"_cs,
+     {&NamedType::Uint64(),
+      {},
+      CONST + IN_IMPL + OVERRIDE,
+      [](IrClass *cl, Util::SourceInfo, cstring) -> cstring {
+          // A hand-written equiv body may ignore some fields (and a 'no equiv' directive
+          // ignores all of them), so mixing fields into the hash could break the
+          // "equiv implies equal hashes" invariant.  Inherit the parent hash in those
+          // cases instead -- a weaker hash is always sound.
+          if (Util::enumerate(cl->elements)
+                  ->where([](IrElement *el) { return el->is<IrMethod>(); })
+                  ->where([](IrElement *el) { return el->to<IrMethod>()->name == "equiv"; })
+                  ->any())
+              return cstring();
+          if (Util::enumerate(cl->elements)
+                  ->where([](IrElement *el) { return el->is<IrNo>(); })
+                  ->where([](IrElement *el) { return el->to<IrNo>()->text == "equiv"; })
+                  ->any())
+              return cstring();
+          std::stringstream buf;
+          buf << "{" << std::endl;
+          buf << cl->indent << cl->indent << "uint64_t h = "
+              << cl->getParent()->qualified_name(cl->containedIn) << "::computeEquivHash();"
+              << std::endl;
+          for (auto f : *cl->getFields()) {
+              if (f->type && *f->type == NamedType::SourceInfo())
+                  continue;  // FIXME -- deal with SourcInfo
+              buf << cl->indent << cl->indent << "h = Util::hash_combine(h, ";
+              if (!f->type) {  // variant field -- hash only the alternative index
+                  buf << "static_cast<uint64_t>(" << f->name << ".index())";
+              } else if (f->type->resolve(cl->containedIn) == nullptr) {
+                  // This is not an IR pointer
+                  buf << "equivHashValue(" << f->name << ")";
+              } else if (f->isInline) {
+                  buf << f->name << ".getEquivHash()";
+              } else {
+                  buf << "(" << f->name << " ? " << f->name << "->getEquivHash() : 1)";
+              }
+              buf << ");" << std::endl;
+          }
+          buf << cl->indent << cl->indent << "return h;" << std::endl;
+          buf << cl->indent << "}";
+          return {buf};
+      }}},
     {"equiv"_cs,
      {&NamedType::Bool(),
       {new IrField(new ReferenceType(new NamedType(IrClass::nodeClass()), true), "a_"_cs)},
@@ -89,6 +133,9 @@ const ordered_map<cstring, IrMethod::info_t> IrMethod::Generate = {
                   buf << cl->indent << cl->indent
                       << "if (this->typeId() != a_.typeId()) "
                          "return false;\n";
+                  buf << cl->indent << cl->indent
+                      << "if (this->getEquivHash() != a_.getEquivHash()) "
+                         "return false;\n";
               } else {
                   buf << cl->indent << cl->indent << "if (!"
                       << parent->qualified_name(cl->containedIn) << "::equiv(a_)) return false;\n";
@@ -86,6 +86,11 @@ NamedType &NamedType::Int() {
     return nt;
 }
 
+NamedType &NamedType::Uint64() {
+    static NamedType nt("uint64_t"_cs);
+    return nt;
+}
+
 NamedType &NamedType::Void() {
     static NamedType nt("void"_cs);
     return nt;
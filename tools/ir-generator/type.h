@@ -103,6 +103,7 @@ class NamedType : public Type {
     static NamedType &Bool();
     static NamedType &Char();
     static NamedType &Int();
+    static NamedType &Uint64();
     static NamedType &Void();
     static NamedType &Cstring();
     static NamedType &Ostream();
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# Copyright 2013-present Barefoot Networks, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Benchmark harness for the p4c frontend and midend.
+
+Runs p4test (with --pass-timing-json) over a corpus of P4 programs and writes a
+machine-readable JSON report with per-program wall/cpu time, exit codes, and
+per-pass wall-clock totals aggregated across the corpus. Invoked by the
+`p4c-bench` CMake target with testdata/p4_16_samples as the default corpus;
+pass additional --corpus directories or --programs files to benchmark your own
+programs."""
+
+import argparse
+import json
+import resource
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--p4test", required=True, type=Path, help="Path to the p4test binary.")
+    parser.add_argument(
+        "--corpus",
+        action="append",
+        default=[],
+        type=Path,
+        help="Directory whose *.p4 files (non-recursive) are benchmarked. May be repeated.",
+    )
+    parser.add_argument(
+        "--programs",
+        nargs="*",
+        default=[],
+        type=Path,
+        help="Additional individual P4 programs to benchmark.",
+    )
+    parser.add_argument(
+        "--output", required=True, type=Path, help="Where to write the JSON report."
+    )
+    parser.add_argument(
+        "--p4test-arg",
+        action="append",
+        default=[],
+        dest="p4test_args",
+        help="Extra argument forwarded to every p4test invocation. May be repeated.",
+    )
+    return parser.parse_args()
+
+
+def child_cpu_ms():
+    """CPU time (user + system) consumed by terminated children, in milliseconds."""
+    usage = resource.getrusage(resource.RUSAGE_CHILDREN)
+    return int((usage.ru_utime + usage.ru_stime) * 1000)
+
+
+def run_one(p4test, program, extra_args):
+    """Compiles one program and returns its benchmark record."""
+    with tempfile.NamedTemporaryFile(suffix=".json", mode="r") as timing_file:
+        cmd = [str(p4test), "--pass-timing-json", timing_file.name]
+        cmd += extra_args
+        cmd += [str(program)]
+        cpu_before = child_cpu_ms()
+        wall_before = time.monotonic()
+        proc = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        wall_ms = int((time.monotonic() - wall_before) * 1000)
+        cpu_ms = child_cpu_ms() - cpu_before
+        timers = []
+        try:
+            data = timing_file.read()
+            if data:
+                timers = json.loads(data)
+        except json.JSONDecodeError:
+            # A crashed or interrupted compile leaves a truncated file behind.
+            timers = []
+    return {
+        "program": str(program),
+        "exit_code": proc.returncode,
+        "wall_ms": wall_ms,
+        "cpu_ms": cpu_ms,
+        "timers": timers,
+    }
+
+
+def aggregate_passes(results):
+    """Sums per-pass milliseconds and invocations across all benchmarked programs.
+
+    Timer names are dotted paths of nested timers; aggregation keys on the full
+    path so a pass nested in different pass managers is reported separately."""
+    totals = {}
+    for result in results:
+        for timer in result["timers"]:
+            entry = totals.setdefault(timer["name"], {"milliseconds": 0, "invocations": 0})
+            entry["milliseconds"] += timer["milliseconds"]
+            entry["invocations"] += timer["invocations"]
+    return [
+        {"name": name, **entry}
+        for name, entry in sorted(
+            totals.items(), key=lambda item: item[1]["milliseconds"], reverse=True
+        )
+    ]
+
+
+def main():
+    args = parse_args()
+    programs = []
+    for corpus in args.corpus:
+        if not corpus.is_dir():
+            print(f"p4c_bench: corpus directory {corpus} does not exist", file=sys.stderr)
+            return 1
+        programs += sorted(corpus.glob("*.p4"))
+    programs += args.programs
+    if not programs:
+        print("p4c_bench: no programs to benchmark", file=sys.stderr)
+        return 1
+
+    results = []
+    for idx, program in enumerate(programs):
+        print(f"[{idx + 1}/{len(programs)}] {program}", file=sys.stderr)
+        results.append(run_one(args.p4test, program, args.p4test_args))
+
+    report = {
+        "p4test": str(args.p4test),
+        "program_count": len(programs),
+        "failed_programs": [r["program"] for r in results if r["exit_code"] != 0],
+        "total_wall_ms": sum(r["wall_ms"] for r in results),
+        "total_cpu_ms": sum(r["cpu_ms"] for r in results),
+        "pass_totals": aggregate_passes(results),
+        "programs": results,
+    }
+    args.output.write_text(json.dumps(report, indent=2) + "\n")
+    print(f"p4c_bench: report written to {args.output}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())